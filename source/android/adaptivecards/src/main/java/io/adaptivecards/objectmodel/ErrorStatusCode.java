@@ -15,7 +15,8 @@ public enum ErrorStatusCode {
   InvalidPropertyValue,
   UnsupportedParserOverride,
   IdCollision,
-  CustomError;
+  CustomError,
+  ParseLimitExceeded;
 
   public final int swigValue() {
     return swigValue;
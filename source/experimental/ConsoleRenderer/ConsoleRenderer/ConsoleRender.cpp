@@ -2,354 +2,951 @@
 // Licensed under the MIT License.
 #include "stdafx.h"
 #include <algorithm>
+#include <sstream>
 #include "ConsoleRender.h"
-#include "TextBlock.h"
-#include "Container.h"
-#include "Image.h"
+#include "ActionSet.h"
+#include "ChoiceInput.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
 #include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "Fact.h"
 #include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "Media.h"
+#include "NumberInput.h"
+#include "RichTextBlock.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
 
 using namespace AdaptiveSharedNamespace;
-using namespace std::string_literals;
-
-size_t RenderElements(std::vector<std::shared_ptr<BaseCardElement>> elements, size_t columnWidth, size_t x, size_t y, std::vector<std::string>& consoleString);
-size_t RenderColumnSet(ColumnSet &set, size_t columnWidth, size_t x, size_t y, std::vector<std::string> &consoleString);
-size_t RenderColumn(Column &set, size_t columnWidth, size_t x, size_t y, std::vector<std::string> &consoleString);
-size_t RenderFactSet(FactSet &set, size_t FactWidth, size_t x, size_t y, std::vector<std::string> &consoleString);
-size_t RenderFact(Fact &set, size_t FactWidth, size_t x, size_t y, std::vector<std::string> &consoleString);
 
 #define ESC "\x1b"
+#define SGR_RESET ESC "[0m"
 
-std::vector<std::string> ConvertToVector(const std::string &consoleString, size_t width)
+namespace
 {
-    std::vector<std::string> vectorOut;
-    vectorOut.reserve(consoleString.length() % width); // just a guess
+    // Terminal cells assumed per pixel when converting explicit pixel widths.
+    constexpr unsigned int c_pixelsPerCell = 8;
+    constexpr size_t c_multilineInputRows = 3;
 
-    std::string currentLine;
-    currentLine.reserve(width);
-    for (auto currChar : consoleString)
-    {
-        if (currentLine.length() == 0 && isspace(currChar))
-        {
-            continue;
-        }
-        else
-        {
-            currentLine.push_back(currChar);
-        }
+    bool IsContinuationByte(char c) { return (static_cast<unsigned char>(c) & 0xC0) == 0x80; }
 
-        if (currentLine.length() >= width)
+    // Appends text from the card, replacing control characters so card content can't inject terminal escapes.
+    void AppendSanitized(std::string& output, const std::string& text)
+    {
+        for (const char c : text)
         {
-            vectorOut.push_back(currentLine);
-            currentLine.clear();
+            const unsigned char byte = static_cast<unsigned char>(c);
+            if (c == '\n')
+            {
+                output.push_back(c);
+            }
+            else if (byte < 0x20 || byte == 0x7F)
+            {
+                output.push_back(' ');
+            }
+            else
+            {
+                output.push_back(c);
+            }
         }
     }
-    vectorOut.push_back(currentLine);
 
-    return vectorOut;
-}
-
-void EnsureRows(std::vector<std::string> &toEnsure, size_t cRows)
-{
-    while (toEnsure.size() < cRows)
+    // Display width in cells of text[begin, end), skipping SGR sequences. Every code point is treated as one cell.
+    size_t DisplayWidth(const std::string& text, size_t begin, size_t end)
     {
-        toEnsure.push_back(""s);
-    }
-}
-
-void WriteTextAtX(std::string &dest, std::string &src, size_t srcWidth, size_t x)
-{
-    // dest.resize(????
-    while (dest.size() < (x + srcWidth))
-    {
-        dest.push_back(' ');
-    }
-    std::replace(src.begin(), src.end(), '\n', ' ');
-    dest.replace(x, src.size(), src);
-}
-
-void CompositeVector(std::vector<std::string> &vectorDest, std::vector<std::string> &vectorIn, size_t vectorInWidth, size_t x, size_t y)
-{
-    EnsureRows(vectorDest, y + vectorIn.size());
-    for (size_t currRow = y; currRow < (vectorIn.size() + y); currRow++)
-    {
-        WriteTextAtX(vectorDest[currRow], vectorIn[currRow - y], vectorInWidth, x);
-    }
-}
-
-#define BOLD_TEXT "\x1b[1m"
-void ApplyTextProperties(bool bold, ForegroundColor color, std::vector<std::string> &output)
-{
-    for (auto &row : output)
-    {
-        bool haveProperties = false;
-        if (bold)
+        size_t width = 0;
+        for (size_t i = begin; i < end; ++i)
         {
-            row.insert(0, BOLD_TEXT);
-            haveProperties = true;
+            if (text[i] == '\x1b')
+            {
+                i = std::min(text.find('m', i), end - 1);
+            }
+            else if (!IsContinuationByte(text[i]))
+            {
+                ++width;
+            }
         }
+        return width;
+    }
 
-        std::string sgrCode;
+    std::string GetColorSequence(ForegroundColor color, bool isSubtle)
+    {
+        const char* sgrCode = nullptr;
         switch (color)
         {
         case ForegroundColor::Accent:
-        {
             sgrCode = "34";
             break;
-        }
         case ForegroundColor::Good:
-        {
             sgrCode = "32";
             break;
-        }
         case ForegroundColor::Warning:
-        {
             sgrCode = "33";
             break;
-        }
         case ForegroundColor::Attention:
-        {
             sgrCode = "31";
             break;
-        }
         case ForegroundColor::Light:
-        {
             sgrCode = "37";
             break;
-        }
+        default:
+            break;
         }
 
-        if (!sgrCode.empty())
+        std::string sequence;
+        if (sgrCode)
         {
-            std::string sgrSequence = ESC "[" + sgrCode + "m";
-            row.insert(0, sgrSequence);
+            sequence.append(ESC "[").append(sgrCode).append("m");
         }
-
-        if (haveProperties)
+        if (isSubtle)
         {
-            row.append(ESC "[0m");
+            sequence.append(ESC "[2m");
         }
+        return sequence;
     }
-}
 
-size_t RenderElement(std::shared_ptr<BaseCardElement> element,  size_t columnWidth, size_t x, size_t &y, std::vector<std::string> &consoleString)
-{
-    size_t rowsRendered = 0;
-    switch (element->GetElementType())
-    {
-    case CardElementType::Container:
-        rowsRendered = RenderElements(std::dynamic_pointer_cast<Container>(element)->GetItems(), columnWidth, x, y, consoleString);
-        break;
-    case CardElementType::TextBlock:
-    {
-        auto textBlock = std::dynamic_pointer_cast<TextBlock>(element);
-        auto textOut = ConvertToVector(textBlock->GetText(), columnWidth);
-        //ApplyTextProperties(textBlock->GetTextWeight() == TextWeight::Bolder, textBlock->GetTextColor(), textOut);
-        CompositeVector(consoleString, textOut, columnWidth, x, y);
-        rowsRendered = textOut.size();
-        break;
-    }
-    case CardElementType::Image:
+    std::string GetTextSequence(TextWeight weight, TextSize size, ForegroundColor color, bool isSubtle)
     {
-        auto imageElem = std::dynamic_pointer_cast<Image>(element);
-        std::string imageText = imageElem->GetAltText();
-        imageText.append(" <" + imageElem->GetUrl() + ">");
-        auto textBlock = ConvertToVector(imageText, columnWidth);
-        CompositeVector(consoleString, textBlock, columnWidth, x, y);
-        rowsRendered = textBlock.size();
-        break;
+        std::string sequence = GetColorSequence(color, isSubtle);
+        if (weight == TextWeight::Bolder || size == TextSize::Large || size == TextSize::ExtraLarge)
+        {
+            sequence.append(ESC "[1m");
+        }
+        return sequence;
     }
-    case CardElementType::Column:
+
+    // Formats {{DATE()}} tokens in en-US. {{TIME()}} tokens arrive already formatted by the preparser.
+    std::string FormatText(const std::string& text)
     {
-        rowsRendered = RenderColumn(*std::dynamic_pointer_cast<Column>(element), columnWidth, x, y, consoleString);
-        break;
+        // Constructing a DateTimePreparser runs its regex over the whole string, so skip it when there's nothing to find.
+        if (text.find("{{") == std::string::npos)
+        {
+            return text;
+        }
+
+        std::string result;
+        for (const auto& token : DateTimePreparser(text).GetTextTokens())
+        {
+            result += token->GetDisplayText();
+        }
+        return result;
     }
-    case CardElementType::ColumnSet:
+
+    // A LineSource produces the rendering of one element a line at a time. Every line it appends is exactly as wide
+    // as the width it was created with, so parents can place lines side by side without measuring them again.
+    class LineSource
     {
-        rowsRendered = RenderColumnSet(*std::dynamic_pointer_cast<ColumnSet>(element), columnWidth, x, y, consoleString);
-        break;
-    }
-    case CardElementType::Fact:
+    public:
+        virtual ~LineSource() = default;
+
+        // Appends the next line to output and returns true, or returns false (appending nothing) once exhausted.
+        virtual bool AppendLine(std::string& output) = 0;
+    };
+
+    std::unique_ptr<LineSource> CreateLineSource(const BaseCardElement& element, size_t width, const ConsoleRenderOptions& options);
+
+    // Word-wraps text to the given width. The text may contain SGR sequences; the style in effect at the end of one
+    // line is re-applied at the start of the next so that wrapped runs keep their formatting.
+    class TextLines : public LineSource
     {
-        rowsRendered = RenderFact(*std::dynamic_pointer_cast<Fact>(element), columnWidth, x, y, consoleString);
-        break;
-    }
-    case CardElementType::FactSet:
+    public:
+        TextLines(std::string text, size_t width, bool wrap = true, size_t maxLines = 0, std::string style = {}) :
+            m_text(std::move(text)), m_width(std::max<size_t>(1, width)), m_wrap(wrap), m_maxLines(maxLines), m_activeStyle(std::move(style))
+        {
+        }
+
+        bool AppendLine(std::string& output) override
+        {
+            if (m_position > m_text.size() || (m_maxLines && m_linesWritten == m_maxLines))
+            {
+                return false;
+            }
+
+            size_t lineEnd = m_text.size();
+            size_t nextLine = m_text.size() + 1;
+            size_t lineWidth = 0;
+            size_t lastBreak = std::string::npos;
+            size_t widthAtLastBreak = 0;
+
+            for (size_t i = m_position; i < m_text.size(); ++i)
+            {
+                const char c = m_text[i];
+                if (c == '\x1b')
+                {
+                    const size_t sequenceEnd = m_text.find('m', i);
+                    i = (sequenceEnd == std::string::npos) ? m_text.size() - 1 : sequenceEnd;
+                    continue;
+                }
+
+                if (c == '\n')
+                {
+                    lineEnd = i;
+                    nextLine = i + 1;
+                    break;
+                }
+
+                if (IsContinuationByte(c))
+                {
+                    continue;
+                }
+
+                if (c == ' ')
+                {
+                    lastBreak = i;
+                    widthAtLastBreak = lineWidth;
+                }
+
+                if (lineWidth == m_width)
+                {
+                    if (!m_wrap)
+                    {
+                        // unwrapped text is cut off at the edge of its column
+                        lineEnd = i;
+                        nextLine = m_text.size() + 1;
+                    }
+                    else if (c == ' ')
+                    {
+                        lineEnd = i;
+                        nextLine = i + 1;
+                    }
+                    else if (lastBreak != std::string::npos)
+                    {
+                        lineEnd = lastBreak;
+                        nextLine = lastBreak + 1;
+                        lineWidth = widthAtLastBreak;
+                    }
+                    else
+                    {
+                        // a word that's wider than the column is split where it overflows
+                        lineEnd = i;
+                        nextLine = i;
+                    }
+                    break;
+                }
+
+                ++lineWidth;
+            }
+
+            const bool hasStyle = !m_activeStyle.empty();
+            output.append(m_activeStyle);
+            output.append(m_text, m_position, lineEnd - m_position);
+            UpdateActiveStyle(m_position, lineEnd);
+            if (hasStyle || !m_activeStyle.empty())
+            {
+                output.append(SGR_RESET);
+            }
+            output.append(m_width - lineWidth, ' ');
+
+            // continuation lines don't start with the spaces they were broken at
+            while (nextLine < m_text.size() && m_text[nextLine] == ' ' && m_wrap)
+            {
+                ++nextLine;
+            }
+
+            m_position = nextLine;
+            ++m_linesWritten;
+            return true;
+        }
+
+    private:
+        void UpdateActiveStyle(size_t begin, size_t end)
+        {
+            for (size_t i = m_text.find('\x1b', begin); i < end; i = m_text.find('\x1b', i + 1))
+            {
+                const size_t sequenceEnd = std::min(m_text.find('m', i), m_text.size() - 1);
+                if (m_text.compare(i, sequenceEnd - i + 1, SGR_RESET) == 0)
+                {
+                    m_activeStyle.clear();
+                }
+                else
+                {
+                    m_activeStyle.append(m_text, i, sequenceEnd - i + 1);
+                }
+            }
+        }
+
+        std::string m_text;
+        size_t m_width;
+        bool m_wrap;
+        size_t m_maxLines;
+        std::string m_activeStyle;
+        size_t m_position = 0;
+        size_t m_linesWritten = 0;
+    };
+
+    // Renders a list of elements one below the other. Only the element currently being written is realized.
+    class StackLines : public LineSource
     {
-        rowsRendered = RenderFactSet(*std::dynamic_pointer_cast<FactSet>(element), columnWidth, x, y, consoleString);
-        break;
-    }
-    default:
+    public:
+        StackLines(const std::vector<std::shared_ptr<BaseCardElement>>& items, size_t width, const ConsoleRenderOptions& options) :
+            m_items(items), m_width(width), m_options(options)
+        {
+        }
+
+        bool AppendLine(std::string& output) override
+        {
+            while (true)
+            {
+                if (m_pendingBlankLines)
+                {
+                    --m_pendingBlankLines;
+                    output.append(m_width, ' ');
+                    return true;
+                }
+
+                if (m_pendingSeparator)
+                {
+                    m_pendingSeparator = false;
+                    for (size_t i = 0; i < m_width; ++i)
+                    {
+                        output.append(m_options.useAnsi ? "\xE2\x94\x80" : "-");
+                    }
+                    return true;
+                }
+
+                if (m_hasFirstLine)
+                {
+                    m_hasFirstLine = false;
+                    output.append(m_firstLine);
+                    return true;
+                }
+
+                if (m_current && m_current->AppendLine(output))
+                {
+                    return true;
+                }
+
+                if (!AdvanceToNextItem())
+                {
+                    return false;
+                }
+            }
+        }
+
+    private:
+        bool AdvanceToNextItem()
+        {
+            m_current.reset();
+            while (m_nextItem < m_items.size())
+            {
+                const auto& item = *m_items[m_nextItem++];
+                if (!item.GetIsVisible())
+                {
+                    continue;
+                }
+
+                auto source = CreateLineSource(item, m_width, m_options);
+                m_firstLine.clear();
+                if (!source || !source->AppendLine(m_firstLine))
+                {
+                    // elements that render nothing don't get spacing or separators either
+                    continue;
+                }
+
+                if (m_hasWrittenItem)
+                {
+                    const Spacing spacing = item.GetSpacing();
+                    m_pendingBlankLines = (spacing == Spacing::Large || spacing == Spacing::ExtraLarge || spacing == Spacing::Padding) ? 1 : 0;
+                    m_pendingSeparator = item.GetSeparator();
+                }
+
+                m_hasWrittenItem = true;
+                m_hasFirstLine = true;
+                m_current = std::move(source);
+                return true;
+            }
+            return false;
+        }
+
+        const std::vector<std::shared_ptr<BaseCardElement>>& m_items;
+        size_t m_width;
+        const ConsoleRenderOptions& m_options;
+
+        size_t m_nextItem = 0;
+        std::unique_ptr<LineSource> m_current;
+        std::string m_firstLine;
+        bool m_hasFirstLine = false;
+        bool m_hasWrittenItem = false;
+        size_t m_pendingBlankLines = 0;
+        bool m_pendingSeparator = false;
+    };
+
+    // Places cells side by side. Each row is as tall as its tallest cell; shorter cells are padded with blank space.
+    class RowLines : public LineSource
     {
-        auto unimplText = ConvertToVector("Unimplemented: " + AdaptiveSharedNamespace::CardElementTypeToString(element->GetElementType()), columnWidth);
-        CompositeVector(consoleString, unimplText, columnWidth, x, y);
-        rowsRendered = unimplText.size();
-        break;
-    }
-    }
+    public:
+        RowLines(const std::string& gap) : m_gap(gap) {}
 
-    return rowsRendered;
-}
+        void AddCell(std::unique_ptr<LineSource> source, size_t width)
+        {
+            m_cells.push_back({std::move(source), width});
+        }
 
-size_t RenderElements(std::vector<std::shared_ptr<BaseCardElement>> elements,  size_t columnWidth, size_t x, size_t y, std::vector<std::string> &consoleString)
-{
-    for (auto element : elements)
+        bool AppendLine(std::string& output) override
+        {
+            const size_t rowStart = output.size();
+            bool anyCellWritten = false;
+            for (size_t i = 0; i < m_cells.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    output.append(m_gap);
+                }
+
+                auto& cell = m_cells[i];
+                if (cell.source && cell.source->AppendLine(output))
+                {
+                    anyCellWritten = true;
+                }
+                else
+                {
+                    cell.source.reset();
+                    output.append(cell.width, ' ');
+                }
+            }
+
+            if (!anyCellWritten)
+            {
+                output.resize(rowStart);
+            }
+            return anyCellWritten;
+        }
+
+    private:
+        struct Cell
+        {
+            std::unique_ptr<LineSource> source;
+            size_t width;
+        };
+
+        std::string m_gap;
+        std::vector<Cell> m_cells;
+    };
+
+    std::unique_ptr<LineSource> CreateColumnSetLines(const ColumnSet& columnSet, size_t width, const ConsoleRenderOptions& options)
     {
-        y += RenderElement(element, columnWidth, x, y, consoleString);
+        std::vector<const Column*> columns;
+        for (const auto& column : columnSet.GetColumns())
+        {
+            if (column->GetIsVisible())
+            {
+                columns.push_back(column.get());
+            }
+        }
+
+        if (columns.empty())
+        {
+            return nullptr;
+        }
+
+        const std::string gap = options.useAnsi ? " \xE2\x94\x82 " : " | ";
+        const size_t gapWidth = 3;
+        const size_t gapsWidth = gapWidth * (columns.size() - 1);
+        const size_t available = (width > gapsWidth + columns.size()) ? width - gapsWidth : columns.size();
+
+        // explicit pixel widths are converted to cells; everything else shares the remaining space by weight
+        size_t fixedWidth = 0;
+        double totalWeight = 0;
+        std::vector<double> weights;
+        for (const auto column : columns)
+        {
+            const double weight = std::atof(column->GetWidth().c_str());
+            weights.push_back((weight > 0) ? weight : 1.0);
+            if (column->GetPixelWidth())
+            {
+                fixedWidth += std::max(1U, column->GetPixelWidth() / c_pixelsPerCell);
+            }
+            else
+            {
+                totalWeight += weights.back();
+            }
+        }
+
+        const size_t remaining = (available > fixedWidth) ? available - fixedWidth : 0;
+        std::vector<size_t> widths;
+        size_t usedWidth = 0;
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            size_t columnWidth = columns[i]->GetPixelWidth() ? std::max(1U, columns[i]->GetPixelWidth() / c_pixelsPerCell) :
+                                                               static_cast<size_t>(remaining * weights[i] / totalWeight);
+            columnWidth = std::max<size_t>(1, std::min(columnWidth, available - std::min(available, usedWidth)));
+            widths.push_back(columnWidth);
+            usedWidth += columnWidth;
+        }
+
+        // rounding leftovers go to the last column so rows are always exactly the requested width
+        widths.back() += available - std::min(available, usedWidth);
+
+        auto row = std::make_unique<RowLines>(gap);
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            row->AddCell(std::make_unique<StackLines>(columns[i]->GetItems(), widths[i], options), widths[i]);
+        }
+        return row;
     }
-    return y;
-}
 
-size_t RenderColumn(Column &column, size_t columnWidth, size_t x, size_t y, std::vector<std::string> &consoleString)
-{
-    // first, build column
-    std::vector<std::string> columnText;
-    size_t columnY = 0;
-    for (auto item : column.GetItems())
+    class FactSetLines : public LineSource
     {
-        columnY += RenderElement(item, columnWidth, 0, columnY, columnText);
-    }
+    public:
+        FactSetLines(const FactSet& factSet, size_t width, const ConsoleRenderOptions& options) :
+            m_facts(factSet.GetFacts()), m_width(width), m_options(options)
+        {
+            size_t longestTitle = 0;
+            for (const auto& fact : m_facts)
+            {
+                const auto title = fact->GetTitle();
+                longestTitle = std::max(longestTitle, DisplayWidth(title, 0, title.size()));
+            }
 
-    // composite column into place
-    CompositeVector(consoleString, columnText, columnWidth, x, y);
-    return columnY;
-}
+            m_titleWidth = std::max<size_t>(1, std::min(longestTitle, (m_width > c_gapWidth) ? (m_width - c_gapWidth) / 2 : 0));
+            m_valueWidth = (m_width > m_titleWidth + c_gapWidth) ? m_width - m_titleWidth - c_gapWidth : 1;
+        }
 
-size_t RenderFact(Fact &set, size_t columnWidth, size_t x, size_t y, std::vector<std::string> &consoleString)
-{
-    const size_t itemWidth = (columnWidth / 2) - 1;
-    auto titleBlock = ConvertToVector(set.GetTitle(), itemWidth);
-    auto valueBlock = ConvertToVector(set.GetValue(), itemWidth);
+        bool AppendLine(std::string& output) override
+        {
+            while (true)
+            {
+                if (m_currentRow && m_currentRow->AppendLine(output))
+                {
+                    return true;
+                }
+
+                if (m_nextFact >= m_facts.size())
+                {
+                    return false;
+                }
+
+                const auto& fact = *m_facts[m_nextFact++];
+                std::string title;
+                std::string value;
+                AppendSanitized(title, FormatText(fact.GetTitle()));
+                AppendSanitized(value, FormatText(fact.GetValue()));
+
+                m_currentRow = std::make_unique<RowLines>(std::string(c_gapWidth, ' '));
+                m_currentRow->AddCell(std::make_unique<TextLines>(std::move(title), m_titleWidth, true, 0, m_options.useAnsi ? ESC "[1m" : ""),
+                                      m_titleWidth);
+                m_currentRow->AddCell(std::make_unique<TextLines>(std::move(value), m_valueWidth), m_valueWidth);
+            }
+        }
 
-    CompositeVector(consoleString, titleBlock, itemWidth, x, y);
-    CompositeVector(consoleString, valueBlock, itemWidth, x + itemWidth + 1, y);
-    return std::max(titleBlock.size(), valueBlock.size());
-}
+    private:
+        static constexpr size_t c_gapWidth = 2;
 
-size_t RenderFactSet(FactSet &set, size_t columnWidth, size_t x, size_t y, std::vector<std::string> &consoleString)
-{
-    size_t cRows = 0;
-    for (auto fact : set.GetFacts())
+        const std::vector<std::shared_ptr<Fact>>& m_facts;
+        size_t m_width;
+        const ConsoleRenderOptions& m_options;
+        size_t m_titleWidth;
+        size_t m_valueWidth;
+        size_t m_nextFact = 0;
+        std::unique_ptr<RowLines> m_currentRow;
+    };
+
+    // Lays out actions as buttons, as many per line as fit.
+    class ActionLines : public LineSource
     {
-        cRows += RenderFact(*fact, columnWidth, x, y+cRows, consoleString);
-    }
-    return cRows;
-}
+    public:
+        ActionLines(const std::vector<std::shared_ptr<BaseActionElement>>& actions, size_t width) : m_width(width)
+        {
+            for (const auto& action : actions)
+            {
+                std::string button = "[ ";
+                AppendSanitized(button, action->GetTitle());
+                std::replace(button.begin(), button.end(), '\n', ' ');
+                button.append(" ]");
+                m_buttons.push_back(std::move(button));
+            }
+        }
 
-size_t RenderColumnSet(ColumnSet &set, size_t columnWidth, size_t x, size_t y, std::vector<std::string> &consoleString)
-{
-    auto columns = set.GetColumns();
-    const auto cCols = columns.size();
-    size_t maxY = 0;
-    const size_t individualWidth = (columnWidth / cCols) - 3;
+        bool AppendLine(std::string& output) override
+        {
+            if (m_nextButton >= m_buttons.size())
+            {
+                return false;
+            }
 
-    for (size_t i = 0; i < cCols; i++)
+            size_t lineWidth = 0;
+            while (m_nextButton < m_buttons.size())
+            {
+                const auto& button = m_buttons[m_nextButton];
+                const size_t buttonWidth = DisplayWidth(button, 0, button.size());
+                const size_t separatorWidth = lineWidth ? 1 : 0;
+                if (lineWidth && lineWidth + separatorWidth + buttonWidth > m_width)
+                {
+                    break;
+                }
+
+                if (separatorWidth)
+                {
+                    output.push_back(' ');
+                }
+
+                if (buttonWidth > m_width)
+                {
+                    // a lone button wider than the line is truncated
+                    TextLines(button, m_width - lineWidth, false).AppendLine(output);
+                    lineWidth = m_width;
+                }
+                else
+                {
+                    output.append(button);
+                    lineWidth += separatorWidth + buttonWidth;
+                }
+                ++m_nextButton;
+            }
+
+            output.append(m_width - lineWidth, ' ');
+            return true;
+        }
+
+    private:
+        std::vector<std::string> m_buttons;
+        size_t m_width;
+        size_t m_nextButton = 0;
+    };
+
+    // Input fields are drawn as bracketed boxes holding their value, or their placeholder dimmed.
+    std::unique_ptr<LineSource> CreateFieldLines(const std::string& value,
+                                                 const std::string& placeholder,
+                                                 size_t width,
+                                                 size_t rows,
+                                                 const ConsoleRenderOptions& options)
     {
-        maxY = std::max(maxY, RenderElement(columns[i], individualWidth, x + (i * individualWidth) + (i ? 1 : 0), y, consoleString));
-    }
-    return maxY;
-}
+        const size_t innerWidth = (width > 2) ? width - 2 : 1;
+        const bool showPlaceholder = value.empty();
+        std::string content;
+        AppendSanitized(content, showPlaceholder ? placeholder : value);
+        std::replace(content.begin(), content.end(), '\n', ' ');
+
+        std::string leftEdge = "[";
+        std::string rightEdge = "]";
+        for (size_t i = 1; i < rows; ++i)
+        {
+            leftEdge.append("\n[");
+            rightEdge.append("\n]");
+        }
 
-void VTSaveCursor()
-{
-    printf(ESC "7");
-}
+        auto row = std::make_unique<RowLines>("");
+        row->AddCell(std::make_unique<TextLines>(std::move(leftEdge), 1), 1);
+        row->AddCell(std::make_unique<TextLines>(std::move(content), innerWidth, rows > 1, rows, (showPlaceholder && options.useAnsi) ? ESC "[2m" : ""),
+                     innerWidth);
+        row->AddCell(std::make_unique<TextLines>(std::move(rightEdge), 1), 1);
+        return row;
+    }
 
-void VTRestoreCursor()
-{
-    printf(ESC "8");
-}
+    std::string GetRichTextBlockText(const RichTextBlock& richTextBlock, const ConsoleRenderOptions& options)
+    {
+        std::string text;
+        for (const auto& inlineElement : richTextBlock.GetInlines())
+        {
+            if (inlineElement->GetInlineType() != InlineElementType::TextRun)
+            {
+                continue;
+            }
 
-void VTSetCursorPos(size_t x, size_t y)
-{
-    printf(ESC "[%d;%dH", (unsigned int)y, (unsigned int)x);
-}
+            const auto& textRun = static_cast<const TextRun&>(*inlineElement);
+            std::string style;
+            if (options.useAnsi)
+            {
+                style = GetTextSequence(textRun.GetTextWeight(), textRun.GetTextSize(), textRun.GetTextColor(), textRun.GetIsSubtle());
+                if (textRun.GetItalic())
+                {
+                    style.append(ESC "[3m");
+                }
+                if (textRun.GetUnderline())
+                {
+                    style.append(ESC "[4m");
+                }
+                if (textRun.GetStrikethrough())
+                {
+                    style.append(ESC "[9m");
+                }
+            }
 
-void RenderAsColumn(const std::string &consoleString, size_t x, size_t y, size_t width)
-{
-    VTSaveCursor();
+            text.append(style);
+            AppendSanitized(text, FormatText(textRun.GetText()));
+            if (!style.empty())
+            {
+                text.append(SGR_RESET);
+            }
+        }
+        return text;
+    }
 
-    VTSetCursorPos(x, y);
-    size_t charsEmitted = 0;
-    size_t currOffset = 0;
-    for (char currChar : consoleString)
+    std::unique_ptr<LineSource> CreateLineSource(const BaseCardElement& element, size_t width, const ConsoleRenderOptions& options)
     {
-        if (currChar == '\n')
+        switch (element.GetElementType())
+        {
+        case CardElementType::TextBlock:
         {
-            charsEmitted = 0;
-            currOffset += 2;
-            VTSetCursorPos(x, y + currOffset);
+            const auto& textBlock = static_cast<const TextBlock&>(element);
+            std::string text;
+            AppendSanitized(text, FormatText(textBlock.GetText()));
+            const std::string style =
+                options.useAnsi ?
+                    GetTextSequence(textBlock.GetTextWeight(), textBlock.GetTextSize(), textBlock.GetTextColor(), textBlock.GetIsSubtle()) :
+                    "";
+            return std::make_unique<TextLines>(std::move(text), width, textBlock.GetWrap(), textBlock.GetMaxLines(), style);
         }
-        else
+        case CardElementType::RichTextBlock:
+            return std::make_unique<TextLines>(GetRichTextBlockText(static_cast<const RichTextBlock&>(element), options), width);
+        case CardElementType::Container:
+            return std::make_unique<StackLines>(static_cast<const Container&>(element).GetItems(), width, options);
+        case CardElementType::Column:
+            return std::make_unique<StackLines>(static_cast<const Column&>(element).GetItems(), width, options);
+        case CardElementType::ColumnSet:
+            return CreateColumnSetLines(static_cast<const ColumnSet&>(element), width, options);
+        case CardElementType::FactSet:
+            return std::make_unique<FactSetLines>(static_cast<const FactSet&>(element), width, options);
+        case CardElementType::Image:
         {
-            if (charsEmitted == 0 && isspace(currChar))
+            const auto& image = static_cast<const Image&>(element);
+            std::string text = "[image";
+            const auto altText = image.GetAltText();
+            if (!altText.empty())
             {
-                continue;
+                text.append(": ");
+                AppendSanitized(text, altText);
+            }
+            text.append("]");
+            return std::make_unique<TextLines>(std::move(text), width, false);
+        }
+        case CardElementType::ImageSet:
+        {
+            const auto imageCount = static_cast<const ImageSet&>(element).GetImages().size();
+            return std::make_unique<TextLines>("[" + std::to_string(imageCount) + " images]", width, false);
+        }
+        case CardElementType::Media:
+        {
+            std::string text = "[media";
+            const auto altText = static_cast<const Media&>(element).GetAltText();
+            if (!altText.empty())
+            {
+                text.append(": ");
+                AppendSanitized(text, altText);
+            }
+            text.append("]");
+            return std::make_unique<TextLines>(std::move(text), width, false);
+        }
+        case CardElementType::ActionSet:
+            return std::make_unique<ActionLines>(static_cast<const ActionSet&>(element).GetActions(), width);
+        case CardElementType::TextInput:
+        {
+            const auto& textInput = static_cast<const TextInput&>(element);
+            return CreateFieldLines(
+                textInput.GetValue(), textInput.GetPlaceholder(), width, textInput.GetIsMultiline() ? c_multilineInputRows : 1, options);
+        }
+        case CardElementType::NumberInput:
+        {
+            // the object model reports 0 when no value was given
+            const auto& numberInput = static_cast<const NumberInput&>(element);
+            const std::string value = numberInput.GetValue() ? std::to_string(numberInput.GetValue()) : "";
+            return CreateFieldLines(value, numberInput.GetPlaceholder(), width, 1, options);
+        }
+        case CardElementType::DateInput:
+        {
+            const auto& dateInput = static_cast<const DateInput&>(element);
+            return CreateFieldLines(dateInput.GetValue(), dateInput.GetPlaceholder(), width, 1, options);
+        }
+        case CardElementType::TimeInput:
+        {
+            const auto& timeInput = static_cast<const TimeInput&>(element);
+            return CreateFieldLines(timeInput.GetValue(), timeInput.GetPlaceholder(), width, 1, options);
+        }
+        case CardElementType::ToggleInput:
+        {
+            const auto& toggleInput = static_cast<const ToggleInput&>(element);
+            std::string text = (toggleInput.GetValue() == toggleInput.GetValueOn()) ? "[x] " : "[ ] ";
+            AppendSanitized(text, toggleInput.GetTitle());
+            return std::make_unique<TextLines>(std::move(text), width, toggleInput.GetWrap());
+        }
+        case CardElementType::ChoiceSetInput:
+        {
+            const auto& choiceSet = static_cast<const ChoiceSetInput&>(element);
+
+            // values of multi-select choice sets are comma separated
+            const std::string value = "," + choiceSet.GetValue() + ",";
+            const auto isSelected = [&value](const ChoiceInput& choice) {
+                return value.find("," + choice.GetValue() + ",") != std::string::npos;
+            };
+
+            if (choiceSet.GetChoiceSetStyle() == ChoiceSetStyle::Compact && !choiceSet.GetIsMultiSelect())
+            {
+                std::string selected;
+                for (const auto& choice : choiceSet.GetChoices())
+                {
+                    if (isSelected(*choice))
+                    {
+                        selected = choice->GetTitle();
+                        break;
+                    }
+                }
+                return CreateFieldLines(selected, "Select", width, 1, options);
+            }
+
+            std::string text;
+            for (const auto& choice : choiceSet.GetChoices())
+            {
+                if (!text.empty())
+                {
+                    text.push_back('\n');
+                }
+
+                const bool selected = isSelected(*choice);
+                if (choiceSet.GetIsMultiSelect())
+                {
+                    text.append(selected ? "[x] " : "[ ] ");
+                }
+                else
+                {
+                    text.append(selected ? "(*) " : "( ) ");
+                }
+                AppendSanitized(text, choice->GetTitle());
             }
-            putchar(currChar);
-            charsEmitted++;
-            if (charsEmitted >= width)
+            return std::make_unique<TextLines>(std::move(text), width, choiceSet.GetWrap());
+        }
+        case CardElementType::Unknown:
+        case CardElementType::Custom:
+        default:
+        {
+            if (element.GetFallbackType() == FallbackType::Content)
             {
-                charsEmitted = 0;
-                currOffset++;
-                VTSetCursorPos(x, y + currOffset);
+                const auto fallback = std::static_pointer_cast<BaseCardElement>(element.GetFallbackContent());
+                return CreateLineSource(*fallback, width, options);
             }
+            return nullptr;
+        }
         }
     }
 
-    VTRestoreCursor();
-}
+    // The card's body followed by its actions, separated by a blank line.
+    class CardLines : public LineSource
+    {
+    public:
+        CardLines(const AdaptiveCard& card, size_t width, const ConsoleRenderOptions& options) :
+            m_body(card.GetBody(), width, options), m_actions(card.GetActions(), width), m_width(width)
+        {
+        }
 
-#define LR_BORDER "\x1b(0x\x1b(B"
+        bool AppendLine(std::string& output) override
+        {
+            if (m_inBody)
+            {
+                if (m_body.AppendLine(output))
+                {
+                    m_wroteBody = true;
+                    return true;
+                }
+                m_inBody = false;
+
+                std::string firstActionLine;
+                if (m_actions.AppendLine(firstActionLine))
+                {
+                    if (m_wroteBody)
+                    {
+                        m_pendingActionLine = std::move(firstActionLine);
+                        output.append(m_width, ' ');
+                        return true;
+                    }
+                    output.append(firstActionLine);
+                    return true;
+                }
+                return false;
+            }
 
-void RenderBorder(std::vector<std::string> &output, size_t columnWidth)
-{
-    std::string top;
-    top.append(ESC "(0");
-    top.append("l");
-    for (unsigned int i = 0; i < columnWidth - 1; i++)
+            if (!m_pendingActionLine.empty())
+            {
+                output.append(m_pendingActionLine);
+                m_pendingActionLine.clear();
+                return true;
+            }
+            return m_actions.AppendLine(output);
+        }
+
+    private:
+        StackLines m_body;
+        ActionLines m_actions;
+        size_t m_width;
+        bool m_inBody = true;
+        bool m_wroteBody = false;
+        std::string m_pendingActionLine;
+    };
+
+    void AppendBorderRow(std::string& output, const char* left, const char* fill, const char* right, size_t width)
     {
-        top.append("q");
+        output.append(left);
+        for (size_t i = 2; i < width; ++i)
+        {
+            output.append(fill);
+        }
+        output.append(right);
     }
-    top.append("k");
-    top.append(ESC "(B");
+}
 
-    for (auto &row : output)
+void RenderToConsole(const AdaptiveCard& card, const ConsoleRenderOptions& options, std::ostream& output)
+{
+    // "│ " and " │" on either side of the content
+    const size_t borderWidth = 4;
+    const size_t width = std::max<size_t>(options.width, borderWidth + 1);
+    const size_t contentWidth = options.drawBorder ? width - borderWidth : width;
+
+    const char* const horizontal = options.useAnsi ? "\xE2\x94\x80" : "-";
+    const char* const vertical = options.useAnsi ? "\xE2\x94\x82" : "|";
+
+    std::string line;
+    if (options.drawBorder)
     {
-        row.resize(columnWidth-1, ' ');
-        row.insert(0, LR_BORDER);
-        row.append(LR_BORDER);
+        AppendBorderRow(line, options.useAnsi ? "\xE2\x94\x8C" : "+", horizontal, options.useAnsi ? "\xE2\x94\x90" : "+", width);
+        output << line << '\n';
     }
 
-    std::string bottom;
-    bottom.append(ESC "(0");
-    bottom.append("m");
-    for (unsigned int i = 0; i < columnWidth - 1; i++)
+    CardLines cardLines(card, contentWidth, options);
+    while (true)
     {
-        bottom.append("q");
+        line.clear();
+        if (options.drawBorder)
+        {
+            line.append(vertical).push_back(' ');
+        }
+
+        if (!cardLines.AppendLine(line))
+        {
+            break;
+        }
+
+        if (options.drawBorder)
+        {
+            line.push_back(' ');
+            line.append(vertical);
+        }
+        output << line << '\n';
     }
-    bottom.append("j");
-    bottom.append(ESC "(B");
 
-    output[0] = top;
-    //output.insert(output.begin(), top);
-    output.push_back(bottom);
+    if (options.drawBorder)
+    {
+        line.clear();
+        AppendBorderRow(line, options.useAnsi ? "\xE2\x94\x94" : "+", horizontal, options.useAnsi ? "\xE2\x94\x98" : "+", width);
+        output << line << '\n';
+    }
 }
 
-void RenderToConsole(std::shared_ptr<AdaptiveSharedNamespace::AdaptiveCard> card, size_t columnWidth, std::vector<std::string> &output)
+void RenderToConsole(std::shared_ptr<AdaptiveSharedNamespace::AdaptiveCard> card, size_t columnWidth, std::vector<std::string>& output)
 {
-    std::vector<std::string> outputVector;
-    auto body = card->GetBody();
-    RenderElements(body, columnWidth-4, 1, 1, output); // save 4 width for border
-    RenderBorder(output, columnWidth);
-    //printf("\n\n\n");
-
-    //RenderAsColumn("Some sample text. Let's see how we do!\n Should be exciting."s, 10, 10, 10);
-    //RenderAsColumn("More samples... This should be rendered to the right of.\n\n<-- That one."s, 21, 10, 10);
+    ConsoleRenderOptions options;
+    options.width = columnWidth;
 
-    //auto output = ConvertToVector("Some sample text. Let's see how we do!\n Should be exciting."s, 10);
-    //auto output2 = ConvertToVector("More samples... This should be rendered to the right of.\n\n<-- That one."s, 10);
+    std::ostringstream stream;
+    RenderToConsole(*card, options, stream);
 
-    /*CompositeVector(outputVector, output, 1, 1);
-    CompositeVector(outputVector, output2, 12, 3);*/
+    std::istringstream lines(stream.str());
+    for (std::string line; std::getline(lines, line);)
+    {
+        output.push_back(line);
+    }
 }
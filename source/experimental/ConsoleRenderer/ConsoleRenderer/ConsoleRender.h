@@ -2,4 +2,23 @@
 // Licensed under the MIT License.
 #pragma once
 
-void RenderToConsole(std::shared_ptr<AdaptiveSharedNamespace::AdaptiveCard> card, size_t columnWidth, std::vector<std::string> &output);
+#include <ostream>
+#include "SharedAdaptiveCard.h"
+
+struct ConsoleRenderOptions
+{
+    // Total width of the output in terminal cells, including the border.
+    size_t width = 120;
+
+    // Emit ANSI SGR sequences for bold and colored text.
+    bool useAnsi = true;
+
+    // Draw a box around the card. Without it the card's content fills the full width.
+    bool drawBorder = true;
+};
+
+// Renders a card as plain text (optionally with ANSI styling) to the given stream. Lines are produced top to bottom and
+// written as soon as they're complete, so memory use is bounded by the card's nesting depth rather than its length.
+void RenderToConsole(const AdaptiveSharedNamespace::AdaptiveCard& card, const ConsoleRenderOptions& options, std::ostream& output);
+
+void RenderToConsole(std::shared_ptr<AdaptiveSharedNamespace::AdaptiveCard> card, size_t columnWidth, std::vector<std::string>& output);
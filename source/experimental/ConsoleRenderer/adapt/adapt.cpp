@@ -1,9 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "stdafx.h"
+#include <cstring>
+#include <iostream>
 
 using namespace AdaptiveSharedNamespace;
 
+#ifdef _WIN32
 DWORD SetConsoleModeForDisplay()
 {
     DWORD dwRet = 0;
@@ -27,21 +30,56 @@ void RestoreConsoleModeForDisplay(DWORD dwRestore)
         SetConsoleMode(hOut, dwRestore);
     }
 }
+#endif
 
-int main(int /*argc*/, char *argv[])
+int main(int argc, char *argv[])
 {
-    DWORD dwOld = SetConsoleModeForDisplay();
+    ConsoleRenderOptions options;
+    const char* cardFile = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--width") == 0 && (i + 1) < argc)
+        {
+            options.width = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--plain") == 0)
+        {
+            options.useAnsi = false;
+        }
+        else if (strcmp(argv[i], "--no-border") == 0)
+        {
+            options.drawBorder = false;
+        }
+        else
+        {
+            cardFile = argv[i];
+        }
+    }
 
-    auto parseResult = AdaptiveCard::DeserializeFromFile(argv[1], "1.1");
+    if (!cardFile)
+    {
+        fprintf(stderr, "usage: adapt [--width <columns>] [--plain] [--no-border] <card.json>\n");
+        return 1;
+    }
 
-    std::vector<std::string> result;
-    RenderToConsole(parseResult->GetAdaptiveCard(), 120U, result);
-    for (auto row : result)
+#ifdef _WIN32
+    DWORD dwOld = SetConsoleModeForDisplay();
+#endif
+
+    int result = 0;
+    try
+    {
+        auto parseResult = AdaptiveCard::DeserializeFromFile(cardFile, "1.3");
+        RenderToConsole(*parseResult->GetAdaptiveCard(), options, std::cout);
+    }
+    catch (const AdaptiveCardParseException& e)
     {
-        printf(row.c_str());
-        printf("\n");
+        fprintf(stderr, "%s: %s\n", cardFile, e.what());
+        result = 1;
     }
 
+#ifdef _WIN32
     RestoreConsoleModeForDisplay(dwOld);
-    return 0;
+#endif
+    return result;
 }
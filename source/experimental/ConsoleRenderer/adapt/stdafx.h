@@ -7,13 +7,16 @@
 
 #pragma once
 
+#include <stdio.h>
+
+#ifdef _WIN32
 #include "targetver.h"
 
-#include <stdio.h>
 #include <tchar.h>
 
 #include <windows.h>
 #include <wincon.h>
+#endif
 
 // TODO: reference additional headers your program requires here
 #include "SharedAdaptiveCard.h"
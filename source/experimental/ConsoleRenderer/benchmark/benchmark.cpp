@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include "SharedAdaptiveCard.h"
+#include "ConsoleRender.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// Discards output while counting it, so the benchmark measures rendering rather than I/O.
+class CountingStreamBuffer : public std::streambuf
+{
+public:
+    size_t count = 0;
+
+protected:
+    std::streamsize xsputn(const char*, std::streamsize n) override
+    {
+        count += static_cast<size_t>(n);
+        return n;
+    }
+
+    int_type overflow(int_type ch) override
+    {
+        ++count;
+        return ch;
+    }
+};
+
+// Parses every card iterations times, keeping all of the results alive, then releases them. Reports the time taken by each
+// phase in milliseconds.
+void TimeParseAndDestroy(const std::vector<std::string>& cardJsons, unsigned int iterations, bool useArena, double& parseMs, double& destroyMs)
+{
+    std::vector<std::shared_ptr<ParseResult>> results;
+    results.reserve(cardJsons.size() * iterations);
+
+    const auto parseStart = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        for (const auto& cardJson : cardJsons)
+        {
+            ParseContext context;
+            if (useArena)
+            {
+                context.SetArena(std::make_shared<ParseArena>());
+            }
+            results.push_back(AdaptiveCard::DeserializeFromString(cardJson, "1.3", context));
+        }
+    }
+    const auto parseEnd = std::chrono::steady_clock::now();
+    results.clear();
+    const auto destroyEnd = std::chrono::steady_clock::now();
+
+    parseMs = std::chrono::duration<double, std::milli>(parseEnd - parseStart).count();
+    destroyMs = std::chrono::duration<double, std::milli>(destroyEnd - parseEnd).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const char* samplesPath = nullptr;
+    unsigned int iterations = 20;
+    ConsoleRenderOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--width") == 0 && (i + 1) < argc)
+        {
+            options.width = strtoul(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            samplesPath = argv[i];
+        }
+    }
+
+    if (!samplesPath)
+    {
+        std::cerr << "usage: adapt_benchmark [--iterations <n>] [--width <columns>] <samples directory>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::shared_ptr<AdaptiveCard>> cards;
+    std::vector<std::string> cardJsons;
+    size_t skipped = 0;
+    const auto parseStart = std::chrono::steady_clock::now();
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(samplesPath))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        try
+        {
+            std::ifstream file(entry.path());
+            std::stringstream cardJson;
+            cardJson << file.rdbuf();
+            auto parseResult = AdaptiveCard::DeserializeFromString(cardJson.str(), "1.3");
+            cards.push_back(parseResult->GetAdaptiveCard());
+            cardJsons.push_back(cardJson.str());
+        }
+        catch (const std::exception&)
+        {
+            // host configs and other non-card json
+            ++skipped;
+        }
+    }
+    const auto parseEnd = std::chrono::steady_clock::now();
+
+    if (cards.empty())
+    {
+        std::cerr << "no cards found under " << samplesPath << std::endl;
+        return 1;
+    }
+
+    CountingStreamBuffer counter;
+    std::ostream output(&counter);
+
+    const auto renderStart = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        for (const auto& card : cards)
+        {
+            RenderToConsole(*card, options, output);
+        }
+    }
+    const auto renderEnd = std::chrono::steady_clock::now();
+
+    const double parseMs = std::chrono::duration<double, std::milli>(parseEnd - parseStart).count();
+    const double renderMs = std::chrono::duration<double, std::milli>(renderEnd - renderStart).count();
+    const size_t renders = cards.size() * iterations;
+
+    std::cout << cards.size() << " cards (" << skipped << " files skipped), loaded and parsed in " << parseMs << " ms" << std::endl;
+    for (bool useArena : {false, true})
+    {
+        double parseMs;
+        double destroyMs;
+        TimeParseAndDestroy(cardJsons, iterations, useArena, parseMs, destroyMs);
+        std::cout << (useArena ? "arena" : "heap ") << " parse " << (parseMs * 1000.0 / renders) << " us/card, destroy "
+                  << (destroyMs * 1000.0 / renders) << " us/card" << std::endl;
+    }
+    std::cout << iterations << " iterations at width " << options.width << ": " << renderMs << " ms, "
+              << (renderMs * 1000.0 / renders) << " us/card, " << (counter.count / renders) << " bytes/card" << std::endl;
+    return 0;
+}
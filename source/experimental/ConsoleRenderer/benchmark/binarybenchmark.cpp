@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "BinaryCardFormat.h"
+#include "ParseUtil.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// Runs f on every card iterations times and returns the time per card in microseconds
+template<typename F> double TimeUs(unsigned int iterations, size_t cardCount, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        for (size_t card = 0; card < cardCount; card++)
+        {
+            f(card);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / (iterations * cardCount);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* samplesPath = nullptr;
+    unsigned int iterations = 20;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            samplesPath = argv[i];
+        }
+    }
+
+    if (!samplesPath)
+    {
+        std::cerr << "usage: adapt_binary_benchmark [--iterations <n>] <samples directory>" << std::endl;
+        return 1;
+    }
+
+    // Each card as Serialize() writes it, so both forms hold the same content
+    std::vector<std::shared_ptr<AdaptiveCard>> cards;
+    std::vector<std::string> jsons;
+    std::vector<std::vector<uint8_t>> binaries;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(samplesPath))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        try
+        {
+            std::ifstream file(entry.path());
+            std::stringstream cardJson;
+            cardJson << file.rdbuf();
+            cards.push_back(AdaptiveCard::DeserializeFromString(cardJson.str(), "1.3")->GetAdaptiveCard());
+        }
+        catch (const std::exception&)
+        {
+            // host configs and other non-card json
+            continue;
+        }
+        jsons.push_back(cards.back()->Serialize());
+        binaries.push_back(cards.back()->SerializeBinary());
+    }
+
+    if (cards.empty())
+    {
+        std::cerr << "no cards found under " << samplesPath << std::endl;
+        return 1;
+    }
+
+    size_t jsonBytes = 0;
+    size_t binaryBytes = 0;
+    for (size_t i = 0; i < cards.size(); i++)
+    {
+        jsonBytes += jsons[i].size();
+        binaryBytes += binaries[i].size();
+
+        const auto roundTripped = AdaptiveCard::DeserializeBinary(binaries[i].data(), binaries[i].size(), "1.3")->GetAdaptiveCard();
+        if (roundTripped->Serialize() != AdaptiveCard::DeserializeFromString(jsons[i], "1.3")->GetAdaptiveCard()->Serialize())
+        {
+            std::cerr << "card " << i << " doesn't round trip through the binary format" << std::endl;
+            return 1;
+        }
+    }
+
+    const double writeJsonUs = TimeUs(iterations, cards.size(), [&](size_t i) { cards[i]->Serialize(); });
+    const double writeBinaryUs = TimeUs(iterations, cards.size(), [&](size_t i) { cards[i]->SerializeBinary(); });
+    const double readJsonUs = TimeUs(iterations, cards.size(), [&](size_t i) { ParseUtil::GetJsonValueFromString(jsons[i]); });
+    const double readBinaryUs =
+        TimeUs(iterations, cards.size(), [&](size_t i) { BinaryCardFormat::Read(binaries[i].data(), binaries[i].size()); });
+    const double parseJsonUs = TimeUs(iterations, cards.size(), [&](size_t i) { AdaptiveCard::DeserializeFromString(jsons[i], "1.3"); });
+    const double parseBinaryUs = TimeUs(iterations, cards.size(), [&](size_t i) {
+        AdaptiveCard::DeserializeBinary(binaries[i].data(), binaries[i].size(), "1.3");
+    });
+
+    std::cout << cards.size() << " cards, " << (jsonBytes / cards.size()) << " bytes/card as JSON, "
+              << (binaryBytes / cards.size()) << " bytes/card as binary" << std::endl;
+    std::cout << "JSON:   serialize " << writeJsonUs << " us/card, read into Json::Value " << readJsonUs
+              << " us/card, parse card " << parseJsonUs << " us/card" << std::endl;
+    std::cout << "binary: serialize " << writeBinaryUs << " us/card, read into Json::Value " << readBinaryUs
+              << " us/card, parse card " << parseBinaryUs << " us/card" << std::endl;
+    return 0;
+}
@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ChoiceInput.h"
+#include "ChoiceList.h"
+#include "ChoiceSetInput.h"
+#include "ParseUtil.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// Every allocation is prefixed with its size so the heap in use can be measured around a parse
+namespace
+{
+    const size_t c_header = alignof(std::max_align_t);
+    size_t g_bytesInUse = 0;
+}
+
+void* operator new(size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + c_header));
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    g_bytesInUse += size;
+    return block + c_header;
+}
+
+void operator delete(void* allocation) noexcept
+{
+    if (allocation != nullptr)
+    {
+        char* block = static_cast<char*>(allocation) - c_header;
+        g_bytesInUse -= *reinterpret_cast<size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* allocation, size_t) noexcept
+{
+    operator delete(allocation);
+}
+
+// A multi-select ChoiceSet of choiceCount employees, with every hundredth one selected by default
+std::string MakeCard(unsigned int choiceCount)
+{
+    std::string value;
+    std::string choices;
+    for (unsigned int i = 0; i < choiceCount; i++)
+    {
+        const std::string id = "employee" + std::to_string(i);
+        choices += (i == 0) ? "" : ",";
+        choices += R"({"title": "Employee )" + std::to_string((i * 7919) % choiceCount) + R"(", "value": ")" + id + R"("})";
+        if (i % 100 == 0)
+        {
+            value += (value.empty() ? "" : ",") + id;
+        }
+    }
+    return R"({"type": "AdaptiveCard", "version": "1.2", "body": [{"type": "Input.ChoiceSet", "id": "people", "isMultiSelect": true, "value": ")" +
+           value + R"(", "choices": [)" + choices + "]}]}";
+}
+
+// The first call is left out: the heap may still be settling after the parse freed the card's json
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    f();
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int choiceCount = 50000;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--choices") == 0 && (i + 1) < argc)
+        {
+            choiceCount = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_choice_benchmark [--choices <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string json = MakeCard(choiceCount);
+    const std::string prefix = "employee 12";
+
+    size_t selectedCounts[2] = {};
+    size_t matchCounts[2] = {};
+    for (const bool compact : {false, true})
+    {
+        ParseContext context;
+        context.SetCompactChoiceThreshold(compact ? 1000 : 0);
+
+        const size_t bytesBefore = g_bytesInUse;
+        const auto start = std::chrono::steady_clock::now();
+        auto card = AdaptiveCard::DeserializeFromString(json, "1.2", context)->GetAdaptiveCard();
+        const auto end = std::chrono::steady_clock::now();
+        const size_t bytes = g_bytesInUse - bytesBefore;
+
+        const auto choiceSet = std::static_pointer_cast<const ChoiceSetInput>(card->GetBody().at(0));
+        const auto choiceList = choiceSet->GetChoiceList();
+        if (compact != (choiceList != nullptr))
+        {
+            std::cerr << "unexpected choice storage" << std::endl;
+            return 1;
+        }
+
+        // Resolving the default value and filtering by title, by scanning the ChoiceInputs or through the indexes
+        const unsigned int iterations = 20;
+        double resolveUs, filterUs;
+        if (compact)
+        {
+            resolveUs = TimeUs(iterations, [&]() { selectedCounts[1] = choiceList->FindValues(choiceSet->GetValue()).size(); });
+            filterUs = TimeUs(iterations, [&]() { matchCounts[1] = choiceList->FindTitlesWithPrefix(prefix, 50).size(); });
+        }
+        else
+        {
+            resolveUs = TimeUs(iterations, [&]() {
+                std::vector<size_t> selected;
+                std::istringstream values(choiceSet->GetValue());
+                std::string value;
+                while (std::getline(values, value, ','))
+                {
+                    const auto& choices = choiceSet->GetChoices();
+                    for (size_t i = 0; i < choices.size(); i++)
+                    {
+                        if (choices[i]->GetValue() == value)
+                        {
+                            selected.push_back(i);
+                            break;
+                        }
+                    }
+                }
+                selectedCounts[0] = selected.size();
+            });
+            filterUs = TimeUs(iterations, [&]() {
+                std::vector<size_t> matches;
+                const auto& choices = choiceSet->GetChoices();
+                for (size_t i = 0; i < choices.size() && matches.size() < 50; i++)
+                {
+                    if (ParseUtil::ToLowercase(choices[i]->GetTitle()).compare(0, prefix.size(), prefix) == 0)
+                    {
+                        matches.push_back(i);
+                    }
+                }
+                matchCounts[0] = matches.size();
+            });
+        }
+
+        std::cout << choiceCount << " choices, " << (compact ? "compact: " : "objects: ") << "parse "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms, " << (bytes / 1024) << " KiB, "
+                  << (static_cast<double>(bytes) / choiceCount) << " bytes/choice; resolve value " << resolveUs << " us, filter "
+                  << filterUs << " us" << std::endl;
+    }
+
+    if (selectedCounts[0] != selectedCounts[1] || matchCounts[0] != matchCounts[1])
+    {
+        std::cerr << "compact choices disagree with ChoiceInputs" << std::endl;
+        return 1;
+    }
+    return 0;
+}
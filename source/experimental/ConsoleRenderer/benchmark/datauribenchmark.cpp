@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "AdaptiveBase64Util.h"
+#include "Image.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// Every allocation is counted, so that the benchmark can report the most memory live at once
+namespace
+{
+    std::atomic<size_t> g_liveBytes{0};
+    std::atomic<size_t> g_peakBytes{0};
+    constexpr size_t c_header = alignof(std::max_align_t);
+
+    void ResetPeak() { g_peakBytes = g_liveBytes.load(); }
+}
+
+void* operator new(size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + c_header));
+    if (!block)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+
+    const size_t live = (g_liveBytes += size);
+    size_t peak = g_peakBytes;
+    while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live))
+    {
+    }
+    return block + c_header;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer)
+    {
+        char* block = static_cast<char*>(pointer) - c_header;
+        g_liveBytes -= *reinterpret_cast<size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+struct MemoryUse
+{
+    size_t parsePeak;
+    size_t retained;
+    size_t renderPeak;
+};
+
+// Parses the card, then does what a renderer does with each image: decodes its bytes, keeping them until the card
+// is done
+MemoryUse Measure(const std::string& cardJson, size_t internThreshold)
+{
+    MemoryUse use;
+    const size_t baseline = g_liveBytes;
+    ResetPeak();
+
+    ParseContext context;
+    context.SetDataUriInternThreshold(internThreshold);
+    auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2", context)->GetAdaptiveCard();
+    use.parsePeak = g_peakBytes - baseline;
+    use.retained = g_liveBytes - baseline;
+
+    ResetPeak();
+    {
+        std::vector<std::shared_ptr<const DataUri>> sharedImages;
+        std::vector<std::vector<char>> decodedImages;
+        for (const auto& element : card->GetBody())
+        {
+            const auto& image = static_cast<const Image&>(*element);
+            if (image.GetDataUri())
+            {
+                image.GetDataUri()->GetData();
+                sharedImages.push_back(image.GetDataUri());
+            }
+            else
+            {
+                decodedImages.push_back(AdaptiveBase64Util::Decode(AdaptiveBase64Util::ExtractDataFromUri(image.GetUrl())));
+            }
+        }
+        use.renderPeak = g_peakBytes - baseline;
+    }
+    return use;
+}
+
+std::string MakeCard(unsigned int imageCount, unsigned int distinctCount, size_t imageBytes)
+{
+    std::string cardJson = R"({ "type": "AdaptiveCard", "version": "1.2", "body": [)";
+    for (unsigned int i = 0; i < imageCount; i++)
+    {
+        std::vector<char> content(imageBytes, static_cast<char>('a' + (i % distinctCount)));
+        cardJson += std::string(i == 0 ? "" : ",") + R"({ "type": "Image", "url": "data:image/png;base64,)" +
+                    AdaptiveBase64Util::Encode(content) + R"(" })";
+    }
+    return cardJson + "] }";
+}
+
+void Report(const char* name, const std::string& cardJson)
+{
+    const MemoryUse strings = Measure(cardJson, 0);
+    const MemoryUse interned = Measure(cardJson, 4096);
+    const double mb = 1024.0 * 1024.0;
+    std::cout << name << " (" << (cardJson.size() / mb) << " MB of JSON)" << std::endl;
+    std::cout << "  strings:  parse peak " << (strings.parsePeak / mb) << " MB, retained " << (strings.retained / mb)
+              << " MB, render peak " << (strings.renderPeak / mb) << " MB" << std::endl;
+    std::cout << "  interned: parse peak " << (interned.parsePeak / mb) << " MB, retained " << (interned.retained / mb)
+              << " MB, render peak " << (interned.renderPeak / mb) << " MB" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t imageKilobytes = 500;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--image-kb") == 0 && (i + 1) < argc)
+        {
+            imageKilobytes = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_datauri_benchmark [--image-kb <size of each image>]" << std::endl;
+            return 1;
+        }
+    }
+
+    // The size of the base64 text is what's inline, so size the content to make each URL imageKilobytes long
+    const size_t imageBytes = imageKilobytes * 1024 * 3 / 4;
+    Report("20 distinct images", MakeCard(20, 20, imageBytes));
+    Report("20 images, 4 distinct", MakeCard(20, 4, imageBytes));
+    return 0;
+}
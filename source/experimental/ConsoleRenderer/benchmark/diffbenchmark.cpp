@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "CardDiff.h"
+#include "ParseUtil.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// A poll with optionCount options, each a ColumnSet with the option's name and its vote count
+std::string MakePoll(unsigned int optionCount, unsigned int changedOption, unsigned int changedVotes)
+{
+    std::string options;
+    for (unsigned int i = 0; i < optionCount; i++)
+    {
+        const unsigned int votes = (i == changedOption) ? changedVotes : i % 7;
+        options += (i == 0) ? "" : ",";
+        options += R"({"type": "ColumnSet", "id": "option)" + std::to_string(i) + R"(", "columns": [)" +
+                   R"({"type": "Column", "width": "stretch", "items": [{"type": "TextBlock", "text": "Option )" + std::to_string(i) + R"(", "wrap": true}]},)" +
+                   R"({"type": "Column", "width": "auto", "items": [{"type": "TextBlock", "id": "votes)" + std::to_string(i) +
+                   R"(", "text": ")" + std::to_string(votes) + R"( votes", "weight": "bolder"}]}]})";
+    }
+
+    return R"({"type": "AdaptiveCard", "version": "1.2", "body": [{"type": "TextBlock", "text": "Poll", "size": "large"},)" + options +
+           R"(], "actions": [{"type": "Action.Submit", "id": "vote", "title": "Vote"}]})";
+}
+
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 50;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_diff_benchmark [--iterations <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const unsigned int optionCount = 500;
+    const std::string original = MakePoll(optionCount, 0, 0);
+    const std::string updated = MakePoll(optionCount, optionCount / 2, 42);
+    const auto card = AdaptiveCard::DeserializeFromString(original, "1.2")->GetAdaptiveCard();
+
+    // What hosts do today: parse the new version of the card and render it from scratch
+    std::shared_ptr<AdaptiveCard> newCard;
+    const double parseUs = TimeUs(iterations, [&]() { newCard = AdaptiveCard::DeserializeFromString(updated, "1.2")->GetAdaptiveCard(); });
+
+    std::vector<CardPatch> patches;
+    const double diffUs = TimeUs(iterations, [&]() { patches = CardDiff::Diff(*card, *newCard); });
+    if (patches.size() != 1 || patches[0].oldElement != card->GetElementById("votes" + std::to_string(optionCount / 2)))
+    {
+        std::cerr << "expected the diff to change just one vote count" << std::endl;
+        return 1;
+    }
+
+    // Or, when the sender knows what changed, a delta applied to the card already on screen
+    const Json::Value delta = ParseUtil::GetJsonValueFromString(R"([{"op": "replace", "id": "votes)" + std::to_string(optionCount / 2) +
+                                                                R"(", "property": "text", "value": "42 votes"}])");
+    const double deltaUs = TimeUs(iterations, [&]() { patches = CardDiff::ApplyDelta(*card, delta); });
+    if (!CardDiff::Diff(*card, *newCard).empty())
+    {
+        std::cerr << "applying the delta didn't produce the updated card" << std::endl;
+        return 1;
+    }
+
+    std::cout << optionCount << " option poll, one vote count changed: parse the new card " << parseUs
+              << " us, diff the parsed cards " << diffUs << " us, apply a delta " << deltaUs << " us" << std::endl;
+    return 0;
+}
@@ -0,0 +1,278 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "IncrementalCardParser.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+struct TypedCard
+{
+    std::string json;
+    std::vector<TextEdit> edits;
+};
+
+// Runs f on every card iterations times and returns the time per keystroke in microseconds
+template<typename F> double TimeUs(unsigned int iterations, const std::vector<TypedCard>& cards, F&& f)
+{
+    size_t keystrokes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        for (size_t card = 0; card < cards.size(); card++)
+        {
+            f(card);
+            keystrokes += cards[card].edits.size();
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / keystrokes;
+}
+
+// Typing a phrase a character at a time at offset, then deleting it again a character at a time
+std::vector<TextEdit> TypeAt(size_t offset)
+{
+    const std::string phrase = " Hello world";
+    std::vector<TextEdit> edits;
+    for (size_t i = 0; i < phrase.size(); i++)
+    {
+        edits.push_back({offset + i, 0, phrase.substr(i, 1)});
+    }
+    for (size_t i = phrase.size(); i > 0; i--)
+    {
+        edits.push_back({offset + i - 1, 1, std::string()});
+    }
+    return edits;
+}
+
+// A long list of tasks, each a container with a title, a due date and a checkbox
+std::string MakeCard(unsigned int taskCount)
+{
+    Json::Value card;
+    card["type"] = "AdaptiveCard";
+    card["version"] = "1.2";
+    for (unsigned int i = 0; i < taskCount; i++)
+    {
+        const std::string name = std::to_string(i);
+
+        Json::Value title;
+        title["type"] = "TextBlock";
+        title["id"] = "title" + name;
+        title["text"] = "Task " + name;
+        title["weight"] = "bolder";
+
+        Json::Value due;
+        due["type"] = "TextBlock";
+        due["text"] = "Due {{DATE(2020-06-01T09:00:00Z, SHORT)}}";
+        due["isSubtle"] = true;
+
+        Json::Value done;
+        done["type"] = "Input.Toggle";
+        done["id"] = "done" + name;
+        done["title"] = "Done";
+
+        Json::Value task;
+        task["type"] = "Container";
+        task["id"] = "task" + name;
+        task["items"].append(title);
+        task["items"].append(due);
+        task["items"].append(done);
+        card["body"].append(task);
+    }
+    return card.toStyledString();
+}
+
+// Whether applying the edit leaves the same card as parsing the edited text from scratch, or throws as that does
+bool MatchesFullParse(IncrementalCardParser& parser, const TextEdit& edit)
+{
+    std::shared_ptr<ParseResult> result;
+    try
+    {
+        result = parser.ApplyEdit(edit);
+    }
+    catch (const std::exception&)
+    {
+    }
+
+    std::shared_ptr<ParseResult> expected;
+    try
+    {
+        expected = AdaptiveCard::DeserializeFromString(parser.GetText(), "1.3");
+    }
+    catch (const std::exception&)
+    {
+    }
+
+    if (!result || !expected)
+    {
+        return !result && !expected;
+    }
+    return result->GetAdaptiveCard()->Serialize() == expected->GetAdaptiveCard()->Serialize() &&
+           result->GetWarnings().size() == expected->GetWarnings().size();
+}
+
+// An edit that leaves the first element throwing as it's parsed, and shrinks it past where the second one began,
+// followed by an edit to what was the second element and one that puts the first element right again
+bool CheckEditAfterThrow()
+{
+    const std::string type = R"({"type":)";
+    const std::string textBlock = R"("TextBlock","text":")";
+    const std::string y = R"({"type":"TextBlock","text":"yy"})";
+    const std::string x = type + textBlock + std::string(y.size() + 2 - textBlock.size(), 'x') + R"("})";
+    const std::string json = R"({"type":"AdaptiveCard","version":"1.2","body":[)" + x + "," + y + R"(,{"type":"TextBlock","text":"zz"},{"type":"TextBlock","text":"ww"}]})";
+
+    const size_t typeOffset = json.find(textBlock);
+    const size_t yOffset = json.find(y);
+    const std::vector<TextEdit> edits = {{typeOffset, x.size() - type.size() - 1, "{}"},
+                                         {yOffset + y.size() - 4, 0, "Q"},
+                                         {typeOffset, 2, R"("TextBlock")"}};
+
+    IncrementalCardParser parser("1.3");
+    parser.Parse(json);
+    for (const auto& edit : edits)
+    {
+        if (!MatchesFullParse(parser, edit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* samplesPath = nullptr;
+    unsigned int iterations = 10;
+    unsigned int taskCount = 500;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--tasks") == 0 && (i + 1) < argc)
+        {
+            taskCount = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            samplesPath = argv[i];
+        }
+    }
+
+    if (!samplesPath)
+    {
+        std::cerr << "usage: adapt_edit_benchmark [--iterations <n>] [--tasks <count>] <samples directory>" << std::endl;
+        return 1;
+    }
+
+    // Each sample as it was written, typed into at the start of its first TextBlock's text
+    const std::string text = "\"text\": \"";
+    std::vector<TypedCard> samples;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(samplesPath))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        std::ifstream file(entry.path());
+        std::stringstream cardJson;
+        cardJson << file.rdbuf();
+        const size_t offset = cardJson.str().find(text);
+        if (offset == std::string::npos)
+        {
+            continue;
+        }
+
+        try
+        {
+            AdaptiveCard::DeserializeFromString(cardJson.str(), "1.3");
+        }
+        catch (const std::exception&)
+        {
+            // host configs and other non-card json
+            continue;
+        }
+        samples.push_back({cardJson.str(), TypeAt(offset + text.size())});
+    }
+
+    if (samples.empty())
+    {
+        std::cerr << "no cards found under " << samplesPath << std::endl;
+        return 1;
+    }
+
+    // The task list, typed into at the end of the title of the task in the middle
+    const std::string taskJson = MakeCard(taskCount);
+    const std::string middle = "\"Task " + std::to_string(taskCount / 2);
+    const std::vector<TypedCard> tasks = {{taskJson, TypeAt(taskJson.find(middle) + middle.size())}};
+    const std::vector<const std::vector<TypedCard>*> typedCards = {&samples, &tasks};
+
+    if (!CheckEditAfterThrow())
+    {
+        std::cerr << "an edit after one that threw differs from parsing the card from scratch" << std::endl;
+        return 1;
+    }
+
+    // Every keystroke has to leave the same card as parsing the text from scratch
+    size_t keystrokes = 0;
+    size_t incremental = 0;
+    for (const auto* cards : typedCards)
+    {
+        for (const auto& card : *cards)
+        {
+            IncrementalCardParser parser("1.3");
+            parser.Parse(card.json);
+            for (const auto& edit : card.edits)
+            {
+                const auto result = parser.ApplyEdit(edit);
+                const auto expected = AdaptiveCard::DeserializeFromString(parser.GetText(), "1.3");
+                if (result->GetAdaptiveCard()->Serialize() != expected->GetAdaptiveCard()->Serialize() ||
+                    result->GetWarnings().size() != expected->GetWarnings().size())
+                {
+                    std::cerr << "card " << (&card - cards->data()) << " differs from parsing it from scratch" << std::endl;
+                    return 1;
+                }
+                keystrokes++;
+                incremental += parser.GetLastParsedElement() ? 1 : 0;
+            }
+        }
+    }
+
+    std::cout << samples.size() << " samples and a " << taskCount << "-task card (" << taskJson.size() << " bytes), "
+              << keystrokes << " keystrokes, " << incremental << " parsed incrementally" << std::endl;
+    for (const auto* cards : typedCards)
+    {
+        std::vector<std::unique_ptr<IncrementalCardParser>> parsers;
+        for (const auto& card : *cards)
+        {
+            parsers.emplace_back(new IncrementalCardParser("1.3"));
+            parsers.back()->Parse(card.json);
+        }
+
+        const double fullUs = TimeUs(iterations, *cards, [&](size_t i) {
+            std::string json = (*cards)[i].json;
+            for (const auto& edit : (*cards)[i].edits)
+            {
+                json.replace(edit.offset, edit.length, edit.replacement);
+                AdaptiveCard::DeserializeFromString(json, "1.3");
+            }
+        });
+        const double incrementalUs = TimeUs(iterations, *cards, [&](size_t i) {
+            for (const auto& edit : (*cards)[i].edits)
+            {
+                parsers[i]->ApplyEdit(edit);
+            }
+        });
+
+        std::cout << (cards == &samples ? "samples:   " : "task list: ") << "parsing the whole card " << fullUs
+                  << " us/keystroke, parsing the edited element " << incrementalUs << " us/keystroke" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "CardIterator.h"
+#include "FallbackResolver.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+// Rows that each hold an element the host supports, one that needs a newer feature than the host has and falls back
+// twice, and an element of a type the host has no renderer for, inside a container with fallback
+std::shared_ptr<AdaptiveCard> MakeCard(unsigned int rowCount)
+{
+    Json::Value body(Json::arrayValue);
+    for (unsigned int row = 0; row < rowCount; row++)
+    {
+        const std::string name = std::to_string(row);
+
+        Json::Value plain;
+        plain["type"] = "TextBlock";
+        plain["text"] = "Row " + name;
+        plain["requires"]["acTest"] = "1.0";
+
+        Json::Value finalFallback;
+        finalFallback["type"] = "TextBlock";
+        finalFallback["text"] = "Chart " + name + " isn't available";
+        Json::Value chartFallback;
+        chartFallback["type"] = "Chart";
+        chartFallback["fallback"] = finalFallback;
+        Json::Value newer;
+        newer["type"] = "Image";
+        newer["url"] = "https://adaptivecards.io/charts/" + name + ".png";
+        newer["requires"]["acTest"] = "2.0";
+        newer["fallback"] = chartFallback;
+
+        Json::Value graph;
+        graph["type"] = "Graph";
+        Json::Value containerFallback;
+        containerFallback["type"] = "TextBlock";
+        containerFallback["text"] = "Graph " + name;
+        Json::Value container;
+        container["type"] = "Container";
+        container["items"].append(plain);
+        container["items"].append(newer);
+        container["items"].append(graph);
+        container["fallback"] = containerFallback;
+
+        body.append(plain);
+        body.append(newer);
+        body.append(container);
+    }
+
+    Json::Value card;
+    card["type"] = "AdaptiveCard";
+    card["version"] = "1.2";
+    card["body"] = body;
+    return AdaptiveCard::DeserializeFromString(card.toStyledString(), "1.2")->GetAdaptiveCard();
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 200;
+    unsigned int rowCount = 200;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--rows") == 0 && (i + 1) < argc)
+        {
+            rowCount = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_fallback_benchmark [--iterations <count>] [--rows <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const auto card = MakeCard(rowCount);
+    FeatureRegistration featureRegistration;
+    featureRegistration.AddFeature("acTest", "1.5");
+    FallbackResolver resolver(featureRegistration);
+
+    // What a renderer does with the resolution: looks up each element it reaches, and renders what's in its place
+    size_t rendered = 0;
+    CardIterator iterator(*card);
+    const auto render = [&](const FallbackResolution& resolution) {
+        rendered = 0;
+        iterator.Reset(*card);
+        while (iterator.Next())
+        {
+            const BaseCardElement* element = iterator.GetNode().GetElement();
+            if (element && iterator.GetDepth() == 1)
+            {
+                rendered += (resolution.GetRenderedElement(*element) != nullptr) ? 1 : 0;
+                iterator.SkipChildren();
+            }
+        }
+    };
+
+    // Resolving on every render, as the renderers do now, against resolving once and looking elements up
+    const double everyRenderUs = TimeUs(iterations, [&]() {
+        resolver.Invalidate(*card);
+        render(*resolver.Resolve(card));
+    });
+    const double cachedUs = TimeUs(iterations, [&]() { render(*resolver.Resolve(card)); });
+
+    const auto resolution = resolver.Resolve(card);
+    if (rendered != card->GetBody().size() || resolution->GetWarnings().size() != 5 * rowCount)
+    {
+        std::cerr << "Unexpected resolution: " << rendered << " elements rendered, " << resolution->GetWarnings().size()
+                  << " warnings" << std::endl;
+        return 1;
+    }
+
+    std::cout << rowCount << " rows (" << card->GetBody().size() << " top-level elements, "
+              << resolution->GetWarnings().size() << " fallbacks)" << std::endl;
+    std::cout << "  resolving every render: " << everyRenderUs << " us per render" << std::endl;
+    std::cout << "  resolved once, looked up: " << cachedUs << " us per render" << std::endl;
+    return 0;
+}
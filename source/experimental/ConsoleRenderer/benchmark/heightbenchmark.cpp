@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "CardHeightEstimator.h"
+#include "CardIterator.h"
+#include "ConsoleRender.h"
+#include "SharedAdaptiveCard.h"
+#include "ToggleVisibilityAction.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// The console renderer is the one renderer in the tree that runs everywhere, so it stands in for a platform renderer
+// when checking the estimates. This host config and metrics table describe it: a row is 20px and a cell 10px, the card's
+// border is its padding, large spacing is a blank row, a separator is a row, and images are a row of placeholder text.
+constexpr unsigned int c_rowHeight = 20;
+constexpr unsigned int c_cellWidth = 10;
+
+const char* const c_consoleHostConfig = R"json({
+    "spacing": { "small": 0, "default": 0, "medium": 0, "large": 20, "extraLarge": 20, "padding": 20 },
+    "separator": { "lineThickness": 20 },
+    "fontTypes": {
+        "default": { "fontSizes": { "small": 20, "default": 20, "medium": 20, "large": 20, "extraLarge": 20 } },
+        "monospace": { "fontSizes": { "small": 20, "default": 20, "medium": 20, "large": 20, "extraLarge": 20 } }
+    },
+    "imageSizes": { "small": 20, "medium": 20, "large": 20 },
+    "imageSet": { "maxImageHeight": 20 },
+    "factSet": { "title": { "maxWidth": 10000, "wrap": true }, "value": { "wrap": true }, "spacing": 20 },
+    "actions": { "maxActions": 100, "spacing": "large", "buttonSpacing": 10 }
+})json";
+
+const char* const c_consoleFontMetrics = R"json({
+    "default": { "averageCharWidth": 0.5, "bolderCharWidth": 0.5, "lineHeight": 1.0 },
+    "monospace": { "averageCharWidth": 0.5, "bolderCharWidth": 0.5, "lineHeight": 1.0 }
+})json";
+
+// Counts the rows the console renderer draws for a card
+size_t RenderRows(const AdaptiveCard& card, const ConsoleRenderOptions& options)
+{
+    std::ostringstream output;
+    RenderToConsole(card, options, output);
+    const std::string text = output.str();
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+// Runs f on every card iterations times and returns the time per card in microseconds
+template<typename F> double TimeUs(unsigned int iterations, size_t cardCount, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        for (size_t card = 0; card < cardCount; card++)
+        {
+            f(card);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / (iterations * cardCount);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* samplesPath = nullptr;
+    unsigned int iterations = 20;
+    size_t columns = 60;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--width") == 0 && (i + 1) < argc)
+        {
+            columns = strtoul(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            samplesPath = argv[i];
+        }
+    }
+
+    if (!samplesPath)
+    {
+        std::cerr << "usage: adapt_height_benchmark [--iterations <n>] [--width <columns>] <samples directory>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::shared_ptr<AdaptiveCard>> cards;
+    std::vector<std::string> names;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(samplesPath))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        try
+        {
+            std::ifstream file(entry.path());
+            std::stringstream cardJson;
+            cardJson << file.rdbuf();
+            cards.push_back(AdaptiveCard::DeserializeFromString(cardJson.str(), "1.3")->GetAdaptiveCard());
+            names.push_back(entry.path().filename().string());
+        }
+        catch (const std::exception&)
+        {
+            // host configs and other non-card json
+        }
+    }
+
+    if (cards.empty())
+    {
+        std::cerr << "no cards found under " << samplesPath << std::endl;
+        return 1;
+    }
+
+    const HostConfig hostConfig = HostConfig::DeserializeFromString(c_consoleHostConfig);
+    const FontMetricsTable fontMetrics = FontMetricsTable::DeserializeFromString(c_consoleFontMetrics);
+    const unsigned int width = static_cast<unsigned int>(columns * c_cellWidth);
+
+    ConsoleRenderOptions options;
+    options.width = columns;
+    options.useAnsi = false;
+
+    // Accuracy: the estimate in rows against the rows the console renderer draws
+    std::vector<double> errors;
+    size_t withinOneRow = 0;
+    size_t worst = 0;
+    for (size_t i = 0; i < cards.size(); i++)
+    {
+        CardHeightEstimator estimator(cards[i], hostConfig, fontMetrics);
+        const double estimatedRows = static_cast<double>(estimator.EstimateHeight(width)) / c_rowHeight;
+        const double renderedRows = static_cast<double>(RenderRows(*cards[i], options));
+        errors.push_back(std::abs(estimatedRows - renderedRows) / renderedRows);
+        withinOneRow += (std::abs(estimatedRows - renderedRows) <= 1.0) ? 1 : 0;
+        worst = (errors[i] > errors[worst]) ? i : worst;
+    }
+    std::vector<double> sortedErrors = errors;
+    std::sort(sortedErrors.begin(), sortedErrors.end());
+    double totalError = 0;
+    for (const double error : errors)
+    {
+        totalError += error;
+    }
+
+    // Every element with an id is toggled, and the estimate kept up to date by the estimator has to match estimating
+    // the card from scratch
+    std::vector<std::vector<std::shared_ptr<ToggleVisibilityAction>>> toggles(cards.size());
+    size_t toggleCount = 0;
+    for (size_t i = 0; i < cards.size(); i++)
+    {
+        CardIterator iterator(*cards[i]);
+        while (iterator.Next())
+        {
+            if (iterator.GetNode().GetKind() == CardNodeKind::Action)
+            {
+                // elements in the cards of ShowCard actions aren't part of the card's height
+                iterator.SkipChildren();
+                continue;
+            }
+
+            const auto element = iterator.GetNode().GetElement();
+            const auto id = element ? element->GetId() : std::string();
+            if (!id.empty())
+            {
+                auto target = std::make_shared<ToggleVisibilityTarget>();
+                target->SetElementId(id);
+                target->SetIsVisible(IsVisibleToggle);
+                auto toggle = std::make_shared<ToggleVisibilityAction>();
+                toggle->GetTargetElements().push_back(target);
+                toggles[i].push_back(toggle);
+            }
+        }
+
+        CardHeightEstimator estimator(cards[i], hostConfig, fontMetrics);
+        estimator.EstimateHeight(width);
+        for (const auto& toggle : toggles[i])
+        {
+            estimator.ApplyToggleVisibility(*toggle);
+            CardHeightEstimator freshEstimator(cards[i], hostConfig, fontMetrics);
+            if (estimator.EstimateHeight(width) != freshEstimator.EstimateHeight(width))
+            {
+                std::cerr << names[i] << ": estimate after toggling " << toggle->GetTargetElements()[0]->GetElementId()
+                          << " differs from estimating it from scratch" << std::endl;
+                return 1;
+            }
+            estimator.ApplyToggleVisibility(*toggle);
+            toggleCount++;
+        }
+    }
+
+    std::cout << cards.size() << " cards at " << columns << " columns (" << width << "px), " << toggleCount
+              << " toggles checked against estimating from scratch" << std::endl;
+    std::cout << "accuracy against the console renderer: mean error " << (100.0 * totalError / errors.size()) << "%, median "
+              << (100.0 * sortedErrors[sortedErrors.size() / 2]) << "%, 90th percentile "
+              << (100.0 * sortedErrors[sortedErrors.size() * 9 / 10]) << "%, " << withinOneRow << " of " << cards.size()
+              << " within a row, worst " << names[worst] << " (" << (100.0 * errors[worst]) << "%)" << std::endl;
+
+    std::vector<std::unique_ptr<CardHeightEstimator>> estimators;
+    for (const auto& card : cards)
+    {
+        estimators.emplace_back(new CardHeightEstimator(card, hostConfig, fontMetrics));
+    }
+
+    const double renderUs = TimeUs(iterations, cards.size(), [&](size_t i) { RenderRows(*cards[i], options); });
+    const double coldUs = TimeUs(iterations, cards.size(), [&](size_t i) {
+        estimators[i]->ClearCache();
+        estimators[i]->EstimateHeight(width);
+    });
+    const double cachedUs = TimeUs(iterations, cards.size(), [&](size_t i) { estimators[i]->EstimateHeight(width); });
+    const double toggleUs = TimeUs(iterations, cards.size(), [&](size_t i) {
+        for (const auto& toggle : toggles[i])
+        {
+            estimators[i]->ApplyToggleVisibility(*toggle);
+            estimators[i]->EstimateHeight(width);
+        }
+    });
+
+    std::cout << "rendering to measure " << renderUs << " us/card, estimating " << coldUs << " us/card, cached estimate "
+              << (cachedUs * 1000.0) << " ns/card, re-estimating after each toggle " << toggleUs << " us/card" << std::endl;
+    return 0;
+}
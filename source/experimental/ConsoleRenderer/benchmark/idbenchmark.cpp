@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BaseElement.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// Builds a card with elementCount uniquely id'd elements. Every tenth element is an unknown type whose fallback content
+// reuses its id, and the elements are spread across containers so ids are checked at more than one depth.
+std::string MakeCard(unsigned int elementCount)
+{
+    std::string json = R"({"type": "AdaptiveCard", "version": "1.2", "body": [)";
+    for (unsigned int i = 0; i < elementCount; i++)
+    {
+        const std::string id = "element" + std::to_string(i);
+        if (i % 100 == 0)
+        {
+            json += (i == 0) ? "" : "]},";
+            json += R"({"type": "Container", "items": [)";
+        }
+        else
+        {
+            json += ',';
+        }
+
+        if (i % 10 == 0)
+        {
+            json += R"({"type": "FancyInput", "id": ")" + id + R"(", "fallback": {"type": "Input.Text", "id": ")" + id + R"("}})";
+        }
+        else
+        {
+            json += R"({"type": "TextBlock", "id": ")" + id + R"(", "text": "Text"})";
+        }
+    }
+    json += (elementCount != 0) ? "]}]}" : "]}";
+    return json;
+}
+
+// Times ParseContext's id tracking on its own: elementCount top-level elements with unique ids, every tenth with
+// fallback content that reuses the id. Returns microseconds per element.
+double TimeIdTracking(unsigned int elementCount, unsigned int iterations)
+{
+    std::vector<std::string> ids;
+    for (unsigned int i = 0; i < elementCount; i++)
+    {
+        ids.push_back("element" + std::to_string(i));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int iteration = 0; iteration < iterations; iteration++)
+    {
+        ParseContext context;
+        for (unsigned int i = 0; i < elementCount; i++)
+        {
+            const auto internalId = InternalId::Next();
+            context.PushElement(ids[i], internalId);
+            if (i % 10 == 0)
+            {
+                context.PushElement(ids[i], internalId, true);
+                context.PushElement(ids[i], InternalId::Next());
+                context.PopElement();
+                context.PopElement();
+            }
+            context.PopElement();
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations / elementCount;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int maxElements = 100000;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--max") == 0 && (i + 1) < argc)
+        {
+            maxElements = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_id_benchmark [--max <elements>]" << std::endl;
+            return 1;
+        }
+    }
+
+    for (unsigned int elementCount : {10U, 1000U, 100000U})
+    {
+        if (elementCount > maxElements)
+        {
+            break;
+        }
+
+        const std::string json = MakeCard(elementCount);
+
+        // Small cards parse too quickly to time individually
+        const unsigned int iterations = std::max(1U, 100000U / elementCount);
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < iterations; i++)
+        {
+            auto parseResult = AdaptiveCard::DeserializeFromString(json, "1.2");
+            if (!parseResult->GetAdaptiveCard())
+            {
+                std::cerr << "parse failed" << std::endl;
+                return 1;
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double totalUs = std::chrono::duration<double, std::micro>(end - start).count();
+        std::cout << elementCount << " ids: parse " << (totalUs / iterations / 1000.0) << " ms/card, "
+                  << (totalUs / iterations / elementCount) << " us/element; id tracking "
+                  << (TimeIdTracking(elementCount, iterations) * 1000.0) << " ns/element" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,275 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "ResourceLoader.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// Stands in for an image server: answers each fetch after a fixed latency, on one of a few connections, with content
+// made up from the URL. data: URIs are decoded locally, as a host's transport would.
+class StubServerTransport : public ResourceTransport
+{
+public:
+    StubServerTransport(unsigned int connectionCount, std::chrono::microseconds latency) : m_latency(latency)
+    {
+        for (unsigned int i = 0; i < connectionCount; i++)
+        {
+            m_connections.emplace_back([this]() { Serve(); });
+        }
+    }
+
+    ~StubServerTransport()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_requestAvailable.notify_all();
+        for (auto& connection : m_connections)
+        {
+            connection.join();
+        }
+    }
+
+    void Fetch(const std::string& url, const ResourceLoadCallback& onComplete) override
+    {
+        if (IsDataUri(url))
+        {
+            m_local.Fetch(url, onComplete);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_requests.emplace_back(url, onComplete);
+            m_fetchCount++;
+        }
+        m_requestAvailable.notify_one();
+    }
+
+    size_t GetFetchCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fetchCount;
+    }
+
+    static bool IsDataUri(const std::string& url) { return url.compare(0, 5, "data:") == 0; }
+
+    static size_t ContentSize(const std::string& url) { return 2048 + std::hash<std::string>()(url) % (62 * 1024); }
+
+    static std::vector<char> ContentFor(const std::string& url)
+    {
+        const size_t size = ContentSize(url);
+        std::vector<char> content(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            content[i] = url[i % url.size()];
+        }
+        return content;
+    }
+
+private:
+    void Serve()
+    {
+        for (;;)
+        {
+            std::pair<std::string, ResourceLoadCallback> request;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_requestAvailable.wait(lock, [this]() { return m_isStopping || !m_requests.empty(); });
+                if (m_requests.empty())
+                {
+                    return;
+                }
+                request = std::move(m_requests.front());
+                m_requests.pop_front();
+            }
+
+            std::this_thread::sleep_for(m_latency);
+            request.second({ResourceLoadStatus::Fetched, request.first, "image",
+                            std::make_shared<std::vector<char>>(ContentFor(request.first)), ""});
+        }
+    }
+
+    LocalResourceTransport m_local;
+    const std::chrono::microseconds m_latency;
+    std::vector<std::thread> m_connections;
+    std::deque<std::pair<std::string, ResourceLoadCallback>> m_requests;
+    std::mutex m_mutex;
+    std::condition_variable m_requestAvailable;
+    size_t m_fetchCount = 0;
+    bool m_isStopping = false;
+};
+
+// Counts completions, and waits for the expected number of them
+class Completions
+{
+public:
+    explicit Completions(size_t expected) : m_expected(expected) {}
+
+    ResourceLoadCallback Callback()
+    {
+        return [this](const ResourceLoadResult& result) {
+            // Checking the size and the first byte keeps the check out of the timings
+            const bool isCorrect = (result.data != nullptr) &&
+                                   (StubServerTransport::IsDataUri(result.url) ||
+                                    (result.data->size() == StubServerTransport::ContentSize(result.url) && result.data->front() == result.url[0]));
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_failures += isCorrect ? 0 : 1;
+            if (++m_completed == m_expected)
+            {
+                m_done.notify_all();
+            }
+        };
+    }
+
+    // Returns the number of loads that failed or returned the wrong content
+    size_t Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_completed == m_expected; });
+        return m_failures;
+    }
+
+private:
+    const size_t m_expected;
+    size_t m_completed = 0;
+    size_t m_failures = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+};
+
+template<typename F> double TimeMs(F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const char* samplesPath = nullptr;
+    unsigned int latencyMs = 20;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--latency-ms") == 0 && (i + 1) < argc)
+        {
+            latencyMs = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            samplesPath = argv[i];
+        }
+    }
+
+    if (!samplesPath)
+    {
+        std::cerr << "usage: adapt_loader_benchmark [--latency-ms <server latency>] <samples directory>" << std::endl;
+        return 1;
+    }
+
+    // Every resource reference of every sample, duplicates and all, as the renderers request them today
+    std::vector<std::string> urls;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(samplesPath))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        try
+        {
+            std::ifstream file(entry.path());
+            std::stringstream cardJson;
+            cardJson << file.rdbuf();
+            for (const auto& resource : AdaptiveCard::DeserializeFromString(cardJson.str(), "1.3")->GetAdaptiveCard()->GetResourceInformation())
+            {
+                if (!resource.url.empty())
+                {
+                    urls.push_back(resource.url);
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            // host configs and other non-card json
+        }
+    }
+
+    if (urls.empty())
+    {
+        std::cerr << "no resources found under " << samplesPath << std::endl;
+        return 1;
+    }
+
+    const auto latency = std::chrono::milliseconds(latencyMs);
+    const unsigned int connectionCount = 6;
+    const auto cacheDirectory = std::filesystem::temp_directory_path() / "adapt_loader_benchmark";
+    std::filesystem::remove_all(cacheDirectory);
+    std::filesystem::create_directories(cacheDirectory);
+    ResourceLoaderOptions options;
+    options.diskCacheDirectory = cacheDirectory.string();
+
+    const auto loadAll = [&urls](const std::function<void(const std::string&, const ResourceLoadCallback&)>& load) {
+        Completions completions(urls.size());
+        for (const auto& url : urls)
+        {
+            load(url, completions.Callback());
+        }
+        return completions.Wait();
+    };
+
+    size_t failures = 0;
+    size_t uncachedFetches;
+    size_t coldFetches;
+    double uncachedMs;
+    double coldMs;
+    double memoryMs;
+    double diskMs;
+    {
+        auto server = std::make_shared<StubServerTransport>(connectionCount, latency);
+        uncachedMs = TimeMs([&]() { failures += loadAll([&server](const std::string& url, const ResourceLoadCallback& onComplete) { server->Fetch(url, onComplete); }); });
+        uncachedFetches = server->GetFetchCount();
+    }
+    {
+        auto server = std::make_shared<StubServerTransport>(connectionCount, latency);
+        ResourceLoader loader(server, options);
+        const auto load = [&loader](const std::string& url, const ResourceLoadCallback& onComplete) { loader.Load(url, onComplete); };
+        coldMs = TimeMs([&]() { failures += loadAll(load); });
+        coldFetches = server->GetFetchCount();
+        memoryMs = TimeMs([&]() { failures += loadAll(load); });
+    }
+    {
+        auto server = std::make_shared<StubServerTransport>(connectionCount, latency);
+        ResourceLoader loader(server, options);
+        diskMs = TimeMs([&]() { failures += loadAll([&loader](const std::string& url, const ResourceLoadCallback& onComplete) { loader.Load(url, onComplete); }); });
+        if (server->GetFetchCount() != 0)
+        {
+            std::cerr << "a new loader fetched " << server->GetFetchCount() << " resources that were on disk" << std::endl;
+            return 1;
+        }
+    }
+    std::filesystem::remove_all(cacheDirectory);
+
+    if (failures != 0)
+    {
+        std::cerr << failures << " loads failed or returned the wrong content" << std::endl;
+        return 1;
+    }
+
+    std::cout << urls.size() << " resource references, " << latencyMs << " ms latency, " << connectionCount << " connections" << std::endl;
+    std::cout << "without ResourceLoader: " << uncachedFetches << " fetches, " << uncachedMs << " ms" << std::endl;
+    std::cout << "ResourceLoader, cold:   " << coldFetches << " fetches, " << coldMs << " ms" << std::endl;
+    std::cout << "ResourceLoader, memory: 0 fetches, " << memoryMs << " ms" << std::endl;
+    std::cout << "ResourceLoader, disk:   0 fetches, " << diskMs << " ms" << std::endl;
+    return 0;
+}
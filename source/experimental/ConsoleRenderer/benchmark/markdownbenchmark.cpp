@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "MarkDownParser.h"
+
+using namespace AdaptiveSharedNamespace;
+
+template<typename F> double TimeUs(unsigned int iterations, size_t textCount, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        for (size_t text = 0; text < textCount; text++)
+        {
+            f(text);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / (iterations * textCount);
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 2000;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_markdown_benchmark [--iterations <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    // The kinds of text a text-heavy card holds
+    const std::vector<std::string> texts = {
+        "Your order has shipped",
+        "**Flight 1234** to *Seattle* departs at 10:45 from gate **B12**. Check the [status](https://adaptivecards.io/flights/1234) before you leave.",
+        "Release notes:\r- **Faster** rendering of _long_ text\r- Links such as [the docs](https://adaptivecards.io/docs) open in the browser\r- Fixed a crash when **bold _and italic_** text wraps",
+        "Steps:\r1. Open the *Settings* page\r2. Choose **Accounts** > **Sign-in options**\r3. Follow the [instructions](https://adaptivecards.io/help?topic=sign-in&lang=en)",
+        "A longer paragraph with __strong__ and _emphasis_ spread through it, so that the parser has to match delimiters over "
+        "a good stretch of plain text, with a [link](https://adaptivecards.io) near the end and **one more** bold run.",
+    };
+
+    size_t runCount = 0;
+    for (const auto& text : texts)
+    {
+        MarkDownParser parser(text);
+        runCount += parser.TransformToStyledRuns().runs.size();
+    }
+
+    const double htmlUs = TimeUs(iterations, texts.size(), [&](size_t i) {
+        MarkDownParser parser(texts[i]);
+        parser.TransformToHtml();
+    });
+    const double runsUs = TimeUs(iterations, texts.size(), [&](size_t i) {
+        MarkDownParser parser(texts[i]);
+        parser.TransformToStyledRuns();
+    });
+
+    std::cout << texts.size() << " texts, " << runCount << " styled runs: TransformToHtml " << htmlUs
+              << " us/text, TransformToStyledRuns " << runsUs << " us/text" << std::endl;
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "RenderPrep.h"
+#include "SharedAdaptiveCard.h"
+
+using namespace AdaptiveSharedNamespace;
+
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+// A feed of items, each a text block, a fact set and a rich text block, as a text-heavy card lays them out
+std::shared_ptr<AdaptiveCard> MakeFeedCard(unsigned int itemCount)
+{
+    Json::Value body(Json::arrayValue);
+    for (unsigned int i = 0; i < itemCount; i++)
+    {
+        const std::string item = std::to_string(i);
+
+        Json::Value title;
+        title["type"] = "TextBlock";
+        title["text"] = "**Order " + item + "** shipped on {{DATE(2017-02-14T06:08:39Z, SHORT)}}, see [tracking](https://adaptivecards.io/orders/" + item + ")";
+
+        Json::Value facts(Json::arrayValue);
+        for (const char* name : {"Carrier", "Items", "Total"})
+        {
+            Json::Value fact;
+            fact["title"] = name;
+            fact["value"] = "*" + std::string(name) + " " + item + "*";
+            facts.append(fact);
+        }
+        Json::Value factSet;
+        factSet["type"] = "FactSet";
+        factSet["facts"] = facts;
+
+        Json::Value note;
+        note["type"] = "TextRun";
+        note["text"] = "Arrives {{DATE(2017-02-16T06:08:39Z, LONG)}}";
+        note["highlight"] = true;
+        Json::Value richText;
+        richText["type"] = "RichTextBlock";
+        richText["inlines"].append(note);
+
+        Json::Value container;
+        container["type"] = "Container";
+        container["style"] = (i % 2 == 0) ? "emphasis" : "default";
+        container["items"].append(title);
+        container["items"].append(factSet);
+        container["items"].append(richText);
+        body.append(container);
+    }
+
+    Json::Value card;
+    card["type"] = "AdaptiveCard";
+    card["version"] = "1.2";
+    card["body"] = body;
+    return AdaptiveCard::DeserializeFromString(card.toStyledString(), "1.2")->GetAdaptiveCard();
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 200;
+    unsigned int threadCount = std::max(std::thread::hardware_concurrency(), 2U);
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && (i + 1) < argc)
+        {
+            threadCount = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_renderprep_benchmark [--iterations <count>] [--threads <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const auto card = MakeFeedCard(100);
+    const HostConfig hostConfig;
+    RenderPrepThreadPool pool(threadCount);
+    RenderPrepOptions pooled;
+    pooled.scheduler = pool.GetScheduler();
+
+    const auto expected = RenderPrep::Prepare(*card, hostConfig);
+    const auto actual = RenderPrep::Prepare(*card, hostConfig, pooled);
+    if (expected->GetElementCount() != actual->GetElementCount())
+    {
+        std::cerr << "the pool prepared " << actual->GetElementCount() << " elements, the calling thread "
+                  << expected->GetElementCount() << std::endl;
+        return 1;
+    }
+
+    const double callingThreadUs = TimeUs(iterations, [&]() { RenderPrep::Prepare(*card, hostConfig); });
+    const double poolUs = TimeUs(iterations, [&]() { RenderPrep::Prepare(*card, hostConfig, pooled); });
+
+    std::cout << expected->GetElementCount() << " elements with text: calling thread " << callingThreadUs << " us/card, "
+              << threadCount << " threads " << poolUs << " us/card" << std::endl;
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "ParseContext.h"
+#include "SharedAdaptiveCard.h"
+#include "ShowCardAction.h"
+
+using namespace AdaptiveSharedNamespace;
+
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+// An approval card: a summary, and a ShowCard per response, each with a form to fill in before submitting it
+std::string MakeCard(unsigned int showCardCount)
+{
+    Json::Value card;
+    card["type"] = "AdaptiveCard";
+    card["version"] = "1.2";
+
+    Json::Value summary;
+    summary["type"] = "TextBlock";
+    summary["text"] = "Expense report: 12 items, $1,204.50";
+    card["body"].append(summary);
+
+    for (unsigned int i = 0; i < showCardCount; i++)
+    {
+        const std::string name = std::to_string(i);
+
+        Json::Value form;
+        form["type"] = "AdaptiveCard";
+        for (unsigned int j = 0; j < 6; j++)
+        {
+            Json::Value label;
+            label["type"] = "TextBlock";
+            label["text"] = "Question " + std::to_string(j) + " for response " + name;
+            label["wrap"] = true;
+            form["body"].append(label);
+
+            Json::Value choices;
+            choices["type"] = "Input.ChoiceSet";
+            choices["id"] = "answer" + name + "_" + std::to_string(j);
+            for (unsigned int k = 0; k < 5; k++)
+            {
+                Json::Value choice;
+                choice["title"] = "Choice " + std::to_string(k);
+                choice["value"] = std::to_string(k);
+                choices["choices"].append(choice);
+            }
+            form["body"].append(choices);
+        }
+
+        Json::Value image;
+        image["type"] = "Image";
+        image["url"] = "https://adaptivecards.io/responses/" + name + ".png";
+        form["body"].append(image);
+
+        Json::Value comment;
+        comment["type"] = "Input.Text";
+        comment["id"] = "comment" + name;
+        comment["isMultiline"] = true;
+        form["body"].append(comment);
+
+        Json::Value submit;
+        submit["type"] = "Action.Submit";
+        submit["title"] = "Send";
+        submit["data"]["response"] = name;
+        form["actions"].append(submit);
+
+        Json::Value showCard;
+        showCard["type"] = "Action.ShowCard";
+        showCard["title"] = "Response " + name;
+        showCard["card"] = form;
+        card["actions"].append(showCard);
+    }
+    return card.toStyledString();
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 500;
+    unsigned int showCardCount = 10;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--showcards") == 0 && (i + 1) < argc)
+        {
+            showCardCount = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_showcard_benchmark [--iterations <count>] [--showcards <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string json = MakeCard(showCardCount);
+    const auto parse = [&](bool defer) {
+        ParseContext context;
+        context.SetDeferShowCardParsing(defer);
+        return AdaptiveCard::DeserializeFromString(json, "1.2", context)->GetAdaptiveCard();
+    };
+
+    const auto eager = parse(false);
+    const auto deferred = parse(true);
+    const auto eagerResources = eager->GetResourceInformation();
+    const auto deferredResources = deferred->GetResourceInformation();
+
+    // Serializing a deferred card doesn't parse it; showing them all gives the card parsing it all would
+    deferred->Serialize();
+    bool stillDeferred = true;
+    for (const auto& action : deferred->GetActions())
+    {
+        const auto showCard = std::static_pointer_cast<ShowCardAction>(action);
+        stillDeferred = stillDeferred && showCard->IsCardDeferred();
+        showCard->GetCard();
+    }
+    if (eagerResources.size() != showCardCount || deferredResources.size() != showCardCount || !stillDeferred ||
+        eager->Serialize() != deferred->Serialize())
+    {
+        std::cerr << "Deferred card differs: " << deferredResources.size() << " resources, expected "
+                  << eagerResources.size() << std::endl;
+        return 1;
+    }
+
+    // Parsing the whole card, against deferring the ShowCards, and deferring them and then showing one
+    const double eagerUs = TimeUs(iterations, [&]() { parse(false); });
+    const double deferredUs = TimeUs(iterations, [&]() { parse(true); });
+    const double expandOneUs = TimeUs(iterations, [&]() {
+        const auto card = parse(true);
+        std::static_pointer_cast<ShowCardAction>(card->GetActions()[0])->GetCard();
+    });
+    const double resourcesUs = TimeUs(iterations, [&]() { parse(true)->GetResourceInformation(); });
+
+    std::cout << showCardCount << " ShowCards (" << json.size() << " bytes)" << std::endl;
+    std::cout << "  parsing all of it: " << eagerUs << " us per card" << std::endl;
+    std::cout << "  deferring the ShowCards: " << deferredUs << " us per card" << std::endl;
+    std::cout << "  deferring them, then showing one: " << expandOneUs << " us per card" << std::endl;
+    std::cout << "  deferring them, then listing resources: " << resourcesUs << " us per card" << std::endl;
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include "ParseUtil.h"
+#include "SubmitAction.h"
+#include "SubmitPayloadBuilder.h"
+
+using namespace AdaptiveSharedNamespace;
+
+// A form of inputCount Input.Texts, half of them in a ShowCard, with a submit action carrying a few dozen properties
+// of data. Fills values with a value for each input.
+std::string MakeForm(unsigned int inputCount, std::unordered_map<std::string, std::string>& values)
+{
+    std::string inputs[2];
+    for (unsigned int i = 0; i < inputCount; i++)
+    {
+        const std::string id = "input" + std::to_string(i);
+        std::string& json = inputs[i % 2];
+        json += json.empty() ? "" : ",";
+        json += R"({"type": "Input.Text", "id": ")" + id + R"("})";
+        values[id] = "Value of input " + std::to_string(i) + ", with \"quotes\"";
+    }
+
+    std::string data;
+    for (unsigned int i = 0; i < 40; i++)
+    {
+        data += (i == 0) ? "" : ",";
+        data += R"("property)" + std::to_string(i) + R"(": {"id": )" + std::to_string(i) + R"(, "name": "Property", "tags": ["a", "b"]})";
+    }
+
+    return R"({"type": "AdaptiveCard", "version": "1.2", "body": [)" + inputs[0] +
+           R"(], "actions": [{"type": "Action.Submit", "id": "submit", "data": {)" + data +
+           R"(}}, {"type": "Action.ShowCard", "card": {"type": "AdaptiveCard", "body": [)" + inputs[1] + "]}}]}";
+}
+
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 200;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_submit_benchmark [--iterations <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const unsigned int inputCount = 500;
+    std::unordered_map<std::string, std::string> values;
+    auto card = AdaptiveCard::DeserializeFromString(MakeForm(inputCount, values), "1.2")->GetAdaptiveCard();
+    const auto& submitAction = static_cast<const SubmitAction&>(*card->GetActions().at(0));
+
+    // What hosts do today: copy the data, or round trip it through a string, then add the inputs and serialize
+    Json::Value merged;
+    const double copyUs = TimeUs(iterations, [&]() {
+        merged = submitAction.GetDataJsonAsValue();
+        for (const auto& value : values)
+        {
+            merged[value.first] = value.second;
+        }
+        ParseUtil::JsonToString(merged);
+    });
+    const double roundTripUs = TimeUs(iterations, [&]() {
+        Json::Value data = ParseUtil::GetJsonValueFromString(submitAction.GetDataJson());
+        for (const auto& value : values)
+        {
+            data[value.first] = value.second;
+        }
+        ParseUtil::JsonToString(data);
+    });
+
+    SubmitPayloadBuilder builder(*card);
+    std::string payload;
+    const double builderUs = TimeUs(iterations, [&]() { builder.Build(submitAction, values, payload); });
+
+    if (builder.GetInputs().size() != inputCount || ParseUtil::GetJsonValueFromString(payload) != merged)
+    {
+        std::cerr << "payload doesn't match the merged data" << std::endl;
+        return 1;
+    }
+
+    std::cout << inputCount << " inputs, " << payload.size() << " byte payload: copy and merge " << copyUs
+              << " us, round trip through GetDataJson " << roundTripUs << " us, SubmitPayloadBuilder " << builderUs
+              << " us" << std::endl;
+    return 0;
+}
@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "CardIterator.h"
+#include "LineBreaker.h"
+#include "SharedAdaptiveCard.h"
+#include "TextBlock.h"
+#include "TextMeasurer.h"
+
+using namespace AdaptiveSharedNamespace;
+
+struct MeasuredText
+{
+    std::string text;
+    FontType fontType;
+    TextSize size;
+    TextWeight weight;
+};
+
+// Runs f iterations times and returns the time per run in milliseconds
+template<typename F> double TimeMs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* samplesPath = nullptr;
+    unsigned int iterations = 5;
+    size_t cardCount = 10000;
+    double width = 400;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--cards") == 0 && (i + 1) < argc)
+        {
+            cardCount = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--width") == 0 && (i + 1) < argc)
+        {
+            width = strtod(argv[++i], nullptr);
+        }
+        else
+        {
+            samplesPath = argv[i];
+        }
+    }
+
+    if (!samplesPath)
+    {
+        std::cerr << "usage: adapt_text_benchmark [--iterations <n>] [--cards <count>] [--width <px>] <samples directory>" << std::endl;
+        return 1;
+    }
+
+    // The TextBlocks of each sample
+    std::vector<std::vector<MeasuredText>> sampleTexts;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(samplesPath))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        std::shared_ptr<AdaptiveCard> card;
+        try
+        {
+            std::ifstream file(entry.path());
+            std::stringstream cardJson;
+            cardJson << file.rdbuf();
+            card = AdaptiveCard::DeserializeFromString(cardJson.str(), "1.3")->GetAdaptiveCard();
+        }
+        catch (const std::exception&)
+        {
+            // host configs and other non-card json
+            continue;
+        }
+
+        std::vector<MeasuredText> texts;
+        CardIterator iterator(*card);
+        while (iterator.Next())
+        {
+            const auto element = iterator.GetNode().GetElement();
+            if (element && element->GetElementType() == CardElementType::TextBlock)
+            {
+                const auto& textBlock = static_cast<const TextBlock&>(*element);
+                texts.push_back({textBlock.GetText(), textBlock.GetFontType(), textBlock.GetTextSize(), textBlock.GetTextWeight()});
+            }
+        }
+        sampleTexts.push_back(std::move(texts));
+    }
+
+    if (sampleTexts.empty())
+    {
+        std::cerr << "no cards found under " << samplesPath << std::endl;
+        return 1;
+    }
+
+    // A batch of cardCount cards, going round the samples
+    std::vector<const MeasuredText*> batch;
+    for (size_t i = 0; i < cardCount; i++)
+    {
+        for (const auto& text : sampleTexts[i % sampleTexts.size()])
+        {
+            batch.push_back(&text);
+        }
+    }
+
+    const HostConfig hostConfig;
+    const FontMetricsTable fontMetrics;
+    auto advanceTable = std::make_shared<AdvanceTableTextMeasurer>(hostConfig, fontMetrics);
+
+    // One line breaker per style for each measurer, as CardHeightEstimator keeps them
+    const auto makeBreakers = [](std::shared_ptr<TextMeasurer> measurer) {
+        std::vector<std::unique_ptr<LineBreaker>> breakers;
+        for (const auto fontType : {FontType::Default, FontType::Monospace})
+        {
+            for (const auto size : {TextSize::Small, TextSize::Default, TextSize::Medium, TextSize::Large, TextSize::ExtraLarge})
+            {
+                for (const auto weight : {TextWeight::Lighter, TextWeight::Default, TextWeight::Bolder})
+                {
+                    breakers.emplace_back(new LineBreaker(measurer, fontType, size, weight));
+                }
+            }
+        }
+        return breakers;
+    };
+    const auto getBreaker = [](std::vector<std::unique_ptr<LineBreaker>>& breakers, const MeasuredText& text) -> LineBreaker& {
+        const size_t fontType = (text.fontType == FontType::Monospace) ? 1 : 0;
+        return *breakers[(fontType * 5 + static_cast<size_t>(text.size)) * 3 + static_cast<size_t>(text.weight)];
+    };
+
+    // The optimal breaker never uses fewer lines than the greedy one, and caching doesn't change any result
+    auto caching = std::make_shared<CachingTextMeasurer>(advanceTable);
+    auto directBreakers = makeBreakers(advanceTable);
+    auto cachedBreakers = makeBreakers(caching);
+    size_t lines = 0;
+    for (const auto& sample : sampleTexts)
+    {
+        for (const auto& text : sample)
+        {
+            const size_t greedy = getBreaker(directBreakers, text).CountLinesGreedy(text.text, width);
+            if (getBreaker(cachedBreakers, text).CountLinesGreedy(text.text, width) != greedy ||
+                getBreaker(cachedBreakers, text).BreakOptimal(text.text, width).size() < greedy ||
+                caching->MeasureWidth(text.text, text.fontType, text.size, text.weight) !=
+                    advanceTable->MeasureWidth(text.text, text.fontType, text.size, text.weight))
+            {
+                std::cerr << "results differ for \"" << text.text << "\"" << std::endl;
+                return 1;
+            }
+            lines += greedy;
+        }
+    }
+
+    size_t total = 0;
+    const double measureMs = TimeMs(iterations, [&]() {
+        for (const auto text : batch)
+        {
+            total += static_cast<size_t>(advanceTable->MeasureWidth(text->text, text->fontType, text->size, text->weight));
+        }
+    });
+    const double cachedMeasureMs = TimeMs(iterations, [&]() {
+        for (const auto text : batch)
+        {
+            total += static_cast<size_t>(caching->MeasureWidth(text->text, text->fontType, text->size, text->weight));
+        }
+    });
+    const double greedyMs = TimeMs(iterations, [&]() {
+        for (const auto text : batch)
+        {
+            total += getBreaker(cachedBreakers, *text).CountLinesGreedy(text->text, width);
+        }
+    });
+    const double optimalMs = TimeMs(iterations, [&]() {
+        for (const auto text : batch)
+        {
+            total += getBreaker(cachedBreakers, *text).BreakOptimal(text->text, width).size();
+        }
+    });
+
+    std::cout << sampleTexts.size() << " samples, " << lines << " lines at " << width << "px; a batch of " << cardCount
+              << " cards holds " << batch.size() << " TextBlocks (checksum " << total << ")" << std::endl;
+    std::cout << "on one thread, per batch: measuring " << measureMs << " ms, measuring with CachingTextMeasurer "
+              << cachedMeasureMs << " ms, breaking greedily " << greedyMs << " ms, breaking optimally " << optimalMs
+              << " ms" << std::endl;
+    return 0;
+}
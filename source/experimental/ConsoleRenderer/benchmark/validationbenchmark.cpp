@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "InputValidator.h"
+#include "TextInput.h"
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    const char* const c_patterns[] = {
+        R"(^[^@\s]+@[^@\s]+\.[a-z]{2,}$)",
+        R"(^\+?\d{1,3}[ -]?\(?\d{3}\)?[ -]?\d{3}-?\d{4}$)",
+        R"(^\d{5}(-\d{4})?$)",
+        R"(^[A-Z][a-z]+( [A-Z][a-z]+)*$)",
+        R"(^(\w+\s?)*$)",
+    };
+    const char* const c_values[] = {
+        "someone@example.com",
+        "+1 (425) 555-0100",
+        "98052-6399",
+        "Ada Lovelace",
+        "a perfectly ordinary sentence",
+    };
+}
+
+// A form of inputCount inputs: mostly Input.Text with one of a handful of regexes, plus numbers and dates with ranges.
+// Fills values with a valid value for each.
+std::string MakeForm(unsigned int inputCount, std::unordered_map<std::string, std::string>& values)
+{
+    std::string json = R"({"type": "AdaptiveCard", "version": "1.2", "body": [)";
+    for (unsigned int i = 0; i < inputCount; i++)
+    {
+        const std::string id = "input" + std::to_string(i);
+        json += (i == 0) ? "" : ",";
+        if (i % 5 == 3)
+        {
+            json += R"({"type": "Input.Number", "id": ")" + id + R"(", "isRequired": true, "min": 0, "max": 100})";
+            values[id] = std::to_string(i % 100);
+        }
+        else if (i % 5 == 4)
+        {
+            json += R"({"type": "Input.Date", "id": ")" + id + R"(", "min": "2020-01-01", "max": "2030-12-31"})";
+            values[id] = "2024-02-29";
+        }
+        else
+        {
+            std::string pattern = c_patterns[i % 5];
+            for (size_t escape = pattern.find('\\'); escape != std::string::npos; escape = pattern.find('\\', escape + 2))
+            {
+                pattern.insert(escape, "\\");
+            }
+            json += R"({"type": "Input.Text", "id": ")" + id + R"(", "isRequired": true, "maxLength": 100, "regex": ")" +
+                    pattern + R"("})";
+            values[id] = c_values[i % 5];
+        }
+    }
+    return json + "]}";
+}
+
+// What a renderer does without the shared validator: compile each regex every time the input is checked
+size_t ValidateWithStdRegex(const AdaptiveCard& card, const std::unordered_map<std::string, std::string>& values)
+{
+    size_t failures = 0;
+    for (const auto& element : card.GetBody())
+    {
+        if (element->GetElementType() == CardElementType::TextInput)
+        {
+            const auto& regex = std::static_pointer_cast<TextInput>(element)->GetRegexRef();
+            failures += std::regex_search(values.at(element->GetId()), std::regex(regex)) ? 0 : 1;
+        }
+    }
+    return failures;
+}
+
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 20;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_validation_benchmark [--iterations <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const unsigned int inputCount = 500;
+    std::unordered_map<std::string, std::string> values;
+    auto card = AdaptiveCard::DeserializeFromString(MakeForm(inputCount, values), "1.2")->GetAdaptiveCard();
+
+    InputValidator validator;
+    size_t errorCount = 0;
+    const double firstUs = TimeUs(1, [&]() { errorCount = validator.Validate(*card, values).size(); });
+    const double cachedUs = TimeUs(iterations, [&]() { errorCount += validator.Validate(*card, values).size(); });
+    size_t stdFailures = 0;
+    const double stdRegexUs = TimeUs(iterations, [&]() { stdFailures += ValidateWithStdRegex(*card, values); });
+    if (errorCount != 0 || stdFailures != 0)
+    {
+        std::cerr << "valid form failed validation" << std::endl;
+        return 1;
+    }
+
+    std::cout << inputCount << " inputs: validate " << firstUs << " us first pass, " << cachedUs
+              << " us with compiled regexes; std::regex compiled per input " << stdRegexUs << " us" << std::endl;
+
+    // The last pattern backtracks exponentially in std::regex on a value that almost matches
+    TextInput input;
+    input.SetRegex(c_patterns[4]);
+    for (const size_t length : {16U, 20U, 22U})
+    {
+        const std::string nearMiss = std::string(length, 'a') + "!";
+        bool linearMatched = true, stdMatched = true;
+        const double linearUs = TimeUs(1, [&]() { linearMatched = validator.Validate(input, nearMiss) == InputValidationResult::Valid; });
+        const double stdUs = TimeUs(1, [&]() { stdMatched = std::regex_search(nearMiss, std::regex(c_patterns[4])); });
+        if (linearMatched || stdMatched)
+        {
+            std::cerr << "near miss matched" << std::endl;
+            return 1;
+        }
+        std::cout << "near miss of " << length << " characters: " << linearUs << " us, std::regex " << stdUs << " us" << std::endl;
+    }
+
+    // Patterns that would need backtracking aren't run at all
+    input.SetRegex(R"(^(a+)+\1$)");
+    if (validator.Validate(input, std::string(27, 'a') + "!") != InputValidationResult::InvalidRegex)
+    {
+        std::cerr << "backreference wasn't reported as an invalid regex" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "CardView.h"
+#include "SharedAdaptiveCard.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace AdaptiveSharedNamespace;
+
+// The corpus file, mapped into memory where mmap is available and read into memory elsewhere
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path)
+    {
+#ifndef _WIN32
+        const int file = open(path.c_str(), O_RDONLY);
+        struct stat status;
+        if (file >= 0 && fstat(file, &status) == 0 && status.st_size > 0)
+        {
+            void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED)
+            {
+                m_data = static_cast<const uint8_t*>(mapping);
+                m_size = static_cast<size_t>(status.st_size);
+            }
+        }
+        if (file >= 0)
+        {
+            close(file);
+        }
+#else
+        std::ifstream file(path, std::ios::binary);
+        m_copy.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_data = reinterpret_cast<const uint8_t*>(m_copy.data());
+        m_size = m_copy.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+#endif
+    }
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    std::vector<char> m_copy;
+#endif
+};
+
+// Calls f with each card in the corpus, which is a list of cards each preceded by its size as a little-endian uint32
+template<typename F> void ForEachCard(const MappedFile& corpus, F&& f)
+{
+    const uint8_t* position = corpus.data();
+    const uint8_t* end = position + corpus.size();
+    while (end - position >= 4)
+    {
+        const uint32_t size = static_cast<uint32_t>(position[0]) | (static_cast<uint32_t>(position[1]) << 8) |
+                              (static_cast<uint32_t>(position[2]) << 16) | (static_cast<uint32_t>(position[3]) << 24);
+        f(position + 4, static_cast<size_t>(size));
+        position += 4 + size;
+    }
+}
+
+bool SameResources(const std::vector<RemoteResourceInformation>& a, const std::vector<RemoteResourceInformation>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].url != b[i].url || a[i].mimeType != b[i].mimeType)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* samplesPath = nullptr;
+    size_t corpusMegabytes = 1024;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--size-mb") == 0 && (i + 1) < argc)
+        {
+            corpusMegabytes = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            samplesPath = argv[i];
+        }
+    }
+
+    if (!samplesPath)
+    {
+        std::cerr << "usage: adapt_view_benchmark [--size-mb <corpus size>] <samples directory>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t>> binaries;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(samplesPath))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        try
+        {
+            std::ifstream file(entry.path());
+            std::stringstream cardJson;
+            cardJson << file.rdbuf();
+            binaries.push_back(AdaptiveCard::DeserializeFromString(cardJson.str(), "1.3")->GetAdaptiveCard()->SerializeBinary());
+        }
+        catch (const std::exception&)
+        {
+            // host configs and other non-card json
+        }
+    }
+
+    if (binaries.empty())
+    {
+        std::cerr << "no cards found under " << samplesPath << std::endl;
+        return 1;
+    }
+
+    for (size_t i = 0; i < binaries.size(); i++)
+    {
+        const auto parsed = AdaptiveCard::DeserializeBinary(binaries[i].data(), binaries[i].size(), "1.3")->GetAdaptiveCard();
+        if (!SameResources(parsed->GetResourceInformation(), CardView(binaries[i].data(), binaries[i].size()).GetResourceInformation()))
+        {
+            std::cerr << "card " << i << " has different resources in a CardView" << std::endl;
+            return 1;
+        }
+    }
+
+    // The samples over and over, as a cache of cards on disk would hold them
+    const std::string corpusPath = (std::filesystem::temp_directory_path() / "adapt_view_benchmark.bin").string();
+    {
+        std::ofstream corpus(corpusPath, std::ios::binary | std::ios::trunc);
+        size_t written = 0;
+        for (size_t i = 0; written < corpusMegabytes * 1024 * 1024; i = (i + 1) % binaries.size())
+        {
+            const uint32_t size = static_cast<uint32_t>(binaries[i].size());
+            const char header[4] = {static_cast<char>(size), static_cast<char>(size >> 8), static_cast<char>(size >> 16), static_cast<char>(size >> 24)};
+            corpus.write(header, sizeof(header));
+            corpus.write(reinterpret_cast<const char*>(binaries[i].data()), binaries[i].size());
+            written += sizeof(header) + binaries[i].size();
+        }
+    }
+
+    size_t cardCount = 0;
+    size_t parsedResources = 0;
+    size_t viewedResources = 0;
+    double parseSeconds;
+    double viewSeconds;
+    size_t corpusBytes;
+    {
+        const MappedFile corpus(corpusPath);
+        corpusBytes = corpus.size();
+
+        auto start = std::chrono::steady_clock::now();
+        ForEachCard(corpus, [&](const uint8_t* data, size_t size) {
+            parsedResources += AdaptiveCard::DeserializeBinary(data, size, "1.3")->GetAdaptiveCard()->GetResourceInformation().size();
+            cardCount++;
+        });
+        parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        ForEachCard(corpus, [&](const uint8_t* data, size_t size) { viewedResources += CardView(data, size).GetResourceInformation().size(); });
+        viewSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::filesystem::remove(corpusPath);
+
+    if (parsedResources != viewedResources)
+    {
+        std::cerr << "parsed cards have " << parsedResources << " resources, CardViews " << viewedResources << std::endl;
+        return 1;
+    }
+
+    const double megabytes = corpusBytes / (1024.0 * 1024.0);
+    std::cout << cardCount << " cards (" << megabytes << " MB), " << parsedResources << " resources" << std::endl;
+    std::cout << "DeserializeBinary + GetResourceInformation: " << parseSeconds << " s, " << (megabytes / parseSeconds) << " MB/s" << std::endl;
+    std::cout << "CardView + GetResourceInformation:          " << viewSeconds << " s, " << (megabytes / viewSeconds) << " MB/s" << std::endl;
+    return 0;
+}
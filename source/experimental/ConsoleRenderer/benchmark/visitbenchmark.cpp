@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "CardIterator.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "ImageSet.h"
+#include "SharedAdaptiveCard.h"
+#include "ShowCardAction.h"
+
+using namespace AdaptiveSharedNamespace;
+
+template<typename F> double TimeUs(unsigned int iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+// Rows of nested containers and column sets holding images, text and image sets, with a ShowCard for each row
+std::shared_ptr<AdaptiveCard> MakeCard(unsigned int rowCount, unsigned int depth)
+{
+    Json::Value body(Json::arrayValue);
+    Json::Value actions(Json::arrayValue);
+    for (unsigned int row = 0; row < rowCount; row++)
+    {
+        const std::string name = std::to_string(row);
+
+        Json::Value imageSet;
+        imageSet["type"] = "ImageSet";
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            Json::Value image;
+            image["type"] = "Image";
+            image["url"] = "https://adaptivecards.io/thumbnails/" + name + "_" + std::to_string(i) + ".png";
+            imageSet["images"].append(image);
+        }
+
+        Json::Value item;
+        item["type"] = "Container";
+        item["backgroundImage"] = "https://adaptivecards.io/backgrounds/" + name + ".png";
+        item["items"].append(imageSet);
+        for (unsigned int level = 0; level < depth; level++)
+        {
+            Json::Value text;
+            text["type"] = "TextBlock";
+            text["text"] = "Row " + name;
+
+            Json::Value column;
+            column["type"] = "Column";
+            column["items"].append(text);
+            column["items"].append(item);
+            Json::Value columnSet;
+            columnSet["type"] = "ColumnSet";
+            columnSet["columns"].append(column);
+
+            item = Json::Value();
+            item["type"] = "Container";
+            item["items"].append(columnSet);
+        }
+        body.append(item);
+
+        Json::Value details;
+        details["type"] = "Image";
+        details["url"] = "https://adaptivecards.io/details/" + name + ".png";
+        Json::Value action;
+        action["type"] = "Action.ShowCard";
+        action["iconUrl"] = "https://adaptivecards.io/icons/" + name + ".png";
+        action["card"]["type"] = "AdaptiveCard";
+        action["card"]["body"].append(details);
+        actions.append(action);
+    }
+
+    Json::Value card;
+    card["type"] = "AdaptiveCard";
+    card["version"] = "1.2";
+    card["body"] = body;
+    card["actions"] = actions;
+    return AdaptiveCard::DeserializeFromString(card.toStyledString(), "1.2")->GetAdaptiveCard();
+}
+
+// What GetResourceInformation did before it walked the card with a CardIterator: each element lists its own
+// resources and recurses into its children
+void GetResourceInformationRecursively(AdaptiveCard& card, std::vector<RemoteResourceInformation>& resourceInfo)
+{
+    if (card.GetBackgroundImage())
+    {
+        RemoteResourceInformation backgroundImageInfo;
+        backgroundImageInfo.url = card.GetBackgroundImage()->GetUrl();
+        backgroundImageInfo.mimeType = "image";
+        resourceInfo.push_back(backgroundImageInfo);
+    }
+    for (auto item : card.GetBody())
+    {
+        item->GetResourceInformation(resourceInfo);
+    }
+    for (auto action : card.GetActions())
+    {
+        if (action->GetElementType() == ActionType::ShowCard)
+        {
+            GetResourceInformationRecursively(*std::static_pointer_cast<ShowCardAction>(action)->GetCard(), resourceInfo);
+        }
+        else
+        {
+            action->GetResourceInformation(resourceInfo);
+        }
+    }
+}
+
+// Counts elements the way renderers walk cards by hand, casting each element to find its children
+size_t CountRecursively(const std::vector<std::shared_ptr<BaseCardElement>>& elements)
+{
+    size_t count = 0;
+    for (auto element : elements)
+    {
+        count++;
+        if (auto container = std::dynamic_pointer_cast<Container>(element))
+        {
+            count += CountRecursively(container->GetItems());
+        }
+        else if (auto columnSet = std::dynamic_pointer_cast<ColumnSet>(element))
+        {
+            for (auto column : columnSet->GetColumns())
+            {
+                count += 1 + CountRecursively(column->GetItems());
+            }
+        }
+        else if (auto imageSet = std::dynamic_pointer_cast<ImageSet>(element))
+        {
+            count += imageSet->GetImages().size();
+        }
+    }
+    return count;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int iterations = 200;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && (i + 1) < argc)
+        {
+            iterations = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "usage: adapt_visit_benchmark [--iterations <count>]" << std::endl;
+            return 1;
+        }
+    }
+
+    for (unsigned int depth : {1u, 8u})
+    {
+        const auto card = MakeCard(100, depth);
+
+        std::vector<RemoteResourceInformation> recursive;
+        std::vector<RemoteResourceInformation> walked;
+        GetResourceInformationRecursively(*card, recursive);
+        card->GetResourceInformation(walked);
+        bool matches = (recursive.size() == walked.size());
+        for (size_t i = 0; matches && i < recursive.size(); i++)
+        {
+            matches = (recursive[i].url == walked[i].url) && (recursive[i].mimeType == walked[i].mimeType);
+        }
+        if (!matches)
+        {
+            std::cerr << "GetResourceInformation doesn't match the recursive walk" << std::endl;
+            return 1;
+        }
+
+        size_t counted = 0;
+        size_t iterated = 0;
+        CardIterator iterator(*card);
+        const double recursiveUs = TimeUs(iterations, [&]() {
+            std::vector<RemoteResourceInformation> resourceInfo;
+            GetResourceInformationRecursively(*card, resourceInfo);
+        });
+        const double walkedUs = TimeUs(iterations, [&]() {
+            std::vector<RemoteResourceInformation> resourceInfo;
+            card->GetResourceInformation(resourceInfo);
+        });
+        const double countedUs = TimeUs(iterations, [&]() { counted = CountRecursively(card->GetBody()); });
+        const double iteratedUs = TimeUs(iterations, [&]() {
+            iterated = 0;
+            iterator.Reset(*card);
+            while (iterator.Next())
+            {
+                if (iterator.GetNode().GetElement())
+                {
+                    iterated++;
+                }
+                else if (iterator.GetNode().GetAction())
+                {
+                    iterator.SkipChildren();
+                }
+            }
+        });
+        if (counted != iterated)
+        {
+            std::cerr << "CardIterator doesn't meet the same elements as the recursive walk" << std::endl;
+            return 1;
+        }
+
+        std::cout << "100 rows nested " << depth << " deep (" << walked.size() << " resources)" << std::endl;
+        std::cout << "  GetResourceInformation: recursive " << recursiveUs << " us, CardIterator " << walkedUs << " us"
+                  << std::endl;
+        std::cout << "  count " << counted << " body elements: dynamic_pointer_cast recursion " << countedUs
+                  << " us, CardIterator " << iteratedUs << " us" << std::endl;
+    }
+    return 0;
+}
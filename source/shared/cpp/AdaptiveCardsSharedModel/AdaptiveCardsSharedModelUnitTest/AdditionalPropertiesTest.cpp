@@ -103,5 +103,20 @@ namespace AdaptiveCardsSharedModelUnitTest
             Assert::AreEqual("{\"actions\":[],\"body\":[{\"text\":\"Standard textblock\",\"type\":\"TextBlock\"},{\"property\":\"value\",\"someOtherProperty\":\"some other value\",\"type\":\"SomeRandomType\"}],\"type\":\"AdaptiveCard\",\"version\":\"1.0\"}\n"s,
                 outputCard);
         }
+
+        TEST_METHOD(CustomElementKnownProperties)
+        {
+            // Custom elements add their own properties to m_knownProperties on top of those BaseCardElement shares
+            class RatingElement : public BaseCardElement
+            {
+            public:
+                RatingElement() : BaseCardElement(CardElementType::Custom) { m_knownProperties.insert("stars"); }
+            };
+
+            ParseContext context;
+            const auto json = ParseUtil::GetJsonValueFromString(R"({"type": "Rating", "stars": 4, "spacing": "large", "color": "good"})");
+            const auto element = BaseCardElement::Deserialize<RatingElement>(context, json);
+            Assert::AreEqual("{\"color\":\"good\"}\n"s, ParseUtil::JsonToString(element->GetAdditionalProperties()));
+        }
     };
 }
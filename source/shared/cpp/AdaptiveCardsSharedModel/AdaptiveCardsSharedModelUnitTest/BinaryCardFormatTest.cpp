@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "BinaryCardFormat.h"
+#include "ParseUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(BinaryCardFormatTest)
+    {
+    public:
+        TEST_METHOD(RoundTripsJsonValues)
+        {
+            Json::Value value(Json::objectValue);
+            value["text"] = std::string("nul\0and \xE2\x82\xAC", 10);
+            value["Text"] = "property names are case sensitive";
+            value["customProperty"] = Json::Value(Json::arrayValue);
+            value["customProperty"].append(Json::Value());
+            value["customProperty"].append(true);
+            value["customProperty"].append(static_cast<Json::LargestInt>(-9007199254740993LL));
+            value["customProperty"].append(static_cast<Json::LargestUInt>(18446744073709551615ULL));
+            value["customProperty"].append(0.1);
+            value["customProperty"].append(Json::Value(Json::objectValue));
+            value["emptyArray"] = Json::Value(Json::arrayValue);
+            value["size"] = 3;
+            value["weight"] = 3u;
+
+            const auto binary = BinaryCardFormat::Write(value);
+            const Json::Value read = BinaryCardFormat::Read(binary.data(), binary.size());
+            Assert::IsTrue(read == value);
+            Assert::AreEqual(std::string("nul\0and \xE2\x82\xAC", 10), read["text"].asString());
+            Assert::IsTrue(read["size"].type() == Json::intValue);
+            Assert::IsTrue(read["weight"].type() == Json::uintValue);
+            Assert::IsTrue(read["customProperty"][4].asDouble() == 0.1);
+        }
+
+        TEST_METHOD(RoundTripsCards)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "lang": "en",
+                "body": [
+                    { "type": "TextBlock", "text": "Hello", "weight": "bolder", "size": "large", "wrap": true },
+                    {
+                        "type": "ColumnSet",
+                        "columns": [
+                            { "type": "Column", "width": 2, "items": [ { "type": "Image", "url": "https://adaptivecards.io/a.png", "altText": "A" } ] },
+                            { "type": "Column", "width": "50px", "items": [ { "type": "TextBlock", "text": "Hello", "isVisible": false } ] }
+                        ]
+                    },
+                    { "type": "Input.ChoiceSet", "id": "choice", "choices": [ { "title": "One", "value": "1" } ] },
+                    { "type": "FancyElement", "fancy": { "nested": [ 1, -2, 3.5 ] } }
+                ],
+                "actions": [
+                    { "type": "Action.Submit", "title": "Send", "data": { "x": 1 } },
+                    { "type": "Action.ShowCard", "title": "More", "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "text": "More" } ] } }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+
+            const auto binary = card->SerializeBinary();
+            auto parseResult = AdaptiveCard::DeserializeBinary(binary.data(), binary.size(), "1.2");
+            Assert::AreEqual(card->Serialize(), parseResult->GetAdaptiveCard()->Serialize());
+            Assert::IsTrue(binary.size() < card->Serialize().size());
+        }
+
+        TEST_METHOD(RejectsInvalidBuffers)
+        {
+            Json::Value value;
+            value["type"] = "AdaptiveCard";
+            value["body"] = Json::Value(Json::arrayValue);
+            const auto binary = BinaryCardFormat::Write(value);
+
+            auto truncated = binary;
+            truncated.pop_back();
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { BinaryCardFormat::Read(truncated.data(), truncated.size()); });
+
+            auto otherVersion = binary;
+            otherVersion[4] = BinaryCardFormat::Version + 1;
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { BinaryCardFormat::Read(otherVersion.data(), otherVersion.size()); });
+
+            const std::string json = ParseUtil::JsonToString(value);
+            Assert::ExpectException<AdaptiveCardParseException>([&]() {
+                BinaryCardFormat::Read(reinterpret_cast<const uint8_t*>(json.data()), json.size());
+            });
+
+            // Flipping any byte of the value gives an error or another value, never a crash
+            for (size_t i = binary.size() - 12; i < binary.size(); i++)
+            {
+                auto corrupt = binary;
+                corrupt[i] ^= 0xFF;
+                try
+                {
+                    BinaryCardFormat::Read(corrupt.data(), corrupt.size());
+                }
+                catch (const AdaptiveCardParseException&)
+                {
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,262 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "CardDiff.h"
+#include "Container.h"
+#include "TextBlock.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(CardDiffTest)
+    {
+    private:
+        const std::string c_card = R"card({
+            "type": "AdaptiveCard",
+            "version": "1.2",
+            "body": [
+                { "type": "TextBlock", "id": "title", "text": "Lunch poll" },
+                {
+                    "type": "Container",
+                    "id": "options",
+                    "items": [
+                        { "type": "TextBlock", "id": "pizza", "text": "Pizza: 3 votes" },
+                        { "type": "TextBlock", "id": "salad", "text": "Salad: 1 vote" },
+                        { "type": "TextBlock", "id": "soup", "text": "Soup: 0 votes" }
+                    ]
+                },
+                { "type": "TextBlock", "text": "Closes at noon" },
+                { "type": "Image", "url": "http://adaptivecards.io/poll.png" }
+            ],
+            "actions": [
+                { "type": "Action.Submit", "id": "vote", "title": "Vote" }
+            ]
+        })card";
+
+        std::shared_ptr<AdaptiveCard> Parse(const std::string& json)
+        {
+            return AdaptiveCard::DeserializeFromString(json, "1.2")->GetAdaptiveCard();
+        }
+
+        std::string Replace(std::string json, const std::string& from, const std::string& to)
+        {
+            json.replace(json.find(from), from.size(), to);
+            return json;
+        }
+
+    public:
+        TEST_METHOD(IdenticalCardsHaveNoChanges)
+        {
+            Assert::IsTrue(CardDiff::Diff(*Parse(c_card), *Parse(c_card)).empty());
+        }
+
+        TEST_METHOD(FindsPropertyChanges)
+        {
+            auto oldCard = Parse(c_card);
+            std::string updated = Replace(c_card, "Salad: 1 vote", "Salad: 2 votes");
+            updated = Replace(updated, R"("title": "Vote")", R"("title": "Vote again")");
+            updated = Replace(updated, R"("version": "1.2")", R"("version": "1.2", "speak": "Lunch")");
+            auto newCard = Parse(updated);
+
+            const auto patches = CardDiff::Diff(*oldCard, *newCard);
+            Assert::AreEqual(3u, static_cast<unsigned int>(patches.size()));
+
+            Assert::IsTrue(patches[0].type == CardPatchType::Update);
+            Assert::IsTrue(patches[0].oldElement == nullptr);
+            Assert::IsTrue(patches[0].properties == std::vector<std::string>{"speak"});
+
+            Assert::IsTrue(patches[1].type == CardPatchType::Update);
+            Assert::IsTrue(patches[1].oldElement == oldCard->GetElementById("salad"));
+            Assert::IsTrue(patches[1].newElement == newCard->GetElementById("salad"));
+            Assert::IsTrue(patches[1].parent == oldCard->GetElementById("options"));
+            Assert::AreEqual(std::string("items"), patches[1].collection);
+            Assert::AreEqual(1u, static_cast<unsigned int>(patches[1].index));
+            Assert::IsTrue(patches[1].properties == std::vector<std::string>{"text"});
+
+            Assert::IsTrue(patches[2].oldElement == oldCard->GetElementById("vote"));
+            Assert::IsTrue(patches[2].properties == std::vector<std::string>{"title"});
+        }
+
+        TEST_METHOD(FindsStructuralChanges)
+        {
+            auto oldCard = Parse(c_card);
+
+            // Soup moves to the top, salad goes and tacos come in; the footer is hidden and the image becomes text,
+            // while the elements without ids are matched by position
+            std::string updated = Replace(c_card, R"({ "type": "TextBlock", "id": "salad", "text": "Salad: 1 vote" },)", "");
+            updated = Replace(updated, R"("id": "soup", "text": "Soup: 0 votes")", R"("id": "tacos", "text": "Tacos: 0 votes")");
+            updated = Replace(updated, R"("items": [)", R"("items": [ { "type": "TextBlock", "id": "soup", "text": "Soup: 0 votes" },)");
+            updated = Replace(updated, R"("text": "Closes at noon")", R"("text": "Closes at noon", "isVisible": false)");
+            updated = Replace(updated, R"({ "type": "Image", "url": "http://adaptivecards.io/poll.png" })", R"({ "type": "TextBlock", "text": "Closed" })");
+            auto newCard = Parse(updated);
+
+            const auto patches = CardDiff::Diff(*oldCard, *newCard);
+            const std::vector<std::tuple<CardPatchType, std::string, unsigned int>> expected{
+                {CardPatchType::Remove, "body", 3},
+                {CardPatchType::Insert, "body", 3},
+                {CardPatchType::Remove, "items", 2},
+                {CardPatchType::Remove, "items", 1},
+                {CardPatchType::Insert, "items", 0},
+                {CardPatchType::Insert, "items", 2},
+                {CardPatchType::SetVisibility, "body", 2}};
+            Assert::AreEqual(static_cast<unsigned int>(expected.size()), static_cast<unsigned int>(patches.size()));
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                Assert::IsTrue(std::get<0>(expected[i]) == patches[i].type);
+                Assert::AreEqual(std::get<1>(expected[i]), patches[i].collection);
+                Assert::AreEqual(std::get<2>(expected[i]), static_cast<unsigned int>(patches[i].index));
+            }
+
+            Assert::IsTrue(patches[1].newElement == newCard->GetBody()[3]);
+            Assert::IsTrue(patches[2].oldElement == oldCard->GetElementById("soup"));
+            Assert::IsTrue(patches[2].parent == oldCard->GetElementById("options"));
+            Assert::IsTrue(patches[3].oldElement == oldCard->GetElementById("salad"));
+            Assert::IsTrue(patches[4].newElement == newCard->GetElementById("soup"));
+            Assert::IsTrue(patches[5].newElement == newCard->GetElementById("tacos"));
+            Assert::IsTrue(patches[6].oldElement == oldCard->GetBody()[2]);
+            Assert::IsFalse(patches[6].isVisible);
+        }
+
+        TEST_METHOD(ReordersWithFewestMoves)
+        {
+            auto oldCard = Parse(c_card);
+            std::string updated = Replace(c_card, R"({ "type": "TextBlock", "id": "soup", "text": "Soup: 0 votes" })", "");
+            updated = Replace(updated, R"("text": "Salad: 1 vote" },)", R"("text": "Salad: 1 vote" })");
+            updated = Replace(updated, R"("items": [)", R"("items": [ { "type": "TextBlock", "id": "soup", "text": "Soup: 0 votes" },)");
+            auto newCard = Parse(updated);
+
+            // Moving soup to the top is one remove and one insert, rather than moving pizza and salad down
+            const auto patches = CardDiff::Diff(*oldCard, *newCard);
+            Assert::AreEqual(2u, static_cast<unsigned int>(patches.size()));
+            Assert::IsTrue(patches[0].type == CardPatchType::Remove);
+            Assert::AreEqual(2u, static_cast<unsigned int>(patches[0].index));
+            Assert::IsTrue(patches[1].type == CardPatchType::Insert);
+            Assert::AreEqual(0u, static_cast<unsigned int>(patches[1].index));
+            Assert::AreEqual(std::string("soup"), patches[1].newElement->GetId());
+        }
+
+        TEST_METHOD(AppliesDelta)
+        {
+            auto card = Parse(c_card);
+            auto options = std::static_pointer_cast<Container>(card->GetElementById("options"));
+            const auto pizza = options->GetItems()[0];
+
+            const auto patches = CardDiff::ApplyDeltaFromString(*card, R"delta([
+                { "op": "replace", "id": "salad", "property": "text", "value": "Salad: 2 votes" },
+                { "op": "replace", "id": "options", "property": "style", "value": "emphasis" },
+                { "op": "replace", "id": "title", "property": "isVisible", "value": false },
+                { "op": "remove", "id": "soup" },
+                { "op": "add", "parent": "options", "index": 0, "value": { "type": "TextBlock", "id": "tacos", "text": "Tacos: 5 votes" } },
+                { "op": "add", "collection": "actions", "value": { "type": "Action.Submit", "id": "close", "title": "Close poll" } }
+            ])delta");
+            Assert::AreEqual(6u, static_cast<unsigned int>(patches.size()));
+
+            // The text block is replaced, and so is the container, but the container's items carry over
+            auto salad = std::static_pointer_cast<TextBlock>(card->GetElementById("salad"));
+            Assert::AreEqual(std::string("Salad: 2 votes"), salad->GetText());
+            Assert::IsTrue(patches[0].newElement == salad);
+            Assert::IsTrue(patches[1].oldElement == options);
+            Assert::IsTrue(patches[1].properties == std::vector<std::string>{"style"});
+            auto updatedOptions = std::static_pointer_cast<Container>(card->GetElementById("options"));
+            Assert::IsTrue(updatedOptions != options);
+            Assert::IsTrue(ContainerStyle::Emphasis == updatedOptions->GetStyle());
+            Assert::IsTrue(updatedOptions->GetItems()[1] == pizza);
+
+            Assert::IsTrue(patches[2].type == CardPatchType::SetVisibility);
+            Assert::IsFalse(std::static_pointer_cast<BaseCardElement>(card->GetBody()[0])->GetIsVisible());
+
+            Assert::IsTrue(patches[3].type == CardPatchType::Remove);
+            Assert::IsTrue(patches[3].parent == updatedOptions);
+            Assert::AreEqual(2u, static_cast<unsigned int>(patches[3].index));
+            Assert::IsTrue(card->GetElementById("soup") == nullptr);
+
+            Assert::AreEqual(std::string("tacos"), updatedOptions->GetItems()[0]->GetId());
+            Assert::AreEqual(3u, static_cast<unsigned int>(updatedOptions->GetItems().size()));
+            Assert::IsTrue(patches[5].parent == nullptr);
+            Assert::AreEqual(1u, static_cast<unsigned int>(patches[5].index));
+            Assert::IsTrue(card->GetActions()[1] == card->GetElementById("close"));
+
+            // Applying the delta leaves the card as if it had been parsed that way
+            Assert::IsTrue(CardDiff::Diff(*card, *Parse(card->Serialize())).empty());
+
+            Assert::ExpectException<AdaptiveCardParseException>([&]() {
+                CardDiff::ApplyDeltaFromString(*card, R"([{ "op": "remove", "id": "soup" }])");
+            });
+            Assert::ExpectException<AdaptiveCardParseException>([&]() {
+                CardDiff::ApplyDeltaFromString(*card, R"([{ "op": "add", "parent": "salad", "value": { "type": "TextBlock", "text": "x" } }])");
+            });
+        }
+
+        TEST_METHOD(ParsesNewContentInPlace)
+        {
+            auto card = Parse(R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    {
+                        "type": "Container",
+                        "id": "outer",
+                        "style": "emphasis",
+                        "items": [
+                            { "type": "Container", "id": "inner", "style": "emphasis", "items": [ { "type": "TextBlock", "text": "a" } ] },
+                            { "type": "TextBlock", "id": "last", "text": "b" }
+                        ]
+                    }
+                ]
+            })card");
+
+            CardDiff::ApplyDeltaFromString(*card, R"delta([
+                { "op": "replace", "id": "inner", "property": "bleed", "value": true },
+                { "op": "add", "parent": "outer", "value": { "type": "Container", "id": "added", "style": "good", "bleed": true, "items": [] } }
+            ])delta");
+
+            // The new containers get the padding and bleed they'd get from parsing the whole card
+            auto reparsed = Parse(card->Serialize());
+            for (const auto id : {"inner", "added"})
+            {
+                auto container = std::static_pointer_cast<Container>(card->GetElementById(id));
+                auto expected = std::static_pointer_cast<Container>(reparsed->GetElementById(id));
+                Assert::AreEqual(expected->GetPadding(), container->GetPadding());
+                Assert::AreEqual(expected->GetCanBleed(), container->GetCanBleed());
+                Assert::IsTrue(expected->GetBleedDirection() == container->GetBleedDirection());
+            }
+            Assert::IsFalse(std::static_pointer_cast<Container>(card->GetElementById("inner"))->GetPadding());
+            auto added = std::static_pointer_cast<Container>(card->GetElementById("added"));
+            Assert::IsTrue(added->GetPadding());
+            Assert::IsTrue(added->GetParentalId() == card->GetElementById("outer")->GetInternalId());
+        }
+
+        TEST_METHOD(RejectsCollidingIds)
+        {
+            auto card = Parse(c_card);
+            const auto expectCollision = [&card](const std::string& delta) {
+                try
+                {
+                    CardDiff::ApplyDeltaFromString(*card, delta);
+                    Assert::Fail();
+                }
+                catch (const AdaptiveCardParseException& e)
+                {
+                    Assert::IsTrue(ErrorStatusCode::IdCollision == e.GetStatusCode());
+                }
+            };
+
+            expectCollision(R"([{ "op": "add", "value": { "type": "TextBlock", "id": "pizza", "text": "Pizza again" } }])");
+            expectCollision(R"([{ "op": "add", "collection": "actions", "value": { "type": "Action.Submit", "id": "title" } }])");
+            expectCollision(R"([{ "op": "replace", "id": "options", "property": "items", "value": [ { "type": "TextBlock", "id": "title", "text": "x" } ] }])");
+            expectCollision(R"([{ "op": "replace", "id": "vote", "property": "fallback", "value": { "type": "Action.Submit", "id": "salad" } }])");
+
+            // Nothing was changed, and the card still parses after a round trip
+            Assert::AreEqual(4u, static_cast<unsigned int>(card->GetBody().size()));
+            Assert::AreEqual(3u, static_cast<unsigned int>(std::static_pointer_cast<Container>(card->GetElementById("options"))->GetItems().size()));
+            Assert::IsTrue(CardDiff::Diff(*card, *Parse(card->Serialize())).empty());
+
+            // An element's own ids, and those of the children it keeps, don't collide with themselves
+            CardDiff::ApplyDeltaFromString(*card, R"([{ "op": "replace", "id": "options", "property": "style", "value": "good" }])");
+            CardDiff::ApplyDeltaFromString(*card, R"([{ "op": "replace", "id": "options", "property": "items", "value": [ { "type": "TextBlock", "id": "pizza", "text": "x" } ] }])");
+            Assert::IsTrue(CardDiff::Diff(*card, *Parse(card->Serialize())).empty());
+        }
+    };
+}
@@ -0,0 +1,198 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "CardHeightEstimator.h"
+#include "Container.h"
+#include "ToggleVisibilityAction.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(CardHeightEstimatorTest)
+    {
+    private:
+        const std::string c_toggleCard = R"card({
+            "type": "AdaptiveCard",
+            "version": "1.2",
+            "body": [
+                {
+                    "type": "TextBlock",
+                    "text": "This is a long paragraph of text that will certainly need to wrap onto several lines when the card is narrow.",
+                    "wrap": true
+                },
+                {
+                    "type": "Container",
+                    "id": "details",
+                    "isVisible": false,
+                    "items": [
+                        {
+                            "type": "TextBlock",
+                            "text": "Hidden details"
+                        },
+                        {
+                            "type": "Image",
+                            "url": "https://adaptivecards.io/content/cats/1.png",
+                            "height": "100px"
+                        }
+                    ]
+                },
+                {
+                    "type": "ColumnSet",
+                    "columns": [
+                        {
+                            "type": "Column",
+                            "width": "auto",
+                            "items": [ { "type": "TextBlock", "text": "Left" } ]
+                        },
+                        {
+                            "type": "Column",
+                            "width": "stretch",
+                            "items": [ { "type": "TextBlock", "text": "Right column text that wraps", "wrap": true } ]
+                        }
+                    ]
+                }
+            ],
+            "actions": [
+                {
+                    "type": "Action.ToggleVisibility",
+                    "title": "Details",
+                    "targetElements": [ "details" ]
+                }
+            ]
+        })card";
+
+    public:
+        TEST_METHOD(NarrowerCardsAreTaller)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_toggleCard, "1.2")->GetAdaptiveCard();
+            CardHeightEstimator estimator(card, HostConfig(), FontMetricsTable());
+
+            const auto narrow = estimator.EstimateHeight(200);
+            const auto wide = estimator.EstimateHeight(800);
+            Assert::IsTrue(narrow > wide);
+            Assert::IsTrue(wide > 0);
+
+            // repeated estimates at the same width are served from the cache and must agree
+            Assert::AreEqual(narrow, estimator.EstimateHeight(200));
+            Assert::AreEqual(wide, estimator.EstimateHeight(800));
+        }
+
+        TEST_METHOD(ToggleVisibilityUpdatesEstimate)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_toggleCard, "1.2")->GetAdaptiveCard();
+            CardHeightEstimator estimator(card, HostConfig(), FontMetricsTable());
+            const auto collapsed = estimator.EstimateHeight(400);
+
+            auto toggleAction = std::static_pointer_cast<ToggleVisibilityAction>(card->GetActions().at(0));
+            estimator.ApplyToggleVisibility(*toggleAction);
+            Assert::IsTrue(card->GetBody().at(1)->GetIsVisible());
+
+            const auto expanded = estimator.EstimateHeight(400);
+            Assert::IsTrue(expanded >= collapsed + 100);
+
+            // toggling back must produce the original estimate
+            estimator.ApplyToggleVisibility(*toggleAction);
+            Assert::IsFalse(card->GetBody().at(1)->GetIsVisible());
+            Assert::AreEqual(collapsed, estimator.EstimateHeight(400));
+
+            // estimates from a fresh estimator agree with the incrementally maintained ones
+            card->GetBody().at(1)->SetIsVisible(true);
+            estimator.InvalidateElement("details");
+            CardHeightEstimator freshEstimator(card, HostConfig(), FontMetricsTable());
+            Assert::AreEqual(freshEstimator.EstimateHeight(400), estimator.EstimateHeight(400));
+        }
+
+        TEST_METHOD(ToggleVisibilityInFallbackContent)
+        {
+            const std::string cardStr = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    {
+                        "type": "Graph",
+                        "fallback": {
+                            "type": "Container",
+                            "items": [
+                                {
+                                    "type": "TextBlock",
+                                    "text": "Summary"
+                                },
+                                {
+                                    "type": "Image",
+                                    "id": "chart",
+                                    "url": "https://adaptivecards.io/content/cats/1.png",
+                                    "height": "100px",
+                                    "isVisible": false
+                                }
+                            ]
+                        }
+                    }
+                ],
+                "actions": [
+                    {
+                        "type": "Action.ToggleVisibility",
+                        "title": "Chart",
+                        "targetElements": [ "chart" ]
+                    }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardStr, "1.2")->GetAdaptiveCard();
+            CardHeightEstimator estimator(card, HostConfig(), FontMetricsTable());
+            const auto collapsed = estimator.EstimateHeight(400);
+
+            // the toggle reaches the element in the unknown element's fallback content and invalidates the unknown element
+            auto toggleAction = std::static_pointer_cast<ToggleVisibilityAction>(card->GetActions().at(0));
+            estimator.ApplyToggleVisibility(*toggleAction);
+            const auto expanded = estimator.EstimateHeight(400);
+            Assert::IsTrue(expanded >= collapsed + 100);
+
+            CardHeightEstimator freshEstimator(card, HostConfig(), FontMetricsTable());
+            Assert::AreEqual(freshEstimator.EstimateHeight(400), expanded);
+        }
+
+        TEST_METHOD(RespectsMinHeightAndMaxLines)
+        {
+            const std::string cardStr = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "minHeight": "500px",
+                "body": [
+                    {
+                        "type": "TextBlock",
+                        "text": "A very long string of text that would normally take many lines at this width, but is clamped.",
+                        "wrap": true,
+                        "maxLines": 1
+                    }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardStr, "1.2")->GetAdaptiveCard();
+            CardHeightEstimator estimator(card, HostConfig(), FontMetricsTable());
+            Assert::AreEqual(500U, estimator.EstimateHeight(100));
+
+            card->SetMinHeight(0);
+            estimator.ClearCache();
+            HostConfig hostConfig;
+            const unsigned int lineHeight = static_cast<unsigned int>(
+                std::ceil(hostConfig.GetFontSize(FontType::Default, TextSize::Default) * FontMetrics().lineHeight));
+            Assert::AreEqual(lineHeight + 2 * hostConfig.GetSpacing().paddingSpacing, estimator.EstimateHeight(100));
+        }
+
+        TEST_METHOD(FontMetricsDeserialization)
+        {
+            const std::string metricsStr = R"metrics({
+                "monospace": {
+                    "averageCharWidth": 0.7,
+                    "lineHeight": 1.5
+                }
+            })metrics";
+            auto metrics = FontMetricsTable::DeserializeFromString(metricsStr);
+
+            Assert::AreEqual(0.7, metrics.GetFontMetrics(FontType::Monospace).averageCharWidth);
+            Assert::AreEqual(1.5, metrics.GetFontMetrics(FontType::Monospace).lineHeight);
+            Assert::AreEqual(0.6, metrics.GetFontMetrics(FontType::Monospace).bolderCharWidth);
+            Assert::AreEqual(FontMetrics().averageCharWidth, metrics.GetFontMetrics(FontType::Default).averageCharWidth);
+        }
+    };
+}
@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "CardIterator.h"
+#include "Fact.h"
+#include "Image.h"
+#include "TextBlock.h"
+#include "TextRun.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace
+{
+    const std::string c_cardJson = R"card({
+        "type": "AdaptiveCard",
+        "version": "1.2",
+        "selectAction": { "type": "Action.OpenUrl", "id": "cardSelect", "url": "https://adaptivecards.io" },
+        "body": [
+            { "type": "TextBlock", "id": "title", "text": "Title" },
+            {
+                "type": "Container",
+                "id": "container",
+                "selectAction": { "type": "Action.Submit", "id": "containerSelect" },
+                "items": [
+                    { "type": "Image", "id": "image", "url": "a.png" },
+                    { "type": "FactSet", "id": "facts", "facts": [ { "title": "t", "value": "v" } ] }
+                ]
+            },
+            {
+                "type": "ColumnSet",
+                "id": "columnSet",
+                "columns": [ { "type": "Column", "id": "column", "items": [ { "type": "RichTextBlock", "id": "rich", "inlines": [ "run" ] } ] } ]
+            },
+            {
+                "type": "Graph",
+                "id": "graph",
+                "fallback": { "type": "TextBlock", "id": "graphFallback", "text": "No graph" }
+            },
+            { "type": "ActionSet", "id": "actionSet", "actions": [ { "type": "Action.Submit", "id": "setSubmit" } ] }
+        ],
+        "actions": [
+            {
+                "type": "Action.ShowCard",
+                "id": "show",
+                "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "id": "shown", "text": "Shown" } ] }
+            }
+        ]
+    })card";
+
+    std::string Describe(const CardNode& node)
+    {
+        switch (node.GetKind())
+        {
+        case CardNodeKind::Card:
+            return "card";
+        case CardNodeKind::Element:
+            return node.GetElement()->GetId();
+        case CardNodeKind::Action:
+            return node.GetAction()->GetId();
+        case CardNodeKind::Fact:
+            return "fact:" + node.GetFact()->GetTitle();
+        default:
+            return "run:" + static_cast<const TextRun*>(node.GetInline())->GetText();
+        }
+    }
+
+    std::string Walk(const AdaptiveCard& card, CardIteratorOptions options)
+    {
+        std::string walked;
+        CardIterator iterator(card, options);
+        while (iterator.Next())
+        {
+            walked += std::string(walked.empty() ? "" : " ") + (iterator.IsLeaving() ? "/" : "") + Describe(iterator.GetNode());
+        }
+        return walked;
+    }
+
+    class CountingVisitor : public CardVisitor
+    {
+    public:
+        bool VisitCard(const AdaptiveCard&) override
+        {
+            visited += "card ";
+            return true;
+        }
+
+        void LeaveCard(const AdaptiveCard&) override { visited += "/card "; }
+
+        bool VisitElement(const BaseCardElement& element) override
+        {
+            visited += element.GetId() + " ";
+            return true;
+        }
+
+        bool VisitTextBlock(const TextBlock& textBlock) override
+        {
+            visited += "text:" + textBlock.GetText() + " ";
+            return true;
+        }
+
+        bool VisitColumnSet(const ColumnSet&) override
+        {
+            visited += "columns(skipped) ";
+            return false;
+        }
+
+        bool VisitAction(const BaseActionElement& action) override
+        {
+            visited += action.GetId() + " ";
+            return true;
+        }
+
+        void VisitFact(const Fact& fact) override { visited += "fact:" + fact.GetValue() + " "; }
+
+        std::string visited;
+    };
+}
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(CardIteratorTest)
+    {
+    public:
+        TEST_METHOD(WalksInDocumentOrder)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+
+            Assert::AreEqual(std::string("card title container image facts fact:t columnSet column rich run:run graph "
+                                         "actionSet setSubmit show card shown"),
+                             Walk(*card, {}));
+
+            CardIteratorOptions postOrder;
+            postOrder.order = CardTraversalOrder::PostOrder;
+            Assert::AreEqual(std::string("/title /image /fact:t /facts /container /run:run /rich /column /columnSet "
+                                         "/graph /setSubmit /actionSet /shown /card /show /card"),
+                             Walk(*card, postOrder));
+
+            CardIteratorOptions everything;
+            everything.order = CardTraversalOrder::PreAndPostOrder;
+            everything.includeFallbackContent = true;
+            everything.includeSelectActions = true;
+            Assert::AreEqual(std::string("card title /title container image /image facts fact:t /fact:t /facts "
+                                         "containerSelect /containerSelect /container columnSet column rich run:run "
+                                         "/run:run /rich /column /columnSet graph graphFallback /graphFallback /graph "
+                                         "actionSet setSubmit /setSubmit /actionSet show card shown /shown /card /show "
+                                         "cardSelect /cardSelect /card"),
+                             Walk(*card, everything));
+        }
+
+        TEST_METHOD(SkipsChildrenAndReportsDepth)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            CardIteratorOptions options;
+            options.includeFallbackContent = true;
+            options.includeSelectActions = true;
+
+            CardIterator iterator(*card, options);
+            std::string walked;
+            while (iterator.Next())
+            {
+                const CardNode& node = iterator.GetNode();
+                walked += std::to_string(iterator.GetDepth()) + ":" + Describe(node) + " ";
+                if (node.GetElement() && node.GetElement()->GetElementType() == CardElementType::Container)
+                {
+                    iterator.SkipChildren();
+                }
+                if (node.GetElement() && node.GetElement()->GetId() == "graphFallback")
+                {
+                    Assert::IsTrue(node.IsFallbackContent());
+                }
+                if (node.GetAction() && node.GetAction()->GetId() == "cardSelect")
+                {
+                    Assert::IsTrue(node.IsSelectAction());
+                }
+            }
+            Assert::AreEqual(std::string("0:card 1:title 1:container 1:columnSet 2:column 3:rich 4:run:run 1:graph "
+                                         "2:graphFallback 1:actionSet 2:setSubmit 1:show 2:card 3:shown 1:cardSelect "),
+                             walked);
+
+            // Reused, the iterator walks just an element
+            const auto& container = *card->GetBody()[1];
+            iterator.Reset(container);
+            walked.clear();
+            while (iterator.Next())
+            {
+                walked += Describe(iterator.GetNode()) + " ";
+            }
+            Assert::AreEqual(std::string("container image facts fact:t containerSelect "), walked);
+        }
+
+        TEST_METHOD(VisitorDispatchesOnType)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            CountingVisitor visitor;
+            CardIterator::Walk(*card, visitor);
+            Assert::AreEqual(std::string("card text:Title container image facts fact:v columns(skipped) graph actionSet "
+                                         "setSubmit show card text:Shown "),
+                             visitor.visited);
+
+            CardIteratorOptions leaving;
+            leaving.order = CardTraversalOrder::PreAndPostOrder;
+            visitor.visited.clear();
+            CardIterator::Walk(*card, visitor, leaving);
+            Assert::AreEqual(std::string("card text:Title container image facts fact:v columns(skipped) graph actionSet "
+                                         "setSubmit show card text:Shown /card /card "),
+                             visitor.visited);
+        }
+    };
+}
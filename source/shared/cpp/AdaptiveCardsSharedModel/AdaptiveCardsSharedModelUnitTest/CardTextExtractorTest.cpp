@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "CardTextExtractor.h"
+#include "DateTimePreparsedToken.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(CardTextExtractorTest)
+    {
+    private:
+        const std::string c_card = R"card({
+            "type": "AdaptiveCard",
+            "version": "1.2",
+            "body": [
+                { "type": "TextBlock", "text": "Hello **world** & [friends](https://example.com)" },
+                { "type": "TextBlock", "text": "- one\r- two" },
+                { "type": "TextBlock", "text": "Hidden", "isVisible": false },
+                {
+                    "type": "ColumnSet",
+                    "columns": [
+                        {
+                            "type": "Column",
+                            "items": [
+                                {
+                                    "type": "RichTextBlock",
+                                    "inlines": [ "Rich ", { "type": "TextRun", "text": "*text*", "weight": "bolder" } ]
+                                }
+                            ]
+                        },
+                        {
+                            "type": "Column",
+                            "items": [ { "type": "Image", "url": "https://example.com/cat.png", "altText": "A cat" } ]
+                        }
+                    ]
+                },
+                {
+                    "type": "FactSet",
+                    "facts": [ { "title": "Due", "value": "{{DATE(2017-02-13T20:46:30Z, SHORT)}}" } ]
+                },
+                {
+                    "type": "Input.ChoiceSet",
+                    "id": "color",
+                    "choices": [ { "title": "Red", "value": "1" }, { "title": "Blue", "value": "2" } ]
+                }
+            ],
+            "actions": [
+                {
+                    "type": "Action.ShowCard",
+                    "title": "More",
+                    "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "text": "Inside" } ] }
+                },
+                { "type": "Action.Submit", "title": "Send" }
+            ]
+        })card";
+
+    public:
+        TEST_METHOD(ExtractsTextInReadingOrder)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_card, "1.2")->GetAdaptiveCard();
+            const std::string text = CardTextExtractor().Extract(*card);
+
+            Assert::AreEqual(std::string("Hello world & friends\n"
+                                         "one\ntwo\n"
+                                         "Rich *text*\n"
+                                         "A cat\n"
+                                         "Due\nMon, Feb 13, 2017\n"
+                                         "Red\nBlue\n"
+                                         "More\nInside\nSend"),
+                             text);
+        }
+
+        TEST_METHOD(OptionsAndStreaming)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_card, "1.2")->GetAdaptiveCard();
+
+            CardTextExtractionOptions options;
+            options.separator = " | ";
+            options.includeActions = false;
+            options.includeInputs = false;
+            options.includeAltText = false;
+            options.includeHiddenElements = true;
+            options.dateFormatter = [](const DateTimePreparsedToken& token) {
+                return std::to_string(token.GetYear()) + "-" + std::to_string(token.GetMonth() + 1);
+            };
+
+            unsigned int fragments = 0;
+            std::string text;
+            CardTextExtractor(options).Extract(*card, [&](const char* fragment, size_t length) {
+                fragments++;
+                text.append(fragment, length);
+            });
+
+            Assert::AreEqual(std::string("Hello world & friends | one | two | Hidden | Rich *text* | Due | 2017-2"), text);
+            Assert::IsTrue(fragments > 10);
+        }
+
+        TEST_METHOD(LocaleDateFormatter)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(
+                            R"({"type": "AdaptiveCard", "version": "1.0", "body": [{"type": "TextBlock", "text": "{{DATE(2017-02-13T20:46:30Z, LONG)}}"}]})",
+                            "1.0")
+                            ->GetAdaptiveCard();
+
+            CardTextExtractionOptions options;
+            options.dateFormatter = CardTextExtractor::MakeLocaleDateFormatter(std::locale::classic());
+            Assert::AreEqual(std::string("Monday, February 13, 2017"), CardTextExtractor(options).Extract(*card));
+        }
+    };
+}
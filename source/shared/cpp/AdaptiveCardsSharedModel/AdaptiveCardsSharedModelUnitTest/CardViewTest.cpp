@@ -0,0 +1,268 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "CardView.h"
+#include "Fact.h"
+#include "TextRun.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(CardViewTest)
+    {
+    private:
+        template<typename Node> static std::string DescribeKind(const Node& node, bool isLeaving, size_t depth)
+        {
+            return std::string(isLeaving ? "/" : "") + std::to_string(depth) + (node.IsFallbackContent() ? "f" : "") +
+                   (node.IsSelectAction() ? "s" : "") + ":";
+        }
+
+        static std::string Describe(const CardNode& node)
+        {
+            switch (node.GetKind())
+            {
+            case CardNodeKind::Card:
+                return "card";
+            case CardNodeKind::Element:
+                return node.GetElement()->GetId();
+            case CardNodeKind::Action:
+                return node.GetAction()->GetId();
+            case CardNodeKind::Fact:
+                return "fact:" + node.GetFact()->GetTitle();
+            default:
+                return "run:" + static_cast<const TextRun*>(node.GetInline())->GetText();
+            }
+        }
+
+        static std::string Describe(const CardViewNode& node)
+        {
+            switch (node.GetKind())
+            {
+            case CardNodeKind::Card:
+                return "card";
+            case CardNodeKind::Fact:
+                return "fact:" + node.GetView().GetString(AdaptiveCardSchemaKey::Title);
+            case CardNodeKind::Inline:
+                return "run:" + node.GetView().GetString(AdaptiveCardSchemaKey::Text);
+            default:
+                return node.GetView().GetId();
+            }
+        }
+
+        template<typename Iterator> static std::string Walk(Iterator& iterator)
+        {
+            std::string walked;
+            while (iterator.Next())
+            {
+                walked += DescribeKind(iterator.GetNode(), iterator.IsLeaving(), iterator.GetDepth()) + Describe(iterator.GetNode()) + " ";
+                if (Describe(iterator.GetNode()) == "container" && !iterator.IsLeaving())
+                {
+                    iterator.SkipChildren();
+                }
+            }
+            return walked;
+        }
+
+    public:
+        TEST_METHOD(WalksLikeCardIterator)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "TextBlock", "id": "title", "text": "Title" },
+                    {
+                        "type": "Container",
+                        "id": "container",
+                        "items": [ { "type": "TextBlock", "id": "skipped", "text": "Skipped" } ]
+                    },
+                    {
+                        "type": "Container",
+                        "id": "other",
+                        "selectAction": { "type": "Action.Submit", "id": "containerSelect" },
+                        "items": [
+                            { "type": "Image", "id": "image", "url": "a.png", "selectAction": { "type": "Action.Submit", "id": "imageSelect" } },
+                            { "type": "FactSet", "id": "facts", "facts": [ { "title": "t", "value": "v" } ] }
+                        ]
+                    },
+                    {
+                        "type": "ColumnSet",
+                        "id": "columnSet",
+                        "columns": [ { "type": "Column", "id": "column", "items": [ { "type": "RichTextBlock", "id": "rich", "inlines": [ "run" ] } ] } ]
+                    },
+                    {
+                        "type": "Graph",
+                        "id": "graph",
+                        "fallback": { "type": "TextBlock", "id": "graphFallback", "text": "No graph" }
+                    },
+                    { "type": "TextBlock", "id": "dropped", "text": "Dropped", "fallback": "drop" },
+                    { "type": "ActionSet", "id": "actionSet", "actions": [ { "type": "Action.Submit", "id": "setSubmit" } ] }
+                ],
+                "actions": [
+                    {
+                        "type": "Action.ShowCard",
+                        "id": "show",
+                        "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "id": "shown", "text": "Shown" } ] },
+                        "fallback": { "type": "Action.Submit", "id": "showFallback" }
+                    }
+                ]
+            })card";
+            const auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+            const auto binary = card->SerializeBinary();
+            const CardView view(binary.data(), binary.size());
+
+            for (const auto order : {CardTraversalOrder::PreOrder, CardTraversalOrder::PostOrder, CardTraversalOrder::PreAndPostOrder})
+            {
+                for (int flags = 0; flags < 4; flags++)
+                {
+                    CardIteratorOptions options;
+                    options.order = order;
+                    options.includeFallbackContent = (flags & 1) != 0;
+                    options.includeSelectActions = (flags & 2) != 0;
+
+                    CardIterator iterator(*card, options);
+                    CardViewIterator viewIterator(view, options);
+                    Assert::AreEqual(Walk(iterator), Walk(viewIterator));
+
+                    // Reused, and started from an element
+                    iterator.Reset(*card->GetBody()[2]);
+                    viewIterator.Reset(view.GetBody()[2]);
+                    Assert::AreEqual(Walk(iterator), Walk(viewIterator));
+                }
+            }
+        }
+
+        TEST_METHOD(VisitorWalksViews)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "Container", "id": "container", "items": [ { "type": "TextBlock", "id": "inner", "text": "Inner" } ] },
+                    { "type": "FactSet", "facts": [ { "title": "t", "value": "v" } ] }
+                ],
+                "actions": [ { "type": "Action.Submit", "id": "submit" } ]
+            })card";
+            const auto binary = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard()->SerializeBinary();
+            const CardView view(binary.data(), binary.size());
+
+            class Visitor : public CardViewVisitor
+            {
+            public:
+                bool VisitCard(const ElementView&) override
+                {
+                    visited += "card ";
+                    return true;
+                }
+                void LeaveCard(const ElementView&) override { visited += "/card "; }
+                bool VisitElement(const ElementView& element) override
+                {
+                    visited += element.GetElementTypeString() + " ";
+                    return element.GetElementTypeString() != "Container";
+                }
+                bool VisitAction(const ElementView& action) override
+                {
+                    visited += action.GetId() + " ";
+                    return true;
+                }
+                void VisitFact(const ElementView& fact) override { visited += "fact:" + fact.GetString(AdaptiveCardSchemaKey::Value) + " "; }
+
+                std::string visited;
+            } visitor;
+
+            CardViewIterator::Walk(view, visitor, {CardTraversalOrder::PostOrder});
+            Assert::AreEqual(std::string("card Container FactSet fact:v submit /card "), visitor.visited);
+        }
+
+        TEST_METHOD(ReadsPropertiesInPlace)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "TextBlock", "id": "title", "text": "Hello", "isVisible": false },
+                    { "type": "Container", "items": [ { "type": "Input.Text", "id": "name", "placeholder": "Name" } ] }
+                ],
+                "actions": [
+                    { "type": "Action.ShowCard", "title": "More", "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "id": "more", "text": "More" } ] } }
+                ]
+            })card";
+            const auto binary = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard()->SerializeBinary();
+            const CardView view(binary.data(), binary.size());
+
+            Assert::AreEqual(std::string("1.2"), view.GetVersion());
+            const auto body = view.GetBody();
+            Assert::AreEqual(2u, static_cast<unsigned int>(body.size()));
+            Assert::AreEqual(std::string("TextBlock"), body[0].GetElementTypeString());
+            Assert::AreEqual(std::string("Hello"), body[0].GetString(AdaptiveCardSchemaKey::Text));
+            Assert::IsFalse(body[0].GetBool(AdaptiveCardSchemaKey::IsVisible, true));
+            Assert::IsTrue(body[1].GetBool(AdaptiveCardSchemaKey::IsVisible, true));
+            Assert::IsFalse(body[1].HasProperty(AdaptiveCardSchemaKey::Text));
+
+            Assert::AreEqual(std::string("Name"), view.GetElementById("name").GetString(AdaptiveCardSchemaKey::Placeholder));
+            Assert::AreEqual(std::string("More"), view.GetElementById("more").GetString(AdaptiveCardSchemaKey::Text));
+            Assert::IsFalse(view.GetElementById("missing").IsValid());
+
+            const auto showCard = view.GetActions()[0].GetObject(AdaptiveCardSchemaKey::Card);
+            Assert::AreEqual(std::string("AdaptiveCard"), showCard.GetElementTypeString());
+            Assert::AreEqual(std::string("More"), showCard.GetValue(AdaptiveCardSchemaKey::Body)[0]["text"].asString());
+        }
+
+        TEST_METHOD(MatchesResourceInformationOfParsedCard)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "backgroundImage": "https://adaptivecards.io/background.png",
+                "body": [
+                    { "type": "Image", "url": "https://adaptivecards.io/a.png" },
+                    {
+                        "type": "Container",
+                        "backgroundImage": { "url": "https://adaptivecards.io/container.png", "fillMode": "repeat" },
+                        "items": [ { "type": "ImageSet", "images": [ { "type": "Image", "url": "https://adaptivecards.io/b.png" } ] } ]
+                    },
+                    {
+                        "type": "ColumnSet",
+                        "columns": [ { "type": "Column", "backgroundImage": "https://adaptivecards.io/column.png", "items": [] } ]
+                    },
+                    {
+                        "type": "Media",
+                        "poster": "https://adaptivecards.io/poster.png",
+                        "sources": [ { "mimeType": "video/mp4", "url": "https://adaptivecards.io/video.mp4" } ]
+                    },
+                    { "type": "ActionSet", "actions": [ { "type": "Action.Submit", "iconUrl": "https://adaptivecards.io/ignored.png" } ] }
+                ],
+                "actions": [
+                    { "type": "Action.OpenUrl", "url": "https://adaptivecards.io", "iconUrl": "https://adaptivecards.io/icon.png" },
+                    { "type": "Action.Submit", "title": "No icon" },
+                    {
+                        "type": "Action.ShowCard",
+                        "iconUrl": "https://adaptivecards.io/ignored.png",
+                        "card": { "type": "AdaptiveCard", "body": [ { "type": "Image", "url": "https://adaptivecards.io/c.png" } ] }
+                    }
+                ]
+            })card";
+            const auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+            const auto binary = card->SerializeBinary();
+            const CardView view(binary.data(), binary.size());
+
+            const auto expected = card->GetResourceInformation();
+            const auto actual = view.GetResourceInformation();
+            Assert::AreEqual(9u, static_cast<unsigned int>(expected.size()));
+            Assert::AreEqual(static_cast<unsigned int>(expected.size()), static_cast<unsigned int>(actual.size()));
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                Assert::AreEqual(expected[i].url, actual[i].url);
+                Assert::AreEqual(expected[i].mimeType, actual[i].mimeType);
+            }
+        }
+
+        TEST_METHOD(RejectsBuffersThatArentCards)
+        {
+            const auto binary = BinaryCardFormat::Write(Json::Value("not a card"));
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { CardView view(binary.data(), binary.size()); });
+        }
+    };
+}
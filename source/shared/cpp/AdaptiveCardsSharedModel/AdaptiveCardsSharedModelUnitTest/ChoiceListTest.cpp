@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "EverythingBagel.h"
+#include "ChoiceInput.h"
+#include "ChoiceList.h"
+#include "ChoiceSetInput.h"
+#include "Container.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(ChoiceListTest)
+    {
+    private:
+        const std::string c_card = R"card({
+            "type": "AdaptiveCard",
+            "version": "1.2",
+            "body": [
+                {
+                    "type": "Input.ChoiceSet",
+                    "id": "city",
+                    "isMultiSelect": true,
+                    "value": "sea,nope,pdx",
+                    "choices": [
+                        { "title": "Seattle", "value": "sea" },
+                        { "title": "Portland", "value": "pdx" },
+                        { "title": "San Francisco", "value": "sfo" },
+                        { "title": "seaside", "value": "sea" },
+                        { "title": "Spokane", "value": "geg" }
+                    ]
+                }
+            ]
+        })card";
+
+        std::shared_ptr<ChoiceSetInput> ParseChoiceSet(size_t compactChoiceThreshold)
+        {
+            ParseContext context;
+            context.SetCompactChoiceThreshold(compactChoiceThreshold);
+            auto card = AdaptiveCard::DeserializeFromString(c_card, "1.2", context)->GetAdaptiveCard();
+            return std::static_pointer_cast<ChoiceSetInput>(card->GetBody()[0]);
+        }
+
+    public:
+        TEST_METHOD(StoresLargeChoiceSetsCompactly)
+        {
+            Assert::IsTrue(ParseChoiceSet(0)->GetChoiceList() == nullptr);
+            Assert::IsTrue(ParseChoiceSet(6)->GetChoiceList() == nullptr);
+
+            auto choiceSet = ParseChoiceSet(5);
+            auto choiceList = choiceSet->GetChoiceList();
+            Assert::IsTrue(choiceList != nullptr);
+            Assert::AreEqual(5U, static_cast<unsigned int>(choiceList->GetCount()));
+            Assert::AreEqual(std::string("San Francisco"), choiceList->GetTitle(2));
+            Assert::AreEqual(std::string("sfo"), choiceList->GetValue(2));
+
+            // Serializes the same either way
+            Assert::AreEqual(ParseChoiceSet(0)->Serialize(), choiceSet->Serialize());
+        }
+
+        TEST_METHOD(FindsValuesAndTitles)
+        {
+            auto choiceList = ParseChoiceSet(1)->GetChoiceList();
+
+            Assert::AreEqual(0U, static_cast<unsigned int>(choiceList->FindValue("sea")));
+            Assert::AreEqual(4U, static_cast<unsigned int>(choiceList->FindValue("geg")));
+            Assert::IsTrue(choiceList->FindValue("Seattle") == ChoiceList::NotFound);
+
+            const std::vector<size_t> selected{0, 1};
+            Assert::IsTrue(choiceList->FindValues("sea,nope,pdx") == selected);
+            Assert::IsTrue(choiceList->FindValues("").empty());
+
+            const std::vector<size_t> sea{0, 3};
+            Assert::IsTrue(choiceList->FindTitlesWithPrefix("SEA") == sea);
+            const std::vector<size_t> s{0, 2, 3, 4};
+            Assert::IsTrue(choiceList->FindTitlesWithPrefix("s") == s);
+            const std::vector<size_t> firstTwo{0, 2};
+            Assert::IsTrue(choiceList->FindTitlesWithPrefix("s", 2) == firstTwo);
+            Assert::IsTrue(choiceList->FindTitlesWithPrefix("Seattles").empty());
+            Assert::AreEqual(5U, static_cast<unsigned int>(choiceList->FindTitlesWithPrefix("").size()));
+
+            auto fromChoices = ChoiceList::FromChoices(ParseChoiceSet(0)->GetChoices());
+            Assert::IsTrue(fromChoices->FindTitlesWithPrefix("sea") == sea);
+        }
+
+        TEST_METHOD(ChoiceInputsAreCreatedOnDemand)
+        {
+            auto choiceSet = ParseChoiceSet(1);
+
+            const auto& constChoiceSet = *choiceSet;
+            Assert::AreEqual(5U, static_cast<unsigned int>(constChoiceSet.GetChoices().size()));
+            Assert::AreEqual(std::string("Portland"), constChoiceSet.GetChoices()[1]->GetTitle());
+            Assert::IsTrue(choiceSet->GetChoiceList() != nullptr);
+
+            // Reading through the non-const overload keeps the compact list
+            Assert::AreEqual(std::string("Portland"), choiceSet->GetChoices()[1]->GetTitle());
+            Assert::IsTrue(choiceSet->GetChoiceList() != nullptr);
+
+            // Changes are made by setting the choices
+            auto choices = choiceSet->GetChoices();
+            choices[1] = std::make_shared<ChoiceInput>();
+            choices[1]->SetTitle("Rose City");
+            choices[1]->SetValue("pdx");
+            choiceSet->SetChoices(choices);
+            Assert::IsTrue(choiceSet->GetChoiceList() == nullptr);
+            Assert::IsTrue(choiceSet->Serialize().find("Rose City") != std::string::npos);
+
+            choiceSet->SetChoiceList(ChoiceList::FromChoices(choiceSet->GetChoices()));
+            Assert::AreEqual(1U, static_cast<unsigned int>(choiceSet->GetChoiceList()->FindTitlesWithPrefix("rose").front()));
+        }
+
+        TEST_METHOD(KeepsAdditionalPropertiesOfChoices)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    {
+                        "type": "Input.ChoiceSet",
+                        "id": "city",
+                        "choices": [
+                            { "title": "Seattle", "value": "sea", "region": "west" },
+                            { "title": "Boston", "value": "bos" }
+                        ]
+                    }
+                ]
+            })card";
+
+            for (const size_t threshold : {0, 1})
+            {
+                ParseContext context;
+                context.SetCompactChoiceThreshold(threshold);
+                auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2", context)->GetAdaptiveCard();
+                auto choiceSet = std::static_pointer_cast<ChoiceSetInput>(card->GetBody()[0]);
+                Assert::AreEqual(threshold != 0, choiceSet->GetChoiceList() != nullptr);
+
+                Assert::AreEqual(std::string("west"), choiceSet->GetChoices()[0]->GetAdditionalProperties()["region"].asString());
+                Assert::IsTrue(choiceSet->GetChoices()[1]->GetAdditionalProperties().empty());
+
+                // Serializing and parsing again keeps them
+                ParseContext reparseContext;
+                reparseContext.SetCompactChoiceThreshold(threshold);
+                auto reparsed = AdaptiveCard::DeserializeFromString(card->Serialize(), "1.2", reparseContext)->GetAdaptiveCard();
+                auto reparsedChoices = std::static_pointer_cast<ChoiceSetInput>(reparsed->GetBody()[0])->GetChoices();
+                Assert::AreEqual(std::string("west"), reparsedChoices[0]->GetAdditionalProperties()["region"].asString());
+            }
+        }
+
+        TEST_METHOD(LeavesChoiceTypesOut)
+        {
+            // Choices tagged "type": "Input.Choice" serialize as they always have, without it, and the compact list
+            // keeps no additional properties for them
+            for (const size_t threshold : {0, 1})
+            {
+                ParseContext context;
+                context.SetCompactChoiceThreshold(threshold);
+                auto card = AdaptiveCard::DeserializeFromFile("EverythingBagel.json", "1.0", context)->GetAdaptiveCard();
+                Assert::AreEqual(std::string(EVERYTHING_JSON), card->Serialize());
+
+                auto inputs = std::static_pointer_cast<Container>(card->GetBody()[7]);
+                auto choiceSet = std::static_pointer_cast<ChoiceSetInput>(inputs->GetItems()[6]);
+                Assert::AreEqual(threshold != 0, choiceSet->GetChoiceList() != nullptr);
+                for (const auto& choice : choiceSet->GetChoices())
+                {
+                    Assert::IsTrue(choice->GetAdditionalProperties().empty());
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "AdaptiveBase64Util.h"
+#include "Container.h"
+#include "DataUri.h"
+#include "Image.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(DataUriTest)
+    {
+    public:
+        TEST_METHOD(InternsLargeDataUris)
+        {
+            const std::vector<char> content(6000, 'x');
+            const std::string dataUri = "data:image/png;base64," + AdaptiveBase64Util::Encode(content);
+            const std::string cardJson = R"({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "Image", "url": ")" + dataUri + R"(" },
+                    { "type": "Container", "backgroundImage": ")" + dataUri + R"(", "items": [ { "type": "Image", "url": ")" + dataUri + R"(" } ] },
+                    { "type": "Image", "url": "data:image/png;base64,AA==" }
+                ]
+            })";
+            const auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+
+            const auto& first = std::static_pointer_cast<Image>(card->GetBody()[0]);
+            const auto& container = std::static_pointer_cast<Container>(card->GetBody()[1]);
+            const auto& nested = std::static_pointer_cast<Image>(container->GetItems()[0]);
+            Assert::IsNotNull(first->GetDataUri().get());
+            Assert::IsTrue(first->GetDataUri() == nested->GetDataUri());
+            Assert::IsTrue(first->GetDataUri() == container->GetBackgroundImage()->GetDataUri());
+            Assert::IsTrue(&first->GetUrlRef() == &nested->GetUrlRef());
+            Assert::AreEqual(dataUri, first->GetUrl());
+            Assert::AreEqual(std::string("image/png"), first->GetDataUri()->GetMimeType());
+            Assert::IsTrue(first->GetDataUri()->GetData() == content);
+            Assert::IsTrue(&first->GetDataUri()->GetData() == &nested->GetDataUri()->GetData());
+
+            // Small data URIs stay strings
+            const auto& small = std::static_pointer_cast<Image>(card->GetBody()[2]);
+            Assert::IsNull(small->GetDataUri().get());
+            Assert::AreEqual(std::string("data:image/png;base64,AA=="), small->GetUrl());
+
+            // Round trips unchanged
+            const auto reparsed = AdaptiveCard::DeserializeFromString(card->Serialize(), "1.2")->GetAdaptiveCard();
+            Assert::AreEqual(dataUri, std::static_pointer_cast<Image>(reparsed->GetBody()[0])->GetUrl());
+            Assert::AreEqual(dataUri, std::static_pointer_cast<Container>(reparsed->GetBody()[1])->GetBackgroundImage()->GetUrl());
+
+            first->SetUrl("https://adaptivecards.io/a.png");
+            Assert::IsNull(first->GetDataUri().get());
+            Assert::AreEqual(std::string("https://adaptivecards.io/a.png"), first->GetUrl());
+        }
+
+        TEST_METHOD(ThresholdZeroTurnsInterningOff)
+        {
+            const std::string dataUri = "data:text/plain," + std::string(5000, 'x');
+            ParseContext context;
+            context.SetDataUriInternThreshold(0);
+            const auto card = AdaptiveCard::DeserializeFromString(
+                R"({ "type": "AdaptiveCard", "version": "1.2", "body": [ { "type": "Image", "url": ")" + dataUri + R"(" } ] })", "1.2", context)->GetAdaptiveCard();
+
+            const auto& image = std::static_pointer_cast<Image>(card->GetBody()[0]);
+            Assert::IsNull(image->GetDataUri().get());
+            Assert::AreEqual(dataUri, image->GetUrl());
+        }
+    };
+}
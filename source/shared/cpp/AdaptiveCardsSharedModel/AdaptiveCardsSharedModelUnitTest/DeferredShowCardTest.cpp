@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include <thread>
+#include "ActionSet.h"
+#include "Container.h"
+#include "FallbackResolver.h"
+#include "ParseContext.h"
+#include "ParseUtil.h"
+#include "RenderPrep.h"
+#include "ShowCardAction.h"
+#include "TextBlock.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace
+{
+    const std::string c_cardJson = R"card({
+        "type": "AdaptiveCard",
+        "version": "1.2",
+        "lang": "fr",
+        "body": [ { "type": "TextBlock", "id": "title", "text": "Approve?" } ],
+        "actions": [
+            {
+                "type": "Action.ShowCard",
+                "id": "approve",
+                "card": {
+                    "type": "AdaptiveCard",
+                    "backgroundImage": "https://adaptivecards.io/background.png",
+                    "minHeight": "-50px",
+                    "body": [
+                        { "type": "Input.Text", "id": "comment", "placeholder": "Comment" },
+                        { "type": "Image", "id": "chart", "url": "https://adaptivecards.io/chart.png" },
+                        {
+                            "type": "Graph",
+                            "id": "graph",
+                            "fallback": { "type": "TextBlock", "id": "graph", "text": "No graph" }
+                        }
+                    ],
+                    "actions": [ { "type": "Action.Submit", "id": "send", "iconUrl": "https://adaptivecards.io/send.png" } ]
+                }
+            },
+            {
+                "type": "Action.ShowCard",
+                "id": "reject",
+                "card": { "type": "AdaptiveCard", "version": "1.0", "body": [ { "type": "TextBlock", "id": "reason", "text": "Why?" } ] }
+            }
+        ]
+    })card";
+
+    std::shared_ptr<AdaptiveCard> ParseDeferred(const std::string& json)
+    {
+        ParseContext context;
+        context.SetDeferShowCardParsing(true);
+        return AdaptiveCard::DeserializeFromString(json, "1.2", context)->GetAdaptiveCard();
+    }
+
+    std::shared_ptr<ShowCardAction> GetShowCard(const AdaptiveCard& card, size_t index)
+    {
+        return std::static_pointer_cast<ShowCardAction>(card.GetActions()[index]);
+    }
+}
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(DeferredShowCardTest)
+    {
+    public:
+        TEST_METHOD(ParsesOnFirstGetCard)
+        {
+            const auto eager = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            const auto deferred = ParseDeferred(c_cardJson);
+            const auto approve = GetShowCard(*deferred, 0);
+            Assert::IsTrue(approve->IsCardDeferred());
+            Assert::IsFalse(GetShowCard(*eager, 0)->IsCardDeferred());
+
+            const auto card = approve->GetCard();
+            Assert::IsFalse(approve->IsCardDeferred());
+            Assert::IsTrue(card == approve->GetCard());
+            Assert::AreEqual(3u, static_cast<unsigned int>(card->GetBody().size()));
+
+            // The card takes its version and language from the card containing it, as it would have if parsed then
+            Assert::AreEqual(std::string("1.2"), card->GetVersion());
+            Assert::AreEqual(std::string("fr"), card->GetLanguage());
+            Assert::AreEqual(std::string("1.0"), GetShowCard(*deferred, 1)->GetCard()->GetVersion());
+            Assert::AreEqual(eager->Serialize(), deferred->Serialize());
+
+            // Its warnings are kept with it
+            Assert::AreEqual(1u, static_cast<unsigned int>(approve->GetDeferredCardWarnings().size()));
+            Assert::IsTrue(approve->GetDeferredCardWarnings()[0]->GetStatusCode() == WarningStatusCode::InvalidDimensionSpecified);
+
+            // A card built as a Json::Value has no text to keep its ShowCard cards as, but defers them the same
+            ParseContext context;
+            context.SetDeferShowCardParsing(true);
+            const auto fromValue = AdaptiveCard::Deserialize(ParseUtil::GetJsonValueFromString(c_cardJson), "1.2", context)->GetAdaptiveCard();
+            Assert::IsTrue(GetShowCard(*fromValue, 0)->IsCardDeferred());
+            Assert::AreEqual(3u, static_cast<unsigned int>(fromValue->GetResourceInformation().size()));
+            GetShowCard(*fromValue, 0)->GetCard();
+            GetShowCard(*fromValue, 1)->GetCard();
+            Assert::AreEqual(eager->Serialize(), fromValue->Serialize());
+        }
+
+        TEST_METHOD(SerializesWithoutParsing)
+        {
+            // A deferred card is serialized from its JSON, so a card that wouldn't parse doesn't keep the card
+            // containing it from serializing
+            std::string invalid = c_cardJson;
+            invalid.replace(invalid.find("\"id\": \"comment\", "), 17, "");
+            const auto card = ParseDeferred(invalid);
+            const auto approve = GetShowCard(*card, 0);
+
+            const Json::Value json = ParseUtil::GetJsonValueFromString(card->Serialize());
+            Assert::IsTrue(approve->IsCardDeferred());
+            const Json::Value& input = json["actions"][0]["card"]["body"][0];
+            Assert::AreEqual(std::string("Comment"), input["placeholder"].asString());
+            Assert::IsFalse(input.isMember("id"));
+            Assert::AreEqual(std::string("1.2"), json["actions"][0]["card"]["version"].asString());
+
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { approve->GetCard(); });
+            Assert::AreEqual(json.toStyledString(), ParseUtil::GetJsonValueFromString(card->Serialize()).toStyledString());
+        }
+
+        TEST_METHOD(ParsesInTheStateOfTheAction)
+        {
+            // A container in a ShowCard card is styled against the containers the action is in, as it would be if the
+            // card were parsed with them
+            const std::string json = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    {
+                        "type": "Container",
+                        "style": "emphasis",
+                        "items": [
+                            {
+                                "type": "ActionSet",
+                                "actions": [
+                                    {
+                                        "type": "Action.ShowCard",
+                                        "card": {
+                                            "type": "AdaptiveCard",
+                                            "body": [ { "type": "Container", "style": "emphasis", "bleed": true, "items": [] } ]
+                                        }
+                                    }
+                                ]
+                            }
+                        ]
+                    }
+                ]
+            })card";
+            const auto getInner = [](const AdaptiveCard& card) {
+                const auto& outer = static_cast<const Container&>(*card.GetBody()[0]);
+                const auto& actionSet = static_cast<const ActionSet&>(*outer.GetItems()[0]);
+                const auto& showCard = static_cast<const ShowCardAction&>(*actionSet.GetActions()[0]);
+                return std::static_pointer_cast<Container>(showCard.GetCard()->GetBody()[0]);
+            };
+
+            const auto eager = getInner(*AdaptiveCard::DeserializeFromString(json, "1.2")->GetAdaptiveCard());
+            const auto deferred = getInner(*ParseDeferred(json));
+            Assert::IsFalse(eager->GetPadding());
+            Assert::AreEqual(eager->GetPadding(), deferred->GetPadding());
+            Assert::AreEqual(eager->GetCanBleed(), deferred->GetCanBleed());
+            Assert::IsTrue(eager->GetBleedDirection() == deferred->GetBleedDirection());
+        }
+
+        TEST_METHOD(LeavesDeferredCardsToRenderers)
+        {
+            // Preparing and resolving fallback for a card don't parse its deferred cards, so an invalid one doesn't
+            // keep the rest of the card from rendering
+            std::string invalid = c_cardJson;
+            invalid.replace(invalid.find("\"fallback\": {"), 13, "\"fallback\": \"skip\", \"unused\": {");
+            const auto card = ParseDeferred(invalid);
+
+            HostConfig hostConfig;
+            Assert::AreEqual(1u, static_cast<unsigned int>(RenderPrep::Prepare(*card, hostConfig)->GetElementCount()));
+            FallbackResolver(FeatureRegistration()).Resolve(card);
+            Assert::IsTrue(GetShowCard(*card, 0)->IsCardDeferred());
+
+            // A card that has been parsed is prepared with the rest
+            GetShowCard(*card, 1)->GetCard();
+            Assert::AreEqual(2u, static_cast<unsigned int>(RenderPrep::Prepare(*card, hostConfig)->GetElementCount()));
+        }
+
+        TEST_METHOD(ChecksIdsAsItParses)
+        {
+            // Fallback content sharing its element's id is fine in a deferred card, as in any other
+            ParseDeferred(c_cardJson);
+
+            std::string collision = c_cardJson;
+            collision.replace(collision.find("\"reason\""), 8, "\"title\"");
+            try
+            {
+                ParseDeferred(collision);
+                Assert::IsTrue(false, L"Deserializing should throw an exception");
+            }
+            catch (const AdaptiveCardParseException& e)
+            {
+                Assert::IsTrue(ErrorStatusCode::IdCollision == e.GetStatusCode(), L"ErrorStatusCode incorrect");
+            }
+
+            // Other errors in the card are only found when it's parsed, and are thrown every time it's asked for
+            std::string invalid = c_cardJson;
+            invalid.replace(invalid.find("\"fallback\": {"), 13, "\"fallback\": \"skip\", \"unused\": {");
+            const auto card = ParseDeferred(invalid);
+            const auto approve = GetShowCard(*card, 0);
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { approve->GetCard(); });
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { approve->GetCard(); });
+        }
+
+        TEST_METHOD(ListsResourcesWithoutParsing)
+        {
+            const auto eager = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            const auto deferred = ParseDeferred(c_cardJson);
+
+            const auto expected = eager->GetResourceInformation();
+            const auto resources = deferred->GetResourceInformation();
+            Assert::AreEqual(3u, static_cast<unsigned int>(resources.size()));
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                Assert::AreEqual(expected[i].url, resources[i].url);
+                Assert::AreEqual(expected[i].mimeType, resources[i].mimeType);
+            }
+            Assert::IsTrue(GetShowCard(*deferred, 0)->IsCardDeferred());
+
+            // Looking up an element in a deferred card parses it
+            const auto reason = deferred->GetElementById("reason");
+            Assert::IsTrue(reason != nullptr);
+            Assert::AreEqual(std::string("Why?"), std::static_pointer_cast<TextBlock>(reason)->GetText());
+            Assert::IsTrue(deferred->GetElementById("missing") == nullptr);
+        }
+
+        TEST_METHOD(ParsesOnceAcrossThreads)
+        {
+            const auto deferred = ParseDeferred(c_cardJson);
+            const auto approve = GetShowCard(*deferred, 0);
+
+            std::vector<std::shared_ptr<AdaptiveCard>> cards(4);
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < cards.size(); i++)
+            {
+                threads.emplace_back([&, i]() { cards[i] = approve->GetCard(); });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            for (const auto& card : cards)
+            {
+                Assert::IsTrue(card != nullptr);
+                Assert::IsTrue(card == cards[0]);
+            }
+        }
+    };
+}
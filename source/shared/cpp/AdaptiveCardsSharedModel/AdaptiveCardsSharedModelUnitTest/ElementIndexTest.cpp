@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include <thread>
+#include "Container.h"
+#include "ShowCardAction.h"
+#include "TextBlock.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(ElementIndexTest)
+    {
+    private:
+        const std::string c_card = R"card({
+            "type": "AdaptiveCard",
+            "version": "1.2",
+            "body": [
+                {
+                    "type": "Container",
+                    "id": "container",
+                    "items": [
+                        {
+                            "type": "ColumnSet",
+                            "columns": [ { "type": "Column", "id": "column", "items": [ { "type": "TextBlock", "id": "text", "text": "a" } ] } ]
+                        },
+                        { "type": "ImageSet", "images": [ { "type": "Image", "id": "image", "url": "https://example.com/a.png" } ] }
+                    ]
+                },
+                {
+                    "type": "FancyInput",
+                    "id": "phone",
+                    "fallback": { "type": "Input.Text", "id": "phone" }
+                },
+                {
+                    "type": "FancyElement",
+                    "fallback": { "type": "TextBlock", "id": "fallbackOnly", "text": "b" }
+                },
+                { "type": "ActionSet", "actions": [ { "type": "Action.Submit", "id": "submit" } ] }
+            ],
+            "actions": [
+                {
+                    "type": "Action.ShowCard",
+                    "id": "show",
+                    "card": { "type": "AdaptiveCard", "body": [ { "type": "Input.Text", "id": "nested" } ] }
+                },
+                { "type": "Action.ToggleVisibility", "targetElements": [ "column" ] }
+            ]
+        })card";
+
+    public:
+        TEST_METHOD(FindsElementsAnywhereInTheCard)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_card, "1.2")->GetAdaptiveCard();
+
+            for (const auto id : {"container", "column", "text", "image", "submit", "show", "nested", "fallbackOnly"})
+            {
+                auto element = card->GetElementById(id);
+                Assert::IsTrue(element != nullptr);
+                Assert::AreEqual(std::string(id), element->GetId());
+            }
+            Assert::IsTrue(card->GetElementById("missing") == nullptr);
+
+            // The element rather than the fallback content that shares its id
+            auto phone = card->GetElementById("phone");
+            Assert::AreEqual(std::string("FancyInput"), phone->GetElementTypeString());
+            Assert::IsTrue(phone->GetFallbackContent() != nullptr);
+
+            // ShowCard cards have their own index
+            auto showCard = std::static_pointer_cast<ShowCardAction>(card->GetElementById("show"));
+            Assert::IsTrue(showCard->GetCard()->GetElementById("nested") == card->GetElementById("nested"));
+            Assert::IsTrue(showCard->GetCard()->GetElementById("text") == nullptr);
+        }
+
+        TEST_METHOD(FollowsChangesToTheCard)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_card, "1.2")->GetAdaptiveCard();
+
+            auto added = std::make_shared<TextBlock>();
+            added->SetId("added");
+            card->GetBody().push_back(added);
+            Assert::IsTrue(card->GetElementById("added") == nullptr);
+            card->InvalidateElementIndex();
+            Assert::IsTrue(card->GetElementById("added") == added);
+
+            auto text = card->GetElementById("text");
+            text->SetId("renamed");
+            Assert::IsTrue(card->GetElementById("text") == nullptr);
+            Assert::IsTrue(card->GetElementById("renamed") == text);
+
+            // Changes made through a container retrieved earlier need the index to be invalidated
+            auto container = std::static_pointer_cast<Container>(card->GetElementById("container"));
+            auto inner = std::make_shared<TextBlock>();
+            inner->SetId("inner");
+            container->GetItems().push_back(inner);
+            card->InvalidateElementIndex();
+            Assert::IsTrue(card->GetElementById("inner") == inner);
+
+            container->GetItems().clear();
+            inner.reset();
+            text.reset();
+            Assert::IsTrue(card->GetElementById("inner") == nullptr);
+            Assert::IsTrue(card->GetElementById("renamed") == nullptr);
+        }
+
+        TEST_METHOD(IndexesCardsBuiltInCode)
+        {
+            AdaptiveCard card;
+            auto textBlock = std::make_shared<TextBlock>();
+            textBlock->SetId("text");
+            card.GetBody().push_back(textBlock);
+
+            Assert::IsTrue(card.GetElementById("text") == textBlock);
+        }
+
+        TEST_METHOD(ConcurrentLookups)
+        {
+            // The first lookups build the index of a card built in code, and the threads race to do so
+            AdaptiveCard card;
+            for (int i = 0; i < 200; ++i)
+            {
+                auto textBlock = std::make_shared<TextBlock>();
+                textBlock->SetId("text" + std::to_string(i));
+                card.GetBody().push_back(textBlock);
+            }
+
+            std::vector<int> found(4, 0);
+            std::vector<std::thread> threads;
+            for (size_t thread = 0; thread < found.size(); ++thread)
+            {
+                threads.emplace_back([&card, &found, thread]() {
+                    for (int i = 0; i < 200; ++i)
+                    {
+                        const auto element = card.GetElementById("text" + std::to_string(i));
+                        found[thread] += (element && element->GetId() == "text" + std::to_string(i)) ? 1 : 0;
+                    }
+                });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            for (const int count : found)
+            {
+                Assert::AreEqual(200, count);
+            }
+        }
+    };
+}
@@ -572,5 +572,20 @@ namespace AdaptiveCardsSharedModelUnitTest
             const std::string actualJson {everythingBagel->Serialize()};
             Assert::AreEqual(expectedJson, actualJson);
         }
+
+        TEST_METHOD(EverythingBagelWarnsOnce)
+        {
+            // Parsing the card of a ShowCard action doesn't give the warnings found before it a second time
+            auto parseResult = AdaptiveCard::DeserializeFromFile("EverythingBagel.json", "1.0");
+            auto parseWarnings = parseResult->GetWarnings();
+            for (size_t i = 0; i < parseWarnings.size(); i++)
+            {
+                for (size_t j = i + 1; j < parseWarnings.size(); j++)
+                {
+                    Assert::IsFalse(parseWarnings[i]->GetStatusCode() == parseWarnings[j]->GetStatusCode() &&
+                                    parseWarnings[i]->GetReason() == parseWarnings[j]->GetReason());
+                }
+            }
+        }
     };
 }
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "Container.h"
+#include "FallbackResolver.h"
+#include "ShowCardAction.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace
+{
+    const std::string c_cardJson = R"card({
+        "type": "AdaptiveCard",
+        "version": "1.2",
+        "body": [
+            { "type": "TextBlock", "id": "plain", "text": "Plain" },
+            {
+                "type": "TextBlock",
+                "id": "needsFeature",
+                "text": "Needs acTest 2",
+                "requires": { "acTest": "2.0" },
+                "fallback": {
+                    "type": "Graph",
+                    "id": "graphFallback",
+                    "fallback": { "type": "TextBlock", "id": "finalFallback", "text": "Final" }
+                }
+            },
+            { "type": "Image", "id": "dropped", "url": "a.png", "requires": { "acTest": "2.0" }, "fallback": "drop" },
+            {
+                "type": "Container",
+                "id": "outer",
+                "fallback": { "type": "TextBlock", "id": "outerFallback", "text": "Outer" },
+                "items": [ { "type": "TextBlock", "id": "fine", "text": "Fine" }, { "type": "Graph", "id": "inner" } ]
+            },
+            { "type": "Graph", "id": "lonely" }
+        ],
+        "actions": [
+            {
+                "type": "Action.Submit",
+                "id": "submit",
+                "requires": { "acTest": "2.0" },
+                "fallback": { "type": "Action.OpenUrl", "id": "openUrl", "url": "https://adaptivecards.io" }
+            },
+            {
+                "type": "Action.ShowCard",
+                "id": "show",
+                "card": { "type": "AdaptiveCard", "body": [ { "type": "Graph", "id": "shownGraph", "fallback": "drop" } ] }
+            }
+        ]
+    })card";
+
+    FeatureRegistration MakeRegistration()
+    {
+        FeatureRegistration featureRegistration;
+        featureRegistration.AddFeature("acTest", "1.0");
+        return featureRegistration;
+    }
+}
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(FallbackResolverTest)
+    {
+    public:
+        TEST_METHOD(ResolvesFallbackOnce)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            FallbackResolver resolver(MakeRegistration());
+            const auto resolution = resolver.Resolve(card);
+            const auto& body = card->GetBody();
+
+            Assert::IsTrue(resolution->GetRenderedElement(*body[0]) == body[0].get());
+            Assert::AreEqual(std::string("finalFallback"), resolution->GetRenderedElement(*body[1])->GetId());
+            Assert::IsNull(resolution->GetRenderedElement(*body[2]));
+
+            // A child that can't be rendered and has no fallback of its own falls back to its ancestor's
+            Assert::AreEqual(std::string("outerFallback"), resolution->GetRenderedElement(*body[3])->GetId());
+            Assert::IsNull(resolution->GetRenderedElement(*body[4]));
+
+            const auto& actions = card->GetActions();
+            Assert::AreEqual(std::string("openUrl"), resolution->GetRenderedAction(*actions[0])->GetId());
+            Assert::IsTrue(resolution->GetRenderedAction(*actions[1]) == actions[1].get());
+            const auto& shownGraph = *std::static_pointer_cast<ShowCardAction>(actions[1])->GetCard()->GetBody()[0];
+            Assert::IsNull(resolution->GetRenderedElement(shownGraph));
+
+            const auto& warnings = resolution->GetWarnings();
+            Assert::AreEqual(7u, static_cast<unsigned int>(warnings.size()));
+            Assert::AreEqual(std::string("Performing fallback for 'TextBlock' (fallback element type: 'Graph')"), warnings[0]->GetReason());
+            Assert::AreEqual(std::string("Performing fallback for 'Graph' (fallback element type: 'TextBlock')"), warnings[1]->GetReason());
+            Assert::AreEqual(std::string("Dropping element 'Image' for fallback"), warnings[2]->GetReason());
+            Assert::AreEqual(std::string("Performing fallback for 'Container' (fallback element type: 'TextBlock')"), warnings[3]->GetReason());
+            Assert::IsTrue(warnings[4]->GetStatusCode() == WarningStatusCode::NoRendererForType);
+            Assert::IsTrue(warnings[5]->GetStatusCode() == WarningStatusCode::UnknownActionElementType);
+            Assert::AreEqual(std::string("Dropping element 'Graph' for fallback"), warnings[6]->GetReason());
+        }
+
+        TEST_METHOD(HonorsHostRenderers)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            auto elementTypes = FallbackResolver::GetBuiltInElementTypes();
+            elementTypes.insert("Graph");
+            elementTypes.erase("Image");
+            FallbackResolver resolver(MakeRegistration(), elementTypes);
+            const auto resolution = resolver.Resolve(card);
+            const auto& body = card->GetBody();
+
+            Assert::AreEqual(std::string("graphFallback"), resolution->GetRenderedElement(*body[1])->GetId());
+            Assert::IsTrue(resolution->GetRenderedElement(*body[3]) == body[3].get());
+            Assert::IsTrue(resolution->GetRenderedElement(*body[4]) == body[4].get());
+        }
+
+        TEST_METHOD(CachesPerCard)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            const auto other = AdaptiveCard::DeserializeFromString(c_cardJson, "1.2")->GetAdaptiveCard();
+            FallbackResolver resolver(MakeRegistration());
+
+            const auto resolution = resolver.Resolve(card);
+            Assert::IsTrue(resolver.Resolve(card) == resolution);
+            Assert::IsFalse(resolver.Resolve(other) == resolution);
+
+            // After a change, the card is resolved again
+            std::static_pointer_cast<Container>(card->GetBody()[3])->GetItems().pop_back();
+            resolver.Invalidate(*card);
+            const auto changed = resolver.Resolve(card);
+            Assert::IsFalse(changed == resolution);
+            Assert::IsTrue(changed->GetRenderedElement(*card->GetBody()[3]) == card->GetBody()[3].get());
+        }
+    };
+}
@@ -522,6 +522,37 @@ namespace AdaptiveCardsSharedModelUnitTest
             AdaptiveCard::DeserializeFromString(cardStr, "1.2");
         }
 
+        TEST_METHOD(ManyIdsWithFallback)
+        {
+            // every element has a unique id and every tenth has fallback content reusing it
+            std::string body;
+            for (unsigned int i = 0; i < 2000; i++)
+            {
+                const std::string id = "id" + std::to_string(i);
+                body += (i == 0) ? "" : ",";
+                body += (i % 10 == 0) ? R"({"type": "Fancy", "id": ")" + id + R"(", "fallback": {"type": "TextBlock", "id": ")" + id + R"(", "text": "x"}})" :
+                                        R"({"type": "TextBlock", "id": ")" + id + R"(", "text": "x"})";
+            }
+
+            const std::string cardStr = R"({"type": "AdaptiveCard", "version": "1.2", "body": [)" + body + "]}";
+            auto parseResult = AdaptiveCard::DeserializeFromString(cardStr, "1.2");
+            Assert::AreEqual(2000U, static_cast<unsigned int>(parseResult->GetAdaptiveCard()->GetBody().size()));
+
+            // a repeat of an early id (one that served as a fallback parent, too) is still caught at the end
+            const std::string duplicateStr = R"({"type": "AdaptiveCard", "version": "1.2", "body": [)" + body +
+                R"(, {"type": "TextBlock", "id": "id10", "text": "x"}]})";
+            try
+            {
+                AdaptiveCard::DeserializeFromString(duplicateStr, "1.2");
+                Assert::IsTrue(false, L"Deserializing should throw an exception");
+            }
+            catch (const AdaptiveCardParseException& e)
+            {
+                Assert::IsTrue(ErrorStatusCode::IdCollision == e.GetStatusCode(), L"ErrorStatusCode incorrect");
+                Assert::AreEqual("Collision detected for id 'id10'", e.GetReason().c_str(), L"GetReason incorrect");
+            }
+        }
+
         TEST_METHOD(RequiresAndFallbackSerialization)
         {
             std::string cardStr = R"card({
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "HtmlRenderer.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(HtmlRendererTest)
+    {
+    private:
+        static bool Contains(const std::string& html, const std::string& fragment)
+        {
+            return html.find(fragment) != std::string::npos;
+        }
+
+    public:
+        TEST_METHOD(RendersTextWithMarkDownAndHostConfigStyles)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    {
+                        "type": "TextBlock",
+                        "text": "Hello **world** <b>&",
+                        "size": "large",
+                        "weight": "bolder",
+                        "color": "attention",
+                        "wrap": true
+                    },
+                    {
+                        "type": "TextBlock",
+                        "text": "Due {{DATE(2017-02-13T20:46:30Z, LONG)}}",
+                        "spacing": "large",
+                        "separator": true
+                    }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+
+            HostConfig hostConfig = HostConfig::DeserializeFromString(R"({
+                "fontSizes": { "large": 21 },
+                "spacing": { "large": 30 },
+                "separator": { "lineThickness": 2, "lineColor": "#80FF0000" }
+            })");
+            HtmlRenderer renderer(hostConfig);
+            const std::string html = renderer.Render(*card);
+
+            Assert::IsTrue(Contains(html, "<strong>world</strong>"));
+            Assert::IsTrue(Contains(html, "&lt;b&gt;&amp;"));
+            Assert::IsFalse(Contains(html, "<b>"));
+            Assert::IsTrue(Contains(html, "font-size:21px;font-weight:800;"));
+            Assert::IsTrue(Contains(html, "color:rgba(139,0,0,1.00);"));
+            Assert::IsTrue(Contains(html, "Monday, February 13, 2017"));
+
+            // spacing is split around a separator line
+            Assert::IsTrue(Contains(html, "margin-top:15px;padding-top:15px;border-top:2px solid rgba(255,0,0,0.50);"));
+        }
+
+        TEST_METHOD(AppendsToCallerBuffer)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(
+                            R"({"type": "AdaptiveCard", "version": "1.0", "body": [{"type": "TextBlock", "text": "one"}]})", "1.0")
+                            ->GetAdaptiveCard();
+            HtmlRenderer renderer{HostConfig()};
+
+            std::string output = "<html>";
+            renderer.Render(*card, output);
+            const size_t firstLength = output.size();
+            renderer.Render(*card, output);
+
+            Assert::AreEqual(0U, static_cast<unsigned int>(output.find("<html><div class=\"ac-adaptiveCard\"")));
+            Assert::AreEqual(firstLength * 2 - 6, output.size());
+            Assert::AreEqual(renderer.Render(*card), output.substr(6, firstLength - 6));
+        }
+
+        TEST_METHOD(ContainerStylesAndColumnWidths)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    {
+                        "type": "Container",
+                        "style": "emphasis",
+                        "items": [
+                            {
+                                "type": "ColumnSet",
+                                "columns": [
+                                    { "type": "Column", "width": "auto", "items": [ { "type": "TextBlock", "text": "a" } ] },
+                                    { "type": "Column", "width": 1, "items": [ { "type": "TextBlock", "text": "b" } ] },
+                                    { "type": "Column", "width": 3, "items": [ { "type": "TextBlock", "text": "c" } ] },
+                                    { "type": "Column", "width": "50px", "style": "good", "items": [ { "type": "TextBlock", "text": "d" } ] }
+                                ]
+                            }
+                        ]
+                    },
+                    { "type": "TextBlock", "text": "hidden", "isVisible": false }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+            HtmlRenderer renderer{HostConfig()};
+            const std::string html = renderer.Render(*card);
+
+            Assert::IsTrue(Contains(html, "class=\"ac-container\" style=\"background-color:rgba(0,0,0,0.03);padding:20px;"));
+            Assert::IsTrue(Contains(html, "role=\"presentation\""));
+            Assert::IsTrue(Contains(html, "width:1px;white-space:nowrap;"));
+            Assert::IsTrue(Contains(html, "width:25.0%;"));
+            Assert::IsTrue(Contains(html, "width:75.0%;"));
+            Assert::IsTrue(Contains(html, "width:50px;"));
+            Assert::IsTrue(Contains(html, "background-color:rgba(213,240,221,1.00);"));
+            Assert::IsTrue(Contains(html, "display:none;\"><p style=\"margin:0\">hidden</p>"));
+        }
+
+        TEST_METHOD(ActionsAndUnsafeUrls)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "Image", "url": "cat.png", "altText": "a \"cat\"", "style": "person", "size": "small" },
+                    { "type": "Image", "url": "javascript:alert(1)" },
+                    { "type": "Image", "url": "data:image/png;base64,iVBORw0KGgo=" },
+                    { "type": "TextBlock", "text": "[one](javascript:alert(3)) [two](JaVaScRiPt:alert(4)) [three](data:text/html,<script>alert(5)</script>) [four](https://adaptivecards.io/?a=1&b=2)" },
+                    { "type": "Input.Text", "id": "name", "placeholder": "Name" }
+                ],
+                "actions": [
+                    { "type": "Action.OpenUrl", "title": "Open", "url": "https://adaptivecards.io" },
+                    { "type": "Action.OpenUrl", "title": "Evil", "url": " JavaScript:alert(1)" },
+                    { "type": "Action.OpenUrl", "title": "Data", "url": "data:text/html,<script>alert(2)</script>image/" },
+                    { "type": "Action.Submit", "title": "Send" }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+
+            HostConfig hostConfig = HostConfig::DeserializeFromString(R"({
+                "imageBaseUrl": "https://example.com/images/",
+                "imageSizes": { "small": 40 }
+            })");
+            const std::string html = HtmlRenderer(hostConfig).Render(*card);
+
+            Assert::IsTrue(Contains(html, "src=\"https://example.com/images/cat.png\" alt=\"a &quot;cat&quot;\""));
+            Assert::IsTrue(Contains(html, "width:40px;height:40px;border-radius:50%;"));
+            Assert::IsFalse(Contains(html, "alert(1)"));
+            Assert::IsFalse(Contains(html, "alert(2)"));
+
+            // Markdown links are checked as other urls are, and unsafe ones are left as plain text
+            Assert::IsFalse(Contains(html, "alert(3)"));
+            Assert::IsFalse(Contains(html, "alert(4)"));
+            Assert::IsFalse(Contains(html, "alert(5)"));
+            Assert::IsTrue(Contains(html, ">one"));
+            Assert::IsTrue(Contains(html, "<a href=\"https://adaptivecards.io/?a=1&amp;b=2\">four</a>"));
+            Assert::IsTrue(Contains(html, "src=\"data:image/png;base64,iVBORw0KGgo=\""));
+            Assert::IsTrue(Contains(html, "href=\"https://adaptivecards.io\""));
+            Assert::IsTrue(Contains(html, "<button type=\"button\" class=\"ac-pushButton\""));
+            Assert::IsTrue(Contains(html, "<input type=\"text\" name=\"name\" placeholder=\"Name\""));
+
+            hostConfig.SetSupportsInteractivity(false);
+            const std::string staticHtml = HtmlRenderer(hostConfig).Render(*card);
+            Assert::IsFalse(Contains(staticHtml, "ac-pushButton"));
+            Assert::IsFalse(Contains(staticHtml, "<input"));
+        }
+    };
+}
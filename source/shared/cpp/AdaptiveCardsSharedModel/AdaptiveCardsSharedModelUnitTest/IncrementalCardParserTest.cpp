@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include <random>
+#include "IncrementalCardParser.h"
+#include "TextBlock.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace
+{
+    const std::string c_card = R"card({
+        "type": "AdaptiveCard",
+        "version": "1.2",
+        "body": [
+            { "type": "TextBlock", "id": "title", "text": "Lunch poll" },
+            {
+                "type": "Container",
+                "id": "options",
+                "style": "emphasis",
+                "items": [
+                    { "type": "TextBlock", "id": "pizza", "text": "Pizza: 3 votes" },
+                    { "type": "TextBlock", "id": "salad", "text": "Salad: 1 vote" },
+                    {
+                        "type": "ColumnSet",
+                        "columns": [
+                            { "items": [ { "type": "Image", "id": "chart", "url": "https://adaptivecards.io/chart.png" } ] },
+                            { "type": "Column", "bleed": true, "style": "good", "items": [ { "type": "TextBlock", "text": "Soup" } ] }
+                        ]
+                    }
+                ]
+            },
+            { "type": "ImageSet", "images": [ { "url": "https://adaptivecards.io/a.png" }, { "url": "https://adaptivecards.io/b.png" } ] },
+            { "type": "Graph", "id": "graph", "fallback": { "type": "TextBlock", "id": "graph", "text": "No graph" } }
+        ],
+        "actions": [
+            { "type": "Action.Submit", "id": "vote", "title": "Vote" },
+            {
+                "type": "Action.ShowCard",
+                "title": "Comment",
+                "card": { "type": "AdaptiveCard", "body": [ { "type": "Input.Text", "id": "comment", "placeholder": "Why?" } ] }
+            }
+        ]
+    })card";
+
+    TextEdit Insert(const std::string& text, const std::string& after, const std::string& replacement)
+    {
+        return {text.find(after) + after.size(), 0, replacement};
+    }
+
+    TextEdit Replace(const std::string& text, const std::string& from, const std::string& to)
+    {
+        return {text.find(from), from.size(), to};
+    }
+
+    // Checks the parser's card against parsing its text from scratch
+    void AssertMatchesFullParse(const IncrementalCardParser& parser, const ParseResult& result)
+    {
+        const auto expected = AdaptiveCard::DeserializeFromString(parser.GetText(), "1.2");
+        Assert::AreEqual(expected->GetAdaptiveCard()->Serialize(), result.GetAdaptiveCard()->Serialize());
+        Assert::AreEqual(static_cast<unsigned int>(expected->GetWarnings().size()), static_cast<unsigned int>(result.GetWarnings().size()));
+    }
+}
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(IncrementalCardParserTest)
+    {
+    public:
+        TEST_METHOD(ParsesOnlyTheEditedElement)
+        {
+            IncrementalCardParser parser("1.2");
+            const auto card = parser.Parse(c_card)->GetAdaptiveCard();
+            const auto oldVote = card->GetElementById("vote");
+
+            // Typing into one element parses it again and puts it in the card in place of the old one
+            const auto result = parser.ApplyEdit(Insert(parser.GetText(), "Salad: 1", "0"));
+            Assert::IsTrue(card == result->GetAdaptiveCard());
+            const auto salad = std::static_pointer_cast<TextBlock>(card->GetElementById("salad"));
+            Assert::IsTrue(salad == parser.GetLastParsedElement());
+            Assert::AreEqual(std::string("Salad: 10 vote"), salad->GetText());
+            Assert::IsTrue(oldVote == card->GetElementById("vote"));
+            AssertMatchesFullParse(parser, *result);
+
+            // The spans of the element and those after it follow the edit
+            SourceSpan span;
+            Assert::IsTrue(parser.GetSourceSpan(*salad, span));
+            Assert::AreEqual(parser.GetText().find(R"({ "type": "TextBlock", "id": "salad")"), span.begin);
+            Assert::AreEqual('}', parser.GetText()[span.end - 1]);
+            Assert::IsTrue(parser.GetSourceSpan(*oldVote, span));
+            Assert::AreEqual(parser.GetText().find(R"({ "type": "Action.Submit")"), span.begin);
+
+            // An edit between a container's items parses the container, and one to an image set's image just the image
+            parser.ApplyEdit(Insert(parser.GetText(), R"("text": "Pizza: 3 votes" },)", R"( { "type": "TextBlock", "text": "Pasta" },)"));
+            Assert::AreEqual(std::string("options"), parser.GetLastParsedElement()->GetId());
+            const auto image = parser.ApplyEdit(Replace(parser.GetText(), "b.png", "c.png"));
+            Assert::AreEqual(std::string("Image"), parser.GetLastParsedElement()->GetElementTypeString());
+            AssertMatchesFullParse(parser, *image);
+
+            // Columns that leave out their type, with the container style and bleed of the elements around them
+            const auto column = parser.ApplyEdit(Insert(parser.GetText(), R"("text": "Soup")", R"(, "size": "large")"));
+            Assert::AreEqual(std::string("Soup"), std::static_pointer_cast<TextBlock>(parser.GetLastParsedElement())->GetText());
+            AssertMatchesFullParse(parser, *column);
+            const auto firstColumn = parser.ApplyEdit(Insert(parser.GetText(), R"({ "items": [)", R"( { "type": "TextBlock", "text": "Chart" },)"));
+            Assert::AreEqual(std::string("Column"), parser.GetLastParsedElement()->GetElementTypeString());
+            AssertMatchesFullParse(parser, *firstColumn);
+        }
+
+        TEST_METHOD(ParsesTheWholeCardWhenItHasTo)
+        {
+            IncrementalCardParser parser("1.2");
+            const auto card = parser.Parse(c_card)->GetAdaptiveCard();
+
+            // The card's own properties
+            auto result = parser.ApplyEdit(Insert(parser.GetText(), R"("version": "1.2",)", R"( "speak": "Lunch",)"));
+            Assert::IsTrue(parser.GetLastParsedElement() == nullptr);
+            Assert::IsTrue(card != result->GetAdaptiveCard());
+            Assert::AreEqual(std::string("Lunch"), result->GetAdaptiveCard()->GetSpeak());
+
+            // Text that isn't one element any more
+            result = parser.ApplyEdit(Insert(parser.GetText(), R"("Pizza: 3 votes")", R"( }, { "type": "TextBlock", "text": "Pasta")"));
+            Assert::IsTrue(parser.GetLastParsedElement() == nullptr);
+            AssertMatchesFullParse(parser, *result);
+
+            // Text that doesn't parse throws as parsing it from scratch would, and is parsed in full once it's fixed
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { parser.ApplyEdit(Insert(parser.GetText(), "Lunch poll\"", ", \"wrap\":")); });
+            result = parser.ApplyEdit(Insert(parser.GetText(), "\"wrap\":", " true"));
+            Assert::IsTrue(parser.GetLastParsedElement() == nullptr);
+            AssertMatchesFullParse(parser, *result);
+            Assert::IsTrue(std::static_pointer_cast<TextBlock>(result->GetAdaptiveCard()->GetElementById("title"))->GetWrap());
+
+            // A ShowCard whose card has a style changes how the elements after it are parsed
+            parser.ApplyEdit(Insert(parser.GetText(), R"("card": { "type": "AdaptiveCard",)", R"( "style": "good",)"));
+            Assert::IsTrue(parser.GetLastParsedElement() == nullptr);
+
+            Assert::ExpectException<AdaptiveCardParseException>([&]() { parser.ApplyEdit({parser.GetText().size(), 1, ""}); });
+        }
+
+        TEST_METHOD(ChecksIdsAgainstTheRestOfTheCard)
+        {
+            IncrementalCardParser parser("1.2");
+            parser.Parse(c_card);
+
+            // A new id is checked as the element is parsed
+            auto result = parser.ApplyEdit(Replace(parser.GetText(), R"("id": "salad")", R"("id": "salads")"));
+            Assert::IsTrue(parser.GetLastParsedElement() != nullptr);
+            Assert::IsTrue(result->GetAdaptiveCard()->GetElementById("salad") == nullptr);
+            Assert::IsTrue(result->GetAdaptiveCard()->GetElementById("salads") != nullptr);
+
+            // One that's used elsewhere in the card collides, as it would parsing the card from scratch
+            try
+            {
+                parser.ApplyEdit(Replace(parser.GetText(), R"("id": "salads")", R"("id": "comment")"));
+                Assert::IsTrue(false, L"Deserializing should throw an exception");
+            }
+            catch (const AdaptiveCardParseException& e)
+            {
+                Assert::IsTrue(ErrorStatusCode::IdCollision == e.GetStatusCode(), L"ErrorStatusCode incorrect");
+            }
+            result = parser.ApplyEdit(Replace(parser.GetText(), R"("id": "comment")", R"("id": "salad")"));
+            AssertMatchesFullParse(parser, *result);
+
+            // Ids moved from one element to another are counted as they go, and fallback content keeps its element's id
+            result = parser.ApplyEdit(Replace(parser.GetText(), R"("id": "pizza")", R"("id": "pasta")"));
+            Assert::IsTrue(parser.GetLastParsedElement() != nullptr);
+            result = parser.ApplyEdit(Replace(parser.GetText(), R"("id": "title")", R"("id": "pizza")"));
+            Assert::IsTrue(parser.GetLastParsedElement() != nullptr);
+            result = parser.ApplyEdit(Replace(parser.GetText(), "No graph", "No chart"));
+            Assert::AreEqual(std::string("graph"), parser.GetLastParsedElement()->GetId());
+            AssertMatchesFullParse(parser, *result);
+        }
+
+        TEST_METHOD(KeepsTheWarningsOfEachElement)
+        {
+            IncrementalCardParser parser("1.2");
+            auto result = parser.Parse(c_card);
+            Assert::AreEqual(0u, static_cast<unsigned int>(result->GetWarnings().size()));
+
+            result = parser.ApplyEdit(Insert(parser.GetText(), R"("style": "emphasis",)", R"( "minHeight": "-5px",)"));
+            Assert::AreEqual(1u, static_cast<unsigned int>(result->GetWarnings().size()));
+            result = parser.ApplyEdit(Insert(parser.GetText(), R"("placeholder": "Why?")", R"(, "minHeight": "-5px")"));
+            Assert::AreEqual(1u, static_cast<unsigned int>(result->GetWarnings().size()));
+            result = parser.ApplyEdit(Insert(parser.GetText(), R"("type": "AdaptiveCard", "body")", R"(: [], "minHeight": "-5px", "unused")"));
+            Assert::AreEqual(2u, static_cast<unsigned int>(result->GetWarnings().size()));
+            AssertMatchesFullParse(parser, *result);
+
+            result = parser.ApplyEdit(Replace(parser.GetText(), R"( "minHeight": "-5px",)", ""));
+            Assert::AreEqual(1u, static_cast<unsigned int>(result->GetWarnings().size()));
+            AssertMatchesFullParse(parser, *result);
+        }
+
+        TEST_METHOD(RandomEditsMatchParsingFromScratch)
+        {
+            const std::string characters = "ab \"{}[],:1";
+            std::mt19937 random(2020);
+            IncrementalCardParser parser("1.2");
+            parser.Parse(c_card);
+
+            unsigned int incremental = 0;
+            for (unsigned int i = 0; i < 400; i++)
+            {
+                // Mostly typing, with the odd edit that breaks the JSON, then undoing it
+                const std::string text = parser.GetText();
+                const size_t offset = random() % text.size();
+                const size_t length = (random() % 4 == 0) ? 1 : 0;
+                const std::string replacement(1, characters[random() % characters.size()]);
+
+                for (const TextEdit& edit : {TextEdit{offset, length, replacement}, TextEdit{offset, 1, text.substr(offset, length)}})
+                {
+                    std::shared_ptr<ParseResult> expected;
+                    ErrorStatusCode expectedError = ErrorStatusCode::InvalidJson;
+                    std::string edited = parser.GetText();
+                    edited.replace(edit.offset, edit.length, edit.replacement);
+                    try
+                    {
+                        expected = AdaptiveCard::DeserializeFromString(edited, "1.2");
+                    }
+                    catch (const AdaptiveCardParseException& e)
+                    {
+                        expectedError = e.GetStatusCode();
+                    }
+
+                    try
+                    {
+                        const auto result = parser.ApplyEdit(edit);
+                        Assert::IsTrue(expected != nullptr, L"Parsing from scratch should have thrown");
+                        AssertMatchesFullParse(parser, *result);
+                        incremental += parser.GetLastParsedElement() ? 1 : 0;
+                    }
+                    catch (const AdaptiveCardParseException& e)
+                    {
+                        Assert::IsTrue(expected == nullptr, L"Parsing from scratch shouldn't have thrown");
+                        Assert::IsTrue(expectedError == e.GetStatusCode(), L"ErrorStatusCode incorrect");
+                    }
+                    Assert::AreEqual(edited, parser.GetText());
+                }
+            }
+            Assert::IsTrue(incremental > 100);
+        }
+    };
+}
@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "InputValidator.h"
+#include "NumberInput.h"
+#include "ShowCardAction.h"
+#include "SubmitAction.h"
+#include "TextInput.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(InputValidatorTest)
+    {
+    public:
+        TEST_METHOD(RegexSyntax)
+        {
+            struct
+            {
+                const char* pattern;
+                const char* text;
+                bool matches;
+            } cases[] = {
+                {"^\\d{3}-\\d{4}$", "555-1234", true},
+                {"^\\d{3}-\\d{4}$", "555-12345", false},
+                {"colou?r", "my color", true},
+                {"^(ab)*$", "abab", true},
+                {"^(ab)*$", "aba", false},
+                {"^x{2,3}$", "xxxx", false},
+                {"^x{2,}$", "xxxx", true},
+                {"a{,2}", "a{,2}", true},
+                {"(?:foo|bar)+baz", "foobarbaz", true},
+                {"\\bcat\\b", "concat", false},
+                {"\\bcat\\b", "the cat sat", true},
+                {"^[^@\\s]+@[^@\\s]+$", "a@b", true},
+                {"^[^@\\s]+@[^@\\s]+$", "a b@c", false},
+                {"^[a-c-]+$", "a-c", true},
+                {"^[\\D]+$", "abc", true},
+                {"\\u0041\\x42", "AB", true},
+                {"a.c", "a\nc", false},
+                {"^[à-ÿ]+$", "éè", true},
+                {"^.$", "é", true},
+                {"[]", "anything", false},
+                {"[^]", "x", true},
+            };
+
+            for (const auto& test : cases)
+            {
+                InputRegex regex(test.pattern);
+                Assert::IsTrue(regex.IsValid());
+                Assert::AreEqual(test.matches, regex.Search(test.text));
+            }
+
+            // Patterns that need backtracking, or too big a program, aren't matched at all
+            Assert::IsTrue(InputRegex("(a+)+$").IsSupported());
+            for (const auto& pattern : {"^(a)\\1$", "^(a+)+\\1$", "(?=a)a", "^(a|aa){0,2000}$"})
+            {
+                InputRegex regex(pattern);
+                Assert::IsFalse(regex.IsSupported());
+                Assert::IsFalse(regex.IsValid());
+                Assert::IsFalse(regex.Search("aa"));
+            }
+            Assert::IsFalse(InputRegex("(a").IsValid());
+            Assert::IsFalse(InputRegex("*a").IsValid());
+
+            // As in JavaScript, a quantifier can't follow another quantifier (other than the ? of a lazy one)
+            for (const auto& pattern : {"a**", "a+*", "a{2}{3}", "a{1000}{1000}", "a*?+", "{2}"})
+            {
+                Assert::IsFalse(InputRegex(pattern).IsValid());
+            }
+            Assert::IsTrue(InputRegex("a*?").IsValid());
+            Assert::IsTrue(InputRegex("a{2}{").IsValid());
+            Assert::IsFalse(InputRegex("(a").Search("b"));
+
+            // Would take minutes to fail by backtracking
+            Assert::IsFalse(InputRegex("^(\\w+\\s?)*$").Search(std::string(64, 'a') + "!"));
+        }
+
+        TEST_METHOD(ValidatesCardInputs)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "Input.Text", "id": "name", "isRequired": true, "errorMessage": "Name is required" },
+                    { "type": "Input.Text", "id": "zip", "regex": "^\\d{5}$", "maxLength": 5 },
+                    {
+                        "type": "Container",
+                        "items": [
+                            {
+                                "type": "ColumnSet",
+                                "columns": [
+                                    { "type": "Column", "items": [ { "type": "Input.Number", "id": "count", "min": 1, "max": 10 } ] },
+                                    { "type": "Column", "items": [ { "type": "Input.Date", "id": "due", "min": "2020-01-01" } ] }
+                                ]
+                            }
+                        ]
+                    },
+                    { "type": "Input.Time", "id": "time", "max": "17:00" },
+                    { "type": "Input.Toggle", "id": "agree", "title": "I agree", "isRequired": true, "valueOn": "yes" },
+                    { "type": "Input.ChoiceSet", "id": "color", "isRequired": true, "choices": [ { "title": "Red", "value": "red" } ] }
+                ],
+                "actions": [
+                    { "type": "Action.Submit", "id": "submit" },
+                    { "type": "Action.Submit", "id": "cancel", "ignoreInputValidation": true },
+                    { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "Input.Text", "id": "nested", "isRequired": true } ] } }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+
+            InputValidator validator;
+            std::unordered_map<std::string, std::string> values{
+                {"name", "Ada"}, {"zip", "98052"}, {"count", "10"}, {"due", "2020-01-01"}, {"time", "17:00"}, {"agree", "yes"}, {"color", "red"}};
+            Assert::IsTrue(validator.Validate(*card, values).empty());
+
+            values = {{"zip", "980521"}, {"count", "11"}, {"due", "2019-12-31"}, {"time", "5pm"}, {"agree", "false"}};
+            const auto errors = validator.Validate(*card, values);
+            const std::vector<std::pair<std::string, InputValidationResult>> expected{
+                {"name", InputValidationResult::Required},
+                {"zip", InputValidationResult::TooLong},
+                {"count", InputValidationResult::AboveMax},
+                {"due", InputValidationResult::BelowMin},
+                {"time", InputValidationResult::InvalidValue},
+                {"agree", InputValidationResult::Required},
+                {"color", InputValidationResult::Required}};
+            Assert::AreEqual(static_cast<unsigned int>(expected.size()), static_cast<unsigned int>(errors.size()));
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                Assert::AreEqual(expected[i].first, errors[i].input->GetId());
+                Assert::IsTrue(expected[i].second == errors[i].result);
+            }
+            Assert::AreEqual(std::string("Name is required"), errors[0].input->GetErrorMessage());
+
+            auto submit = std::static_pointer_cast<SubmitAction>(card->GetActions()[0]);
+            auto cancel = std::static_pointer_cast<SubmitAction>(card->GetActions()[1]);
+            Assert::AreEqual(static_cast<unsigned int>(expected.size()), static_cast<unsigned int>(validator.ValidateForSubmit(*card, *submit, values).size()));
+            Assert::IsTrue(validator.ValidateForSubmit(*card, *cancel, values).empty());
+        }
+
+        TEST_METHOD(ValidatesSingleInputs)
+        {
+            InputValidator validator;
+            TextInput textInput;
+            textInput.SetRegex("^[a-z]+$");
+            textInput.SetMaxLength(3);
+
+            Assert::IsTrue(validator.Validate(textInput, "") == InputValidationResult::Valid);
+            Assert::IsTrue(validator.Validate(textInput, "abc") == InputValidationResult::Valid);
+            Assert::IsTrue(validator.Validate(textInput, "ab1") == InputValidationResult::RegexMismatch);
+            Assert::IsTrue(validator.Validate(textInput, "abcd") == InputValidationResult::TooLong);
+
+            // maxLength counts characters rather than bytes
+            textInput.SetRegex("");
+            Assert::IsTrue(validator.Validate(textInput, "äöü") == InputValidationResult::Valid);
+
+            // Each pattern is compiled once
+            Assert::IsTrue(validator.GetRegex("^[a-z]+$") == validator.GetRegex("^[a-z]+$"));
+
+            // No value matches a pattern that isn't valid
+            textInput.SetRegex("(a");
+            Assert::IsTrue(validator.Validate(textInput, "a") == InputValidationResult::InvalidRegex);
+            Assert::IsTrue(validator.Validate(textInput, "") == InputValidationResult::Valid);
+            textInput.SetRegex("^(a+)+\\1$");
+            Assert::IsTrue(validator.Validate(textInput, "aa!") == InputValidationResult::InvalidRegex);
+
+            // Only the bounds that are set are checked
+            NumberInput numberInput;
+            Assert::IsTrue(validator.Validate(numberInput, "-1e12") == InputValidationResult::Valid);
+            Assert::IsTrue(validator.Validate(numberInput, "1e12") == InputValidationResult::Valid);
+            numberInput.SetMin(0);
+            Assert::IsTrue(validator.Validate(numberInput, "-1") == InputValidationResult::BelowMin);
+            Assert::IsTrue(validator.Validate(numberInput, "1e12") == InputValidationResult::Valid);
+        }
+
+        TEST_METHOD(ValidatesInputsSubmittedWithAction)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "Input.Text", "id": "name", "isRequired": true },
+                    { "type": "Input.Text", "id": "hidden", "isRequired": true, "isVisible": false },
+                    { "type": "Container", "isVisible": false, "items": [ { "type": "Input.Text", "id": "inHidden", "isRequired": true } ] },
+                    {
+                        "type": "ActionSet",
+                        "actions": [
+                            {
+                                "type": "Action.ShowCard",
+                                "card": {
+                                    "type": "AdaptiveCard",
+                                    "body": [ { "type": "Input.Text", "id": "comment", "isRequired": true } ],
+                                    "actions": [ { "type": "Action.Submit", "id": "send" } ]
+                                }
+                            }
+                        ]
+                    }
+                ],
+                "actions": [
+                    { "type": "Action.Submit", "id": "submit" },
+                    {
+                        "type": "Action.ShowCard",
+                        "card": {
+                            "type": "AdaptiveCard",
+                            "body": [ { "type": "Input.Text", "id": "reason", "isRequired": true } ],
+                            "actions": [ { "type": "Action.Submit", "id": "decline" } ]
+                        }
+                    }
+                ]
+            })card";
+            auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+
+            const auto inputIds = [](const std::vector<InputValidationError>& errors) {
+                std::string ids;
+                for (const auto& error : errors)
+                {
+                    ids += error.input->GetId() + " ";
+                }
+                return ids;
+            };
+
+            InputValidator validator;
+            const std::unordered_map<std::string, std::string> values;
+            Assert::AreEqual(std::string("name "), inputIds(validator.Validate(*card, values)));
+
+            const auto& submit = static_cast<const SubmitAction&>(*card->GetElementById("submit"));
+            const auto& send = static_cast<const SubmitAction&>(*card->GetElementById("send"));
+            const auto& decline = static_cast<const SubmitAction&>(*card->GetElementById("decline"));
+            Assert::AreEqual(std::string("name "), inputIds(validator.ValidateForSubmit(*card, submit, values)));
+            Assert::AreEqual(std::string("name comment "), inputIds(validator.ValidateForSubmit(*card, send, values)));
+            Assert::AreEqual(std::string("name reason "), inputIds(validator.ValidateForSubmit(*card, decline, values)));
+
+            // An action from elsewhere submits the card's own inputs
+            SubmitAction other;
+            Assert::AreEqual(std::string("name "), inputIds(validator.ValidateForSubmit(*card, other, values)));
+        }
+    };
+}
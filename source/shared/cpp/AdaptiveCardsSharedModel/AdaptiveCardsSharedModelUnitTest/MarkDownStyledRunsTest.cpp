@@ -0,0 +1,344 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "MarkDownParser.h"
+#include <cstring>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    // The style of one character of text
+    struct StyledChar
+    {
+        char ch;
+        bool isBold;
+        bool isItalic;
+        std::string link;
+        MarkDownStyledBlockType blockType;
+        unsigned int blockIndex;
+        unsigned int listNumber;
+    };
+
+    std::string Unescape(const std::string& html)
+    {
+        std::string text;
+        for (size_t i = 0; i < html.size(); i++)
+        {
+            static const std::pair<const char*, char> entities[] = {{"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&amp;", '&'}};
+            bool isEntity = false;
+            for (const auto& entity : entities)
+            {
+                if (html.compare(i, strlen(entity.first), entity.first) == 0)
+                {
+                    text += entity.second;
+                    i += strlen(entity.first) - 1;
+                    isEntity = true;
+                    break;
+                }
+            }
+            if (!isEntity)
+            {
+                text += html[i];
+            }
+        }
+        return text;
+    }
+
+    // Reads back the few tags the markdown parser writes
+    std::vector<StyledChar> StyleHtml(const std::string& html)
+    {
+        std::vector<StyledChar> styled;
+        int italicDepth = 0;
+        int boldDepth = 0;
+        std::string link;
+        MarkDownStyledBlockType blockType = MarkDownStyledBlockType::Paragraph;
+        unsigned int blockCount = 0;
+        unsigned int blockIndex = 0;
+        unsigned int listNumber = 0;
+        bool isOrderedList = false;
+        unsigned int nextListNumber = 0;
+
+        std::string text;
+        for (size_t i = 0; i < html.size(); i++)
+        {
+            if (html[i] != '<')
+            {
+                text += html[i];
+                continue;
+            }
+
+            for (const char ch : Unescape(text))
+            {
+                styled.push_back({ch, boldDepth > 0, italicDepth > 0, link, blockType, blockIndex, listNumber});
+            }
+            text.clear();
+
+            const size_t tagEnd = html.find('>', i);
+            const std::string tag = html.substr(i + 1, tagEnd - i - 1);
+            i = tagEnd;
+            if (tag == "p")
+            {
+                blockType = MarkDownStyledBlockType::Paragraph;
+                blockIndex = blockCount++;
+                listNumber = 0;
+            }
+            else if (tag == "ul")
+            {
+                isOrderedList = false;
+            }
+            else if (tag.compare(0, 9, "ol start=") == 0)
+            {
+                isOrderedList = true;
+                nextListNumber = static_cast<unsigned int>(std::stoul(tag.substr(10)));
+            }
+            else if (tag == "li")
+            {
+                blockType = isOrderedList ? MarkDownStyledBlockType::OrderedListItem : MarkDownStyledBlockType::UnorderedListItem;
+                blockIndex = blockCount++;
+                listNumber = isOrderedList ? nextListNumber++ : 0;
+            }
+            else if (tag == "em" || tag == "/em")
+            {
+                italicDepth += (tag == "em") ? 1 : -1;
+            }
+            else if (tag == "strong" || tag == "/strong")
+            {
+                boldDepth += (tag == "strong") ? 1 : -1;
+            }
+            else if (tag.compare(0, 7, "a href=") == 0)
+            {
+                link = Unescape(tag.substr(8, tag.size() - 9));
+            }
+            else if (tag == "/a")
+            {
+                link.clear();
+            }
+        }
+
+        for (const char ch : Unescape(text))
+        {
+            styled.push_back({ch, boldDepth > 0, italicDepth > 0, link, blockType, blockIndex, listNumber});
+        }
+        return styled;
+    }
+
+    std::vector<StyledChar> StyleRuns(const MarkDownStyledText& styledText)
+    {
+        std::vector<StyledChar> styled;
+        size_t expectedStart = 0;
+        for (const auto& run : styledText.runs)
+        {
+            // Runs cover the text in order, without gaps
+            Assert::AreEqual(static_cast<unsigned int>(expectedStart), static_cast<unsigned int>(run.start));
+            Assert::IsTrue(run.length > 0);
+            expectedStart = run.start + run.length;
+
+            for (size_t i = run.start; i < run.start + run.length; i++)
+            {
+                styled.push_back({styledText.text[i], run.isBold, run.isItalic, run.link, run.blockType, run.blockIndex, run.listNumber});
+            }
+        }
+        Assert::AreEqual(static_cast<unsigned int>(styledText.text.size()), static_cast<unsigned int>(expectedStart));
+        return styled;
+    }
+
+    TEST_CLASS(MarkDownStyledRunsTest)
+    {
+    public:
+        TEST_METHOD(StyledRunsMatchHtml)
+        {
+            const char* const markDowns[] = {
+                " & ",
+                "&",
+                "(**foo**)",
+                "(__foo__)",
+                "* foo bar*",
+                "*(*foo*)*",
+                "*(foo)*",
+                "** foo bar**",
+                "** is not an empty emphasis",
+                "**(**foo)",
+                "**** is not an empty emphasis",
+                "******foo******",
+                "****foo****",
+                "***foo** bar*",
+                "***foo**",
+                "***foo***",
+                "**Gomphocarpus (*Gomphocarpus physocarpus*, syn.\n*Asclepias physocarpa*)**",
+                "**H *foo**bar***",
+                "**Hello** *[*hello*](*www.naver.com*)*",
+                "**K *J *foo**bar* *cool*",
+                "**foo **bar baz**",
+                "**foo **bar****",
+                "**foo *bar **baz**\n bim* bop**",
+                "**foo bar **",
+                "**foo bar**",
+                "**foo*",
+                "**foo**bar",
+                "**foo\nbar**",
+                "**m *J *foo**bar *cool**",
+                "**以前の製品のリンクで検索**",
+                "*Hello* *[*hello*](*www.naver.com*)** Hello, [second](www.microsoft.com)",
+                "*Hello* abc ***Hello* def *world***",
+                "*[*hello(www.naver.com)",
+                "*[*hello(www.naver.com)*",
+                "*[*hello*](*www.naver.com*)",
+                "*[*hello*](www.naver.com)",
+                "*[hello](www.naver.com)*",
+                "*foo *",
+                "*foo **bar *baz* bim** bop*",
+                "*foo **bar** baz*",
+                "*foo **bar***",
+                "*foo *bar baz*",
+                "*foo *bar**",
+                "*foo __bar *baz bim__ bam*",
+                "*foo _bar* baz_",
+                "*foo bar*",
+                "*foo**",
+                "*foo****",
+                "*foo**bar**baz*",
+                "*foo*bar",
+                "*hello *hello**h*",
+                "*hello *hi **H foo** bar**",
+                "- hello world - hello hello",
+                "- hello world - hello hello\r- ***winner* winner** chicken dinner",
+                "- hello world - hello hello\r- winner winner chicken dinner",
+                "- hello world\r- hello hello\r- new site = [adaptive card](www.adaptivecards.io)",
+                "- hello",
+                "- hello\n- Hi",
+                "- my list\rHello",
+                "- my list\r\rHello",
+                "023-34-567",
+                "1. Click [以前の製品のリンクで検索](https://www.microsoft.com)\r2. Click [以前の製品のリンクで検索](https://www.microsoft.com)",
+                "1. hello world - hello hello",
+                "1. hello world - hello hello\r- ***winner* winner** chicken dinner",
+                "1. hello world - hello hello\r2. winner winner chicken dinner",
+                "1. hello world\r2. hello hello\r3. new site = [adaptive card](www.adaptivecards.io)",
+                "1. hello",
+                "1. hello\n2. Hi",
+                "1. my list\rHello",
+                "1. my list\r\rHello",
+                "3<5",
+                "5*6*78",
+                "5>3",
+                "5_6_78",
+                "777. my list\rHello",
+                "Green Eggs & Ham",
+                "Hello World&",
+                "Hello\r- my list",
+                "Hello\r1. my list",
+                "How about **以前の製品のリンクで検索**",
+                "How about**以前の製品のリンクで検索**",
+                "It's OK!\rClick [以前の製品のリンクで検索](https://www.microsoft.com)\rClick [以前の製品のリンクで検索](https://www.microsoft.com)",
+                "It's not OK!\r1. Click [以前の製品のリンクで検索](https://www.microsoft.com)\r2. Click [以前の製品のリンクで検索](https://www.microsoft.com)",
+                "[*[hello[hello]hello]*](www.naver.com)",
+                "[*[hello]*](www.naver.com)",
+                "[*hello*](www.naver.com)",
+                "[*hello[hello]hello](www.naver.com)",
+                "[*hellohello]hello](www.naver.com)",
+                "[1234.5](www.naver.com)",
+                "[Bug [021356]](https://msn.com): Markdown link parsing",
+                "[[[[hello](www.naver.com)",
+                "[[a[b[h(ello](www.naver.com)",
+                "[[hello]](www.naver.com)",
+                "[a[b[hello](www.naver.com)",
+                "[hello(www.naver.com)",
+                "[hello](www.naver.com)",
+                "[hello]a(www.naver.com)",
+                "\"Hello World!\"",
+                "_ foo bar_",
+                "_(bar)_.",
+                "__ foo bar__",
+                "__(__foo",
+                "__(foo)__.",
+                "_____foo_____",
+                "__foo __bar__ baz__",
+                "__foo bar __",
+                "__foo bar__",
+                "__foo__bar",
+                "_foo __bar__ baz_",
+                "_foo _bar_ baz_",
+                "_foo bar _",
+                "_foo bar_",
+                "_foo*",
+                "_foo_",
+                "_foo_bar",
+                "a**\"foo bar\"**",
+                "a*\"foo\"*",
+                "a_\"foo\"_",
+                "a__\"foo bar\"__",
+                "foo **\\***",
+                "foo *\\**",
+                "foo __\\___",
+                "foo*bar*",
+                "foo-_(bar)_",
+                "foo-__(bar)__",
+                "foo_bar_",
+                "hello **how are** *you **i** am **great** *thank* **you***",
+                "hello, **how are__ you**",
+                "hello, __how **are__ you?**",
+                "以前の製品のリンクで検索 **以前の製品のリンクで検索**",
+                "以前の製品のリンクで検索",
+                "以前の製品のリンクで検索**以前の製品のリンクで検索**",
+            };
+
+            for (const char* markDown : markDowns)
+            {
+                MarkDownParser htmlParser(markDown);
+                const auto expected = StyleHtml(htmlParser.TransformToHtml());
+
+                MarkDownParser runsParser(markDown);
+                const auto actual = StyleRuns(runsParser.TransformToStyledRuns());
+                Assert::AreEqual(htmlParser.HasHtmlTags(), runsParser.HasHtmlTags());
+
+                const std::wstring message = L"markdown: " + std::wstring(markDown, markDown + strlen(markDown));
+                Assert::AreEqual(static_cast<unsigned int>(expected.size()), static_cast<unsigned int>(actual.size()), message.c_str());
+                for (size_t i = 0; i < expected.size(); i++)
+                {
+                    Assert::AreEqual(expected[i].ch, actual[i].ch, message.c_str());
+                    Assert::AreEqual(expected[i].isBold, actual[i].isBold, message.c_str());
+                    Assert::AreEqual(expected[i].isItalic, actual[i].isItalic, message.c_str());
+                    Assert::AreEqual(expected[i].link, actual[i].link, message.c_str());
+                    Assert::IsTrue(expected[i].blockType == actual[i].blockType, message.c_str());
+                    Assert::AreEqual(expected[i].blockIndex, actual[i].blockIndex, message.c_str());
+                    Assert::AreEqual(expected[i].listNumber, actual[i].listNumber, message.c_str());
+                }
+            }
+        }
+
+        TEST_METHOD(StyledRunsOfListsAndLinks)
+        {
+            MarkDownParser parser("Intro *with* [a **link**](https://adaptivecards.io?a=1&b=2)\r3. first\r4. second");
+            const auto styledText = parser.TransformToStyledRuns();
+            Assert::AreEqual(std::string("Intro with a linkfirstsecond"), styledText.text);
+            Assert::IsTrue(parser.HasHtmlTags());
+
+            const auto& runs = styledText.runs;
+            Assert::AreEqual(7u, static_cast<unsigned int>(runs.size()));
+            Assert::IsTrue(runs[1].isItalic);
+            Assert::AreEqual(std::string("with"), styledText.text.substr(runs[1].start, runs[1].length));
+            Assert::AreEqual(std::string("https://adaptivecards.io?a=1&b=2"), runs[3].link);
+            Assert::AreEqual(std::string("a "), styledText.text.substr(runs[3].start, runs[3].length));
+            Assert::IsTrue(runs[4].isBold);
+            Assert::AreEqual(runs[3].link, runs[4].link);
+            Assert::IsTrue(runs[5].blockType == MarkDownStyledBlockType::OrderedListItem);
+            Assert::AreEqual(3u, runs[5].listNumber);
+            Assert::AreEqual(4u, runs[6].listNumber);
+            Assert::AreNotEqual(runs[5].blockIndex, runs[6].blockIndex);
+        }
+
+        TEST_METHOD(StyledRunsOfPlainText)
+        {
+            MarkDownParser parser("3 < 5 & \"quoted\"");
+            const auto styledText = parser.TransformToStyledRuns();
+            Assert::AreEqual(std::string("3 < 5 & \"quoted\""), styledText.text);
+            Assert::AreEqual(1u, static_cast<unsigned int>(styledText.runs.size()));
+            Assert::IsFalse(parser.HasHtmlTags());
+
+            MarkDownParser empty("");
+            Assert::IsTrue(empty.TransformToStyledRuns().runs.empty());
+        }
+    };
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "ParseArena.h"
+#include "TextBlock.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(ParseArenaTest)
+    {
+    public:
+        TEST_METHOD(AllocationsAreAlignedAndChunked)
+        {
+            ParseArena arena(64);
+
+            char* first = static_cast<char*>(arena.Allocate(1, 1));
+            void* aligned = arena.Allocate(8, 8);
+            Assert::IsTrue(first != nullptr);
+            Assert::AreEqual(0U, static_cast<unsigned int>(reinterpret_cast<uintptr_t>(aligned) % 8));
+            Assert::AreEqual(64U, static_cast<unsigned int>(arena.GetBytesReserved()));
+
+            // Too big for a chunk: gets its own without abandoning the current one
+            arena.Allocate(200, 8);
+            Assert::AreEqual(64U + 208U, static_cast<unsigned int>(arena.GetBytesReserved()));
+            char* next = static_cast<char*>(arena.Allocate(1, 1));
+            Assert::IsTrue(next > first && next < first + 64);
+            Assert::AreEqual(210U, static_cast<unsigned int>(arena.GetBytesAllocated()));
+        }
+
+        TEST_METHOD(ArenaParseMatchesHeapParse)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "TextBlock", "text": "Hello", "requires": { "foo": "1.0" }, "unknown": 1 },
+                    {
+                        "type": "Container",
+                        "items": [
+                            { "type": "RichTextBlock", "inlines": [ "one", { "type": "TextRun", "text": "two" } ] },
+                            { "type": "FactSet", "facts": [ { "title": "a", "value": "b" } ] },
+                            { "type": "Input.ChoiceSet", "id": "choice", "choices": [ { "title": "c", "value": "d" } ] }
+                        ]
+                    }
+                ],
+                "actions": [ { "type": "Action.ToggleVisibility", "title": "Toggle", "targetElements": [ "choice" ] } ]
+            })card";
+
+            ParseContext context;
+            context.SetArena(std::make_shared<ParseArena>());
+            std::shared_ptr<BaseCardElement> textBlock;
+            std::string arenaJson;
+            {
+                auto parseResult = AdaptiveCard::DeserializeFromString(cardJson, "1.2", context);
+                Assert::IsTrue(parseResult->GetArena() == context.GetArena());
+                Assert::IsTrue(parseResult->GetArena()->GetBytesAllocated() > 0);
+
+                arenaJson = parseResult->GetAdaptiveCard()->Serialize();
+                textBlock = parseResult->GetAdaptiveCard()->GetBody()[0];
+            }
+            context.SetArena(nullptr);
+
+            // Elements keep the arena alive after the card is gone
+            Assert::AreEqual(std::string("Hello"), std::static_pointer_cast<TextBlock>(textBlock)->GetText());
+            Assert::AreEqual(1U, static_cast<unsigned int>(textBlock->GetRequirements()->size()));
+            Assert::AreEqual(1, textBlock->GetAdditionalProperties()["unknown"].asInt());
+
+            auto heapResult = AdaptiveCard::DeserializeFromString(cardJson, "1.2");
+            Assert::IsTrue(heapResult->GetArena() == nullptr);
+            Assert::AreEqual(heapResult->GetAdaptiveCard()->Serialize(), arenaJson);
+        }
+    };
+}
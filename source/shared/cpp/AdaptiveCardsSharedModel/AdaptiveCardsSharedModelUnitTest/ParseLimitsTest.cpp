@@ -0,0 +1,260 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include <chrono>
+#include <random>
+#include "BinaryCardFormat.h"
+#include "CardIterator.h"
+#include "ParseContext.h"
+#include "ParseUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace
+{
+    std::string WrapBody(const std::string& body)
+    {
+        return R"({"type": "AdaptiveCard", "version": "1.2", "body": [)" + body + "]}";
+    }
+
+    std::string NestedContainers(unsigned int depth)
+    {
+        std::string json;
+        for (unsigned int i = 0; i < depth; i++)
+        {
+            json += R"({"type": "Container", "items": [)";
+        }
+        json += R"({"type": "TextBlock", "text": "Deep"})";
+        for (unsigned int i = 0; i < depth; i++)
+        {
+            json += "]}";
+        }
+        return WrapBody(json);
+    }
+
+    std::string FallbackChain(unsigned int length)
+    {
+        std::string json;
+        for (unsigned int i = 0; i < length; i++)
+        {
+            json += R"({"type": "Graph", "fallback": )";
+        }
+        json += R"({"type": "TextBlock", "text": "Last"})";
+        json += std::string(length, '}');
+        return WrapBody(json);
+    }
+
+    std::string TextBlocks(unsigned int count)
+    {
+        std::string json;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            json += std::string(i == 0 ? "" : ",") + R"({"type": "TextBlock", "text": "Item"})";
+        }
+        return WrapBody(json);
+    }
+
+    // Returns whether parsing json with these limits failed for exceeding one of them. Any other failure fails the test.
+    bool ExceedsLimits(const std::string& json, const ParseLimits& limits)
+    {
+        ParseContext context;
+        context.SetLimits(limits);
+        try
+        {
+            AdaptiveCard::DeserializeFromString(json, "1.2", context);
+            return false;
+        }
+        catch (const AdaptiveCardParseException& e)
+        {
+            Assert::IsTrue(e.GetStatusCode() == ErrorStatusCode::ParseLimitExceeded, L"ErrorStatusCode incorrect");
+            return true;
+        }
+    }
+
+    // A random card of containers, ShowCard actions and fallback content, up to maxDepth deep
+    Json::Value RandomElement(std::mt19937& random, unsigned int depth, unsigned int maxDepth)
+    {
+        Json::Value element;
+        const unsigned int kind = (depth < maxDepth) ? random() % 4 : 0;
+        if (kind == 1 || kind == 2)
+        {
+            element["type"] = "Container";
+            const unsigned int count = random() % 4;
+            element["items"] = Json::Value(Json::arrayValue);
+            for (unsigned int i = 0; i < count; i++)
+            {
+                element["items"].append(RandomElement(random, depth + 1, maxDepth));
+            }
+        }
+        else if (kind == 3)
+        {
+            element["type"] = "ActionSet";
+            Json::Value action;
+            action["type"] = "Action.ShowCard";
+            action["card"]["type"] = "AdaptiveCard";
+            action["card"]["body"].append(RandomElement(random, depth + 2, maxDepth));
+            element["actions"].append(action);
+        }
+        else
+        {
+            element["type"] = "TextBlock";
+            element["text"] = std::string(random() % 64, 'x');
+        }
+
+        if (depth < maxDepth && random() % 5 == 0)
+        {
+            element["fallback"] = RandomElement(random, depth + 1, maxDepth);
+        }
+        return element;
+    }
+}
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(ParseLimitsTest)
+    {
+    public:
+        TEST_METHOD(LimitsDepth)
+        {
+            ParseLimits limits;
+            Assert::IsFalse(ExceedsLimits(NestedContainers(200), limits));
+            Assert::IsFalse(ExceedsLimits(FallbackChain(200), limits));
+
+            limits.maxDepth = 32;
+            Assert::IsFalse(ExceedsLimits(NestedContainers(31), limits));
+            Assert::IsTrue(ExceedsLimits(NestedContainers(32), limits));
+            Assert::IsTrue(ExceedsLimits(FallbackChain(32), limits));
+
+            // Nesting this deep is too much for the JSON reader already, but a host can build such a card itself,
+            // so the limit has to hold without the reader's
+            Json::Value card;
+            card["type"] = "AdaptiveCard";
+            card["version"] = "1.2";
+            Json::Value* items = &card["body"];
+            for (unsigned int i = 0; i < 1000; i++)
+            {
+                Json::Value& container = items->append(Json::Value(Json::objectValue));
+                container["type"] = "Container";
+                items = &container["items"];
+            }
+            ParseContext context;
+            context.SetLimits(limits);
+            try
+            {
+                AdaptiveCard::Deserialize(card, "1.2", context);
+                Assert::IsTrue(false, L"Deserializing should throw an exception");
+            }
+            catch (const AdaptiveCardParseException& e)
+            {
+                Assert::IsTrue(e.GetStatusCode() == ErrorStatusCode::ParseLimitExceeded, L"ErrorStatusCode incorrect");
+            }
+        }
+
+        TEST_METHOD(LimitsElementCount)
+        {
+            ParseLimits limits;
+            limits.maxElementCount = 1000;
+            Assert::IsFalse(ExceedsLimits(TextBlocks(1000), limits));
+            Assert::IsTrue(ExceedsLimits(TextBlocks(1001), limits));
+
+            // A context parsing several cards counts each card's elements on their own
+            ParseContext context;
+            context.SetLimits(limits);
+            AdaptiveCard::DeserializeFromString(TextBlocks(1000), "1.2", context);
+            AdaptiveCard::DeserializeFromString(TextBlocks(1000), "1.2", context);
+
+            // Fallback content counts too
+            limits.maxElementCount = 100;
+            Assert::IsFalse(ExceedsLimits(FallbackChain(99), limits));
+            Assert::IsTrue(ExceedsLimits(FallbackChain(100), limits));
+        }
+
+        TEST_METHOD(LimitsSize)
+        {
+            const std::string longText = WrapBody(R"({"type": "TextBlock", "text": ")" + std::string(1 << 20, 'x') + "\"}");
+
+            ParseLimits limits;
+            limits.maxStringLength = 64 * 1024;
+            Assert::IsTrue(ExceedsLimits(longText, limits));
+            Assert::IsFalse(ExceedsLimits(TextBlocks(100), limits));
+
+            limits = {};
+            limits.maxTotalBytes = 512 * 1024;
+            Assert::IsTrue(ExceedsLimits(longText, limits));
+
+            const std::vector<uint8_t> binary = BinaryCardFormat::Write(ParseUtil::GetJsonValueFromString(longText));
+            ParseContext context;
+            context.SetLimits(limits);
+            Assert::ExpectException<AdaptiveCardParseException>(
+                [&]() { AdaptiveCard::DeserializeBinary(binary.data(), binary.size(), "1.2", context); });
+        }
+
+        TEST_METHOD(LimitsTime)
+        {
+            const std::string json = TextBlocks(100000);
+            ParseLimits limits;
+            limits.timeBudget = std::chrono::milliseconds(1);
+
+            const auto start = std::chrono::steady_clock::now();
+            Assert::IsTrue(ExceedsLimits(json, limits));
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            // Reading the JSON isn't interrupted, but building the card stops as soon as the budget is spent
+            limits = {};
+            const auto unlimitedStart = std::chrono::steady_clock::now();
+            Assert::IsFalse(ExceedsLimits(json, limits));
+            Assert::IsTrue(elapsed < (std::chrono::steady_clock::now() - unlimitedStart));
+        }
+
+        TEST_METHOD(RandomCardsStayWithinLimits)
+        {
+            ParseLimits limits;
+            limits.maxDepth = 8;
+            limits.maxElementCount = 200;
+
+            CardIteratorOptions options;
+            options.includeFallbackContent = true;
+
+            std::mt19937 random(2020);
+            unsigned int parsed = 0;
+            unsigned int exceeded = 0;
+            for (unsigned int i = 0; i < 500; i++)
+            {
+                Json::Value card;
+                card["type"] = "AdaptiveCard";
+                card["version"] = "1.2";
+                const unsigned int count = 1 + random() % 8;
+                for (unsigned int j = 0; j < count; j++)
+                {
+                    card["body"].append(RandomElement(random, 1, 12));
+                }
+
+                if (ExceedsLimits(card.toStyledString(), limits))
+                {
+                    exceeded++;
+                    continue;
+                }
+
+                // A card that parses is within the limits
+                parsed++;
+                const auto result = AdaptiveCard::DeserializeFromString(card.toStyledString(), "1.2");
+                CardIterator iterator(*result->GetAdaptiveCard(), options);
+                unsigned int elements = 0;
+                while (iterator.Next())
+                {
+                    const auto& node = iterator.GetNode();
+                    if (node.GetElement() || node.GetAction())
+                    {
+                        elements++;
+                    }
+                }
+                Assert::IsTrue(elements <= limits.maxElementCount);
+            }
+
+            // Both kinds of card are generated
+            Assert::IsTrue(parsed > 0);
+            Assert::IsTrue(exceeded > 0);
+        }
+    };
+}
@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "Container.h"
+#include "DateTimePreparsedToken.h"
+#include "FactSet.h"
+#include "RenderPrep.h"
+#include "RichTextBlock.h"
+#include "ShowCardAction.h"
+#include "TextBlock.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(RenderPrepTest)
+    {
+    public:
+        TEST_METHOD(PreparesTextOfEveryKind)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "body": [
+                    { "type": "TextBlock", "text": "Due {{DATE(2017-02-14T06:08:39Z, SHORT)}}, **soon**", "weight": "bolder", "size": "large" },
+                    {
+                        "type": "Container",
+                        "style": "emphasis",
+                        "items": [
+                            {
+                                "type": "RichTextBlock",
+                                "inlines": [ "Plain", { "type": "TextRun", "text": "**Marked**", "highlight": true, "fontType": "monospace" } ]
+                            },
+                            { "type": "FactSet", "facts": [ { "title": "Owner", "value": "*Ada*" } ] }
+                        ]
+                    }
+                ],
+                "actions": [
+                    { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "TextBlock", "text": "Shown", "color": "accent" } ] } }
+                ]
+            })card";
+            const auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+            HostConfig hostConfig;
+            const auto prepared = RenderPrep::Prepare(*card, hostConfig);
+            Assert::AreEqual(4u, static_cast<unsigned int>(prepared->GetElementCount()));
+
+            const auto& textBlock = *card->GetBody()[0];
+            const auto& dueText = prepared->GetTexts(textBlock.GetInternalId())->at(0);
+            Assert::AreEqual(std::string("Due Tue, Feb 14, 2017, **soon**"), dueText.text);
+            Assert::AreEqual(std::string("Due Tue, Feb 14, 2017, soon"), dueText.styledText.text);
+            Assert::AreEqual(2u, static_cast<unsigned int>(dueText.styledText.runs.size()));
+            Assert::IsTrue(dueText.styledText.runs[1].isBold);
+            Assert::AreEqual(hostConfig.GetFontSize(FontType::Default, TextSize::Large), dueText.fontSize);
+            Assert::AreEqual(hostConfig.GetFontWeight(FontType::Default, TextWeight::Bolder), dueText.fontWeight);
+            Assert::AreEqual(hostConfig.GetForegroundColor(ContainerStyle::Default, ForegroundColor::Default, false), dueText.color);
+
+            const auto& container = static_cast<const Container&>(*card->GetBody()[1]);
+            Assert::IsNull(prepared->GetTexts(container.GetInternalId()));
+            const auto& runs = *prepared->GetTexts(container.GetItems()[0]->GetInternalId());
+            Assert::AreEqual(2u, static_cast<unsigned int>(runs.size()));
+            Assert::AreEqual(std::string("**Marked**"), runs[1].text);
+            Assert::IsTrue(runs[1].styledText.runs.empty());
+            Assert::AreEqual(hostConfig.GetFontFamily(FontType::Monospace), runs[1].fontFamily);
+            Assert::AreEqual(hostConfig.GetHighlightColor(ContainerStyle::Emphasis, ForegroundColor::Default, false), runs[1].highlightColor);
+            Assert::IsTrue(runs[0].highlightColor.empty());
+
+            const auto& facts = *prepared->GetTexts(container.GetItems()[1]->GetInternalId());
+            Assert::AreEqual(2u, static_cast<unsigned int>(facts.size()));
+            Assert::AreEqual(hostConfig.GetFontWeight(FontType::Default, hostConfig.GetFactSet().title.weight), facts[0].fontWeight);
+            Assert::IsTrue(facts[1].styledText.runs[0].isItalic);
+
+            const auto showCard = std::static_pointer_cast<ShowCardAction>(card->GetActions()[0])->GetCard();
+            const auto& shown = prepared->GetTexts(showCard->GetBody()[0]->GetInternalId())->at(0);
+            Assert::AreEqual(hostConfig.GetForegroundColor(hostConfig.GetActions().showCard.style, ForegroundColor::Accent, false), shown.color);
+        }
+
+        TEST_METHOD(PoolMatchesCallingThread)
+        {
+            Json::Value body(Json::arrayValue);
+            for (int i = 0; i < 200; i++)
+            {
+                Json::Value textBlock;
+                textBlock["type"] = "TextBlock";
+                textBlock["text"] = "Item **" + std::to_string(i) + "** on {{DATE(2017-02-14T06:08:39Z, LONG)}}";
+                body.append(textBlock);
+            }
+            Json::Value cardJson;
+            cardJson["type"] = "AdaptiveCard";
+            cardJson["version"] = "1.2";
+            cardJson["body"] = body;
+            const auto card = AdaptiveCard::DeserializeFromString(cardJson.toStyledString(), "1.2")->GetAdaptiveCard();
+            HostConfig hostConfig;
+
+            const auto onCallingThread = RenderPrep::Prepare(*card, hostConfig);
+            RenderPrepThreadPool pool(4);
+            RenderPrepOptions options;
+            options.scheduler = pool.GetScheduler();
+            options.textsPerBatch = 3;
+            options.dateFormatter = [](const DateTimePreparsedToken& token, const std::string&) { return token.GetDisplayText(); };
+            const auto pooled = RenderPrep::Prepare(*card, hostConfig, options);
+
+            Assert::AreEqual(200u, static_cast<unsigned int>(pooled->GetElementCount()));
+            for (const auto& element : card->GetBody())
+            {
+                const auto& expected = FirstText(*onCallingThread, element->GetInternalId());
+                const auto& actual = FirstText(*pooled, element->GetInternalId());
+                Assert::AreEqual(expected.text, actual.text);
+                Assert::AreEqual(expected.styledText.text, actual.styledText.text);
+                Assert::AreEqual(static_cast<unsigned int>(expected.styledText.runs.size()), static_cast<unsigned int>(actual.styledText.runs.size()));
+                Assert::AreEqual(expected.color, actual.color);
+            }
+        }
+
+        TEST_METHOD(RethrowsFormatterErrors)
+        {
+            const auto card = AdaptiveCard::DeserializeFromString(
+                R"({ "type": "AdaptiveCard", "version": "1.2", "body": [ { "type": "TextBlock", "text": "{{TIME(2017-02-14T06:08:39Z)}}" } ] })", "1.2")->GetAdaptiveCard();
+            RenderPrepThreadPool pool(2);
+            RenderPrepOptions options;
+            options.scheduler = pool.GetScheduler();
+            options.dateFormatter = [](const DateTimePreparsedToken&, const std::string&) -> std::string {
+                throw std::runtime_error("no formatter for this language");
+            };
+            Assert::ExpectException<std::runtime_error>([&]() { RenderPrep::Prepare(*card, HostConfig(), options); });
+        }
+
+    private:
+        static const PreparedText& FirstText(const PreparedCard& card, const InternalId& id)
+        {
+            return card.GetTexts(id)->at(0);
+        }
+    };
+}
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "ResourceLoader.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    // Holds fetches until the test completes them
+    class ManualTransport : public ResourceTransport
+    {
+    public:
+        void Fetch(const std::string& url, const ResourceLoadCallback& onComplete) override
+        {
+            fetches.emplace_back(url, onComplete);
+        }
+
+        void Complete(size_t index, const std::string& content)
+        {
+            fetches[index].second({ResourceLoadStatus::Fetched, fetches[index].first, "image/png",
+                                   std::make_shared<std::vector<char>>(content.begin(), content.end()), ""});
+        }
+
+        std::vector<std::pair<std::string, ResourceLoadCallback>> fetches;
+    };
+
+    TEST_CLASS(ResourceLoaderTest)
+    {
+    public:
+        TEST_METHOD(CoalescesLoadsOfTheSameUrl)
+        {
+            auto transport = std::make_shared<ManualTransport>();
+            ResourceLoader loader(transport);
+
+            std::vector<ResourceLoadResult> results;
+            const auto onComplete = [&results](const ResourceLoadResult& result) { results.push_back(result); };
+            loader.Load("https://adaptivecards.io/a.png", onComplete);
+            loader.Load("https://adaptivecards.io/a.png", onComplete);
+            loader.Load("https://adaptivecards.io/b.png", onComplete);
+            Assert::AreEqual(2u, static_cast<unsigned int>(transport->fetches.size()));
+            Assert::IsTrue(results.empty());
+
+            transport->Complete(0, "aaaa");
+            Assert::AreEqual(2u, static_cast<unsigned int>(results.size()));
+            Assert::IsTrue(results[0].status == ResourceLoadStatus::Fetched);
+            Assert::IsTrue(results[0].data == results[1].data);
+            Assert::AreEqual(std::string("image/png"), results[1].mimeType);
+
+            loader.Load("https://adaptivecards.io/a.png", onComplete);
+            Assert::AreEqual(2u, static_cast<unsigned int>(transport->fetches.size()));
+            Assert::IsTrue(results[2].status == ResourceLoadStatus::FromMemoryCache);
+            Assert::IsTrue(results[2].data == results[0].data);
+        }
+
+        TEST_METHOD(EvictsLeastRecentlyUsed)
+        {
+            auto transport = std::make_shared<ManualTransport>();
+            ResourceLoaderOptions options;
+            options.memoryCacheBytes = 8;
+            ResourceLoader loader(transport, options);
+
+            ResourceLoadStatus status;
+            const auto onComplete = [&status](const ResourceLoadResult& result) { status = result.status; };
+            loader.Load("a", onComplete);
+            transport->Complete(0, "aaaa");
+            loader.Load("b", onComplete);
+            transport->Complete(1, "bbbb");
+            loader.Load("a", onComplete);
+            Assert::IsTrue(status == ResourceLoadStatus::FromMemoryCache);
+
+            loader.Load("c", onComplete);
+            transport->Complete(2, "cccc");
+            Assert::AreEqual(8u, static_cast<unsigned int>(loader.GetMemoryCacheBytes()));
+
+            loader.Load("a", onComplete);
+            Assert::IsTrue(status == ResourceLoadStatus::FromMemoryCache);
+            loader.Load("b", onComplete);
+            Assert::AreEqual(4u, static_cast<unsigned int>(transport->fetches.size()));
+        }
+
+        TEST_METHOD(ChecksDiskCacheContent)
+        {
+            const char* temp = std::getenv("TEMP");
+            temp = (temp == nullptr) ? std::getenv("TMPDIR") : temp;
+            ResourceLoaderOptions options;
+            options.memoryCacheBytes = 0;
+            options.diskCacheDirectory = (temp == nullptr) ? "." : temp;
+
+            // Content files are named after the SHA-256 of the content and its size
+            const std::string contentPath =
+                options.diskCacheDirectory + "/ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad-3";
+            const auto readContent = [&contentPath]() {
+                std::ifstream file(contentPath, std::ios::binary);
+                return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            };
+            const std::string url = "https://adaptivecards.io/disk-cache-test.png";
+
+            ResourceLoadResult result;
+            const auto onComplete = [&result](const ResourceLoadResult& loaded) { result = loaded; };
+            auto transport = std::make_shared<ManualTransport>();
+            ResourceLoader(transport, options).Load(url, onComplete);
+            transport->Complete(0, "abc");
+            Assert::AreEqual(std::string("abc"), readContent());
+
+            transport = std::make_shared<ManualTransport>();
+            ResourceLoader(transport, options).Load(url, onComplete);
+            Assert::IsTrue(transport->fetches.empty());
+            Assert::IsTrue(result.status == ResourceLoadStatus::FromDiskCache);
+            Assert::AreEqual(std::string("abc"), std::string(result.data->begin(), result.data->end()));
+
+            // Content that doesn't match its name is fetched again, and the file written again
+            std::ofstream(contentPath, std::ios::binary | std::ios::trunc) << "xyz";
+            transport = std::make_shared<ManualTransport>();
+            ResourceLoader loader(transport, options);
+            loader.Load(url, onComplete);
+            Assert::AreEqual(1u, static_cast<unsigned int>(transport->fetches.size()));
+            transport->Complete(0, "abc");
+            Assert::IsTrue(result.status == ResourceLoadStatus::Fetched);
+            Assert::AreEqual(std::string("abc"), readContent());
+
+            std::remove(contentPath.c_str());
+        }
+
+        TEST_METHOD(LoadsDataUris)
+        {
+            ResourceLoader loader(std::make_shared<LocalResourceTransport>());
+
+            std::vector<ResourceLoadResult> results;
+            const auto onComplete = [&results](const ResourceLoadResult& result) { results.push_back(result); };
+            loader.Load("data:text/plain;base64,SGVsbG8=", onComplete);
+            loader.Load("data:,Hello%2C%20world", onComplete);
+            loader.Load("https://adaptivecards.io/a.png", onComplete);
+
+            Assert::AreEqual(3u, static_cast<unsigned int>(results.size()));
+            Assert::AreEqual(std::string("text/plain"), results[0].mimeType);
+            Assert::AreEqual(std::string("Hello"), std::string(results[0].data->begin(), results[0].data->end()));
+            Assert::AreEqual(std::string("Hello, world"), std::string(results[1].data->begin(), results[1].data->end()));
+            Assert::IsTrue(results[2].status == ResourceLoadStatus::Failed);
+            Assert::IsNull(results[2].data.get());
+            Assert::IsFalse(results[2].error.empty());
+        }
+    };
+}
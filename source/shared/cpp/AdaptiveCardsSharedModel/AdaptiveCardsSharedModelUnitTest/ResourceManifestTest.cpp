@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "Container.h"
+#include "ResourceManifest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(ResourceManifestTest)
+    {
+    public:
+        TEST_METHOD(DeduplicatesAndOrdersByVisibility)
+        {
+            const std::string cardJson = R"card({
+                "type": "AdaptiveCard",
+                "version": "1.2",
+                "backgroundImage": "",
+                "body": [
+                    { "type": "Image", "url": "hidden.png", "isVisible": false },
+                    {
+                        "type": "Container",
+                        "items": [
+                            { "type": "Image", "url": "avatar.png" },
+                            { "type": "Image", "url": "https://adaptivecards.io/avatar.png" }
+                        ]
+                    },
+                    { "type": "Image", "url": "avatar.png" },
+                    { "type": "ActionSet", "actions": [ { "type": "Action.Submit", "iconUrl": "/icons/submit.png" } ] }
+                ],
+                "actions": [
+                    {
+                        "type": "Action.ShowCard",
+                        "card": { "type": "AdaptiveCard", "body": [ { "type": "Image", "url": "hidden.png" }, { "type": "Image", "url": "more.png" } ] }
+                    }
+                ]
+            })card";
+            const auto card = AdaptiveCard::DeserializeFromString(cardJson, "1.2")->GetAdaptiveCard();
+            HostConfig hostConfig;
+            hostConfig.SetImageBaseUrl("https://adaptivecards.io/cards/");
+
+            const auto manifest = ResourceManifest::Build(*card, hostConfig);
+            Assert::AreEqual(5u, static_cast<unsigned int>(manifest.size()));
+
+            Assert::AreEqual(std::string("https://adaptivecards.io/cards/avatar.png"), manifest[0].url);
+            Assert::IsTrue(manifest[0].isInitiallyVisible);
+            Assert::AreEqual(1u, manifest[0].position);
+            const auto& container = static_cast<const Container&>(*card->GetBody()[1]);
+            Assert::AreEqual(2u, static_cast<unsigned int>(manifest[0].referencedBy.size()));
+            Assert::IsTrue(manifest[0].referencedBy[0] == container.GetItems()[0]->GetInternalId());
+            Assert::IsTrue(manifest[0].referencedBy[1] == card->GetBody()[2]->GetInternalId());
+
+            Assert::AreEqual(std::string("https://adaptivecards.io/avatar.png"), manifest[1].url);
+            Assert::AreEqual(std::string("https://adaptivecards.io/icons/submit.png"), manifest[2].url);
+            Assert::IsTrue(manifest[2].isInitiallyVisible);
+
+            Assert::AreEqual(std::string("https://adaptivecards.io/cards/hidden.png"), manifest[3].url);
+            Assert::IsFalse(manifest[3].isInitiallyVisible);
+            Assert::AreEqual(0u, manifest[3].position);
+            Assert::AreEqual(2u, static_cast<unsigned int>(manifest[3].referencedBy.size()));
+            Assert::AreEqual(std::string("https://adaptivecards.io/cards/more.png"), manifest[4].url);
+            Assert::IsFalse(manifest[4].isInitiallyVisible);
+        }
+
+        TEST_METHOD(ResolvesRelativeUrls)
+        {
+            Assert::AreEqual(std::string("a.png"), ResourceManifest::ResolveUrl("", "a.png"));
+            Assert::AreEqual(std::string("data:image/png;base64,AA=="), ResourceManifest::ResolveUrl("https://host/", "data:image/png;base64,AA=="));
+            Assert::AreEqual(std::string("https://host/a.png"), ResourceManifest::ResolveUrl("https://host", "a.png"));
+            Assert::AreEqual(std::string("https://host/images/a.png"), ResourceManifest::ResolveUrl("https://host/images/", "a.png"));
+            Assert::AreEqual(std::string("https://host/images/a.png"), ResourceManifest::ResolveUrl("https://host/images/card.json?v=2", "a.png"));
+            Assert::AreEqual(std::string("https://host/a.png"), ResourceManifest::ResolveUrl("https://host/images/", "/a.png"));
+            Assert::AreEqual(std::string("https://cdn/a.png"), ResourceManifest::ResolveUrl("https://host/images/", "//cdn/a.png"));
+        }
+    };
+}
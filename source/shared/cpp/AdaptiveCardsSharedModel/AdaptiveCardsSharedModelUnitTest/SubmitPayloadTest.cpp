@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "ShowCardAction.h"
+#include "SubmitAction.h"
+#include "SubmitPayloadBuilder.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    TEST_CLASS(SubmitPayloadTest)
+    {
+    private:
+        const std::string c_card = R"card({
+            "type": "AdaptiveCard",
+            "version": "1.2",
+            "body": [
+                { "type": "Input.Text", "id": "name" },
+                {
+                    "type": "Container",
+                    "items": [
+                        { "type": "ActionSet", "actions": [ { "type": "Action.ShowCard", "card": { "type": "AdaptiveCard", "body": [ { "type": "Input.Date", "id": "due" } ] } } ] }
+                    ]
+                },
+                { "type": "FancyInput", "id": "fancy", "fallback": { "type": "Input.Text", "id": "fancy" } }
+            ],
+            "actions": [
+                { "type": "Action.Submit", "data": { "name": "replaced", "kind": "form", "nested": { "list": [ 1, 2.5, true, null, "a\"b" ] } } },
+                { "type": "Action.Submit" },
+                { "type": "Action.Submit", "data": "just a string" },
+                {
+                    "type": "Action.ShowCard",
+                    "card": {
+                        "type": "AdaptiveCard",
+                        "body": [ { "type": "Input.Toggle", "id": "agree", "title": "I agree" } ],
+                        "actions": [ { "type": "Action.Submit", "data": { "from": "showCard" } } ]
+                    }
+                }
+            ]
+        })card";
+
+    public:
+        TEST_METHOD(FindsInputsInScope)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_card, "1.2")->GetAdaptiveCard();
+            SubmitPayloadBuilder builder(*card);
+
+            std::vector<std::string> ids;
+            for (const auto& input : builder.GetInputs())
+            {
+                ids.push_back(input->GetId());
+            }
+            const std::vector<std::string> expected{"name", "due", "agree"};
+            Assert::IsTrue(ids == expected);
+        }
+
+        TEST_METHOD(MergesInputsIntoData)
+        {
+            auto card = AdaptiveCard::DeserializeFromString(c_card, "1.2")->GetAdaptiveCard();
+            SubmitPayloadBuilder builder(*card);
+            const std::unordered_map<std::string, std::string> values{
+                {"name", "Ada \"Countess\" Lovelace\n\xC3\xA9"}, {"agree", "true"}, {"fancy", "ignored"}};
+
+            const auto& withData = static_cast<const SubmitAction&>(*card->GetActions()[0]);
+            Json::Value expected = withData.GetDataJsonAsValue();
+            expected["name"] = values.at("name");
+            expected["agree"] = "true";
+            Assert::IsTrue(ParseUtil::GetJsonValueFromString(builder.Build(withData, values)) == expected);
+
+            const auto& withoutData = static_cast<const SubmitAction&>(*card->GetActions()[1]);
+            Assert::AreEqual(std::string("{\"name\":\"Ada \\\"Countess\\\" Lovelace\\n\xC3\xA9\",\"agree\":\"true\"}"),
+                             builder.Build(withoutData, values));
+            Assert::AreEqual(std::string("{}"), builder.Build(withoutData, {}));
+
+            const auto& withString = static_cast<const SubmitAction&>(*card->GetActions()[2]);
+            Assert::AreEqual(std::string("\"just a string\""), builder.Build(withString, values));
+
+            // Actions in ShowCards see the inputs of the whole card
+            auto showCard = std::static_pointer_cast<ShowCardAction>(card->GetActions()[3]);
+            const auto& nested = static_cast<const SubmitAction&>(*showCard->GetCard()->GetActions()[0]);
+            std::string payload = "reused";
+            builder.Build(nested, values, payload);
+            Assert::AreEqual(std::string("{\"from\":\"showCard\",\"name\":\"Ada \\\"Countess\\\" Lovelace\\n\xC3\xA9\",\"agree\":\"true\"}"), payload);
+        }
+    };
+}
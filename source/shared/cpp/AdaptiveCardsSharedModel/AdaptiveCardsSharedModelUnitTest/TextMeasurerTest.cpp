@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "stdafx.h"
+#include "LineBreaker.h"
+#include "TextMeasurer.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace AdaptiveCards;
+
+namespace AdaptiveCardsSharedModelUnitTest
+{
+    // Counts calls so tests can observe the cache in front of it.
+    class CountingTextMeasurer : public TextMeasurer
+    {
+    public:
+        double MeasureWidth(const std::string& text, FontType, TextSize, TextWeight) override
+        {
+            ++measureCount;
+            return static_cast<double>(text.size());
+        }
+
+        double GetLineHeight(FontType, TextSize) override { return 1; }
+
+        unsigned int measureCount = 0;
+    };
+
+    TEST_CLASS(TextMeasurerTest)
+    {
+    public:
+        TEST_METHOD(AdvanceTableMeasurement)
+        {
+            const std::string metricsStr = R"metrics({
+                "default": {
+                    "averageCharWidth": 0.5,
+                    "bolderCharWidth": 0.6,
+                    "advances": { "i": 0.25, "W": 1.0, "\u00e9": 0.75 }
+                }
+            })metrics";
+            HostConfig hostConfig;
+            const double fontSize = hostConfig.GetFontSize(FontType::Default, TextSize::Default);
+            AdvanceTableTextMeasurer measurer(hostConfig, FontMetricsTable::DeserializeFromString(metricsStr));
+
+            Assert::AreEqual(0.0, measurer.MeasureWidth("", FontType::Default, TextSize::Default, TextWeight::Default));
+            Assert::AreEqual(fontSize * 1.75, measurer.MeasureWidth("iWa", FontType::Default, TextSize::Default, TextWeight::Default));
+            Assert::AreEqual(fontSize * 0.75, measurer.MeasureWidth("\xC3\xA9", FontType::Default, TextSize::Default, TextWeight::Default));
+
+            // bolder text scales listed advances by bolderCharWidth / averageCharWidth
+            Assert::AreEqual(fontSize * 0.3, measurer.MeasureWidth("i", FontType::Default, TextSize::Default, TextWeight::Bolder), 1e-9);
+
+            // monospace wasn't overridden and keeps its fixed advance
+            const double monospaceSize = hostConfig.GetFontSize(FontType::Monospace, TextSize::Default);
+            Assert::AreEqual(monospaceSize * 1.8, measurer.MeasureWidth("iWa", FontType::Monospace, TextSize::Default, TextWeight::Default), 1e-9);
+        }
+
+        TEST_METHOD(CachingMeasurerMemoizesPerStyle)
+        {
+            auto counter = std::make_shared<CountingTextMeasurer>();
+            CachingTextMeasurer measurer(counter, 2);
+
+            Assert::AreEqual(5.0, measurer.MeasureWidth("hello", FontType::Default, TextSize::Default, TextWeight::Default));
+            Assert::AreEqual(5.0, measurer.MeasureWidth("hello", FontType::Default, TextSize::Default, TextWeight::Default));
+            Assert::AreEqual(1U, counter->measureCount);
+
+            measurer.MeasureWidth("hello", FontType::Default, TextSize::Large, TextWeight::Default);
+            Assert::AreEqual(2U, counter->measureCount);
+
+            // the cache is full; the next new entry starts it over
+            measurer.MeasureWidth("world", FontType::Default, TextSize::Default, TextWeight::Default);
+            measurer.MeasureWidth("hello", FontType::Default, TextSize::Default, TextWeight::Default);
+            Assert::AreEqual(4U, counter->measureCount);
+        }
+
+        TEST_METHOD(GreedyLineBreaking)
+        {
+            LineBreaker lineBreaker(std::make_shared<CountingTextMeasurer>(), FontType::Default, TextSize::Default, TextWeight::Default);
+
+            const std::string text = "aaa bb cc dddd\n\nee";
+            auto lines = lineBreaker.BreakGreedy(text, 6);
+            Assert::AreEqual(static_cast<size_t>(5), lines.size());
+            Assert::AreEqual(std::string("aaa bb"), text.substr(lines[0].begin, lines[0].end - lines[0].begin));
+            Assert::AreEqual(std::string("cc"), text.substr(lines[1].begin, lines[1].end - lines[1].begin));
+            Assert::AreEqual(std::string("dddd"), text.substr(lines[2].begin, lines[2].end - lines[2].begin));
+            Assert::AreEqual(0.0, lines[3].width);
+            Assert::AreEqual(std::string("ee"), text.substr(lines[4].begin, lines[4].end - lines[4].begin));
+            Assert::AreEqual(lines.size(), lineBreaker.CountLinesGreedy(text, 6));
+
+            // words that don't fit on their own overflow onto a line by themselves
+            lines = lineBreaker.BreakGreedy("a abcdefgh b", 4);
+            Assert::AreEqual(static_cast<size_t>(3), lines.size());
+            Assert::AreEqual(8.0, lines[1].width);
+
+            Assert::AreEqual(static_cast<size_t>(1), lineBreaker.CountLinesGreedy("", 10));
+        }
+
+        TEST_METHOD(OptimalLineBreaking)
+        {
+            LineBreaker lineBreaker(std::make_shared<CountingTextMeasurer>(), FontType::Default, TextSize::Default, TextWeight::Default);
+
+            // greedy fills the first line and leaves the second one ragged; optimal evens them out
+            const std::string text = "aaa bb cc ddddd";
+            auto greedy = lineBreaker.BreakGreedy(text, 6);
+            Assert::AreEqual(static_cast<size_t>(3), greedy.size());
+            Assert::AreEqual(std::string("aaa bb"), text.substr(greedy[0].begin, greedy[0].end - greedy[0].begin));
+            Assert::AreEqual(std::string("cc"), text.substr(greedy[1].begin, greedy[1].end - greedy[1].begin));
+
+            auto optimal = lineBreaker.BreakOptimal(text, 6);
+            Assert::AreEqual(static_cast<size_t>(3), optimal.size());
+            Assert::AreEqual(std::string("aaa"), text.substr(optimal[0].begin, optimal[0].end - optimal[0].begin));
+            Assert::AreEqual(std::string("bb cc"), text.substr(optimal[1].begin, optimal[1].end - optimal[1].begin));
+            Assert::AreEqual(std::string("ddddd"), text.substr(optimal[2].begin, optimal[2].end - optimal[2].begin));
+
+            auto paragraphs = lineBreaker.BreakOptimal("a b\nc", 10);
+            Assert::AreEqual(static_cast<size_t>(2), paragraphs.size());
+            Assert::AreEqual(3.0, paragraphs[0].width);
+        }
+    };
+}
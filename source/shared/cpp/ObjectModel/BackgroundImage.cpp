@@ -7,9 +7,23 @@
 
 using namespace AdaptiveSharedNamespace;
 
-std::string BackgroundImage::GetUrl() const { return m_url; }
+std::string BackgroundImage::GetUrl() const { return m_dataUri ? m_dataUri->GetUri() : m_url; }
 
-void BackgroundImage::SetUrl(const std::string& value) { m_url = value; }
+const std::string& BackgroundImage::GetUrlRef() const { return m_dataUri ? m_dataUri->GetUri() : m_url; }
+
+void BackgroundImage::SetUrl(const std::string& value)
+{
+    m_url = value;
+    m_dataUri.reset();
+}
+
+std::shared_ptr<const DataUri> BackgroundImage::GetDataUri() const { return m_dataUri; }
+
+void BackgroundImage::SetDataUri(const std::shared_ptr<const DataUri>& value)
+{
+    m_url.clear();
+    m_dataUri = value;
+}
 
 ImageFillMode BackgroundImage::GetFillMode() const { return m_fillMode; }
 
@@ -33,18 +47,18 @@ Json::Value BackgroundImage::SerializeToJsonValue() const
     Json::Value root;
 
     // if BackgroundImage has a url and the rest as default values
-    if (!m_url.empty() && m_fillMode == ImageFillMode::Cover && m_hAlignment == HorizontalAlignment::Left &&
+    if (!GetUrl().empty() && m_fillMode == ImageFillMode::Cover && m_hAlignment == HorizontalAlignment::Left &&
         m_vAlignment == VerticalAlignment::Top)
     {
-        root = m_url;
+        root = GetUrl();
     }
 
     // standard serialization process
     else
     {
-        if (!m_url.empty())
+        if (!GetUrl().empty())
         {
-            root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url)] = m_url;
+            root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url)] = GetUrl();
         }
 
         if (m_fillMode != ImageFillMode::Cover)
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "pch.h"
+#include "DataUri.h"
 #include "ParseContext.h"
 
 namespace AdaptiveSharedNamespace
@@ -21,7 +22,11 @@ namespace AdaptiveSharedNamespace
         }
 
         std::string GetUrl() const;
+        const std::string& GetUrlRef() const;
         void SetUrl(const std::string& value);
+        // The URL when it's an interned data: URI (see ParseContext::InternDataUri), or nullptr
+        std::shared_ptr<const DataUri> GetDataUri() const;
+        void SetDataUri(const std::shared_ptr<const DataUri>& value);
         ImageFillMode GetFillMode() const;
         void SetFillMode(const ImageFillMode& value);
         HorizontalAlignment GetHorizontalAlignment() const;
@@ -37,6 +42,7 @@ namespace AdaptiveSharedNamespace
 
     private:
         std::string m_url;
+        std::shared_ptr<const DataUri> m_dataUri;
         ImageFillMode m_fillMode = ImageFillMode::Cover;
         HorizontalAlignment m_hAlignment = HorizontalAlignment::Left;
         VerticalAlignment m_vAlignment = VerticalAlignment::Top;
@@ -8,6 +8,10 @@
 #include "BaseElement.h"
 
 void HandleUnknownProperties(const Json::Value& json, const std::unordered_set<std::string>& knownProperties, Json::Value& unknownProperties);
+void HandleUnknownProperties(const Json::Value& json,
+                             const std::unordered_set<std::string>& sharedKnownProperties,
+                             const std::unordered_set<std::string>& knownProperties,
+                             Json::Value& unknownProperties);
 
 namespace AdaptiveSharedNamespace
 {
@@ -56,7 +60,7 @@ namespace AdaptiveSharedNamespace
     template <typename T>
     std::shared_ptr<T> BaseActionElement::Deserialize(ParseContext& context, const Json::Value& json)
     {
-        std::shared_ptr<T> cardElement = std::make_shared<T>();
+        std::shared_ptr<T> cardElement = context.MakeShared<T>();
         std::shared_ptr<BaseActionElement> baseActionElement = std::static_pointer_cast<BaseActionElement>(cardElement);
 
         ParseUtil::ThrowIfNotJsonObject(json);
@@ -67,8 +71,12 @@ namespace AdaptiveSharedNamespace
         baseActionElement->SetStyle(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Style, defaultStyle, false));
 
         // Walk all properties and put any unknown ones in the additional properties json
-        HandleUnknownProperties(json, baseActionElement->m_knownProperties, baseActionElement->m_additionalProperties);
+        HandleUnknownProperties(json,
+                                *baseActionElement->m_sharedKnownProperties,
+                                baseActionElement->m_knownProperties,
+                                baseActionElement->m_additionalProperties);
 
+        context.AddIdentifiedElement(cardElement);
         return cardElement;
     }
 }
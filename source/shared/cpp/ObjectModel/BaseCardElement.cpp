@@ -27,11 +27,13 @@ BaseCardElement::BaseCardElement(CardElementType type) :
 
 void BaseCardElement::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Height),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsVisible),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MinHeight),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Separator),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Spacing)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Height),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsVisible),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MinHeight),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Separator),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Spacing)});
+    m_sharedKnownProperties = &knownProperties;
 }
 
 bool BaseCardElement::GetSeparator() const
@@ -10,6 +10,10 @@
 #include "RemoteResourceInformation.h"
 
 void HandleUnknownProperties(const Json::Value& json, const std::unordered_set<std::string>& knownProperties, Json::Value& unknownProperties);
+void HandleUnknownProperties(const Json::Value& json,
+                             const std::unordered_set<std::string>& sharedKnownProperties,
+                             const std::unordered_set<std::string>& knownProperties,
+                             Json::Value& unknownProperties);
 
 namespace AdaptiveSharedNamespace
 {
@@ -60,7 +64,7 @@ namespace AdaptiveSharedNamespace
 
     template<typename T> std::shared_ptr<T> BaseCardElement::Deserialize(ParseContext& context, const Json::Value& json)
     {
-        std::shared_ptr<T> cardElement = std::make_shared<T>();
+        std::shared_ptr<T> cardElement = context.MakeShared<T>();
         std::shared_ptr<BaseCardElement> baseCardElement = std::static_pointer_cast<BaseCardElement>(cardElement);
 
         ParseUtil::ThrowIfNotJsonObject(json);
@@ -75,8 +79,12 @@ namespace AdaptiveSharedNamespace
             ParseUtil::GetEnumValue<Spacing>(json, AdaptiveCardSchemaKey::Spacing, Spacing::Default, SpacingFromString));
 
         // Walk all properties and put any unknown ones in the additional properties json
-        HandleUnknownProperties(json, baseCardElement->m_knownProperties, baseCardElement->m_additionalProperties);
+        HandleUnknownProperties(json,
+                                *baseCardElement->m_sharedKnownProperties,
+                                baseCardElement->m_knownProperties,
+                                baseCardElement->m_additionalProperties);
 
+        context.AddIdentifiedElement(cardElement);
         return cardElement;
     }
 }
@@ -41,18 +41,31 @@ namespace AdaptiveSharedNamespace
 
     std::string BaseElement::GetElementTypeString() const { return m_typeString; }
 
+    const std::string& BaseElement::GetElementTypeStringRef() const { return m_typeString; }
+
     void BaseElement::SetElementTypeString(const std::string& value) { m_typeString = value; }
 
     void BaseElement::PopulateKnownPropertiesSet()
     {
-        m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback),
-                                  AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Id),
-                                  AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Requires),
-                                  AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)});
+        static const std::unordered_set<std::string> knownProperties{
+            AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback),
+            AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Id),
+            AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Requires),
+            AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)};
+        m_sharedKnownProperties = &knownProperties;
+    }
+
+    std::unordered_set<std::string> BaseElement::ExtendKnownProperties(std::initializer_list<std::string> properties) const
+    {
+        std::unordered_set<std::string> knownProperties = *m_sharedKnownProperties;
+        knownProperties.insert(properties);
+        return knownProperties;
     }
 
     Json::Value BaseElement::GetAdditionalProperties() const { return m_additionalProperties; }
 
+    const Json::Value& BaseElement::GetAdditionalPropertiesRef() const { return m_additionalProperties; }
+
     void BaseElement::SetAdditionalProperties(Json::Value const& value) { m_additionalProperties = value; }
 
     // Given a map of what our host provides, determine if this element's requirements are satisfied.
@@ -45,7 +45,7 @@ namespace AdaptiveSharedNamespace
     {
     public:
         BaseElement() :
-            m_typeString{}, m_additionalProperties{},
+            m_typeString{}, m_knownProperties{}, m_sharedKnownProperties{}, m_additionalProperties{},
             m_requires{std::make_shared<std::unordered_map<std::string, AdaptiveSharedNamespace::SemanticVersion>>()},
             m_fallbackContent(nullptr), m_internalId{InternalId::Current()}, m_fallbackType(FallbackType::None),
             m_canFallbackToAncestor(false), m_id{}
@@ -61,6 +61,7 @@ namespace AdaptiveSharedNamespace
 
         // Element type and identity
         std::string GetElementTypeString() const;
+        const std::string& GetElementTypeStringRef() const;
         void SetElementTypeString(const std::string& value);
         virtual std::string GetId() const;
         virtual void SetId(const std::string& value);
@@ -72,6 +73,7 @@ namespace AdaptiveSharedNamespace
         virtual std::string Serialize() const;
         virtual Json::Value SerializeToJsonValue() const;
         Json::Value GetAdditionalProperties() const;
+        const Json::Value& GetAdditionalPropertiesRef() const;
         void SetAdditionalProperties(const Json::Value& additionalProperties);
 
         // Fallback and Requires support
@@ -91,8 +93,18 @@ namespace AdaptiveSharedNamespace
         void SetTypeString(const std::string& type) { m_typeString = type; }
         void SetCanFallbackToAncestor(bool value) { m_canFallbackToAncestor = value; }
 
+        // Returns the known properties set so far (i.e. the base class's) plus properties
+        std::unordered_set<std::string> ExtendKnownProperties(std::initializer_list<std::string> properties) const;
+
         std::string m_typeString;
+
+        // Properties known to this instance on top of those its class shares (m_sharedKnownProperties). The built-in
+        // elements leave this empty; subclasses can still add their own properties to it.
         std::unordered_set<std::string> m_knownProperties;
+
+        // The properties an element's class understands, which are shared by all of its instances. Each class's
+        // PopulateKnownPropertiesSet builds its set once, from its base class's, and points this at it.
+        const std::unordered_set<std::string>* m_sharedKnownProperties;
         Json::Value m_additionalProperties;
 
     private:
@@ -121,7 +133,8 @@ namespace AdaptiveSharedNamespace
 
     template<typename T> void BaseElement::ParseFallback(ParseContext& context, const Json::Value& json)
     {
-        const auto fallbackValue = ParseUtil::ExtractJsonValue(json, AdaptiveCardSchemaKey::Fallback, false);
+        // Not copied, since fallback content can hold fallback content of its own
+        const Json::Value& fallbackValue = json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback)];
         if (!fallbackValue.empty())
         {
             // Two possible valid json values for fallback -- either the string "drop", or a valid Adaptive Card
@@ -32,6 +32,11 @@ std::string BaseInputElement::GetErrorMessage() const
     return m_errorMessage;
 }
 
+const std::string& BaseInputElement::GetErrorMessageRef() const
+{
+    return m_errorMessage;
+}
+
 void BaseInputElement::SetErrorMessage(const std::string errorMessage)
 {
     m_errorMessage = errorMessage;
@@ -56,6 +61,8 @@ Json::Value BaseInputElement::SerializeToJsonValue() const
 
 void BaseInputElement::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsRequired),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ErrorMessage)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsRequired),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ErrorMessage)});
+    m_sharedKnownProperties = &knownProperties;
 }
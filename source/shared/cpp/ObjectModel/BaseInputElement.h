@@ -20,6 +20,7 @@ namespace AdaptiveSharedNamespace
         void SetIsRequired(const bool isRequired);
 
         std::string GetErrorMessage() const;
+        const std::string& GetErrorMessageRef() const;
         void SetErrorMessage(const std::string errorMessage);
 
         Json::Value SerializeToJsonValue() const override;
@@ -0,0 +1,589 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "BinaryCardFormat.h"
+#include "AdaptiveCardParseException.h"
+#include <cstring>
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    const char c_magic[4] = {'A', 'C', 'B', 'N'};
+    const size_t c_headerSize = 20;
+
+    // Deeper nesting than any card needs, to bound the recursion on malformed buffers
+    const unsigned int c_maxDepth = 1000;
+
+    // AdaptiveCardSchemaKey runs from zero to Wrap, its last value
+    const uint16_t c_schemaKeyCount = static_cast<uint16_t>(AdaptiveCardSchemaKey::Wrap) + 1;
+
+    const std::vector<std::string>& GetSchemaKeyNames()
+    {
+        static const std::vector<std::string> names = []() {
+            std::vector<std::string> keyNames;
+            keyNames.reserve(c_schemaKeyCount);
+            for (uint16_t key = 0; key < c_schemaKeyCount; key++)
+            {
+                // A few keys are only used in code and have no name; they're left empty
+                try
+                {
+                    keyNames.push_back(AdaptiveCardSchemaKeyToString(static_cast<AdaptiveCardSchemaKey>(key)));
+                }
+                catch (const std::out_of_range&)
+                {
+                    keyNames.emplace_back();
+                }
+            }
+            return keyNames;
+        }();
+        return names;
+    }
+
+    // AdaptiveCardSchemaKeyFromString ignores case, but property names don't
+    const std::unordered_map<std::string, uint16_t>& GetSchemaKeys()
+    {
+        static const std::unordered_map<std::string, uint16_t> keys = []() {
+            std::unordered_map<std::string, uint16_t> schemaKeys;
+            const auto& names = GetSchemaKeyNames();
+            for (uint16_t key = 0; key < names.size(); key++)
+            {
+                if (!names[key].empty())
+                {
+                    schemaKeys.emplace(names[key], key);
+                }
+            }
+            return schemaKeys;
+        }();
+        return keys;
+    }
+
+    void WriteUInt16(uint16_t value, std::vector<uint8_t>& out)
+    {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void WriteUInt32(uint32_t value, std::vector<uint8_t>& out)
+    {
+        for (unsigned int shift = 0; shift < 32; shift += 8)
+        {
+            out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void PatchUInt32(uint32_t value, size_t offset, std::vector<uint8_t>& out)
+    {
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            out[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+        }
+    }
+
+    void WriteVarint(uint64_t value, std::vector<uint8_t>& out)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    class Writer
+    {
+    public:
+        std::vector<uint8_t> Write(const Json::Value& value)
+        {
+            // Count the uses of each string first, so the most used get the smallest indexes
+            CountStrings(value);
+            std::vector<std::pair<std::string, uint32_t>> strings(m_strings.begin(), m_strings.end());
+            std::sort(strings.begin(), strings.end(), [](const std::pair<std::string, uint32_t>& a, const std::pair<std::string, uint32_t>& b) {
+                return a.second != b.second ? a.second > b.second : a.first < b.first;
+            });
+
+            std::vector<uint8_t> out(c_magic, c_magic + sizeof(c_magic));
+            WriteUInt16(BinaryCardFormat::Version, out);
+            WriteUInt16(c_schemaKeyCount, out);
+            WriteUInt32(static_cast<uint32_t>(strings.size()), out);
+            const size_t sizesOffset = out.size();
+            WriteUInt32(0, out);
+            WriteUInt32(0, out);
+
+            uint32_t stringOffset = 0;
+            for (uint32_t i = 0; i < strings.size(); i++)
+            {
+                WriteUInt32(stringOffset, out);
+                stringOffset += static_cast<uint32_t>(strings[i].first.size());
+                m_strings[strings[i].first] = i;
+            }
+            WriteUInt32(stringOffset, out);
+            for (const auto& string : strings)
+            {
+                out.insert(out.end(), string.first.begin(), string.first.end());
+            }
+
+            const size_t valueOffset = out.size();
+            WriteValue(value, out);
+
+            PatchUInt32(stringOffset, sizesOffset, out);
+            PatchUInt32(static_cast<uint32_t>(out.size() - valueOffset), sizesOffset + 4, out);
+            return out;
+        }
+
+    private:
+        void CountStrings(const Json::Value& value)
+        {
+            switch (value.type())
+            {
+            case Json::stringValue:
+            {
+                const char* begin;
+                const char* end;
+                value.getString(&begin, &end);
+                ++m_strings[std::string(begin, end)];
+                break;
+            }
+            case Json::arrayValue:
+                for (const auto& element : value)
+                {
+                    CountStrings(element);
+                }
+                break;
+            case Json::objectValue:
+                for (auto member = value.begin(); member != value.end(); ++member)
+                {
+                    const char* nameEnd;
+                    const char* name = member.memberName(&nameEnd);
+                    std::string memberName(name, nameEnd);
+                    if (GetSchemaKeys().count(memberName) == 0)
+                    {
+                        ++m_strings[std::move(memberName)];
+                    }
+                    CountStrings(*member);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        void WriteValue(const Json::Value& value, std::vector<uint8_t>& out)
+        {
+            switch (value.type())
+            {
+            case Json::nullValue:
+                out.push_back(static_cast<uint8_t>(BinaryCardFormat::ValueType::Null));
+                break;
+            case Json::booleanValue:
+                out.push_back(static_cast<uint8_t>(value.asBool() ? BinaryCardFormat::ValueType::True : BinaryCardFormat::ValueType::False));
+                break;
+            case Json::intValue:
+            {
+                const Json::LargestInt number = value.asLargestInt();
+                out.push_back(static_cast<uint8_t>(BinaryCardFormat::ValueType::Int));
+                WriteVarint((static_cast<uint64_t>(number) << 1) ^ static_cast<uint64_t>(number >> 63), out);
+                break;
+            }
+            case Json::uintValue:
+                out.push_back(static_cast<uint8_t>(BinaryCardFormat::ValueType::UInt));
+                WriteVarint(value.asLargestUInt(), out);
+                break;
+            case Json::realValue:
+            {
+                const double number = value.asDouble();
+                uint64_t bits;
+                memcpy(&bits, &number, sizeof(bits));
+                out.push_back(static_cast<uint8_t>(BinaryCardFormat::ValueType::Real));
+                for (unsigned int shift = 0; shift < 64; shift += 8)
+                {
+                    out.push_back(static_cast<uint8_t>(bits >> shift));
+                }
+                break;
+            }
+            case Json::stringValue:
+            {
+                const char* begin;
+                const char* end;
+                value.getString(&begin, &end);
+                out.push_back(static_cast<uint8_t>(BinaryCardFormat::ValueType::String));
+                WriteVarint(m_strings[std::string(begin, end)], out);
+                break;
+            }
+            case Json::arrayValue:
+            {
+                out.push_back(static_cast<uint8_t>(BinaryCardFormat::ValueType::Array));
+                const size_t sizeOffset = out.size();
+                WriteUInt32(0, out);
+                WriteVarint(value.size(), out);
+                for (const auto& element : value)
+                {
+                    WriteValue(element, out);
+                }
+                PatchUInt32(static_cast<uint32_t>(out.size() - sizeOffset - 4), sizeOffset, out);
+                break;
+            }
+            case Json::objectValue:
+            {
+                out.push_back(static_cast<uint8_t>(BinaryCardFormat::ValueType::Object));
+                const size_t sizeOffset = out.size();
+                WriteUInt32(0, out);
+                WriteVarint(value.size(), out);
+                for (auto member = value.begin(); member != value.end(); ++member)
+                {
+                    const char* nameEnd;
+                    const char* name = member.memberName(&nameEnd);
+                    const std::string memberName(name, nameEnd);
+                    const auto key = GetSchemaKeys().find(memberName);
+                    if (key != GetSchemaKeys().end())
+                    {
+                        WriteVarint(static_cast<uint64_t>(key->second) << 1, out);
+                    }
+                    else
+                    {
+                        WriteVarint((static_cast<uint64_t>(m_strings[memberName]) << 1) | 1, out);
+                    }
+                    WriteValue(*member, out);
+                }
+                PatchUInt32(static_cast<uint32_t>(out.size() - sizeOffset - 4), sizeOffset, out);
+                break;
+            }
+            }
+        }
+
+        // Use counts while counting, then indexes into the string table
+        std::unordered_map<std::string, uint32_t> m_strings;
+    };
+
+    [[noreturn]] void ThrowInvalid(const std::string& message)
+    {
+        throw AdaptiveCardParseException(ErrorStatusCode::InvalidJson, "Invalid binary card: " + message);
+    }
+
+    uint16_t ReadUInt16(const uint8_t* data) { return static_cast<uint16_t>(data[0] | (data[1] << 8)); }
+
+    uint32_t ReadUInt32(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) |
+               (static_cast<uint32_t>(data[3]) << 24);
+    }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    constexpr uint16_t BinaryCardFormat::Version;
+
+    std::vector<uint8_t> BinaryCardFormat::Write(const Json::Value& value) { return Writer().Write(value); }
+
+    Json::Value BinaryCardFormat::Read(const uint8_t* data, size_t size)
+    {
+        const BinaryCardReader reader(data, size);
+        return reader.ToJson(reader.GetRoot());
+    }
+
+    BinaryCardReader::BinaryCardReader(const uint8_t* data, size_t size) : m_end(data + size)
+    {
+        if (size < c_headerSize || memcmp(data, c_magic, sizeof(c_magic)) != 0)
+        {
+            ThrowInvalid("not a binary card");
+        }
+
+        const uint8_t* header = data + sizeof(c_magic);
+        if (ReadUInt16(header) != BinaryCardFormat::Version || ReadUInt16(header + 2) != c_schemaKeyCount)
+        {
+            ThrowInvalid("written by an incompatible version");
+        }
+
+        const uint64_t stringCount = ReadUInt32(header + 4);
+        const uint64_t stringDataSize = ReadUInt32(header + 8);
+        const uint64_t valueSize = ReadUInt32(header + 12);
+        const uint64_t tableSize = (stringCount + 1) * 4;
+        if (c_headerSize + tableSize + stringDataSize + valueSize != static_cast<uint64_t>(size))
+        {
+            ThrowInvalid("truncated");
+        }
+
+        m_stringCount = static_cast<size_t>(stringCount);
+        m_stringOffsets = data + c_headerSize;
+        m_stringData = reinterpret_cast<const char*>(m_stringOffsets + tableSize);
+        m_stringDataSize = static_cast<uint32_t>(stringDataSize);
+        m_root = m_stringOffsets + tableSize + stringDataSize;
+        if (m_root == m_end || Skip(m_root) != m_end)
+        {
+            ThrowInvalid("unexpected data after the card");
+        }
+    }
+
+    BinaryCardFormat::ValueType BinaryCardReader::GetType(const uint8_t* value) const
+    {
+        if (value >= m_end)
+        {
+            ThrowInvalid("truncated");
+        }
+        if (*value > static_cast<uint8_t>(BinaryCardFormat::ValueType::Object))
+        {
+            ThrowInvalid("unknown value type");
+        }
+        return static_cast<BinaryCardFormat::ValueType>(*value);
+    }
+
+    const uint8_t* BinaryCardReader::Skip(const uint8_t* value) const
+    {
+        const uint8_t* position = value + 1;
+        switch (GetType(value))
+        {
+        case BinaryCardFormat::ValueType::Int:
+        case BinaryCardFormat::ValueType::UInt:
+        case BinaryCardFormat::ValueType::String:
+            ReadVarint(position);
+            return position;
+        case BinaryCardFormat::ValueType::Real:
+            if (m_end - position < 8)
+            {
+                ThrowInvalid("truncated");
+            }
+            return position + 8;
+        case BinaryCardFormat::ValueType::Array:
+        case BinaryCardFormat::ValueType::Object:
+            return ReadContainerEnd(position);
+        default:
+            return position;
+        }
+    }
+
+    bool BinaryCardReader::GetString(const uint8_t* value, const char*& begin, const char*& end) const
+    {
+        if (GetType(value) != BinaryCardFormat::ValueType::String)
+        {
+            return false;
+        }
+        const uint8_t* position = value + 1;
+        GetTableString(ReadVarint(position), begin, end);
+        return true;
+    }
+
+    size_t BinaryCardReader::GetCount(const uint8_t* value, const uint8_t*& first) const
+    {
+        const BinaryCardFormat::ValueType type = GetType(value);
+        if (type != BinaryCardFormat::ValueType::Array && type != BinaryCardFormat::ValueType::Object)
+        {
+            first = nullptr;
+            return 0;
+        }
+
+        first = value + 1;
+        const uint8_t* containerEnd = ReadContainerEnd(first);
+        const uint64_t count = ReadVarint(first);
+
+        // Every element and member takes at least a byte
+        if (count > static_cast<uint64_t>(containerEnd - first))
+        {
+            ThrowInvalid("bad count");
+        }
+        return static_cast<size_t>(count);
+    }
+
+    const uint8_t* BinaryCardReader::ReadMemberName(const uint8_t* member, const char*& begin, const char*& end) const
+    {
+        const uint64_t name = ReadVarint(member);
+        if ((name & 1) == 0)
+        {
+            if ((name >> 1) >= c_schemaKeyCount || GetSchemaKeyNames()[name >> 1].empty())
+            {
+                ThrowInvalid("bad property name");
+            }
+            const std::string& keyName = GetSchemaKeyNames()[name >> 1];
+            begin = keyName.data();
+            end = keyName.data() + keyName.size();
+        }
+        else
+        {
+            GetTableString(name >> 1, begin, end);
+        }
+        return member;
+    }
+
+    const uint8_t* BinaryCardReader::FindMember(const uint8_t* object, AdaptiveCardSchemaKey key) const
+    {
+        if (GetType(object) != BinaryCardFormat::ValueType::Object)
+        {
+            return nullptr;
+        }
+
+        const uint64_t wanted = static_cast<uint64_t>(key) << 1;
+        const uint8_t* member;
+        for (size_t count = GetCount(object, member); count > 0; count--)
+        {
+            const uint64_t name = ReadVarint(member);
+            if (name == wanted)
+            {
+                return member;
+            }
+            member = Skip(member);
+        }
+        return nullptr;
+    }
+
+    Json::Value BinaryCardReader::ToJson(const uint8_t* value) const
+    {
+        Json::Value json;
+        ReadValue(value, json, 0);
+        return json;
+    }
+
+    uint64_t BinaryCardReader::ReadVarint(const uint8_t*& position) const
+    {
+        uint64_t value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+            if (position >= m_end)
+            {
+                ThrowInvalid("truncated");
+            }
+            const uint8_t byte = *position++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        ThrowInvalid("bad number");
+    }
+
+    void BinaryCardReader::GetTableString(uint64_t index, const char*& begin, const char*& end) const
+    {
+        if (index >= m_stringCount)
+        {
+            ThrowInvalid("bad string index");
+        }
+        const uint32_t first = ReadUInt32(m_stringOffsets + index * 4);
+        const uint32_t last = ReadUInt32(m_stringOffsets + (index + 1) * 4);
+        if (first > last || last > m_stringDataSize)
+        {
+            ThrowInvalid("bad string table");
+        }
+        begin = m_stringData + first;
+        end = m_stringData + last;
+    }
+
+    const uint8_t* BinaryCardReader::ReadContainerEnd(const uint8_t*& position) const
+    {
+        if (m_end - position < 4)
+        {
+            ThrowInvalid("truncated");
+        }
+        const uint32_t size = ReadUInt32(position);
+        position += 4;
+        if (static_cast<size_t>(m_end - position) < size)
+        {
+            ThrowInvalid("truncated");
+        }
+        return position + size;
+    }
+
+    const uint8_t* BinaryCardReader::ReadValue(const uint8_t* value, Json::Value& json, unsigned int depth) const
+    {
+        if (depth > c_maxDepth)
+        {
+            ThrowInvalid("nested too deeply");
+        }
+
+        const uint8_t* position = value + 1;
+        switch (GetType(value))
+        {
+        case BinaryCardFormat::ValueType::Null:
+            json = Json::Value();
+            break;
+        case BinaryCardFormat::ValueType::False:
+            json = false;
+            break;
+        case BinaryCardFormat::ValueType::True:
+            json = true;
+            break;
+        case BinaryCardFormat::ValueType::Int:
+        {
+            const uint64_t zigzag = ReadVarint(position);
+            json = static_cast<Json::LargestInt>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            break;
+        }
+        case BinaryCardFormat::ValueType::UInt:
+            json = static_cast<Json::LargestUInt>(ReadVarint(position));
+            break;
+        case BinaryCardFormat::ValueType::Real:
+        {
+            if (m_end - position < 8)
+            {
+                ThrowInvalid("truncated");
+            }
+            uint64_t bits = 0;
+            for (unsigned int i = 0; i < 8; i++)
+            {
+                bits |= static_cast<uint64_t>(position[i]) << (i * 8);
+            }
+            position += 8;
+            double number;
+            memcpy(&number, &bits, sizeof(number));
+            json = number;
+            break;
+        }
+        case BinaryCardFormat::ValueType::String:
+        {
+            const char* begin;
+            const char* end;
+            GetTableString(ReadVarint(position), begin, end);
+            json = Json::Value(begin, end);
+            break;
+        }
+        case BinaryCardFormat::ValueType::Array:
+        {
+            const uint8_t* arrayEnd = Skip(value);
+            const size_t count = GetCount(value, position);
+            json = Json::Value(Json::arrayValue);
+            if (count > 0)
+            {
+                json.resize(static_cast<Json::ArrayIndex>(count));
+            }
+            for (Json::ArrayIndex i = 0; i < count; i++)
+            {
+                position = ReadValue(position, json[i], depth + 1);
+            }
+            if (position != arrayEnd)
+            {
+                ThrowInvalid("bad array");
+            }
+            break;
+        }
+        case BinaryCardFormat::ValueType::Object:
+        {
+            const uint8_t* objectEnd = Skip(value);
+            json = Json::Value(Json::objectValue);
+            for (size_t count = GetCount(value, position); count > 0; count--)
+            {
+                const uint64_t name = ReadVarint(position);
+                if ((name & 1) == 0)
+                {
+                    // Schema key names live as long as the process, so the member doesn't need a copy of the name
+                    if ((name >> 1) >= c_schemaKeyCount || GetSchemaKeyNames()[name >> 1].empty())
+                    {
+                        ThrowInvalid("bad property name");
+                    }
+                    position = ReadValue(position, json[Json::StaticString(GetSchemaKeyNames()[name >> 1].c_str())], depth + 1);
+                }
+                else
+                {
+                    const char* begin;
+                    const char* end;
+                    GetTableString(name >> 1, begin, end);
+                    position = ReadValue(position, json[std::string(begin, end)], depth + 1);
+                }
+            }
+            if (position != objectEnd)
+            {
+                ThrowInvalid("bad object");
+            }
+            break;
+        }
+        }
+        return position;
+    }
+}
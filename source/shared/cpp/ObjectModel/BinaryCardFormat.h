@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "Enums.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // BinaryCardFormat is a compact encoding of serialized cards (see AdaptiveCard::SerializeBinary), for caches and for
+    // handing parsed cards from one process to another without writing and tokenizing JSON text.
+    //
+    // All numbers are little-endian, and nothing in the buffer needs to be aligned, so it can be read in place from a
+    // memory-mapped file. The buffer is a header, a string table and a value:
+    //
+    //   header   "ACBN", uint16 format version, uint16 AdaptiveCardSchemaKey count, uint32 string count,
+    //            uint32 size of the string data, uint32 size of the value
+    //   strings  uint32 offset of each string in the string data, then an end offset, then the string data (UTF-8,
+    //            unterminated). Every distinct string appears once, most used first, so most are referred to by a
+    //            single byte.
+    //   value    a tag byte followed by:
+    //              null, false, true: nothing
+    //              int: zigzag varint; uint: varint; real: 8 byte double
+    //              string: varint index into the string table
+    //              array: uint32 size of the elements in bytes, varint count, then the elements
+    //              object: uint32 size of the members in bytes, varint count, then each member's name and value. A
+    //                      name that is an AdaptiveCardSchemaKey is written as the key's value times two, any other
+    //                      name as its string's index times two plus one.
+    //
+    // The sizes let a reader skip over an element without decoding it. Buffers are only read by the build that wrote
+    // them or one with the same format version and schema keys; anything else is rejected.
+    class BinaryCardFormat
+    {
+    public:
+        static constexpr uint16_t Version = 1;
+
+        // The tag byte of each value
+        enum class ValueType : uint8_t
+        {
+            Null = 0,
+            False,
+            True,
+            Int,
+            UInt,
+            Real,
+            String,
+            Array,
+            Object
+        };
+
+        static std::vector<uint8_t> Write(const Json::Value& value);
+
+        // Throws an AdaptiveCardParseException with ErrorStatusCode::InvalidJson if the buffer isn't a valid encoding
+        static Json::Value Read(const uint8_t* data, size_t size);
+    };
+
+    // BinaryCardReader reads values in place, without copying the buffer, which must outlive the reader. Values are
+    // pointers to their tag bytes. The constructor checks the header and the root value's size; the rest is checked as
+    // it's read, and every function throws an AdaptiveCardParseException with ErrorStatusCode::InvalidJson if the
+    // value it reads isn't a valid encoding.
+    class BinaryCardReader
+    {
+    public:
+        BinaryCardReader(const uint8_t* data, size_t size);
+
+        const uint8_t* GetRoot() const { return m_root; }
+        BinaryCardFormat::ValueType GetType(const uint8_t* value) const;
+
+        // Returns the first byte after value
+        const uint8_t* Skip(const uint8_t* value) const;
+
+        // Points begin and end at a string value's characters, or returns false if value isn't a string
+        bool GetString(const uint8_t* value, const char*& begin, const char*& end) const;
+
+        // Returns the number of elements or members of an array or object and points first at the first of them, or
+        // returns zero for any other value. An array's elements are values; an object's members are names followed by
+        // values, read with ReadMemberName.
+        size_t GetCount(const uint8_t* value, const uint8_t*& first) const;
+
+        // Points begin and end at a member's name and returns its value
+        const uint8_t* ReadMemberName(const uint8_t* member, const char*& begin, const char*& end) const;
+
+        // Returns the value of an object's member, or nullptr if value isn't an object or has no such member
+        const uint8_t* FindMember(const uint8_t* object, AdaptiveCardSchemaKey key) const;
+
+        Json::Value ToJson(const uint8_t* value) const;
+
+    private:
+        uint64_t ReadVarint(const uint8_t*& position) const;
+        void GetTableString(uint64_t index, const char*& begin, const char*& end) const;
+        const uint8_t* ReadContainerEnd(const uint8_t*& position) const;
+        const uint8_t* ReadValue(const uint8_t* value, Json::Value& json, unsigned int depth) const;
+
+        const uint8_t* m_end;
+        const uint8_t* m_stringOffsets;
+        const char* m_stringData;
+        uint32_t m_stringDataSize;
+        size_t m_stringCount;
+        const uint8_t* m_root;
+    };
+}
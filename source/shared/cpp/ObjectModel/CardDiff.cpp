@@ -0,0 +1,836 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CardDiff.h"
+#include "ActionSet.h"
+#include "CardIterator.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "ParseUtil.h"
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    const size_t c_unmatched = static_cast<size_t>(-1);
+
+    // The name of the element's list of children, or an empty string if it has none
+    std::string GetChildCollection(const BaseCardElement& element)
+    {
+        switch (element.GetElementType())
+        {
+        case CardElementType::Container:
+        case CardElementType::Column:
+            return AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Items);
+        case CardElementType::ColumnSet:
+            return AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Columns);
+        case CardElementType::ActionSet:
+            return AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions);
+        case CardElementType::ImageSet:
+            return AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Images);
+        default:
+            return std::string();
+        }
+    }
+
+    bool IsActionCollection(const std::string& collection)
+    {
+        return collection == AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions);
+    }
+
+    // Calls f with the vector behind the named list of children of parent (or of the card when parent is null).
+    // Returns false if there's no such list.
+    template<typename Card, typename F>
+    bool VisitChildren(Card& card, BaseCardElement* parent, const std::string& collection, F&& f)
+    {
+        if (parent == nullptr)
+        {
+            if (collection == AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body))
+            {
+                f(card.GetBody());
+                return true;
+            }
+            if (IsActionCollection(collection))
+            {
+                f(card.GetActions());
+                return true;
+            }
+            return false;
+        }
+
+        if (collection.empty() || collection != GetChildCollection(*parent))
+        {
+            return false;
+        }
+
+        switch (parent->GetElementType())
+        {
+        case CardElementType::Container:
+            f(static_cast<Container*>(parent)->GetItems());
+            break;
+        case CardElementType::Column:
+            f(static_cast<Column*>(parent)->GetItems());
+            break;
+        case CardElementType::ColumnSet:
+            f(static_cast<ColumnSet*>(parent)->GetColumns());
+            break;
+        case CardElementType::ActionSet:
+            f(static_cast<ActionSet*>(parent)->GetActions());
+            break;
+        case CardElementType::ImageSet:
+            f(static_cast<ImageSet*>(parent)->GetImages());
+            break;
+        default:
+            return false;
+        }
+        return true;
+    }
+
+    template<typename Card>
+    std::vector<std::shared_ptr<BaseElement>> GetChildren(Card& card, BaseCardElement* parent, const std::string& collection)
+    {
+        std::vector<std::shared_ptr<BaseElement>> children;
+        VisitChildren(card, parent, collection, [&children](const auto& elements) { children.assign(elements.begin(), elements.end()); });
+        return children;
+    }
+
+    // Names of the members that differ between two serialized elements, leaving out the given list of children
+    std::vector<std::string> GetChangedProperties(const Json::Value& oldJson, const Json::Value& newJson, const std::string& childCollection)
+    {
+        const std::string isVisible = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsVisible);
+
+        std::vector<std::string> properties;
+        for (const auto& name : oldJson.getMemberNames())
+        {
+            if (name != childCollection && name != isVisible && (!newJson.isMember(name) || oldJson[name] != newJson[name]))
+            {
+                properties.push_back(name);
+            }
+        }
+        for (const auto& name : newJson.getMemberNames())
+        {
+            if (name != childCollection && name != isVisible && !oldJson.isMember(name))
+            {
+                properties.push_back(name);
+            }
+        }
+        return properties;
+    }
+
+    // Of the matched children, keeps those whose old positions increase along the longest run through the new list,
+    // so that the fewest children have to be removed and inserted again to put them in their new order.
+    void KeepLongestOrderedRun(std::vector<size_t>& oldIndexOfNew)
+    {
+        // tails[k] is the new index ending the best run of length k + 1 found so far
+        std::vector<size_t> tails;
+        std::vector<size_t> previous(oldIndexOfNew.size(), c_unmatched);
+        for (size_t i = 0; i < oldIndexOfNew.size(); i++)
+        {
+            if (oldIndexOfNew[i] == c_unmatched)
+            {
+                continue;
+            }
+
+            const auto tail = std::lower_bound(tails.begin(), tails.end(), oldIndexOfNew[i], [&oldIndexOfNew](size_t newIndex, size_t oldIndex) {
+                return oldIndexOfNew[newIndex] < oldIndex;
+            });
+            if (tail != tails.begin())
+            {
+                previous[i] = *(tail - 1);
+            }
+            if (tail == tails.end())
+            {
+                tails.push_back(i);
+            }
+            else
+            {
+                *tail = i;
+            }
+        }
+
+        std::vector<bool> keep(oldIndexOfNew.size(), false);
+        for (size_t i = tails.empty() ? c_unmatched : tails.back(); i != c_unmatched; i = previous[i])
+        {
+            keep[i] = true;
+        }
+        for (size_t i = 0; i < oldIndexOfNew.size(); i++)
+        {
+            if (!keep[i])
+            {
+                oldIndexOfNew[i] = c_unmatched;
+            }
+        }
+    }
+
+    class CardDiffer
+    {
+    public:
+        CardDiffer(const AdaptiveCard& oldCard, const AdaptiveCard& newCard, std::vector<CardPatch>& patches) :
+            m_oldCard(oldCard), m_newCard(newCard), m_patches(patches)
+        {
+        }
+
+        void Diff()
+        {
+            // Both cards are serialized once up front; each element's JSON is then found at the same position as the
+            // element itself
+            const Json::Value oldJson = m_oldCard.SerializeToJsonValue();
+            const Json::Value newJson = m_newCard.SerializeToJsonValue();
+
+            const std::string body = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body);
+            const std::string actions = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions);
+
+            auto properties = GetChangedProperties(oldJson, newJson, body);
+            properties.erase(std::remove(properties.begin(), properties.end(), actions), properties.end());
+            if (!properties.empty())
+            {
+                m_patches.push_back({CardPatchType::Update, nullptr, std::string(), 0, nullptr, nullptr, std::move(properties), true});
+            }
+
+            DiffChildren(nullptr, nullptr, body, oldJson, newJson);
+            DiffChildren(nullptr, nullptr, actions, oldJson, newJson);
+        }
+
+    private:
+        void DiffChildren(const std::shared_ptr<BaseCardElement>& oldParent,
+                          const std::shared_ptr<BaseCardElement>& newParent,
+                          const std::string& collection,
+                          const Json::Value& oldParentJson,
+                          const Json::Value& newParentJson)
+        {
+            const auto oldChildren = GetChildren(m_oldCard, oldParent.get(), collection);
+            const auto newChildren = GetChildren(m_newCard, newParent.get(), collection);
+            const Json::Value& oldJson = oldParentJson[collection];
+            const Json::Value& newJson = newParentJson[collection];
+
+            // Match children by id first...
+            std::unordered_map<std::string, std::vector<size_t>> oldIndexesById;
+            for (size_t i = oldChildren.size(); i-- > 0;)
+            {
+                const std::string id = oldChildren[i]->GetId();
+                if (!id.empty())
+                {
+                    oldIndexesById[id].push_back(i);
+                }
+            }
+
+            std::vector<size_t> oldIndexOfNew(newChildren.size(), c_unmatched);
+            std::vector<bool> oldIsMatched(oldChildren.size(), false);
+            for (size_t i = 0; i < newChildren.size(); i++)
+            {
+                const auto oldIndexes = oldIndexesById.find(newChildren[i]->GetId());
+                if (oldIndexes != oldIndexesById.end() && !oldIndexes->second.empty())
+                {
+                    oldIndexOfNew[i] = oldIndexes->second.back();
+                    oldIndexes->second.pop_back();
+                    oldIsMatched[oldIndexOfNew[i]] = true;
+                }
+            }
+
+            // ...then children without an id by position
+            for (size_t i = 0; i < newChildren.size() && i < oldChildren.size(); i++)
+            {
+                if (oldIndexOfNew[i] == c_unmatched && !oldIsMatched[i] && newChildren[i]->GetId().empty() &&
+                    oldChildren[i]->GetId().empty())
+                {
+                    oldIndexOfNew[i] = i;
+                    oldIsMatched[i] = true;
+                }
+            }
+
+            // A child that changed type is a different element
+            for (size_t i = 0; i < newChildren.size(); i++)
+            {
+                if (oldIndexOfNew[i] != c_unmatched &&
+                    oldChildren[oldIndexOfNew[i]]->GetElementTypeStringRef() != newChildren[i]->GetElementTypeStringRef())
+                {
+                    oldIndexOfNew[i] = c_unmatched;
+                }
+            }
+
+            KeepLongestOrderedRun(oldIndexOfNew);
+            std::fill(oldIsMatched.begin(), oldIsMatched.end(), false);
+            for (const auto oldIndex : oldIndexOfNew)
+            {
+                if (oldIndex != c_unmatched)
+                {
+                    oldIsMatched[oldIndex] = true;
+                }
+            }
+
+            for (size_t i = oldChildren.size(); i-- > 0;)
+            {
+                if (!oldIsMatched[i])
+                {
+                    m_patches.push_back({CardPatchType::Remove, oldParent, collection, i, oldChildren[i], nullptr, {}, true});
+                }
+            }
+            for (size_t i = 0; i < newChildren.size(); i++)
+            {
+                if (oldIndexOfNew[i] == c_unmatched)
+                {
+                    m_patches.push_back({CardPatchType::Insert, oldParent, collection, i, nullptr, newChildren[i], {}, true});
+                }
+            }
+
+            const bool isActions = IsActionCollection(collection);
+            for (size_t i = 0; i < newChildren.size(); i++)
+            {
+                const size_t oldIndex = oldIndexOfNew[i];
+                if (oldIndex == c_unmatched)
+                {
+                    continue;
+                }
+
+                const Json::Value& oldChildJson = oldJson[static_cast<Json::ArrayIndex>(oldIndex)];
+                const Json::Value& newChildJson = newJson[static_cast<Json::ArrayIndex>(i)];
+                if (isActions)
+                {
+                    auto properties = GetChangedProperties(oldChildJson, newChildJson, std::string());
+                    if (!properties.empty())
+                    {
+                        m_patches.push_back({CardPatchType::Update, oldParent, collection, i, oldChildren[oldIndex], newChildren[i], std::move(properties), true});
+                    }
+                }
+                else
+                {
+                    DiffElement(oldParent,
+                                collection,
+                                i,
+                                std::static_pointer_cast<BaseCardElement>(oldChildren[oldIndex]),
+                                std::static_pointer_cast<BaseCardElement>(newChildren[i]),
+                                oldChildJson,
+                                newChildJson);
+                }
+            }
+        }
+
+        void DiffElement(const std::shared_ptr<BaseCardElement>& parent,
+                         const std::string& collection,
+                         size_t index,
+                         const std::shared_ptr<BaseCardElement>& oldElement,
+                         const std::shared_ptr<BaseCardElement>& newElement,
+                         const Json::Value& oldJson,
+                         const Json::Value& newJson)
+        {
+            const std::string childCollection = GetChildCollection(*oldElement);
+
+            auto properties = GetChangedProperties(oldJson, newJson, childCollection);
+            if (!properties.empty())
+            {
+                m_patches.push_back({CardPatchType::Update, parent, collection, index, oldElement, newElement, std::move(properties), true});
+            }
+
+            if (oldElement->GetIsVisible() != newElement->GetIsVisible())
+            {
+                m_patches.push_back({CardPatchType::SetVisibility, parent, collection, index, oldElement, newElement, {}, newElement->GetIsVisible()});
+            }
+
+            if (!childCollection.empty())
+            {
+                DiffChildren(oldElement, newElement, childCollection, oldJson, newJson);
+            }
+        }
+
+        const AdaptiveCard& m_oldCard;
+        const AdaptiveCard& m_newCard;
+        std::vector<CardPatch>& m_patches;
+    };
+
+    // An element that holds the one being changed, and where it is in its own parent's list of children
+    struct Ancestor
+    {
+        std::shared_ptr<BaseCardElement> element;
+        size_t index;
+        size_t count;
+    };
+
+    struct ElementLocation
+    {
+        std::shared_ptr<BaseCardElement> parent;
+        std::string collection;
+        size_t index;
+        std::shared_ptr<BaseElement> element;
+        // From the card's body down to parent
+        std::vector<Ancestor> ancestors;
+        size_t count;
+    };
+
+    bool FindElement(AdaptiveCard& card,
+                     const std::shared_ptr<BaseCardElement>& parent,
+                     const std::string& collection,
+                     const std::string& id,
+                     std::vector<Ancestor>& ancestors,
+                     ElementLocation& location)
+    {
+        const auto children = GetChildren(card, parent.get(), collection);
+        const bool isActions = IsActionCollection(collection);
+        for (size_t i = 0; i < children.size(); i++)
+        {
+            if (children[i]->GetId() == id)
+            {
+                location = {parent, collection, i, children[i], ancestors, children.size()};
+                return true;
+            }
+
+            if (!isActions)
+            {
+                auto element = std::static_pointer_cast<BaseCardElement>(children[i]);
+                const std::string childCollection = GetChildCollection(*element);
+                ancestors.push_back({element, i, children.size()});
+                if (!childCollection.empty() && FindElement(card, element, childCollection, id, ancestors, location))
+                {
+                    return true;
+                }
+                ancestors.pop_back();
+            }
+        }
+        return false;
+    }
+
+    ElementLocation FindElement(AdaptiveCard& card, const std::string& id)
+    {
+        ElementLocation location;
+        std::vector<Ancestor> ancestors;
+        if (!id.empty() && (FindElement(card, nullptr, AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body), id, ancestors, location) ||
+                            FindElement(card, nullptr, AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Actions), id, ancestors, location)))
+        {
+            return location;
+        }
+        throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "No element with the id \"" + id + "\" to change");
+    }
+
+    // The directions the item at index in a list of count items may bleed in, as ParseUtil::GetElementCollection
+    // works them out
+    ContainerBleedDirection GetItemBleedDirection(ContainerBleedDirection direction, bool isTopToBottom, size_t index, size_t count)
+    {
+        if (index != 0)
+        {
+            direction &= isTopToBottom ? ~ContainerBleedDirection::BleedUp : ~ContainerBleedDirection::BleedLeft;
+        }
+        if (index + 1 < count)
+        {
+            direction &= isTopToBottom ? ~ContainerBleedDirection::BleedDown : ~ContainerBleedDirection::BleedRight;
+        }
+        return direction;
+    }
+
+    // Puts context in the state parsing the whole card would be in as it got to the index'th of count children in the
+    // named list of the last ancestor (or of the card), from the styles, padding and fallback of the ancestors
+    void RestoreParseState(ParseContext& context,
+                           const AdaptiveCard& card,
+                           const std::vector<Ancestor>& ancestors,
+                           const std::string& collection,
+                           size_t index,
+                           size_t count)
+    {
+        ContainerStyle style = (card.GetStyle() != ContainerStyle::None) ? card.GetStyle() : ContainerStyle::Default;
+        InternalId paddingParentInternalId;
+        ContainerBleedDirection bleedDirection = ContainerBleedDirection::BleedAll;
+        bool canFallbackToAncestor = false;
+        bool isTopToBottom = true;
+        for (const auto& ancestor : ancestors)
+        {
+            bleedDirection = GetItemBleedDirection(bleedDirection, isTopToBottom, ancestor.index, ancestor.count);
+
+            const BaseCardElement& element = *ancestor.element;
+            isTopToBottom = element.GetElementType() != CardElementType::ColumnSet;
+            if (element.GetElementType() == CardElementType::Container || element.GetElementType() == CardElementType::Column ||
+                element.GetElementType() == CardElementType::ColumnSet)
+            {
+                const auto& collectionElement = static_cast<const CollectionTypeElement&>(element);
+                canFallbackToAncestor = canFallbackToAncestor || (collectionElement.GetFallbackType() != FallbackType::None);
+                if (collectionElement.GetStyle() != ContainerStyle::None)
+                {
+                    style = collectionElement.GetStyle();
+                }
+                if (collectionElement.GetPadding())
+                {
+                    paddingParentInternalId = collectionElement.GetInternalId();
+                    bleedDirection = ContainerBleedDirection::BleedAll;
+                }
+            }
+        }
+
+        // Actions are parsed one by one rather than as a collection, and take the bleed of their parent as it is
+        if (!IsActionCollection(collection))
+        {
+            bleedDirection = GetItemBleedDirection(bleedDirection, isTopToBottom, index, count);
+        }
+        context.RestoreElementState(style, paddingParentInternalId, bleedDirection, canFallbackToAncestor);
+    }
+
+    // Throws if an element parsed with context has the id of one already in the card, other than the element being
+    // replaced and what's inside it
+    void CheckNewIds(const AdaptiveCard& card, ParseContext& context, const BaseElement* replaced)
+    {
+        std::unordered_map<std::string, std::vector<std::weak_ptr<BaseElement>>> newIds;
+        context.IndexIdentifiedElements(0, newIds);
+        if (newIds.empty())
+        {
+            return;
+        }
+
+        CardIteratorOptions options;
+        options.includeFallbackContent = true;
+        options.includeSelectActions = true;
+        CardIterator iterator(card, options);
+        while (iterator.Next())
+        {
+            const CardNode& node = iterator.GetNode();
+            const BaseElement* element = node.GetElement();
+            if (element == nullptr)
+            {
+                element = node.GetAction();
+            }
+
+            if (element == nullptr)
+            {
+                continue;
+            }
+            if (element == replaced)
+            {
+                iterator.SkipChildren();
+            }
+            else if (newIds.count(element->GetId()) != 0)
+            {
+                throw AdaptiveCardParseException(ErrorStatusCode::IdCollision, "Collision detected for id '" + element->GetId() + "'");
+            }
+        }
+    }
+
+    // Parses a single element for the given kind of list
+    template<typename T> std::shared_ptr<T> ParseElement(ParseContext& context, Json::Value& json);
+
+    template<> std::shared_ptr<BaseCardElement> ParseElement<BaseCardElement>(ParseContext& context, Json::Value& json)
+    {
+        std::shared_ptr<BaseElement> element;
+        BaseCardElement::ParseJsonObject(context, json, element);
+        return std::static_pointer_cast<BaseCardElement>(element);
+    }
+
+    template<> std::shared_ptr<BaseActionElement> ParseElement<BaseActionElement>(ParseContext& context, Json::Value& json)
+    {
+        auto action = ParseUtil::GetActionFromJsonValue(context, json);
+        if (action == nullptr)
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue,
+                                             "Unable to parse action of type " + ParseUtil::GetTypeAsString(json));
+        }
+        return action;
+    }
+
+    // Columns and Images may leave out their type, as in a ColumnSet or ImageSet
+    template<typename T> std::shared_ptr<T> ParseElementOfType(ParseContext& context, Json::Value& json, CardElementType type)
+    {
+        const std::string typeString = ParseUtil::GetString(json, AdaptiveCardSchemaKey::Type, CardElementTypeToString(type), false);
+        if (typeString != CardElementTypeToString(type))
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "Unable to parse element of type " + typeString);
+        }
+        json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)] = typeString;
+
+        return std::static_pointer_cast<T>(ParseElement<BaseCardElement>(context, json));
+    }
+
+    template<> std::shared_ptr<Column> ParseElement<Column>(ParseContext& context, Json::Value& json)
+    {
+        return ParseElementOfType<Column>(context, json, CardElementType::Column);
+    }
+
+    template<> std::shared_ptr<Image> ParseElement<Image>(ParseContext& context, Json::Value& json)
+    {
+        return ParseElementOfType<Image>(context, json, CardElementType::Image);
+    }
+
+    // Holds the children of an element while it's replaced
+    struct DetachedChildren
+    {
+        std::vector<std::shared_ptr<BaseCardElement>> items;
+        std::vector<std::shared_ptr<Column>> columns;
+        std::vector<std::shared_ptr<BaseActionElement>> actions;
+        std::vector<std::shared_ptr<Image>> images;
+    };
+
+    void SwapChildren(BaseCardElement& element, DetachedChildren& children)
+    {
+        switch (element.GetElementType())
+        {
+        case CardElementType::Container:
+            static_cast<Container&>(element).GetItems().swap(children.items);
+            break;
+        case CardElementType::Column:
+            static_cast<Column&>(element).GetItems().swap(children.items);
+            break;
+        case CardElementType::ColumnSet:
+            static_cast<ColumnSet&>(element).GetColumns().swap(children.columns);
+            break;
+        case CardElementType::ActionSet:
+            static_cast<ActionSet&>(element).GetActions().swap(children.actions);
+            break;
+        case CardElementType::ImageSet:
+            static_cast<ImageSet&>(element).GetImages().swap(children.images);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void SetProperty(Json::Value& json, const std::string& property, const Json::Value& value)
+    {
+        if (value.isNull())
+        {
+            json.removeMember(property);
+        }
+        else
+        {
+            json[property] = value;
+        }
+    }
+
+    std::shared_ptr<BaseActionElement> ReplaceProperty(const AdaptiveCard& card,
+                                                       ParseContext& context,
+                                                       const std::shared_ptr<BaseActionElement>& action,
+                                                       const std::string& property,
+                                                       const Json::Value& value)
+    {
+        Json::Value json = action->SerializeToJsonValue();
+        SetProperty(json, property, value);
+        auto updated = ParseElement<BaseActionElement>(context, json);
+        CheckNewIds(card, context, action.get());
+        return updated;
+    }
+
+    // Parses the element again with the property changed. Unless the property is the element's list of children, the
+    // children are moved over to the new element rather than being serialized and parsed again.
+    template<typename T>
+    std::shared_ptr<T> ReplaceProperty(const AdaptiveCard& card,
+                                       ParseContext& context,
+                                       const std::shared_ptr<T>& element,
+                                       const std::string& property,
+                                       const Json::Value& value)
+    {
+        const bool keepChildren = property != GetChildCollection(*element);
+
+        // An ImageSet has to have images to be parsed, so its images are swapped for the new ones afterwards instead
+        const bool detachChildren = keepChildren && element->GetElementType() != CardElementType::ImageSet;
+
+        DetachedChildren children;
+        if (detachChildren)
+        {
+            SwapChildren(*element, children);
+        }
+
+        std::shared_ptr<T> updated;
+        try
+        {
+            Json::Value json = element->SerializeToJsonValue();
+            SetProperty(json, property, value);
+            updated = ParseElement<T>(context, json);
+            CheckNewIds(card, context, element.get());
+        }
+        catch (...)
+        {
+            if (detachChildren)
+            {
+                SwapChildren(*element, children);
+            }
+            throw;
+        }
+
+        if (keepChildren)
+        {
+            if (!detachChildren)
+            {
+                SwapChildren(*element, children);
+            }
+            SwapChildren(*updated, children);
+        }
+        return updated;
+    }
+
+    std::string GetOperationString(const Json::Value& operation, const char* name, bool isRequired)
+    {
+        const Json::Value& value = operation[name];
+        if (value.isString())
+        {
+            return value.asString();
+        }
+        if (isRequired || !value.isNull())
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::RequiredPropertyMissing,
+                                             std::string("Expected a string for \"") + name + "\" in a card delta operation");
+        }
+        return std::string();
+    }
+
+    CardPatch ApplyReplace(AdaptiveCard& card, const Json::Value& operation, ParseContext& context)
+    {
+        const auto location = FindElement(card, GetOperationString(operation, "id", true));
+        const std::string property = GetOperationString(operation, "property", true);
+        const Json::Value& value = operation[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value)];
+        const bool isAction = IsActionCollection(location.collection);
+
+        if (property == AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type) ||
+            property == AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Id))
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue,
+                                             "An element's " + property + " can't be replaced; remove it and add a new element instead");
+        }
+
+        if (property == AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsVisible) && !isAction)
+        {
+            if (!value.isBool())
+            {
+                throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "Expected a boolean for isVisible");
+            }
+            std::static_pointer_cast<BaseCardElement>(location.element)->SetIsVisible(value.asBool());
+            return {CardPatchType::SetVisibility, location.parent, location.collection, location.index, location.element, location.element, {}, value.asBool()};
+        }
+
+        RestoreParseState(context, card, location.ancestors, location.collection, location.index, location.count);
+        CardPatch patch{CardPatchType::Update, location.parent, location.collection, location.index, location.element, nullptr, {property}, true};
+        VisitChildren(card, location.parent.get(), location.collection, [&](auto& elements) {
+            auto& slot = elements[location.index];
+            slot = ReplaceProperty(card, context, slot, property, value);
+            patch.newElement = slot;
+        });
+        return patch;
+    }
+
+    CardPatch ApplyRemove(AdaptiveCard& card, const Json::Value& operation)
+    {
+        const auto location = FindElement(card, GetOperationString(operation, "id", true));
+        VisitChildren(card, location.parent.get(), location.collection, [&location](auto& elements) {
+            elements.erase(elements.begin() + location.index);
+        });
+        return {CardPatchType::Remove, location.parent, location.collection, location.index, location.element, nullptr, {}, true};
+    }
+
+    CardPatch ApplyAdd(AdaptiveCard& card, const Json::Value& operation, ParseContext& context)
+    {
+        std::shared_ptr<BaseCardElement> parent;
+        std::vector<Ancestor> ancestors;
+        const std::string parentId = GetOperationString(operation, "parent", false);
+        if (!parentId.empty())
+        {
+            auto location = FindElement(card, parentId);
+            if (IsActionCollection(location.collection))
+            {
+                throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "Elements can't be added to the action " + parentId);
+            }
+            parent = std::static_pointer_cast<BaseCardElement>(location.element);
+            ancestors = std::move(location.ancestors);
+            ancestors.push_back({parent, location.index, location.count});
+        }
+
+        std::string collection = GetOperationString(operation, "collection", false);
+        if (collection.empty())
+        {
+            collection = parent ? GetChildCollection(*parent) : AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Body);
+        }
+
+        const Json::Value& index = operation["index"];
+        if (!index.isNull() && !index.isUInt())
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "Expected a non-negative integer for index");
+        }
+
+        CardPatch patch{CardPatchType::Insert, parent, collection, 0, nullptr, nullptr, {}, true};
+        const bool found = VisitChildren(card, parent.get(), collection, [&](auto& elements) {
+            patch.index = index.isNull() ? elements.size() : index.asUInt();
+            if (patch.index > elements.size())
+            {
+                throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue,
+                                                 "Index " + std::to_string(patch.index) + " is past the end of " + collection);
+            }
+
+            RestoreParseState(context, card, ancestors, collection, patch.index, elements.size() + 1);
+
+            typedef typename std::decay<decltype(elements)>::type::value_type::element_type ElementType;
+            Json::Value json = operation[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value)];
+            auto element = ParseElement<ElementType>(context, json);
+            CheckNewIds(card, context, nullptr);
+            elements.insert(elements.begin() + patch.index, element);
+            patch.newElement = element;
+        });
+
+        if (!found)
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue,
+                                             "There's no list of elements named \"" + collection + "\" to add to");
+        }
+        return patch;
+    }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    std::vector<CardPatch> CardDiff::Diff(const AdaptiveCard& oldCard, const AdaptiveCard& newCard)
+    {
+        std::vector<CardPatch> patches;
+        CardDiffer(oldCard, newCard, patches).Diff();
+        return patches;
+    }
+
+    std::vector<CardPatch> CardDiff::ApplyDelta(AdaptiveCard& card, const Json::Value& delta)
+    {
+        ParseContext context;
+        return ApplyDelta(card, delta, context);
+    }
+
+    std::vector<CardPatch> CardDiff::ApplyDelta(AdaptiveCard& card, const Json::Value& delta, ParseContext& context)
+    {
+        if (!delta.isArray())
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidJson, "Expected a card delta to be an array of operations");
+        }
+
+        std::vector<CardPatch> patches;
+        for (const auto& operation : delta)
+        {
+            if (!operation.isObject())
+            {
+                throw AdaptiveCardParseException(ErrorStatusCode::InvalidJson, "Expected a card delta operation to be an object");
+            }
+
+            // New content is parsed on its own, so its ids can't collide with those the context saw in the rest of the card
+            ParseContext operationContext(context.elementParserRegistration, context.actionParserRegistration);
+            operationContext.SetLanguage(card.GetLanguageRef().empty() ? context.GetLanguageRef() : card.GetLanguageRef());
+            operationContext.SetCompactChoiceThreshold(context.GetCompactChoiceThreshold());
+
+            const std::string op = GetOperationString(operation, "op", true);
+            if (op == "replace")
+            {
+                patches.push_back(ApplyReplace(card, operation, operationContext));
+            }
+            else if (op == "remove")
+            {
+                patches.push_back(ApplyRemove(card, operation));
+            }
+            else if (op == "add")
+            {
+                patches.push_back(ApplyAdd(card, operation, operationContext));
+            }
+            else
+            {
+                throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "Unknown card delta operation \"" + op + "\"");
+            }
+
+            context.warnings.insert(context.warnings.end(), operationContext.warnings.begin(), operationContext.warnings.end());
+            if (patches.back().type != CardPatchType::SetVisibility)
+            {
+                card.InvalidateElementIndex();
+            }
+        }
+        return patches;
+    }
+
+    std::vector<CardPatch> CardDiff::ApplyDeltaFromString(AdaptiveCard& card, const std::string& delta)
+    {
+        return ApplyDelta(card, ParseUtil::GetJsonValueFromString(delta));
+    }
+}
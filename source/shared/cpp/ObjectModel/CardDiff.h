@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "ParseContext.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    enum class CardPatchType
+    {
+        Update = 0,
+        Insert,
+        Remove,
+        SetVisibility
+    };
+
+    // One change to a card, described against the card being changed.
+    //
+    // parent and collection name the list of children that an Insert or Remove applies to: parent is the Container,
+    // Column, ColumnSet, ActionSet or ImageSet that holds the list, or nullptr for the card itself, and collection is
+    // the list's property name ("body", "actions", "items", "columns" or "images"). index is where the element goes
+    // (Insert) or where it was (Remove), counting the patches before this one as already applied.
+    //
+    // oldElement is the element in the card being changed (Update, Remove, SetVisibility) and newElement is the element
+    // taking its place (Update) or being added (Insert). An Update with no elements is a change to the card's own
+    // properties. properties lists the JSON properties an Update changes; they can include nested content such as
+    // "selectAction", "fallback", "inlines", "choices" or the "card" of an Action.ShowCard.
+    struct CardPatch
+    {
+        CardPatchType type;
+        std::shared_ptr<BaseElement> parent;
+        std::string collection;
+        size_t index;
+        std::shared_ptr<BaseElement> oldElement;
+        std::shared_ptr<BaseElement> newElement;
+        std::vector<std::string> properties;
+        bool isVisible;
+    };
+
+    // CardDiff lets a host update a card it has already rendered rather than rendering a new version of it from scratch.
+    class CardDiff
+    {
+    public:
+        // Returns the changes that turn oldCard into newCard. Children are matched by id, and then children without an
+        // id by position, so an element keeps its identity while its properties change. Matched elements of a different
+        // type, or that have moved relative to the other children, are removed and inserted again. A change to
+        // isVisible alone is a SetVisibility patch; children are compared element by element, everything else an
+        // element holds (including its fallback content and the cards of ShowCard actions) is compared as a property.
+        // Removes come before inserts within each list, and a list's patches come before those of its children.
+        static std::vector<CardPatch> Diff(const AdaptiveCard& oldCard, const AdaptiveCard& newCard);
+
+        // Applies a delta to the card in place and returns what was changed, in the same form as Diff. The delta is a
+        // JSON array of operations, applied in order:
+        //
+        //   { "op": "replace", "id": "votes", "property": "text", "value": "12 votes" }
+        //   { "op": "remove", "id": "banner" }
+        //   { "op": "add", "parent": "options", "collection": "items", "index": 0, "value": { "type": "TextBlock", ... } }
+        //
+        // "replace" sets one property of the element with the given id; a null value removes it. Only that element is
+        // parsed again, without its children, which keep their identity. Setting "isVisible" changes the element
+        // itself rather than replacing it. "add" parses just the new element; "parent" is the id of the element to add
+        // to (the card when omitted), "collection" defaults to the parent's only list of children (or the card's
+        // body) and "index" to the end of the list. Elements are found anywhere in the card except fallback content
+        // and the cards of ShowCard actions. New content is parsed with the container style, padding and bleed it
+        // would get from its ancestors in the card, and with a context of its own that takes the registrations,
+        // language and compact choice threshold of the given one (not its arena).
+        //
+        // Throws an AdaptiveCardParseException for an operation that can't be applied, including one whose new content
+        // has an id already used elsewhere in the card (IdCollision); operations before it stay applied. Warnings from
+        // parsing new content are added to the context's warnings.
+        static std::vector<CardPatch> ApplyDelta(AdaptiveCard& card, const Json::Value& delta);
+        static std::vector<CardPatch> ApplyDelta(AdaptiveCard& card, const Json::Value& delta, ParseContext& context);
+        static std::vector<CardPatch> ApplyDeltaFromString(AdaptiveCard& card, const std::string& delta);
+    };
+}
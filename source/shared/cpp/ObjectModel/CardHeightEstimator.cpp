@@ -0,0 +1,611 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CardHeightEstimator.h"
+#include <cmath>
+#include "ActionSet.h"
+#include "ChoiceInput.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "Fact.h"
+#include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "RichTextBlock.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "ToggleInput.h"
+#include "ToggleVisibilityAction.h"
+
+namespace AdaptiveSharedNamespace
+{
+    namespace
+    {
+        // Inputs and buttons are drawn as a line of default text plus the platform's chrome.
+        constexpr unsigned int c_controlPadding = 8;
+        constexpr unsigned int c_multilineInputLines = 3;
+
+        // Representative en-US renderings of the DATE()/TIME() formats; good enough for line counting.
+        const char* GetFormattedTokenSample(const DateTimePreparsedToken& token)
+        {
+            switch (token.GetFormat())
+            {
+            case DateTimePreparsedTokenFormat::Time:
+                return "12:00 AM";
+            case DateTimePreparsedTokenFormat::DateCompact:
+                return "12/31/2019";
+            case DateTimePreparsedTokenFormat::DateShort:
+                return "Tue, Dec 31, 2019";
+            case DateTimePreparsedTokenFormat::DateLong:
+                return "Tuesday, December 31, 2019";
+            case DateTimePreparsedTokenFormat::RegularString:
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    CardHeightEstimator::CardHeightEstimator(std::shared_ptr<AdaptiveCard> card, const HostConfig& hostConfig, const FontMetricsTable& fontMetrics) :
+        CardHeightEstimator(card,
+                            hostConfig,
+                            std::make_shared<CachingTextMeasurer>(std::make_shared<AdvanceTableTextMeasurer>(hostConfig, fontMetrics)))
+    {
+    }
+
+    CardHeightEstimator::CardHeightEstimator(std::shared_ptr<AdaptiveCard> card,
+                                             const HostConfig& hostConfig,
+                                             std::shared_ptr<TextMeasurer> textMeasurer) :
+        m_card(card), m_textMeasurer(textMeasurer), m_spacing(hostConfig.GetSpacing()), m_separator(hostConfig.GetSeparator()),
+        m_imageSizes(hostConfig.GetImageSizes()), m_image(hostConfig.GetImage()), m_imageSet(hostConfig.GetImageSet()),
+        m_factSet(hostConfig.GetFactSet()), m_actions(hostConfig.GetActions()),
+        m_supportsInteractivity(hostConfig.GetSupportsInteractivity())
+    {
+        IndexElements(m_card->GetBody(), nullptr);
+    }
+
+    unsigned int CardHeightEstimator::EstimateHeight(unsigned int width)
+    {
+        const auto cached = m_cardHeights.find(width);
+        if (cached != m_cardHeights.end())
+        {
+            return cached->second;
+        }
+
+        // cards are always padded
+        const unsigned int padding = m_spacing.paddingSpacing;
+        const unsigned int contentWidth = (width > 2 * padding) ? width - 2 * padding : 0;
+
+        unsigned int height = EstimateStack(m_card->GetBody(), contentWidth);
+
+        const unsigned int actionsHeight = EstimateActions(m_card->GetActions(), contentWidth);
+        if (actionsHeight)
+        {
+            height += (height ? GetSpacing(m_actions.spacing) : 0) + actionsHeight;
+        }
+
+        height = std::max(height + 2 * padding, m_card->GetMinHeight());
+
+        m_cardHeights.emplace(width, height);
+        return height;
+    }
+
+    void CardHeightEstimator::ApplyToggleVisibility(const ToggleVisibilityAction& action)
+    {
+        for (const auto& target : action.GetTargetElements())
+        {
+            const auto& targetId = target->GetElementIdRef();
+            const auto range = m_elementsById.equal_range(targetId);
+            for (auto entry = range.first; entry != range.second; ++entry)
+            {
+                BaseCardElement* element = entry->second;
+                const IsVisible isVisible = target->GetIsVisible();
+                const bool newValue = (isVisible == IsVisibleToggle) ? !element->GetIsVisible() : (isVisible == IsVisibleTrue);
+                if (newValue != element->GetIsVisible())
+                {
+                    element->SetIsVisible(newValue);
+                    InvalidateAncestors(element);
+                }
+            }
+        }
+    }
+
+    void CardHeightEstimator::InvalidateElement(const std::string& elementId)
+    {
+        const auto range = m_elementsById.equal_range(elementId);
+        for (auto entry = range.first; entry != range.second; ++entry)
+        {
+            // the element's own subtree is unaffected by its visibility, but it may have been edited otherwise
+            m_elementHeights.erase(entry->second);
+            InvalidateAncestors(entry->second);
+        }
+    }
+
+    void CardHeightEstimator::ClearCache()
+    {
+        m_elementHeights.clear();
+        m_cardHeights.clear();
+    }
+
+    void CardHeightEstimator::InvalidateAncestors(const BaseCardElement* element)
+    {
+        for (auto parent = m_parents.find(element); parent != m_parents.end() && parent->second != nullptr;
+             parent = m_parents.find(parent->second))
+        {
+            m_elementHeights.erase(parent->second);
+        }
+        m_cardHeights.clear();
+    }
+
+    void CardHeightEstimator::IndexElements(const std::vector<std::shared_ptr<BaseCardElement>>& items, const BaseCardElement* parent)
+    {
+        for (const auto& item : items)
+        {
+            IndexElement(item, parent);
+        }
+    }
+
+    void CardHeightEstimator::IndexElement(const std::shared_ptr<BaseCardElement>& item, const BaseCardElement* parent)
+    {
+        m_parents[item.get()] = parent;
+
+        const auto id = item->GetId();
+        if (!id.empty())
+        {
+            m_elementsById.emplace(id, item.get());
+        }
+
+        switch (item->GetElementType())
+        {
+        case CardElementType::Container:
+            IndexElements(std::static_pointer_cast<Container>(item)->GetItems(), item.get());
+            break;
+        case CardElementType::Column:
+            IndexElements(std::static_pointer_cast<Column>(item)->GetItems(), item.get());
+            break;
+        case CardElementType::ColumnSet:
+            for (const auto& column : std::static_pointer_cast<ColumnSet>(item)->GetColumns())
+            {
+                IndexElement(column, item.get());
+            }
+            break;
+        default:
+            break;
+        }
+
+        // fallback content is estimated in place of the element it belongs to, so the element is its parent
+        if (item->GetFallbackType() == FallbackType::Content)
+        {
+            const auto fallback = std::dynamic_pointer_cast<BaseCardElement>(item->GetFallbackContent());
+            if (fallback)
+            {
+                IndexElement(fallback, item.get());
+            }
+        }
+    }
+
+    unsigned int CardHeightEstimator::EstimateElement(const BaseCardElement& element, unsigned int width)
+    {
+        auto& heights = m_elementHeights[&element];
+        const auto cached = heights.find(width);
+        if (cached != heights.end())
+        {
+            return cached->second;
+        }
+
+        const unsigned int height = EstimateElementUncached(element, width);
+
+        // EstimateElementUncached may have rehashed m_elementHeights; look the entry up again
+        m_elementHeights[&element].emplace(width, height);
+        return height;
+    }
+
+    unsigned int CardHeightEstimator::EstimateElementUncached(const BaseCardElement& element, unsigned int width)
+    {
+        switch (element.GetElementType())
+        {
+        case CardElementType::TextBlock:
+        {
+            const auto& textBlock = static_cast<const TextBlock&>(element);
+            return EstimateTextHeight(textBlock.GetTextRef(),
+                                      textBlock.GetFontType(),
+                                      textBlock.GetTextSize(),
+                                      textBlock.GetTextWeight(),
+                                      width,
+                                      textBlock.GetWrap(),
+                                      textBlock.GetMaxLines());
+        }
+        case CardElementType::RichTextBlock:
+        {
+            // RichTextBlock is measured as a single paragraph using the metrics of its largest run
+            const auto& richTextBlock = static_cast<const RichTextBlock&>(element);
+            std::string text;
+            FontType fontType = FontType::Default;
+            TextSize size = TextSize::Small;
+            TextWeight weight = TextWeight::Default;
+            for (const auto& inlineElement : richTextBlock.GetInlines())
+            {
+                if (inlineElement->GetInlineType() == InlineElementType::TextRun)
+                {
+                    const auto& textRun = static_cast<const TextRun&>(*inlineElement);
+                    text += textRun.GetTextRef();
+                    if (textRun.GetTextSize() >= size)
+                    {
+                        size = textRun.GetTextSize();
+                        fontType = textRun.GetFontType();
+                        weight = textRun.GetTextWeight();
+                    }
+                }
+            }
+            return EstimateTextHeight(text, fontType, size, weight, width, true, 0);
+        }
+        case CardElementType::Container:
+        {
+            const auto& container = static_cast<const Container&>(element);
+            const unsigned int padding = container.GetPadding() ? m_spacing.paddingSpacing : 0;
+            const unsigned int innerWidth = (width > 2 * padding) ? width - 2 * padding : 0;
+            const unsigned int height = EstimateStack(container.GetItems(), innerWidth) + 2 * padding;
+            return std::max(height, container.GetMinHeight());
+        }
+        case CardElementType::Column:
+        {
+            const auto& column = static_cast<const Column&>(element);
+            const unsigned int padding = column.GetPadding() ? m_spacing.paddingSpacing : 0;
+            const unsigned int innerWidth = (width > 2 * padding) ? width - 2 * padding : 0;
+            const unsigned int height = EstimateStack(column.GetItems(), innerWidth) + 2 * padding;
+            return std::max(height, column.GetMinHeight());
+        }
+        case CardElementType::ColumnSet:
+            return EstimateColumnSet(element, width);
+        case CardElementType::FactSet:
+            return EstimateFactSet(element, width);
+        case CardElementType::Image:
+            return EstimateImage(element, width);
+        case CardElementType::ImageSet:
+            return EstimateImageSet(element, width);
+        case CardElementType::Media:
+            // media is rendered with a 16:9 poster
+            return width * 9 / 16;
+        case CardElementType::ActionSet:
+            return EstimateActions(static_cast<const ActionSet&>(element).GetActions(), width);
+        case CardElementType::TextInput:
+        {
+            const auto& textInput = static_cast<const TextInput&>(element);
+            const unsigned int lines = textInput.GetIsMultiline() ? c_multilineInputLines : 1;
+            return lines * GetLineHeight(FontType::Default, TextSize::Default) + 2 * c_controlPadding;
+        }
+        case CardElementType::ChoiceSetInput:
+        {
+            const auto& choiceSet = static_cast<const ChoiceSetInput&>(element);
+            if (choiceSet.GetChoiceSetStyle() == ChoiceSetStyle::Compact && !choiceSet.GetIsMultiSelect())
+            {
+                return GetInputHeight();
+            }
+
+            // expanded choice sets render one radio button or check box per choice
+            unsigned int height = 0;
+            for (const auto& choice : choiceSet.GetChoices())
+            {
+                height += EstimateTextHeight(
+                              choice->GetTitleRef(), FontType::Default, TextSize::Default, TextWeight::Default, width, choiceSet.GetWrap(), 0) +
+                          m_spacing.smallSpacing;
+            }
+            return height;
+        }
+        case CardElementType::ToggleInput:
+        {
+            const auto& toggleInput = static_cast<const ToggleInput&>(element);
+            return EstimateTextHeight(
+                toggleInput.GetTitleRef(), FontType::Default, TextSize::Default, TextWeight::Default, width, toggleInput.GetWrap(), 0);
+        }
+        case CardElementType::DateInput:
+        case CardElementType::NumberInput:
+        case CardElementType::TimeInput:
+            return GetInputHeight();
+        case CardElementType::Unknown:
+        case CardElementType::Custom:
+        default:
+        {
+            // renderers show an element's fallback content in place of elements they don't know about
+            if (element.GetFallbackType() == FallbackType::Content)
+            {
+                const auto fallback = std::static_pointer_cast<BaseCardElement>(element.GetFallbackContent());
+                return EstimateElement(*fallback, width);
+            }
+            return 0;
+        }
+        }
+    }
+
+    unsigned int CardHeightEstimator::EstimateStack(const std::vector<std::shared_ptr<BaseCardElement>>& items, unsigned int width)
+    {
+        unsigned int height = 0;
+        bool isFirst = true;
+        for (const auto& item : items)
+        {
+            if (!item->GetIsVisible())
+            {
+                continue;
+            }
+
+            if (!isFirst)
+            {
+                height += GetSpacing(item->GetSpacing());
+                if (item->GetSeparator())
+                {
+                    height += m_separator.lineThickness;
+                }
+            }
+
+            height += EstimateElement(*item, width);
+            isFirst = false;
+        }
+        return height;
+    }
+
+    unsigned int CardHeightEstimator::EstimateColumnSet(const BaseCardElement& element, unsigned int width)
+    {
+        const auto& columnSet = static_cast<const ColumnSet&>(element);
+        const unsigned int padding = columnSet.GetPadding() ? m_spacing.paddingSpacing : 0;
+
+        std::vector<const Column*> columns;
+        unsigned int fixedWidth = 0;
+        double totalWeight = 0;
+        for (const auto& column : columnSet.GetColumns())
+        {
+            if (!column->GetIsVisible())
+            {
+                continue;
+            }
+
+            if (!columns.empty())
+            {
+                fixedWidth += GetSpacing(column->GetSpacing()) + (column->GetSeparator() ? m_separator.lineThickness : 0);
+            }
+
+            if (column->GetPixelWidth() > 0)
+            {
+                fixedWidth += column->GetPixelWidth();
+            }
+            else
+            {
+                // "auto" and "stretch" columns are treated as sharing the remaining space evenly
+                const auto& columnWidth = column->GetWidthRef();
+                const double weight = std::atof(columnWidth.c_str());
+                totalWeight += (weight > 0) ? weight : 1.0;
+            }
+            columns.push_back(column.get());
+        }
+
+        const unsigned int innerWidth = (width > 2 * padding) ? width - 2 * padding : 0;
+        const unsigned int remainingWidth = (innerWidth > fixedWidth) ? innerWidth - fixedWidth : 0;
+
+        unsigned int height = 0;
+        for (const auto column : columns)
+        {
+            unsigned int columnWidth = column->GetPixelWidth();
+            if (columnWidth == 0)
+            {
+                const double weight = std::atof(column->GetWidthRef().c_str());
+                columnWidth = static_cast<unsigned int>(remainingWidth * ((weight > 0) ? weight : 1.0) / totalWeight);
+            }
+            height = std::max(height, EstimateElement(*column, columnWidth));
+        }
+
+        return std::max(height + 2 * padding, columnSet.GetMinHeight());
+    }
+
+    unsigned int CardHeightEstimator::EstimateFactSet(const BaseCardElement& element, unsigned int width)
+    {
+        const auto& factSet = static_cast<const FactSet&>(element);
+        const auto& titleConfig = m_factSet.title;
+        const auto& valueConfig = m_factSet.value;
+
+        // titles are laid out in an auto-sized column capped by the host's maxWidth
+        unsigned int titleWidth = 0;
+        for (const auto& fact : factSet.GetFacts())
+        {
+            titleWidth = std::max(titleWidth, EstimateTextWidth(fact->GetTitleRef(), titleConfig.fontType, titleConfig.size, titleConfig.weight));
+        }
+        titleWidth = std::min({titleWidth, titleConfig.maxWidth, width / 2});
+        const unsigned int valueWidth = (width > titleWidth + m_factSet.spacing) ? width - titleWidth - m_factSet.spacing : 0;
+
+        unsigned int height = 0;
+        for (const auto& fact : factSet.GetFacts())
+        {
+            const unsigned int titleHeight = EstimateTextHeight(
+                fact->GetTitleRef(), titleConfig.fontType, titleConfig.size, titleConfig.weight, titleWidth, titleConfig.wrap, 0);
+            const unsigned int valueHeight = EstimateTextHeight(
+                fact->GetValueRef(), valueConfig.fontType, valueConfig.size, valueConfig.weight, valueWidth, valueConfig.wrap, 0);
+            height += std::max(titleHeight, valueHeight);
+        }
+        return height;
+    }
+
+    unsigned int CardHeightEstimator::EstimateImage(const BaseCardElement& element, unsigned int width) const
+    {
+        const auto& image = static_cast<const Image&>(element);
+        if (image.GetPixelHeight())
+        {
+            return image.GetPixelHeight();
+        }
+
+        // without an explicit height images are assumed to be square
+        if (image.GetPixelWidth())
+        {
+            return std::min(image.GetPixelWidth(), width);
+        }
+
+        ImageSize size = image.GetImageSize();
+        if (size == ImageSize::None)
+        {
+            size = m_image.imageSize;
+        }
+
+        switch (size)
+        {
+        case ImageSize::Small:
+            return m_imageSizes.smallSize;
+        case ImageSize::Medium:
+            return m_imageSizes.mediumSize;
+        case ImageSize::Large:
+            return m_imageSizes.largeSize;
+        case ImageSize::Stretch:
+            return width;
+        case ImageSize::Auto:
+        case ImageSize::None:
+        default:
+            return std::min(m_imageSizes.largeSize, width);
+        }
+    }
+
+    unsigned int CardHeightEstimator::EstimateImageSet(const BaseCardElement& element, unsigned int width) const
+    {
+        const auto& imageSet = static_cast<const ImageSet&>(element);
+        const size_t imageCount = imageSet.GetImages().size();
+        if (imageCount == 0)
+        {
+            return 0;
+        }
+
+        ImageSize size = imageSet.GetImageSize();
+        if (size == ImageSize::None)
+        {
+            size = m_imageSet.imageSize;
+        }
+
+        unsigned int imageSize;
+        switch (size)
+        {
+        case ImageSize::Small:
+            imageSize = m_imageSizes.smallSize;
+            break;
+        case ImageSize::Large:
+            imageSize = m_imageSizes.largeSize;
+            break;
+        case ImageSize::Medium:
+        default:
+            imageSize = m_imageSizes.mediumSize;
+            break;
+        }
+        imageSize = std::max(1U, std::min(imageSize, m_imageSet.maxImageHeight));
+
+        const unsigned int gap = m_spacing.defaultSpacing;
+        const size_t perRow = std::max<size_t>(1, (width + gap) / (imageSize + gap));
+        const size_t rows = (imageCount + perRow - 1) / perRow;
+        return static_cast<unsigned int>(rows * imageSize + (rows - 1) * gap);
+    }
+
+    unsigned int CardHeightEstimator::EstimateActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions, unsigned int width)
+    {
+        if (actions.empty() || !m_supportsInteractivity)
+        {
+            return 0;
+        }
+
+        unsigned int buttonHeight = GetInputHeight();
+        if (m_actions.iconPlacement == IconPlacement::AboveTitle)
+        {
+            for (const auto& action : actions)
+            {
+                if (!action->GetIconUrl().empty())
+                {
+                    buttonHeight += m_actions.iconSize;
+                    break;
+                }
+            }
+        }
+
+        const size_t buttonCount = std::min<size_t>(actions.size(), m_actions.maxActions);
+        if (m_actions.actionsOrientation == ActionsOrientation::Horizontal)
+        {
+            // horizontal buttons wrap only if each can't get at least a few characters of width
+            const unsigned int minButtonWidth = EstimateTextWidth("XXXXXX", FontType::Default, TextSize::Default, TextWeight::Default);
+            const size_t perRow =
+                std::max<size_t>(1, (width + m_actions.buttonSpacing) / (minButtonWidth + m_actions.buttonSpacing));
+            const size_t rows = (buttonCount + perRow - 1) / perRow;
+            return static_cast<unsigned int>(rows * buttonHeight + (rows - 1) * m_actions.buttonSpacing);
+        }
+
+        return static_cast<unsigned int>(buttonCount * buttonHeight + (buttonCount - 1) * m_actions.buttonSpacing);
+    }
+
+    unsigned int CardHeightEstimator::EstimateTextHeight(
+        const std::string& text, FontType fontType, TextSize size, TextWeight weight, unsigned int width, bool wrap, unsigned int maxLines)
+    {
+        const unsigned int lineHeight = GetLineHeight(fontType, size);
+        if (!wrap || text.empty())
+        {
+            return lineHeight;
+        }
+
+        // DATE/TIME functions render at a different length than their source text
+        const std::string* measured = &text;
+        std::string expanded;
+        if (text.find("{{") != std::string::npos)
+        {
+            for (const auto& token : DateTimePreparser(text).GetTextTokens())
+            {
+                const char* sample = GetFormattedTokenSample(*token);
+                expanded.append(sample ? sample : token->GetTextRef());
+            }
+            measured = &expanded;
+        }
+
+        size_t lines = GetLineBreaker(fontType, size, weight).CountLinesGreedy(*measured, width);
+        if (maxLines && lines > maxLines)
+        {
+            lines = maxLines;
+        }
+        return static_cast<unsigned int>(lines * lineHeight);
+    }
+
+    unsigned int CardHeightEstimator::EstimateTextWidth(const std::string& text, FontType fontType, TextSize size, TextWeight weight)
+    {
+        return static_cast<unsigned int>(std::ceil(m_textMeasurer->MeasureWidth(text, fontType, size, weight)));
+    }
+
+    unsigned int CardHeightEstimator::GetLineHeight(FontType fontType, TextSize size)
+    {
+        return static_cast<unsigned int>(std::ceil(m_textMeasurer->GetLineHeight(fontType, size)));
+    }
+
+    LineBreaker& CardHeightEstimator::GetLineBreaker(FontType fontType, TextSize size, TextWeight weight)
+    {
+        auto& lineBreaker = m_lineBreakers[(fontType == FontType::Monospace) ? 1 : 0][static_cast<int>(size)][static_cast<int>(weight)];
+        if (!lineBreaker)
+        {
+            lineBreaker = std::make_unique<LineBreaker>(m_textMeasurer, fontType, size, weight);
+        }
+        return *lineBreaker;
+    }
+
+    unsigned int CardHeightEstimator::GetInputHeight()
+    {
+        return GetLineHeight(FontType::Default, TextSize::Default) + 2 * c_controlPadding;
+    }
+
+    unsigned int CardHeightEstimator::GetSpacing(Spacing spacing) const
+    {
+        switch (spacing)
+        {
+        case Spacing::None:
+            return 0;
+        case Spacing::Small:
+            return m_spacing.smallSpacing;
+        case Spacing::Medium:
+            return m_spacing.mediumSpacing;
+        case Spacing::Large:
+            return m_spacing.largeSpacing;
+        case Spacing::ExtraLarge:
+            return m_spacing.extraLargeSpacing;
+        case Spacing::Padding:
+            return m_spacing.paddingSpacing;
+        case Spacing::Default:
+        default:
+            return m_spacing.defaultSpacing;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "HostConfig.h"
+#include "LineBreaker.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class ToggleVisibilityAction;
+
+    // CardHeightEstimator predicts the height (in pixels) a card will occupy once rendered at a given width, without
+    // realizing any platform UI. It is intended for hosts that virtualize long lists of cards and need a size for each
+    // card before it is rendered.
+    //
+    // Estimates are cached per element and per available width, so asking for the height of the same card at the same
+    // width is a lookup. When an element's visibility changes (see ApplyToggleVisibility and InvalidateElement), only
+    // the cached heights of that element's ancestors are discarded; sibling subtrees are reused on the next estimate.
+    class CardHeightEstimator
+    {
+    public:
+        CardHeightEstimator(std::shared_ptr<AdaptiveCard> card, const HostConfig& hostConfig, const FontMetricsTable& fontMetrics);
+        CardHeightEstimator(std::shared_ptr<AdaptiveCard> card, const HostConfig& hostConfig, std::shared_ptr<TextMeasurer> textMeasurer);
+
+        unsigned int EstimateHeight(unsigned int width);
+
+        // Applies the visibility changes described by a ToggleVisibilityAction to the card and invalidates the cached
+        // heights that depend on them.
+        void ApplyToggleVisibility(const ToggleVisibilityAction& action);
+
+        // Invalidates the cached heights that depend on the elements with the given id. Call this after changing an
+        // element through the object model (e.g. BaseCardElement::SetIsVisible).
+        void InvalidateElement(const std::string& elementId);
+
+        void ClearCache();
+
+    private:
+        unsigned int EstimateElement(const BaseCardElement& element, unsigned int width);
+        unsigned int EstimateElementUncached(const BaseCardElement& element, unsigned int width);
+        unsigned int EstimateStack(const std::vector<std::shared_ptr<BaseCardElement>>& items, unsigned int width);
+        unsigned int EstimateColumnSet(const BaseCardElement& element, unsigned int width);
+        unsigned int EstimateFactSet(const BaseCardElement& element, unsigned int width);
+        unsigned int EstimateImage(const BaseCardElement& element, unsigned int width) const;
+        unsigned int EstimateImageSet(const BaseCardElement& element, unsigned int width) const;
+        unsigned int EstimateActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions, unsigned int width);
+
+        unsigned int EstimateTextHeight(const std::string& text,
+                                        FontType fontType,
+                                        TextSize size,
+                                        TextWeight weight,
+                                        unsigned int width,
+                                        bool wrap,
+                                        unsigned int maxLines);
+        unsigned int EstimateTextWidth(const std::string& text, FontType fontType, TextSize size, TextWeight weight);
+        unsigned int GetLineHeight(FontType fontType, TextSize size);
+        unsigned int GetInputHeight();
+        LineBreaker& GetLineBreaker(FontType fontType, TextSize size, TextWeight weight);
+        unsigned int GetSpacing(Spacing spacing) const;
+
+        void IndexElements(const std::vector<std::shared_ptr<BaseCardElement>>& items, const BaseCardElement* parent);
+        void IndexElement(const std::shared_ptr<BaseCardElement>& item, const BaseCardElement* parent);
+        void InvalidateAncestors(const BaseCardElement* element);
+
+        std::shared_ptr<AdaptiveCard> m_card;
+        std::shared_ptr<TextMeasurer> m_textMeasurer;
+
+        // one line breaker per [fontType][size][weight], created on first use
+        std::unique_ptr<LineBreaker> m_lineBreakers[2][5][3];
+
+        // HostConfig values are resolved once up front; HostConfig getters return copies.
+        SpacingConfig m_spacing;
+        SeparatorConfig m_separator;
+        ImageSizesConfig m_imageSizes;
+        ImageConfig m_image;
+        ImageSetConfig m_imageSet;
+        FactSetConfig m_factSet;
+        ActionsConfig m_actions;
+        bool m_supportsInteractivity;
+
+        //                  element               -> (available width -> height)
+        std::unordered_map<const BaseCardElement*, std::unordered_map<unsigned int, unsigned int>> m_elementHeights;
+        std::unordered_map<unsigned int, unsigned int> m_cardHeights;
+
+        std::unordered_map<const BaseCardElement*, const BaseCardElement*> m_parents;
+        std::unordered_multimap<std::string, BaseCardElement*> m_elementsById;
+    };
+}
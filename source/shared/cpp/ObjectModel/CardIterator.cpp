@@ -0,0 +1,534 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CardIterator.h"
+#include "ActionSet.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "Fact.h"
+#include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "Media.h"
+#include "NumberInput.h"
+#include "OpenUrlAction.h"
+#include "RichTextBlock.h"
+#include "ShowCardAction.h"
+#include "SubmitAction.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+#include "ToggleVisibilityAction.h"
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    // Room for the stack of a card nested this deep is made up front
+    constexpr size_t c_initialDepth = 16;
+
+    // Gets a child from a list of them, as the base class nodes point at
+    template<typename T, typename Base> const void* GetListChild(const void* children, size_t index)
+    {
+        return static_cast<const Base*>((*static_cast<const std::vector<std::shared_ptr<T>>*>(children))[index].get());
+    }
+
+    // For lists of one, the child itself stands in for the list
+    const void* GetOnlyChild(const void* child, size_t /*index*/) { return child; }
+
+    std::shared_ptr<BaseActionElement> GetSelectAction(const BaseCardElement& element, CardElementType type)
+    {
+        switch (type)
+        {
+        case CardElementType::Image:
+            return static_cast<const Image&>(element).GetSelectAction();
+        case CardElementType::Container:
+        case CardElementType::Column:
+        case CardElementType::ColumnSet:
+            return static_cast<const CollectionTypeElement&>(element).GetSelectAction();
+        default:
+            return nullptr;
+        }
+    }
+}
+
+CardIterator::CardIterator(const AdaptiveCard& card, CardIteratorOptions options) : m_options(options)
+{
+    m_stack.reserve(c_initialDepth);
+    Reset(card);
+}
+
+CardIterator::CardIterator(const BaseCardElement& element, CardIteratorOptions options) : m_options(options)
+{
+    m_stack.reserve(c_initialDepth);
+    Reset(element);
+}
+
+void CardIterator::Reset(const AdaptiveCard& card)
+{
+    CardNode root;
+    root.m_kind = CardNodeKind::Card;
+    root.m_node = &card;
+    Start(root);
+}
+
+void CardIterator::Reset(const BaseCardElement& element)
+{
+    CardNode root;
+    root.m_kind = CardNodeKind::Element;
+    root.m_node = &element;
+    Start(root);
+}
+
+void CardIterator::Start(const CardNode& root)
+{
+    m_stack.clear();
+    m_root = root;
+    m_node = CardNode();
+    m_isStarted = false;
+    m_isLeaving = false;
+}
+
+bool CardIterator::Next()
+{
+    const bool wantsEntering = (m_options.order != CardTraversalOrder::PostOrder);
+    const bool wantsLeaving = (m_options.order != CardTraversalOrder::PreOrder);
+
+    if (!m_isStarted)
+    {
+        m_isStarted = true;
+        Enter(m_root);
+        if (wantsEntering)
+        {
+            return true;
+        }
+    }
+
+    while (!m_stack.empty())
+    {
+        Frame& frame = m_stack.back();
+        if (frame.index < frame.count)
+        {
+            CardNode child;
+            child.m_kind = frame.childKind;
+            child.m_node = frame.getChild(frame.children, frame.index++);
+            child.m_isFallbackContent = (frame.list == ChildList::FallbackContent);
+            child.m_isSelectAction = (frame.list == ChildList::SelectAction);
+            Enter(child);
+            if (wantsEntering)
+            {
+                return true;
+            }
+        }
+        else if (frame.list < frame.lastList)
+        {
+            OpenList(frame, static_cast<ChildList>(static_cast<int>(frame.list) + 1));
+        }
+        else
+        {
+            m_node = frame.node;
+            m_isLeaving = true;
+            m_stack.pop_back();
+            if (wantsLeaving)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void CardIterator::SkipChildren()
+{
+    if (!m_isLeaving && !m_stack.empty())
+    {
+        Frame& frame = m_stack.back();
+        frame.lastList = frame.list;
+        frame.count = 0;
+    }
+}
+
+void CardIterator::Enter(const CardNode& node)
+{
+    m_stack.push_back({node, ChildList::Done, ChildList::Done, CardNodeKind::Element, nullptr, nullptr, 0, 0});
+    Frame& frame = m_stack.back();
+
+    // Most nodes are leaves, and the rest have one or two lists of children, so only the lists a node can have are
+    // walked
+    ChildList firstList = ChildList::None;
+    ChildList lastList = ChildList::None;
+    switch (node.m_kind)
+    {
+    case CardNodeKind::Card:
+        firstList = ChildList::Items;
+        lastList = m_options.includeSelectActions ? ChildList::SelectAction : ChildList::Actions;
+        break;
+    case CardNodeKind::Element:
+        frame.node.m_type = static_cast<int>(node.GetElement()->GetElementType());
+        switch (static_cast<CardElementType>(frame.node.m_type))
+        {
+        case CardElementType::Container:
+        case CardElementType::Column:
+        case CardElementType::ColumnSet:
+        case CardElementType::ImageSet:
+        case CardElementType::FactSet:
+        case CardElementType::RichTextBlock:
+            firstList = ChildList::Items;
+            lastList = ChildList::Items;
+            break;
+        case CardElementType::ActionSet:
+            firstList = ChildList::Actions;
+            lastList = ChildList::Actions;
+            break;
+        default:
+            break;
+        }
+        if (m_options.includeSelectActions)
+        {
+            firstList = (firstList == ChildList::None) ? ChildList::SelectAction : firstList;
+            lastList = ChildList::SelectAction;
+        }
+        if (m_options.includeFallbackContent)
+        {
+            firstList = (firstList == ChildList::None) ? ChildList::FallbackContent : firstList;
+            lastList = ChildList::FallbackContent;
+        }
+        break;
+    case CardNodeKind::Action:
+        frame.node.m_type = static_cast<int>(node.GetAction()->GetElementType());
+        if (static_cast<ActionType>(frame.node.m_type) == ActionType::ShowCard)
+        {
+            firstList = ChildList::Items;
+            lastList = ChildList::Items;
+        }
+        if (m_options.includeFallbackContent)
+        {
+            firstList = (firstList == ChildList::None) ? ChildList::FallbackContent : firstList;
+            lastList = ChildList::FallbackContent;
+        }
+        break;
+    default:
+        // Facts and inlines are leaves
+        break;
+    }
+
+    // The first list is opened on the next step rather than here, so that a node whose children are skipped never
+    // looks them up (which would parse a deferred ShowCard card, for one)
+    if (firstList != ChildList::None)
+    {
+        frame.list = static_cast<ChildList>(static_cast<int>(firstList) - 1);
+        frame.lastList = lastList;
+    }
+
+    m_node = frame.node;
+    m_isLeaving = false;
+}
+
+void CardIterator::OpenList(Frame& frame, ChildList list) const
+{
+    frame.list = list;
+    frame.childKind = CardNodeKind::Element;
+    frame.children = nullptr;
+    frame.getChild = GetOnlyChild;
+    frame.index = 0;
+    frame.count = 0;
+
+    const CardNode& node = frame.node;
+    switch (node.m_kind)
+    {
+    case CardNodeKind::Card:
+    {
+        const auto& card = *node.GetCard();
+        switch (list)
+        {
+        case ChildList::Items:
+            frame.children = &card.GetBody();
+            frame.getChild = GetListChild<BaseCardElement, BaseCardElement>;
+            frame.count = card.GetBody().size();
+            break;
+        case ChildList::Actions:
+            frame.childKind = CardNodeKind::Action;
+            frame.children = &card.GetActions();
+            frame.getChild = GetListChild<BaseActionElement, BaseActionElement>;
+            frame.count = card.GetActions().size();
+            break;
+        case ChildList::SelectAction:
+            if (m_options.includeSelectActions)
+            {
+                frame.childKind = CardNodeKind::Action;
+                frame.children = card.GetSelectAction().get();
+            }
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+    case CardNodeKind::Element:
+    {
+        const auto& element = *node.GetElement();
+        const auto type = static_cast<CardElementType>(node.m_type);
+        switch (list)
+        {
+        case ChildList::Items:
+            switch (type)
+            {
+            case CardElementType::Container:
+                frame.children = &static_cast<const Container&>(element).GetItems();
+                frame.getChild = GetListChild<BaseCardElement, BaseCardElement>;
+                frame.count = static_cast<const Container&>(element).GetItems().size();
+                break;
+            case CardElementType::Column:
+                frame.children = &static_cast<const Column&>(element).GetItems();
+                frame.getChild = GetListChild<BaseCardElement, BaseCardElement>;
+                frame.count = static_cast<const Column&>(element).GetItems().size();
+                break;
+            case CardElementType::ColumnSet:
+                frame.children = &static_cast<const ColumnSet&>(element).GetColumns();
+                frame.getChild = GetListChild<Column, BaseCardElement>;
+                frame.count = static_cast<const ColumnSet&>(element).GetColumns().size();
+                break;
+            case CardElementType::ImageSet:
+                frame.children = &static_cast<const ImageSet&>(element).GetImages();
+                frame.getChild = GetListChild<Image, BaseCardElement>;
+                frame.count = static_cast<const ImageSet&>(element).GetImages().size();
+                break;
+            case CardElementType::FactSet:
+                frame.childKind = CardNodeKind::Fact;
+                frame.children = &static_cast<const FactSet&>(element).GetFacts();
+                frame.getChild = GetListChild<Fact, Fact>;
+                frame.count = static_cast<const FactSet&>(element).GetFacts().size();
+                break;
+            case CardElementType::RichTextBlock:
+                frame.childKind = CardNodeKind::Inline;
+                frame.children = &static_cast<const RichTextBlock&>(element).GetInlines();
+                frame.getChild = GetListChild<Inline, Inline>;
+                frame.count = static_cast<const RichTextBlock&>(element).GetInlines().size();
+                break;
+            default:
+                break;
+            }
+            break;
+        case ChildList::Actions:
+            if (type == CardElementType::ActionSet)
+            {
+                frame.childKind = CardNodeKind::Action;
+                frame.children = &static_cast<const ActionSet&>(element).GetActions();
+                frame.getChild = GetListChild<BaseActionElement, BaseActionElement>;
+                frame.count = static_cast<const ActionSet&>(element).GetActions().size();
+            }
+            break;
+        case ChildList::SelectAction:
+            if (m_options.includeSelectActions)
+            {
+                frame.childKind = CardNodeKind::Action;
+                frame.children = static_cast<const BaseActionElement*>(GetSelectAction(element, type).get());
+            }
+            break;
+        case ChildList::FallbackContent:
+            if (m_options.includeFallbackContent && (element.GetFallbackType() == FallbackType::Content))
+            {
+                frame.children = static_cast<const BaseCardElement*>(element.GetFallbackContent().get());
+            }
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+    case CardNodeKind::Action:
+    {
+        const auto& action = *node.GetAction();
+        switch (list)
+        {
+        case ChildList::Items:
+            if (static_cast<ActionType>(node.m_type) == ActionType::ShowCard)
+            {
+                frame.childKind = CardNodeKind::Card;
+                frame.children = static_cast<const ShowCardAction&>(action).GetCard().get();
+            }
+            break;
+        case ChildList::FallbackContent:
+            if (m_options.includeFallbackContent && (action.GetFallbackType() == FallbackType::Content))
+            {
+                frame.childKind = CardNodeKind::Action;
+                frame.children = static_cast<const BaseActionElement*>(action.GetFallbackContent().get());
+            }
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+    default:
+        // Facts and inlines are leaves
+        break;
+    }
+
+    if (frame.getChild == GetOnlyChild && frame.children != nullptr)
+    {
+        frame.count = 1;
+    }
+}
+
+void CardIterator::Walk(const AdaptiveCard& card, CardVisitor& visitor, CardIteratorOptions options)
+{
+    if (options.order == CardTraversalOrder::PostOrder)
+    {
+        options.order = CardTraversalOrder::PreAndPostOrder;
+    }
+    CardIterator iterator(card, options);
+    while (iterator.Next())
+    {
+        const CardNode& node = iterator.GetNode();
+        if (iterator.IsLeaving())
+        {
+            switch (node.GetKind())
+            {
+            case CardNodeKind::Card:
+                visitor.LeaveCard(*node.GetCard());
+                break;
+            case CardNodeKind::Element:
+                visitor.LeaveElement(*node.GetElement());
+                break;
+            case CardNodeKind::Action:
+                visitor.LeaveAction(*node.GetAction());
+                break;
+            default:
+                break;
+            }
+            continue;
+        }
+
+        bool walkChildren = true;
+        switch (node.GetKind())
+        {
+        case CardNodeKind::Card:
+            walkChildren = visitor.VisitCard(*node.GetCard());
+            break;
+        case CardNodeKind::Element:
+        {
+            const BaseCardElement& element = *node.GetElement();
+            switch (static_cast<CardElementType>(node.m_type))
+            {
+            case CardElementType::ActionSet:
+                walkChildren = visitor.VisitActionSet(static_cast<const ActionSet&>(element));
+                break;
+            case CardElementType::ChoiceSetInput:
+                walkChildren = visitor.VisitChoiceSetInput(static_cast<const ChoiceSetInput&>(element));
+                break;
+            case CardElementType::Column:
+                walkChildren = visitor.VisitColumn(static_cast<const Column&>(element));
+                break;
+            case CardElementType::ColumnSet:
+                walkChildren = visitor.VisitColumnSet(static_cast<const ColumnSet&>(element));
+                break;
+            case CardElementType::Container:
+                walkChildren = visitor.VisitContainer(static_cast<const Container&>(element));
+                break;
+            case CardElementType::DateInput:
+                walkChildren = visitor.VisitDateInput(static_cast<const DateInput&>(element));
+                break;
+            case CardElementType::FactSet:
+                walkChildren = visitor.VisitFactSet(static_cast<const FactSet&>(element));
+                break;
+            case CardElementType::Image:
+                walkChildren = visitor.VisitImage(static_cast<const Image&>(element));
+                break;
+            case CardElementType::ImageSet:
+                walkChildren = visitor.VisitImageSet(static_cast<const ImageSet&>(element));
+                break;
+            case CardElementType::Media:
+                walkChildren = visitor.VisitMedia(static_cast<const Media&>(element));
+                break;
+            case CardElementType::NumberInput:
+                walkChildren = visitor.VisitNumberInput(static_cast<const NumberInput&>(element));
+                break;
+            case CardElementType::RichTextBlock:
+                walkChildren = visitor.VisitRichTextBlock(static_cast<const RichTextBlock&>(element));
+                break;
+            case CardElementType::TextBlock:
+                walkChildren = visitor.VisitTextBlock(static_cast<const TextBlock&>(element));
+                break;
+            case CardElementType::TextInput:
+                walkChildren = visitor.VisitTextInput(static_cast<const TextInput&>(element));
+                break;
+            case CardElementType::TimeInput:
+                walkChildren = visitor.VisitTimeInput(static_cast<const TimeInput&>(element));
+                break;
+            case CardElementType::ToggleInput:
+                walkChildren = visitor.VisitToggleInput(static_cast<const ToggleInput&>(element));
+                break;
+            default:
+                walkChildren = visitor.VisitElement(element);
+                break;
+            }
+            break;
+        }
+        case CardNodeKind::Action:
+        {
+            const BaseActionElement& action = *node.GetAction();
+            switch (static_cast<ActionType>(node.m_type))
+            {
+            case ActionType::OpenUrl:
+                walkChildren = visitor.VisitOpenUrlAction(static_cast<const OpenUrlAction&>(action));
+                break;
+            case ActionType::ShowCard:
+                walkChildren = visitor.VisitShowCardAction(static_cast<const ShowCardAction&>(action));
+                break;
+            case ActionType::Submit:
+                walkChildren = visitor.VisitSubmitAction(static_cast<const SubmitAction&>(action));
+                break;
+            case ActionType::ToggleVisibility:
+                walkChildren = visitor.VisitToggleVisibilityAction(static_cast<const ToggleVisibilityAction&>(action));
+                break;
+            default:
+                walkChildren = visitor.VisitAction(action);
+                break;
+            }
+            break;
+        }
+        case CardNodeKind::Fact:
+            visitor.VisitFact(*node.GetFact());
+            break;
+        case CardNodeKind::Inline:
+            if (node.GetInline()->GetInlineType() == InlineElementType::TextRun)
+            {
+                visitor.VisitTextRun(static_cast<const TextRun&>(*node.GetInline()));
+            }
+            break;
+        }
+
+        if (!walkChildren)
+        {
+            iterator.SkipChildren();
+        }
+    }
+}
+
+bool CardVisitor::VisitActionSet(const ActionSet& actionSet) { return VisitElement(actionSet); }
+bool CardVisitor::VisitChoiceSetInput(const ChoiceSetInput& choiceSetInput) { return VisitElement(choiceSetInput); }
+bool CardVisitor::VisitColumn(const Column& column) { return VisitElement(column); }
+bool CardVisitor::VisitColumnSet(const ColumnSet& columnSet) { return VisitElement(columnSet); }
+bool CardVisitor::VisitContainer(const Container& container) { return VisitElement(container); }
+bool CardVisitor::VisitDateInput(const DateInput& dateInput) { return VisitElement(dateInput); }
+bool CardVisitor::VisitFactSet(const FactSet& factSet) { return VisitElement(factSet); }
+bool CardVisitor::VisitImage(const Image& image) { return VisitElement(image); }
+bool CardVisitor::VisitImageSet(const ImageSet& imageSet) { return VisitElement(imageSet); }
+bool CardVisitor::VisitMedia(const Media& media) { return VisitElement(media); }
+bool CardVisitor::VisitNumberInput(const NumberInput& numberInput) { return VisitElement(numberInput); }
+bool CardVisitor::VisitRichTextBlock(const RichTextBlock& richTextBlock) { return VisitElement(richTextBlock); }
+bool CardVisitor::VisitTextBlock(const TextBlock& textBlock) { return VisitElement(textBlock); }
+bool CardVisitor::VisitTextInput(const TextInput& textInput) { return VisitElement(textInput); }
+bool CardVisitor::VisitTimeInput(const TimeInput& timeInput) { return VisitElement(timeInput); }
+bool CardVisitor::VisitToggleInput(const ToggleInput& toggleInput) { return VisitElement(toggleInput); }
+
+bool CardVisitor::VisitOpenUrlAction(const OpenUrlAction& action) { return VisitAction(action); }
+bool CardVisitor::VisitShowCardAction(const ShowCardAction& action) { return VisitAction(action); }
+bool CardVisitor::VisitSubmitAction(const SubmitAction& action) { return VisitAction(action); }
+bool CardVisitor::VisitToggleVisibilityAction(const ToggleVisibilityAction& action) { return VisitAction(action); }
@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class ActionSet;
+    class CardVisitor;
+    class ChoiceSetInput;
+    class Column;
+    class ColumnSet;
+    class Container;
+    class DateInput;
+    class Fact;
+    class FactSet;
+    class Image;
+    class ImageSet;
+    class Inline;
+    class Media;
+    class NumberInput;
+    class OpenUrlAction;
+    class RichTextBlock;
+    class ShowCardAction;
+    class SubmitAction;
+    class TextBlock;
+    class TextInput;
+    class TextRun;
+    class TimeInput;
+    class ToggleInput;
+    class ToggleVisibilityAction;
+
+    enum class CardNodeKind
+    {
+        Card,
+        Element,
+        Action,
+        Fact,
+        Inline
+    };
+
+    // A card, element, action, fact or inline met while walking a card. Nodes don't hold references to what they
+    // point at; the card has to outlive them.
+    class CardNode
+    {
+    public:
+        CardNode() : m_kind(CardNodeKind::Card), m_node(nullptr), m_type(0), m_isFallbackContent(false), m_isSelectAction(false)
+        {
+        }
+
+        CardNodeKind GetKind() const { return m_kind; }
+
+        // Each returns nullptr unless the node is of that kind
+        const AdaptiveCard* GetCard() const { return Get<AdaptiveCard>(CardNodeKind::Card); }
+        const BaseCardElement* GetElement() const { return Get<BaseCardElement>(CardNodeKind::Element); }
+        const BaseActionElement* GetAction() const { return Get<BaseActionElement>(CardNodeKind::Action); }
+        const Fact* GetFact() const { return Get<Fact>(CardNodeKind::Fact); }
+        const Inline* GetInline() const { return Get<Inline>(CardNodeKind::Inline); }
+
+        // Whether the node is the fallback content of its parent
+        bool IsFallbackContent() const { return m_isFallbackContent; }
+        // Whether the node is the select action of its parent
+        bool IsSelectAction() const { return m_isSelectAction; }
+
+    private:
+        template<typename T> const T* Get(CardNodeKind kind) const
+        {
+            return (m_kind == kind) ? static_cast<const T*>(m_node) : nullptr;
+        }
+
+        CardNodeKind m_kind;
+        const void* m_node;
+        // The CardElementType or ActionType of an element or action, looked up once when it's entered
+        int m_type;
+        bool m_isFallbackContent;
+        bool m_isSelectAction;
+
+        friend class CardIterator;
+    };
+
+    enum class CardTraversalOrder
+    {
+        // Each node is visited before its children
+        PreOrder,
+        // Each node is visited after its children
+        PostOrder,
+        // Each node is visited twice: entering it, before its children, and leaving it, after them
+        PreAndPostOrder
+    };
+
+    struct CardIteratorOptions
+    {
+        CardTraversalOrder order = CardTraversalOrder::PreOrder;
+
+        // Walk the fallback content of elements and actions, after their other children
+        bool includeFallbackContent = false;
+
+        // Walk the select actions of cards, images, containers, columns and column sets, after their other children
+        // and before their fallback content
+        bool includeSelectActions = false;
+    };
+
+    // CardIterator walks a card depth first, in document order, without recursing: the card's body then its actions,
+    // the items of containers and columns, the columns of column sets, the images of image sets, the actions of
+    // action sets, the facts of fact sets, the inlines of rich text blocks and the card of ShowCard actions. Other
+    // elements and actions are leaves. The nodes are pointers into the card, so walking it copies no shared_ptrs, and
+    // the stack of nodes being walked is kept between walks, so an iterator that's reused with Reset doesn't allocate
+    // once it has grown to the depth of the cards it walks.
+    //
+    //     CardIterator iterator(card);
+    //     while (iterator.Next())
+    //     {
+    //         const CardNode& node = iterator.GetNode();
+    //         ...
+    //     }
+    class CardIterator
+    {
+    public:
+        explicit CardIterator(const AdaptiveCard& card, CardIteratorOptions options = {});
+        // Walks only element and what's inside it
+        explicit CardIterator(const BaseCardElement& element, CardIteratorOptions options = {});
+
+        void Reset(const AdaptiveCard& card);
+        void Reset(const BaseCardElement& element);
+
+        // Moves to the next node. Returns false once the walk is over.
+        bool Next();
+
+        const CardNode& GetNode() const { return m_node; }
+        // Whether the iterator is leaving the node, after its children, rather than entering it
+        bool IsLeaving() const { return m_isLeaving; }
+        // How many ancestors the node has, up to the node the walk started at
+        size_t GetDepth() const { return m_isLeaving ? m_stack.size() : m_stack.size() - 1; }
+
+        // Doesn't walk the children of the node being entered. Has no effect when leaving a node.
+        void SkipChildren();
+
+        // Calls visitor for each node, as CardVisitor describes. Visit methods are called on entering each node, and
+        // Leave methods on leaving it unless options.order is PreOrder.
+        static void Walk(const AdaptiveCard& card, CardVisitor& visitor, CardIteratorOptions options = {});
+
+    private:
+        // The lists of children a node can have, in the order they're walked
+        enum class ChildList
+        {
+            None,
+            Items,
+            Actions,
+            SelectAction,
+            FallbackContent,
+            Done
+        };
+
+        // A node being walked, and where the walk is among its children. The list being walked is looked up once, when
+        // the walk gets to it, rather than for each child.
+        struct Frame
+        {
+            CardNode node;
+            ChildList list;
+            // The list after which the node can't have any more children
+            ChildList lastList;
+            CardNodeKind childKind;
+            const void* children;
+            const void* (*getChild)(const void* children, size_t index);
+            size_t index;
+            size_t count;
+        };
+
+        void Start(const CardNode& root);
+        void Enter(const CardNode& node);
+        void OpenList(Frame& frame, ChildList list) const;
+
+        CardIteratorOptions m_options;
+        std::vector<Frame> m_stack;
+        CardNode m_root;
+        CardNode m_node;
+        bool m_isStarted;
+        bool m_isLeaving;
+    };
+
+    // A visitor with a method for each type of node, for CardIterator::Walk. Nodes are dispatched on their element or
+    // action type. Each typed Visit method calls VisitElement or VisitAction unless it's overridden, so a visitor can
+    // handle just the types it's interested in. Visit methods are called on entering a node and return whether to
+    // walk its children; Leave methods are called after them, if the walk asks for them. Custom and unknown elements and actions go to
+    // VisitElement and VisitAction.
+    class CardVisitor
+    {
+    public:
+        virtual ~CardVisitor() = default;
+
+        virtual bool VisitCard(const AdaptiveCard& /*card*/) { return true; }
+        virtual void LeaveCard(const AdaptiveCard& /*card*/) {}
+
+        virtual bool VisitElement(const BaseCardElement& /*element*/) { return true; }
+        virtual void LeaveElement(const BaseCardElement& /*element*/) {}
+
+        virtual bool VisitActionSet(const ActionSet& actionSet);
+        virtual bool VisitChoiceSetInput(const ChoiceSetInput& choiceSetInput);
+        virtual bool VisitColumn(const Column& column);
+        virtual bool VisitColumnSet(const ColumnSet& columnSet);
+        virtual bool VisitContainer(const Container& container);
+        virtual bool VisitDateInput(const DateInput& dateInput);
+        virtual bool VisitFactSet(const FactSet& factSet);
+        virtual bool VisitImage(const Image& image);
+        virtual bool VisitImageSet(const ImageSet& imageSet);
+        virtual bool VisitMedia(const Media& media);
+        virtual bool VisitNumberInput(const NumberInput& numberInput);
+        virtual bool VisitRichTextBlock(const RichTextBlock& richTextBlock);
+        virtual bool VisitTextBlock(const TextBlock& textBlock);
+        virtual bool VisitTextInput(const TextInput& textInput);
+        virtual bool VisitTimeInput(const TimeInput& timeInput);
+        virtual bool VisitToggleInput(const ToggleInput& toggleInput);
+
+        virtual bool VisitAction(const BaseActionElement& /*action*/) { return true; }
+        virtual void LeaveAction(const BaseActionElement& /*action*/) {}
+
+        virtual bool VisitOpenUrlAction(const OpenUrlAction& action);
+        virtual bool VisitShowCardAction(const ShowCardAction& action);
+        virtual bool VisitSubmitAction(const SubmitAction& action);
+        virtual bool VisitToggleVisibilityAction(const ToggleVisibilityAction& action);
+
+        // Facts and inlines have no children
+        virtual void VisitFact(const Fact& /*fact*/) {}
+        virtual void VisitTextRun(const TextRun& /*textRun*/) {}
+    };
+}
@@ -0,0 +1,345 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CardTextExtractor.h"
+#include "ActionSet.h"
+#include "ChoiceInput.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "DateTimePreparser.h"
+#include "Fact.h"
+#include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "MarkDownParser.h"
+#include "Media.h"
+#include "NumberInput.h"
+#include "RichTextBlock.h"
+#include "ShowCardAction.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+
+namespace AdaptiveSharedNamespace
+{
+    namespace
+    {
+        // Text without these characters comes out of the markdown parser unchanged, so it can be passed through as is.
+        // A leading '-', '+' or digit may start a list.
+        bool MayContainMarkDown(const std::string& text)
+        {
+            if (text.empty())
+            {
+                return false;
+            }
+
+            const char first = text.front();
+            if (first == '-' || first == '+' || (first >= '0' && first <= '9'))
+            {
+                return true;
+            }
+            return text.find_first_of("*_[\\\r\n") != std::string::npos;
+        }
+
+        // Constructing a DateTimePreparser runs its regex over the whole string, so skip it when there's nothing to find.
+        bool HasDateTimeTokens(const std::string& text)
+        {
+            return text.find("{{") != std::string::npos;
+        }
+    }
+
+    CardTextExtractor::CardTextExtractor() : CardTextExtractor(CardTextExtractionOptions())
+    {
+    }
+
+    CardTextExtractor::CardTextExtractor(const CardTextExtractionOptions& options) : m_options(options)
+    {
+    }
+
+    std::function<std::string(const DateTimePreparsedToken& token)> CardTextExtractor::MakeLocaleDateFormatter(const std::locale& locale)
+    {
+        return [locale](const DateTimePreparsedToken& token) { return token.GetDisplayText(locale); };
+    }
+
+    std::string CardTextExtractor::Extract(const AdaptiveCard& card) const
+    {
+        std::string text;
+        Extract(card, [&text](const char* fragment, size_t length) { text.append(fragment, length); });
+        return text;
+    }
+
+    void CardTextExtractor::Extract(const AdaptiveCard& card, const CardTextCallback& callback) const
+    {
+        ExtractionState state{callback, false};
+        ExtractCard(card, state);
+    }
+
+    void CardTextExtractor::ExtractCard(const AdaptiveCard& card, ExtractionState& state) const
+    {
+        ExtractElements(card.GetBody(), state);
+        if (m_options.includeActions)
+        {
+            ExtractActions(card.GetActions(), state);
+        }
+    }
+
+    void CardTextExtractor::ExtractElements(const std::vector<std::shared_ptr<BaseCardElement>>& elements, ExtractionState& state) const
+    {
+        for (const auto& element : elements)
+        {
+            if (element && (m_options.includeHiddenElements || element->GetIsVisible()))
+            {
+                ExtractElement(*element, state);
+            }
+        }
+    }
+
+    void CardTextExtractor::ExtractElement(const BaseCardElement& element, ExtractionState& state) const
+    {
+        switch (element.GetElementType())
+        {
+        case CardElementType::TextBlock:
+            EmitText(static_cast<const TextBlock&>(element).GetTextRef(), true, state);
+            break;
+        case CardElementType::RichTextBlock:
+        {
+            // The runs of a RichTextBlock form a single block; they aren't markdown.
+            bool isFirstRun = true;
+            for (const auto& inlineElement : static_cast<const RichTextBlock&>(element).GetInlines())
+            {
+                if (!inlineElement || inlineElement->GetInlineType() != InlineElementType::TextRun)
+                {
+                    continue;
+                }
+
+                const std::string& runText = static_cast<const TextRun&>(*inlineElement).GetTextRef();
+                std::string formatted;
+                const std::string& text = HasDateTimeTokens(runText) ? (formatted = FormatDateTimeTokens(runText)) : runText;
+                if (!text.empty())
+                {
+                    if (isFirstRun)
+                    {
+                        BeginBlock(state);
+                        isFirstRun = false;
+                    }
+                    state.callback(text.data(), text.size());
+                }
+            }
+            break;
+        }
+        case CardElementType::Container:
+            ExtractElements(static_cast<const Container&>(element).GetItems(), state);
+            break;
+        case CardElementType::ColumnSet:
+            for (const auto& column : static_cast<const ColumnSet&>(element).GetColumns())
+            {
+                if (column && (m_options.includeHiddenElements || column->GetIsVisible()))
+                {
+                    ExtractElements(column->GetItems(), state);
+                }
+            }
+            break;
+        case CardElementType::FactSet:
+            for (const auto& fact : static_cast<const FactSet&>(element).GetFacts())
+            {
+                if (fact)
+                {
+                    EmitText(fact->GetTitleRef(), true, state);
+                    EmitText(fact->GetValueRef(), true, state);
+                }
+            }
+            break;
+        case CardElementType::Image:
+            if (m_options.includeAltText)
+            {
+                EmitText(static_cast<const Image&>(element).GetAltTextRef(), false, state);
+            }
+            break;
+        case CardElementType::ImageSet:
+            if (m_options.includeAltText)
+            {
+                for (const auto& image : static_cast<const ImageSet&>(element).GetImages())
+                {
+                    if (image)
+                    {
+                        EmitText(image->GetAltTextRef(), false, state);
+                    }
+                }
+            }
+            break;
+        case CardElementType::Media:
+            if (m_options.includeAltText)
+            {
+                EmitText(static_cast<const Media&>(element).GetAltTextRef(), false, state);
+            }
+            break;
+        case CardElementType::ActionSet:
+            if (m_options.includeActions)
+            {
+                ExtractActions(static_cast<const ActionSet&>(element).GetActions(), state);
+            }
+            break;
+        case CardElementType::TextInput:
+            if (m_options.includeInputs)
+            {
+                const auto& textInput = static_cast<const TextInput&>(element);
+                EmitText(textInput.GetPlaceholderRef(), false, state);
+                EmitText(textInput.GetValueRef(), false, state);
+            }
+            break;
+        case CardElementType::NumberInput:
+            if (m_options.includeInputs)
+            {
+                EmitText(static_cast<const NumberInput&>(element).GetPlaceholderRef(), false, state);
+            }
+            break;
+        case CardElementType::DateInput:
+            if (m_options.includeInputs)
+            {
+                EmitText(static_cast<const DateInput&>(element).GetPlaceholderRef(), false, state);
+            }
+            break;
+        case CardElementType::TimeInput:
+            if (m_options.includeInputs)
+            {
+                EmitText(static_cast<const TimeInput&>(element).GetPlaceholderRef(), false, state);
+            }
+            break;
+        case CardElementType::ToggleInput:
+            if (m_options.includeInputs)
+            {
+                EmitText(static_cast<const ToggleInput&>(element).GetTitleRef(), false, state);
+            }
+            break;
+        case CardElementType::ChoiceSetInput:
+            if (m_options.includeInputs)
+            {
+                for (const auto& choice : static_cast<const ChoiceSetInput&>(element).GetChoices())
+                {
+                    if (choice)
+                    {
+                        EmitText(choice->GetTitleRef(), false, state);
+                    }
+                }
+            }
+            break;
+        default:
+            if (element.GetFallbackType() == FallbackType::Content && element.GetFallbackContent())
+            {
+                ExtractElement(static_cast<const BaseCardElement&>(*element.GetFallbackContent()), state);
+            }
+            break;
+        }
+    }
+
+    void CardTextExtractor::ExtractActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions, ExtractionState& state) const
+    {
+        for (const auto& action : actions)
+        {
+            if (action)
+            {
+                ExtractAction(*action, state);
+            }
+        }
+    }
+
+    void CardTextExtractor::ExtractAction(const BaseActionElement& action, ExtractionState& state) const
+    {
+        switch (action.GetElementType())
+        {
+        case ActionType::UnknownAction:
+        case ActionType::Custom:
+        case ActionType::Unsupported:
+            if (action.GetFallbackType() == FallbackType::Content && action.GetFallbackContent())
+            {
+                ExtractAction(static_cast<const BaseActionElement&>(*action.GetFallbackContent()), state);
+            }
+            break;
+        case ActionType::ShowCard:
+        {
+            EmitText(action.GetTitle(), false, state);
+            const auto card = static_cast<const ShowCardAction&>(action).GetCard();
+            if (card)
+            {
+                ExtractCard(*card, state);
+            }
+            break;
+        }
+        default:
+            EmitText(action.GetTitle(), false, state);
+            break;
+        }
+    }
+
+    void CardTextExtractor::BeginBlock(ExtractionState& state) const
+    {
+        if (state.hasOutput)
+        {
+            state.callback(m_options.separator.data(), m_options.separator.size());
+        }
+        state.hasOutput = true;
+    }
+
+    std::string CardTextExtractor::FormatDateTimeTokens(const std::string& text) const
+    {
+        std::string formatted;
+        for (const auto& token : DateTimePreparser(text).GetTextTokens())
+        {
+            formatted += m_options.dateFormatter ? m_options.dateFormatter(*token) : token->GetDisplayText();
+        }
+        return formatted;
+    }
+
+    void CardTextExtractor::EmitText(const std::string& text, bool isMarkDown, ExtractionState& state) const
+    {
+        if (text.empty())
+        {
+            return;
+        }
+
+        std::string formatted;
+        const std::string* source = &text;
+        if (isMarkDown && HasDateTimeTokens(text))
+        {
+            formatted = FormatDateTimeTokens(text);
+            source = &formatted;
+        }
+
+        if (isMarkDown && MayContainMarkDown(*source))
+        {
+            EmitMarkDownAsText(*source, state);
+        }
+        else
+        {
+            BeginBlock(state);
+            state.callback(source->data(), source->size());
+        }
+    }
+
+    void CardTextExtractor::EmitMarkDownAsText(const std::string& text, ExtractionState& state) const
+    {
+        // Run the text through the same parser the renderers use and stream out its styled runs; paragraphs and list
+        // items become separators.
+        MarkDownParser parser(text);
+        const MarkDownStyledText styledText = parser.TransformToStyledRuns();
+
+        for (size_t i = 0; i < styledText.runs.size(); i++)
+        {
+            const MarkDownStyledRun& run = styledText.runs[i];
+            if (i == 0)
+            {
+                BeginBlock(state);
+            }
+            else if (run.blockIndex != styledText.runs[i - 1].blockIndex)
+            {
+                state.callback(m_options.separator.data(), m_options.separator.size());
+            }
+            state.callback(styledText.text.data() + run.start, run.length);
+        }
+    }
+}
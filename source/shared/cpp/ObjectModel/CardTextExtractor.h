@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class DateTimePreparsedToken;
+
+    // Receives the extracted text in fragments. Fragments point into the card or into scratch storage that's reused
+    // after the callback returns, so copy anything that needs to outlive the call.
+    typedef std::function<void(const char* text, size_t length)> CardTextCallback;
+
+    struct CardTextExtractionOptions
+    {
+        // Written between blocks of text (text blocks, facts, choices, action titles, ...) and between the lines and
+        // list items of a markdown block.
+        std::string separator = "\n";
+
+        bool includeActions = true;
+        bool includeInputs = true;
+        bool includeAltText = true;
+        bool includeHiddenElements = false;
+
+        // Formats {{DATE()}} tokens. When empty, dates are written in en-US; see DateTimePreparsedToken::GetDisplayText.
+        std::function<std::string(const DateTimePreparsedToken& token)> dateFormatter;
+    };
+
+    // CardTextExtractor walks a card once, in reading order, and streams its text to a callback: TextBlocks and
+    // RichTextBlock inlines, facts, image alt text, input placeholders and choices, and action titles (including the
+    // contents of ShowCard actions). Markdown is stripped and DATE/TIME macros are resolved.
+    class CardTextExtractor
+    {
+    public:
+        CardTextExtractor();
+        CardTextExtractor(const CardTextExtractionOptions& options);
+
+        void Extract(const AdaptiveCard& card, const CardTextCallback& callback) const;
+        std::string Extract(const AdaptiveCard& card) const;
+
+        // Returns a date formatter that uses the locale's month and day names.
+        static std::function<std::string(const DateTimePreparsedToken& token)> MakeLocaleDateFormatter(const std::locale& locale);
+
+    private:
+        struct ExtractionState
+        {
+            const CardTextCallback& callback;
+            bool hasOutput;
+        };
+
+        void ExtractCard(const AdaptiveCard& card, ExtractionState& state) const;
+        void ExtractElements(const std::vector<std::shared_ptr<BaseCardElement>>& elements, ExtractionState& state) const;
+        void ExtractElement(const BaseCardElement& element, ExtractionState& state) const;
+        void ExtractActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions, ExtractionState& state) const;
+        void ExtractAction(const BaseActionElement& action, ExtractionState& state) const;
+
+        // Emits one block of text. Markdown is only run when the text contains something the parser would change.
+        void EmitText(const std::string& text, bool isMarkDown, ExtractionState& state) const;
+        void EmitMarkDownAsText(const std::string& text, ExtractionState& state) const;
+        void BeginBlock(ExtractionState& state) const;
+        std::string FormatDateTimeTokens(const std::string& text) const;
+
+        CardTextExtractionOptions m_options;
+    };
+}
@@ -0,0 +1,650 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CardView.h"
+#include "AdaptiveCardParseException.h"
+#include <cstring>
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    bool Equals(const char* begin, const char* end, const char* text, size_t length)
+    {
+        return static_cast<size_t>(end - begin) == length && memcmp(begin, text, length) == 0;
+    }
+
+    // The types of element and action with children, as CardIterator walks them
+    enum ViewType
+    {
+        OtherType,
+        ContainerType,
+        ColumnType,
+        ColumnSetType,
+        ImageSetType,
+        FactSetType,
+        RichTextBlockType,
+        ActionSetType,
+        ImageType,
+        ShowCardType
+    };
+
+    constexpr size_t c_initialDepth = 16;
+
+    void AddResource(std::vector<RemoteResourceInformation>& resourceInfo, std::string url, std::string mimeType)
+    {
+        RemoteResourceInformation info;
+        info.url = std::move(url);
+        info.mimeType = std::move(mimeType);
+        resourceInfo.push_back(std::move(info));
+    }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    ElementView::ElementView() : m_reader(nullptr), m_value(nullptr) {}
+
+    ElementView::ElementView(const BinaryCardReader* reader, const uint8_t* value) : m_reader(reader), m_value(value) {}
+
+    bool ElementView::IsValid() const { return m_value != nullptr; }
+
+    std::string ElementView::GetElementTypeString() const { return GetString(AdaptiveCardSchemaKey::Type); }
+
+    std::string ElementView::GetId() const { return GetString(AdaptiveCardSchemaKey::Id); }
+
+    bool ElementView::HasProperty(AdaptiveCardSchemaKey key) const
+    {
+        return IsValid() && m_reader->FindMember(m_value, key) != nullptr;
+    }
+
+    std::string ElementView::GetString(AdaptiveCardSchemaKey key) const
+    {
+        const char* begin;
+        const char* end;
+        const uint8_t* value = IsValid() ? m_reader->FindMember(m_value, key) : nullptr;
+        if (value == nullptr || !m_reader->GetString(value, begin, end))
+        {
+            return "";
+        }
+        return std::string(begin, end);
+    }
+
+    bool ElementView::GetBool(AdaptiveCardSchemaKey key, bool defaultValue) const
+    {
+        const uint8_t* value = IsValid() ? m_reader->FindMember(m_value, key) : nullptr;
+        if (value == nullptr)
+        {
+            return defaultValue;
+        }
+
+        switch (m_reader->GetType(value))
+        {
+        case BinaryCardFormat::ValueType::True:
+            return true;
+        case BinaryCardFormat::ValueType::False:
+            return false;
+        default:
+            return defaultValue;
+        }
+    }
+
+    ElementView ElementView::GetObject(AdaptiveCardSchemaKey key) const
+    {
+        const uint8_t* value = IsValid() ? m_reader->FindMember(m_value, key) : nullptr;
+        if (value == nullptr || m_reader->GetType(value) != BinaryCardFormat::ValueType::Object)
+        {
+            return ElementView();
+        }
+        return ElementView(m_reader, value);
+    }
+
+    std::vector<ElementView> ElementView::GetElements(AdaptiveCardSchemaKey key) const
+    {
+        std::vector<ElementView> elements;
+        GetElements(key, elements);
+        return elements;
+    }
+
+    void ElementView::GetElements(AdaptiveCardSchemaKey key, std::vector<ElementView>& elements) const
+    {
+        elements.clear();
+        const uint8_t* value = IsValid() ? m_reader->FindMember(m_value, key) : nullptr;
+        if (value == nullptr || m_reader->GetType(value) != BinaryCardFormat::ValueType::Array)
+        {
+            return;
+        }
+
+        const uint8_t* element;
+        const size_t count = m_reader->GetCount(value, element);
+        elements.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (m_reader->GetType(element) == BinaryCardFormat::ValueType::Object)
+            {
+                elements.emplace_back(m_reader, element);
+            }
+            element = m_reader->Skip(element);
+        }
+    }
+
+    Json::Value ElementView::GetValue(AdaptiveCardSchemaKey key) const
+    {
+        const uint8_t* value = IsValid() ? m_reader->FindMember(m_value, key) : nullptr;
+        return (value == nullptr) ? Json::Value() : m_reader->ToJson(value);
+    }
+
+    Json::Value ElementView::ToJson() const { return IsValid() ? m_reader->ToJson(m_value) : Json::Value(); }
+
+    bool ElementView::IsType(const char* type) const
+    {
+        const char* begin;
+        const char* end;
+        const uint8_t* value = m_reader->FindMember(m_value, AdaptiveCardSchemaKey::Type);
+        return value != nullptr && m_reader->GetString(value, begin, end) && Equals(begin, end, type, strlen(type));
+    }
+
+    void ElementView::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo) const
+    {
+        if (!IsValid())
+        {
+            return;
+        }
+
+        if (IsType("Container") || IsType("Column"))
+        {
+            GetBackgroundImageInformation(resourceInfo);
+            GetChildrenResourceInformation(AdaptiveCardSchemaKey::Items, resourceInfo);
+        }
+        else if (IsType("ColumnSet"))
+        {
+            GetBackgroundImageInformation(resourceInfo);
+            GetChildrenResourceInformation(AdaptiveCardSchemaKey::Columns, resourceInfo);
+        }
+        else if (IsType("Image"))
+        {
+            AddResource(resourceInfo, GetString(AdaptiveCardSchemaKey::Url), "image");
+        }
+        else if (IsType("ImageSet"))
+        {
+            GetChildrenResourceInformation(AdaptiveCardSchemaKey::Images, resourceInfo);
+        }
+        else if (IsType("Media"))
+        {
+            AddResource(resourceInfo, GetString(AdaptiveCardSchemaKey::Poster), "image");
+            for (const auto& source : GetElements(AdaptiveCardSchemaKey::Sources))
+            {
+                AddResource(resourceInfo, source.GetString(AdaptiveCardSchemaKey::Url), source.GetString(AdaptiveCardSchemaKey::MimeType));
+            }
+        }
+        else if (IsType("Action.ShowCard"))
+        {
+            // A ShowCard action's own icon isn't included, as with ShowCardAction::GetResourceInformation
+            GetObject(AdaptiveCardSchemaKey::Card).GetCardResourceInformation(resourceInfo);
+        }
+        else if (HasProperty(AdaptiveCardSchemaKey::IconUrl))
+        {
+            // Only actions have an icon
+            std::string iconUrl = GetString(AdaptiveCardSchemaKey::IconUrl);
+            if (!iconUrl.empty())
+            {
+                AddResource(resourceInfo, std::move(iconUrl), "image");
+            }
+        }
+    }
+
+    void ElementView::GetCardResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo) const
+    {
+        GetBackgroundImageInformation(resourceInfo);
+        GetChildrenResourceInformation(AdaptiveCardSchemaKey::Body, resourceInfo);
+        GetChildrenResourceInformation(AdaptiveCardSchemaKey::Actions, resourceInfo);
+    }
+
+    void ElementView::GetBackgroundImageInformation(std::vector<RemoteResourceInformation>& resourceInfo) const
+    {
+        // Serialize writes a background image with only a url as the url alone
+        const uint8_t* backgroundImage = IsValid() ? m_reader->FindMember(m_value, AdaptiveCardSchemaKey::BackgroundImage) : nullptr;
+        if (backgroundImage == nullptr)
+        {
+            return;
+        }
+
+        const char* begin;
+        const char* end;
+        if (m_reader->GetString(backgroundImage, begin, end))
+        {
+            AddResource(resourceInfo, std::string(begin, end), "image");
+        }
+        else if (m_reader->GetType(backgroundImage) == BinaryCardFormat::ValueType::Object)
+        {
+            AddResource(resourceInfo, ElementView(m_reader, backgroundImage).GetString(AdaptiveCardSchemaKey::Url), "image");
+        }
+    }
+
+    void ElementView::GetChildrenResourceInformation(AdaptiveCardSchemaKey key, std::vector<RemoteResourceInformation>& resourceInfo) const
+    {
+        for (const auto& child : GetElements(key))
+        {
+            child.GetResourceInformation(resourceInfo);
+        }
+    }
+
+    ElementView ElementView::FindElementById(const std::string& id) const
+    {
+        const char* begin;
+        const char* end;
+        const uint8_t* elementId = m_reader->FindMember(m_value, AdaptiveCardSchemaKey::Id);
+        if (elementId != nullptr && m_reader->GetString(elementId, begin, end) && Equals(begin, end, id.data(), id.size()))
+        {
+            return *this;
+        }
+
+        // A card (the card of a ShowCard action) has a body and actions, and any element at most one of the others
+        for (const auto key : {AdaptiveCardSchemaKey::SelectAction, AdaptiveCardSchemaKey::Card})
+        {
+            const ElementView child = GetObject(key);
+            const ElementView found = child.IsValid() ? child.FindElementById(id) : ElementView();
+            if (found.IsValid())
+            {
+                return found;
+            }
+        }
+
+        for (const auto key : {AdaptiveCardSchemaKey::Body,
+                               AdaptiveCardSchemaKey::Items,
+                               AdaptiveCardSchemaKey::Columns,
+                               AdaptiveCardSchemaKey::Images,
+                               AdaptiveCardSchemaKey::Actions})
+        {
+            for (const auto& child : GetElements(key))
+            {
+                const ElementView found = child.FindElementById(id);
+                if (found.IsValid())
+                {
+                    return found;
+                }
+            }
+        }
+        return ElementView();
+    }
+
+    CardView::CardView(const uint8_t* data, size_t size) : m_reader(std::make_unique<BinaryCardReader>(data, size))
+    {
+        if (m_reader->GetType(m_reader->GetRoot()) != BinaryCardFormat::ValueType::Object)
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidJson, "Invalid binary card: not a card");
+        }
+    }
+
+    ElementView CardView::GetRoot() const { return ElementView(m_reader.get(), m_reader->GetRoot()); }
+
+    std::string CardView::GetVersion() const { return GetRoot().GetString(AdaptiveCardSchemaKey::Version); }
+
+    std::vector<ElementView> CardView::GetBody() const { return GetRoot().GetElements(AdaptiveCardSchemaKey::Body); }
+
+    std::vector<ElementView> CardView::GetActions() const { return GetRoot().GetElements(AdaptiveCardSchemaKey::Actions); }
+
+    std::vector<RemoteResourceInformation> CardView::GetResourceInformation() const
+    {
+        std::vector<RemoteResourceInformation> resourceInfo;
+        GetRoot().GetCardResourceInformation(resourceInfo);
+        return resourceInfo;
+    }
+
+    ElementView CardView::GetElementById(const std::string& id) const
+    {
+        const ElementView root = GetRoot();
+
+        // The card's own id isn't an element's
+        for (const auto key : {AdaptiveCardSchemaKey::Body, AdaptiveCardSchemaKey::Actions})
+        {
+            for (const auto& element : root.GetElements(key))
+            {
+                const ElementView found = element.FindElementById(id);
+                if (found.IsValid())
+                {
+                    return found;
+                }
+            }
+        }
+        return ElementView();
+    }
+
+    CardViewIterator::CardViewIterator(const CardView& card, CardIteratorOptions options) : m_options(options)
+    {
+        m_stack.reserve(c_initialDepth);
+        Reset(card);
+    }
+
+    CardViewIterator::CardViewIterator(const ElementView& element, CardIteratorOptions options) : m_options(options)
+    {
+        m_stack.reserve(c_initialDepth);
+        Reset(element);
+    }
+
+    void CardViewIterator::Reset(const CardView& card) { Start(CardNodeKind::Card, card.GetRoot()); }
+
+    void CardViewIterator::Reset(const ElementView& element) { Start(CardNodeKind::Element, element); }
+
+    void CardViewIterator::Start(CardNodeKind kind, const ElementView& root)
+    {
+        m_depth = 0;
+        m_root = CardViewNode();
+        m_root.m_kind = kind;
+        m_root.m_view = root;
+        m_node = CardViewNode();
+        m_isStarted = false;
+        m_isLeaving = false;
+    }
+
+    bool CardViewIterator::Next()
+    {
+        const bool wantsEntering = (m_options.order != CardTraversalOrder::PostOrder);
+        const bool wantsLeaving = (m_options.order != CardTraversalOrder::PreOrder);
+
+        if (!m_isStarted)
+        {
+            m_isStarted = true;
+            Enter(m_root);
+            if (wantsEntering)
+            {
+                return true;
+            }
+        }
+
+        while (m_depth != 0)
+        {
+            Frame& frame = m_stack[m_depth - 1];
+            if (frame.index < frame.children.size())
+            {
+                CardViewNode child;
+                child.m_kind = frame.childKind;
+                child.m_view = frame.children[frame.index++];
+                child.m_isFallbackContent = (frame.list == ChildList::FallbackContent);
+                child.m_isSelectAction = (frame.list == ChildList::SelectAction);
+                Enter(child);
+                if (wantsEntering)
+                {
+                    return true;
+                }
+            }
+            else if (frame.list < frame.lastList)
+            {
+                OpenList(frame, static_cast<ChildList>(static_cast<int>(frame.list) + 1));
+            }
+            else
+            {
+                m_node = frame.node;
+                m_isLeaving = true;
+                m_depth--;
+                if (wantsLeaving)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void CardViewIterator::SkipChildren()
+    {
+        if (!m_isLeaving && m_depth != 0)
+        {
+            Frame& frame = m_stack[m_depth - 1];
+            frame.lastList = frame.list;
+            frame.children.clear();
+        }
+    }
+
+    void CardViewIterator::Enter(const CardViewNode& node)
+    {
+        if (m_depth == m_stack.size())
+        {
+            m_stack.emplace_back();
+        }
+        Frame& frame = m_stack[m_depth++];
+        frame.node = node;
+        frame.list = ChildList::Done;
+        frame.lastList = ChildList::Done;
+        frame.children.clear();
+        frame.index = 0;
+
+        // The type is looked up once and compared against the types with children
+        const ElementView& view = node.m_view;
+        const char* typeBegin = nullptr;
+        const char* typeEnd = nullptr;
+        const uint8_t* typeValue = view.IsValid() ? view.m_reader->FindMember(view.m_value, AdaptiveCardSchemaKey::Type) : nullptr;
+        if (typeValue == nullptr || !view.m_reader->GetString(typeValue, typeBegin, typeEnd))
+        {
+            typeBegin = typeEnd = nullptr;
+        }
+        const auto isType = [typeBegin, typeEnd](const char* type) { return Equals(typeBegin, typeEnd, type, strlen(type)); };
+
+        ChildList firstList = ChildList::None;
+        ChildList lastList = ChildList::None;
+        switch (node.m_kind)
+        {
+        case CardNodeKind::Card:
+            firstList = ChildList::Items;
+            lastList = m_options.includeSelectActions ? ChildList::SelectAction : ChildList::Actions;
+            break;
+        case CardNodeKind::Element:
+            frame.node.m_type = isType("Container") ? ContainerType :
+                                isType("Column") ? ColumnType :
+                                isType("ColumnSet") ? ColumnSetType :
+                                isType("ImageSet") ? ImageSetType :
+                                isType("FactSet") ? FactSetType :
+                                isType("RichTextBlock") ? RichTextBlockType :
+                                isType("ActionSet") ? ActionSetType :
+                                isType("Image") ? ImageType : OtherType;
+            if (frame.node.m_type == ActionSetType)
+            {
+                firstList = ChildList::Actions;
+                lastList = ChildList::Actions;
+            }
+            else if (frame.node.m_type != OtherType && frame.node.m_type != ImageType)
+            {
+                firstList = ChildList::Items;
+                lastList = ChildList::Items;
+            }
+            if (m_options.includeSelectActions)
+            {
+                firstList = (firstList == ChildList::None) ? ChildList::SelectAction : firstList;
+                lastList = ChildList::SelectAction;
+            }
+            if (m_options.includeFallbackContent)
+            {
+                firstList = (firstList == ChildList::None) ? ChildList::FallbackContent : firstList;
+                lastList = ChildList::FallbackContent;
+            }
+            break;
+        case CardNodeKind::Action:
+            frame.node.m_type = isType("Action.ShowCard") ? ShowCardType : OtherType;
+            if (frame.node.m_type == ShowCardType)
+            {
+                firstList = ChildList::Items;
+                lastList = ChildList::Items;
+            }
+            if (m_options.includeFallbackContent)
+            {
+                firstList = (firstList == ChildList::None) ? ChildList::FallbackContent : firstList;
+                lastList = ChildList::FallbackContent;
+            }
+            break;
+        default:
+            // Facts and inlines are leaves
+            break;
+        }
+
+        // As in CardIterator, the first list is read on the next step, so skipped children are never read
+        if (firstList != ChildList::None)
+        {
+            frame.list = static_cast<ChildList>(static_cast<int>(firstList) - 1);
+            frame.lastList = lastList;
+        }
+
+        m_node = frame.node;
+        m_isLeaving = false;
+    }
+
+    void CardViewIterator::OpenList(Frame& frame, ChildList list) const
+    {
+        frame.list = list;
+        frame.childKind = CardNodeKind::Element;
+        frame.children.clear();
+        frame.index = 0;
+
+        const ElementView& view = frame.node.m_view;
+        const int type = frame.node.m_type;
+        ElementView onlyChild;
+        switch (frame.node.m_kind)
+        {
+        case CardNodeKind::Card:
+            switch (list)
+            {
+            case ChildList::Items:
+                view.GetElements(AdaptiveCardSchemaKey::Body, frame.children);
+                break;
+            case ChildList::Actions:
+                frame.childKind = CardNodeKind::Action;
+                view.GetElements(AdaptiveCardSchemaKey::Actions, frame.children);
+                break;
+            case ChildList::SelectAction:
+                frame.childKind = CardNodeKind::Action;
+                if (m_options.includeSelectActions)
+                {
+                    onlyChild = view.GetObject(AdaptiveCardSchemaKey::SelectAction);
+                }
+                break;
+            default:
+                break;
+            }
+            break;
+        case CardNodeKind::Element:
+            switch (list)
+            {
+            case ChildList::Items:
+                switch (type)
+                {
+                case ContainerType:
+                case ColumnType:
+                    view.GetElements(AdaptiveCardSchemaKey::Items, frame.children);
+                    break;
+                case ColumnSetType:
+                    view.GetElements(AdaptiveCardSchemaKey::Columns, frame.children);
+                    break;
+                case ImageSetType:
+                    view.GetElements(AdaptiveCardSchemaKey::Images, frame.children);
+                    break;
+                case FactSetType:
+                    frame.childKind = CardNodeKind::Fact;
+                    view.GetElements(AdaptiveCardSchemaKey::Facts, frame.children);
+                    break;
+                case RichTextBlockType:
+                    frame.childKind = CardNodeKind::Inline;
+                    view.GetElements(AdaptiveCardSchemaKey::Inlines, frame.children);
+                    break;
+                default:
+                    break;
+                }
+                break;
+            case ChildList::Actions:
+                frame.childKind = CardNodeKind::Action;
+                view.GetElements(AdaptiveCardSchemaKey::Actions, frame.children);
+                break;
+            case ChildList::SelectAction:
+                frame.childKind = CardNodeKind::Action;
+                if (m_options.includeSelectActions &&
+                    (type == ImageType || type == ContainerType || type == ColumnType || type == ColumnSetType))
+                {
+                    onlyChild = view.GetObject(AdaptiveCardSchemaKey::SelectAction);
+                }
+                break;
+            case ChildList::FallbackContent:
+                // "drop" isn't an object, so only fallback content is
+                onlyChild = view.GetObject(AdaptiveCardSchemaKey::Fallback);
+                break;
+            default:
+                break;
+            }
+            break;
+        case CardNodeKind::Action:
+            switch (list)
+            {
+            case ChildList::Items:
+                frame.childKind = CardNodeKind::Card;
+                onlyChild = view.GetObject(AdaptiveCardSchemaKey::Card);
+                break;
+            case ChildList::FallbackContent:
+                frame.childKind = CardNodeKind::Action;
+                onlyChild = view.GetObject(AdaptiveCardSchemaKey::Fallback);
+                break;
+            default:
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (onlyChild.IsValid())
+        {
+            frame.children.push_back(onlyChild);
+        }
+    }
+
+    void CardViewIterator::Walk(const CardView& card, CardViewVisitor& visitor, CardIteratorOptions options)
+    {
+        if (options.order == CardTraversalOrder::PostOrder)
+        {
+            options.order = CardTraversalOrder::PreAndPostOrder;
+        }
+        CardViewIterator iterator(card, options);
+        while (iterator.Next())
+        {
+            const CardViewNode& node = iterator.GetNode();
+            if (iterator.IsLeaving())
+            {
+                switch (node.GetKind())
+                {
+                case CardNodeKind::Card:
+                    visitor.LeaveCard(node.GetView());
+                    break;
+                case CardNodeKind::Element:
+                    visitor.LeaveElement(node.GetView());
+                    break;
+                case CardNodeKind::Action:
+                    visitor.LeaveAction(node.GetView());
+                    break;
+                default:
+                    break;
+                }
+                continue;
+            }
+
+            bool walkChildren = true;
+            switch (node.GetKind())
+            {
+            case CardNodeKind::Card:
+                walkChildren = visitor.VisitCard(node.GetView());
+                break;
+            case CardNodeKind::Element:
+                walkChildren = visitor.VisitElement(node.GetView());
+                break;
+            case CardNodeKind::Action:
+                walkChildren = visitor.VisitAction(node.GetView());
+                break;
+            case CardNodeKind::Fact:
+                visitor.VisitFact(node.GetView());
+                break;
+            case CardNodeKind::Inline:
+                visitor.VisitInline(node.GetView());
+                break;
+            }
+
+            if (!walkChildren)
+            {
+                iterator.SkipChildren();
+            }
+        }
+    }
+}
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "BinaryCardFormat.h"
+#include "CardIterator.h"
+#include "RemoteResourceInformation.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // A read-only view of one element, action or other object in a CardView. Properties are read from the buffer when
+    // asked for; a missing property reads as empty (or the given default). ElementViews are only valid while their
+    // CardView is.
+    class ElementView
+    {
+    public:
+        ElementView();
+        ElementView(const BinaryCardReader* reader, const uint8_t* value);
+
+        bool IsValid() const;
+
+        std::string GetElementTypeString() const;
+        std::string GetId() const;
+
+        bool HasProperty(AdaptiveCardSchemaKey key) const;
+        std::string GetString(AdaptiveCardSchemaKey key) const;
+        bool GetBool(AdaptiveCardSchemaKey key, bool defaultValue) const;
+        ElementView GetObject(AdaptiveCardSchemaKey key) const;
+
+        // The objects in an array property such as "body", "items", "columns" or "actions"
+        std::vector<ElementView> GetElements(AdaptiveCardSchemaKey key) const;
+        // As above, replacing what elements held
+        void GetElements(AdaptiveCardSchemaKey key, std::vector<ElementView>& elements) const;
+
+        // Copies a property, or the whole object, out of the buffer
+        Json::Value GetValue(AdaptiveCardSchemaKey key) const;
+        Json::Value ToJson() const;
+
+        // The same resources, in the same order, as GetResourceInformation on the parsed element
+        void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo) const;
+
+    private:
+        bool IsType(const char* type) const;
+        void GetCardResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo) const;
+        void GetBackgroundImageInformation(std::vector<RemoteResourceInformation>& resourceInfo) const;
+        void GetChildrenResourceInformation(AdaptiveCardSchemaKey key, std::vector<RemoteResourceInformation>& resourceInfo) const;
+        ElementView FindElementById(const std::string& id) const;
+
+        const BinaryCardReader* m_reader;
+        const uint8_t* m_value;
+
+        friend class CardView;
+        friend class CardViewIterator;
+    };
+
+    // CardView reads a card straight from a buffer written by AdaptiveCard::SerializeBinary, such as a memory-mapped
+    // cache file, without parsing it into elements. It suits hosts that only need to look a card over (prefetch its
+    // images, find an element, check its version) before deciding whether to parse and render it. The buffer isn't
+    // copied and must outlive the view. CardViewIterator and CardViewVisitor walk it as CardIterator and CardVisitor
+    // walk a parsed card.
+    //
+    // The constructor only checks the buffer's header; the rest is checked as it's read, so any function can throw an
+    // AdaptiveCardParseException with ErrorStatusCode::InvalidJson if the buffer is damaged.
+    class CardView
+    {
+    public:
+        CardView(const uint8_t* data, size_t size);
+
+        ElementView GetRoot() const;
+        std::string GetVersion() const;
+        std::vector<ElementView> GetBody() const;
+        std::vector<ElementView> GetActions() const;
+
+        std::vector<RemoteResourceInformation> GetResourceInformation() const;
+
+        // Searches the body and actions, including nested containers, action sets and the cards of ShowCard actions,
+        // and returns the first element or action with the id, or an invalid view. Fallback content isn't searched.
+        ElementView GetElementById(const std::string& id) const;
+
+    private:
+        // Held by pointer so ElementViews keep pointing at it if the CardView is moved
+        std::unique_ptr<BinaryCardReader> m_reader;
+    };
+
+    class CardViewVisitor;
+
+    // A card, element, action, fact or inline met while walking a CardView, as CardNode is for a parsed card
+    class CardViewNode
+    {
+    public:
+        CardViewNode() : m_kind(CardNodeKind::Card), m_type(0), m_isFallbackContent(false), m_isSelectAction(false) {}
+
+        CardNodeKind GetKind() const { return m_kind; }
+        const ElementView& GetView() const { return m_view; }
+
+        // Whether the node is the fallback content of its parent
+        bool IsFallbackContent() const { return m_isFallbackContent; }
+        // Whether the node is the select action of its parent
+        bool IsSelectAction() const { return m_isSelectAction; }
+
+    private:
+        CardNodeKind m_kind;
+        ElementView m_view;
+        // Which of the types with children the node is, looked up once when it's entered
+        int m_type;
+        bool m_isFallbackContent;
+        bool m_isSelectAction;
+
+        friend class CardViewIterator;
+    };
+
+    // CardViewIterator walks a CardView as CardIterator walks a parsed card: the same nodes, in the same order, with
+    // the same options, so code written against one ports to the other by swapping GetCard, GetElement and the like
+    // for GetView. Children are read from the buffer as the walk gets to them.
+    class CardViewIterator
+    {
+    public:
+        explicit CardViewIterator(const CardView& card, CardIteratorOptions options = {});
+        // Walks only element and what's inside it
+        explicit CardViewIterator(const ElementView& element, CardIteratorOptions options = {});
+
+        void Reset(const CardView& card);
+        void Reset(const ElementView& element);
+
+        bool Next();
+
+        const CardViewNode& GetNode() const { return m_node; }
+        bool IsLeaving() const { return m_isLeaving; }
+        size_t GetDepth() const { return m_isLeaving ? m_depth : m_depth - 1; }
+
+        void SkipChildren();
+
+        // Calls visitor for each node, as CardIterator::Walk does
+        static void Walk(const CardView& card, CardViewVisitor& visitor, CardIteratorOptions options = {});
+
+    private:
+        enum class ChildList
+        {
+            None,
+            Items,
+            Actions,
+            SelectAction,
+            FallbackContent,
+            Done
+        };
+
+        struct Frame
+        {
+            CardViewNode node;
+            ChildList list;
+            ChildList lastList;
+            CardNodeKind childKind;
+            std::vector<ElementView> children;
+            size_t index;
+        };
+
+        void Start(CardNodeKind kind, const ElementView& root);
+        void Enter(const CardViewNode& node);
+        void OpenList(Frame& frame, ChildList list) const;
+
+        CardIteratorOptions m_options;
+        // Frames past m_depth are kept, with their lists of children, for reuse
+        std::vector<Frame> m_stack;
+        size_t m_depth;
+        CardViewNode m_root;
+        CardViewNode m_node;
+        bool m_isStarted;
+        bool m_isLeaving;
+    };
+
+    // CardVisitor for views: the card, element, action, fact and inline methods of CardVisitor, taking ElementViews.
+    // Element and action types can be told apart with GetElementTypeString.
+    class CardViewVisitor
+    {
+    public:
+        virtual ~CardViewVisitor() = default;
+
+        virtual bool VisitCard(const ElementView& /*card*/) { return true; }
+        virtual void LeaveCard(const ElementView& /*card*/) {}
+
+        virtual bool VisitElement(const ElementView& /*element*/) { return true; }
+        virtual void LeaveElement(const ElementView& /*element*/) {}
+
+        virtual bool VisitAction(const ElementView& /*action*/) { return true; }
+        virtual void LeaveAction(const ElementView& /*action*/) {}
+
+        virtual void VisitFact(const ElementView& /*fact*/) {}
+        virtual void VisitInline(const ElementView& /*inlineElement*/) {}
+    };
+}
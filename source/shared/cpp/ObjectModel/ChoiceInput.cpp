@@ -4,6 +4,7 @@
 #include "ChoiceInput.h"
 #include "ParseContext.h"
 #include "ParseUtil.h"
+#include "Util.h"
 
 using namespace AdaptiveSharedNamespace;
 
@@ -11,13 +12,19 @@ ChoiceInput::ChoiceInput()
 {
 }
 
-std::shared_ptr<ChoiceInput> ChoiceInput::Deserialize(ParseContext& /*context*/, const Json::Value& json)
+std::shared_ptr<ChoiceInput> ChoiceInput::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    auto choice = std::make_shared<ChoiceInput>();
+    auto choice = context.MakeShared<ChoiceInput>();
 
     choice->SetTitle(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Title, true));
     choice->SetValue(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Value, true));
 
+    // A choice may be tagged "type": "Input.Choice", which it isn't kept for
+    static const std::unordered_set<std::string> knownProperties{AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title),
+                                                                 AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
+                                                                 AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)};
+    HandleUnknownProperties(json, knownProperties, choice->m_additionalProperties);
+
     return choice;
 }
 
@@ -33,7 +40,7 @@ std::string ChoiceInput::Serialize()
 
 Json::Value ChoiceInput::SerializeToJsonValue()
 {
-    Json::Value root;
+    Json::Value root = m_additionalProperties;
 
     root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title)] = GetTitle();
     root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value)] = GetValue();
@@ -46,6 +53,11 @@ std::string ChoiceInput::GetTitle() const
     return m_title;
 }
 
+const std::string& ChoiceInput::GetTitleRef() const
+{
+    return m_title;
+}
+
 void ChoiceInput::SetTitle(const std::string& title)
 {
     m_title = title;
@@ -56,7 +68,22 @@ std::string ChoiceInput::GetValue() const
     return m_value;
 }
 
+const std::string& ChoiceInput::GetValueRef() const
+{
+    return m_value;
+}
+
 void ChoiceInput::SetValue(const std::string& value)
 {
     m_value = value;
 }
+
+Json::Value ChoiceInput::GetAdditionalProperties() const
+{
+    return m_additionalProperties;
+}
+
+void ChoiceInput::SetAdditionalProperties(const Json::Value& additionalProperties)
+{
+    m_additionalProperties = additionalProperties;
+}
@@ -16,16 +16,23 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue();
 
         std::string GetTitle() const;
+        const std::string& GetTitleRef() const;
         void SetTitle(const std::string& value);
 
         std::string GetValue() const;
+        const std::string& GetValueRef() const;
         void SetValue(const std::string& value);
 
+        // Properties of the choice other than title, value and type, kept so that they survive a round trip
+        Json::Value GetAdditionalProperties() const;
+        void SetAdditionalProperties(const Json::Value& additionalProperties);
+
         static std::shared_ptr<ChoiceInput> Deserialize(ParseContext&, const Json::Value& root);
         static std::shared_ptr<ChoiceInput> DeserializeFromString(ParseContext&, const std::string& jsonString);
 
     private:
         std::string m_title;
         std::string m_value;
+        Json::Value m_additionalProperties;
     };
 }
@@ -0,0 +1,266 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ChoiceList.h"
+#include "ChoiceInput.h"
+#include "ParseUtil.h"
+#include "Util.h"
+
+namespace
+{
+    // FNV-1a; values are hashed straight out of the pool, so std::hash<std::string> won't do
+    size_t HashText(const char* text, size_t length)
+    {
+        uint32_t hash = 2166136261U;
+        for (size_t i = 0; i < length; i++)
+        {
+            hash = (hash ^ static_cast<unsigned char>(text[i])) * 16777619U;
+        }
+        return hash;
+    }
+
+    char ToLowerAscii(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    const size_t ChoiceList::NotFound = std::numeric_limits<size_t>::max();
+
+    size_t ChoiceList::GetCount() const { return m_offsets.empty() ? 0 : (m_offsets.size() - 1) / 2; }
+
+    std::string ChoiceList::GetTitle(size_t index) const
+    {
+        size_t length;
+        const char* title = GetText(2 * index, length);
+        return std::string(title, length);
+    }
+
+    std::string ChoiceList::GetValue(size_t index) const
+    {
+        size_t length;
+        const char* value = GetText(2 * index + 1, length);
+        return std::string(value, length);
+    }
+
+    Json::Value ChoiceList::GetAdditionalProperties(size_t index) const
+    {
+        const auto entry = std::lower_bound(m_additionalProperties.begin(),
+                                            m_additionalProperties.end(),
+                                            index,
+                                            [](const std::pair<uint32_t, Json::Value>& entry, size_t index) { return entry.first < index; });
+        return (entry != m_additionalProperties.end() && entry->first == index) ? entry->second : Json::Value();
+    }
+
+    std::shared_ptr<ChoiceInput> ChoiceList::GetChoice(size_t index) const
+    {
+        auto choice = std::make_shared<ChoiceInput>();
+        choice->SetTitle(GetTitle(index));
+        choice->SetValue(GetValue(index));
+        choice->SetAdditionalProperties(GetAdditionalProperties(index));
+        return choice;
+    }
+
+    size_t ChoiceList::FindValue(const std::string& value) const { return FindValue(value.data(), value.size()); }
+
+    std::vector<size_t> ChoiceList::FindValues(const std::string& values) const
+    {
+        std::vector<size_t> indices;
+        if (values.empty())
+        {
+            return indices;
+        }
+
+        size_t start = 0;
+        while (start <= values.size())
+        {
+            size_t end = values.find(',', start);
+            if (end == std::string::npos)
+            {
+                end = values.size();
+            }
+
+            const size_t index = FindValue(values.data() + start, end - start);
+            if (index != NotFound)
+            {
+                indices.push_back(index);
+            }
+            start = end + 1;
+        }
+        return indices;
+    }
+
+    std::vector<size_t> ChoiceList::FindTitlesWithPrefix(const std::string& prefix, size_t maxResults) const
+    {
+        // Titles starting with prefix are contiguous in m_titleIndex
+        const auto first = std::partition_point(m_titleIndex.begin(), m_titleIndex.end(), [this, &prefix](uint32_t index) {
+            return CompareTitlePrefix(index, prefix) < 0;
+        });
+        const auto last = std::partition_point(first, m_titleIndex.end(), [this, &prefix](uint32_t index) {
+            return CompareTitlePrefix(index, prefix) == 0;
+        });
+
+        std::vector<size_t> indices(first, last);
+        if (maxResults < indices.size())
+        {
+            std::partial_sort(indices.begin(), indices.begin() + maxResults, indices.end());
+            indices.resize(maxResults);
+        }
+        else
+        {
+            std::sort(indices.begin(), indices.end());
+        }
+        return indices;
+    }
+
+    std::shared_ptr<ChoiceList> ChoiceList::Deserialize(ParseContext& context, const Json::Value& choices)
+    {
+        auto choiceList = context.MakeShared<ChoiceList>();
+        choiceList->m_offsets.reserve(2 * choices.size() + 1);
+        static const std::string title = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title);
+        static const std::string value = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value);
+        static const std::string type = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type);
+        static const std::unordered_set<std::string> knownProperties{title, value, type};
+        for (const auto& choice : choices)
+        {
+            // Most choices have only a title and a value, and perhaps a type, which isn't kept; the other properties are
+            // only looked for when there are more
+            Json::Value additionalProperties;
+            if (choice.isObject() &&
+                choice.size() > static_cast<unsigned int>(choice.isMember(title) + choice.isMember(value) + choice.isMember(type)))
+            {
+                HandleUnknownProperties(choice, knownProperties, additionalProperties);
+            }
+            choiceList->Append(ParseUtil::GetString(choice, AdaptiveCardSchemaKey::Title, true),
+                               ParseUtil::GetString(choice, AdaptiveCardSchemaKey::Value, true),
+                               additionalProperties);
+        }
+        choiceList->BuildIndexes();
+        return choiceList;
+    }
+
+    std::shared_ptr<ChoiceList> ChoiceList::FromChoices(const std::vector<std::shared_ptr<ChoiceInput>>& choices)
+    {
+        auto choiceList = std::make_shared<ChoiceList>();
+        choiceList->m_offsets.reserve(2 * choices.size() + 1);
+        for (const auto& choice : choices)
+        {
+            choiceList->Append(choice->GetTitleRef(), choice->GetValueRef(), choice->GetAdditionalProperties());
+        }
+        choiceList->BuildIndexes();
+        return choiceList;
+    }
+
+    void ChoiceList::Append(const std::string& title, const std::string& value, const Json::Value& additionalProperties)
+    {
+        if ((m_pool.size() + title.size() + value.size()) > std::numeric_limits<uint32_t>::max())
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "Choices are too large to store");
+        }
+
+        if (m_offsets.empty())
+        {
+            m_offsets.push_back(0);
+        }
+        m_pool += title;
+        m_offsets.push_back(static_cast<uint32_t>(m_pool.size()));
+        m_pool += value;
+        m_offsets.push_back(static_cast<uint32_t>(m_pool.size()));
+
+        if (!additionalProperties.empty())
+        {
+            m_additionalProperties.emplace_back(static_cast<uint32_t>(GetCount() - 1), additionalProperties);
+        }
+    }
+
+    void ChoiceList::BuildIndexes()
+    {
+        const size_t count = GetCount();
+        m_pool.shrink_to_fit();
+
+        // Keep the hash table at most half full so probe sequences stay short
+        size_t slotCount = 16;
+        while (slotCount < 2 * count)
+        {
+            slotCount *= 2;
+        }
+        m_valueIndex.assign(slotCount, 0);
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t length;
+            const char* value = GetText(2 * i + 1, length);
+
+            // The first choice with a given value wins, as it would when scanning the choices in order
+            if (FindValue(value, length) == NotFound)
+            {
+                size_t slot = HashText(value, length) & (slotCount - 1);
+                while (m_valueIndex[slot] != 0)
+                {
+                    slot = (slot + 1) & (slotCount - 1);
+                }
+                m_valueIndex[slot] = static_cast<uint32_t>(i + 1);
+            }
+        }
+
+        m_titleIndex.resize(count);
+        std::iota(m_titleIndex.begin(), m_titleIndex.end(), 0U);
+        std::stable_sort(m_titleIndex.begin(), m_titleIndex.end(), [this](uint32_t left, uint32_t right) {
+            size_t leftLength, rightLength;
+            const char* leftTitle = GetText(2 * left, leftLength);
+            const char* rightTitle = GetText(2 * right, rightLength);
+            return std::lexicographical_compare(leftTitle, leftTitle + leftLength, rightTitle, rightTitle + rightLength, [](char a, char b) {
+                return ToLowerAscii(a) < ToLowerAscii(b);
+            });
+        });
+    }
+
+    const char* ChoiceList::GetText(size_t offsetIndex, size_t& length) const
+    {
+        const uint32_t start = m_offsets.at(offsetIndex);
+        length = m_offsets.at(offsetIndex + 1) - start;
+        return m_pool.data() + start;
+    }
+
+    size_t ChoiceList::FindValue(const char* value, size_t length) const
+    {
+        if (m_valueIndex.empty())
+        {
+            return NotFound;
+        }
+
+        const size_t mask = m_valueIndex.size() - 1;
+        for (size_t slot = HashText(value, length) & mask; m_valueIndex[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const size_t index = m_valueIndex[slot] - 1;
+            size_t candidateLength;
+            const char* candidate = GetText(2 * index + 1, candidateLength);
+            if (candidateLength == length && std::equal(value, value + length, candidate))
+            {
+                return index;
+            }
+        }
+        return NotFound;
+    }
+
+    // Compares the start of a title with prefix, ignoring ASCII case: negative if the title sorts before every title
+    // starting with prefix, zero if it starts with prefix, and positive if it sorts after them
+    int ChoiceList::CompareTitlePrefix(uint32_t index, const std::string& prefix) const
+    {
+        size_t length;
+        const char* title = GetText(2 * index, length);
+        for (size_t i = 0; i < prefix.size(); i++)
+        {
+            if (i == length)
+            {
+                return -1;
+            }
+
+            const char titleChar = ToLowerAscii(title[i]);
+            const char prefixChar = ToLowerAscii(prefix[i]);
+            if (titleChar != prefixChar)
+            {
+                return (titleChar < prefixChar) ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "ParseContext.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class ChoiceInput;
+
+    // ChoiceList is a compact, read-only store for the choices of a ChoiceSetInput. Rather than one ChoiceInput object
+    // per choice, every title and value lives in a single string pool addressed by offset, with a hash index from value
+    // to choice and a case-insensitive sorted index on titles for filtering. Choices are referred to by their position
+    // in the list. See ParseContext::SetCompactChoiceThreshold and ChoiceSetInput::GetChoiceList.
+    class ChoiceList
+    {
+    public:
+        static const size_t NotFound;
+
+        ChoiceList() = default;
+        ChoiceList(const ChoiceList&) = delete;
+        ChoiceList& operator=(const ChoiceList&) = delete;
+
+        size_t GetCount() const;
+        std::string GetTitle(size_t index) const;
+        std::string GetValue(size_t index) const;
+        // Properties of the choice other than title, value and type (see ChoiceInput::GetAdditionalProperties)
+        Json::Value GetAdditionalProperties(size_t index) const;
+        std::shared_ptr<ChoiceInput> GetChoice(size_t index) const;
+
+        // Returns the index of the first choice with the given value, or NotFound
+        size_t FindValue(const std::string& value) const;
+
+        // Resolves a ChoiceSetInput value (comma-separated when multi-select) to choice indices, skipping values that
+        // don't match any choice
+        std::vector<size_t> FindValues(const std::string& values) const;
+
+        // Returns the choices whose title starts with prefix, ignoring ASCII case, in the order they appear in the list
+        std::vector<size_t> FindTitlesWithPrefix(const std::string& prefix, size_t maxResults = std::numeric_limits<size_t>::max()) const;
+
+        static std::shared_ptr<ChoiceList> Deserialize(ParseContext& context, const Json::Value& choices);
+        static std::shared_ptr<ChoiceList> FromChoices(const std::vector<std::shared_ptr<ChoiceInput>>& choices);
+
+    private:
+        void Append(const std::string& title, const std::string& value, const Json::Value& additionalProperties);
+        void BuildIndexes();
+
+        const char* GetText(size_t offsetIndex, size_t& length) const;
+        size_t FindValue(const char* value, size_t length) const;
+        int CompareTitlePrefix(uint32_t index, const std::string& prefix) const;
+
+        // Titles and values alternate in m_pool. Choice i has its title at [m_offsets[2i], m_offsets[2i + 1]) and its
+        // value at [m_offsets[2i + 1], m_offsets[2i + 2]).
+        std::string m_pool;
+        std::vector<uint32_t> m_offsets;
+
+        // Open-addressed hash table of choice index + 1 (0 marks an empty slot), keyed on value
+        std::vector<uint32_t> m_valueIndex;
+
+        // Choice indices ordered by lowercased title
+        std::vector<uint32_t> m_titleIndex;
+
+        // The additional properties of the few choices that have any, ordered by choice index
+        std::vector<std::pair<uint32_t, Json::Value>> m_additionalProperties;
+    };
+}
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "pch.h"
+#include <mutex>
 #include "ChoiceInput.h"
+#include "ChoiceList.h"
 #include "ChoiceSetInput.h"
 #include "ParseUtil.h"
 #include "Util.h"
@@ -15,14 +17,54 @@ ChoiceSetInput::ChoiceSetInput() :
     PopulateKnownPropertiesSet();
 }
 
+struct ChoiceSetInput::CompactChoices
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ChoiceInput>> choices;
+};
+
 const std::vector<std::shared_ptr<ChoiceInput>>& ChoiceSetInput::GetChoices() const
 {
-    return m_choices;
+    if (!m_choiceList)
+    {
+        return m_choices;
+    }
+
+    std::lock_guard<std::mutex> lock(m_compactChoices->mutex);
+    if (m_compactChoices->choices.size() != m_choiceList->GetCount())
+    {
+        m_compactChoices->choices.clear();
+        m_compactChoices->choices.reserve(m_choiceList->GetCount());
+        for (size_t i = 0; i < m_choiceList->GetCount(); i++)
+        {
+            m_compactChoices->choices.push_back(m_choiceList->GetChoice(i));
+        }
+    }
+    return m_compactChoices->choices;
 }
 
 std::vector<std::shared_ptr<ChoiceInput>>& ChoiceSetInput::GetChoices()
 {
-    return m_choices;
+    return const_cast<std::vector<std::shared_ptr<ChoiceInput>>&>(static_cast<const ChoiceSetInput*>(this)->GetChoices());
+}
+
+void ChoiceSetInput::SetChoices(const std::vector<std::shared_ptr<ChoiceInput>>& choices)
+{
+    m_choices = choices;
+    m_choiceList.reset();
+    m_compactChoices.reset();
+}
+
+std::shared_ptr<const ChoiceList> ChoiceSetInput::GetChoiceList() const
+{
+    return m_choiceList;
+}
+
+void ChoiceSetInput::SetChoiceList(const std::shared_ptr<const ChoiceList>& choiceList)
+{
+    m_choiceList = choiceList;
+    m_compactChoices = choiceList ? std::make_shared<CompactChoices>() : nullptr;
+    m_choices.clear();
 }
 
 Json::Value ChoiceSetInput::SerializeToJsonValue() const
@@ -48,9 +90,22 @@ Json::Value ChoiceSetInput::SerializeToJsonValue() const
 
     std::string propertyName = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Choices);
     root[propertyName] = Json::Value(Json::arrayValue);
-    for (const auto& choice : m_choices)
+    if (m_choiceList)
     {
-        root[propertyName].append(choice->SerializeToJsonValue());
+        for (size_t i = 0; i < m_choiceList->GetCount(); i++)
+        {
+            Json::Value choice = m_choiceList->GetAdditionalProperties(i);
+            choice[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title)] = m_choiceList->GetTitle(i);
+            choice[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value)] = m_choiceList->GetValue(i);
+            root[propertyName].append(choice);
+        }
+    }
+    else
+    {
+        for (const auto& choice : m_choices)
+        {
+            root[propertyName].append(choice->SerializeToJsonValue());
+        }
     }
 
     return root;
@@ -81,6 +136,11 @@ std::string ChoiceSetInput::GetValue() const
     return m_value;
 }
 
+const std::string& ChoiceSetInput::GetValueRef() const
+{
+    return m_value;
+}
+
 void ChoiceSetInput::SetValue(std::string const& value)
 {
     m_value = value;
@@ -109,8 +169,16 @@ std::shared_ptr<BaseCardElement> ChoiceSetInputParser::Deserialize(ParseContext&
     choiceSet->SetWrap(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::Wrap, false, false));
 
     // Parse Choices
-    auto choices = ParseUtil::GetElementCollectionOfSingleType<ChoiceInput>(context, json, AdaptiveCardSchemaKey::Choices, ChoiceInput::Deserialize, true);
-    choiceSet->m_choices = std::move(choices);
+    const Json::Value& choices = json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Choices)];
+    if (context.GetCompactChoiceThreshold() != 0 && choices.isArray() && choices.size() >= context.GetCompactChoiceThreshold())
+    {
+        choiceSet->SetChoiceList(ChoiceList::Deserialize(context, choices));
+    }
+    else
+    {
+        choiceSet->m_choices = ParseUtil::GetElementCollectionOfSingleType<ChoiceInput>(
+            context, json, AdaptiveCardSchemaKey::Choices, ChoiceInput::Deserialize, true);
+    }
 
     return choiceSet;
 }
@@ -123,9 +191,11 @@ ChoiceSetInputParser::DeserializeFromString(ParseContext& context, const std::st
 
 void ChoiceSetInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Choices),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsMultiSelect),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Choices),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsMultiSelect),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap)});
+    m_sharedKnownProperties = &knownProperties;
 }
@@ -8,6 +8,7 @@
 namespace AdaptiveSharedNamespace
 {
     class ChoiceInput;
+    class ChoiceList;
 
     class ChoiceSetInput : public BaseInputElement
     {
@@ -29,10 +30,19 @@ namespace AdaptiveSharedNamespace
         ChoiceSetStyle GetChoiceSetStyle() const;
         void SetChoiceSetStyle(const ChoiceSetStyle choiceSetStyle);
 
+        // When the choices are stored compactly (see GetChoiceList), these return ChoiceInputs created from the list on
+        // first use, and changes made to them aren't kept: change the choices with SetChoices or SetChoiceList.
         std::vector<std::shared_ptr<ChoiceInput>>& GetChoices();
         const std::vector<std::shared_ptr<ChoiceInput>>& GetChoices() const;
+        // Stores the choices as ChoiceInputs, dropping the compact list if there was one
+        void SetChoices(const std::vector<std::shared_ptr<ChoiceInput>>& choices);
+
+        // Returns the choices in compact form when they're stored that way, otherwise null
+        std::shared_ptr<const ChoiceList> GetChoiceList() const;
+        void SetChoiceList(const std::shared_ptr<const ChoiceList>& choiceList);
 
         std::string GetValue() const;
+        const std::string& GetValueRef() const;
         void SetValue(const std::string& value);
 
         bool GetWrap() const;
@@ -47,6 +57,11 @@ namespace AdaptiveSharedNamespace
         ChoiceSetStyle m_choiceSetStyle;
 
         std::vector<std::shared_ptr<ChoiceInput>> m_choices;
+        std::shared_ptr<const ChoiceList> m_choiceList;
+
+        // The ChoiceInputs made from m_choiceList, created under its mutex on first use. Copies of the set share it.
+        struct CompactChoices;
+        std::shared_ptr<CompactChoices> m_compactChoices;
     };
 
     class ChoiceSetInputParser : public BaseCardElementParser
@@ -94,7 +94,7 @@ namespace AdaptiveSharedNamespace
     {
         auto collection = BaseCardElement::Deserialize<T>(context, value);
 
-        auto backgroundImage = ParseUtil::GetBackgroundImage(value);
+        auto backgroundImage = ParseUtil::GetBackgroundImage(context, value);
         collection->SetBackgroundImage(backgroundImage);
 
         bool canFallbackToAncestor = context.GetCanFallbackToAncestor();
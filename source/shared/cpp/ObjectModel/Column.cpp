@@ -18,6 +18,11 @@ std::string Column::GetWidth() const
     return m_width;
 }
 
+const std::string& Column::GetWidthRef() const
+{
+    return m_width;
+}
+
 void Column::SetWidth(const std::string& value)
 {
     SetWidth(value, nullptr);
@@ -80,11 +85,13 @@ Json::Value Column::SerializeToJsonValue() const
 
 void Column::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Items),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Width),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::VerticalContentAlignment)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Items),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Width),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::VerticalContentAlignment)});
+    m_sharedKnownProperties = &knownProperties;
 }
 
 void Column::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
@@ -23,6 +23,7 @@ namespace AdaptiveSharedNamespace
         void DeserializeChildren(ParseContext& context, const Json::Value& value) override;
 
         std::string GetWidth() const;
+        const std::string& GetWidthRef() const;
         void SetWidth(const std::string& value);
         void SetWidth(const std::string& value,
                       std::vector<std::shared_ptr<AdaptiveSharedNamespace::AdaptiveCardParseWarning>>* warnings);
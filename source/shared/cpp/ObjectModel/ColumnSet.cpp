@@ -51,10 +51,12 @@ void ColumnSet::DeserializeChildren(ParseContext& context, const Json::Value& va
 
 void ColumnSet::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Bleed),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Columns),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Bleed),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Columns),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style)});
+    m_sharedKnownProperties = &knownProperties;
 }
 
 void ColumnSet::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
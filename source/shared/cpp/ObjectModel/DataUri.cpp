@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "DataUri.h"
+#include "ResourceLoader.h"
+
+using namespace AdaptiveSharedNamespace;
+
+DataUri::DataUri(std::string uri) : m_uri(std::move(uri))
+{
+    const size_t mediaTypeEnd = std::min(m_uri.find(';'), m_uri.find(','));
+    if (IsDataUri(m_uri) && mediaTypeEnd != std::string::npos)
+    {
+        m_mimeType = m_uri.substr(5, mediaTypeEnd - 5);
+    }
+}
+
+const std::vector<char>& DataUri::GetData() const
+{
+    std::call_once(m_decodeOnce, [this]() {
+        std::string mimeType;
+        LocalResourceTransport::DecodeDataUri(m_uri, mimeType, m_data);
+    });
+    return m_data;
+}
+
+bool DataUri::IsDataUri(const std::string& url)
+{
+    return url.compare(0, 5, "data:") == 0;
+}
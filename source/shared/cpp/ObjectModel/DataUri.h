@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include <mutex>
+
+namespace AdaptiveSharedNamespace
+{
+    // An immutable data: URI, shared by every element that uses the same one instead of each holding a copy. Parsing
+    // interns large data URIs into DataUris (see ParseContext::InternDataUri); Image and BackgroundImage hold them and
+    // return their text from GetUrl.
+    class DataUri
+    {
+    public:
+        explicit DataUri(std::string uri);
+
+        DataUri(const DataUri&) = delete;
+        DataUri& operator=(const DataUri&) = delete;
+
+        // The whole URI, as it appeared in the card
+        const std::string& GetUri() const { return m_uri; }
+        // The media type before any parameters, e.g. "image/png", or empty if the URI doesn't have one
+        const std::string& GetMimeType() const { return m_mimeType; }
+
+        // The decoded content. It's decoded the first time it's asked for, on any thread, and kept.
+        const std::vector<char>& GetData() const;
+
+        static bool IsDataUri(const std::string& url);
+
+    private:
+        const std::string m_uri;
+        std::string m_mimeType;
+        mutable std::once_flag m_decodeOnce;
+        mutable std::vector<char> m_data;
+    };
+}
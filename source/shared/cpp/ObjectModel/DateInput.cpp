@@ -44,6 +44,11 @@ std::string DateInput::GetMax() const
     return m_max;
 }
 
+const std::string& DateInput::GetMaxRef() const
+{
+    return m_max;
+}
+
 void DateInput::SetMax(const std::string& value)
 {
     m_max = value;
@@ -54,6 +59,11 @@ std::string DateInput::GetMin() const
     return m_min;
 }
 
+const std::string& DateInput::GetMinRef() const
+{
+    return m_min;
+}
+
 void DateInput::SetMin(const std::string& value)
 {
     m_min = value;
@@ -64,6 +74,11 @@ std::string DateInput::GetPlaceholder() const
     return m_placeholder;
 }
 
+const std::string& DateInput::GetPlaceholderRef() const
+{
+    return m_placeholder;
+}
+
 void DateInput::SetPlaceholder(const std::string& value)
 {
     m_placeholder = value;
@@ -74,6 +89,11 @@ std::string DateInput::GetValue() const
     return m_value;
 }
 
+const std::string& DateInput::GetValueRef() const
+{
+    return m_value;
+}
+
 void DateInput::SetValue(const std::string& value)
 {
     m_value = value;
@@ -100,8 +120,10 @@ std::shared_ptr<BaseCardElement> DateInputParser::DeserializeFromString(ParseCon
 
 void DateInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder)});
+    m_sharedKnownProperties = &knownProperties;
 }
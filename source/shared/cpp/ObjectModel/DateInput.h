@@ -20,15 +20,19 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue() const override;
 
         std::string GetMax() const;
+        const std::string& GetMaxRef() const;
         void SetMax(const std::string& value);
 
         std::string GetMin() const;
+        const std::string& GetMinRef() const;
         void SetMin(const std::string& value);
 
         std::string GetPlaceholder() const;
+        const std::string& GetPlaceholderRef() const;
         void SetPlaceholder(const std::string& value);
 
         std::string GetValue() const;
+        const std::string& GetValueRef() const;
         void SetValue(const std::string& value);
 
     private:
@@ -2,9 +2,23 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "DateTimePreparsedToken.h"
+#include <iomanip>
 
 using namespace AdaptiveSharedNamespace;
 
+namespace
+{
+    const char* const c_monthNames[] = {
+        "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December"};
+    const char* const c_dayNames[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+
+    bool IsDateFormat(DateTimePreparsedTokenFormat format)
+    {
+        return format == DateTimePreparsedTokenFormat::DateCompact || format == DateTimePreparsedTokenFormat::DateShort ||
+            format == DateTimePreparsedTokenFormat::DateLong;
+    }
+}
+
 DateTimePreparsedToken::DateTimePreparsedToken() :
     m_text(""), m_date{}, m_format(DateTimePreparsedTokenFormat::RegularString)
 {
@@ -25,6 +39,11 @@ std::string DateTimePreparsedToken::GetText() const
     return m_text;
 }
 
+const std::string& DateTimePreparsedToken::GetTextRef() const
+{
+    return m_text;
+}
+
 DateTimePreparsedTokenFormat DateTimePreparsedToken::GetFormat() const
 {
     return m_format;
@@ -44,3 +63,44 @@ int DateTimePreparsedToken::GetYear() const
 {
     return m_date.tm_year + 1900;
 }
+
+std::string DateTimePreparsedToken::GetDisplayText() const
+{
+    if (!IsDateFormat(m_format) || m_date.tm_mon < 0 || m_date.tm_mon > 11 || m_date.tm_wday < 0 || m_date.tm_wday > 6)
+    {
+        return m_text;
+    }
+
+    const std::string day = std::to_string(m_date.tm_mday);
+    const std::string year = std::to_string(GetYear());
+    if (m_format == DateTimePreparsedTokenFormat::DateCompact)
+    {
+        return std::to_string(m_date.tm_mon + 1) + '/' + day + '/' + year;
+    }
+
+    const bool isLong = m_format == DateTimePreparsedTokenFormat::DateLong;
+    const std::string dayName = c_dayNames[m_date.tm_wday];
+    const std::string monthName = c_monthNames[m_date.tm_mon];
+    return (isLong ? dayName : dayName.substr(0, 3)) + ", " + (isLong ? monthName : monthName.substr(0, 3)) + ' ' + day +
+        ", " + year;
+}
+
+std::string DateTimePreparsedToken::GetDisplayText(const std::locale& locale,
+                                                   const char* compactPattern,
+                                                   const char* shortPattern,
+                                                   const char* longPattern) const
+{
+    if (!IsDateFormat(m_format))
+    {
+        return m_text;
+    }
+
+    const char* pattern = (m_format == DateTimePreparsedTokenFormat::DateCompact) ?
+        compactPattern :
+        ((m_format == DateTimePreparsedTokenFormat::DateShort) ? shortPattern : longPattern);
+
+    std::ostringstream formatted;
+    formatted.imbue(locale);
+    formatted << std::put_time(&m_date, pattern);
+    return formatted.str();
+}
@@ -13,6 +13,7 @@ namespace AdaptiveSharedNamespace
         DateTimePreparsedToken(std::string const& text, struct tm date, DateTimePreparsedTokenFormat format);
 
         std::string GetText() const;
+        const std::string& GetTextRef() const;
         DateTimePreparsedTokenFormat GetFormat() const;
         // returns values 1-31
         int GetDay() const;
@@ -21,6 +22,17 @@ namespace AdaptiveSharedNamespace
         // return values 1900 onward
         int GetYear() const;
 
+        // Returns the text to display for this token: en-US dates (e.g. "2/13/2017", "Mon, Feb 13, 2017" and
+        // "Monday, February 13, 2017") for date tokens, and GetText() for everything else.
+        std::string GetDisplayText() const;
+
+        // As above, but dates are written with the locale's time_put facet using the strftime-style pattern for the
+        // token's format, so month and day names follow the locale.
+        std::string GetDisplayText(const std::locale& locale,
+                                   const char* compactPattern = "%x",
+                                   const char* shortPattern = "%a, %b %d, %Y",
+                                   const char* longPattern = "%A, %B %d, %Y") const;
+
     private:
         std::string m_text;
         struct tm m_date;
@@ -373,6 +373,7 @@ namespace AdaptiveSharedNamespace
         UnsupportedParserOverride,
         IdCollision,
         CustomError,
+        ParseLimitExceeded,
     };
     // No mapping to string needed
 
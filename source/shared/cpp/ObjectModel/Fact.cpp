@@ -20,7 +20,7 @@ std::shared_ptr<Fact> Fact::Deserialize(const ParseContext& context, const Json:
     std::string title = ParseUtil::GetString(json, AdaptiveCardSchemaKey::Title, true);
     std::string value = ParseUtil::GetString(json, AdaptiveCardSchemaKey::Value, true);
 
-    auto fact = std::make_shared<Fact>(title, value);
+    auto fact = context.MakeShared<Fact>(title, value);
     fact->SetLanguage(context.GetLanguage());
 
     return fact;
@@ -50,6 +50,11 @@ std::string Fact::GetTitle() const
     return m_title;
 }
 
+const std::string& Fact::GetTitleRef() const
+{
+    return m_title;
+}
+
 void Fact::SetTitle(const std::string& value)
 {
     m_title = value;
@@ -60,6 +65,11 @@ std::string Fact::GetValue() const
     return m_value;
 }
 
+const std::string& Fact::GetValueRef() const
+{
+    return m_value;
+}
+
 void Fact::SetValue(const std::string& value)
 {
     m_value = value;
@@ -80,6 +90,11 @@ std::string Fact::GetLanguage() const
     return m_language;
 }
 
+const std::string& Fact::GetLanguageRef() const
+{
+    return m_language;
+}
+
 void Fact::SetLanguage(const std::string& value)
 {
     m_language = value;
@@ -18,15 +18,18 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue();
 
         std::string GetTitle() const;
+        const std::string& GetTitleRef() const;
         void SetTitle(const std::string& value);
 
         std::string GetValue() const;
+        const std::string& GetValueRef() const;
         void SetValue(const std::string& value);
         DateTimePreparser GetTitleForDateParsing() const;
         DateTimePreparser GetValueForDateParsing() const;
 
         void SetLanguage(const std::string& value);
         std::string GetLanguage() const;
+        const std::string& GetLanguageRef() const;
 
         static std::shared_ptr<Fact> Deserialize(const ParseContext& context, const Json::Value& root);
         static std::shared_ptr<Fact> DeserializeFromString(const ParseContext& context, const std::string& jsonString);
@@ -0,0 +1,285 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "FallbackResolver.h"
+#include "ActionSet.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "ImageSet.h"
+#include "ShowCardAction.h"
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    // Walks a card as a renderer would, recording for each element and action what's rendered in its place
+    class FallbackResolutionBuilder
+    {
+    public:
+        FallbackResolutionBuilder(const FeatureRegistration& featureRegistration,
+                                  const std::unordered_set<std::string>& elementTypes,
+                                  const std::unordered_set<std::string>& actionTypes,
+                                  std::unordered_map<InternalId, const BaseElement*, InternalIdKeyHash>& rendered,
+                                  std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& warnings) :
+            m_featureRegistration(featureRegistration),
+            m_elementTypes(elementTypes), m_actionTypes(actionTypes), m_rendered(rendered),
+            m_warnings(warnings)
+        {
+        }
+
+        void ResolveCard(const AdaptiveCard& card)
+        {
+            // A card has no ancestor to fall back to, so everything in it resolves
+            for (const auto& element : card.GetBody())
+            {
+                ResolveElement(*element, false);
+            }
+            for (const auto& action : card.GetActions())
+            {
+                ResolveAction(*action, false);
+            }
+        }
+
+    private:
+        // Returns false when the element can't be rendered and has to be replaced by an ancestor's fallback
+        bool ResolveElement(const BaseCardElement& element, bool ancestorHasFallback)
+        {
+            const bool hasFallback = (element.GetFallbackType() != FallbackType::None);
+            if (IsSupported(element, m_elementTypes) && ResolveChildren(element, hasFallback || ancestorHasFallback))
+            {
+                m_rendered[element.GetInternalId()] = &element;
+                return true;
+            }
+            return ResolveFallback(element, element, false, ancestorHasFallback);
+        }
+
+        bool ResolveAction(const BaseActionElement& action, bool ancestorHasFallback)
+        {
+            if (IsSupported(action, m_actionTypes))
+            {
+                ResolveShowCard(action);
+                m_rendered[action.GetInternalId()] = &action;
+                return true;
+            }
+            return ResolveFallback(action, action, true, ancestorHasFallback);
+        }
+
+        bool ResolveChildren(const BaseCardElement& element, bool ancestorHasFallback)
+        {
+            switch (element.GetElementType())
+            {
+            case CardElementType::Container:
+                return ResolveElements(static_cast<const Container&>(element).GetItems(), ancestorHasFallback);
+            case CardElementType::Column:
+                return ResolveElements(static_cast<const Column&>(element).GetItems(), ancestorHasFallback);
+            case CardElementType::ColumnSet:
+                return ResolveElements(static_cast<const ColumnSet&>(element).GetColumns(), ancestorHasFallback);
+            case CardElementType::ImageSet:
+                return ResolveElements(static_cast<const ImageSet&>(element).GetImages(), ancestorHasFallback);
+            case CardElementType::ActionSet:
+                for (const auto& action : static_cast<const ActionSet&>(element).GetActions())
+                {
+                    if (!ResolveAction(*action, ancestorHasFallback))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            default:
+                return true;
+            }
+        }
+
+        template<typename T> bool ResolveElements(const std::vector<std::shared_ptr<T>>& elements, bool ancestorHasFallback)
+        {
+            for (const auto& element : elements)
+            {
+                if (!ResolveElement(*element, ancestorHasFallback))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Resolves what replaces original, once failed (original itself or fallback content standing in for it) can't
+        // be rendered
+        bool ResolveFallback(const BaseElement& original, const BaseElement& failed, bool isAction, bool ancestorHasFallback)
+        {
+            switch (failed.GetFallbackType())
+            {
+            case FallbackType::Content:
+            {
+                const auto fallback = failed.GetFallbackContent();
+                if (!fallback)
+                {
+                    break;
+                }
+                AddWarning(isAction ? WarningStatusCode::UnknownActionElementType : WarningStatusCode::UnknownElementType,
+                           "Performing fallback for '" + failed.GetElementTypeStringRef() + "' (fallback element type: '" +
+                               fallback->GetElementTypeStringRef() + "')");
+
+                const bool fallbackHasFallback = (fallback->GetFallbackType() != FallbackType::None);
+                bool isRendered;
+                if (isAction)
+                {
+                    isRendered = IsSupported(*fallback, m_actionTypes);
+                    if (isRendered)
+                    {
+                        ResolveShowCard(static_cast<const BaseActionElement&>(*fallback));
+                    }
+                }
+                else
+                {
+                    isRendered = IsSupported(*fallback, m_elementTypes) &&
+                                 ResolveChildren(static_cast<const BaseCardElement&>(*fallback), fallbackHasFallback || ancestorHasFallback);
+                }
+
+                if (isRendered)
+                {
+                    m_rendered[fallback->GetInternalId()] = fallback.get();
+                    m_rendered[original.GetInternalId()] = fallback.get();
+                    return true;
+                }
+                return ResolveFallback(original, *fallback, isAction, ancestorHasFallback);
+            }
+            case FallbackType::Drop:
+                AddWarning(isAction ? WarningStatusCode::UnknownActionElementType : WarningStatusCode::UnknownElementType,
+                           "Dropping element '" + failed.GetElementTypeStringRef() + "' for fallback");
+                m_rendered[original.GetInternalId()] = nullptr;
+                return true;
+            default:
+                break;
+            }
+
+            if (ancestorHasFallback)
+            {
+                return false;
+            }
+            AddWarning(WarningStatusCode::NoRendererForType, "No Renderer found for type: " + failed.GetElementTypeStringRef());
+            m_rendered[original.GetInternalId()] = nullptr;
+            return true;
+        }
+
+        // The card of a ShowCard action is shown on its own, so it's resolved with no ancestor to fall back to. A
+        // deferred card isn't parsed to resolve it.
+        void ResolveShowCard(const BaseActionElement& action)
+        {
+            if (action.GetElementType() == ActionType::ShowCard && !static_cast<const ShowCardAction&>(action).IsCardDeferred())
+            {
+                const auto card = static_cast<const ShowCardAction&>(action).GetCard();
+                if (card)
+                {
+                    ResolveCard(*card);
+                }
+            }
+        }
+
+        bool IsSupported(const BaseElement& element, const std::unordered_set<std::string>& types) const
+        {
+            return (types.find(element.GetElementTypeStringRef()) != types.end()) && element.MeetsRequirements(m_featureRegistration);
+        }
+
+        void AddWarning(WarningStatusCode statusCode, const std::string& message)
+        {
+            m_warnings.push_back(std::make_shared<AdaptiveCardParseWarning>(statusCode, message));
+        }
+
+        const FeatureRegistration& m_featureRegistration;
+        const std::unordered_set<std::string>& m_elementTypes;
+        const std::unordered_set<std::string>& m_actionTypes;
+        std::unordered_map<InternalId, const BaseElement*, InternalIdKeyHash>& m_rendered;
+        std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& m_warnings;
+    };
+}
+
+const BaseElement* FallbackResolution::GetRendered(const InternalId& id) const
+{
+    const auto found = m_rendered.find(id);
+    return (found != m_rendered.end()) ? found->second : nullptr;
+}
+
+const BaseCardElement* FallbackResolution::GetRenderedElement(const BaseCardElement& element) const
+{
+    return static_cast<const BaseCardElement*>(GetRendered(element.GetInternalId()));
+}
+
+const BaseActionElement* FallbackResolution::GetRenderedAction(const BaseActionElement& action) const
+{
+    return static_cast<const BaseActionElement*>(GetRendered(action.GetInternalId()));
+}
+
+FallbackResolver::FallbackResolver(const FeatureRegistration& featureRegistration,
+                                   std::unordered_set<std::string> elementTypes,
+                                   std::unordered_set<std::string> actionTypes) :
+    m_featureRegistration(featureRegistration),
+    m_elementTypes(std::move(elementTypes)), m_actionTypes(std::move(actionTypes))
+{
+}
+
+std::unordered_set<std::string> FallbackResolver::GetBuiltInElementTypes()
+{
+    std::unordered_set<std::string> types;
+    for (const auto type : {CardElementType::ActionSet,
+                            CardElementType::ChoiceSetInput,
+                            CardElementType::Column,
+                            CardElementType::ColumnSet,
+                            CardElementType::Container,
+                            CardElementType::DateInput,
+                            CardElementType::FactSet,
+                            CardElementType::Image,
+                            CardElementType::ImageSet,
+                            CardElementType::Media,
+                            CardElementType::NumberInput,
+                            CardElementType::RichTextBlock,
+                            CardElementType::TextBlock,
+                            CardElementType::TextInput,
+                            CardElementType::TimeInput,
+                            CardElementType::ToggleInput})
+    {
+        types.insert(CardElementTypeToString(type));
+    }
+    return types;
+}
+
+std::unordered_set<std::string> FallbackResolver::GetBuiltInActionTypes()
+{
+    std::unordered_set<std::string> types;
+    for (const auto type : {ActionType::OpenUrl, ActionType::ShowCard, ActionType::Submit, ActionType::ToggleVisibility})
+    {
+        types.insert(ActionTypeToString(type));
+    }
+    return types;
+}
+
+std::shared_ptr<const FallbackResolution> FallbackResolver::Resolve(const std::shared_ptr<AdaptiveCard>& card)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        const auto cached = m_cache.find(card->GetInternalId());
+        if (cached != m_cache.end() && cached->second.card.lock() == card)
+        {
+            return cached->second.resolution;
+        }
+    }
+
+    // Resolved outside the lock, so that resolving one card doesn't hold up finding another in the cache
+    auto resolution = std::make_shared<FallbackResolution>();
+    FallbackResolutionBuilder builder(m_featureRegistration, m_elementTypes, m_actionTypes, resolution->m_rendered, resolution->m_warnings);
+    builder.ResolveCard(*card);
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    for (auto entry = m_cache.begin(); entry != m_cache.end();)
+    {
+        entry = entry->second.card.expired() ? m_cache.erase(entry) : std::next(entry);
+    }
+    m_cache[card->GetInternalId()] = {card, resolution};
+    return resolution;
+}
+
+void FallbackResolver::Invalidate(const AdaptiveCard& card)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cache.erase(card.GetInternalId());
+}
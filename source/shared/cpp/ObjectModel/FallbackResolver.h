@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include <mutex>
+#include "AdaptiveCardParseWarning.h"
+#include "FeatureRegistration.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // The fallback decisions for every element and action of a card, made once for one host. Renderers look up each
+    // element as they reach it instead of checking its requirements and walking its fallback content themselves.
+    // A FallbackResolution doesn't own the card; the card has to outlive it.
+    class FallbackResolution
+    {
+    public:
+        // What to render in place of the element or action with this id. That's the element itself, the fallback
+        // content that replaces it, or nullptr if it's dropped. Also nullptr for elements the resolution didn't
+        // reach, such as those in fallback content that isn't used.
+        const BaseElement* GetRendered(const InternalId& id) const;
+        const BaseCardElement* GetRenderedElement(const BaseCardElement& element) const;
+        const BaseActionElement* GetRenderedAction(const BaseActionElement& action) const;
+
+        // The warnings a renderer would give while falling back, in document order
+        const std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& GetWarnings() const { return m_warnings; }
+
+    private:
+        std::unordered_map<InternalId, const BaseElement*, InternalIdKeyHash> m_rendered;
+        std::vector<std::shared_ptr<AdaptiveCardParseWarning>> m_warnings;
+
+        friend class FallbackResolver;
+    };
+
+    // FallbackResolver resolves fallback as the renderers do, for a host that provides the features in a
+    // FeatureRegistration and has renderers for a set of element and action types (matched against
+    // GetElementTypeString). An element is rendered when the host has a renderer for its type, meets its requirements
+    // and can render all its children. Otherwise it falls back: to its fallback content, which is checked the same
+    // way and can fall back in turn; by being dropped; or, with no fallback of its own, to the nearest ancestor with
+    // fallback, being dropped if there's none. The cards of ShowCard actions are resolved too, each on its own, except
+    // cards whose parsing is deferred and hasn't happened yet; Invalidate the card once they're parsed.
+    //
+    // Resolutions are cached per card, so a host keeps one FallbackResolver for its registration and resolves each
+    // card once, however often it's rendered. It's safe to use from several threads.
+    class FallbackResolver
+    {
+    public:
+        FallbackResolver(const FeatureRegistration& featureRegistration,
+                         std::unordered_set<std::string> elementTypes = GetBuiltInElementTypes(),
+                         std::unordered_set<std::string> actionTypes = GetBuiltInActionTypes());
+
+        // The types of the elements and actions the platform renderers render
+        static std::unordered_set<std::string> GetBuiltInElementTypes();
+        static std::unordered_set<std::string> GetBuiltInActionTypes();
+
+        // Resolves card, or returns its resolution from the cache. The cached resolution is of the card as it was
+        // first resolved; call Invalidate after changing the card.
+        std::shared_ptr<const FallbackResolution> Resolve(const std::shared_ptr<AdaptiveCard>& card);
+        void Invalidate(const AdaptiveCard& card);
+
+    private:
+        struct CacheEntry
+        {
+            std::weak_ptr<AdaptiveCard> card;
+            std::shared_ptr<const FallbackResolution> resolution;
+        };
+
+        const FeatureRegistration m_featureRegistration;
+        const std::unordered_set<std::string> m_elementTypes;
+        const std::unordered_set<std::string> m_actionTypes;
+
+        std::mutex m_cacheMutex;
+        std::unordered_map<InternalId, CacheEntry, InternalIdKeyHash> m_cache;
+    };
+}
@@ -672,6 +672,11 @@ std::string HostConfig::GetFontFamily() const
     return _fontFamily;
 }
 
+const std::string& HostConfig::GetFontFamilyRef() const
+{
+    return _fontFamily;
+}
+
 void HostConfig::SetFontFamily(const std::string& value)
 {
     _fontFamily = value;
@@ -722,6 +727,11 @@ std::string HostConfig::GetImageBaseUrl() const
     return _imageBaseUrl;
 }
 
+const std::string& HostConfig::GetImageBaseUrlRef() const
+{
+    return _imageBaseUrl;
+}
+
 void HostConfig::SetImageBaseUrl(const std::string& value)
 {
     _imageBaseUrl = value;
@@ -325,6 +325,7 @@ namespace AdaptiveSharedNamespace
         unsigned int GetBorderThickness(ContainerStyle style) const;
 
         std::string GetFontFamily() const;
+        const std::string& GetFontFamilyRef() const;
         void SetFontFamily(const std::string& value);
 
         FontSizesConfig GetFontSizes() const;
@@ -340,6 +341,7 @@ namespace AdaptiveSharedNamespace
         void SetSupportsInteractivity(const bool value);
 
         std::string GetImageBaseUrl() const;
+        const std::string& GetImageBaseUrlRef() const;
         void SetImageBaseUrl(const std::string& value);
 
         ImageSizesConfig GetImageSizes() const;
@@ -0,0 +1,1423 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "HtmlRenderer.h"
+#include <cstring>
+#include "ActionSet.h"
+#include "BackgroundImage.h"
+#include "ChoiceInput.h"
+#include "ChoiceSetInput.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "DateTimePreparser.h"
+#include "Fact.h"
+#include "FactSet.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "MarkDownParser.h"
+#include "Media.h"
+#include "MediaSource.h"
+#include "NumberInput.h"
+#include "OpenUrlAction.h"
+#include "RichTextBlock.h"
+#include "TextBlock.h"
+#include "TextInput.h"
+#include "TextRun.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+
+namespace AdaptiveSharedNamespace
+{
+    namespace
+    {
+        constexpr const char* c_presentationTable = "table role=\"presentation\" cellpadding=\"0\" cellspacing=\"0\"";
+
+        void AppendNumber(std::string& output, unsigned int value)
+        {
+            char buffer[10];
+            char* end = buffer + sizeof(buffer);
+            char* begin = end;
+            do
+            {
+                *--begin = static_cast<char>('0' + (value % 10));
+                value /= 10;
+            } while (value != 0);
+            output.append(begin, end);
+        }
+
+        void AppendNumber(std::string& output, int value)
+        {
+            if (value < 0)
+            {
+                output += '-';
+                AppendNumber(output, static_cast<unsigned int>(-(static_cast<long long>(value))));
+            }
+            else
+            {
+                AppendNumber(output, static_cast<unsigned int>(value));
+            }
+        }
+
+        void AppendPixels(std::string& output, const char* property, unsigned int value)
+        {
+            output += property;
+            output += ':';
+            AppendNumber(output, value);
+            output += "px;";
+        }
+
+        // Escapes text for use in element content and in double- or single-quoted attribute values.
+        void AppendEscaped(std::string& output, const std::string& text)
+        {
+            size_t runStart = 0;
+            for (size_t i = 0; i < text.size(); i++)
+            {
+                const char* replacement;
+                switch (text[i])
+                {
+                case '&':
+                    replacement = "&amp;";
+                    break;
+                case '<':
+                    replacement = "&lt;";
+                    break;
+                case '>':
+                    replacement = "&gt;";
+                    break;
+                case '"':
+                    replacement = "&quot;";
+                    break;
+                case '\'':
+                    replacement = "&#39;";
+                    break;
+                default:
+                    continue;
+                }
+                output.append(text, runStart, i - runStart);
+                output += replacement;
+                runStart = i + 1;
+            }
+            output.append(text, runStart, std::string::npos);
+        }
+
+        void AppendAttribute(std::string& output, const char* name, const std::string& value)
+        {
+            if (!value.empty())
+            {
+                output += ' ';
+                output += name;
+                output += "=\"";
+                AppendEscaped(output, value);
+                output += '"';
+            }
+        }
+
+        int HexValue(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                return c - 'A' + 10;
+            }
+            return 0;
+        }
+
+        // Converts a HostConfig color ("#AARRGGBB" or "#RRGGBB") to CSS.
+        std::string ToCssColor(const std::string& color)
+        {
+            if (color.size() != 9 && color.size() != 7)
+            {
+                return "inherit";
+            }
+
+            const size_t rgbStart = color.size() - 6;
+            unsigned int alpha = (color.size() == 9) ? (HexValue(color[1]) * 16 + HexValue(color[2])) : 255;
+
+            std::string result = "rgba(";
+            for (size_t i = 0; i < 3; i++)
+            {
+                AppendNumber(result, static_cast<unsigned int>(HexValue(color[rgbStart + i * 2]) * 16 + HexValue(color[rgbStart + i * 2 + 1])));
+                result += ',';
+            }
+
+            // Two decimal places are as precise as an 8-bit alpha channel.
+            const unsigned int hundredths = (alpha * 100 + 127) / 255;
+            AppendNumber(result, hundredths / 100);
+            result += '.';
+            result += static_cast<char>('0' + (hundredths / 10) % 10);
+            result += static_cast<char>('0' + hundredths % 10);
+            result += ')';
+            return result;
+        }
+
+        // Blocks script and other active URL schemes from href and src attributes. Browsers ignore tabs and newlines
+        // inside a scheme, so they're skipped here as well.
+        bool IsSafeUrl(const std::string& url)
+        {
+            std::string scheme;
+            for (const char c : url)
+            {
+                if (c == ':')
+                {
+                    if (scheme == "javascript" || scheme == "vbscript")
+                    {
+                        return false;
+                    }
+                    if (scheme == "data")
+                    {
+                        // Only raster images: the media type, up to the first ';' or ',', has to be image/ and not SVG
+                        std::string mediaType;
+                        for (size_t i = url.find(':') + 1; i < url.size() && url[i] != ';' && url[i] != ','; i++)
+                        {
+                            if (static_cast<unsigned char>(url[i]) > ' ')
+                            {
+                                mediaType += static_cast<char>(std::tolower(static_cast<unsigned char>(url[i])));
+                            }
+                        }
+                        return mediaType.compare(0, 6, "image/") == 0 && mediaType.compare(0, 9, "image/svg") != 0;
+                    }
+                    return true;
+                }
+                if (c == '/' || c == '?' || c == '#')
+                {
+                    return true;
+                }
+                if (c == '\t' || c == '\n' || c == '\r' || (scheme.empty() && static_cast<unsigned char>(c) <= ' '))
+                {
+                    continue;
+                }
+                scheme += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            return true;
+        }
+
+        bool IsAbsoluteUrl(const std::string& url)
+        {
+            const size_t schemeEnd = url.find(':');
+            return schemeEnd != std::string::npos && url.find_first_of("/?#") > schemeEnd;
+        }
+
+        bool IsOpenUrlAction(const std::shared_ptr<BaseActionElement>& action)
+        {
+            return action && action->GetElementType() == ActionType::OpenUrl &&
+                IsSafeUrl(std::static_pointer_cast<OpenUrlAction>(action)->GetUrlRef());
+        }
+
+        bool IsInputElement(CardElementType type)
+        {
+            switch (type)
+            {
+            case CardElementType::ChoiceSetInput:
+            case CardElementType::DateInput:
+            case CardElementType::NumberInput:
+            case CardElementType::TextInput:
+            case CardElementType::TimeInput:
+            case CardElementType::ToggleInput:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        const char* GetTextAlign(HorizontalAlignment alignment)
+        {
+            switch (alignment)
+            {
+            case HorizontalAlignment::Center:
+                return "text-align:center;";
+            case HorizontalAlignment::Right:
+                return "text-align:right;";
+            default:
+                return "";
+            }
+        }
+
+        const char* GetVerticalAlign(VerticalContentAlignment alignment)
+        {
+            switch (alignment)
+            {
+            case VerticalContentAlignment::Center:
+                return "vertical-align:middle;";
+            case VerticalContentAlignment::Bottom:
+                return "vertical-align:bottom;";
+            default:
+                return "vertical-align:top;";
+            }
+        }
+
+        void AppendMinHeight(std::string& output, unsigned int minHeight, VerticalContentAlignment alignment)
+        {
+            if (minHeight != 0)
+            {
+                AppendPixels(output, "min-height", minHeight);
+                if (alignment == VerticalContentAlignment::Center)
+                {
+                    output += "display:flex;flex-direction:column;justify-content:center;";
+                }
+                else if (alignment == VerticalContentAlignment::Bottom)
+                {
+                    output += "display:flex;flex-direction:column;justify-content:flex-end;";
+                }
+            }
+        }
+
+        // Returns the column's relative width, or 0 for auto and pixel-sized columns.
+        double GetColumnWeight(const Column& column)
+        {
+            if (column.GetPixelWidth() > 0)
+            {
+                return 0;
+            }
+
+            const std::string& width = column.GetWidthRef();
+            if (width.empty() || ParseUtil::ToLowercase(width) == "stretch")
+            {
+                return 1;
+            }
+
+            const double weight = std::strtod(width.c_str(), nullptr);
+            return (weight > 0) ? weight : 0;
+        }
+
+        // Formats {{DATE()}} tokens in en-US. {{TIME()}} tokens arrive already formatted by the preparser.
+        std::string FormatDateTimeTokens(const DateTimePreparser& preparser)
+        {
+            std::string result;
+            for (const auto& token : preparser.GetTextTokens())
+            {
+                result += token->GetDisplayText();
+            }
+            return result;
+        }
+
+        std::string FormatText(const std::string& text)
+        {
+            // Constructing a DateTimePreparser runs its regex over the whole string, so skip it when there's nothing to find.
+            return (text.find("{{") == std::string::npos) ? text : FormatDateTimeTokens(DateTimePreparser(text));
+        }
+    }
+
+    HtmlRenderer::HtmlRenderer(const HostConfig& hostConfig) :
+        m_padding(hostConfig.GetSpacing().paddingSpacing), m_imageSize(hostConfig.GetImage().imageSize),
+        m_imageSetImageSize(hostConfig.GetImageSet().imageSize), m_imageSetMaxHeight(hostConfig.GetImageSet().maxImageHeight),
+        m_factSet(hostConfig.GetFactSet()), m_actions(hostConfig.GetActions()), m_imageBaseUrl(hostConfig.GetImageBaseUrlRef()),
+        m_supportsInteractivity(hostConfig.GetSupportsInteractivity())
+    {
+        for (int style = 0; style < 7; style++)
+        {
+            const auto containerStyle = static_cast<ContainerStyle>(style);
+            m_backgroundColors[style] = ToCssColor(hostConfig.GetBackgroundColor(containerStyle));
+            for (int color = 0; color < 7; color++)
+            {
+                for (int isSubtle = 0; isSubtle < 2; isSubtle++)
+                {
+                    const auto foregroundColor = static_cast<ForegroundColor>(color);
+                    m_foregroundColors[style][color][isSubtle] =
+                        ToCssColor(hostConfig.GetForegroundColor(containerStyle, foregroundColor, isSubtle != 0));
+                    m_highlightColors[style][color][isSubtle] =
+                        ToCssColor(hostConfig.GetHighlightColor(containerStyle, foregroundColor, isSubtle != 0));
+                }
+            }
+        }
+
+        for (int fontType = 0; fontType < 2; fontType++)
+        {
+            const auto type = static_cast<FontType>(fontType);
+            AppendEscaped(m_fontFamilies[fontType], hostConfig.GetFontFamily(type));
+            for (int size = 0; size < 5; size++)
+            {
+                m_fontSizes[fontType][size] = hostConfig.GetFontSize(type, static_cast<TextSize>(size));
+            }
+            for (int weight = 0; weight < 3; weight++)
+            {
+                m_fontWeights[fontType][weight] = hostConfig.GetFontWeight(type, static_cast<TextWeight>(weight));
+            }
+        }
+
+        const auto spacing = hostConfig.GetSpacing();
+        m_spacing[static_cast<int>(Spacing::Default)] = spacing.defaultSpacing;
+        m_spacing[static_cast<int>(Spacing::None)] = 0;
+        m_spacing[static_cast<int>(Spacing::Small)] = spacing.smallSpacing;
+        m_spacing[static_cast<int>(Spacing::Medium)] = spacing.mediumSpacing;
+        m_spacing[static_cast<int>(Spacing::Large)] = spacing.largeSpacing;
+        m_spacing[static_cast<int>(Spacing::ExtraLarge)] = spacing.extraLargeSpacing;
+        m_spacing[static_cast<int>(Spacing::Padding)] = spacing.paddingSpacing;
+
+        const auto imageSizes = hostConfig.GetImageSizes();
+        m_imageSizes[static_cast<int>(ImageSize::None)] = 0;
+        m_imageSizes[static_cast<int>(ImageSize::Auto)] = 0;
+        m_imageSizes[static_cast<int>(ImageSize::Stretch)] = 0;
+        m_imageSizes[static_cast<int>(ImageSize::Small)] = imageSizes.smallSize;
+        m_imageSizes[static_cast<int>(ImageSize::Medium)] = imageSizes.mediumSize;
+        m_imageSizes[static_cast<int>(ImageSize::Large)] = imageSizes.largeSize;
+
+        const auto separator = hostConfig.GetSeparator();
+        m_separator = "border-top:";
+        AppendNumber(m_separator, separator.lineThickness);
+        m_separator += "px solid ";
+        m_separator += ToCssColor(separator.lineColor);
+        m_separator += ';';
+
+        const int defaultStyle = Index(ContainerStyle::Default);
+        const auto& accent = m_foregroundColors[defaultStyle][static_cast<int>(ForegroundColor::Accent)][0];
+        m_buttonStyle = "box-sizing:border-box;padding:6px 12px;text-align:center;text-decoration:none;font-family:inherit;";
+        AppendPixels(m_buttonStyle, "font-size", m_fontSizes[0][static_cast<int>(TextSize::Default)]);
+        m_buttonStyle += "color:";
+        m_buttonStyle += accent;
+        m_buttonStyle += ";border:1px solid ";
+        m_buttonStyle += accent;
+        m_buttonStyle += ";background-color:";
+        m_buttonStyle += m_backgroundColors[defaultStyle];
+        m_buttonStyle += ';';
+    }
+
+    std::string HtmlRenderer::Render(const AdaptiveCard& card) const
+    {
+        std::string output;
+        Render(card, output);
+        return output;
+    }
+
+    void HtmlRenderer::Render(const AdaptiveCard& card, std::string& output) const
+    {
+        const ContainerStyle style = (card.GetStyle() == ContainerStyle::None) ? ContainerStyle::Default : card.GetStyle();
+
+        output += "<div class=\"ac-adaptiveCard\"";
+        AppendAttribute(output, "lang", card.GetLanguageRef());
+        output += " style=\"";
+        if (!m_fontFamilies[0].empty())
+        {
+            output += "font-family:";
+            output += m_fontFamilies[0];
+            output += ';';
+        }
+        output += "background-color:";
+        output += m_backgroundColors[Index(style)];
+        output += ';';
+        AppendPixels(output, "padding", m_padding);
+        AppendMinHeight(output, card.GetMinHeight(), card.GetVerticalContentAlignment());
+        if (const auto backgroundImage = card.GetBackgroundImage())
+        {
+            AppendBackgroundImage(*backgroundImage, output);
+        }
+        output += "\">";
+
+        const bool hasLink = OpenSelectAction(card.GetSelectAction(), output);
+
+        RenderState state{output, style, true};
+        RenderElements(card.GetBody(), state);
+
+        const auto& actions = card.GetActions();
+        if (m_supportsInteractivity && !actions.empty())
+        {
+            output += "<div class=\"ac-actionSet\" style=\"";
+            if (!state.isFirstElement)
+            {
+                AppendPixels(output, "margin-top", m_spacing[static_cast<int>(m_actions.spacing)]);
+            }
+            output += "\">";
+            RenderActions(actions, state);
+            output += "</div>";
+        }
+
+        if (hasLink)
+        {
+            output += "</a>";
+        }
+        output += "</div>";
+    }
+
+    void HtmlRenderer::RenderElements(const std::vector<std::shared_ptr<BaseCardElement>>& elements, RenderState& state) const
+    {
+        for (const auto& element : elements)
+        {
+            if (element && RenderElement(*element, state))
+            {
+                state.isFirstElement = false;
+            }
+        }
+    }
+
+    bool HtmlRenderer::RenderElement(const BaseCardElement& element, RenderState& state) const
+    {
+        const CardElementType elementType = element.GetElementType();
+        if (!m_supportsInteractivity && (elementType == CardElementType::ActionSet || IsInputElement(elementType)))
+        {
+            return false;
+        }
+
+        switch (elementType)
+        {
+        case CardElementType::TextBlock:
+            RenderTextBlock(static_cast<const TextBlock&>(element), state);
+            return true;
+        case CardElementType::RichTextBlock:
+            RenderRichTextBlock(static_cast<const RichTextBlock&>(element), state);
+            return true;
+        case CardElementType::Container:
+            RenderContainer(static_cast<const Container&>(element), state);
+            return true;
+        case CardElementType::ColumnSet:
+            RenderColumnSet(static_cast<const ColumnSet&>(element), state);
+            return true;
+        case CardElementType::FactSet:
+            RenderFactSet(static_cast<const FactSet&>(element), state);
+            return true;
+        case CardElementType::Image:
+            RenderImage(static_cast<const Image&>(element), m_imageSize, false, state);
+            return true;
+        case CardElementType::ImageSet:
+            RenderImageSet(static_cast<const ImageSet&>(element), state);
+            return true;
+        case CardElementType::Media:
+            RenderMedia(static_cast<const Media&>(element), state);
+            return true;
+        case CardElementType::ActionSet:
+            OpenElement("div", "ac-actionSet", element, state);
+            CloseStartTag(element, state.output);
+            RenderActions(static_cast<const ActionSet&>(element).GetActions(), state);
+            state.output += "</div>";
+            return true;
+        case CardElementType::ChoiceSetInput:
+        case CardElementType::DateInput:
+        case CardElementType::NumberInput:
+        case CardElementType::TextInput:
+        case CardElementType::TimeInput:
+        case CardElementType::ToggleInput:
+            RenderInput(static_cast<const BaseInputElement&>(element), state);
+            return true;
+        default:
+            if (element.GetFallbackType() == FallbackType::Content && element.GetFallbackContent())
+            {
+                return RenderElement(static_cast<const BaseCardElement&>(*element.GetFallbackContent()), state);
+            }
+            return false;
+        }
+    }
+
+    void HtmlRenderer::OpenElement(const char* tag, const char* className, const BaseCardElement& element, RenderState& state) const
+    {
+        std::string& output = state.output;
+        output += '<';
+        output += tag;
+        output += " class=\"";
+        output += className;
+        output += '"';
+        AppendAttribute(output, "id", element.GetId());
+        output += " style=\"";
+
+        if (!state.isFirstElement)
+        {
+            const unsigned int spacing = m_spacing[static_cast<int>(element.GetSpacing())];
+            if (element.GetSeparator())
+            {
+                // Center the separator line in the spacing
+                AppendPixels(output, "margin-top", spacing / 2);
+                AppendPixels(output, "padding-top", spacing - spacing / 2);
+                output += m_separator;
+            }
+            else if (spacing != 0)
+            {
+                AppendPixels(output, "margin-top", spacing);
+            }
+        }
+    }
+
+    void HtmlRenderer::CloseStartTag(const BaseCardElement& element, std::string& output)
+    {
+        if (!element.GetIsVisible())
+        {
+            output += "display:none;";
+        }
+        output += "\">";
+    }
+
+    void HtmlRenderer::AppendTextStyle(FontType fontType, TextSize size, TextWeight weight, ForegroundColor color, bool isSubtle, RenderState& state) const
+    {
+        std::string& output = state.output;
+        const int type = static_cast<int>(fontType);
+        output += "color:";
+        output += m_foregroundColors[Index(state.containerStyle)][static_cast<int>(color)][isSubtle ? 1 : 0];
+        output += ';';
+        if (fontType != FontType::Default && !m_fontFamilies[type].empty())
+        {
+            output += "font-family:";
+            output += m_fontFamilies[type];
+            output += ';';
+        }
+        AppendPixels(output, "font-size", m_fontSizes[type][static_cast<int>(size)]);
+        output += "font-weight:";
+        AppendNumber(output, m_fontWeights[type][static_cast<int>(weight)]);
+        output += ';';
+    }
+
+    void HtmlRenderer::AppendText(const std::string& text, std::string& output) const
+    {
+        // Built from the markdown's styled runs rather than its html, so that every link goes through IsSafeUrl; an
+        // unsafe link is left as plain text. Paragraphs drop the browser's margins so spacing stays under the card's
+        // control.
+        const MarkDownStyledText styled = MarkDownParser(FormatText(text)).TransformToStyledRuns();
+
+        const MarkDownStyledRun* block = nullptr;
+        const auto closeBlock = [&]() {
+            if (block != nullptr)
+            {
+                output += (block->blockType == MarkDownStyledBlockType::Paragraph) ? "</p>" : "</li>";
+            }
+        };
+        const auto closeList = [&]() {
+            if (block != nullptr && block->blockType != MarkDownStyledBlockType::Paragraph)
+            {
+                output += (block->blockType == MarkDownStyledBlockType::UnorderedListItem) ? "</ul>" : "</ol>";
+            }
+        };
+
+        for (const auto& run : styled.runs)
+        {
+            if (block == nullptr || run.blockIndex != block->blockIndex)
+            {
+                closeBlock();
+                if (block == nullptr || run.blockType != block->blockType)
+                {
+                    closeList();
+                    if (run.blockType == MarkDownStyledBlockType::UnorderedListItem)
+                    {
+                        output += "<ul>";
+                    }
+                    else if (run.blockType == MarkDownStyledBlockType::OrderedListItem)
+                    {
+                        output += "<ol start=\"";
+                        AppendNumber(output, run.listNumber);
+                        output += "\">";
+                    }
+                }
+                output += (run.blockType == MarkDownStyledBlockType::Paragraph) ? "<p style=\"margin:0\">" : "<li>";
+                block = &run;
+            }
+
+            const bool isLink = !run.link.empty() && IsSafeUrl(run.link);
+            if (isLink)
+            {
+                output += "<a href=\"";
+                AppendEscaped(output, run.link);
+                output += "\">";
+            }
+            output += run.isBold ? "<strong>" : "";
+            output += run.isItalic ? "<em>" : "";
+            AppendEscaped(output, styled.text.substr(run.start, run.length));
+            output += run.isItalic ? "</em>" : "";
+            output += run.isBold ? "</strong>" : "";
+            output += isLink ? "</a>" : "";
+        }
+        closeBlock();
+        closeList();
+    }
+
+    void HtmlRenderer::AppendImageUrl(const std::string& url, std::string& output) const
+    {
+        if (!m_imageBaseUrl.empty() && !IsAbsoluteUrl(url))
+        {
+            AppendEscaped(output, m_imageBaseUrl);
+        }
+        AppendEscaped(output, url);
+    }
+
+    bool HtmlRenderer::OpenSelectAction(const std::shared_ptr<BaseActionElement>& selectAction, std::string& output) const
+    {
+        if (!m_supportsInteractivity || !IsOpenUrlAction(selectAction))
+        {
+            return false;
+        }
+
+        output += "<a href=\"";
+        AppendEscaped(output, std::static_pointer_cast<OpenUrlAction>(selectAction)->GetUrlRef());
+        output += "\" style=\"display:block;color:inherit;text-decoration:none\">";
+        return true;
+    }
+
+    void HtmlRenderer::AppendBackgroundImage(const BackgroundImage& backgroundImage, std::string& output) const
+    {
+        const std::string& url = backgroundImage.GetUrlRef();
+        if (url.empty() || !IsSafeUrl(url))
+        {
+            return;
+        }
+
+        // The URL sits inside a CSS url('') inside an HTML attribute, so percent-encode anything that could end either.
+        std::string fullUrl;
+        if (!m_imageBaseUrl.empty() && !IsAbsoluteUrl(url))
+        {
+            fullUrl = m_imageBaseUrl;
+        }
+        fullUrl += url;
+
+        output += "background-image:url('";
+        for (const char c : fullUrl)
+        {
+            switch (c)
+            {
+            case '\'':
+            case '"':
+            case '(':
+            case ')':
+            case '\\':
+            case '<':
+            case '>':
+            case '&':
+            case ' ':
+            {
+                static const char hexDigits[] = "0123456789ABCDEF";
+                output += '%';
+                output += hexDigits[(static_cast<unsigned char>(c) >> 4) & 0xF];
+                output += hexDigits[static_cast<unsigned char>(c) & 0xF];
+                break;
+            }
+            default:
+                if (static_cast<unsigned char>(c) >= ' ')
+                {
+                    output += c;
+                }
+                break;
+            }
+        }
+        output += "');";
+
+        switch (backgroundImage.GetFillMode())
+        {
+        case ImageFillMode::RepeatHorizontally:
+            output += "background-repeat:repeat-x;";
+            break;
+        case ImageFillMode::RepeatVertically:
+            output += "background-repeat:repeat-y;";
+            break;
+        case ImageFillMode::Repeat:
+            output += "background-repeat:repeat;";
+            break;
+        default:
+            output += "background-size:cover;background-repeat:no-repeat;";
+            break;
+        }
+
+        static const char* const horizontalPositions[] = {"left", "center", "right"};
+        static const char* const verticalPositions[] = {"top", "center", "bottom"};
+        output += "background-position:";
+        output += horizontalPositions[static_cast<int>(backgroundImage.GetHorizontalAlignment())];
+        output += ' ';
+        output += verticalPositions[static_cast<int>(backgroundImage.GetVerticalAlignment())];
+        output += ';';
+    }
+
+    ContainerStyle HtmlRenderer::AppendContainerStyle(const CollectionTypeElement& collection, RenderState& state) const
+    {
+        std::string& output = state.output;
+        const ContainerStyle style = (collection.GetStyle() == ContainerStyle::None) ? state.containerStyle : collection.GetStyle();
+        if (style != state.containerStyle)
+        {
+            output += "background-color:";
+            output += m_backgroundColors[Index(style)];
+            output += ';';
+            AppendPixels(output, "padding", m_padding);
+        }
+
+        if (const auto backgroundImage = collection.GetBackgroundImage())
+        {
+            AppendBackgroundImage(*backgroundImage, output);
+        }
+        return style;
+    }
+
+    void HtmlRenderer::RenderTextBlock(const TextBlock& textBlock, RenderState& state) const
+    {
+        std::string& output = state.output;
+        OpenElement("div", "ac-textBlock", textBlock, state);
+        AppendTextStyle(textBlock.GetFontType(),
+                        textBlock.GetTextSize(),
+                        textBlock.GetTextWeight(),
+                        textBlock.GetTextColor(),
+                        textBlock.GetIsSubtle(),
+                        state);
+        output += GetTextAlign(textBlock.GetHorizontalAlignment());
+
+        if (!textBlock.GetWrap())
+        {
+            output += "white-space:nowrap;overflow:hidden;text-overflow:ellipsis;";
+        }
+        else if (textBlock.GetMaxLines() != 0)
+        {
+            output += "overflow:hidden;display:-webkit-box;-webkit-box-orient:vertical;-webkit-line-clamp:";
+            AppendNumber(output, textBlock.GetMaxLines());
+            output += ';';
+        }
+        CloseStartTag(textBlock, output);
+
+        AppendText(textBlock.GetTextRef(), output);
+        output += "</div>";
+    }
+
+    void HtmlRenderer::RenderRichTextBlock(const RichTextBlock& richTextBlock, RenderState& state) const
+    {
+        std::string& output = state.output;
+        OpenElement("div", "ac-richTextBlock", richTextBlock, state);
+        output += GetTextAlign(richTextBlock.GetHorizontalAlignment());
+        CloseStartTag(richTextBlock, output);
+        output += "<p style=\"margin:0\">";
+
+        for (const auto& inlineElement : richTextBlock.GetInlines())
+        {
+            if (!inlineElement || inlineElement->GetInlineType() != InlineElementType::TextRun)
+            {
+                continue;
+            }
+
+            const auto& textRun = static_cast<const TextRun&>(*inlineElement);
+            const bool hasLink = OpenSelectAction(textRun.GetSelectAction(), output);
+
+            output += "<span style=\"";
+            AppendTextStyle(textRun.GetFontType(),
+                            textRun.GetTextSize(),
+                            textRun.GetTextWeight(),
+                            textRun.GetTextColor(),
+                            textRun.GetIsSubtle(),
+                            state);
+            if (textRun.GetItalic())
+            {
+                output += "font-style:italic;";
+            }
+            if (textRun.GetUnderline() || textRun.GetStrikethrough())
+            {
+                output += "text-decoration:";
+                output += textRun.GetUnderline() ? (textRun.GetStrikethrough() ? "underline line-through;" : "underline;") : "line-through;";
+            }
+            if (textRun.GetHighlight())
+            {
+                output += "background-color:";
+                output += m_highlightColors[Index(state.containerStyle)][static_cast<int>(textRun.GetTextColor())]
+                                           [textRun.GetIsSubtle() ? 1 : 0];
+                output += ';';
+            }
+            output += "\">";
+            AppendEscaped(output, FormatText(textRun.GetTextRef()));
+            output += "</span>";
+
+            if (hasLink)
+            {
+                output += "</a>";
+            }
+        }
+
+        output += "</p></div>";
+    }
+
+    void HtmlRenderer::RenderContainer(const Container& container, RenderState& state) const
+    {
+        std::string& output = state.output;
+        OpenElement("div", "ac-container", container, state);
+        const ContainerStyle style = AppendContainerStyle(container, state);
+        AppendMinHeight(output, container.GetMinHeight(), container.GetVerticalContentAlignment());
+        CloseStartTag(container, output);
+
+        const bool hasLink = OpenSelectAction(container.GetSelectAction(), output);
+
+        RenderState childState{output, style, true};
+        RenderElements(container.GetItems(), childState);
+
+        if (hasLink)
+        {
+            output += "</a>";
+        }
+        output += "</div>";
+    }
+
+    void HtmlRenderer::RenderColumnSet(const ColumnSet& columnSet, RenderState& state) const
+    {
+        std::string& output = state.output;
+        OpenElement(c_presentationTable, "ac-columnSet", columnSet, state);
+        output += "width:100%;border-collapse:collapse;";
+        const ContainerStyle style = AppendContainerStyle(columnSet, state);
+        CloseStartTag(columnSet, output);
+        output += "<tr>";
+
+        const auto& columns = columnSet.GetColumns();
+        double totalWeight = 0;
+        for (const auto& column : columns)
+        {
+            totalWeight += column ? GetColumnWeight(*column) : 0;
+        }
+
+        RenderState columnSetState{output, style, true};
+        bool isFirstColumn = true;
+        for (const auto& column : columns)
+        {
+            if (!column)
+            {
+                continue;
+            }
+
+            output += "<td class=\"ac-column\"";
+            AppendAttribute(output, "id", column->GetId());
+            output += " style=\"";
+            output += GetVerticalAlign(column->GetVerticalContentAlignment());
+
+            const double weight = GetColumnWeight(*column);
+            if (column->GetPixelWidth() > 0)
+            {
+                AppendPixels(output, "width", static_cast<unsigned int>(column->GetPixelWidth()));
+            }
+            else if (weight > 0)
+            {
+                const unsigned int tenths = static_cast<unsigned int>(weight * 1000 / totalWeight + 0.5);
+                output += "width:";
+                AppendNumber(output, tenths / 10);
+                output += '.';
+                output += static_cast<char>('0' + tenths % 10);
+                output += "%;";
+            }
+            else
+            {
+                output += "width:1px;white-space:nowrap;";
+            }
+
+            if (!isFirstColumn)
+            {
+                const unsigned int spacing = m_spacing[static_cast<int>(column->GetSpacing())];
+                if (column->GetSeparator())
+                {
+                    AppendPixels(output, "padding-left", spacing);
+                    output += "border-left:";
+                    output += m_separator.c_str() + strlen("border-top:");
+                }
+                else if (spacing != 0)
+                {
+                    AppendPixels(output, "padding-left", spacing);
+                }
+            }
+
+            const ContainerStyle columnStyle = AppendContainerStyle(*column, columnSetState);
+            CloseStartTag(*column, output);
+
+            const bool hasLink = OpenSelectAction(column->GetSelectAction(), output);
+            RenderState columnState{output, columnStyle, true};
+            RenderElements(column->GetItems(), columnState);
+            if (hasLink)
+            {
+                output += "</a>";
+            }
+
+            output += "</td>";
+            isFirstColumn = false;
+        }
+
+        output += "</tr></table>";
+    }
+
+    void HtmlRenderer::RenderFactSet(const FactSet& factSet, RenderState& state) const
+    {
+        std::string& output = state.output;
+        OpenElement(c_presentationTable, "ac-factSet", factSet, state);
+        output += "border-collapse:collapse;";
+        CloseStartTag(factSet, output);
+
+        const TextConfig& title = m_factSet.title;
+        const TextConfig& value = m_factSet.value;
+        for (const auto& fact : factSet.GetFacts())
+        {
+            if (!fact)
+            {
+                continue;
+            }
+
+            output += "<tr><td style=\"vertical-align:top;";
+            AppendPixels(output, "padding-right", m_factSet.spacing);
+            if (title.maxWidth != ~0U)
+            {
+                AppendPixels(output, "max-width", title.maxWidth);
+            }
+            if (!title.wrap)
+            {
+                output += "white-space:nowrap;";
+            }
+            AppendTextStyle(title.fontType, title.size, title.weight, title.color, title.isSubtle, state);
+            output += "\">";
+            AppendText(fact->GetTitleRef(), output);
+
+            output += "</td><td style=\"vertical-align:top;";
+            if (value.maxWidth != ~0U)
+            {
+                AppendPixels(output, "max-width", value.maxWidth);
+            }
+            if (!value.wrap)
+            {
+                output += "white-space:nowrap;";
+            }
+            AppendTextStyle(value.fontType, value.size, value.weight, value.color, value.isSubtle, state);
+            output += "\">";
+            AppendText(fact->GetValueRef(), output);
+            output += "</td></tr>";
+        }
+
+        output += "</table>";
+    }
+
+    void HtmlRenderer::RenderImage(const Image& image, ImageSize defaultSize, bool isInImageSet, RenderState& state) const
+    {
+        std::string& output = state.output;
+        const std::string& url = image.GetUrlRef();
+
+        if (!isInImageSet)
+        {
+            OpenElement("div", "ac-image", image, state);
+            output += GetTextAlign(image.GetHorizontalAlignment());
+            CloseStartTag(image, output);
+        }
+
+        const bool hasLink = OpenSelectAction(image.GetSelectAction(), output);
+
+        if (IsSafeUrl(url))
+        {
+            output += "<img src=\"";
+            AppendImageUrl(url, output);
+            output += "\" alt=\"";
+            AppendEscaped(output, image.GetAltTextRef());
+            output += "\" style=\"display:inline-block;";
+
+            const unsigned int pixelWidth = image.GetPixelWidth();
+            const unsigned int pixelHeight = image.GetPixelHeight();
+            const bool isPerson = image.GetImageStyle() == ImageStyle::Person;
+            if (pixelWidth != 0 || pixelHeight != 0)
+            {
+                if (pixelWidth != 0)
+                {
+                    AppendPixels(output, "width", pixelWidth);
+                }
+                if (pixelHeight != 0)
+                {
+                    AppendPixels(output, "height", pixelHeight);
+                }
+            }
+            else
+            {
+                const ImageSize size = (image.GetImageSize() == ImageSize::None) ? defaultSize : image.GetImageSize();
+                switch (size)
+                {
+                case ImageSize::Stretch:
+                    output += "width:100%;";
+                    break;
+                case ImageSize::Small:
+                case ImageSize::Medium:
+                case ImageSize::Large:
+                    AppendPixels(output, "width", m_imageSizes[static_cast<int>(size)]);
+                    if (isPerson)
+                    {
+                        AppendPixels(output, "height", m_imageSizes[static_cast<int>(size)]);
+                    }
+                    break;
+                default:
+                    output += "max-width:100%;";
+                    break;
+                }
+            }
+
+            if (isInImageSet)
+            {
+                AppendPixels(output, "max-height", m_imageSetMaxHeight);
+                output += "margin:0 8px 8px 0;";
+                if (!image.GetIsVisible())
+                {
+                    output += "display:none;";
+                }
+            }
+            if (isPerson)
+            {
+                output += "border-radius:50%;";
+            }
+
+            const std::string& backgroundColor = image.GetBackgroundColorRef();
+            if (!backgroundColor.empty())
+            {
+                output += "background-color:";
+                output += ToCssColor(backgroundColor);
+                output += ';';
+            }
+            output += "\">";
+        }
+
+        if (hasLink)
+        {
+            output += "</a>";
+        }
+
+        if (!isInImageSet)
+        {
+            output += "</div>";
+        }
+    }
+
+    void HtmlRenderer::RenderImageSet(const ImageSet& imageSet, RenderState& state) const
+    {
+        OpenElement("div", "ac-imageSet", imageSet, state);
+        CloseStartTag(imageSet, state.output);
+
+        const ImageSize size = (imageSet.GetImageSize() == ImageSize::None) ? m_imageSetImageSize : imageSet.GetImageSize();
+        for (const auto& image : imageSet.GetImages())
+        {
+            if (image)
+            {
+                RenderImage(*image, size, true, state);
+            }
+        }
+
+        state.output += "</div>";
+    }
+
+    void HtmlRenderer::RenderMedia(const Media& media, RenderState& state) const
+    {
+        std::string& output = state.output;
+        OpenElement("div", "ac-media", media, state);
+        CloseStartTag(media, output);
+
+        // Mail clients don't play media, so link the poster to the first source instead.
+        const auto& sources = media.GetSources();
+        const std::string sourceUrl = sources.empty() || !sources.front() ? std::string() : sources.front()->GetUrlRef();
+        const bool hasLink = m_supportsInteractivity && !sourceUrl.empty() && IsSafeUrl(sourceUrl);
+        if (hasLink)
+        {
+            output += "<a href=\"";
+            AppendEscaped(output, sourceUrl);
+            output += "\">";
+        }
+
+        const std::string& poster = media.GetPosterRef();
+        if (!poster.empty() && IsSafeUrl(poster))
+        {
+            output += "<img src=\"";
+            AppendImageUrl(poster, output);
+            output += "\" alt=\"";
+            AppendEscaped(output, media.GetAltTextRef());
+            output += "\" style=\"max-width:100%\">";
+        }
+        else
+        {
+            AppendEscaped(output, media.GetAltTextRef().empty() ? sourceUrl : media.GetAltTextRef());
+        }
+
+        if (hasLink)
+        {
+            output += "</a>";
+        }
+        output += "</div>";
+    }
+
+    void HtmlRenderer::RenderInput(const BaseInputElement& input, RenderState& state) const
+    {
+        std::string& output = state.output;
+        OpenElement("div", "ac-input", input, state);
+        CloseStartTag(input, output);
+
+        const std::string id = input.GetId();
+        switch (input.GetElementType())
+        {
+        case CardElementType::TextInput:
+        {
+            const auto& textInput = static_cast<const TextInput&>(input);
+            output += textInput.GetIsMultiline() ? "<textarea" : "<input";
+            if (!textInput.GetIsMultiline())
+            {
+                static const char* const inputTypes[] = {"text", "tel", "url", "email"};
+                output += " type=\"";
+                output += inputTypes[static_cast<int>(textInput.GetTextInputStyle())];
+                output += '"';
+                AppendAttribute(output, "value", textInput.GetValueRef());
+            }
+            AppendAttribute(output, "name", id);
+            AppendAttribute(output, "placeholder", textInput.GetPlaceholderRef());
+            if (textInput.GetMaxLength() != 0)
+            {
+                output += " maxlength=\"";
+                AppendNumber(output, textInput.GetMaxLength());
+                output += '"';
+            }
+            output += " style=\"box-sizing:border-box;width:100%\">";
+            if (textInput.GetIsMultiline())
+            {
+                AppendEscaped(output, textInput.GetValueRef());
+                output += "</textarea>";
+            }
+            break;
+        }
+        case CardElementType::NumberInput:
+        {
+            const auto& numberInput = static_cast<const NumberInput&>(input);
+            output += "<input type=\"number\"";
+            AppendAttribute(output, "name", id);
+            AppendAttribute(output, "placeholder", numberInput.GetPlaceholderRef());
+            if (numberInput.GetMin() != std::numeric_limits<int>::min())
+            {
+                output += " min=\"";
+                AppendNumber(output, numberInput.GetMin());
+                output += '"';
+            }
+            if (numberInput.GetMax() != std::numeric_limits<int>::max())
+            {
+                output += " max=\"";
+                AppendNumber(output, numberInput.GetMax());
+                output += '"';
+            }
+            output += " value=\"";
+            AppendNumber(output, numberInput.GetValue());
+            output += "\" style=\"box-sizing:border-box;width:100%\">";
+            break;
+        }
+        case CardElementType::DateInput:
+        {
+            const auto& dateInput = static_cast<const DateInput&>(input);
+            output += "<input type=\"date\"";
+            AppendAttribute(output, "name", id);
+            AppendAttribute(output, "placeholder", dateInput.GetPlaceholderRef());
+            AppendAttribute(output, "min", dateInput.GetMinRef());
+            AppendAttribute(output, "max", dateInput.GetMaxRef());
+            AppendAttribute(output, "value", dateInput.GetValueRef());
+            output += " style=\"box-sizing:border-box;width:100%\">";
+            break;
+        }
+        case CardElementType::TimeInput:
+        {
+            const auto& timeInput = static_cast<const TimeInput&>(input);
+            output += "<input type=\"time\"";
+            AppendAttribute(output, "name", id);
+            AppendAttribute(output, "placeholder", timeInput.GetPlaceholderRef());
+            AppendAttribute(output, "min", timeInput.GetMinRef());
+            AppendAttribute(output, "max", timeInput.GetMaxRef());
+            AppendAttribute(output, "value", timeInput.GetValueRef());
+            output += " style=\"box-sizing:border-box;width:100%\">";
+            break;
+        }
+        case CardElementType::ToggleInput:
+        {
+            const auto& toggleInput = static_cast<const ToggleInput&>(input);
+            output += "<label><input type=\"checkbox\"";
+            AppendAttribute(output, "name", id);
+            AppendAttribute(output, "value", toggleInput.GetValueOnRef());
+            if (toggleInput.GetValueRef() == toggleInput.GetValueOnRef())
+            {
+                output += " checked";
+            }
+            output += "> ";
+            AppendEscaped(output, toggleInput.GetTitleRef());
+            output += "</label>";
+            break;
+        }
+        case CardElementType::ChoiceSetInput:
+            RenderChoiceSetInput(static_cast<const ChoiceSetInput&>(input), state);
+            break;
+        default:
+            break;
+        }
+
+        output += "</div>";
+    }
+
+    void HtmlRenderer::RenderChoiceSetInput(const ChoiceSetInput& choiceSet, RenderState& state) const
+    {
+        std::string& output = state.output;
+        const std::string id = choiceSet.GetId();
+        const std::string& value = choiceSet.GetValueRef();
+        const bool isMultiSelect = choiceSet.GetIsMultiSelect();
+
+        // Multi-select values are comma separated
+        const auto isSelected = [&value, isMultiSelect](const std::string& choiceValue) {
+            if (!isMultiSelect)
+            {
+                return value == choiceValue;
+            }
+            for (size_t start = 0; start <= value.size();)
+            {
+                size_t end = value.find(',', start);
+                if (end == std::string::npos)
+                {
+                    end = value.size();
+                }
+                if (value.compare(start, end - start, choiceValue) == 0)
+                {
+                    return true;
+                }
+                start = end + 1;
+            }
+            return false;
+        };
+
+        if (!isMultiSelect && choiceSet.GetChoiceSetStyle() == ChoiceSetStyle::Compact)
+        {
+            output += "<select";
+            AppendAttribute(output, "name", id);
+            output += " style=\"box-sizing:border-box;width:100%\">";
+            for (const auto& choice : choiceSet.GetChoices())
+            {
+                if (!choice)
+                {
+                    continue;
+                }
+                const std::string& choiceValue = choice->GetValueRef();
+                output += "<option";
+                AppendAttribute(output, "value", choiceValue);
+                if (isSelected(choiceValue))
+                {
+                    output += " selected";
+                }
+                output += '>';
+                AppendEscaped(output, choice->GetTitleRef());
+                output += "</option>";
+            }
+            output += "</select>";
+            return;
+        }
+
+        const char* inputType = isMultiSelect ? "<label style=\"display:block\"><input type=\"checkbox\"" :
+                                                "<label style=\"display:block\"><input type=\"radio\"";
+        for (const auto& choice : choiceSet.GetChoices())
+        {
+            if (!choice)
+            {
+                continue;
+            }
+            const std::string& choiceValue = choice->GetValueRef();
+            output += inputType;
+            AppendAttribute(output, "name", id);
+            AppendAttribute(output, "value", choiceValue);
+            if (isSelected(choiceValue))
+            {
+                output += " checked";
+            }
+            output += "> ";
+            AppendEscaped(output, choice->GetTitleRef());
+            output += "</label>";
+        }
+    }
+
+    void HtmlRenderer::RenderActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions, RenderState& state) const
+    {
+        std::string& output = state.output;
+        const size_t count = std::min<size_t>(actions.size(), m_actions.maxActions);
+        const bool isStretch = m_actions.actionAlignment == ActionAlignment::Stretch;
+        const char* layoutStyle = isStretch ? "display:block;width:100%;" : "display:inline-block;";
+
+        if (m_actions.actionsOrientation == ActionsOrientation::Horizontal)
+        {
+            output += '<';
+            output += c_presentationTable;
+            output += " style=\"border-collapse:collapse;";
+            switch (m_actions.actionAlignment)
+            {
+            case ActionAlignment::Stretch:
+                output += "width:100%;";
+                break;
+            case ActionAlignment::Center:
+                output += "margin-left:auto;margin-right:auto;";
+                break;
+            case ActionAlignment::Right:
+                output += "margin-left:auto;";
+                break;
+            default:
+                break;
+            }
+            output += "\"><tr>";
+
+            for (size_t i = 0; i < count; i++)
+            {
+                output += "<td style=\"";
+                if (i != 0)
+                {
+                    AppendPixels(output, "padding-left", m_actions.buttonSpacing);
+                }
+                if (isStretch)
+                {
+                    output += "width:";
+                    AppendNumber(output, static_cast<unsigned int>(100 / count));
+                    output += "%;";
+                }
+                output += "\">";
+                if (actions[i])
+                {
+                    RenderAction(*actions[i], layoutStyle, state);
+                }
+                output += "</td>";
+            }
+
+            output += "</tr></table>";
+        }
+        else
+        {
+            output += "<div style=\"";
+            output += GetTextAlign(static_cast<HorizontalAlignment>(isStretch ? 0 : static_cast<int>(m_actions.actionAlignment)));
+            output += "\">";
+            for (size_t i = 0; i < count; i++)
+            {
+                output += "<div style=\"";
+                if (i != 0)
+                {
+                    AppendPixels(output, "margin-top", m_actions.buttonSpacing);
+                }
+                output += "\">";
+                if (actions[i])
+                {
+                    RenderAction(*actions[i], layoutStyle, state);
+                }
+                output += "</div>";
+            }
+            output += "</div>";
+        }
+    }
+
+    void HtmlRenderer::RenderAction(const BaseActionElement& action, const char* layoutStyle, RenderState& state) const
+    {
+        std::string& output = state.output;
+        const ActionType actionType = action.GetElementType();
+        if (actionType == ActionType::UnknownAction || actionType == ActionType::Custom || actionType == ActionType::Unsupported)
+        {
+            if (action.GetFallbackType() == FallbackType::Content && action.GetFallbackContent())
+            {
+                RenderAction(static_cast<const BaseActionElement&>(*action.GetFallbackContent()), layoutStyle, state);
+            }
+            return;
+        }
+
+        // Only links work without script; the other action types render as inert buttons for the host to wire up.
+        const bool isLink = actionType == ActionType::OpenUrl && IsSafeUrl(static_cast<const OpenUrlAction&>(action).GetUrlRef());
+        if (isLink)
+        {
+            output += "<a class=\"ac-pushButton\" href=\"";
+            AppendEscaped(output, static_cast<const OpenUrlAction&>(action).GetUrlRef());
+            output += '"';
+        }
+        else
+        {
+            output += "<button type=\"button\" class=\"ac-pushButton\"";
+        }
+        AppendAttribute(output, "id", action.GetId());
+        output += " style=\"";
+        output += layoutStyle;
+        output += m_buttonStyle;
+        output += "\">";
+
+        const std::string iconUrl = action.GetIconUrl();
+        if (!iconUrl.empty() && IsSafeUrl(iconUrl))
+        {
+            output += "<img src=\"";
+            AppendImageUrl(iconUrl, output);
+            output += "\" alt=\"\" style=\"vertical-align:middle;margin-right:4px;";
+            AppendPixels(output, "height", m_actions.iconSize);
+            output += "\">";
+        }
+
+        AppendEscaped(output, action.GetTitle());
+        output += isLink ? "</a>" : "</button>";
+    }
+}
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "HostConfig.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class BaseInputElement;
+    class ChoiceSetInput;
+    class Column;
+    class ColumnSet;
+    class CollectionTypeElement;
+    class Container;
+    class FactSet;
+    class Image;
+    class ImageSet;
+    class Media;
+    class RichTextBlock;
+    class TextBlock;
+
+    // HtmlRenderer renders cards to self-contained HTML with inline CSS, suitable for email and notification bodies.
+    //
+    // All HostConfig lookups (colors, font sizes and weights, spacing, ...) are resolved into CSS fragments when the
+    // renderer is constructed, so a single HtmlRenderer can render any number of cards, from any number of threads.
+    // Rendering appends to a caller-supplied buffer; reusing that buffer across cards avoids reallocating it.
+    class HtmlRenderer
+    {
+    public:
+        HtmlRenderer(const HostConfig& hostConfig);
+
+        void Render(const AdaptiveCard& card, std::string& output) const;
+        std::string Render(const AdaptiveCard& card) const;
+
+    private:
+        struct RenderState
+        {
+            std::string& output;
+            ContainerStyle containerStyle;
+            bool isFirstElement;
+        };
+
+        void RenderElements(const std::vector<std::shared_ptr<BaseCardElement>>& elements, RenderState& state) const;
+        bool RenderElement(const BaseCardElement& element, RenderState& state) const;
+        void RenderTextBlock(const TextBlock& textBlock, RenderState& state) const;
+        void RenderRichTextBlock(const RichTextBlock& richTextBlock, RenderState& state) const;
+        void RenderContainer(const Container& container, RenderState& state) const;
+        void RenderColumnSet(const ColumnSet& columnSet, RenderState& state) const;
+        void RenderFactSet(const FactSet& factSet, RenderState& state) const;
+        void RenderImage(const Image& image, ImageSize defaultSize, bool isInImageSet, RenderState& state) const;
+        void RenderImageSet(const ImageSet& imageSet, RenderState& state) const;
+        void RenderMedia(const Media& media, RenderState& state) const;
+        void RenderInput(const BaseInputElement& input, RenderState& state) const;
+        void RenderChoiceSetInput(const ChoiceSetInput& choiceSet, RenderState& state) const;
+        void RenderActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions, RenderState& state) const;
+        void RenderAction(const BaseActionElement& action, const char* layoutStyle, RenderState& state) const;
+
+        // Opens the element's root tag and its style attribute (with the element's spacing and separator), leaving the
+        // attribute open for element-specific CSS. CloseStartTag hides the element if it's not visible and ends the tag.
+        void OpenElement(const char* tag, const char* className, const BaseCardElement& element, RenderState& state) const;
+        static void CloseStartTag(const BaseCardElement& element, std::string& output);
+
+        // Emits the background, padding and minimum height of a container or column and returns the style its children
+        // inherit.
+        ContainerStyle AppendContainerStyle(const CollectionTypeElement& collection, RenderState& state) const;
+        void AppendBackgroundImage(const BackgroundImage& backgroundImage, std::string& output) const;
+        void AppendTextStyle(FontType fontType, TextSize size, TextWeight weight, ForegroundColor color, bool isSubtle, RenderState& state) const;
+        void AppendText(const std::string& text, std::string& output) const;
+        void AppendImageUrl(const std::string& url, std::string& output) const;
+        bool OpenSelectAction(const std::shared_ptr<BaseActionElement>& selectAction, std::string& output) const;
+
+        static int Index(ContainerStyle style) { return static_cast<int>(style); }
+
+        // CSS fragments resolved from HostConfig
+        std::string m_foregroundColors[7][7][2]; // [containerStyle][ForegroundColor][isSubtle]
+        std::string m_highlightColors[7][7][2];  // [containerStyle][ForegroundColor][isSubtle]
+        std::string m_backgroundColors[7];       // [containerStyle]
+        std::string m_fontFamilies[2];           // [FontType]
+        unsigned int m_fontSizes[2][5];          // [FontType][TextSize]
+        unsigned int m_fontWeights[2][3];        // [FontType][TextWeight]
+        unsigned int m_spacing[7];               // [Spacing]
+        unsigned int m_imageSizes[6];            // [ImageSize]
+        std::string m_separator;
+        std::string m_buttonStyle;
+        unsigned int m_padding;
+        ImageSize m_imageSize;
+        ImageSize m_imageSetImageSize;
+        unsigned int m_imageSetMaxHeight;
+        FactSetConfig m_factSet;
+        ActionsConfig m_actions;
+        std::string m_imageBaseUrl;
+        bool m_supportsInteractivity;
+    };
+}
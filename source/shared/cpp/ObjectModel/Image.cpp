@@ -50,9 +50,9 @@ Json::Value Image::SerializeToJsonValue() const
         root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style)] = ImageStyleToString(m_imageStyle);
     }
 
-    if (!m_url.empty())
+    if (!GetUrl().empty())
     {
-        root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url)] = m_url;
+        root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url)] = GetUrl();
     }
 
     if (!m_backgroundColor.empty())
@@ -81,12 +81,29 @@ Json::Value Image::SerializeToJsonValue() const
 
 std::string Image::GetUrl() const
 {
-    return m_url;
+    return m_dataUri ? m_dataUri->GetUri() : m_url;
+}
+
+const std::string& Image::GetUrlRef() const
+{
+    return m_dataUri ? m_dataUri->GetUri() : m_url;
 }
 
 void Image::SetUrl(const std::string& value)
 {
     m_url = value;
+    m_dataUri.reset();
+}
+
+std::shared_ptr<const DataUri> Image::GetDataUri() const
+{
+    return m_dataUri;
+}
+
+void Image::SetDataUri(const std::shared_ptr<const DataUri>& value)
+{
+    m_url.clear();
+    m_dataUri = value;
 }
 
 std::string Image::GetBackgroundColor() const
@@ -94,6 +111,11 @@ std::string Image::GetBackgroundColor() const
     return m_backgroundColor;
 }
 
+const std::string& Image::GetBackgroundColorRef() const
+{
+    return m_backgroundColor;
+}
+
 void Image::SetBackgroundColor(const std::string& value)
 {
     m_backgroundColor = value;
@@ -124,6 +146,11 @@ std::string Image::GetAltText() const
     return m_altText;
 }
 
+const std::string& Image::GetAltTextRef() const
+{
+    return m_altText;
+}
+
 void Image::SetAltText(const std::string& value)
 {
     m_altText = value;
@@ -185,7 +212,16 @@ ImageParser::DeserializeWithoutCheckingType(ParseContext& context, const Json::V
 {
     std::shared_ptr<Image> image = BaseCardElement::Deserialize<Image>(context, json);
 
-    image->SetUrl(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Url, true));
+    const std::string url = ParseUtil::GetString(json, AdaptiveCardSchemaKey::Url, true);
+    const auto dataUri = context.InternDataUri(url);
+    if (dataUri)
+    {
+        image->SetDataUri(dataUri);
+    }
+    else
+    {
+        image->SetUrl(url);
+    }
     image->SetBackgroundColor(ValidateColor(ParseUtil::GetString(json, AdaptiveCardSchemaKey::BackgroundColor), context.warnings));
     image->SetImageStyle(ParseUtil::GetEnumValue<ImageStyle>(json, AdaptiveCardSchemaKey::Style, ImageStyle::Default, ImageStyleFromString));
     image->SetAltText(ParseUtil::GetString(json, AdaptiveCardSchemaKey::AltText));
@@ -220,15 +256,17 @@ ImageParser::DeserializeWithoutCheckingType(ParseContext& context, const Json::V
 
 void Image::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::BackgroundColor),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Size),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::AltText),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalAlignment),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Width),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Height),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::BackgroundColor),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Style),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Size),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::AltText),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalAlignment),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Width),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Height),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::SelectAction)});
+    m_sharedKnownProperties = &knownProperties;
 }
 
 void Image::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
@@ -5,6 +5,7 @@
 #include "pch.h"
 #include "BaseActionElement.h"
 #include "BaseCardElement.h"
+#include "DataUri.h"
 #include "ElementParserRegistration.h"
 
 namespace AdaptiveSharedNamespace
@@ -22,9 +23,15 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue() const override;
 
         std::string GetUrl() const;
+        const std::string& GetUrlRef() const;
         void SetUrl(const std::string& value);
 
+        // The URL when it's an interned data: URI (see ParseContext::InternDataUri), or nullptr
+        std::shared_ptr<const DataUri> GetDataUri() const;
+        void SetDataUri(const std::shared_ptr<const DataUri>& value);
+
         std::string GetBackgroundColor() const;
+        const std::string& GetBackgroundColorRef() const;
         void SetBackgroundColor(const std::string& value);
 
         ImageStyle GetImageStyle() const;
@@ -34,6 +41,7 @@ namespace AdaptiveSharedNamespace
         void SetImageSize(const ImageSize value);
 
         std::string GetAltText() const;
+        const std::string& GetAltTextRef() const;
         void SetAltText(const std::string& value);
 
         HorizontalAlignment GetHorizontalAlignment() const;
@@ -54,6 +62,7 @@ namespace AdaptiveSharedNamespace
         void PopulateKnownPropertiesSet();
 
         std::string m_url;
+        std::shared_ptr<const DataUri> m_dataUri;
         std::string m_backgroundColor;
         ImageStyle m_imageStyle;
         ImageSize m_imageSize;
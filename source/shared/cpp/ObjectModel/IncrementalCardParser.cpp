@@ -0,0 +1,589 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "IncrementalCardParser.h"
+#include "ActionSet.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "ParseUtil.h"
+#include "ShowCardAction.h"
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    const size_t c_notFound = static_cast<size_t>(-1);
+
+    // The kind of element a list of children holds, which decides how an element in it is parsed
+    enum class ChildKind
+    {
+        Element = 0,
+        Column,
+        Image,
+        Action
+    };
+
+    // Reads text that has to be exactly one JSON object, as DeserializeFromString's reader would
+    bool ReadObject(const char* begin, const char* end, Json::Value& json)
+    {
+        Json::CharReaderBuilder builder;
+        builder["failIfExtra"] = true;
+        const std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+
+        std::string errors;
+        try
+        {
+            return reader->parse(begin, end, &json, &errors) && json.isObject();
+        }
+        catch (const Json::Exception&)
+        {
+            return false;
+        }
+    }
+
+    std::shared_ptr<BaseElement> ParseChild(ParseContext& context, Json::Value& json, ChildKind kind)
+    {
+        if (kind == ChildKind::Action)
+        {
+            return ParseUtil::GetActionFromJsonValue(context, json);
+        }
+
+        // Columns and Images may leave out their type, as in a ColumnSet or ImageSet
+        if (kind != ChildKind::Element)
+        {
+            const std::string impliedType = CardElementTypeToString((kind == ChildKind::Column) ? CardElementType::Column : CardElementType::Image);
+            if (ParseUtil::GetString(json, AdaptiveCardSchemaKey::Type, impliedType, false) != impliedType)
+            {
+                return nullptr;
+            }
+            json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)] = impliedType;
+        }
+
+        std::shared_ptr<BaseElement> element;
+        BaseCardElement::ParseJsonObject(context, json, element);
+        return element;
+    }
+
+    // Puts element in place of the child at index in parent's list of children (the card's when parent is null)
+    void ReplaceChild(AdaptiveCard& card, BaseElement* parent, ChildKind kind, size_t index, const std::shared_ptr<BaseElement>& element)
+    {
+        if (parent == nullptr)
+        {
+            if (kind == ChildKind::Action)
+            {
+                card.GetActions()[index] = std::static_pointer_cast<BaseActionElement>(element);
+            }
+            else
+            {
+                card.GetBody()[index] = std::static_pointer_cast<BaseCardElement>(element);
+            }
+            return;
+        }
+
+        switch (static_cast<BaseCardElement*>(parent)->GetElementType())
+        {
+        case CardElementType::Container:
+            static_cast<Container*>(parent)->GetItems()[index] = std::static_pointer_cast<BaseCardElement>(element);
+            break;
+        case CardElementType::Column:
+            static_cast<Column*>(parent)->GetItems()[index] = std::static_pointer_cast<BaseCardElement>(element);
+            break;
+        case CardElementType::ColumnSet:
+            static_cast<ColumnSet*>(parent)->GetColumns()[index] = std::static_pointer_cast<Column>(element);
+            break;
+        case CardElementType::ImageSet:
+            static_cast<ImageSet*>(parent)->GetImages()[index] = std::static_pointer_cast<Image>(element);
+            break;
+        case CardElementType::ActionSet:
+            static_cast<ActionSet*>(parent)->GetActions()[index] = std::static_pointer_cast<BaseActionElement>(element);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    struct IncrementalCardParser::Node
+    {
+        // The element and where it is: nullptr for the card, which has no kind or index
+        std::shared_ptr<BaseElement> element;
+        ChildKind kind;
+        size_t index;
+        SourceSpan span;
+
+        // The state the parse was in as it started the element
+        ContainerStyle parentalContainerStyle;
+        InternalId paddingParentInternalId;
+        ContainerBleedDirection bleedDirection;
+        bool canFallbackToAncestor;
+
+        // The ids and warnings of the element and everything it holds, other than its children
+        std::vector<std::string> ids;
+        std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings;
+
+        // In the order they appear in the text
+        std::vector<Node> children;
+
+        void CountIds(std::unordered_map<std::string, size_t>& counts) const
+        {
+            for (const auto& id : ids)
+            {
+                ++counts[id];
+            }
+            for (const auto& child : children)
+            {
+                child.CountIds(counts);
+            }
+        }
+
+        void AddWarnings(std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& allWarnings) const
+        {
+            allWarnings.insert(allWarnings.end(), warnings.begin(), warnings.end());
+            for (const auto& child : children)
+            {
+                child.AddWarnings(allWarnings);
+            }
+        }
+
+        // Moves the spans past editEnd, the end of an edit in the text before the edit, by delta
+        void ShiftSpans(size_t editEnd, ptrdiff_t delta)
+        {
+            span.begin = (span.begin > editEnd) ? span.begin + delta : span.begin;
+            span.end = (span.end > editEnd) ? span.end + delta : span.end;
+            for (auto& child : children)
+            {
+                if (child.span.end > editEnd)
+                {
+                    child.ShiftSpans(editEnd, delta);
+                }
+            }
+        }
+
+        const Node* Find(const BaseElement& other) const
+        {
+            if (element.get() == &other)
+            {
+                return this;
+            }
+            for (const auto& child : children)
+            {
+                if (const Node* node = child.Find(other))
+                {
+                    return node;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    // Records each element as the context parses it: the state the context was in as it started the element, and the
+    // warnings and other elements that were added while it was parsed
+    class IncrementalCardParser::Recorder : public ParseObserver
+    {
+    public:
+        struct Record
+        {
+            InternalId internalId;
+            std::string id;
+            ContainerStyle parentalContainerStyle;
+            InternalId paddingParentInternalId;
+            ContainerBleedDirection bleedDirection;
+            bool canFallbackToAncestor;
+
+            // The element's warnings are [firstWarning, lastWarning) and the records of what it holds follow it, up
+            // to lastRecord
+            size_t firstWarning;
+            size_t lastWarning;
+            size_t lastRecord;
+        };
+
+        void ElementStarted(const ParseContext& context, const InternalId& internalId, const std::string& id) override
+        {
+            m_started.push_back(m_records.size());
+            m_records.push_back({internalId,
+                                 id,
+                                 context.GetParentalContainerStyle(),
+                                 context.PaddingParentInternalId(),
+                                 context.GetBleedDirection(),
+                                 context.GetCanFallbackToAncestor(),
+                                 context.warnings.size(),
+                                 context.warnings.size(),
+                                 m_records.size() + 1});
+        }
+
+        void ElementParsed(const ParseContext& context, const InternalId& /*internalId*/) override
+        {
+            const size_t index = m_started.back();
+            m_started.pop_back();
+
+            Record& record = m_records[index];
+            record.lastWarning = context.warnings.size();
+            record.lastRecord = m_records.size();
+            m_parsed.emplace(record.internalId, index);
+        }
+
+        const std::vector<Record>& GetRecords() const { return m_records; }
+
+        size_t Find(const InternalId& internalId) const
+        {
+            const auto entry = m_parsed.find(internalId);
+            return (entry != m_parsed.end()) ? entry->second : c_notFound;
+        }
+
+        void CountIds(std::unordered_map<std::string, size_t>& counts) const
+        {
+            for (const auto& record : m_records)
+            {
+                if (!record.id.empty())
+                {
+                    ++counts[record.id];
+                }
+            }
+        }
+
+    private:
+        std::vector<Record> m_records;
+        std::vector<size_t> m_started;
+        std::unordered_map<InternalId, size_t, InternalIdKeyHash> m_parsed;
+    };
+
+    // Builds the nodes for an element and its children from its JSON and what the recorder saw as it was parsed
+    class IncrementalCardParser::Builder
+    {
+    public:
+        Builder(const AdaptiveCard& card,
+                const Recorder& recorder,
+                const std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& warnings,
+                size_t textOffset) :
+            m_card(card),
+            m_recorder(recorder), m_warnings(warnings), m_textOffset(textOffset)
+        {
+        }
+
+        // records and warnings are the ranges of them that belong to the node's element
+        void Build(Node& node, const Json::Value& json, std::pair<size_t, size_t> records, std::pair<size_t, size_t> warnings)
+        {
+            AddChildren(node, json);
+
+            // The node keeps what's left once its children's records and warnings are taken out. Both are in the order
+            // they were parsed in, which for a card (the body, then the actions) needn't be the order in the text.
+            std::vector<std::pair<size_t, const Node*>> children;
+            for (const auto& child : node.children)
+            {
+                children.emplace_back(m_recorder.Find(child.element->GetInternalId()), &child);
+            }
+            std::sort(children.begin(), children.end());
+
+            const auto& allRecords = m_recorder.GetRecords();
+            const auto addOwn = [&](size_t lastRecord, size_t lastWarning) {
+                for (size_t i = records.first; i < lastRecord; i++)
+                {
+                    if (!allRecords[i].id.empty())
+                    {
+                        node.ids.push_back(allRecords[i].id);
+                    }
+                }
+                node.warnings.insert(node.warnings.end(), m_warnings.begin() + warnings.first, m_warnings.begin() + lastWarning);
+            };
+            for (const auto& child : children)
+            {
+                const auto& record = allRecords[child.first];
+                addOwn(child.first, record.firstWarning);
+                records.first = record.lastRecord;
+                warnings.first = record.lastWarning;
+            }
+            addOwn(records.second, warnings.second);
+        }
+
+    private:
+        void AddChildren(Node& node, const Json::Value& json)
+        {
+            if (!node.element)
+            {
+                AddChildren(node, m_card.GetBody(), json, AdaptiveCardSchemaKey::Body, ChildKind::Element);
+                AddChildren(node, m_card.GetActions(), json, AdaptiveCardSchemaKey::Actions, ChildKind::Action);
+                std::sort(node.children.begin(), node.children.end(), [](const Node& a, const Node& b) {
+                    return a.span.begin < b.span.begin;
+                });
+                return;
+            }
+
+            if (node.kind == ChildKind::Action)
+            {
+                return;
+            }
+
+            const BaseCardElement* element = static_cast<const BaseCardElement*>(node.element.get());
+            switch (element->GetElementType())
+            {
+            case CardElementType::Container:
+                AddChildren(node, static_cast<const Container*>(element)->GetItems(), json, AdaptiveCardSchemaKey::Items, ChildKind::Element);
+                break;
+            case CardElementType::Column:
+                AddChildren(node, static_cast<const Column*>(element)->GetItems(), json, AdaptiveCardSchemaKey::Items, ChildKind::Element);
+                break;
+            case CardElementType::ColumnSet:
+                AddChildren(node, static_cast<const ColumnSet*>(element)->GetColumns(), json, AdaptiveCardSchemaKey::Columns, ChildKind::Column);
+                break;
+            case CardElementType::ImageSet:
+                AddChildren(node, static_cast<const ImageSet*>(element)->GetImages(), json, AdaptiveCardSchemaKey::Images, ChildKind::Image);
+                break;
+            case CardElementType::ActionSet:
+                AddChildren(node, static_cast<const ActionSet*>(element)->GetActions(), json, AdaptiveCardSchemaKey::Actions, ChildKind::Action);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Pairs each element in the list with the JSON it was parsed from. The list is left untracked if that can't be
+        // told for certain, as when the parser dropped an element from it.
+        template<typename T>
+        void AddChildren(Node& node, const std::vector<std::shared_ptr<T>>& elements, const Json::Value& json, AdaptiveCardSchemaKey key, ChildKind kind)
+        {
+            const Json::Value& items = json[AdaptiveCardSchemaKeyToString(key)];
+            if (!items.isArray() || items.size() != elements.size())
+            {
+                return;
+            }
+
+            for (size_t i = 0; i < elements.size(); i++)
+            {
+                const Json::Value& item = items[static_cast<Json::ArrayIndex>(i)];
+                const size_t recordIndex = m_recorder.Find(elements[i]->GetInternalId());
+                if (recordIndex == c_notFound || !item.isObject() || item.getOffsetStart() < 0 || item.getOffsetLimit() <= item.getOffsetStart())
+                {
+                    continue;
+                }
+
+                const auto& record = m_recorder.GetRecords()[recordIndex];
+                Node child{elements[i],
+                           kind,
+                           i,
+                           {m_textOffset + static_cast<size_t>(item.getOffsetStart()), m_textOffset + static_cast<size_t>(item.getOffsetLimit())},
+                           record.parentalContainerStyle,
+                           record.paddingParentInternalId,
+                           record.bleedDirection,
+                           record.canFallbackToAncestor,
+                           {},
+                           {},
+                           {}};
+                Build(child, item, {recordIndex, record.lastRecord}, {record.firstWarning, record.lastWarning});
+                node.children.push_back(std::move(child));
+            }
+        }
+
+        const AdaptiveCard& m_card;
+        const Recorder& m_recorder;
+        const std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& m_warnings;
+        const size_t m_textOffset;
+    };
+
+    IncrementalCardParser::IncrementalCardParser(const std::string& rendererVersion,
+                                                 std::shared_ptr<ElementParserRegistration> elementRegistration,
+                                                 std::shared_ptr<ActionParserRegistration> actionRegistration) :
+        m_rendererVersion(rendererVersion),
+        m_elementParserRegistration(elementRegistration), m_actionParserRegistration(actionRegistration)
+    {
+    }
+
+    IncrementalCardParser::~IncrementalCardParser() = default;
+
+    std::shared_ptr<ParseResult> IncrementalCardParser::Parse(const std::string& jsonText)
+    {
+        m_text = jsonText;
+        return ParseAll();
+    }
+
+    std::shared_ptr<ParseResult> IncrementalCardParser::ApplyEdit(const TextEdit& edit)
+    {
+        if (edit.offset > m_text.size() || edit.length > m_text.size() - edit.offset)
+        {
+            throw AdaptiveCardParseException(ErrorStatusCode::InvalidPropertyValue, "The edit is past the end of the card's text");
+        }
+
+        // The path from the card to the smallest element that holds the edit, not counting the element's braces
+        std::vector<Node*> path;
+        if (m_root)
+        {
+            path.push_back(m_root.get());
+            for (;;)
+            {
+                auto& children = path.back()->children;
+                const auto next = std::upper_bound(children.begin(), children.end(), edit.offset, [](size_t offset, const Node& node) {
+                    return offset < node.span.begin;
+                });
+                if (next == children.begin())
+                {
+                    break;
+                }
+
+                Node& child = *(next - 1);
+                if (child.span.begin >= edit.offset || edit.offset + edit.length >= child.span.end)
+                {
+                    break;
+                }
+                path.push_back(&child);
+            }
+        }
+
+        m_text.replace(edit.offset, edit.length, edit.replacement);
+
+        if (path.size() > 1)
+        {
+            if (auto parseResult = ParseElement(path, edit))
+            {
+                return parseResult;
+            }
+        }
+        return ParseAll();
+    }
+
+    bool IncrementalCardParser::GetSourceSpan(const BaseElement& element, SourceSpan& span) const
+    {
+        const Node* node = m_root ? m_root->Find(element) : nullptr;
+        if (node == nullptr || node == m_root.get())
+        {
+            return false;
+        }
+        span = node->span;
+        return true;
+    }
+
+    std::shared_ptr<ParseResult> IncrementalCardParser::ParseAll()
+    {
+        // Until this succeeds, the next edit parses everything again too
+        m_card = nullptr;
+        m_root.reset();
+        m_idCounts.clear();
+        m_lastParsedElement = nullptr;
+
+        Recorder recorder;
+        ParseContext context(m_elementParserRegistration, m_actionParserRegistration);
+        context.SetObserver(&recorder);
+        context.BeginParse(m_text.size());
+
+        const Json::Value json = ParseUtil::GetJsonValueFromString(m_text);
+        const auto parseResult = AdaptiveCard::Deserialize(json, m_rendererVersion, context);
+
+        std::unique_ptr<Node> root(new Node{nullptr, ChildKind::Element, 0, {0, m_text.size()}, ContainerStyle::None, {}, ContainerBleedDirection::BleedAll, false, {}, {}, {}});
+        Builder(*parseResult->GetAdaptiveCard(), recorder, context.warnings, 0)
+            .Build(*root, json, {0, recorder.GetRecords().size()}, {0, context.warnings.size()});
+
+        recorder.CountIds(m_idCounts);
+        m_card = parseResult->GetAdaptiveCard();
+        m_root = std::move(root);
+        return parseResult;
+    }
+
+    // Parses the last element on the path again, in the state the parse of the whole card was in as it started the
+    // element. Returns nullptr, having changed nothing, if the whole card has to be parsed again instead.
+    std::shared_ptr<ParseResult> IncrementalCardParser::ParseElement(std::vector<Node*>& path, const TextEdit& edit)
+    {
+        Node& node = *path.back();
+        const BaseElement* parent = path[path.size() - 2]->element.get();
+        const ptrdiff_t delta = static_cast<ptrdiff_t>(edit.replacement.size()) - static_cast<ptrdiff_t>(edit.length);
+        const SourceSpan span{node.span.begin, node.span.end + delta};
+
+        Json::Value json;
+        if (!ReadObject(m_text.data() + span.begin, m_text.data() + span.end, json))
+        {
+            return nullptr;
+        }
+
+        Recorder recorder;
+        ParseContext context(m_elementParserRegistration, m_actionParserRegistration);
+        context.SetObserver(&recorder);
+        context.SetLanguage(m_card->GetLanguageRef());
+        context.RestoreElementState(node.parentalContainerStyle, node.paddingParentInternalId, node.bleedDirection, node.canFallbackToAncestor);
+
+        std::shared_ptr<BaseElement> element;
+        try
+        {
+            element = ParseChild(context, json, node.kind);
+        }
+        catch (...)
+        {
+            // Whatever the element's parsers throw (as jsoncpp's do for a type that isn't a string), parsing the whole
+            // card throws it too, and leaves the next edit to parse everything again
+            return nullptr;
+        }
+
+        // An element that changes the state it leaves the parse in (as a ShowCard with a styled card does) changes how
+        // the rest of the card is parsed
+        if (element == nullptr || context.GetParentalContainerStyle() != node.parentalContainerStyle ||
+            context.PaddingParentInternalId() != node.paddingParentInternalId ||
+            context.GetBleedDirection() != node.bleedDirection || context.GetCanFallbackToAncestor() != node.canFallbackToAncestor)
+        {
+            return nullptr;
+        }
+
+        // The element's ids were checked against each other as it was parsed. Any it shares with the rest of the card
+        // may collide, which parsing the whole card decides.
+        std::unordered_map<std::string, size_t> oldIds;
+        node.CountIds(oldIds);
+        std::unordered_map<std::string, size_t> newIds;
+        recorder.CountIds(newIds);
+        for (const auto& id : newIds)
+        {
+            const auto oldCount = oldIds.find(id.first);
+            if (m_idCounts[id.first] > ((oldCount != oldIds.end()) ? oldCount->second : 0))
+            {
+                return nullptr;
+            }
+        }
+
+        ReplaceChild(*m_card, const_cast<BaseElement*>(parent), node.kind, node.index, element);
+        if (parent == nullptr && node.kind == ChildKind::Action && static_cast<BaseActionElement*>(element.get())->GetElementType() == ActionType::ShowCard)
+        {
+            std::static_pointer_cast<ShowCardAction>(element)->SetDefaultCardVersion(m_card->GetVersionRef());
+        }
+        m_card->InvalidateElementIndex();
+
+        for (const auto& id : oldIds)
+        {
+            auto count = m_idCounts.find(id.first);
+            count->second -= id.second;
+            if (count->second == 0)
+            {
+                m_idCounts.erase(count);
+            }
+        }
+        for (const auto& id : newIds)
+        {
+            m_idCounts[id.first] += id.second;
+        }
+
+        Node parsed{element,
+                    node.kind,
+                    node.index,
+                    span,
+                    node.parentalContainerStyle,
+                    node.paddingParentInternalId,
+                    node.bleedDirection,
+                    node.canFallbackToAncestor,
+                    {},
+                    {},
+                    {}};
+        Builder(*m_card, recorder, context.warnings, span.begin)
+            .Build(parsed, json, {0, recorder.GetRecords().size()}, {0, context.warnings.size()});
+
+        m_root->ShiftSpans(edit.offset + edit.length, delta);
+        node = std::move(parsed);
+
+        m_lastParsedElement = element;
+        return std::make_shared<ParseResult>(m_card, GetWarnings());
+    }
+
+    std::vector<std::shared_ptr<AdaptiveCardParseWarning>> IncrementalCardParser::GetWarnings() const
+    {
+        std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings;
+        m_root->AddWarnings(warnings);
+        return warnings;
+    }
+}
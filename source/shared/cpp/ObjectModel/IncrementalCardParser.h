@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "ParseContext.h"
+#include "ParseResult.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // A change to the text of a card: the length bytes at offset are replaced with replacement
+    struct TextEdit
+    {
+        size_t offset;
+        size_t length;
+        std::string replacement;
+    };
+
+    // Where an element came from in the text of a card, as the byte offsets of its opening and just past its closing
+    // brace
+    struct SourceSpan
+    {
+        size_t begin;
+        size_t end;
+    };
+
+    // IncrementalCardParser keeps a card parsed from text, along with where each element in the card's lists of
+    // children came from, for editors that show the card as its JSON is typed. After an edit to the text only the
+    // smallest such element that holds the edit is parsed again, in the state the rest of the card left the parse in,
+    // and put in the old one's place in the card. Its ids are checked against those in the rest of the card. Edits
+    // to the card's own properties, or that leave the element as anything other than one JSON object, parse the
+    // whole card again, as does an edit that may make an id collide.
+    //
+    // The card is changed in place by an edit that's parsed incrementally, so renderers holding it see the change.
+    // A card parsed in full is a new card. Either way the result holds the same card and warnings as parsing the whole
+    // text with AdaptiveCard::DeserializeFromString would, though not always with the warnings in the same order.
+    class IncrementalCardParser
+    {
+    public:
+        IncrementalCardParser(const std::string& rendererVersion = std::string(),
+                              std::shared_ptr<ElementParserRegistration> elementRegistration = nullptr,
+                              std::shared_ptr<ActionParserRegistration> actionRegistration = nullptr);
+        ~IncrementalCardParser();
+
+        // Parses the whole text, as DeserializeFromString does
+        std::shared_ptr<ParseResult> Parse(const std::string& jsonText);
+
+        // Applies the edit to the text and parses as little of it again as it can. Throws as DeserializeFromString
+        // would for the edited text; the edit is still applied, and the next one parses the whole text again.
+        std::shared_ptr<ParseResult> ApplyEdit(const TextEdit& edit);
+
+        const std::string& GetText() const { return m_text; }
+
+        // The element that was parsed again for the last edit, or nullptr if the whole card was
+        std::shared_ptr<BaseElement> GetLastParsedElement() const { return m_lastParsedElement; }
+
+        // Where the element came from in the text, for the elements in the card's lists of children (its body and
+        // actions, the items of containers and columns, the columns of column sets, the images of image sets and the
+        // actions of action sets). Returns false for anything else.
+        bool GetSourceSpan(const BaseElement& element, SourceSpan& span) const;
+
+    private:
+        struct Node;
+        class Recorder;
+        class Builder;
+
+        std::shared_ptr<ParseResult> ParseAll();
+        std::shared_ptr<ParseResult> ParseElement(std::vector<Node*>& path, const TextEdit& edit);
+        std::vector<std::shared_ptr<AdaptiveCardParseWarning>> GetWarnings() const;
+
+        const std::string m_rendererVersion;
+        std::shared_ptr<ElementParserRegistration> m_elementParserRegistration;
+        std::shared_ptr<ActionParserRegistration> m_actionParserRegistration;
+
+        std::string m_text;
+        std::shared_ptr<AdaptiveCard> m_card;
+        std::shared_ptr<BaseElement> m_lastParsedElement;
+
+        // The card, with its children in the order they appear in the text
+        std::unique_ptr<Node> m_root;
+
+        // How many elements in the card have each id, counting fallback content and the cards of ShowCard actions
+        std::unordered_map<std::string, size_t> m_idCounts;
+    };
+}
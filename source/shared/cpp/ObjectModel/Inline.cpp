@@ -35,6 +35,11 @@ Json::Value Inline::GetAdditionalProperties() const
     return m_additionalProperties;
 }
 
+const Json::Value& Inline::GetAdditionalPropertiesRef() const
+{
+    return m_additionalProperties;
+}
+
 void Inline::SetAdditionalProperties(Json::Value const& value)
 {
     m_additionalProperties = value;
@@ -48,5 +53,6 @@ std::shared_ptr<Inline> Inline::Deserialize(ParseContext& context, const Json::V
 
 void Inline::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)});
+    static const std::unordered_set<std::string> knownProperties{AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)};
+    m_sharedKnownProperties = &knownProperties;
 }
@@ -29,11 +29,15 @@ namespace AdaptiveSharedNamespace
         static std::shared_ptr<Inline> Deserialize(ParseContext& context, const Json::Value& root);
 
         Json::Value GetAdditionalProperties() const;
+        const Json::Value& GetAdditionalPropertiesRef() const;
         void SetAdditionalProperties(const Json::Value& additionalProperties);
 
     protected:
         void PopulateKnownPropertiesSet();
+
+        // Instance and shared known properties; see BaseElement::m_knownProperties and m_sharedKnownProperties
         std::unordered_set<std::string> m_knownProperties;
+        const std::unordered_set<std::string>* m_sharedKnownProperties = nullptr;
         Json::Value m_additionalProperties;
 
     private:
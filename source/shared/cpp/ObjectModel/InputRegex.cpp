@@ -0,0 +1,764 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "InputRegex.h"
+
+namespace
+{
+    const char32_t c_maxCodePoint = 0x10FFFF;
+    const uint32_t c_unbounded = std::numeric_limits<uint32_t>::max();
+
+    // Counted repetition is compiled by copying, so a pattern like (a{1000}){1000} could otherwise make a program too
+    // big to match quickly. Anything larger than this isn't supported.
+    const size_t c_maxProgramSize = 10000;
+    const unsigned int c_maxGroupDepth = 200;
+
+    // Thrown while compiling: the pattern needs backtracking, or isn't a valid pattern at all
+    struct UnsupportedPattern
+    {
+    };
+    struct InvalidPattern
+    {
+    };
+
+    std::vector<char32_t> DecodeUtf8(const std::string& text)
+    {
+        std::vector<char32_t> codePoints;
+        codePoints.reserve(text.size());
+        for (size_t i = 0; i < text.size();)
+        {
+            const unsigned char lead = static_cast<unsigned char>(text[i]);
+            size_t length = (lead < 0x80) ? 1 : ((lead >> 5) == 0x6) ? 2 : ((lead >> 4) == 0xE) ? 3 : ((lead >> 3) == 0x1E) ? 4 : 0;
+            char32_t codePoint = (length == 1) ? lead : (length == 2) ? (lead & 0x1F) : (length == 3) ? (lead & 0x0F) : (lead & 0x07);
+            for (size_t j = 1; j < length; j++)
+            {
+                const unsigned char continuation = (i + j < text.size()) ? static_cast<unsigned char>(text[i + j]) : 0;
+                if ((continuation >> 6) != 0x2)
+                {
+                    length = 0;
+                    break;
+                }
+                codePoint = (codePoint << 6) | (continuation & 0x3F);
+            }
+
+            // Malformed sequences become U+FFFD, one byte at a time
+            codePoints.push_back((length == 0) ? 0xFFFD : codePoint);
+            i += (length == 0) ? 1 : length;
+        }
+        return codePoints;
+    }
+
+    bool IsLineTerminator(char32_t c) { return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029; }
+
+    bool IsWordChar(char32_t c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    typedef std::vector<std::pair<char32_t, char32_t>> Ranges;
+
+    Ranges ShorthandRanges(char32_t shorthand)
+    {
+        switch (shorthand)
+        {
+        case 'd':
+            return {{'0', '9'}};
+        case 'w':
+            return {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+        default:
+            return {{'\t', '\r'}, {' ', ' '}, {0xA0, 0xA0}, {0x1680, 0x1680}, {0x2000, 0x200A}, {0x2028, 0x2029},
+                    {0x202F, 0x202F}, {0x205F, 0x205F}, {0x3000, 0x3000}, {0xFEFF, 0xFEFF}};
+        }
+    }
+
+    // The complement of sorted, non-overlapping ranges
+    Ranges Complement(const Ranges& ranges)
+    {
+        Ranges complement;
+        char32_t next = 0;
+        for (const auto& range : ranges)
+        {
+            if (range.first > next)
+            {
+                complement.emplace_back(next, range.first - 1);
+            }
+            next = range.second + 1;
+        }
+        if (next <= c_maxCodePoint)
+        {
+            complement.emplace_back(next, c_maxCodePoint);
+        }
+        return complement;
+    }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    struct InputRegex::Node
+    {
+        enum class Type
+        {
+            Char,
+            Any,
+            Class,
+            Assertion,
+            Concat,
+            Alternate,
+            Repeat
+        };
+
+        explicit Node(Type type, uint32_t value = 0) : type(type), value(value), min(0), max(0) {}
+
+        Type type;
+        uint32_t value; // The character, class index or assertion Op
+        uint32_t min;
+        uint32_t max;
+        std::vector<Node> children;
+    };
+
+    // Recursive descent parser for the pattern, producing a Node tree and the character classes it refers to
+    class InputRegex::Parser
+    {
+    public:
+        Parser(const std::string& pattern, std::vector<CharClass>& classes) :
+            m_pattern(DecodeUtf8(pattern)), m_position(0), m_depth(0), m_classes(classes)
+        {
+        }
+
+        Node Parse()
+        {
+            Node node = ParseAlternation();
+            if (!AtEnd())
+            {
+                // An unmatched ')'
+                throw InvalidPattern();
+            }
+            return node;
+        }
+
+    private:
+        bool AtEnd() const { return m_position == m_pattern.size(); }
+        char32_t Peek(size_t offset = 0) const
+        {
+            return (m_position + offset < m_pattern.size()) ? m_pattern[m_position + offset] : 0;
+        }
+        char32_t Next()
+        {
+            if (AtEnd())
+            {
+                throw InvalidPattern();
+            }
+            return m_pattern[m_position++];
+        }
+
+        Node ParseAlternation()
+        {
+            Node alternation(Node::Type::Alternate);
+            alternation.children.push_back(ParseConcatenation());
+            while (!AtEnd() && Peek() == '|')
+            {
+                m_position++;
+                alternation.children.push_back(ParseConcatenation());
+            }
+            return (alternation.children.size() == 1) ? std::move(alternation.children.front()) : std::move(alternation);
+        }
+
+        Node ParseConcatenation()
+        {
+            Node concatenation(Node::Type::Concat);
+            while (!AtEnd() && Peek() != '|' && Peek() != ')')
+            {
+                concatenation.children.push_back(ParseQuantified());
+            }
+            return concatenation;
+        }
+
+        Node ParseQuantified()
+        {
+            Node atom = ParseAtom();
+
+            uint32_t min, max;
+            if (!ParseQuantifier(min, max))
+            {
+                return atom;
+            }
+            if (atom.type == Node::Type::Assertion)
+            {
+                throw InvalidPattern();
+            }
+
+            // Lazy quantifiers match the same strings as greedy ones
+            if (!AtEnd() && Peek() == '?')
+            {
+                m_position++;
+            }
+
+            Node repeat(Node::Type::Repeat);
+            repeat.min = min;
+            repeat.max = max;
+            repeat.children.push_back(std::move(atom));
+            return repeat;
+        }
+
+        bool ParseQuantifier(uint32_t& min, uint32_t& max)
+        {
+            switch (Peek())
+            {
+            case '*':
+                m_position++;
+                min = 0;
+                max = c_unbounded;
+                return true;
+            case '+':
+                m_position++;
+                min = 1;
+                max = c_unbounded;
+                return true;
+            case '?':
+                m_position++;
+                min = 0;
+                max = 1;
+                return true;
+            case '{':
+            {
+                // A '{' that doesn't start a well-formed {n}, {n,} or {n,m} is an ordinary character
+                size_t position = m_position + 1;
+                if (!ParseNumber(position, min))
+                {
+                    return false;
+                }
+                max = min;
+                if (position < m_pattern.size() && m_pattern[position] == ',')
+                {
+                    position++;
+                    if (!ParseNumber(position, max))
+                    {
+                        max = c_unbounded;
+                    }
+                }
+                if (position >= m_pattern.size() || m_pattern[position] != '}')
+                {
+                    return false;
+                }
+                if (max < min)
+                {
+                    throw InvalidPattern();
+                }
+                m_position = position + 1;
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        bool ParseNumber(size_t& position, uint32_t& number) const
+        {
+            const size_t start = position;
+            number = 0;
+            while (position < m_pattern.size() && m_pattern[position] >= '0' && m_pattern[position] <= '9')
+            {
+                // Clamped well past anything c_maxProgramSize allows
+                number = std::min<uint32_t>(number * 10 + (m_pattern[position] - '0'), 100000);
+                position++;
+            }
+            return position != start;
+        }
+
+        Node ParseAtom()
+        {
+            const char32_t c = Next();
+            switch (c)
+            {
+            case '(':
+                return ParseGroup();
+            case '[':
+                return ParseClass();
+            case '.':
+                return Node(Node::Type::Any);
+            case '^':
+                return Node(Node::Type::Assertion, static_cast<uint32_t>(Op::InputStart));
+            case '$':
+                return Node(Node::Type::Assertion, static_cast<uint32_t>(Op::InputEnd));
+            case '*':
+            case '+':
+            case '?':
+                // Nothing to repeat
+                throw InvalidPattern();
+            case '{':
+            {
+                // A well-formed {n}, {n,} or {n,m} here follows another quantifier, or nothing, as in a{2}{3}; any other
+                // '{' is an ordinary character
+                uint32_t min, max;
+                m_position--;
+                if (ParseQuantifier(min, max))
+                {
+                    throw InvalidPattern();
+                }
+                m_position++;
+                return Node(Node::Type::Char, c);
+            }
+            case '\\':
+                return ParseEscape();
+            default:
+                return Node(Node::Type::Char, c);
+            }
+        }
+
+        Node ParseGroup()
+        {
+            // Parsing and compiling are recursive, so nesting is limited to keep the stack in bounds
+            if (++m_depth > c_maxGroupDepth)
+            {
+                throw InvalidPattern();
+            }
+
+            if (Peek() == '?')
+            {
+                if (Peek(1) == ':')
+                {
+                    m_position += 2;
+                }
+                else if (Peek(1) == '<' && Peek(2) != '=' && Peek(2) != '!')
+                {
+                    // Named group; the name only matters to backreferences, which aren't supported here
+                    while (Next() != '>')
+                    {
+                    }
+                }
+                else
+                {
+                    // Lookahead and lookbehind
+                    throw UnsupportedPattern();
+                }
+            }
+
+            Node group = ParseAlternation();
+            if (Next() != ')')
+            {
+                throw InvalidPattern();
+            }
+            m_depth--;
+            return group;
+        }
+
+        Node ParseEscape()
+        {
+            const char32_t c = Next();
+            switch (c)
+            {
+            case 'd':
+            case 'w':
+            case 's':
+                return AddClass(ShorthandRanges(c), false);
+            case 'D':
+            case 'W':
+            case 'S':
+                return AddClass(ShorthandRanges(c - 'A' + 'a'), true);
+            case 'b':
+                return Node(Node::Type::Assertion, static_cast<uint32_t>(Op::WordBoundary));
+            case 'B':
+                return Node(Node::Type::Assertion, static_cast<uint32_t>(Op::NotWordBoundary));
+            case 'k':
+                throw UnsupportedPattern();
+            default:
+                if (c >= '1' && c <= '9')
+                {
+                    // Backreference
+                    throw UnsupportedPattern();
+                }
+                return Node(Node::Type::Char, ParseCharacterEscape(c));
+            }
+        }
+
+        // Escapes that stand for a single character, in or out of a class
+        char32_t ParseCharacterEscape(char32_t c)
+        {
+            switch (c)
+            {
+            case 't':
+                return '\t';
+            case 'n':
+                return '\n';
+            case 'r':
+                return '\r';
+            case 'v':
+                return '\v';
+            case 'f':
+                return '\f';
+            case '0':
+                return 0;
+            case 'c':
+            {
+                const char32_t letter = Peek();
+                if ((letter >= 'a' && letter <= 'z') || (letter >= 'A' && letter <= 'Z'))
+                {
+                    m_position++;
+                    return letter % 32;
+                }
+                return '\\';
+            }
+            case 'x':
+                return ParseHex(2, c);
+            case 'u':
+                return ParseHex(4, c);
+            default:
+                return c;
+            }
+        }
+
+        // \xHH and \uHHHH; without enough hex digits the escape is just the letter
+        char32_t ParseHex(size_t digits, char32_t letter)
+        {
+            char32_t value = 0;
+            for (size_t i = 0; i < digits; i++)
+            {
+                const char32_t digit = Peek(i);
+                if (!std::isxdigit(static_cast<int>(digit < 0x80 ? digit : 0)))
+                {
+                    return letter;
+                }
+                value = value * 16 + static_cast<char32_t>((digit <= '9') ? (digit - '0') : ((digit | 0x20) - 'a' + 10));
+            }
+            m_position += digits;
+            return value;
+        }
+
+        Node ParseClass()
+        {
+            bool negated = false;
+            if (Peek() == '^')
+            {
+                negated = true;
+                m_position++;
+            }
+
+            Ranges ranges;
+            while (AtEnd() || Peek() != ']')
+            {
+                bool isShorthand;
+                const char32_t first = ParseClassAtom(ranges, isShorthand);
+                if (isShorthand)
+                {
+                    continue;
+                }
+
+                if (Peek() == '-' && Peek(1) != ']' && !AtEnd())
+                {
+                    m_position++;
+                    const char32_t last = ParseClassAtom(ranges, isShorthand);
+                    if (isShorthand)
+                    {
+                        // [a-\d] is a, -, and digits
+                        ranges.emplace_back(first, first);
+                        ranges.emplace_back('-', '-');
+                        continue;
+                    }
+                    if (last < first)
+                    {
+                        throw InvalidPattern();
+                    }
+                    ranges.emplace_back(first, last);
+                }
+                else
+                {
+                    ranges.emplace_back(first, first);
+                }
+            }
+            m_position++;
+
+            return AddClass(Normalize(ranges), negated);
+        }
+
+        // Returns the character, or adds a shorthand class like \d to ranges
+        char32_t ParseClassAtom(Ranges& ranges, bool& isShorthand)
+        {
+            isShorthand = false;
+            const char32_t c = Next();
+            if (c != '\\')
+            {
+                return c;
+            }
+
+            const char32_t escaped = Next();
+            switch (escaped)
+            {
+            case 'd':
+            case 'w':
+            case 's':
+            case 'D':
+            case 'W':
+            case 'S':
+            {
+                const Ranges shorthand = ShorthandRanges((escaped < 'a') ? (escaped - 'A' + 'a') : escaped);
+                const Ranges added = (escaped < 'a') ? Complement(shorthand) : shorthand;
+                ranges.insert(ranges.end(), added.begin(), added.end());
+                isShorthand = true;
+                return 0;
+            }
+            case 'b':
+                return '\b';
+            case '-':
+                return '-';
+            default:
+                if (escaped >= '1' && escaped <= '9')
+                {
+                    throw UnsupportedPattern();
+                }
+                return ParseCharacterEscape(escaped);
+            }
+        }
+
+        static Ranges Normalize(Ranges ranges)
+        {
+            std::sort(ranges.begin(), ranges.end());
+            Ranges merged;
+            for (const auto& range : ranges)
+            {
+                if (!merged.empty() && range.first <= merged.back().second + 1)
+                {
+                    merged.back().second = std::max(merged.back().second, range.second);
+                }
+                else
+                {
+                    merged.push_back(range);
+                }
+            }
+            return merged;
+        }
+
+        Node AddClass(Ranges ranges, bool negated)
+        {
+            m_classes.push_back({std::move(ranges), negated});
+            return Node(Node::Type::Class, static_cast<uint32_t>(m_classes.size() - 1));
+        }
+
+        std::vector<char32_t> m_pattern;
+        size_t m_position;
+        unsigned int m_depth;
+        std::vector<CharClass>& m_classes;
+    };
+
+    bool InputRegex::CharClass::Contains(char32_t c) const
+    {
+        const auto range = std::lower_bound(ranges.begin(), ranges.end(), c, [](const std::pair<char32_t, char32_t>& range, char32_t c) {
+            return range.second < c;
+        });
+        return (range != ranges.end() && range->first <= c) != negated;
+    }
+
+    InputRegex::InputRegex(const std::string& pattern) : m_isValid(true), m_isSupported(true)
+    {
+        try
+        {
+            const Node root = Parser(pattern, m_classes).Parse();
+            EmitNode(root);
+            Emit(Op::Match);
+        }
+        catch (const InvalidPattern&)
+        {
+            m_isValid = false;
+        }
+        catch (const UnsupportedPattern&)
+        {
+            m_isValid = false;
+            m_isSupported = false;
+        }
+    }
+
+    bool InputRegex::IsValid() const { return m_isValid; }
+
+    bool InputRegex::IsSupported() const { return m_isSupported; }
+
+    uint32_t InputRegex::Emit(Op op, uint32_t x, uint32_t y)
+    {
+        if (m_program.size() >= c_maxProgramSize)
+        {
+            throw UnsupportedPattern();
+        }
+        m_program.push_back({op, x, y});
+        return static_cast<uint32_t>(m_program.size() - 1);
+    }
+
+    void InputRegex::EmitNode(const Node& node)
+    {
+        switch (node.type)
+        {
+        case Node::Type::Char:
+            Emit(Op::Char, node.value);
+            break;
+        case Node::Type::Any:
+            Emit(Op::Any);
+            break;
+        case Node::Type::Class:
+            Emit(Op::Class, node.value);
+            break;
+        case Node::Type::Assertion:
+            Emit(static_cast<Op>(node.value));
+            break;
+        case Node::Type::Concat:
+            for (const auto& child : node.children)
+            {
+                EmitNode(child);
+            }
+            break;
+        case Node::Type::Alternate:
+        {
+            //     split L1, L2
+            // L1: <first>
+            //     jump end
+            // L2: <second> ...
+            std::vector<uint32_t> jumps;
+            for (size_t i = 0; i + 1 < node.children.size(); i++)
+            {
+                const uint32_t split = Emit(Op::Split, static_cast<uint32_t>(m_program.size() + 1));
+                EmitNode(node.children[i]);
+                jumps.push_back(Emit(Op::Jump));
+                m_program[split].y = static_cast<uint32_t>(m_program.size());
+            }
+            EmitNode(node.children.back());
+            for (const auto jump : jumps)
+            {
+                m_program[jump].x = static_cast<uint32_t>(m_program.size());
+            }
+            break;
+        }
+        case Node::Type::Repeat:
+        {
+            const Node& child = node.children.front();
+            for (uint32_t i = 0; i < node.min; i++)
+            {
+                EmitNode(child);
+            }
+
+            if (node.max == c_unbounded)
+            {
+                // loop: split body, end
+                // body: <child>
+                //       jump loop
+                const uint32_t split = Emit(Op::Split, static_cast<uint32_t>(m_program.size() + 1));
+                EmitNode(child);
+                Emit(Op::Jump, split);
+                m_program[split].y = static_cast<uint32_t>(m_program.size());
+            }
+            else
+            {
+                // Each optional copy can skip straight to the end
+                std::vector<uint32_t> splits;
+                for (uint32_t i = node.min; i < node.max; i++)
+                {
+                    splits.push_back(Emit(Op::Split, static_cast<uint32_t>(m_program.size() + 1)));
+                    EmitNode(child);
+                }
+                for (const auto split : splits)
+                {
+                    m_program[split].y = static_cast<uint32_t>(m_program.size());
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    bool InputRegex::Search(const std::string& text) const
+    {
+        if (!m_isValid)
+        {
+            return false;
+        }
+
+        const std::vector<char32_t> chars = DecodeUtf8(text);
+        const size_t length = chars.size();
+
+        // The threads waiting to match the character at the current position, and those for the next one. Each
+        // instruction is added to a list at most once per position, which is what bounds the work per character.
+        std::vector<uint32_t> current, next, stack;
+        current.reserve(m_program.size());
+        next.reserve(m_program.size());
+        std::vector<size_t> addedAt(m_program.size(), std::numeric_limits<size_t>::max());
+
+        // Follows jumps, splits and assertions from pc at position, adding the instructions that consume a character
+        // to list. Returns true on reaching Match.
+        auto addThread = [&](std::vector<uint32_t>& list, uint32_t pc, size_t position) {
+            const bool wordBefore = position > 0 && IsWordChar(chars[position - 1]);
+            const bool wordAfter = position < length && IsWordChar(chars[position]);
+            stack.push_back(pc);
+            while (!stack.empty())
+            {
+                pc = stack.back();
+                stack.pop_back();
+                if (addedAt[pc] == position)
+                {
+                    continue;
+                }
+                addedAt[pc] = position;
+
+                const Instruction& instruction = m_program[pc];
+                switch (instruction.op)
+                {
+                case Op::Jump:
+                    stack.push_back(instruction.x);
+                    break;
+                case Op::Split:
+                    stack.push_back(instruction.y);
+                    stack.push_back(instruction.x);
+                    break;
+                case Op::InputStart:
+                    if (position == 0)
+                    {
+                        stack.push_back(pc + 1);
+                    }
+                    break;
+                case Op::InputEnd:
+                    if (position == length)
+                    {
+                        stack.push_back(pc + 1);
+                    }
+                    break;
+                case Op::WordBoundary:
+                case Op::NotWordBoundary:
+                    if ((wordBefore != wordAfter) == (instruction.op == Op::WordBoundary))
+                    {
+                        stack.push_back(pc + 1);
+                    }
+                    break;
+                case Op::Match:
+                    stack.clear();
+                    return true;
+                default:
+                    list.push_back(pc);
+                    break;
+                }
+            }
+            return false;
+        };
+
+        for (size_t position = 0;; position++)
+        {
+            // A match may start at any position
+            if (addThread(current, 0, position))
+            {
+                return true;
+            }
+            if (position == length)
+            {
+                return false;
+            }
+
+            const char32_t c = chars[position];
+            next.clear();
+            for (const auto pc : current)
+            {
+                const Instruction& instruction = m_program[pc];
+                const bool matches = (instruction.op == Op::Char) ? (c == instruction.x) :
+                                     (instruction.op == Op::Any)  ? !IsLineTerminator(c) :
+                                                                    m_classes[instruction.x].Contains(c);
+                if (matches && addThread(next, pc + 1, position + 1))
+                {
+                    return true;
+                }
+            }
+            std::swap(current, next);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // InputRegex is a compiled TextInput regex. Patterns are compiled once into a program for a Thompson NFA, which
+    // checks every possible match at once rather than backtracking, so matching takes time linear in the length of
+    // the text whatever the pattern. The syntax is that of JavaScript regular expressions without flags, other than
+    // the few constructs that need backtracking (backreferences and lookaround). Since patterns come from the card,
+    // those aren't handed to a backtracking engine; they, and patterns whose program would be too big to match
+    // quickly, are treated as invalid.
+    //
+    // As in the JavaScript renderer, a pattern matches if it matches any part of the text; use ^ and $ to match all of
+    // it. InputRegex is immutable once compiled and can be shared between threads.
+    class InputRegex
+    {
+    public:
+        explicit InputRegex(const std::string& pattern);
+        InputRegex(const InputRegex&) = delete;
+        InputRegex& operator=(const InputRegex&) = delete;
+
+        // False if the pattern isn't a valid regular expression, or isn't supported. Invalid patterns match nothing.
+        bool IsValid() const;
+
+        // False if the pattern needs backtracking or compiles to too big a program, so it's treated as invalid
+        bool IsSupported() const;
+
+        bool Search(const std::string& text) const;
+
+    private:
+        enum class Op : unsigned char
+        {
+            Char,
+            Any,
+            Class,
+            Split,
+            Jump,
+            InputStart,
+            InputEnd,
+            WordBoundary,
+            NotWordBoundary,
+            Match
+        };
+
+        struct Instruction
+        {
+            Op op;
+            uint32_t x;
+            uint32_t y;
+        };
+
+        struct CharClass
+        {
+            std::vector<std::pair<char32_t, char32_t>> ranges;
+            bool negated;
+
+            bool Contains(char32_t c) const;
+        };
+
+        class Parser;
+        struct Node;
+
+        uint32_t Emit(Op op, uint32_t x = 0, uint32_t y = 0);
+        void EmitNode(const Node& node);
+
+        std::vector<Instruction> m_program;
+        std::vector<CharClass> m_classes;
+        bool m_isValid;
+        bool m_isSupported;
+    };
+}
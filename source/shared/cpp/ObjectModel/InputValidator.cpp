@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "InputValidator.h"
+#include <cmath>
+#include <cstring>
+#include "CardIterator.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateInput.h"
+#include "NumberInput.h"
+#include "SubmitAction.h"
+#include "TextInput.h"
+#include "TimeInput.h"
+#include "ToggleInput.h"
+
+namespace
+{
+    // Dates are YYYY-MM-DD and times HH:MM, so well-formed values compare correctly as strings
+    bool MatchesFormat(const std::string& value, const char* format)
+    {
+        const size_t length = strlen(format);
+        if (value.size() != length)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < length; i++)
+        {
+            if ((format[i] == 'd') ? !std::isdigit(static_cast<unsigned char>(value[i])) : (value[i] != format[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    AdaptiveSharedNamespace::InputValidationResult
+    ValidateRange(const std::string& value, const std::string& min, const std::string& max, const char* format)
+    {
+        using AdaptiveSharedNamespace::InputValidationResult;
+        if (!MatchesFormat(value, format))
+        {
+            return InputValidationResult::InvalidValue;
+        }
+        if (MatchesFormat(min, format) && value < min)
+        {
+            return InputValidationResult::BelowMin;
+        }
+        if (MatchesFormat(max, format) && value > max)
+        {
+            return InputValidationResult::AboveMax;
+        }
+        return InputValidationResult::Valid;
+    }
+
+    size_t CountCodePoints(const std::string& value)
+    {
+        return std::count_if(value.begin(), value.end(), [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; });
+    }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    InputValidationResult InputValidator::Validate(const BaseInputElement& input, const std::string& value)
+    {
+        const bool isToggle = input.GetElementType() == CardElementType::ToggleInput;
+        if (value.empty() || (isToggle && value != static_cast<const ToggleInput&>(input).GetValueOnRef()))
+        {
+            return input.GetIsRequired() ? InputValidationResult::Required : InputValidationResult::Valid;
+        }
+
+        switch (input.GetElementType())
+        {
+        case CardElementType::TextInput:
+        {
+            const auto& textInput = static_cast<const TextInput&>(input);
+            if (textInput.GetMaxLength() != 0 && CountCodePoints(value) > textInput.GetMaxLength())
+            {
+                return InputValidationResult::TooLong;
+            }
+            if (!textInput.GetRegexRef().empty())
+            {
+                const auto regex = GetRegex(textInput.GetRegexRef());
+                if (!regex->IsValid())
+                {
+                    return InputValidationResult::InvalidRegex;
+                }
+                if (!regex->Search(value))
+                {
+                    return InputValidationResult::RegexMismatch;
+                }
+            }
+            break;
+        }
+        case CardElementType::NumberInput:
+        {
+            const auto& numberInput = static_cast<const NumberInput&>(input);
+            char* end;
+            const double number = strtod(value.c_str(), &end);
+            if (end != value.c_str() + value.size() || !std::isfinite(number))
+            {
+                return InputValidationResult::InvalidValue;
+            }
+            // The limits of int stand for min and max not being set
+            const int min = numberInput.GetMin();
+            const int max = numberInput.GetMax();
+            if (min != std::numeric_limits<int>::min() && number < min)
+            {
+                return InputValidationResult::BelowMin;
+            }
+            if (max != std::numeric_limits<int>::max() && number > max)
+            {
+                return InputValidationResult::AboveMax;
+            }
+            break;
+        }
+        case CardElementType::DateInput:
+        {
+            const auto& dateInput = static_cast<const DateInput&>(input);
+            return ValidateRange(value, dateInput.GetMinRef(), dateInput.GetMaxRef(), "dddd-dd-dd");
+        }
+        case CardElementType::TimeInput:
+        {
+            const auto& timeInput = static_cast<const TimeInput&>(input);
+            return ValidateRange(value, timeInput.GetMinRef(), timeInput.GetMaxRef(), "dd:dd");
+        }
+        default:
+            break;
+        }
+        return InputValidationResult::Valid;
+    }
+
+    std::vector<InputValidationError> InputValidator::Validate(const AdaptiveCard& card,
+                                                               const std::unordered_map<std::string, std::string>& values)
+    {
+        std::vector<InputValidationError> errors;
+        ValidateElements(card.GetBody(), values, errors);
+        return errors;
+    }
+
+    std::vector<InputValidationError> InputValidator::ValidateForSubmit(const AdaptiveCard& card,
+                                                                        const SubmitAction& action,
+                                                                        const std::unordered_map<std::string, std::string>& values)
+    {
+        if (action.GetIgnoreInputValidation())
+        {
+            return {};
+        }
+
+        // The cards that hold the node being walked, outermost first
+        std::vector<const AdaptiveCard*> cards;
+        CardIteratorOptions options;
+        options.order = CardTraversalOrder::PreAndPostOrder;
+        options.includeFallbackContent = true;
+        options.includeSelectActions = true;
+        CardIterator iterator(card, options);
+        bool isFound = false;
+        while (!isFound && iterator.Next())
+        {
+            const CardNode& node = iterator.GetNode();
+            if (node.GetKind() == CardNodeKind::Card)
+            {
+                if (iterator.IsLeaving())
+                {
+                    cards.pop_back();
+                }
+                else
+                {
+                    cards.push_back(node.GetCard());
+                }
+            }
+            else
+            {
+                isFound = node.GetAction() == &action;
+            }
+        }
+        if (!isFound)
+        {
+            return Validate(card, values);
+        }
+
+        std::vector<InputValidationError> errors;
+        for (const auto submittedCard : cards)
+        {
+            ValidateElements(submittedCard->GetBody(), values, errors);
+        }
+        return errors;
+    }
+
+    std::shared_ptr<const InputRegex> InputValidator::GetRegex(const std::string& pattern)
+    {
+        auto& regex = m_regexes[pattern];
+        if (!regex)
+        {
+            regex = std::make_shared<InputRegex>(pattern);
+        }
+        return regex;
+    }
+
+    void InputValidator::ValidateElements(const std::vector<std::shared_ptr<BaseCardElement>>& elements,
+                                          const std::unordered_map<std::string, std::string>& values,
+                                          std::vector<InputValidationError>& errors)
+    {
+        static const std::string noValue;
+        for (const auto& element : elements)
+        {
+            if (!element->GetIsVisible())
+            {
+                continue;
+            }
+
+            switch (element->GetElementType())
+            {
+            case CardElementType::Container:
+                ValidateElements(std::static_pointer_cast<Container>(element)->GetItems(), values, errors);
+                break;
+            case CardElementType::Column:
+                ValidateElements(std::static_pointer_cast<Column>(element)->GetItems(), values, errors);
+                break;
+            case CardElementType::ColumnSet:
+                for (const auto& column : std::static_pointer_cast<ColumnSet>(element)->GetColumns())
+                {
+                    if (column->GetIsVisible())
+                    {
+                        ValidateElements(column->GetItems(), values, errors);
+                    }
+                }
+                break;
+            case CardElementType::ChoiceSetInput:
+            case CardElementType::DateInput:
+            case CardElementType::NumberInput:
+            case CardElementType::TextInput:
+            case CardElementType::TimeInput:
+            case CardElementType::ToggleInput:
+            {
+                auto input = std::static_pointer_cast<BaseInputElement>(element);
+                const auto value = values.find(input->GetId());
+                const auto result = Validate(*input, (value != values.end()) ? value->second : noValue);
+                if (result != InputValidationResult::Valid)
+                {
+                    errors.push_back({input, result});
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "BaseInputElement.h"
+#include "InputRegex.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class SubmitAction;
+
+    enum class InputValidationResult
+    {
+        Valid = 0,
+        Required,      // isRequired and no value (or an unchecked Input.Toggle)
+        RegexMismatch, // Input.Text value doesn't match regex
+        TooLong,       // Input.Text value is longer than maxLength characters
+        BelowMin,      // Input.Number, Input.Date or Input.Time value is less than min
+        AboveMax,      // ... or greater than max
+        InvalidValue,  // Input.Number, Input.Date or Input.Time value isn't a number, YYYY-MM-DD date or HH:MM time
+        InvalidRegex,  // Input.Text regex isn't a valid pattern or isn't supported by InputRegex, so no value can match it
+    };
+
+    struct InputValidationError
+    {
+        std::shared_ptr<BaseInputElement> input;
+        InputValidationResult result;
+    };
+
+    // InputValidator checks input values against the constraints in the card: isRequired, Input.Text's maxLength and
+    // regex, and min and max for Input.Number, Input.Date and Input.Time. Values are given as strings, the way they'd
+    // appear in submitted data. Constraints other than isRequired only apply to inputs that have a value, and min and
+    // max only where the card sets them. Hidden inputs, and inputs in hidden containers, aren't validated.
+    //
+    // Regexes are compiled the first time they're seen and kept for the life of the validator (see InputRegex), so
+    // keep one validator around to check inputs as they change.
+    class InputValidator
+    {
+    public:
+        InputValidator() = default;
+        InputValidator(const InputValidator&) = delete;
+        InputValidator& operator=(const InputValidator&) = delete;
+
+        InputValidationResult Validate(const BaseInputElement& input, const std::string& value);
+
+        // Validates every input in the card in one pass, skipping fallback content and the cards of ShowCard actions.
+        // values maps input ids to their current values; inputs missing from it have no value.
+        std::vector<InputValidationError> Validate(const AdaptiveCard& card, const std::unordered_map<std::string, std::string>& values);
+
+        // Validates the inputs submitted with action: those of the card the action is in, be it the card itself or the
+        // card of a ShowCard action, and of the cards that contain that one. Nothing is validated if the action asks for
+        // input validation to be skipped. If the action isn't in the card, the card's own inputs are validated.
+        std::vector<InputValidationError> ValidateForSubmit(const AdaptiveCard& card,
+                                                            const SubmitAction& action,
+                                                            const std::unordered_map<std::string, std::string>& values);
+
+        std::shared_ptr<const InputRegex> GetRegex(const std::string& pattern);
+
+    private:
+        void ValidateElements(const std::vector<std::shared_ptr<BaseCardElement>>& elements,
+                              const std::unordered_map<std::string, std::string>& values,
+                              std::vector<InputValidationError>& errors);
+
+        std::unordered_map<std::string, std::shared_ptr<const InputRegex>> m_regexes;
+    };
+}
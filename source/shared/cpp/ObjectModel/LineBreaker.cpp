@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "LineBreaker.h"
+#include <limits>
+
+namespace AdaptiveSharedNamespace
+{
+    LineBreaker::LineBreaker(std::shared_ptr<TextMeasurer> measurer, FontType fontType, TextSize size, TextWeight weight) :
+        m_measurer(measurer), m_fontType(fontType), m_size(size), m_weight(weight)
+    {
+        m_spaceWidth = m_measurer->MeasureWidth(" ", m_fontType, m_size, m_weight);
+    }
+
+    size_t LineBreaker::FindParagraphEnd(const std::string& text, size_t begin) const
+    {
+        const size_t end = text.find('\n', begin);
+        return (end == std::string::npos) ? text.size() : end;
+    }
+
+    void LineBreaker::MeasureWords(const std::string& text, size_t begin, size_t end)
+    {
+        m_words.clear();
+
+        size_t index = begin;
+        while (index < end)
+        {
+            while (index < end && (text[index] == ' ' || text[index] == '\r' || text[index] == '\t'))
+            {
+                ++index;
+            }
+
+            const size_t wordBegin = index;
+            while (index < end && text[index] != ' ' && text[index] != '\r' && text[index] != '\t')
+            {
+                ++index;
+            }
+
+            if (index > wordBegin)
+            {
+                m_word.assign(text, wordBegin, index - wordBegin);
+                m_words.push_back({wordBegin, index, m_measurer->MeasureWidth(m_word, m_fontType, m_size, m_weight)});
+            }
+        }
+    }
+
+    std::vector<TextLine> LineBreaker::BreakGreedy(const std::string& text, double maxWidth)
+    {
+        std::vector<TextLine> lines;
+
+        size_t paragraphBegin = 0;
+        do
+        {
+            const size_t paragraphEnd = FindParagraphEnd(text, paragraphBegin);
+            MeasureWords(text, paragraphBegin, paragraphEnd);
+
+            if (m_words.empty())
+            {
+                lines.push_back({paragraphBegin, paragraphBegin, 0});
+            }
+
+            for (size_t i = 0; i < m_words.size(); ++i)
+            {
+                const Word& word = m_words[i];
+                if (i != 0 && lines.back().width + m_spaceWidth + word.width <= maxWidth)
+                {
+                    lines.back().end = word.end;
+                    lines.back().width += m_spaceWidth + word.width;
+                }
+                else
+                {
+                    lines.push_back({word.begin, word.end, word.width});
+                }
+            }
+
+            paragraphBegin = paragraphEnd + 1;
+        } while (paragraphBegin <= text.size());
+
+        return lines;
+    }
+
+    size_t LineBreaker::CountLinesGreedy(const std::string& text, double maxWidth)
+    {
+        size_t lineCount = 0;
+
+        size_t paragraphBegin = 0;
+        do
+        {
+            const size_t paragraphEnd = FindParagraphEnd(text, paragraphBegin);
+            MeasureWords(text, paragraphBegin, paragraphEnd);
+
+            double lineWidth = 0;
+            for (size_t i = 0; i < m_words.size(); ++i)
+            {
+                if (i != 0 && lineWidth + m_spaceWidth + m_words[i].width <= maxWidth)
+                {
+                    lineWidth += m_spaceWidth + m_words[i].width;
+                }
+                else
+                {
+                    ++lineCount;
+                    lineWidth = m_words[i].width;
+                }
+            }
+
+            if (m_words.empty())
+            {
+                ++lineCount;
+            }
+
+            paragraphBegin = paragraphEnd + 1;
+        } while (paragraphBegin <= text.size());
+
+        return lineCount;
+    }
+
+    std::vector<TextLine> LineBreaker::BreakOptimal(const std::string& text, double maxWidth)
+    {
+        std::vector<TextLine> lines;
+
+        size_t paragraphBegin = 0;
+        do
+        {
+            const size_t paragraphEnd = FindParagraphEnd(text, paragraphBegin);
+            MeasureWords(text, paragraphBegin, paragraphEnd);
+
+            const size_t wordCount = m_words.size();
+            if (wordCount == 0)
+            {
+                lines.push_back({paragraphBegin, paragraphBegin, 0});
+            }
+            else
+            {
+                // m_costs[j] is the least cost of laying out the first j words; m_breaks[j] is where the last of
+                // those lines starts. Only lines that fit (or hold a single overlong word) are considered, so the
+                // inner loop stops as soon as a candidate line gets too wide.
+                m_costs.assign(wordCount + 1, std::numeric_limits<double>::infinity());
+                m_breaks.assign(wordCount + 1, 0);
+                m_costs[0] = 0;
+
+                for (size_t j = 1; j <= wordCount; ++j)
+                {
+                    double lineWidth = -m_spaceWidth;
+                    for (size_t i = j; i-- > 0;)
+                    {
+                        lineWidth += m_spaceWidth + m_words[i].width;
+                        if (lineWidth > maxWidth && i != j - 1)
+                        {
+                            break;
+                        }
+
+                        const double slack = (j == wordCount) ? 0 : std::max(0.0, maxWidth - lineWidth);
+                        const double cost = m_costs[i] + slack * slack;
+                        if (cost < m_costs[j])
+                        {
+                            m_costs[j] = cost;
+                            m_breaks[j] = i;
+                        }
+                    }
+                }
+
+                const size_t firstLine = lines.size();
+                for (size_t j = wordCount; j > 0; j = m_breaks[j])
+                {
+                    const size_t i = m_breaks[j];
+                    double lineWidth = m_words[i].width;
+                    for (size_t k = i + 1; k < j; ++k)
+                    {
+                        lineWidth += m_spaceWidth + m_words[k].width;
+                    }
+                    lines.push_back({m_words[i].begin, m_words[j - 1].end, lineWidth});
+                }
+                std::reverse(lines.begin() + firstLine, lines.end());
+            }
+
+            paragraphBegin = paragraphEnd + 1;
+        } while (paragraphBegin <= text.size());
+
+        return lines;
+    }
+}
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "TextMeasurer.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // A line of broken text. begin and end are byte offsets into the source string; end is exclusive and excludes the
+    // whitespace the line was broken at.
+    struct TextLine
+    {
+        size_t begin;
+        size_t end;
+        double width;
+    };
+
+    // LineBreaker splits text into lines no wider than a given width. Lines are broken at spaces, and '\n' always
+    // starts a new line. A word that is wider than the line on its own is placed on a line by itself.
+    //
+    // Words are measured individually through the supplied TextMeasurer, so wrapping it in a CachingTextMeasurer lets
+    // repeated words across many strings share a single measurement.
+    class LineBreaker
+    {
+    public:
+        LineBreaker(std::shared_ptr<TextMeasurer> measurer, FontType fontType, TextSize size, TextWeight weight);
+
+        // Fills each line with as many words as fit. This matches how platform text controls wrap.
+        std::vector<TextLine> BreakGreedy(const std::string& text, double maxWidth);
+
+        // Same as BreakGreedy, but only counts the lines.
+        size_t CountLinesGreedy(const std::string& text, double maxWidth);
+
+        // Chooses breaks that minimize the sum of squared slack over every line except the last, producing more even
+        // line lengths than BreakGreedy. It never produces fewer lines than BreakGreedy.
+        std::vector<TextLine> BreakOptimal(const std::string& text, double maxWidth);
+
+    private:
+        struct Word
+        {
+            size_t begin;
+            size_t end;
+            double width;
+        };
+
+        void MeasureWords(const std::string& text, size_t begin, size_t end);
+        size_t FindParagraphEnd(const std::string& text, size_t begin) const;
+
+        std::shared_ptr<TextMeasurer> m_measurer;
+        FontType m_fontType;
+        TextSize m_size;
+        TextWeight m_weight;
+        double m_spaceWidth;
+
+        // scratch buffers reused across calls
+        std::vector<Word> m_words;
+        std::string m_word;
+        std::vector<double> m_costs;
+        std::vector<size_t> m_breaks;
+    };
+}
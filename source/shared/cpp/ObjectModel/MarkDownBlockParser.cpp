@@ -483,17 +483,11 @@ bool LinkParser::MatchAtLinkDestinationRun(std::stringstream& lookahead)
 
 // this method is called when link syntax check is complete
 // it processes the parsed result from link destination  and link text
-// and build a MarkDownStringHtmlGenerator that will output
+// and build a MarkDownLinkHtmlGenerator that will output
 // string in link syntax (text)[destination) will converts to
 // <a href=\destination\>text</a>
 void LinkParser::CaptureLinkToken()
 {
-    std::ostringstream html;
-    html << "<a href=\"";
-    // process link destination
-    html << m_parsedResult.GenerateHtmlString();
-    html << "\">";
-
     // when syntax check is complete, we have seen
     // '[', ']', '(', these keywords are not
     // needed anymore, so pop them from the parse result
@@ -506,13 +500,15 @@ void LinkParser::CaptureLinkToken()
     // translate what is captured in text of link
     // emphasis are processed here
     m_linkTextParsedResult.Translate();
-    html << m_linkTextParsedResult.GenerateHtmlString();
-    html << "</a>";
 
-    std::string html_string = html.str();
+    // the link keeps its destination and text, and generates them when asked
+    std::shared_ptr<MarkDownParsedResult> destination = std::make_shared<MarkDownParsedResult>();
+    destination->AppendParseResult(m_parsedResult);
+    std::shared_ptr<MarkDownParsedResult> text = std::make_shared<MarkDownParsedResult>();
+    text->AppendParseResult(m_linkTextParsedResult);
 
-    // Generate a MarkDownStringHtmlGenerator object
-    std::shared_ptr<MarkDownHtmlGenerator> codeGen = std::make_shared<MarkDownStringHtmlGenerator>(html_string);
+    // Generate a MarkDownLinkHtmlGenerator object
+    std::shared_ptr<MarkDownHtmlGenerator> codeGen = std::make_shared<MarkDownLinkHtmlGenerator>(destination, text);
 
     m_parsedResult.Clear();
     m_parsedResult.FoundHtmlTags();
@@ -657,16 +653,12 @@ void ListParser::Match(std::stringstream& stream)
 
 void ListParser::CaptureListToken()
 {
-    std::ostringstream html;
     m_parsedResult.Translate();
-    std::string htmlString = m_parsedResult.GenerateHtmlString();
-
-    html << "<li>";
-    html << htmlString;
-    html << "</li>";
 
-    std::string html_string = html.str();
-    std::shared_ptr<MarkDownListHtmlGenerator> codeGen = std::make_shared<MarkDownListHtmlGenerator>(html_string);
+    // the list item keeps its content, and generates it when asked
+    std::shared_ptr<MarkDownParsedResult> content = std::make_shared<MarkDownParsedResult>();
+    content->AppendParseResult(m_parsedResult);
+    std::shared_ptr<MarkDownListHtmlGenerator> codeGen = std::make_shared<MarkDownListHtmlGenerator>(content);
 
     m_parsedResult.Clear();
     m_parsedResult.FoundHtmlTags();
@@ -711,17 +703,13 @@ void OrderedListParser::Match(std::stringstream& stream)
 
 void OrderedListParser::CaptureOrderedListToken(std::string& number_string)
 {
-    std::ostringstream html;
     m_parsedResult.Translate();
-    std::string htmlString = m_parsedResult.GenerateHtmlString();
-
-    html << "<li>";
-    html << htmlString;
-    html << "</li>";
 
-    std::string html_string = html.str();
+    // the list item keeps its content, and generates it when asked
+    std::shared_ptr<MarkDownParsedResult> content = std::make_shared<MarkDownParsedResult>();
+    content->AppendParseResult(m_parsedResult);
     std::shared_ptr<MarkDownOrderedListHtmlGenerator> codeGen =
-        std::make_shared<MarkDownOrderedListHtmlGenerator>(html_string, number_string);
+        std::make_shared<MarkDownOrderedListHtmlGenerator>(content, number_string);
 
     m_parsedResult.Clear();
     m_parsedResult.FoundHtmlTags();
@@ -2,9 +2,82 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "MarkDownHtmlGenerator.h"
+#include "MarkDownParsedResult.h"
 
 using namespace AdaptiveSharedNamespace;
 
+void MarkDownStyledRunBuilder::BeginParagraph()
+{
+    BeginBlock(MarkDownStyledBlockType::Paragraph);
+    m_listNumber = 0;
+}
+
+void MarkDownStyledRunBuilder::BeginListItem()
+{
+    BeginBlock(MarkDownStyledBlockType::UnorderedListItem);
+    m_listNumber = 0;
+}
+
+// the first item of an ordered list is shown with its own number, and the items after it count up from there
+void MarkDownStyledRunBuilder::BeginOrderedListItem(const std::string& number, bool isFirstItem)
+{
+    const bool continuesList = (m_blockCount > 0 && m_blockType == MarkDownStyledBlockType::OrderedListItem);
+    BeginBlock(MarkDownStyledBlockType::OrderedListItem);
+    if (isFirstItem || !continuesList)
+    {
+        m_listNumber = static_cast<unsigned int>(std::strtoul(number.c_str(), nullptr, 10));
+    }
+    else
+    {
+        m_listNumber++;
+    }
+}
+
+void MarkDownStyledRunBuilder::BeginBlock(MarkDownStyledBlockType blockType)
+{
+    m_blockType = blockType;
+    m_blockIndex = m_blockCount++;
+}
+
+void MarkDownStyledRunBuilder::ApplyTag(EmphasisTag tag)
+{
+    switch (tag)
+    {
+    case EmphasisTag::OpenItalic:
+        m_italicDepth++;
+        break;
+    case EmphasisTag::CloseItalic:
+        m_italicDepth = std::max(m_italicDepth - 1, 0);
+        break;
+    case EmphasisTag::OpenBold:
+        m_boldDepth++;
+        break;
+    case EmphasisTag::CloseBold:
+        m_boldDepth = std::max(m_boldDepth - 1, 0);
+        break;
+    }
+}
+
+// appends text to the last run if it has the same style, or starts a new run
+void MarkDownStyledRunBuilder::AppendText(const std::string& text)
+{
+    if (text.empty())
+    {
+        return;
+    }
+
+    const bool isItalic = (m_italicDepth > 0);
+    const bool isBold = (m_boldDepth > 0);
+    auto& runs = m_styledText.runs;
+    if (runs.empty() || runs.back().isItalic != isItalic || runs.back().isBold != isBold || runs.back().link != m_link ||
+        runs.back().blockIndex != m_blockIndex)
+    {
+        runs.push_back({m_styledText.text.size(), 0, isBold, isItalic, m_link, m_blockType, m_blockIndex, m_listNumber});
+    }
+    runs.back().length += text.size();
+    m_styledText.text += text;
+}
+
 std::string MarkDownStringHtmlGenerator::GenerateHtmlString()
 {
     if (m_isHead)
@@ -20,6 +93,15 @@ std::string MarkDownStringHtmlGenerator::GenerateHtmlString()
     return m_token;
 }
 
+void MarkDownStringHtmlGenerator::GenerateStyledRuns(MarkDownStyledRunBuilder& builder)
+{
+    if (m_isHead)
+    {
+        builder.BeginParagraph();
+    }
+    builder.AppendText(m_token);
+}
+
 //     left and right emphasis tokens are match if
 //     1. they are same types
 //     2. neither of the emphasis tokens are both left and right emphasis tokens, and
@@ -85,26 +167,46 @@ bool MarkDownEmphasisHtmlGenerator::GenerateTags(MarkDownEmphasisHtmlGenerator&
 
 void MarkDownEmphasisHtmlGenerator::PushItalicTag()
 {
-    m_tags.push_back("<em>");
+    m_tags.push_back(EmphasisTag::OpenItalic);
 }
 
 void MarkDownEmphasisHtmlGenerator::PushBoldTag()
 {
-    m_tags.push_back("<strong>");
+    m_tags.push_back(EmphasisTag::OpenBold);
+}
+
+std::string MarkDownEmphasisHtmlGenerator::GetUnusedDelimiters() const
+{
+    return m_token.substr(m_token.size() - m_numberOfUnusedDelimiters, std::string::npos);
+}
+
+const char* MarkDownEmphasisHtmlGenerator::GetHtmlTag(EmphasisTag tag)
+{
+    switch (tag)
+    {
+    case EmphasisTag::OpenItalic:
+        return "<em>";
+    case EmphasisTag::CloseItalic:
+        return "</em>";
+    case EmphasisTag::OpenBold:
+        return "<strong>";
+    case EmphasisTag::CloseBold:
+        return "</strong>";
+    }
+    return "";
 }
 
 std::string MarkDownLeftEmphasisHtmlGenerator::GenerateHtmlString()
 {
     if (m_numberOfUnusedDelimiters)
     {
-        const size_t startIdx = m_token.size() - m_numberOfUnusedDelimiters;
-        html << m_token.substr(startIdx, std::string::npos);
+        html << GetUnusedDelimiters();
     }
 
     // append tags; since left delims, append it in the reverse order
     for (auto itr = m_tags.rbegin(); itr != m_tags.rend(); ++itr)
     {
-        html << *itr;
+        html << GetHtmlTag(*itr);
     }
 
     if (m_isHead)
@@ -120,14 +222,32 @@ std::string MarkDownLeftEmphasisHtmlGenerator::GenerateHtmlString()
     return html.str();
 }
 
+void MarkDownLeftEmphasisHtmlGenerator::GenerateStyledRuns(MarkDownStyledRunBuilder& builder)
+{
+    if (m_isHead)
+    {
+        builder.BeginParagraph();
+    }
+
+    if (m_numberOfUnusedDelimiters)
+    {
+        builder.AppendText(GetUnusedDelimiters());
+    }
+
+    for (auto itr = m_tags.rbegin(); itr != m_tags.rend(); ++itr)
+    {
+        builder.ApplyTag(*itr);
+    }
+}
+
 void MarkDownRightEmphasisHtmlGenerator::PushItalicTag()
 {
-    m_tags.push_back("</em>");
+    m_tags.push_back(EmphasisTag::CloseItalic);
 }
 
 void MarkDownRightEmphasisHtmlGenerator::PushBoldTag()
 {
-    m_tags.push_back("</strong>");
+    m_tags.push_back(EmphasisTag::CloseBold);
 }
 
 std::string MarkDownRightEmphasisHtmlGenerator::GenerateHtmlString()
@@ -135,14 +255,13 @@ std::string MarkDownRightEmphasisHtmlGenerator::GenerateHtmlString()
     // append tags;
     for (auto itr = m_tags.begin(); itr != m_tags.end(); ++itr)
     {
-        html << *itr;
+        html << GetHtmlTag(*itr);
     }
 
     // if there are unused emphasis, append them
     if (m_numberOfUnusedDelimiters)
     {
-        const size_t startIdx = m_token.size() - m_numberOfUnusedDelimiters;
-        html << m_token.substr(startIdx, std::string::npos);
+        html << GetUnusedDelimiters();
     }
 
     if (m_isHead)
@@ -158,15 +277,33 @@ std::string MarkDownRightEmphasisHtmlGenerator::GenerateHtmlString()
     return html.str();
 }
 
+void MarkDownRightEmphasisHtmlGenerator::GenerateStyledRuns(MarkDownStyledRunBuilder& builder)
+{
+    if (m_isHead)
+    {
+        builder.BeginParagraph();
+    }
+
+    for (auto itr = m_tags.begin(); itr != m_tags.end(); ++itr)
+    {
+        builder.ApplyTag(*itr);
+    }
+
+    if (m_numberOfUnusedDelimiters)
+    {
+        builder.AppendText(GetUnusedDelimiters());
+    }
+}
+
 void MarkDownLeftAndRightEmphasisHtmlGenerator::PushItalicTag()
 {
     if (m_directionType == Left)
     {
-        m_tags.push_back("<em>");
+        m_tags.push_back(EmphasisTag::OpenItalic);
     }
     else
     {
-        m_tags.push_back("</em>");
+        m_tags.push_back(EmphasisTag::CloseItalic);
     }
 }
 
@@ -174,16 +311,63 @@ void MarkDownLeftAndRightEmphasisHtmlGenerator::PushBoldTag()
 {
     if (m_directionType == Left)
     {
-        m_tags.push_back("<strong>");
+        m_tags.push_back(EmphasisTag::OpenBold);
     }
     else
     {
-        m_tags.push_back("</strong>");
+        m_tags.push_back(EmphasisTag::CloseBold);
+    }
+}
+
+MarkDownLinkHtmlGenerator::MarkDownLinkHtmlGenerator(const std::shared_ptr<MarkDownParsedResult>& destination,
+                                                     const std::shared_ptr<MarkDownParsedResult>& text) :
+    MarkDownStringHtmlGenerator(std::string()), m_destination(destination), m_text(text)
+{
+}
+
+std::string MarkDownLinkHtmlGenerator::GenerateHtmlString()
+{
+    std::ostringstream link;
+    link << "<a href=\"";
+    link << m_destination->GenerateHtmlString();
+    link << "\">";
+    link << m_text->GenerateHtmlString();
+    link << "</a>";
+    m_token = link.str();
+
+    return MarkDownStringHtmlGenerator::GenerateHtmlString();
+}
+
+void MarkDownLinkHtmlGenerator::GenerateStyledRuns(MarkDownStyledRunBuilder& builder)
+{
+    if (m_isHead)
+    {
+        builder.BeginParagraph();
     }
+
+    // the destination is never translated, so its text is the url as written
+    MarkDownStyledRunBuilder destination;
+    m_destination->GenerateStyledRuns(destination);
+
+    builder.SetLink(destination.GetStyledText().text);
+    m_text->GenerateStyledRuns(builder);
+    builder.SetLink("");
+}
+
+MarkDownListHtmlGenerator::MarkDownListHtmlGenerator(const std::shared_ptr<MarkDownParsedResult>& content) :
+    MarkDownStringHtmlGenerator(std::string()), m_content(content)
+{
+}
+
+void MarkDownListHtmlGenerator::GenerateListItemHtml()
+{
+    m_token = "<li>" + m_content->GenerateHtmlString() + "</li>";
 }
 
 std::string MarkDownListHtmlGenerator::GenerateHtmlString()
 {
+    GenerateListItemHtml();
+
     if (m_isHead)
     {
         m_token = "<ul>" + m_token;
@@ -197,8 +381,16 @@ std::string MarkDownListHtmlGenerator::GenerateHtmlString()
     return m_token;
 }
 
+void MarkDownListHtmlGenerator::GenerateStyledRuns(MarkDownStyledRunBuilder& builder)
+{
+    builder.BeginListItem();
+    m_content->GenerateStyledRuns(builder);
+}
+
 std::string MarkDownOrderedListHtmlGenerator::GenerateHtmlString()
 {
+    GenerateListItemHtml();
+
     if (m_isHead)
     {
         m_token = "<ol start=\"" + m_numberString + "\">" + m_token;
@@ -211,3 +403,9 @@ std::string MarkDownOrderedListHtmlGenerator::GenerateHtmlString()
 
     return m_token;
 }
+
+void MarkDownOrderedListHtmlGenerator::GenerateStyledRuns(MarkDownStyledRunBuilder& builder)
+{
+    builder.BeginOrderedListItem(m_numberString, m_isHead);
+    m_content->GenerateStyledRuns(builder);
+}
@@ -20,6 +20,71 @@ namespace AdaptiveSharedNamespace
         Asterisk
     };
 
+    enum class EmphasisTag
+    {
+        OpenItalic,
+        CloseItalic,
+        OpenBold,
+        CloseBold
+    };
+
+    enum class MarkDownStyledBlockType
+    {
+        Paragraph,
+        UnorderedListItem,
+        OrderedListItem
+    };
+
+    // A span of MarkDownStyledText::text with the same style. start and length are in bytes of UTF-8. Runs of the same
+    // paragraph or list item share a blockIndex; listNumber is the number an ordered list item is shown with.
+    struct MarkDownStyledRun
+    {
+        size_t start;
+        size_t length;
+        bool isBold;
+        bool isItalic;
+        std::string link;
+        MarkDownStyledBlockType blockType;
+        unsigned int blockIndex;
+        unsigned int listNumber;
+    };
+
+    // The text of a markdown string, unescaped and without markdown syntax, and the runs that cover it in order
+    struct MarkDownStyledText
+    {
+        std::string text;
+        std::vector<MarkDownStyledRun> runs;
+    };
+
+    // Collects the styled runs the code gen objects write, tracking the emphasis, link and block they're in
+    class MarkDownStyledRunBuilder
+    {
+    public:
+        void BeginParagraph();
+        void BeginListItem();
+        void BeginOrderedListItem(const std::string& number, bool isFirstItem);
+
+        void ApplyTag(EmphasisTag tag);
+        void SetLink(const std::string& link) { m_link = link; }
+        void AppendText(const std::string& text);
+
+        MarkDownStyledText& GetStyledText() { return m_styledText; }
+
+    private:
+        void BeginBlock(MarkDownStyledBlockType blockType);
+
+        MarkDownStyledText m_styledText;
+        int m_italicDepth = 0;
+        int m_boldDepth = 0;
+        std::string m_link;
+        MarkDownStyledBlockType m_blockType = MarkDownStyledBlockType::Paragraph;
+        unsigned int m_blockIndex = 0;
+        unsigned int m_blockCount = 0;
+        unsigned int m_listNumber = 0;
+    };
+
+    class MarkDownParsedResult;
+
     // this class knows how to generate html string of their types
     // - MarkDownStringHtmlGenerator
     //   it is the most basic form,
@@ -31,6 +96,7 @@ namespace AdaptiveSharedNamespace
     //   it functions similarly as MarkDownStringHtmlGenerator, but its GetBlockType() returns
     //   MarkDownBlockType, this is used in generating html block tags
     //   list uses block tag of <ul> all others use <p>
+    // each of them can also write its text as styled runs instead of html
     class MarkDownHtmlGenerator
     {
     public:
@@ -48,11 +114,12 @@ namespace AdaptiveSharedNamespace
         };
 
         MarkDownHtmlGenerator() : m_token(""){};
-        MarkDownHtmlGenerator(std::string& token) : m_token(token){};
+        MarkDownHtmlGenerator(const std::string& token) : m_token(token){};
         void MakeItHead() { m_isHead = true; }
         void MakeItTail() { m_isTail = true; }
         virtual bool IsNewLine() { return false; }
         virtual std::string GenerateHtmlString() = 0;
+        virtual void GenerateStyledRuns(MarkDownStyledRunBuilder& builder) = 0;
         virtual MarkDownBlockType GetBlockType() const { return ContainerBlock; };
 
     protected:
@@ -75,8 +142,9 @@ namespace AdaptiveSharedNamespace
         MarkDownStringHtmlGenerator& operator=(MarkDownStringHtmlGenerator&&) = delete;
         ~MarkDownStringHtmlGenerator() = default;
 
-        MarkDownStringHtmlGenerator(std::string& token) : MarkDownHtmlGenerator(token){};
+        MarkDownStringHtmlGenerator(const std::string& token) : MarkDownHtmlGenerator(token){};
         std::string GenerateHtmlString() override;
+        void GenerateStyledRuns(MarkDownStyledRunBuilder& builder) override;
     };
 
     // - MarkDownNewLineHtmlGenerator
@@ -111,7 +179,7 @@ namespace AdaptiveSharedNamespace
         MarkDownEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type) :
             MarkDownHtmlGenerator(token), m_numberOfUnusedDelimiters(sizeOfEmphasisDelimiterRun), type(type){};
 
-        MarkDownEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type, std::vector<std::string>& tags) :
+        MarkDownEmphasisHtmlGenerator(std::string& token, int sizeOfEmphasisDelimiterRun, DelimiterType type, std::vector<EmphasisTag>& tags) :
             MarkDownHtmlGenerator(token), m_numberOfUnusedDelimiters(sizeOfEmphasisDelimiterRun), type(type), m_tags(tags){};
 
         virtual bool IsRightEmphasis() const { return false; }
@@ -135,10 +203,12 @@ namespace AdaptiveSharedNamespace
         };
 
         int AdjustEmphasisCounts(int leftOver, MarkDownEmphasisHtmlGenerator& rightToken);
+        std::string GetUnusedDelimiters() const;
+        static const char* GetHtmlTag(EmphasisTag tag);
         int m_numberOfUnusedDelimiters;
         int m_directionType = Right;
         DelimiterType type;
-        std::vector<std::string> m_tags;
+        std::vector<EmphasisTag> m_tags;
     };
 
     // - MarkDownLeftEmphasisHtmlGenerator
@@ -159,11 +229,12 @@ namespace AdaptiveSharedNamespace
         MarkDownLeftEmphasisHtmlGenerator(std::string& token,
                                           int sizeOfEmphasisDelimiterRun,
                                           DelimiterType type,
-                                          std::vector<std::string>& tags) :
+                                          std::vector<EmphasisTag>& tags) :
             MarkDownEmphasisHtmlGenerator(token, sizeOfEmphasisDelimiterRun, type, tags){};
 
         bool IsLeftEmphasis() const override { return true; }
         std::string GenerateHtmlString() override;
+        void GenerateStyledRuns(MarkDownStyledRunBuilder& builder) override;
     };
 
     // - MarkDownRightEmphasisHtmlGenerator
@@ -184,6 +255,7 @@ namespace AdaptiveSharedNamespace
         void GenerateTags(std::shared_ptr<MarkDownEmphasisHtmlGenerator>& token);
         bool IsRightEmphasis() const override { return true; }
         std::string GenerateHtmlString() override;
+        void GenerateStyledRuns(MarkDownStyledRunBuilder& builder) override;
         void PushItalicTag() override;
         void PushBoldTag() override;
     };
@@ -209,9 +281,31 @@ namespace AdaptiveSharedNamespace
         void PushBoldTag() override;
     };
 
+    // - MarkDownLinkHtmlGenerator
+    //   it holds the parsed destination and text of a link, and generates
+    //   <a href="destination">text</a>
+    class MarkDownLinkHtmlGenerator : public MarkDownStringHtmlGenerator
+    {
+    public:
+        MarkDownLinkHtmlGenerator() = delete;
+        MarkDownLinkHtmlGenerator(const MarkDownLinkHtmlGenerator&) = delete;
+        MarkDownLinkHtmlGenerator(MarkDownLinkHtmlGenerator&&) = delete;
+        MarkDownLinkHtmlGenerator& operator=(const MarkDownLinkHtmlGenerator&) = delete;
+        MarkDownLinkHtmlGenerator& operator=(MarkDownLinkHtmlGenerator&&) = delete;
+        ~MarkDownLinkHtmlGenerator() = default;
+
+        MarkDownLinkHtmlGenerator(const std::shared_ptr<MarkDownParsedResult>& destination, const std::shared_ptr<MarkDownParsedResult>& text);
+        std::string GenerateHtmlString() override;
+        void GenerateStyledRuns(MarkDownStyledRunBuilder& builder) override;
+
+    private:
+        std::shared_ptr<MarkDownParsedResult> m_destination;
+        std::shared_ptr<MarkDownParsedResult> m_text;
+    };
+
     // - MarkDownListHtmlGenerator
-    //   it functions similarly as MarkDownStringHtmlGenerator, but its GetBlockType() returns
-    //   UnorderedList type, this is used in generating html block tags <ul>
+    //   it holds the parsed content of a list item, and functions similarly as MarkDownStringHtmlGenerator,
+    //   but its GetBlockType() returns UnorderedList type, this is used in generating html block tags <ul>
     class MarkDownListHtmlGenerator : public MarkDownStringHtmlGenerator
     {
     public:
@@ -222,15 +316,22 @@ namespace AdaptiveSharedNamespace
         MarkDownListHtmlGenerator& operator=(MarkDownListHtmlGenerator&&) = delete;
         ~MarkDownListHtmlGenerator() = default;
 
-        MarkDownListHtmlGenerator(std::string& token) : MarkDownStringHtmlGenerator(token){};
+        MarkDownListHtmlGenerator(const std::shared_ptr<MarkDownParsedResult>& content);
         std::string GenerateHtmlString() override;
+        void GenerateStyledRuns(MarkDownStyledRunBuilder& builder) override;
         MarkDownBlockType GetBlockType() const override { return UnorderedList; };
+
+    protected:
+        // wraps the item's content in <li> tags
+        void GenerateListItemHtml();
+
+        std::shared_ptr<MarkDownParsedResult> m_content;
     };
 
-    // - MarkDownUnorderedListHtmlGenerator
-    //   it functions similarly as MarkDownStringHtmlGenerator, but its GetBlockType() returns
+    // - MarkDownOrderedListHtmlGenerator
+    //   it functions similarly as MarkDownListHtmlGenerator, but its GetBlockType() returns
     //   OrderedList type, this is used in generating html block tags <ol>
-    class MarkDownOrderedListHtmlGenerator : public MarkDownStringHtmlGenerator
+    class MarkDownOrderedListHtmlGenerator : public MarkDownListHtmlGenerator
     {
     public:
         MarkDownOrderedListHtmlGenerator() = delete;
@@ -240,9 +341,10 @@ namespace AdaptiveSharedNamespace
         MarkDownOrderedListHtmlGenerator& operator=(MarkDownOrderedListHtmlGenerator&&) = delete;
         ~MarkDownOrderedListHtmlGenerator() = default;
 
-        MarkDownOrderedListHtmlGenerator(std::string& token, std::string& number_string) :
-            MarkDownStringHtmlGenerator(token), m_numberString(number_string){};
+        MarkDownOrderedListHtmlGenerator(const std::shared_ptr<MarkDownParsedResult>& content, std::string& number_string) :
+            MarkDownListHtmlGenerator(content), m_numberString(number_string){};
         std::string GenerateHtmlString() override;
+        void GenerateStyledRuns(MarkDownStyledRunBuilder& builder) override;
         MarkDownBlockType GetBlockType() const override { return OrderedList; };
 
     private:
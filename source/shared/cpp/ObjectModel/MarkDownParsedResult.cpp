@@ -118,6 +118,14 @@ std::string MarkDownParsedResult::GenerateHtmlString()
     return html.str();
 }
 
+void MarkDownParsedResult::GenerateStyledRuns(MarkDownStyledRunBuilder& builder)
+{
+    for (auto itr = m_codeGenTokens.begin(); itr != m_codeGenTokens.end(); ++itr)
+    {
+        (*itr)->GenerateStyledRuns(builder);
+    }
+}
+
 // Following the rules speicified in CommonMark (http://spec.commonmark.org/0.27/)
 // It generally supports more stricker version of the rules
 // push left delims to stack, until matching right delim is found,
@@ -21,6 +21,9 @@ namespace AdaptiveSharedNamespace
         // Write to html string
         std::string GenerateHtmlString();
 
+        // Write to styled runs instead of html
+        void GenerateStyledRuns(MarkDownStyledRunBuilder& builder);
+
         // Append contents of the given parsing result object
         void AppendParseResult(MarkDownParsedResult&);
 
@@ -20,7 +20,7 @@ std::string MarkDownParser::TransformToHtml()
         return "<p></p>";
     }
     // begin parsing html blocks
-    ParseBlock();
+    ParseBlock(EscapeText());
 
     // process further what is parsed before outputting
     // html string
@@ -33,6 +33,24 @@ std::string MarkDownParser::TransformToHtml()
     return m_parsedResult.GenerateHtmlString();
 }
 
+// transforms string to styled runs
+MarkDownStyledText MarkDownParser::TransformToStyledRuns()
+{
+    MarkDownStyledRunBuilder builder;
+    if (m_text.empty())
+    {
+        return builder.GetStyledText();
+    }
+
+    ParseBlock(m_text);
+    m_parsedResult.Translate();
+    m_parsedResult.AddBlockTags();
+    m_hasHTMLTag = m_parsedResult.HasHtmlTags();
+
+    m_parsedResult.GenerateStyledRuns(builder);
+    return std::move(builder.GetStyledText());
+}
+
 bool MarkDownParser::HasHtmlTags()
 {
     return m_hasHTMLTag;
@@ -44,9 +62,9 @@ bool MarkDownParser::IsEscaped() const
 }
 
 // MarkDown is consisted of Blocks, this methods parses blocks
-void MarkDownParser::ParseBlock()
+void MarkDownParser::ParseBlock(const std::string& text)
 {
-    std::stringstream stream(EscapeText());
+    std::stringstream stream(text);
     EmphasisParser parser;
     while (!stream.eof())
     {
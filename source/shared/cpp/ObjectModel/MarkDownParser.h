@@ -17,12 +17,16 @@ namespace AdaptiveSharedNamespace
 
         std::string TransformToHtml();
 
+        // Parses the text into styled runs instead, for platforms that build attributed strings without an html
+        // parser. The text isn't escaped. A parser produces either html or styled runs, once.
+        MarkDownStyledText TransformToStyledRuns();
+
         bool HasHtmlTags();
 
         bool IsEscaped() const;
 
     private:
-        void ParseBlock();
+        void ParseBlock(const std::string& text);
         std::string EscapeText();
         std::string m_text;
         MarkDownParsedResult m_parsedResult;
@@ -41,6 +41,11 @@ std::string Media::GetPoster() const
     return m_poster;
 }
 
+const std::string& Media::GetPosterRef() const
+{
+    return m_poster;
+}
+
 void Media::SetPoster(const std::string& value)
 {
     m_poster = value;
@@ -51,6 +56,11 @@ std::string Media::GetAltText() const
     return m_altText;
 }
 
+const std::string& Media::GetAltTextRef() const
+{
+    return m_altText;
+}
+
 void Media::SetAltText(const std::string& value)
 {
     m_altText = value;
@@ -61,11 +71,18 @@ std::vector<std::shared_ptr<MediaSource>>& Media::GetSources()
     return m_sources;
 }
 
+const std::vector<std::shared_ptr<MediaSource>>& Media::GetSources() const
+{
+    return m_sources;
+}
+
 void Media::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Poster),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::AltText),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Sources)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Poster),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::AltText),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Sources)});
+    m_sharedKnownProperties = &knownProperties;
 }
 
 void Media::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
@@ -97,7 +114,7 @@ std::shared_ptr<BaseCardElement> MediaParser::Deserialize(ParseContext& context,
     std::string mimeBaseType;
     for (auto source : sources)
     {
-        std::string currentMimeType = source->GetMimeType();
+        const std::string& currentMimeType = source->GetMimeTypeRef();
 
         std::string slash("/");
         const size_t slashPosition = currentMimeType.find(slash, 0);
@@ -24,12 +24,15 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue() const override;
 
         std::string GetPoster() const;
+        const std::string& GetPosterRef() const;
         void SetPoster(const std::string& value);
 
         std::string GetAltText() const;
+        const std::string& GetAltTextRef() const;
         void SetAltText(const std::string& value);
 
         std::vector<std::shared_ptr<MediaSource>>& GetSources();
+        const std::vector<std::shared_ptr<MediaSource>>& GetSources() const;
 
         void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo) override;
 
@@ -32,6 +32,11 @@ std::string MediaSource::GetMimeType() const
     return m_mimeType;
 }
 
+const std::string& MediaSource::GetMimeTypeRef() const
+{
+    return m_mimeType;
+}
+
 void MediaSource::SetMimeType(const std::string& value)
 {
     m_mimeType = value;
@@ -42,6 +47,11 @@ std::string MediaSource::GetUrl() const
     return m_url;
 }
 
+const std::string& MediaSource::GetUrlRef() const
+{
+    return m_url;
+}
+
 void MediaSource::SetUrl(const std::string& value)
 {
     m_url = value;
@@ -57,9 +67,9 @@ void MediaSource::GetResourceInformation(std::vector<RemoteResourceInformation>&
     return;
 }
 
-std::shared_ptr<MediaSource> MediaSourceParser::Deserialize(ParseContext&, const Json::Value& json)
+std::shared_ptr<MediaSource> MediaSourceParser::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<MediaSource> mediaSource = std::make_shared<MediaSource>();
+    std::shared_ptr<MediaSource> mediaSource = context.MakeShared<MediaSource>();
 
     mediaSource->SetMimeType(ParseUtil::GetString(json, AdaptiveCardSchemaKey::MimeType, false));
     mediaSource->SetUrl(ParseUtil::GetString(json, AdaptiveCardSchemaKey::Url, false));
@@ -22,9 +22,11 @@ namespace AdaptiveSharedNamespace
         virtual Json::Value SerializeToJsonValue() const;
 
         std::string GetMimeType() const;
+        const std::string& GetMimeTypeRef() const;
         void SetMimeType(const std::string& value);
 
         std::string GetUrl() const;
+        const std::string& GetUrlRef() const;
         void SetUrl(const std::string& value);
 
         virtual void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo);
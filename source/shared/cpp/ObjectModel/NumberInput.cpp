@@ -46,6 +46,11 @@ std::string NumberInput::GetPlaceholder() const
     return m_placeholder;
 }
 
+const std::string& NumberInput::GetPlaceholderRef() const
+{
+    return m_placeholder;
+}
+
 void NumberInput::SetPlaceholder(const std::string& value)
 {
     m_placeholder = value;
@@ -103,8 +108,10 @@ NumberInputParser::DeserializeFromString(ParseContext& context, const std::strin
 
 void NumberInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min)});
+    m_sharedKnownProperties = &knownProperties;
 }
@@ -26,6 +26,11 @@ std::string OpenUrlAction::GetUrl() const
     return m_url;
 }
 
+const std::string& OpenUrlAction::GetUrlRef() const
+{
+    return m_url;
+}
+
 void OpenUrlAction::SetUrl(const std::string& value)
 {
     m_url = value;
@@ -48,5 +53,7 @@ OpenUrlActionParser::DeserializeFromString(ParseContext& context, const std::str
 
 void OpenUrlAction::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Url)});
+    m_sharedKnownProperties = &knownProperties;
 }
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ParseArena.h"
+
+namespace AdaptiveSharedNamespace
+{
+    ParseArena::ParseArena(size_t chunkSize) :
+        m_next(nullptr), m_remaining(0), m_chunkSize(chunkSize), m_bytesAllocated(0), m_bytesReserved(0)
+    {
+    }
+
+    void* ParseArena::Allocate(size_t size, size_t alignment)
+    {
+        size_t padding = (alignment - (reinterpret_cast<uintptr_t>(m_next) % alignment)) % alignment;
+        if (m_next == nullptr || (padding + size) > m_remaining)
+        {
+            // Anything too big to share a chunk gets one of its own, leaving the current chunk in use
+            const size_t chunkSize = std::max(m_chunkSize, size + alignment);
+            m_chunks.emplace_back(new char[chunkSize]);
+            m_bytesReserved += chunkSize;
+
+            char* chunk = m_chunks.back().get();
+            const size_t chunkPadding = (alignment - (reinterpret_cast<uintptr_t>(chunk) % alignment)) % alignment;
+            if (chunkSize != m_chunkSize && m_next != nullptr)
+            {
+                m_bytesAllocated += size;
+                return chunk + chunkPadding;
+            }
+
+            m_next = chunk;
+            m_remaining = chunkSize;
+            padding = chunkPadding;
+        }
+
+        void* allocation = m_next + padding;
+        m_next += padding + size;
+        m_remaining -= padding + size;
+        m_bytesAllocated += size;
+        return allocation;
+    }
+}
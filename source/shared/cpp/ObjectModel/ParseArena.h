@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // ParseArena is a monotonic allocator for the objects that make up a parsed card. Allocations are carved out of large
+    // chunks one after another and are never released individually; every chunk is released at once when the arena is
+    // destroyed. See ParseContext::SetArena.
+    //
+    // Allocate isn't thread-safe. An arena belongs to the one ParseContext it's set on and mustn't be shared with
+    // another context.
+    class ParseArena
+    {
+    public:
+        explicit ParseArena(size_t chunkSize = 16 * 1024);
+        ParseArena(const ParseArena&) = delete;
+        ParseArena& operator=(const ParseArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment);
+
+        // Bytes handed out by Allocate and bytes reserved from the heap for them
+        size_t GetBytesAllocated() const { return m_bytesAllocated; }
+        size_t GetBytesReserved() const { return m_bytesReserved; }
+
+    private:
+        std::vector<std::unique_ptr<char[]>> m_chunks;
+        char* m_next;
+        size_t m_remaining;
+        size_t m_chunkSize;
+        size_t m_bytesAllocated;
+        size_t m_bytesReserved;
+    };
+
+    // Standard allocator over a ParseArena. Each allocator holds a reference to its arena, so anything allocated with
+    // std::allocate_shared keeps the arena alive for as long as it's in use.
+    template<typename T> class ParseArenaAllocator
+    {
+    public:
+        typedef T value_type;
+
+        explicit ParseArenaAllocator(std::shared_ptr<ParseArena> arena) : m_arena(std::move(arena)) {}
+        template<typename U> ParseArenaAllocator(const ParseArenaAllocator<U>& other) : m_arena(other.m_arena) {}
+
+        T* allocate(size_t count) { return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) {}
+
+        template<typename U> bool operator==(const ParseArenaAllocator<U>& other) const { return m_arena == other.m_arena; }
+        template<typename U> bool operator!=(const ParseArenaAllocator<U>& other) const { return m_arena != other.m_arena; }
+
+    private:
+        template<typename U> friend class ParseArenaAllocator;
+
+        std::shared_ptr<ParseArena> m_arena;
+    };
+}
@@ -5,24 +5,81 @@
 #include "AdaptiveCardParseException.h"
 #include "BaseElement.h"
 #include "CollectionTypeElement.h"
+#include "DataUri.h"
 
 namespace AdaptiveSharedNamespace
 {
+    namespace
+    {
+        // interned ID of elements without an "id"
+        constexpr unsigned int c_noId = UINT_MAX;
+
+        // How many elements are parsed between reads of the clock for ParseLimits::timeBudget
+        constexpr size_t c_clockCheckInterval = 64;
+    }
+
+    // Nearly every ID is seen exactly once, so the first entry is stored inline and only repeats (fallback content
+    // sharing an ID with its parent) allocate. Each entry also holds the element it was recorded for, when the element
+    // was registered with AddIdentifiedElement, so that cards can be indexed from these entries.
+    class ParseContext::IdEntries
+    {
+    public:
+        IdEntries() : m_first{}, m_rest{}, m_size(0) {}
+
+        void Add(const AdaptiveSharedNamespace::InternalId& fallbackId, const std::shared_ptr<BaseElement>& element)
+        {
+            if (m_size == 0)
+            {
+                m_first = {fallbackId, element};
+            }
+            else
+            {
+                m_rest.push_back({fallbackId, element});
+            }
+            ++m_size;
+        }
+
+        size_t Size() const { return m_size; }
+
+        const AdaptiveSharedNamespace::InternalId& operator[](size_t index) const { return Get(index).fallbackId; }
+
+        std::shared_ptr<BaseElement> GetElement(size_t index) const { return Get(index).element.lock(); }
+
+    private:
+        struct Entry
+        {
+            AdaptiveSharedNamespace::InternalId fallbackId;
+            std::weak_ptr<BaseElement> element;
+        };
+
+        const Entry& Get(size_t index) const { return (index == 0) ? m_first : m_rest[index - 1]; }
+
+        Entry m_first;
+        std::vector<Entry> m_rest;
+        size_t m_size;
+    };
+
     ParseContext::ParseContext() :
         elementParserRegistration{std::make_shared<ElementParserRegistration>()},
-        actionParserRegistration{std::make_shared<ActionParserRegistration>()}, warnings{}, m_elementIds{}, m_idStack{},
-        m_parentalContainerStyles{}, m_parentalPadding{}, m_parentalBleedDirection{}, m_canFallbackToAncestor(false)
+        actionParserRegistration{std::make_shared<ActionParserRegistration>()}, warnings{}, m_internedIds{}, m_elementIds{}, m_idStack{},
+        m_fallbackDepth(0), m_identifiedEntries{}, m_parentalContainerStyles{}, m_parentalPadding{}, m_parentalBleedDirection{}, m_canFallbackToAncestor(false),
+        m_compactChoiceThreshold(0), m_deferShowCardParsing(false), m_sourceText(nullptr), m_observer(nullptr), m_limits{}, m_deadline{}, m_elementCount(0), m_parseBegun(false),
+        m_dataUriInternThreshold(4096)
     {
     }
 
     ParseContext::ParseContext(std::shared_ptr<ElementParserRegistration> elementRegistration, std::shared_ptr<ActionParserRegistration> actionRegistration) :
-        warnings{}, m_elementIds{}, m_idStack{}, m_parentalContainerStyles{}, m_parentalPadding{}, m_parentalBleedDirection{},
-        m_canFallbackToAncestor(false)
+        warnings{}, m_internedIds{}, m_elementIds{}, m_idStack{}, m_fallbackDepth(0), m_identifiedEntries{},
+        m_parentalContainerStyles{}, m_parentalPadding{}, m_parentalBleedDirection{}, m_canFallbackToAncestor(false),
+        m_compactChoiceThreshold(0), m_deferShowCardParsing(false), m_sourceText(nullptr), m_observer(nullptr), m_limits{}, m_deadline{}, m_elementCount(0), m_parseBegun(false),
+        m_dataUriInternThreshold(4096)
     {
         elementParserRegistration = (elementRegistration) ? elementRegistration : std::make_shared<ElementParserRegistration>();
         actionParserRegistration = (actionRegistration) ? actionRegistration : std::make_shared<ActionParserRegistration>();
     }
 
+    ParseContext::~ParseContext() = default;
+
     // Detecting ID collisions
     //
     // A word on nomenclature: There are two identifiers in discussion below. "ID" refers to the value of the "id"
@@ -154,7 +211,179 @@ namespace AdaptiveSharedNamespace
                                              "Attemping to push an element on to the stack with an invalid ID");
         }
 
-        m_idStack.push_back({idJsonProperty, internalId, isFallback});
+        CheckLimits(isFallback);
+
+        m_idStack.emplace_back(idJsonProperty.empty() ? c_noId : InternId(idJsonProperty), internalId, isFallback, nullptr);
+        if (isFallback)
+        {
+            ++m_fallbackDepth;
+        }
+        else if (m_observer)
+        {
+            m_observer->ElementStarted(*this, internalId, idJsonProperty);
+        }
+    }
+
+    void ParseContext::BeginParse(size_t inputSize)
+    {
+        if (m_limits.maxTotalBytes != 0 && inputSize > m_limits.maxTotalBytes)
+        {
+            ThrowLimitExceeded("The card is " + std::to_string(inputSize) + " bytes, more than the limit of " +
+                               std::to_string(m_limits.maxTotalBytes));
+        }
+        m_deadline = std::chrono::steady_clock::now() + m_limits.timeBudget;
+        m_parseBegun = true;
+    }
+
+    void ParseContext::BeginCard(const Json::Value& json)
+    {
+        // Cards of ShowCard actions are part of the card that holds them
+        if (!m_idStack.empty())
+        {
+            return;
+        }
+
+        if (!m_parseBegun)
+        {
+            m_deadline = std::chrono::steady_clock::now() + m_limits.timeBudget;
+        }
+        m_parseBegun = false;
+        m_elementCount = 0;
+
+        if (m_limits.maxStringLength == 0)
+        {
+            return;
+        }
+
+        // Walked with a stack of its own, since a Json::Value built by the host can nest more deeply than the reader
+        // would allow
+        std::vector<const Json::Value*> pending{&json};
+        while (!pending.empty())
+        {
+            const Json::Value& value = *pending.back();
+            pending.pop_back();
+            if (value.isString())
+            {
+                const char* begin;
+                const char* end;
+                value.getString(&begin, &end);
+                if (static_cast<size_t>(end - begin) > m_limits.maxStringLength)
+                {
+                    ThrowLimitExceeded("A string of " + std::to_string(end - begin) + " bytes is longer than the limit of " +
+                                       std::to_string(m_limits.maxStringLength));
+                }
+            }
+            else if (value.isObject())
+            {
+                for (auto member = value.begin(); member != value.end(); ++member)
+                {
+                    const char* end;
+                    const char* begin = member.memberName(&end);
+                    if (static_cast<size_t>(end - begin) > m_limits.maxStringLength)
+                    {
+                        ThrowLimitExceeded("A property name of " + std::to_string(end - begin) +
+                                           " bytes is longer than the limit of " + std::to_string(m_limits.maxStringLength));
+                    }
+                    pending.push_back(&*member);
+                }
+            }
+            else if (value.isArray())
+            {
+                for (const auto& item : value)
+                {
+                    pending.push_back(&item);
+                }
+            }
+        }
+    }
+
+    void ParseContext::CheckLimits(bool isFallback)
+    {
+        // Fallback content is pushed twice, as the element it's the fallback for and then as itself, so it's counted
+        // the second time
+        if (isFallback)
+        {
+            return;
+        }
+
+        if (m_limits.maxDepth != 0 && (m_idStack.size() - m_fallbackDepth) >= m_limits.maxDepth)
+        {
+            ThrowLimitExceeded("Elements are nested more than " + std::to_string(m_limits.maxDepth) + " deep");
+        }
+
+        ++m_elementCount;
+        if (m_limits.maxElementCount != 0 && m_elementCount > m_limits.maxElementCount)
+        {
+            ThrowLimitExceeded("The card has more than " + std::to_string(m_limits.maxElementCount) + " elements");
+        }
+
+        // Reading the clock costs more than parsing a small element, so it's only read every so often
+        if (m_limits.timeBudget.count() != 0 && (m_elementCount % c_clockCheckInterval) == 0 &&
+            std::chrono::steady_clock::now() > m_deadline)
+        {
+            ThrowLimitExceeded("The card took more than " + std::to_string(m_limits.timeBudget.count()) + " ms to parse");
+        }
+    }
+
+    void ParseContext::ThrowLimitExceeded(const std::string& message) const
+    {
+        throw AdaptiveCardParseException(ErrorStatusCode::ParseLimitExceeded, message);
+    }
+
+    unsigned int ParseContext::InternId(const std::string& id)
+    {
+        const auto interned = m_internedIds.emplace(id, static_cast<unsigned int>(m_elementIds.size()));
+        if (interned.second)
+        {
+            m_elementIds.emplace_back();
+        }
+        return interned.first->second;
+    }
+
+    const std::string& ParseContext::GetInternedId(unsigned int internedId) const
+    {
+        // Only needed to report a collision, so a linear search is fine
+        for (const auto& entry : m_internedIds)
+        {
+            if (entry.second == internedId)
+            {
+                return entry.first;
+            }
+        }
+
+        static const std::string emptyId;
+        return emptyId;
+    }
+
+    std::shared_ptr<const DataUri> ParseContext::InternDataUri(const std::string& url)
+    {
+        if (m_dataUriInternThreshold == 0 || url.size() < m_dataUriInternThreshold || !DataUri::IsDataUri(url))
+        {
+            return nullptr;
+        }
+
+        const size_t hash = std::hash<std::string>()(url);
+        const auto candidates = m_internedDataUris.equal_range(hash);
+        for (auto candidate = candidates.first; candidate != candidates.second;)
+        {
+            const auto dataUri = candidate->second.lock();
+            if (!dataUri)
+            {
+                candidate = m_internedDataUris.erase(candidate);
+            }
+            else if (dataUri->GetUri() == url)
+            {
+                return dataUri;
+            }
+            else
+            {
+                ++candidate;
+            }
+        }
+
+        const auto dataUri = std::make_shared<const DataUri>(url);
+        m_internedDataUris.emplace(hash, dataUri);
+        return dataUri;
     }
 
     // Pop the last id off our stack and perform validation (see comment above)
@@ -162,19 +391,25 @@ namespace AdaptiveSharedNamespace
     {
         // about to pop an element off the stack. perform collision list maintenance and detection.
         const auto& idsToPop = m_idStack.back();
-        const std::string& elementId{std::get<TupleIndex::Id>(idsToPop)};
+        const unsigned int elementId{std::get<TupleIndex::Id>(idsToPop)};
         const auto& elementInternalId{std::get<TupleIndex::InternalId>(idsToPop)};
         const bool isFallback{std::get<TupleIndex::IsFallback>(idsToPop)};
 
-        if (!elementId.empty())
+        if (elementId != c_noId)
         {
             bool haveCollision = false;
             const auto& nearestFallbackId = GetNearestFallbackId(elementInternalId);
 
+            // -1 is the last item on the stack (the one we're about to pop)
+            // -2 is the parent of the last item on the stack (toplevel elements have none)
+            const AdaptiveSharedNamespace::InternalId* parentInternalId =
+                (m_idStack.size() >= 2) ? &std::get<TupleIndex::InternalId>(m_idStack[m_idStack.size() - 2]) : nullptr;
+
             // Walk through the list of elements we've seen with this ID
-            for (auto currentEntry = m_elementIds.find(elementId); currentEntry != m_elementIds.end(); ++currentEntry)
+            IdEntries& entries = m_elementIds[elementId];
+            for (size_t i = 0; i < entries.Size(); ++i)
             {
-                const AdaptiveSharedNamespace::InternalId& entryFallbackId = currentEntry->second;
+                const AdaptiveSharedNamespace::InternalId& entryFallbackId = entries[i];
 
                 // If the element we're about to pop is the fallback parent for this entry, then there's no collision
                 // (fallback content is allowed to have the same ID as its parent)
@@ -186,20 +421,10 @@ namespace AdaptiveSharedNamespace
 
                 // The inverse of the above -- if this element's fallback parent is the entry we're looking at, there's
                 // no collision.
-                try
+                if (parentInternalId && *parentInternalId == entryFallbackId)
                 {
-                    // -1 is the last item on the stack (the one we're about to pop)
-                    // -2 is the parent of the last item on the stack
-                    const auto& previousInStack = m_idStack.at(m_idStack.size() - 2);
-                    if (std::get<TupleIndex::InternalId>(previousInStack) == entryFallbackId)
-                    {
-                        // we're looking at a fallback entry for our parent
-                        break;
-                    }
-                }
-                catch (const std::out_of_range&)
-                {
-                    // we're looking at a toplevel element
+                    // we're looking at a fallback entry for our parent
+                    break;
                 }
 
                 // if the element we're inspecting is fallback content, continue on to the next entry
@@ -214,17 +439,75 @@ namespace AdaptiveSharedNamespace
 
             if (haveCollision)
             {
-                throw AdaptiveCardParseException(ErrorStatusCode::IdCollision, "Collision detected for id '" + elementId + "'");
+                throw AdaptiveCardParseException(ErrorStatusCode::IdCollision,
+                                                 "Collision detected for id '" + GetInternedId(elementId) + "'");
             }
 
             // no need to add an entry for this element if it's fallback (we'll add one when we parse it for non-fallback)
             if (!isFallback)
             {
-                m_elementIds.emplace(std::make_pair(elementId, nearestFallbackId));
+                const auto& element = std::get<TupleIndex::Element>(idsToPop);
+                entries.Add(nearestFallbackId, element);
+                if (element)
+                {
+                    m_identifiedEntries.emplace_back(elementId, static_cast<unsigned int>(entries.Size() - 1));
+                }
             }
         }
 
-        m_idStack.pop_back();
+        if (isFallback)
+        {
+            --m_fallbackDepth;
+            m_idStack.pop_back();
+        }
+        else if (m_observer)
+        {
+            const AdaptiveSharedNamespace::InternalId internalId = elementInternalId;
+            m_idStack.pop_back();
+            m_observer->ElementParsed(*this, internalId);
+        }
+        else
+        {
+            m_idStack.pop_back();
+        }
+    }
+
+    void ParseContext::AddIdentifiedElement(const std::shared_ptr<BaseElement>& element)
+    {
+        // The element is the one on top of the stack, and its entry is added as it's popped
+        if (!m_idStack.empty() && !std::get<TupleIndex::IsFallback>(m_idStack.back()) &&
+            std::get<TupleIndex::Id>(m_idStack.back()) != c_noId)
+        {
+            std::get<TupleIndex::Element>(m_idStack.back()) = element;
+        }
+    }
+
+    void ParseContext::IndexIdentifiedElements(size_t first,
+                                               std::unordered_map<std::string, std::vector<std::weak_ptr<BaseElement>>>& index)
+    {
+        // Elements go in ahead of any fallback content with the same id
+        for (const bool isFallback : {false, true})
+        {
+            for (size_t i = first; i < m_identifiedEntries.size(); ++i)
+            {
+                const IdEntries& entries = m_elementIds[m_identifiedEntries[i].first];
+                const unsigned int entry = m_identifiedEntries[i].second;
+                if ((entries[entry] != InternalId::Invalid) == isFallback)
+                {
+                    const auto element = entries.GetElement(entry);
+                    if (element)
+                    {
+                        index[element->GetId()].emplace_back(element);
+                    }
+                }
+            }
+        }
+
+        // Nested (ShowCard) cards leave their elements for the card that contains them
+        if (m_idStack.empty())
+        {
+            m_identifiedEntries.clear();
+        }
     }
 
     // Walk stack looking for first element to be marked fallback (which isn't the ID we're supposed to skip), then
@@ -323,7 +606,20 @@ namespace AdaptiveSharedNamespace
 
     void ParseContext::PopBleedDirection() { m_parentalBleedDirection.pop_back(); }
 
+    void ParseContext::RestoreElementState(const ContainerStyle parentalStyle,
+                                           const AdaptiveSharedNamespace::InternalId& paddingParentInternalId,
+                                           const ContainerBleedDirection bleedDirection,
+                                           const bool canFallbackToAncestor)
+    {
+        m_parentalContainerStyles.push_back(parentalStyle);
+        m_parentalPadding.push_back(paddingParentInternalId);
+        m_parentalBleedDirection.push_back(bleedDirection);
+        m_canFallbackToAncestor = canFallbackToAncestor;
+    }
+
     void ParseContext::SetLanguage(const std::string& value) { m_language = value; }
 
     std::string ParseContext::GetLanguage() const { return m_language; }
+
+    const std::string& ParseContext::GetLanguageRef() const { return m_language; }
 }
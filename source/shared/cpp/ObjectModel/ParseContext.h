@@ -4,21 +4,59 @@
 
 #include "pch.h"
 
+#include <chrono>
 #include "ElementParserRegistration.h"
 #include "ActionParserRegistration.h"
 #include "AdaptiveCardParseWarning.h"
+#include "ParseArena.h"
 
 namespace AdaptiveSharedNamespace
 {
     class BaseElement;
+    class DataUri;
     class InternalId;
     class CollectionTypeElement;
+
+    // Bounds on the work and memory parsing one card may take, for cards from sources that aren't trusted. A parse
+    // that exceeds one fails with ErrorStatusCode::ParseLimitExceeded once that's found: the size before reading
+    // starts, strings once the JSON has been read, and the rest as elements are parsed (the time every few dozen
+    // elements). Zero turns a limit off, and every limit is off by default.
+    struct ParseLimits
+    {
+        // How deeply elements and actions may nest, counting fallback content and the cards of ShowCard actions
+        unsigned int maxDepth = 0;
+        // How many elements and actions a card may have, fallback content included
+        size_t maxElementCount = 0;
+        // The longest string, in bytes, the card's JSON may hold. This is checked once the JSON has been read, so it
+        // doesn't bound the memory reading takes; maxTotalBytes does.
+        size_t maxStringLength = 0;
+        // The most bytes of JSON or binary card that are read (DeserializeFromString and DeserializeBinary), checked
+        // before reading starts
+        size_t maxTotalBytes = 0;
+        // How long a card may take to parse, from when its JSON or binary starts being read
+        std::chrono::milliseconds timeBudget{0};
+    };
+
+    class ParseContext;
+
+    // Told about each element and action as it's parsed, for a caller that keeps track of where the parts of a card
+    // came from (see IncrementalCardParser). ElementParsed is called once the element and everything it holds have
+    // been parsed and its id has been checked. Fallback content is reported as elements of its own.
+    class ParseObserver
+    {
+    public:
+        virtual ~ParseObserver() = default;
+        virtual void ElementStarted(const ParseContext& context, const InternalId& internalId, const std::string& id) = 0;
+        virtual void ElementParsed(const ParseContext& context, const InternalId& internalId) = 0;
+    };
+
     class ParseContext
     {
     public:
         ParseContext();
         ParseContext(std::shared_ptr<ElementParserRegistration> elementRegistration,
                      std::shared_ptr<ActionParserRegistration> actionRegistration);
+        ~ParseContext();
 
         std::shared_ptr<ElementParserRegistration> elementParserRegistration;
         std::shared_ptr<ActionParserRegistration> actionParserRegistration;
@@ -29,12 +67,22 @@ namespace AdaptiveSharedNamespace
                          const bool isFallback = false);
         void PopElement();
 
+        // Elements with an "id" are recorded, along with whether they're fallback content, in the entries kept for
+        // detecting id collisions, so that cards can index them without walking the tree again (see
+        // AdaptiveCard::GetElementById). AddIdentifiedElement is called while the element is being parsed.
+        void AddIdentifiedElement(const std::shared_ptr<BaseElement>& element);
+        size_t GetIdentifiedElementCount() const { return m_identifiedEntries.size(); }
+        // Adds the elements recorded since the count was first to index, each element ahead of fallback content that
+        // shares its id. The record is cleared once the outermost card is done.
+        void IndexIdentifiedElements(size_t first, std::unordered_map<std::string, std::vector<std::weak_ptr<BaseElement>>>& index);
+
         // tells if it's possible to fallback to ancestor
         bool GetCanFallbackToAncestor() const { return m_canFallbackToAncestor; }
         void SetCanFallbackToAncestor(bool value) { m_canFallbackToAncestor = value; }
 
         void SetLanguage(const std::string& value);
         std::string GetLanguage() const;
+        const std::string& GetLanguageRef() const;
 
         ContainerStyle GetParentalContainerStyle() const;
         void SetParentalContainerStyle(const ContainerStyle style);
@@ -46,6 +94,64 @@ namespace AdaptiveSharedNamespace
         void PushBleedDirection(const ContainerBleedDirection direction);
         void PopBleedDirection();
 
+        // Puts a new context in the state another was in as it started parsing an element (as seen through the getters
+        // above), so that the element can be parsed again on its own
+        void RestoreElementState(const ContainerStyle parentalStyle,
+                                 const AdaptiveSharedNamespace::InternalId& paddingParentInternalId,
+                                 const ContainerBleedDirection bleedDirection,
+                                 const bool canFallbackToAncestor);
+
+        // When an arena is set, the elements created while parsing are allocated from it instead of one at a time from
+        // the heap. The arena is released once the ParseResult and every element allocated from it are gone. An arena
+        // is for one context only; see ParseArena.
+        std::shared_ptr<ParseArena> GetArena() const { return m_arena; }
+        void SetArena(const std::shared_ptr<ParseArena>& arena) { m_arena = arena; }
+
+        template<typename T, typename... Args> std::shared_ptr<T> MakeShared(Args&&... args) const
+        {
+            if (m_arena)
+            {
+                return std::allocate_shared<T>(ParseArenaAllocator<T>(m_arena), std::forward<Args>(args)...);
+            }
+            return std::make_shared<T>(std::forward<Args>(args)...);
+        }
+
+        // ChoiceSetInputs with at least this many choices keep them in a ChoiceList rather than as one ChoiceInput
+        // object per choice (see ChoiceSetInput::GetChoiceList). Zero, the default, turns this off.
+        size_t GetCompactChoiceThreshold() const { return m_compactChoiceThreshold; }
+        void SetCompactChoiceThreshold(size_t threshold) { m_compactChoiceThreshold = threshold; }
+
+        // data: URIs at least this long are held by elements as a DataUri, one for each distinct URI in the cards
+        // parsed with this context, rather than as a string per element. Zero turns this off; the default is 4 KB.
+        size_t GetDataUriInternThreshold() const { return m_dataUriInternThreshold; }
+        void SetDataUriInternThreshold(size_t threshold) { m_dataUriInternThreshold = threshold; }
+
+        // Returns the DataUri for url, or nullptr if url isn't a data: URI long enough to intern
+        std::shared_ptr<const DataUri> InternDataUri(const std::string& url);
+
+        // When set, the cards of ShowCard actions are kept unparsed, as their JSON text or in binary form, and parsed
+        // the first time they're asked for (see ShowCardAction::GetCard), as most are never shown. Their ids are still
+        // checked for collisions with the rest of the card as it's parsed. Off by default.
+        bool GetDeferShowCardParsing() const { return m_deferShowCardParsing; }
+        void SetDeferShowCardParsing(bool defer) { m_deferShowCardParsing = defer; }
+
+        // The text the card being parsed was read from, while it's parsed from text, so that the JSON of a deferred
+        // ShowCard card can be kept as the slice of it that it was read from.
+        const std::string* GetSourceText() const { return m_sourceText; }
+        void SetSourceText(const std::string* text) { m_sourceText = text; }
+
+        ParseObserver* GetObserver() const { return m_observer; }
+        void SetObserver(ParseObserver* observer) { m_observer = observer; }
+
+        const ParseLimits& GetLimits() const { return m_limits; }
+        void SetLimits(const ParseLimits& limits) { m_limits = limits; }
+
+        // BeginParse starts the clock on a card whose JSON or binary, inputSize bytes of it, is about to be read.
+        // BeginCard is called as the outermost card is deserialized, and starts the clock itself if BeginParse wasn't
+        // called. BeginCard also checks the card's strings, so the walk over them is only made when that's limited.
+        void BeginParse(size_t inputSize);
+        void BeginCard(const Json::Value& json);
+
     private:
         const AdaptiveSharedNamespace::InternalId GetNearestFallbackId(const AdaptiveSharedNamespace::InternalId& skipId) const;
         // This enum is just a helper to keep track of the position of contents within the std::tuple used in
@@ -54,23 +160,43 @@ namespace AdaptiveSharedNamespace
         {
             Id = 0U,
             InternalId,
-            IsFallback
+            IsFallback,
+            Element
         };
 
+        // The fallback internal IDs recorded for one ID (see ParseContext.cpp)
+        class IdEntries;
+
+        // IDs are interned the first time they're pushed, so each element costs one hash lookup and the stack and
+        // collision lists refer to IDs by index rather than by string.
+        unsigned int InternId(const std::string& id);
+        const std::string& GetInternedId(unsigned int internedId) const;
+        std::unordered_map<std::string, unsigned int> m_internedIds;
+
         // m_elementIds keeps track of which elements we've seen during a parse. This is used to detect collisions on id
         // within an Adaptive Card json file. Specifically, we track which non-empty ids we've seen and correllate them
-        // to the internal ID of the element for which it serves fallback (if any). We use unordered_multimap here as
+        // to the internal ID of the element for which it serves fallback (if any). An ID may have several entries as
         // duplicate entries are valid in some circumstances (i.e. where fallback content shares an ID with its parent)
         //
-        //             map ID json property           ->             fallback ID
-        std::unordered_multimap<std::string, AdaptiveSharedNamespace::InternalId> m_elementIds;
+        //     interned ID (index)  ->  fallback IDs
+        std::vector<IdEntries> m_elementIds;
 
         // m_idStack is the stack we use during parse time to track the hierarchy of cards as they are encountered.
         // Any time we parse an element we push it on to the stack, parse its children (if any), then pop it off the
         // stack. When we pop off the stack, we perform id collision detection.
         //
-        //                             (ID,  internal ID, isFallback)[]
-        std::vector<std::tuple<std::string, AdaptiveSharedNamespace::InternalId, bool>> m_idStack;
+        // The element is set by AddIdentifiedElement while it's parsed, for its entry in m_elementIds.
+        //
+        //                      (interned ID, internal ID, isFallback, element)[]
+        std::vector<std::tuple<unsigned int, AdaptiveSharedNamespace::InternalId, bool, std::shared_ptr<BaseElement>>> m_idStack;
+
+        // Number of fallback entries on m_idStack, i.e. nonzero while parsing fallback content
+        unsigned int m_fallbackDepth;
+
+        // The entries in m_elementIds that hold an element, in the order they were added
+        //
+        //                      (interned ID, entry index)[]
+        std::vector<std::pair<unsigned int, unsigned int>> m_identifiedEntries;
 
         std::vector<ContainerStyle> m_parentalContainerStyles;
         std::vector<AdaptiveSharedNamespace::InternalId> m_parentalPadding;
@@ -78,5 +204,23 @@ namespace AdaptiveSharedNamespace
 
         bool m_canFallbackToAncestor;
         std::string m_language;
+        std::shared_ptr<ParseArena> m_arena;
+        size_t m_compactChoiceThreshold;
+        bool m_deferShowCardParsing;
+        const std::string* m_sourceText;
+        ParseObserver* m_observer;
+
+        // Counts the element being pushed against the limits, and checks the time every c_clockCheckInterval of them
+        void CheckLimits(bool isFallback);
+        [[noreturn]] void ThrowLimitExceeded(const std::string& message) const;
+
+        ParseLimits m_limits;
+        std::chrono::steady_clock::time_point m_deadline;
+        size_t m_elementCount;
+        bool m_parseBegun;
+
+        // Keyed by a hash of the URI, so that the table doesn't hold a copy of it
+        std::unordered_multimap<size_t, std::weak_ptr<const DataUri>> m_internedDataUris;
+        size_t m_dataUriInternThreshold;
     };
 }
@@ -2,7 +2,7 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "ParseResult.h"
-#include "ParseResult.h"
+#include "ParseArena.h"
 #include "SharedAdaptiveCard.h"
 
 using namespace AdaptiveSharedNamespace;
@@ -12,6 +12,14 @@ ParseResult::ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard, std::vector
 {
 }
 
+ParseResult::ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard,
+                         std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings,
+                         std::shared_ptr<ParseArena> arena) :
+    m_adaptiveCard(adaptiveCard),
+    m_warnings(warnings), m_arena(arena)
+{
+}
+
 std::shared_ptr<AdaptiveCard> ParseResult::GetAdaptiveCard() const
 {
     return m_adaptiveCard;
@@ -21,3 +29,8 @@ std::vector<std::shared_ptr<AdaptiveCardParseWarning>> ParseResult::GetWarnings(
 {
     return m_warnings;
 }
+
+std::shared_ptr<ParseArena> ParseResult::GetArena() const
+{
+    return m_arena;
+}
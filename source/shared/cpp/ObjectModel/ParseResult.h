@@ -8,17 +8,25 @@ namespace AdaptiveSharedNamespace
 {
     class AdaptiveCard;
     class AdaptiveCardParseWarning;
+    class ParseArena;
 
     class ParseResult
     {
     public:
         ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard, std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings);
+        ParseResult(std::shared_ptr<AdaptiveCard> adaptiveCard,
+                    std::vector<std::shared_ptr<AdaptiveCardParseWarning>> warnings,
+                    std::shared_ptr<ParseArena> arena);
 
         std::shared_ptr<AdaptiveCard> GetAdaptiveCard() const;
         std::vector<std::shared_ptr<AdaptiveCardParseWarning>> GetWarnings() const;
 
+        // The arena the card was allocated from, if the parse used one (see ParseContext::SetArena)
+        std::shared_ptr<ParseArena> GetArena() const;
+
     private:
         std::shared_ptr<AdaptiveCard> m_adaptiveCard;
         std::vector<std::shared_ptr<AdaptiveCardParseWarning>> m_warnings;
+        std::shared_ptr<ParseArena> m_arena;
     };
 }
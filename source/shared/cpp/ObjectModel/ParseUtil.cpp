@@ -175,6 +175,20 @@ namespace AdaptiveSharedNamespace
         }
     }
 
+    std::shared_ptr<BackgroundImage> ParseUtil::GetBackgroundImage(ParseContext& context, const Json::Value& json)
+    {
+        auto backgroundImage = GetBackgroundImage(json);
+        if (backgroundImage)
+        {
+            const auto dataUri = context.InternDataUri(backgroundImage->GetUrl());
+            if (dataUri)
+            {
+                backgroundImage->SetDataUri(dataUri);
+            }
+        }
+        return backgroundImage;
+    }
+
     bool ParseUtil::GetBool(const Json::Value& json, AdaptiveCardSchemaKey key, bool defaultValue, bool isRequired)
     {
         std::string propertyName = AdaptiveCardSchemaKeyToString(key);
@@ -321,10 +335,12 @@ namespace AdaptiveSharedNamespace
         }
     }
 
-    Json::Value ParseUtil::GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
+    const Json::Value& ParseUtil::GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired)
     {
+        // Returned by reference, since the arrays of elements hold everything nested in them and copying them at
+        // every level would make parsing quadratic in the card's depth
         std::string propertyName = AdaptiveCardSchemaKeyToString(key);
-        auto elementArray = json.get(propertyName, Json::Value());
+        const Json::Value& elementArray = json[propertyName];
 
         if (!elementArray.isNull() && !elementArray.isArray())
         {
@@ -410,7 +426,7 @@ namespace AdaptiveSharedNamespace
                                                                                    AdaptiveCardSchemaKey key,
                                                                                    bool isRequired)
     {
-        auto elementArray = GetArray(json, key, isRequired);
+        const auto& elementArray = GetArray(json, key, isRequired);
 
         std::vector<std::shared_ptr<BaseActionElement>> elements;
 
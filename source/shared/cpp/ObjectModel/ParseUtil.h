@@ -34,6 +34,8 @@ namespace AdaptiveSharedNamespace
         std::string GetValueAsString(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
 
         std::shared_ptr<BackgroundImage> GetBackgroundImage(const Json::Value& json);
+        // As above, interning a data: URI through the context (see ParseContext::InternDataUri)
+        std::shared_ptr<BackgroundImage> GetBackgroundImage(ParseContext& context, const Json::Value& json);
 
         bool GetBool(const Json::Value& json, AdaptiveCardSchemaKey key, bool defaultValue, bool isRequired = false);
 
@@ -49,7 +51,7 @@ namespace AdaptiveSharedNamespace
 
         ActionType TryGetActionType(const Json::Value& json);
 
-        Json::Value GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
+        const Json::Value& GetArray(const Json::Value& json, AdaptiveCardSchemaKey key, bool isRequired = false);
 
         Json::Value GetJsonValueFromString(const std::string& jsonString);
 
@@ -152,7 +154,7 @@ namespace AdaptiveSharedNamespace
         const std::function<std::shared_ptr<T>(ParseContext& context, const Json::Value&)>& deserializer,
         bool isRequired)
     {
-        auto elementArray = GetArray(json, key, isRequired);
+        const auto& elementArray = GetArray(json, key, isRequired);
 
         std::vector<std::shared_ptr<T>> elements;
         if (elementArray.empty())
@@ -207,7 +209,7 @@ namespace AdaptiveSharedNamespace
                                                                     bool isRequired,
                                                                     const std::string& impliedType)
     {
-        auto elementArray = GetArray(json, key, isRequired);
+        const auto& elementArray = GetArray(json, key, isRequired);
 
         std::vector<std::shared_ptr<T>> elements;
         if (elementArray.empty())
@@ -221,7 +223,7 @@ namespace AdaptiveSharedNamespace
         const ContainerBleedDirection previousBleedState = context.GetBleedDirection();
 
         size_t currentIndex = 0;
-        for (auto& curJsonValue : elementArray)
+        for (const auto& curJsonValue : elementArray)
         {
             ContainerBleedDirection currentBleedState = previousBleedState;
 
@@ -245,7 +247,9 @@ namespace AdaptiveSharedNamespace
             context.PushBleedDirection(currentBleedState);
 
             // If all items in this collection have the same implied type (i.e. Columns), verify
-            // that if set it is set correctly and set it if it isn't
+            // that if set it is set correctly and set it if it isn't. Only an item without a type is copied to set it.
+            const Json::Value* elementJson = &curJsonValue;
+            Json::Value typedJson;
             if (!impliedType.empty())
             {
                 const std::string typeString = ParseUtil::GetString(curJsonValue, AdaptiveCardSchemaKey::Type, impliedType, false);
@@ -255,11 +259,16 @@ namespace AdaptiveSharedNamespace
                                                      "Unable to parse element of type " + typeString);
                 }
 
-                curJsonValue[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)] = typeString;
+                if (!curJsonValue.isMember(AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)))
+                {
+                    typedJson = curJsonValue;
+                    typedJson[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)] = typeString;
+                    elementJson = &typedJson;
+                }
             }
 
             std::shared_ptr<BaseElement> curElement;
-            ParseJsonObject<T>(context, curJsonValue, curElement);
+            ParseJsonObject<T>(context, *elementJson, curElement);
             elements.push_back(std::static_pointer_cast<T>(curElement));
 
             // restores the parent's bleed state
@@ -0,0 +1,378 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "RenderPrep.h"
+#include "ActionSet.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "DateTimePreparser.h"
+#include "Fact.h"
+#include "FactSet.h"
+#include "RichTextBlock.h"
+#include "ShowCardAction.h"
+#include "TextBlock.h"
+#include "TextRun.h"
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    // A text found while walking the card, with what's needed to prepare it and where the result goes
+    struct PendingText
+    {
+        const std::string* text;
+        const std::string* language;
+        bool isMarkDown;
+        FontType fontType;
+        TextSize size;
+        TextWeight weight;
+        ForegroundColor color;
+        bool isSubtle;
+        bool isHighlighted;
+        ContainerStyle style;
+        PreparedText* output;
+    };
+
+    // Shared by Prepare and the work it schedules, which can outlive it
+    struct PrepState
+    {
+        std::vector<PendingText> pending;
+        const HostConfig* hostConfig;
+        const RenderPrepOptions* options;
+        size_t batchSize;
+        size_t batchCount;
+        std::atomic<size_t> nextBatch{0};
+
+        std::mutex mutex;
+        std::condition_variable batchesDone;
+        size_t completedBatches = 0;
+        std::exception_ptr error;
+    };
+
+    std::string ResolveDates(const std::string& text, const std::string& language, const RenderPrepOptions& options)
+    {
+        if (text.find("{{") == std::string::npos)
+        {
+            return text;
+        }
+
+        std::string resolved;
+        for (const auto& token : DateTimePreparser(text).GetTextTokens())
+        {
+            resolved += options.dateFormatter ? options.dateFormatter(*token, language) : token->GetDisplayText();
+        }
+        return resolved;
+    }
+
+    void PrepareText(const PendingText& pending, const HostConfig& hostConfig, const RenderPrepOptions& options)
+    {
+        PreparedText& prepared = *pending.output;
+        prepared.text = ResolveDates(*pending.text, *pending.language, options);
+        if (pending.isMarkDown)
+        {
+            MarkDownParser parser(prepared.text);
+            prepared.styledText = parser.TransformToStyledRuns();
+        }
+        prepared.fontFamily = hostConfig.GetFontFamily(pending.fontType);
+        prepared.fontSize = hostConfig.GetFontSize(pending.fontType, pending.size);
+        prepared.fontWeight = hostConfig.GetFontWeight(pending.fontType, pending.weight);
+        prepared.color = hostConfig.GetForegroundColor(pending.style, pending.color, pending.isSubtle);
+        if (pending.isHighlighted)
+        {
+            prepared.highlightColor = hostConfig.GetHighlightColor(pending.style, pending.color, pending.isSubtle);
+        }
+    }
+
+    // Prepares batches until there are none left to claim. Once every batch is claimed this returns without touching
+    // the card, so work that runs after Prepare has returned is harmless.
+    void RunBatches(const std::shared_ptr<PrepState>& state)
+    {
+        for (;;)
+        {
+            const size_t batch = state->nextBatch++;
+            if (batch >= state->batchCount)
+            {
+                return;
+            }
+
+            try
+            {
+                const size_t end = std::min(state->pending.size(), (batch + 1) * state->batchSize);
+                for (size_t i = batch * state->batchSize; i < end; i++)
+                {
+                    PrepareText(state->pending[i], *state->hostConfig, *state->options);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error)
+                {
+                    state->error = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (++state->completedBatches == state->batchCount)
+            {
+                state->batchesDone.notify_all();
+            }
+        }
+    }
+
+    ContainerStyle InheritStyle(ContainerStyle style, ContainerStyle parentStyle)
+    {
+        return (style == ContainerStyle::None) ? parentStyle : style;
+    }
+
+    // Walks a card, making room in the side table for each text and queueing it to be prepared
+    class TextCollector
+    {
+    public:
+        TextCollector(std::unordered_map<InternalId, std::vector<PreparedText>, InternalIdKeyHash>& texts,
+                      const HostConfig& hostConfig,
+                      std::vector<PendingText>& pending) :
+            m_texts(texts),
+            m_hostConfig(hostConfig), m_pending(pending)
+        {
+        }
+
+        void AddCard(const AdaptiveCard& card, ContainerStyle style)
+        {
+            AddElements(card.GetBody(), style);
+            AddActions(card.GetActions());
+        }
+
+    private:
+        void AddElements(const std::vector<std::shared_ptr<BaseCardElement>>& elements, ContainerStyle style)
+        {
+            for (const auto& element : elements)
+            {
+                AddElement(*element, style);
+            }
+        }
+
+        void AddActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions)
+        {
+            for (const auto& action : actions)
+            {
+                // Deferred cards are left for when they're parsed, as parsing them here could throw
+                if (action->GetElementType() == ActionType::ShowCard &&
+                    !static_cast<const ShowCardAction&>(*action).IsCardDeferred())
+                {
+                    const auto card = static_cast<const ShowCardAction&>(*action).GetCard();
+                    if (card)
+                    {
+                        AddCard(*card, m_hostConfig.GetActions().showCard.style);
+                    }
+                }
+            }
+        }
+
+        void AddElement(const BaseCardElement& element, ContainerStyle style)
+        {
+            switch (element.GetElementType())
+            {
+            case CardElementType::TextBlock:
+            {
+                const auto& textBlock = static_cast<const TextBlock&>(element);
+                PreparedText* output = Reserve(element.GetInternalId(), 1);
+                m_pending.push_back({&textBlock.GetTextRef(),
+                                     &textBlock.GetLanguageRef(),
+                                     true,
+                                     textBlock.GetFontType(),
+                                     textBlock.GetTextSize(),
+                                     textBlock.GetTextWeight(),
+                                     textBlock.GetTextColor(),
+                                     textBlock.GetIsSubtle(),
+                                     false,
+                                     style,
+                                     output});
+                break;
+            }
+            case CardElementType::RichTextBlock:
+            {
+                const auto& inlines = static_cast<const RichTextBlock&>(element).GetInlines();
+                const size_t runCount = std::count_if(inlines.begin(), inlines.end(), [](const std::shared_ptr<Inline>& item) {
+                    return item->GetInlineType() == InlineElementType::TextRun;
+                });
+                if (runCount == 0)
+                {
+                    break;
+                }
+
+                PreparedText* output = Reserve(element.GetInternalId(), runCount);
+                for (const auto& item : inlines)
+                {
+                    if (item->GetInlineType() == InlineElementType::TextRun)
+                    {
+                        const auto& textRun = static_cast<const TextRun&>(*item);
+                        m_pending.push_back({&textRun.GetTextRef(),
+                                             &textRun.GetLanguageRef(),
+                                             false,
+                                             textRun.GetFontType(),
+                                             textRun.GetTextSize(),
+                                             textRun.GetTextWeight(),
+                                             textRun.GetTextColor(),
+                                             textRun.GetIsSubtle(),
+                                             textRun.GetHighlight(),
+                                             style,
+                                             output++});
+                    }
+                }
+                break;
+            }
+            case CardElementType::FactSet:
+            {
+                const auto& facts = static_cast<const FactSet&>(element).GetFacts();
+                if (facts.empty())
+                {
+                    break;
+                }
+
+                const FactSetConfig factSetConfig = m_hostConfig.GetFactSet();
+                PreparedText* output = Reserve(element.GetInternalId(), facts.size() * 2);
+                for (const auto& fact : facts)
+                {
+                    AddFactText(fact->GetTitleRef(), fact->GetLanguageRef(), factSetConfig.title, style, output++);
+                    AddFactText(fact->GetValueRef(), fact->GetLanguageRef(), factSetConfig.value, style, output++);
+                }
+                break;
+            }
+            case CardElementType::Container:
+            {
+                const auto& container = static_cast<const Container&>(element);
+                AddElements(container.GetItems(), InheritStyle(container.GetStyle(), style));
+                break;
+            }
+            case CardElementType::ColumnSet:
+            {
+                const auto& columnSet = static_cast<const ColumnSet&>(element);
+                const ContainerStyle columnSetStyle = InheritStyle(columnSet.GetStyle(), style);
+                for (const auto& column : columnSet.GetColumns())
+                {
+                    AddElements(column->GetItems(), InheritStyle(column->GetStyle(), columnSetStyle));
+                }
+                break;
+            }
+            case CardElementType::ActionSet:
+                AddActions(static_cast<const ActionSet&>(element).GetActions());
+                break;
+            default:
+                break;
+            }
+        }
+
+        void AddFactText(const std::string& text, const std::string& language, const TextConfig& config, ContainerStyle style, PreparedText* output)
+        {
+            m_pending.push_back({&text, &language, true, config.fontType, config.size, config.weight, config.color, config.isSubtle, false, style, output});
+        }
+
+        // The side table's nodes don't move as it grows, and each vector is sized once, so the pointer stays valid
+        PreparedText* Reserve(const InternalId& id, size_t count)
+        {
+            auto& texts = m_texts[id];
+            texts.resize(count);
+            return texts.data();
+        }
+
+        std::unordered_map<InternalId, std::vector<PreparedText>, InternalIdKeyHash>& m_texts;
+        const HostConfig& m_hostConfig;
+        std::vector<PendingText>& m_pending;
+    };
+}
+
+const std::vector<PreparedText>* PreparedCard::GetTexts(const InternalId& id) const
+{
+    const auto texts = m_texts.find(id);
+    return (texts != m_texts.end()) ? &texts->second : nullptr;
+}
+
+std::shared_ptr<const PreparedCard> RenderPrep::Prepare(const AdaptiveCard& card, const HostConfig& hostConfig, const RenderPrepOptions& options)
+{
+    auto prepared = std::make_shared<PreparedCard>();
+    auto state = std::make_shared<PrepState>();
+    state->hostConfig = &hostConfig;
+    state->options = &options;
+
+    TextCollector collector(prepared->m_texts, hostConfig, state->pending);
+    collector.AddCard(card, InheritStyle(card.GetStyle(), ContainerStyle::Default));
+    if (state->pending.empty())
+    {
+        return prepared;
+    }
+
+    state->batchSize = std::max(options.textsPerBatch, 1U);
+    state->batchCount = (state->pending.size() + state->batchSize - 1) / state->batchSize;
+    if (options.scheduler)
+    {
+        for (size_t i = 1; i < state->batchCount; i++)
+        {
+            options.scheduler([state]() { RunBatches(state); });
+        }
+    }
+    RunBatches(state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->batchesDone.wait(lock, [&state]() { return state->completedBatches == state->batchCount; });
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+    return prepared;
+}
+
+RenderPrepThreadPool::RenderPrepThreadPool(unsigned int threadCount) : m_isStopping(false)
+{
+    for (unsigned int i = 0; i < std::max(threadCount, 1U); i++)
+    {
+        m_threads.emplace_back([this]() { Run(); });
+    }
+}
+
+RenderPrepThreadPool::~RenderPrepThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void RenderPrepThreadPool::Schedule(const std::function<void()>& work)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_work.push_back(work);
+    }
+    m_workAvailable.notify_one();
+}
+
+RenderPrepScheduler RenderPrepThreadPool::GetScheduler()
+{
+    return [this](const std::function<void()>& work) { Schedule(work); };
+}
+
+void RenderPrepThreadPool::Run()
+{
+    for (;;)
+    {
+        std::function<void()> work;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this]() { return m_isStopping || !m_work.empty(); });
+            if (m_work.empty())
+            {
+                return;
+            }
+            work = std::move(m_work.front());
+            m_work.pop_front();
+        }
+        work();
+    }
+}
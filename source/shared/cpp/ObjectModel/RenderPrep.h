@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "HostConfig.h"
+#include "MarkDownParser.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class DateTimePreparsedToken;
+
+    // One piece of text, ready to render. text has its {{DATE()}} and {{TIME()}} tokens resolved; styledText is the
+    // markdown of text parsed into styled runs, for text that supports markdown (text blocks and facts) and is left
+    // empty for TextRuns. The font and colors are resolved from the host config for the element's container style.
+    // highlightColor is only set for highlighted TextRuns.
+    struct PreparedText
+    {
+        std::string text;
+        MarkDownStyledText styledText;
+        std::string fontFamily;
+        unsigned int fontSize;
+        unsigned int fontWeight;
+        std::string color;
+        std::string highlightColor;
+    };
+
+    // The prepared text of a card, keyed by the InternalId of the element it belongs to. A TextBlock has one
+    // PreparedText, a RichTextBlock one for each TextRun, and a FactSet two for each fact (its title and its value).
+    class PreparedCard
+    {
+    public:
+        // Returns nullptr for an element without text
+        const std::vector<PreparedText>* GetTexts(const InternalId& id) const;
+        size_t GetElementCount() const { return m_texts.size(); }
+
+    private:
+        std::unordered_map<InternalId, std::vector<PreparedText>, InternalIdKeyHash> m_texts;
+
+        friend class RenderPrep;
+    };
+
+    // Runs a piece of work, on any thread. The work may run after the call that scheduled it has returned.
+    typedef std::function<void(const std::function<void()>& work)> RenderPrepScheduler;
+
+    struct RenderPrepOptions
+    {
+        // Runs the preparation of batches of text. When empty, everything runs on the calling thread.
+        RenderPrepScheduler scheduler;
+
+        // Texts prepared by each piece of scheduled work
+        unsigned int textsPerBatch = 8;
+
+        // Formats {{DATE()}} and {{TIME()}} tokens for the language of the element they're in. When empty, they're
+        // written in en-US; see DateTimePreparsedToken::GetDisplayText.
+        std::function<std::string(const DateTimePreparsedToken& token, const std::string& language)> dateFormatter;
+    };
+
+    // RenderPrep does the text work a renderer needs before it can lay a card out (resolving dates, parsing markdown
+    // and looking up fonts and colors) for the whole card at once, spread over a thread pool.
+    //
+    // Prepare walks the card once, including the cards of ShowCard actions (those already parsed, if parsing them is
+    // deferred) but not fallback content, then prepares its texts in batches through options.scheduler. The calling
+    // thread prepares batches too, so Prepare finishes even if the scheduler is busy or never runs the work; it
+    // returns once every text is prepared. The card and host
+    // config are only read, and must not change until Prepare returns. Elements are told apart by their InternalId,
+    // which parsing makes unique. Throws the first exception a batch throws.
+    class RenderPrep
+    {
+    public:
+        static std::shared_ptr<const PreparedCard> Prepare(const AdaptiveCard& card,
+                                                           const HostConfig& hostConfig,
+                                                           const RenderPrepOptions& options = RenderPrepOptions());
+    };
+
+    // A fixed set of threads that run work in the order it's scheduled, for RenderPrepOptions::scheduler. The
+    // destructor waits for the work already scheduled to finish.
+    class RenderPrepThreadPool
+    {
+    public:
+        explicit RenderPrepThreadPool(unsigned int threadCount);
+        ~RenderPrepThreadPool();
+
+        RenderPrepThreadPool(const RenderPrepThreadPool&) = delete;
+        RenderPrepThreadPool& operator=(const RenderPrepThreadPool&) = delete;
+
+        void Schedule(const std::function<void()>& work);
+
+        // A scheduler that runs work on this pool, which must outlive it
+        RenderPrepScheduler GetScheduler();
+
+    private:
+        void Run();
+
+        std::vector<std::thread> m_threads;
+        std::deque<std::function<void()>> m_work;
+        std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        bool m_isStopping;
+    };
+}
@@ -0,0 +1,452 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ResourceLoader.h"
+#include "AdaptiveBase64Util.h"
+#include <atomic>
+#include <cstdio>
+#include <random>
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    bool IsDataUri(const std::string& url) { return url.compare(0, 5, "data:") == 0; }
+
+    int HexValue(char ch)
+    {
+        if (ch >= '0' && ch <= '9')
+        {
+            return ch - '0';
+        }
+        if (ch >= 'a' && ch <= 'f')
+        {
+            return ch - 'a' + 10;
+        }
+        if (ch >= 'A' && ch <= 'F')
+        {
+            return ch - 'A' + 10;
+        }
+        return -1;
+    }
+
+    std::vector<char> PercentDecode(const std::string& text, size_t start)
+    {
+        std::vector<char> decoded;
+        decoded.reserve(text.size() - start);
+        for (size_t i = start; i < text.size(); i++)
+        {
+            if (text[i] == '%' && (i + 2) < text.size() && HexValue(text[i + 1]) >= 0 && HexValue(text[i + 2]) >= 0)
+            {
+                decoded.push_back(static_cast<char>((HexValue(text[i + 1]) << 4) | HexValue(text[i + 2])));
+                i += 2;
+            }
+            else
+            {
+                decoded.push_back(text[i]);
+            }
+        }
+        return decoded;
+    }
+
+    // 64-bit FNV-1a, written as 16 hex digits
+    std::string HashToHex(const char* data, size_t size)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(16, '0');
+        for (int i = 15; i >= 0; i--)
+        {
+            hex[i] = digits[hash & 0xF];
+            hash >>= 4;
+        }
+        return hex;
+    }
+
+    uint32_t RotateRight(uint32_t value, int bits) { return (value >> bits) | (value << (32 - bits)); }
+
+    // SHA-256 (FIPS 180-4), written as 64 hex digits. Content files are named with it, so that content can't be
+    // made to collide with another resource's.
+    std::string Sha256ToHex(const char* data, size_t size)
+    {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be,
+            0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa,
+            0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+            0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+            0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+            0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+        uint32_t hash[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+        // The data is followed by a 1 bit, zeros, and its length in bits, to a multiple of 64 bytes
+        const size_t paddedSize = ((size + 8) / 64 + 1) * 64;
+        uint8_t block[64];
+        for (size_t blockStart = 0; blockStart < paddedSize; blockStart += 64)
+        {
+            for (size_t i = 0; i < 64; i++)
+            {
+                const size_t position = blockStart + i;
+                if (position < size)
+                {
+                    block[i] = static_cast<uint8_t>(data[position]);
+                }
+                else if (position == size)
+                {
+                    block[i] = 0x80;
+                }
+                else if (position >= paddedSize - 8)
+                {
+                    block[i] = static_cast<uint8_t>((static_cast<uint64_t>(size) * 8) >> ((paddedSize - 1 - position) * 8));
+                }
+                else
+                {
+                    block[i] = 0;
+                }
+            }
+
+            uint32_t w[64];
+            for (int i = 0; i < 16; i++)
+            {
+                w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+                       (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | block[i * 4 + 3];
+            }
+            for (int i = 16; i < 64; i++)
+            {
+                const uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                const uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            uint32_t a = hash[0], b = hash[1], c = hash[2], d = hash[3], e = hash[4], f = hash[5], g = hash[6], h = hash[7];
+            for (int i = 0; i < 64; i++)
+            {
+                const uint32_t t1 = h + (RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+                const uint32_t t2 = (RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            hash[0] += a;
+            hash[1] += b;
+            hash[2] += c;
+            hash[3] += d;
+            hash[4] += e;
+            hash[5] += f;
+            hash[6] += g;
+            hash[7] += h;
+        }
+
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(64, '0');
+        for (size_t i = 0; i < 64; i++)
+        {
+            hex[i] = digits[(hash[i / 8] >> (28 - (i % 8) * 4)) & 0xF];
+        }
+        return hex;
+    }
+
+    bool ReadFile(const std::string& path, std::vector<char>& data)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            return false;
+        }
+
+        const std::streamoff size = file.tellg();
+        if (size < 0)
+        {
+            return false;
+        }
+        data.resize(static_cast<size_t>(size));
+        file.seekg(0);
+        return static_cast<bool>(file.read(data.data(), size));
+    }
+
+    // Writes through a temporary file so that readers never see part of the file. Each write has a temporary file of
+    // its own, named for this process and the write, so that writes of the same file from several threads or processes
+    // don't write into each other's.
+    void WriteFile(const std::string& path, const char* data, size_t size)
+    {
+        static const std::string processToken = std::to_string(std::random_device()());
+        static std::atomic<uint64_t> writeCount(0);
+        const std::string temporaryPath = path + "." + processToken + "-" + std::to_string(writeCount++) + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file.write(data, size))
+            {
+                return;
+            }
+        }
+        std::remove(path.c_str());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+        {
+            std::remove(temporaryPath.c_str());
+        }
+    }
+
+    std::string JoinPath(const std::string& directory, const std::string& name)
+    {
+        const char last = directory.back();
+        return (last == '/' || last == '\\') ? directory + name : directory + "/" + name;
+    }
+}
+
+bool LocalResourceTransport::DecodeDataUri(const std::string& url, std::string& mimeType, std::vector<char>& data)
+{
+    const size_t comma = url.find(',');
+    if (!IsDataUri(url) || comma == std::string::npos)
+    {
+        return false;
+    }
+
+    const std::string mediaType = url.substr(5, comma - 5);
+    mimeType = mediaType.substr(0, mediaType.find(';'));
+
+    const std::string base64Suffix = ";base64";
+    if (mediaType.size() >= base64Suffix.size() &&
+        mediaType.compare(mediaType.size() - base64Suffix.size(), base64Suffix.size(), base64Suffix) == 0)
+    {
+        data = AdaptiveBase64Util::Decode(AdaptiveBase64Util::ExtractDataFromUri(url));
+    }
+    else
+    {
+        data = PercentDecode(url, comma + 1);
+    }
+    return true;
+}
+
+void LocalResourceTransport::Fetch(const std::string& url, const ResourceLoadCallback& onComplete)
+{
+    ResourceLoadResult result{ResourceLoadStatus::Fetched, url, "", nullptr, ""};
+    auto data = std::make_shared<std::vector<char>>();
+
+    if (IsDataUri(url))
+    {
+        if (!DecodeDataUri(url, result.mimeType, *data))
+        {
+            result.error = "Malformed data URI";
+        }
+    }
+    else
+    {
+        std::string path = url;
+        if (url.compare(0, 7, "file://") == 0)
+        {
+            const std::vector<char> decodedPath = PercentDecode(url, 7);
+            path.assign(decodedPath.begin(), decodedPath.end());
+            // file:///C:/path on Windows
+            if (path.size() > 2 && path[0] == '/' && path[2] == ':')
+            {
+                path.erase(0, 1);
+            }
+        }
+        else if (url.find("://") != std::string::npos)
+        {
+            result.error = "Unsupported URL scheme";
+        }
+
+        if (result.error.empty() && !ReadFile(path, *data))
+        {
+            result.error = "Couldn't read " + path;
+        }
+    }
+
+    if (result.error.empty())
+    {
+        result.data = data;
+    }
+    else
+    {
+        result.status = ResourceLoadStatus::Failed;
+    }
+    onComplete(result);
+}
+
+ResourceLoader::ResourceLoader(std::shared_ptr<ResourceTransport> transport, const ResourceLoaderOptions& options) :
+    m_transport(std::move(transport)), m_options(options), m_memoryCacheBytes(0)
+{
+}
+
+void ResourceLoader::Load(const std::string& url, const ResourceLoadCallback& onComplete)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const auto cached = m_memoryCacheIndex.find(url);
+        if (cached != m_memoryCacheIndex.end())
+        {
+            m_memoryCache.splice(m_memoryCache.begin(), m_memoryCache, cached->second);
+            const ResourceLoadResult result{ResourceLoadStatus::FromMemoryCache, url, cached->second->mimeType, cached->second->data, ""};
+            lock.unlock();
+            onComplete(result);
+            return;
+        }
+
+        auto& waiting = m_inFlight[url];
+        waiting.push_back(onComplete);
+        if (waiting.size() > 1)
+        {
+            return;
+        }
+    }
+
+    if (!m_options.diskCacheDirectory.empty() && !IsDataUri(url))
+    {
+        ResourceLoadResult result{ResourceLoadStatus::FromDiskCache, url, "", nullptr, ""};
+        auto data = std::make_shared<std::vector<char>>();
+        if (ReadFromDisk(url, result.mimeType, *data))
+        {
+            result.data = data;
+            AddToMemoryCache(url, result.mimeType, result.data);
+            CompleteLoads(url, result);
+            return;
+        }
+    }
+
+    try
+    {
+        m_transport->Fetch(url, [this, url](const ResourceLoadResult& result) { OnFetched(url, result); });
+    }
+    catch (const std::exception& e)
+    {
+        CompleteLoads(url, {ResourceLoadStatus::Failed, url, "", nullptr, e.what()});
+    }
+}
+
+size_t ResourceLoader::GetMemoryCacheBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryCacheBytes;
+}
+
+void ResourceLoader::ClearMemoryCache()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryCache.clear();
+    m_memoryCacheIndex.clear();
+    m_memoryCacheBytes = 0;
+}
+
+void ResourceLoader::OnFetched(const std::string& url, const ResourceLoadResult& fetched)
+{
+    ResourceLoadResult result = fetched;
+    result.url = url;
+    if (result.data == nullptr)
+    {
+        result.status = ResourceLoadStatus::Failed;
+    }
+
+    if (result.status != ResourceLoadStatus::Failed)
+    {
+        result.status = ResourceLoadStatus::Fetched;
+        AddToMemoryCache(url, result.mimeType, result.data);
+        if (!m_options.diskCacheDirectory.empty() && !IsDataUri(url))
+        {
+            WriteToDisk(url, result.mimeType, *result.data);
+        }
+    }
+    CompleteLoads(url, result);
+}
+
+void ResourceLoader::CompleteLoads(const std::string& url, const ResourceLoadResult& result)
+{
+    std::vector<ResourceLoadCallback> waiting;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto inFlight = m_inFlight.find(url);
+        if (inFlight == m_inFlight.end())
+        {
+            return;
+        }
+        waiting = std::move(inFlight->second);
+        m_inFlight.erase(inFlight);
+    }
+
+    for (const auto& onComplete : waiting)
+    {
+        onComplete(result);
+    }
+}
+
+void ResourceLoader::AddToMemoryCache(const std::string& url, const std::string& mimeType, const std::shared_ptr<const std::vector<char>>& data)
+{
+    if (data->size() > m_options.memoryCacheBytes)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto existing = m_memoryCacheIndex.find(url);
+    if (existing != m_memoryCacheIndex.end())
+    {
+        m_memoryCacheBytes -= existing->second->data->size();
+        m_memoryCache.erase(existing->second);
+        m_memoryCacheIndex.erase(existing);
+    }
+
+    m_memoryCache.push_front({url, mimeType, data});
+    m_memoryCacheIndex[url] = m_memoryCache.begin();
+    m_memoryCacheBytes += data->size();
+
+    while (m_memoryCacheBytes > m_options.memoryCacheBytes)
+    {
+        const CachedResource& leastRecent = m_memoryCache.back();
+        m_memoryCacheBytes -= leastRecent.data->size();
+        m_memoryCacheIndex.erase(leastRecent.url);
+        m_memoryCache.pop_back();
+    }
+}
+
+// Each URL has a record named after a hash of the URL, holding the URL (to tell apart URLs whose hashes collide),
+// its mime type, and the name of the file with its content. Content files are named after the SHA-256 of the content
+// and its size, so URLs with the same content share one file. The content is checked against its name as it's read,
+// so a damaged or altered file is fetched again rather than used.
+bool ResourceLoader::ReadFromDisk(const std::string& url, std::string& mimeType, std::vector<char>& data) const
+{
+    std::ifstream record(JoinPath(m_options.diskCacheDirectory, HashToHex(url.data(), url.size()) + ".url"));
+    std::string recordedUrl;
+    std::string contentName;
+    if (!std::getline(record, recordedUrl) || recordedUrl != url || !std::getline(record, mimeType) ||
+        !std::getline(record, contentName))
+    {
+        return false;
+    }
+
+    return ReadFile(JoinPath(m_options.diskCacheDirectory, contentName), data) && contentName == GetContentName(data);
+}
+
+std::string ResourceLoader::GetContentName(const std::vector<char>& data)
+{
+    return Sha256ToHex(data.data(), data.size()) + "-" + std::to_string(data.size());
+}
+
+void ResourceLoader::WriteToDisk(const std::string& url, const std::string& mimeType, const std::vector<char>& data) const
+{
+    // Record lines can't hold line breaks, and such URLs aren't worth caching
+    if (url.find_first_of("\r\n") != std::string::npos || mimeType.find_first_of("\r\n") != std::string::npos)
+    {
+        return;
+    }
+
+    // A file that's already there is only kept if it holds the same bytes
+    const std::string contentName = GetContentName(data);
+    const std::string contentPath = JoinPath(m_options.diskCacheDirectory, contentName);
+    std::vector<char> existing;
+    if (!ReadFile(contentPath, existing) || existing != data)
+    {
+        WriteFile(contentPath, data.data(), data.size());
+    }
+
+    const std::string record = url + "\n" + mimeType + "\n" + contentName + "\n";
+    WriteFile(JoinPath(m_options.diskCacheDirectory, HashToHex(url.data(), url.size()) + ".url"), record.data(), record.size());
+}
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include <list>
+#include <mutex>
+
+namespace AdaptiveSharedNamespace
+{
+    enum class ResourceLoadStatus
+    {
+        // Fetched through the transport, by this load or by one it was coalesced with
+        Fetched,
+        FromMemoryCache,
+        FromDiskCache,
+        Failed
+    };
+
+    struct ResourceLoadResult
+    {
+        ResourceLoadStatus status;
+        std::string url;
+        // Empty when it isn't known, as for files
+        std::string mimeType;
+        // Shared with the cache and with every other load of the same URL. Null if the load failed.
+        std::shared_ptr<const std::vector<char>> data;
+        // Why the load failed
+        std::string error;
+    };
+
+    typedef std::function<void(const ResourceLoadResult& result)> ResourceLoadCallback;
+
+    // Fetches resources for a ResourceLoader. Fetch may call onComplete before it returns or later on any thread, but
+    // must call it exactly once. Only status Fetched or Failed is expected.
+    class ResourceTransport
+    {
+    public:
+        virtual ~ResourceTransport() = default;
+        virtual void Fetch(const std::string& url, const ResourceLoadCallback& onComplete) = 0;
+    };
+
+    // Reads data: URIs (base64 or percent-encoded), file:// URLs and plain file paths, completing before Fetch returns.
+    // Fails anything else, so hosts wrap it in a transport of their own that handles http and https.
+    class LocalResourceTransport : public ResourceTransport
+    {
+    public:
+        void Fetch(const std::string& url, const ResourceLoadCallback& onComplete) override;
+
+        // Decodes a data: URI, returning false if it isn't one
+        static bool DecodeDataUri(const std::string& url, std::string& mimeType, std::vector<char>& data);
+    };
+
+    struct ResourceLoaderOptions
+    {
+        // The most the in-memory cache holds, in bytes of resource data. 0 turns it off.
+        size_t memoryCacheBytes = 32 * 1024 * 1024;
+
+        // An existing directory for the on-disk cache, or empty for none. Resources are stored once per distinct
+        // content, under its SHA-256, with a small record per URL pointing at the content. data: URIs aren't stored
+        // on disk, since they hold their content already.
+        std::string diskCacheDirectory;
+    };
+
+    // ResourceLoader loads the resources of cards (images, media, icons) for every card a host shows. Loads of a URL
+    // that's already being fetched wait for that fetch instead of starting another, and loaded resources are kept
+    // in a least recently used in-memory cache and, optionally, an on-disk cache that outlives the process.
+    //
+    // Load calls onComplete before it returns when the resource is cached, and otherwise on whichever thread the
+    // transport completes on. Callbacks aren't called with the loader's lock held, so they may call Load. The loader
+    // is thread safe and must outlive the fetches it starts.
+    class ResourceLoader
+    {
+    public:
+        ResourceLoader(std::shared_ptr<ResourceTransport> transport, const ResourceLoaderOptions& options = ResourceLoaderOptions());
+
+        ResourceLoader(const ResourceLoader&) = delete;
+        ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+        void Load(const std::string& url, const ResourceLoadCallback& onComplete);
+
+        size_t GetMemoryCacheBytes() const;
+        void ClearMemoryCache();
+
+    private:
+        struct CachedResource
+        {
+            std::string url;
+            std::string mimeType;
+            std::shared_ptr<const std::vector<char>> data;
+        };
+
+        void OnFetched(const std::string& url, const ResourceLoadResult& result);
+        void CompleteLoads(const std::string& url, const ResourceLoadResult& result);
+        void AddToMemoryCache(const std::string& url, const std::string& mimeType, const std::shared_ptr<const std::vector<char>>& data);
+
+        static std::string GetContentName(const std::vector<char>& data);
+        bool ReadFromDisk(const std::string& url, std::string& mimeType, std::vector<char>& data) const;
+        void WriteToDisk(const std::string& url, const std::string& mimeType, const std::vector<char>& data) const;
+
+        const std::shared_ptr<ResourceTransport> m_transport;
+        const ResourceLoaderOptions m_options;
+
+        mutable std::mutex m_mutex;
+        // Most recently used first
+        std::list<CachedResource> m_memoryCache;
+        std::unordered_map<std::string, std::list<CachedResource>::iterator> m_memoryCacheIndex;
+        size_t m_memoryCacheBytes;
+        // The callbacks waiting on each URL that's being loaded
+        std::unordered_map<std::string, std::vector<ResourceLoadCallback>> m_inFlight;
+    };
+}
@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ResourceManifest.h"
+#include "ActionSet.h"
+#include "BackgroundImage.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "Media.h"
+#include "MediaSource.h"
+#include "ShowCardAction.h"
+
+using namespace AdaptiveSharedNamespace;
+
+namespace
+{
+    // Walks a card in document order, merging each reference to a resource into the manifest as it goes
+    class ManifestBuilder
+    {
+    public:
+        explicit ManifestBuilder(const HostConfig& hostConfig) : m_baseUrl(hostConfig.GetImageBaseUrlRef()), m_position(0)
+        {
+        }
+
+        void AddCard(const AdaptiveCard& card, bool isVisible)
+        {
+            AddBackgroundImage(card.GetBackgroundImage(), card.GetInternalId(), isVisible);
+            for (const auto& element : card.GetBody())
+            {
+                AddElement(*element, isVisible);
+            }
+            AddActions(card.GetActions(), isVisible);
+        }
+
+        std::vector<ResourceManifestEntry> TakeEntries()
+        {
+            std::stable_sort(m_entries.begin(), m_entries.end(), [](const ResourceManifestEntry& a, const ResourceManifestEntry& b) {
+                return (a.isInitiallyVisible != b.isInitiallyVisible) ? a.isInitiallyVisible : (a.position < b.position);
+            });
+            return std::move(m_entries);
+        }
+
+    private:
+        void AddElement(const BaseCardElement& element, bool isParentVisible)
+        {
+            const bool isVisible = isParentVisible && element.GetIsVisible();
+            const InternalId id = element.GetInternalId();
+            switch (element.GetElementType())
+            {
+            case CardElementType::Image:
+                AddReference(static_cast<const Image&>(element).GetUrlRef(), "image", id, isVisible);
+                break;
+            case CardElementType::ImageSet:
+                for (const auto& image : static_cast<const ImageSet&>(element).GetImages())
+                {
+                    AddElement(*image, isVisible);
+                }
+                break;
+            case CardElementType::Media:
+            {
+                const auto& media = static_cast<const Media&>(element);
+                AddReference(media.GetPosterRef(), "image", id, isVisible);
+                for (const auto& source : media.GetSources())
+                {
+                    AddReference(source->GetUrlRef(), source->GetMimeTypeRef(), id, isVisible);
+                }
+                break;
+            }
+            case CardElementType::Container:
+            {
+                const auto& container = static_cast<const Container&>(element);
+                AddBackgroundImage(container.GetBackgroundImage(), id, isVisible);
+                for (const auto& item : container.GetItems())
+                {
+                    AddElement(*item, isVisible);
+                }
+                break;
+            }
+            case CardElementType::ColumnSet:
+            {
+                const auto& columnSet = static_cast<const ColumnSet&>(element);
+                AddBackgroundImage(columnSet.GetBackgroundImage(), id, isVisible);
+                for (const auto& column : columnSet.GetColumns())
+                {
+                    AddElement(*column, isVisible);
+                }
+                break;
+            }
+            case CardElementType::Column:
+            {
+                const auto& column = static_cast<const Column&>(element);
+                AddBackgroundImage(column.GetBackgroundImage(), id, isVisible);
+                for (const auto& item : column.GetItems())
+                {
+                    AddElement(*item, isVisible);
+                }
+                break;
+            }
+            case CardElementType::ActionSet:
+                AddActions(static_cast<const ActionSet&>(element).GetActions(), isVisible);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void AddActions(const std::vector<std::shared_ptr<BaseActionElement>>& actions, bool isVisible)
+        {
+            for (const auto& action : actions)
+            {
+                AddReference(action->GetIconUrl(), "image", action->GetInternalId(), isVisible);
+            }
+
+            // The cards of ShowCard actions are only shown once the action is invoked
+            for (const auto& action : actions)
+            {
+                if (action->GetElementType() == ActionType::ShowCard)
+                {
+                    // A card that hasn't been parsed lists its resources without being parsed, under the action's id
+                    if (static_cast<const ShowCardAction&>(*action).IsCardDeferred())
+                    {
+                        std::vector<RemoteResourceInformation> resources;
+                        action->GetResourceInformation(resources);
+                        for (const auto& resource : resources)
+                        {
+                            AddReference(resource.url, resource.mimeType, action->GetInternalId(), false);
+                        }
+                        continue;
+                    }
+
+                    const auto card = static_cast<const ShowCardAction&>(*action).GetCard();
+                    if (card)
+                    {
+                        AddCard(*card, false);
+                    }
+                }
+            }
+        }
+
+        void AddBackgroundImage(const std::shared_ptr<BackgroundImage>& backgroundImage, const InternalId& id, bool isVisible)
+        {
+            if (backgroundImage)
+            {
+                AddReference(backgroundImage->GetUrlRef(), "image", id, isVisible);
+            }
+        }
+
+        void AddReference(const std::string& url, const std::string& mimeType, const InternalId& id, bool isVisible)
+        {
+            if (url.empty())
+            {
+                return;
+            }
+
+            const unsigned int position = m_position++;
+            const std::string resolvedUrl = ResourceManifest::ResolveUrl(m_baseUrl, url);
+            const auto existing = m_entryIndexes.find(resolvedUrl);
+            if (existing == m_entryIndexes.end())
+            {
+                m_entryIndexes.emplace(resolvedUrl, m_entries.size());
+                m_entries.push_back({resolvedUrl, mimeType, {id}, position, isVisible});
+                return;
+            }
+
+            ResourceManifestEntry& entry = m_entries[existing->second];
+            if (entry.referencedBy.back() != id)
+            {
+                entry.referencedBy.push_back(id);
+            }
+            if (isVisible && !entry.isInitiallyVisible)
+            {
+                entry.position = position;
+                entry.isInitiallyVisible = true;
+            }
+        }
+
+        const std::string& m_baseUrl;
+        unsigned int m_position;
+        std::vector<ResourceManifestEntry> m_entries;
+        std::unordered_map<std::string, size_t> m_entryIndexes;
+    };
+
+    // Returns the length of url's scheme, including the colon, or 0 if it doesn't have one
+    size_t SchemeLength(const std::string& url)
+    {
+        if (url.empty() || !isalpha(static_cast<unsigned char>(url[0])))
+        {
+            return 0;
+        }
+
+        for (size_t i = 1; i < url.size(); i++)
+        {
+            const char ch = url[i];
+            if (ch == ':')
+            {
+                return i + 1;
+            }
+            if (!isalnum(static_cast<unsigned char>(ch)) && ch != '+' && ch != '-' && ch != '.')
+            {
+                return 0;
+            }
+        }
+        return 0;
+    }
+}
+
+std::vector<ResourceManifestEntry> ResourceManifest::Build(const AdaptiveCard& card, const HostConfig& hostConfig)
+{
+    ManifestBuilder builder(hostConfig);
+    builder.AddCard(card, true);
+    return builder.TakeEntries();
+}
+
+std::string ResourceManifest::ResolveUrl(const std::string& baseUrl, const std::string& url)
+{
+    if (baseUrl.empty() || url.empty() || SchemeLength(url) != 0)
+    {
+        return url;
+    }
+
+    const size_t schemeLength = SchemeLength(baseUrl);
+    if (url.compare(0, 2, "//") == 0)
+    {
+        return baseUrl.substr(0, schemeLength) + url;
+    }
+
+    // The end of the base URL's authority, where its path starts
+    size_t pathStart = schemeLength;
+    if (baseUrl.compare(schemeLength, 2, "//") == 0)
+    {
+        pathStart = std::min(baseUrl.find_first_of("/?#", schemeLength + 2), baseUrl.size());
+    }
+
+    if (url[0] == '/')
+    {
+        return baseUrl.substr(0, pathStart) + url;
+    }
+
+    // The base URL without its query, fragment, and the last segment of its path
+    const size_t pathEnd = std::min(baseUrl.find_first_of("?#", pathStart), baseUrl.size());
+    const size_t lastSlash = baseUrl.rfind('/', pathEnd - 1);
+    if (lastSlash == std::string::npos || lastSlash < pathStart)
+    {
+        return baseUrl.substr(0, pathEnd) + "/" + url;
+    }
+    return baseUrl.substr(0, lastSlash + 1) + url;
+}
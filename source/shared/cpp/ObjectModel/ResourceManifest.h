@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "HostConfig.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // One remote resource of a card, however many times the card uses it
+    struct ResourceManifestEntry
+    {
+        // Resolved against the host config's image base URL
+        std::string url;
+        // The mime type of the first reference ("image" for everything but media sources)
+        std::string mimeType;
+        // The elements that use the resource, in document order. The card itself is listed for its background image.
+        std::vector<InternalId> referencedBy;
+        // Where the resource is first used among all the card's references to resources, in document order, counting
+        // only references that are initially visible when there are any. Lower positions are nearer the top.
+        unsigned int position;
+        // Whether any reference is shown when the card is first rendered, i.e. isn't in an element with
+        // isVisible false or in the card of a ShowCard action
+        bool isInitiallyVisible;
+    };
+
+    // ResourceManifest lists what a prefetcher needs to fetch for a card: each URL once, in the order it's worth
+    // fetching in. Unlike AdaptiveCard::GetResourceInformation, empty URLs are left out, relative URLs are resolved
+    // against HostConfig::GetImageBaseUrl, and the icons of actions in ActionSets and of ShowCard actions are included.
+    // Fallback content isn't included.
+    class ResourceManifest
+    {
+    public:
+        // Entries that are initially visible come first, each group ordered by position
+        static std::vector<ResourceManifestEntry> Build(const AdaptiveCard& card, const HostConfig& hostConfig);
+
+        // Resolves url against baseUrl as a browser resolves a relative reference (without removing "." and ".."
+        // segments). url is returned unchanged if it has a scheme, or if baseUrl is empty.
+        static std::string ResolveUrl(const std::string& baseUrl, const std::string& url);
+    };
+}
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "SharedAdaptiveCard.h"
+#include "BinaryCardFormat.h"
+#include "CardIterator.h"
 #include "ParseUtil.h"
 #include "Util.h"
 #include "ShowCardAction.h"
@@ -10,9 +12,139 @@
 #include "SemanticVersion.h"
 #include "ParseContext.h"
 #include "BackgroundImage.h"
+#include "ActionSet.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "Image.h"
+#include "ImageSet.h"
+#include "Media.h"
+#include "MediaSource.h"
+#include "RichTextBlock.h"
+#include "TextRun.h"
 
 using namespace AdaptiveSharedNamespace;
 
+namespace
+{
+    typedef std::vector<std::pair<std::shared_ptr<BaseElement>, bool>> IdentifiedElements;
+
+    void CollectIdentifiedElements(const AdaptiveCard& card, bool isFallback, IdentifiedElements& elements);
+    void CollectIdentifiedElements(const std::shared_ptr<BaseCardElement>& element, bool isFallback, IdentifiedElements& elements);
+
+    void CollectIdentifiedElements(const std::shared_ptr<BaseActionElement>& action, bool isFallback, IdentifiedElements& elements)
+    {
+        if (!action)
+        {
+            return;
+        }
+
+        if (!action->GetId().empty())
+        {
+            elements.emplace_back(action, isFallback);
+        }
+
+        if (action->GetElementType() == ActionType::ShowCard)
+        {
+            const auto card = std::static_pointer_cast<ShowCardAction>(action)->GetCard();
+            if (card)
+            {
+                CollectIdentifiedElements(*card, isFallback, elements);
+            }
+        }
+
+        if (action->GetFallbackType() == FallbackType::Content)
+        {
+            CollectIdentifiedElements(std::static_pointer_cast<BaseActionElement>(action->GetFallbackContent()), true, elements);
+        }
+    }
+
+    template<typename T>
+    void CollectIdentifiedElements(const std::vector<std::shared_ptr<T>>& elements, bool isFallback, IdentifiedElements& identifiedElements)
+    {
+        for (const auto& element : elements)
+        {
+            CollectIdentifiedElements(element, isFallback, identifiedElements);
+        }
+    }
+
+    void CollectIdentifiedElements(const std::shared_ptr<BaseCardElement>& element, bool isFallback, IdentifiedElements& elements)
+    {
+        if (!element)
+        {
+            return;
+        }
+
+        if (!element->GetId().empty())
+        {
+            elements.emplace_back(element, isFallback);
+        }
+
+        switch (element->GetElementType())
+        {
+        case CardElementType::Container:
+        {
+            const auto container = std::static_pointer_cast<Container>(element);
+            CollectIdentifiedElements(container->GetSelectAction(), isFallback, elements);
+            CollectIdentifiedElements(container->GetItems(), isFallback, elements);
+            break;
+        }
+        case CardElementType::ColumnSet:
+        {
+            const auto columnSet = std::static_pointer_cast<ColumnSet>(element);
+            CollectIdentifiedElements(columnSet->GetSelectAction(), isFallback, elements);
+            for (const auto& column : columnSet->GetColumns())
+            {
+                CollectIdentifiedElements(std::static_pointer_cast<BaseCardElement>(column), isFallback, elements);
+            }
+            break;
+        }
+        case CardElementType::Column:
+        {
+            const auto column = std::static_pointer_cast<Column>(element);
+            CollectIdentifiedElements(column->GetSelectAction(), isFallback, elements);
+            CollectIdentifiedElements(column->GetItems(), isFallback, elements);
+            break;
+        }
+        case CardElementType::ActionSet:
+            CollectIdentifiedElements(std::static_pointer_cast<ActionSet>(element)->GetActions(), isFallback, elements);
+            break;
+        case CardElementType::ImageSet:
+            for (const auto& image : std::static_pointer_cast<ImageSet>(element)->GetImages())
+            {
+                CollectIdentifiedElements(std::static_pointer_cast<BaseCardElement>(image), isFallback, elements);
+            }
+            break;
+        case CardElementType::Image:
+            CollectIdentifiedElements(std::static_pointer_cast<Image>(element)->GetSelectAction(), isFallback, elements);
+            break;
+        case CardElementType::RichTextBlock:
+            for (const auto& inlineElement : std::static_pointer_cast<RichTextBlock>(element)->GetInlines())
+            {
+                if (inlineElement && inlineElement->GetInlineType() == InlineElementType::TextRun)
+                {
+                    CollectIdentifiedElements(std::static_pointer_cast<TextRun>(inlineElement)->GetSelectAction(), isFallback, elements);
+                }
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (element->GetFallbackType() == FallbackType::Content)
+        {
+            CollectIdentifiedElements(std::static_pointer_cast<BaseCardElement>(element->GetFallbackContent()), true, elements);
+        }
+    }
+
+    void CollectIdentifiedElements(const AdaptiveCard& card, bool isFallback, IdentifiedElements& elements)
+    {
+        CollectIdentifiedElements(card.GetBody(), isFallback, elements);
+        CollectIdentifiedElements(card.GetActions(), isFallback, elements);
+        CollectIdentifiedElements(card.GetSelectAction(), isFallback, elements);
+    }
+}
+
 AdaptiveCard::AdaptiveCard() :
     m_style(ContainerStyle::None), m_verticalContentAlignment(VerticalContentAlignment::Top), m_height(HeightType::Auto),
     m_minHeight(0), m_inputNecessityIndicators(InputNecessityIndicators::None), m_internalId{InternalId::Next()}
@@ -110,7 +242,10 @@ std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromFile(const std::string
 std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromFile(const std::string& jsonFile, std::string rendererVersion, ParseContext& context)
 #endif // __ANDROID__
 {
-    std::ifstream jsonFileStream(jsonFile);
+    std::ifstream jsonFileStream(jsonFile, std::ios::ate);
+    const std::streamoff size = jsonFileStream.tellg();
+    context.BeginParse((size > 0) ? static_cast<size_t>(size) : 0);
+    jsonFileStream.seekg(0);
 
     Json::Value root;
     jsonFileStream >> root;
@@ -148,6 +283,7 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json,
 #endif // __ANDROID__
 {
     ParseUtil::ThrowIfNotJsonObject(json);
+    context.BeginCard(json);
 
     const bool enforceVersion = !rendererVersion.empty();
 
@@ -195,7 +331,7 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json,
         }
     }
 
-    auto backgroundImage = ParseUtil::GetBackgroundImage(json);
+    auto backgroundImage = ParseUtil::GetBackgroundImage(context, json);
 
     ContainerStyle style =
         ParseUtil::GetEnumValue<ContainerStyle>(json, AdaptiveCardSchemaKey::Style, ContainerStyle::None, ContainerStyleFromString);
@@ -213,13 +349,14 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json,
         ParseSizeForPixelSize(ParseUtil::GetString(json, AdaptiveCardSchemaKey::MinHeight), &context.warnings);
 
     // Parse body
+    const size_t firstIdentifiedElement = context.GetIdentifiedElementCount();
     auto body = ParseUtil::GetElementCollection<BaseCardElement>(true, context, json, AdaptiveCardSchemaKey::Body, false);
     // Parse actions if present
     auto actions = ParseUtil::GetActionCollection(context, json, AdaptiveCardSchemaKey::Actions, false);
 
     EnsureShowCardVersions(actions, version);
 
-    auto result = std::make_shared<AdaptiveCard>(
+    auto result = context.MakeShared<AdaptiveCard>(
         version, fallbackText, backgroundImage, style, speak, language, verticalContentAlignment, height, minHeight, body, actions);
     result->SetLanguage(language);
 
@@ -229,7 +366,11 @@ std::shared_ptr<ParseResult> AdaptiveCard::Deserialize(const Json::Value& json,
     result->SetInputNecessityIndicators(ParseUtil::GetEnumValue<InputNecessityIndicators>(
         json, AdaptiveCardSchemaKey::InputNecessityIndicators, InputNecessityIndicators::None, InputNecessityIndicatorsFromString));
 
-    return std::make_shared<ParseResult>(result, context.warnings);
+    context.IndexIdentifiedElements(firstIdentifiedElement, result->m_elementsById);
+    result->m_elementIndexIsStale = false;
+    result->m_hasDeferredCards = context.GetDeferShowCardParsing();
+
+    return std::make_shared<ParseResult>(result, context.warnings, context.GetArena());
 }
 
 #ifdef __ANDROID__
@@ -251,7 +392,51 @@ std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromString(const std::stri
 std::shared_ptr<ParseResult> AdaptiveCard::DeserializeFromString(const std::string& jsonString, std::string rendererVersion, ParseContext& context)
 #endif // __ANDROID__
 {
-    return AdaptiveCard::Deserialize(ParseUtil::GetJsonValueFromString(jsonString), rendererVersion, context);
+    context.BeginParse(jsonString.size());
+    const Json::Value json = ParseUtil::GetJsonValueFromString(jsonString);
+    if (!context.GetDeferShowCardParsing())
+    {
+        return AdaptiveCard::Deserialize(json, rendererVersion, context);
+    }
+
+    // Deferred ShowCard cards keep the slice of jsonString they were read from
+    context.SetSourceText(&jsonString);
+    try
+    {
+        const auto parseResult = AdaptiveCard::Deserialize(json, rendererVersion, context);
+        context.SetSourceText(nullptr);
+        return parseResult;
+    }
+    catch (...)
+    {
+        context.SetSourceText(nullptr);
+        throw;
+    }
+}
+
+#ifdef __ANDROID__
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeBinary(const uint8_t* data,
+                                                             size_t size,
+                                                             std::string rendererVersion) throw(AdaptiveSharedNamespace::AdaptiveCardParseException)
+#else
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeBinary(const uint8_t* data, size_t size, std::string rendererVersion)
+#endif // __ANDROID__
+{
+    ParseContext context;
+    return AdaptiveCard::DeserializeBinary(data, size, rendererVersion, context);
+}
+
+#ifdef __ANDROID__
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeBinary(const uint8_t* data,
+                                                             size_t size,
+                                                             std::string rendererVersion,
+                                                             ParseContext& context) throw(AdaptiveSharedNamespace::AdaptiveCardParseException)
+#else
+std::shared_ptr<ParseResult> AdaptiveCard::DeserializeBinary(const uint8_t* data, size_t size, std::string rendererVersion, ParseContext& context)
+#endif // __ANDROID__
+{
+    context.BeginParse(size);
+    return AdaptiveCard::Deserialize(BinaryCardFormat::Read(data, size), rendererVersion, context);
 }
 
 Json::Value AdaptiveCard::SerializeToJsonValue() const
@@ -355,11 +540,21 @@ std::string AdaptiveCard::Serialize() const
     return ParseUtil::JsonToString(SerializeToJsonValue());
 }
 
+std::vector<uint8_t> AdaptiveCard::SerializeBinary() const
+{
+    return BinaryCardFormat::Write(SerializeToJsonValue());
+}
+
 std::string AdaptiveCard::GetVersion() const
 {
     return m_version;
 }
 
+const std::string& AdaptiveCard::GetVersionRef() const
+{
+    return m_version;
+}
+
 void AdaptiveCard::SetVersion(const std::string& value)
 {
     m_version = value;
@@ -370,6 +565,11 @@ std::string AdaptiveCard::GetFallbackText() const
     return m_fallbackText;
 }
 
+const std::string& AdaptiveCard::GetFallbackTextRef() const
+{
+    return m_fallbackText;
+}
+
 void AdaptiveCard::SetFallbackText(const std::string& value)
 {
     m_fallbackText = value;
@@ -390,6 +590,11 @@ std::string AdaptiveCard::GetSpeak() const
     return m_speak;
 }
 
+const std::string& AdaptiveCard::GetSpeakRef() const
+{
+    return m_speak;
+}
+
 void AdaptiveCard::SetSpeak(const std::string& value)
 {
     m_speak = value;
@@ -410,6 +615,11 @@ std::string AdaptiveCard::GetLanguage() const
     return m_language;
 }
 
+const std::string& AdaptiveCard::GetLanguageRef() const
+{
+    return m_language;
+}
+
 void AdaptiveCard::SetLanguage(const std::string& value)
 {
     m_language = value;
@@ -458,6 +668,7 @@ std::shared_ptr<BaseActionElement> AdaptiveCard::GetSelectAction() const
 void AdaptiveCard::SetSelectAction(const std::shared_ptr<BaseActionElement> action)
 {
     m_selectAction = action;
+    InvalidateElementIndex();
 }
 
 VerticalContentAlignment AdaptiveCard::GetVerticalContentAlignment() const
@@ -490,28 +701,189 @@ void AdaptiveCard::SetInputNecessityIndicators(const InputNecessityIndicators va
     m_inputNecessityIndicators = value;
 }
 
-std::vector<RemoteResourceInformation> AdaptiveCard::GetResourceInformation()
+std::shared_ptr<BaseElement> AdaptiveCard::GetElementById(const std::string& id) const
 {
-    auto resourceVector = std::vector<RemoteResourceInformation>();
-
-    auto backgroundImage = GetBackgroundImage();
-    if (backgroundImage != nullptr)
+    std::lock_guard<std::mutex> lock(m_elementIndexMutex);
+    for (int attempt = 0; attempt < 2; ++attempt)
     {
-        RemoteResourceInformation backgroundImageInfo;
-        backgroundImageInfo.url = backgroundImage->GetUrl();
-        backgroundImageInfo.mimeType = "image";
-        resourceVector.push_back(backgroundImageInfo);
-    }
+        if (m_elementIndexIsStale)
+        {
+            IdentifiedElements elements;
+            CollectIdentifiedElements(*this, false, elements);
+            BuildElementIndex(elements);
+        }
 
-    for (auto item : m_body)
-    {
-        item->GetResourceInformation(resourceVector);
+        auto entry = m_elementsById.find(id);
+        if (entry == m_elementsById.end() && m_hasDeferredCards)
+        {
+            // Collecting the elements again parses the deferred cards, so this is only done once
+            m_hasDeferredCards = false;
+            IdentifiedElements elements;
+            CollectIdentifiedElements(*this, false, elements);
+            BuildElementIndex(elements);
+            entry = m_elementsById.find(id);
+        }
+        if (entry == m_elementsById.end())
+        {
+            return nullptr;
+        }
+
+        // The element may have been removed or given a different id since the index was built
+        auto element = entry->second.front().lock();
+        if (element && element->GetId() == id)
+        {
+            return element;
+        }
+        m_elementIndexIsStale = true;
     }
+    return nullptr;
+}
+
+void AdaptiveCard::InvalidateElementIndex()
+{
+    std::lock_guard<std::mutex> lock(m_elementIndexMutex);
+    m_elementIndexIsStale = true;
+}
 
-    for (auto item : m_actions)
+void AdaptiveCard::BuildElementIndex(const std::vector<std::pair<std::shared_ptr<BaseElement>, bool>>& elements) const
+{
+    m_elementsById.clear();
+
+    // Elements go in ahead of any fallback content with the same id
+    for (const bool isFallback : {false, true})
     {
-        item->GetResourceInformation(resourceVector);
+        for (const auto& element : elements)
+        {
+            if (element.second == isFallback)
+            {
+                m_elementsById[element.first->GetId()].emplace_back(element.first);
+            }
+        }
     }
+    m_elementIndexIsStale = false;
+}
 
+std::vector<RemoteResourceInformation> AdaptiveCard::GetResourceInformation()
+{
+    auto resourceVector = std::vector<RemoteResourceInformation>();
+    GetResourceInformation(resourceVector);
     return resourceVector;
 }
+
+namespace
+{
+    // Collects what the elements' own GetResourceInformation methods report, in the same order, walking only the
+    // children they walk: the actions of ActionSets aren't included, for instance, and neither are ShowCard icons.
+    class ResourceInformationCollector : public CardVisitor
+    {
+    public:
+        explicit ResourceInformationCollector(std::vector<RemoteResourceInformation>& resourceInfo) :
+            m_resourceInfo(resourceInfo)
+        {
+        }
+
+        bool VisitCard(const AdaptiveCard& card) override
+        {
+            AddBackgroundImage(card.GetBackgroundImage());
+            return true;
+        }
+
+        bool VisitContainer(const Container& container) override
+        {
+            AddBackgroundImage(container.GetBackgroundImage());
+            return true;
+        }
+
+        bool VisitColumn(const Column& column) override
+        {
+            AddBackgroundImage(column.GetBackgroundImage());
+            return true;
+        }
+
+        bool VisitColumnSet(const ColumnSet& columnSet) override
+        {
+            AddBackgroundImage(columnSet.GetBackgroundImage());
+            return true;
+        }
+
+        bool VisitImageSet(const ImageSet& /*imageSet*/) override { return true; }
+
+        bool VisitImage(const Image& image) override
+        {
+            Add(image.GetUrl(), "image");
+            return false;
+        }
+
+        bool VisitMedia(const Media& media) override
+        {
+            Add(media.GetPoster(), "image");
+            for (const auto& source : media.GetSources())
+            {
+                Add(source->GetUrl(), source->GetMimeType());
+            }
+            return false;
+        }
+
+        bool VisitElement(const BaseCardElement& element) override
+        {
+            // Custom elements report their own resources. The card being walked isn't const, so neither are they.
+            if (element.GetElementType() == CardElementType::Custom)
+            {
+                const_cast<BaseCardElement&>(element).GetResourceInformation(m_resourceInfo);
+            }
+            return false;
+        }
+
+        bool VisitShowCardAction(const ShowCardAction& action) override
+        {
+            // A card that hasn't been parsed reports its resources without being parsed for them
+            if (action.IsCardDeferred())
+            {
+                const_cast<ShowCardAction&>(action).GetResourceInformation(m_resourceInfo);
+                return false;
+            }
+            return true;
+        }
+
+        bool VisitAction(const BaseActionElement& action) override
+        {
+            if (action.GetElementType() == ActionType::Custom)
+            {
+                const_cast<BaseActionElement&>(action).GetResourceInformation(m_resourceInfo);
+            }
+            else
+            {
+                const std::string iconUrl = action.GetIconUrl();
+                if (!iconUrl.empty())
+                {
+                    Add(iconUrl, "image");
+                }
+            }
+            return false;
+        }
+
+    private:
+        void AddBackgroundImage(const std::shared_ptr<BackgroundImage>& backgroundImage)
+        {
+            if (backgroundImage != nullptr)
+            {
+                Add(backgroundImage->GetUrl(), "image");
+            }
+        }
+
+        void Add(const std::string& url, const std::string& mimeType)
+        {
+            m_resourceInfo.emplace_back();
+            m_resourceInfo.back().url = url;
+            m_resourceInfo.back().mimeType = mimeType;
+        }
+
+        std::vector<RemoteResourceInformation>& m_resourceInfo;
+    };
+}
+
+void AdaptiveCard::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
+{
+    ResourceInformationCollector collector(resourceInfo);
+    CardIterator::Walk(*this, collector);
+}
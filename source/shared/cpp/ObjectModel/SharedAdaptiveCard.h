@@ -3,6 +3,7 @@
 #pragma once
 
 #include "pch.h"
+#include <mutex>
 #include "BaseCardElement.h"
 #include "BaseActionElement.h"
 #include "ParseResult.h"
@@ -62,16 +63,20 @@ namespace AdaptiveSharedNamespace
                      std::vector<std::shared_ptr<BaseActionElement>>& actions);
 
         std::string GetVersion() const;
+        const std::string& GetVersionRef() const;
         void SetVersion(const std::string& value);
         std::string GetFallbackText() const;
+        const std::string& GetFallbackTextRef() const;
         void SetFallbackText(const std::string& value);
         std::shared_ptr<BackgroundImage> GetBackgroundImage() const;
         void SetBackgroundImage(const std::shared_ptr<BackgroundImage> value);
         std::string GetSpeak() const;
+        const std::string& GetSpeakRef() const;
         void SetSpeak(const std::string& value);
         ContainerStyle GetStyle() const;
         void SetStyle(const ContainerStyle value);
         std::string GetLanguage() const;
+        const std::string& GetLanguageRef() const;
         void SetLanguage(const std::string& value);
         VerticalContentAlignment GetVerticalContentAlignment() const;
         void SetVerticalContentAlignment(const VerticalContentAlignment value);
@@ -90,7 +95,20 @@ namespace AdaptiveSharedNamespace
         std::vector<std::shared_ptr<BaseActionElement>>& GetActions();
         const std::vector<std::shared_ptr<BaseActionElement>>& GetActions() const;
 
+        // Returns the element with the given id from anywhere in the card, including fallback content and the cards of
+        // ShowCard actions, or nullptr. Where fallback content shares an id with the element it stands in for, the
+        // element itself is returned.
+        //
+        // The index behind this is built while parsing, from the ids checked for collisions. Call
+        // InvalidateElementIndex() after adding elements to the card or changing its containers; SetSelectAction() does
+        // so itself. Changed ids and destroyed elements are picked up on the next lookup. The first id not found parses
+        // any ShowCard cards that were deferred, to look in them too. Lookups may be made from several threads at once.
+        std::shared_ptr<BaseElement> GetElementById(const std::string& id) const;
+        void InvalidateElementIndex();
+
         std::vector<RemoteResourceInformation> GetResourceInformation();
+        // As above, appending to resourceInfo. See ResourceManifest for a list without duplicates.
+        void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo);
 
         CardElementType GetElementType() const;
 #ifdef __ANDROID__
@@ -109,6 +127,14 @@ namespace AdaptiveSharedNamespace
                                                                   ParseContext& context) throw(AdaptiveSharedNamespace::AdaptiveCardParseException);
         static std::shared_ptr<ParseResult> DeserializeFromString(const std::string& jsonString,
                                                                   std::string rendererVersion) throw(AdaptiveSharedNamespace::AdaptiveCardParseException);
+
+        static std::shared_ptr<ParseResult> DeserializeBinary(const uint8_t* data,
+                                                              size_t size,
+                                                              std::string rendererVersion,
+                                                              ParseContext& context) throw(AdaptiveSharedNamespace::AdaptiveCardParseException);
+        static std::shared_ptr<ParseResult> DeserializeBinary(const uint8_t* data,
+                                                              size_t size,
+                                                              std::string rendererVersion) throw(AdaptiveSharedNamespace::AdaptiveCardParseException);
         static std::shared_ptr<AdaptiveCard> MakeFallbackTextCard(const std::string& fallbackText,
                                                                   const std::string& language,
                                                                   const std::string& speak) throw(AdaptiveSharedNamespace::AdaptiveCardParseException);
@@ -127,6 +153,10 @@ namespace AdaptiveSharedNamespace
         static std::shared_ptr<ParseResult> DeserializeFromString(const std::string& jsonString,
                                                                   std::string rendererVersion);
 
+        // Parses a card from the output of SerializeBinary, which can be read in place from a memory-mapped file
+        static std::shared_ptr<ParseResult> DeserializeBinary(const uint8_t* data, size_t size, std::string rendererVersion, ParseContext& context);
+        static std::shared_ptr<ParseResult> DeserializeBinary(const uint8_t* data, size_t size, std::string rendererVersion);
+
         static std::shared_ptr<AdaptiveCard> MakeFallbackTextCard(const std::string& fallbackText,
                                                                   const std::string& language,
                                                                   const std::string& speak);
@@ -135,11 +165,17 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue() const;
         std::string Serialize() const;
 
+        // The same content as Serialize() in a compact binary form, with strings deduplicated and property names
+        // stored as AdaptiveCardSchemaKeys (see BinaryCardFormat)
+        std::vector<uint8_t> SerializeBinary() const;
+
         const InternalId GetInternalId() const { return m_internalId; }
 
     private:
         static void _ValidateLanguage(const std::string& language, std::vector<std::shared_ptr<AdaptiveCardParseWarning>>& warnings);
 
+        void BuildElementIndex(const std::vector<std::pair<std::shared_ptr<BaseElement>, bool>>& elements) const;
+
         std::string m_version;
         std::string m_fallbackText;
         std::shared_ptr<BackgroundImage> m_backgroundImage;
@@ -157,5 +193,13 @@ namespace AdaptiveSharedNamespace
         std::vector<std::shared_ptr<BaseActionElement>> m_actions;
 
         std::shared_ptr<BaseActionElement> m_selectAction;
+
+        // id -> elements with that id, the element before any fallback content that shares its id. Rebuilt when it's
+        // stale, under the mutex, by lookups.
+        mutable std::mutex m_elementIndexMutex;
+        mutable std::unordered_map<std::string, std::vector<std::weak_ptr<BaseElement>>> m_elementsById;
+        mutable bool m_elementIndexIsStale = true;
+        // Whether the card may hold ShowCard cards whose elements are left out of the index until they're parsed
+        mutable bool m_hasDeferredCards = false;
     };
 }
@@ -1,13 +1,332 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "pch.h"
+#include <mutex>
 #include "SharedAdaptiveCard.h"
+#include "BinaryCardFormat.h"
+#include "CardView.h"
 #include "ParseUtil.h"
 #include "ShowCardAction.h"
 #include "ParseContext.h"
 
 using namespace AdaptiveSharedNamespace;
 
+class ShowCardAction::DeferredCard
+{
+public:
+    DeferredCard(const ParseContext& context, const Json::Value& card) :
+        m_elementParserRegistration(context.elementParserRegistration),
+        m_actionParserRegistration(context.actionParserRegistration), m_language(context.GetLanguage()),
+        m_limits(context.GetLimits()), m_compactChoiceThreshold(context.GetCompactChoiceThreshold()),
+        m_dataUriInternThreshold(context.GetDataUriInternThreshold()),
+        m_parentalContainerStyle(context.GetParentalContainerStyle()),
+        m_paddingParentInternalId(context.PaddingParentInternalId()), m_bleedDirection(context.GetBleedDirection()),
+        m_canFallbackToAncestor(context.GetCanFallbackToAncestor()), m_hasResources(false), m_isParsed(false)
+    {
+        // Copying out the text the card was read from is cheaper than writing it in binary form, so that's kept when
+        // the card was read from text. A card built as a Json::Value has no text to keep.
+        const std::string* text = context.GetSourceText();
+        const ptrdiff_t start = card.getOffsetStart();
+        const ptrdiff_t limit = card.getOffsetLimit();
+        if (text && start >= 0 && start < limit && static_cast<size_t>(limit) <= text->size() &&
+            (*text)[start] == '{' && (*text)[limit - 1] == '}')
+        {
+            m_text.assign(*text, static_cast<size_t>(start), static_cast<size_t>(limit - start));
+        }
+        else
+        {
+            m_binary = BinaryCardFormat::Write(card);
+        }
+    }
+
+    std::shared_ptr<AdaptiveCard> GetCard()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isParsed)
+        {
+            Parse();
+        }
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+        return m_card;
+    }
+
+    bool IsParsed()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_isParsed;
+    }
+
+    std::vector<std::shared_ptr<AdaptiveCardParseWarning>> GetWarnings()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_warnings;
+    }
+
+    // The card's resources, listed from its JSON if it hasn't been parsed
+    void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_isParsed)
+        {
+            if (!m_hasResources)
+            {
+                if (m_binary.empty())
+                {
+                    const std::vector<uint8_t> binary = BinaryCardFormat::Write(ParseUtil::GetJsonValueFromString(m_text));
+                    m_resources = CardView(binary.data(), binary.size()).GetResourceInformation();
+                }
+                else
+                {
+                    m_resources = CardView(m_binary.data(), m_binary.size()).GetResourceInformation();
+                }
+                m_hasResources = true;
+            }
+            resourceInfo.insert(resourceInfo.end(), m_resources.begin(), m_resources.end());
+            return;
+        }
+        lock.unlock();
+
+        const auto card = GetCard();
+        if (card)
+        {
+            card->GetResourceInformation(resourceInfo);
+        }
+    }
+
+    // The card's JSON as it was kept while the card is deferred, or couldn't be parsed, so serializing doesn't
+    // parse it
+    Json::Value SerializeToJsonValue()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_isParsed && !m_error)
+        {
+            lock.unlock();
+            return m_card->SerializeToJsonValue();
+        }
+
+        Json::Value json = m_binary.empty() ? ParseUtil::GetJsonValueFromString(m_text) :
+                                              BinaryCardFormat::Read(m_binary.data(), m_binary.size());
+        const std::string language = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Language);
+        if (!m_defaultLanguage.empty() && !json.isMember(language))
+        {
+            json[language] = m_defaultLanguage;
+        }
+        const std::string version = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Version);
+        if (!m_defaultVersion.empty() && !json.isMember(version))
+        {
+            json[version] = m_defaultVersion;
+        }
+        return json;
+    }
+
+    void SetLanguage(const std::string& language)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isParsed)
+        {
+            m_defaultLanguage = language;
+        }
+        else if (m_card && m_card->GetLanguage().empty())
+        {
+            m_card->SetLanguage(language);
+        }
+    }
+
+    void SetDefaultVersion(const std::string& version)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isParsed)
+        {
+            m_defaultVersion = version;
+        }
+        else if (m_card && m_card->GetVersion().empty())
+        {
+            m_card->SetVersion(version);
+        }
+    }
+
+private:
+    // Parses the card as the context it was deferred by would have, though as a card of its own: its ids were checked
+    // against the rest of the card when it was deferred. The context is put back in the state it was in at the
+    // action, so styles, padding and bleed come out as they would have.
+    void Parse()
+    {
+        m_isParsed = true;
+        try
+        {
+            ParseContext context(m_elementParserRegistration, m_actionParserRegistration);
+            context.RestoreElementState(m_parentalContainerStyle, m_paddingParentInternalId, m_bleedDirection, m_canFallbackToAncestor);
+            context.SetLanguage(m_language);
+            context.SetLimits(m_limits);
+            context.SetCompactChoiceThreshold(m_compactChoiceThreshold);
+            context.SetDataUriInternThreshold(m_dataUriInternThreshold);
+            context.SetDeferShowCardParsing(true);
+
+            const auto parseResult = m_binary.empty() ?
+                AdaptiveCard::DeserializeFromString(m_text, "", context) :
+                AdaptiveCard::Deserialize(BinaryCardFormat::Read(m_binary.data(), m_binary.size()), "", context);
+            m_card = parseResult->GetAdaptiveCard();
+            m_warnings = parseResult->GetWarnings();
+
+            if (!m_defaultLanguage.empty() && m_card->GetLanguage().empty())
+            {
+                m_card->SetLanguage(m_defaultLanguage);
+            }
+            if (!m_defaultVersion.empty() && m_card->GetVersion().empty())
+            {
+                m_card->SetVersion(m_defaultVersion);
+            }
+        }
+        catch (...)
+        {
+            // The JSON is kept for serializing a card that doesn't parse
+            m_error = std::current_exception();
+            return;
+        }
+
+        // The card doesn't need its JSON once it's parsed
+        std::string().swap(m_text);
+        std::vector<uint8_t>().swap(m_binary);
+        std::vector<RemoteResourceInformation>().swap(m_resources);
+    }
+
+    std::mutex m_mutex;
+
+    // The card's JSON, as text or in binary form, until it's parsed
+    std::string m_text;
+    std::vector<uint8_t> m_binary;
+
+    std::shared_ptr<ElementParserRegistration> m_elementParserRegistration;
+    std::shared_ptr<ActionParserRegistration> m_actionParserRegistration;
+    std::string m_language;
+    ParseLimits m_limits;
+    size_t m_compactChoiceThreshold;
+    size_t m_dataUriInternThreshold;
+    ContainerStyle m_parentalContainerStyle;
+    InternalId m_paddingParentInternalId;
+    ContainerBleedDirection m_bleedDirection;
+    bool m_canFallbackToAncestor;
+
+    // Set on the action before the card is parsed
+    std::string m_defaultLanguage;
+    std::string m_defaultVersion;
+
+    // Listed the first time they're asked for before the card is parsed
+    std::vector<RemoteResourceInformation> m_resources;
+    bool m_hasResources;
+
+    bool m_isParsed;
+    std::shared_ptr<AdaptiveCard> m_card;
+    std::vector<std::shared_ptr<AdaptiveCardParseWarning>> m_warnings;
+    std::exception_ptr m_error;
+};
+
+namespace
+{
+    void CheckElementIds(ParseContext& context, const Json::Value& json, const char* impliedType = nullptr);
+
+    void CheckElementIds(ParseContext& context, const Json::Value& json, AdaptiveCardSchemaKey key, const char* impliedType = nullptr)
+    {
+        const Json::Value& children = json[AdaptiveCardSchemaKeyToString(key)];
+        if (children.isArray())
+        {
+            for (const auto& child : children)
+            {
+                CheckElementIds(context, child, impliedType);
+            }
+        }
+        else if (children.isObject())
+        {
+            CheckElementIds(context, children, impliedType);
+        }
+    }
+
+    void CheckCardIds(ParseContext& context, const Json::Value& card)
+    {
+        CheckElementIds(context, card, AdaptiveCardSchemaKey::Body);
+        CheckElementIds(context, card, AdaptiveCardSchemaKey::Actions);
+        CheckElementIds(context, card, AdaptiveCardSchemaKey::SelectAction);
+    }
+
+    // Pushes an element of a deferred card, and everything parsing it would push, through the context in the order
+    // parsing would, so that its id is checked for collisions with the rest of the card now rather than when it's
+    // shown. Only the children of built-in elements are known; the ids inside custom elements are checked when the
+    // card is parsed, against the rest of the deferred card.
+    void CheckElementIds(ParseContext& context, const Json::Value& json, const char* impliedType)
+    {
+        if (!json.isObject())
+        {
+            return;
+        }
+
+        const Json::Value& idValue = json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Id)];
+        const std::string id = idValue.isString() ? idValue.asString() : "";
+        const Json::Value& typeValue = json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Type)];
+        const std::string type = typeValue.isString() ? typeValue.asString() : (impliedType ? impliedType : "");
+
+        const InternalId internalId = InternalId::Next();
+        context.PushElement(id, internalId);
+
+        const Json::Value& fallback = json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Fallback)];
+        if (fallback.isObject())
+        {
+            context.PushElement(id, internalId, true /*isFallback*/);
+            CheckElementIds(context, fallback);
+            context.PopElement();
+        }
+
+        if (type == "Container" || type == "Column")
+        {
+            CheckElementIds(context, json, AdaptiveCardSchemaKey::Items);
+            CheckElementIds(context, json, AdaptiveCardSchemaKey::SelectAction);
+        }
+        else if (type == "ColumnSet")
+        {
+            CheckElementIds(context, json, AdaptiveCardSchemaKey::Columns, "Column");
+            CheckElementIds(context, json, AdaptiveCardSchemaKey::SelectAction);
+        }
+        else if (type == "ImageSet")
+        {
+            CheckElementIds(context, json, AdaptiveCardSchemaKey::Images, "Image");
+        }
+        else if (type == "Image")
+        {
+            CheckElementIds(context, json, AdaptiveCardSchemaKey::SelectAction);
+        }
+        else if (type == "ActionSet")
+        {
+            CheckElementIds(context, json, AdaptiveCardSchemaKey::Actions);
+        }
+        else if (type == "RichTextBlock")
+        {
+            const Json::Value& inlines = json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Inlines)];
+            if (inlines.isArray())
+            {
+                for (const auto& inlineJson : inlines)
+                {
+                    if (inlineJson.isObject())
+                    {
+                        CheckElementIds(context, inlineJson, AdaptiveCardSchemaKey::SelectAction);
+                    }
+                }
+            }
+        }
+        else if (type == "Action.ShowCard")
+        {
+            const Json::Value& card = json[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card)];
+            if (card.isObject())
+            {
+                CheckCardIds(context, card);
+            }
+        }
+
+        context.PopElement();
+    }
+}
+
 ShowCardAction::ShowCardAction() : BaseActionElement(ActionType::ShowCard)
 {
     PopulateKnownPropertiesSet();
@@ -17,40 +336,78 @@ Json::Value ShowCardAction::SerializeToJsonValue() const
 {
     Json::Value root = BaseActionElement::SerializeToJsonValue();
 
-    root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card)] = GetCard()->SerializeToJsonValue();
+    // A deferred card is serialized from its JSON rather than parsed
+    root[AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card)] =
+        m_deferredCard ? m_deferredCard->SerializeToJsonValue() : m_card->SerializeToJsonValue();
 
     return root;
 }
 
 std::shared_ptr<AdaptiveCard> ShowCardAction::GetCard() const
 {
-    return m_card;
+    return m_deferredCard ? m_deferredCard->GetCard() : m_card;
 }
 
 void ShowCardAction::SetCard(const std::shared_ptr<AdaptiveCard> card)
 {
     m_card = card;
+    m_deferredCard.reset();
+}
+
+bool ShowCardAction::IsCardDeferred() const
+{
+    return m_deferredCard && !m_deferredCard->IsParsed();
+}
+
+std::vector<std::shared_ptr<AdaptiveCardParseWarning>> ShowCardAction::GetDeferredCardWarnings() const
+{
+    return m_deferredCard ? m_deferredCard->GetWarnings() : std::vector<std::shared_ptr<AdaptiveCardParseWarning>>();
 }
 
 void ShowCardAction::SetLanguage(const std::string& value)
 {
+    if (m_deferredCard)
+    {
+        m_deferredCard->SetLanguage(value);
+    }
     // If the card inside doesn't specify language, propagate
-    if (m_card->GetLanguage().empty())
+    else if (m_card->GetLanguage().empty())
     {
         m_card->SetLanguage(value);
     }
 }
 
+void ShowCardAction::SetDefaultCardVersion(const std::string& version)
+{
+    if (m_deferredCard)
+    {
+        m_deferredCard->SetDefaultVersion(version);
+    }
+    else if (m_card->GetVersion().empty())
+    {
+        m_card->SetVersion(version);
+    }
+}
+
 std::shared_ptr<BaseActionElement> ShowCardActionParser::Deserialize(ParseContext& context, const Json::Value& json)
 {
     std::shared_ptr<ShowCardAction> showCardAction = BaseActionElement::Deserialize<ShowCardAction>(context, json);
 
     std::string propertyName = AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card);
 
-    auto parseResult = AdaptiveCard::Deserialize(json.get(propertyName, Json::Value()), "", context);
+    if (context.GetDeferShowCardParsing())
+    {
+        const Json::Value& card = json[propertyName];
+        ParseUtil::ThrowIfNotJsonObject(card);
+        ParseUtil::ExpectTypeString(card, CardElementType::AdaptiveCard);
+        CheckCardIds(context, card);
 
-    auto showCardWarnings = parseResult->GetWarnings();
-    auto warningsEnd = context.warnings.insert(context.warnings.end(), showCardWarnings.begin(), showCardWarnings.end());
+        showCardAction->m_deferredCard = std::make_shared<ShowCardAction::DeferredCard>(context, card);
+        return showCardAction;
+    }
+
+    // The card is parsed with this context, so its warnings are already among the context's
+    auto parseResult = AdaptiveCard::Deserialize(json[propertyName], "", context);
 
     showCardAction->SetCard(parseResult->GetAdaptiveCard());
 
@@ -65,13 +422,19 @@ ShowCardActionParser::DeserializeFromString(ParseContext& context, const std::st
 
 void ShowCardAction::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Card)});
+    m_sharedKnownProperties = &knownProperties;
 }
 
 void ShowCardAction::GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo)
 {
-    auto card = GetCard();
-    auto showCardResources = card->GetResourceInformation();
-    auto resourceInfoEnd = resourceInfo.insert(resourceInfo.end(), showCardResources.begin(), showCardResources.end());
+    if (m_deferredCard)
+    {
+        m_deferredCard->GetResourceInformation(resourceInfo);
+        return;
+    }
+
+    GetCard()->GetResourceInformation(resourceInfo);
     return;
 }
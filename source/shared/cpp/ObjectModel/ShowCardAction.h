@@ -19,19 +19,37 @@ namespace AdaptiveSharedNamespace
         ShowCardAction& operator=(ShowCardAction&&) = default;
         ~ShowCardAction() = default;
 
+        // A deferred card that hasn't been parsed, or didn't parse, is serialized from its JSON
         Json::Value SerializeToJsonValue() const override;
 
+        // When the card was deferred (see ParseContext::SetDeferShowCardParsing), the first call parses it, and throws
+        // an AdaptiveCardParseException if it doesn't parse; so does every later call. Safe to call from several
+        // threads.
         std::shared_ptr<AdaptiveSharedNamespace::AdaptiveCard> GetCard() const;
         void SetCard(const std::shared_ptr<AdaptiveSharedNamespace::AdaptiveCard>);
 
+        // Whether the card is deferred and hasn't been parsed yet
+        bool IsCardDeferred() const;
+        // The warnings from parsing a deferred card, once it's parsed. A card parsed along with the rest of the card
+        // adds its warnings to that card's ParseResult instead.
+        std::vector<std::shared_ptr<AdaptiveCardParseWarning>> GetDeferredCardWarnings() const;
+
         void SetLanguage(const std::string& value);
+        // Gives the card the version of the card containing it, if it doesn't have one of its own
+        void SetDefaultCardVersion(const std::string& version);
 
         void GetResourceInformation(std::vector<RemoteResourceInformation>& resourceInfo) override;
 
     private:
         void PopulateKnownPropertiesSet();
 
+        // The card's JSON in binary form, along with what parsing it needs from the context it was deferred by
+        class DeferredCard;
+
         std::shared_ptr<AdaptiveCard> m_card;
+        std::shared_ptr<DeferredCard> m_deferredCard;
+
+        friend class ShowCardActionParser;
     };
 
     class ShowCardActionParser : public ActionElementParser
@@ -16,7 +16,7 @@ std::string SubmitAction::GetDataJson() const
     return ParseUtil::JsonToString(m_dataJson);
 }
 
-Json::Value SubmitAction::GetDataJsonAsValue() const
+const Json::Value& SubmitAction::GetDataJsonAsValue() const
 {
     return m_dataJson;
 }
@@ -75,6 +75,8 @@ std::shared_ptr<BaseActionElement> SubmitActionParser::DeserializeFromString(Par
 
 void SubmitAction::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Data),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IgnoreInputValidation)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Data),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IgnoreInputValidation)});
+    m_sharedKnownProperties = &knownProperties;
 }
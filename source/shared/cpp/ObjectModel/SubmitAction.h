@@ -19,7 +19,7 @@ namespace AdaptiveSharedNamespace
         ~SubmitAction() = default;
 
         std::string GetDataJson() const;
-        Json::Value GetDataJsonAsValue() const;
+        const Json::Value& GetDataJsonAsValue() const;
         void SetDataJson(const Json::Value& value);
         void SetDataJson(const std::string value);
 
@@ -0,0 +1,262 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "SubmitPayloadBuilder.h"
+#include "ActionSet.h"
+#include "Column.h"
+#include "ColumnSet.h"
+#include "Container.h"
+#include "ShowCardAction.h"
+#include "SubmitAction.h"
+
+namespace
+{
+    // Escapes as jsoncpp does, except that characters outside ASCII are written as UTF-8 rather than \u escapes
+    void WriteQuoted(const char* begin, const char* end, std::string& out)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        out += '"';
+        const char* unescaped = begin;
+        for (const char* c = begin; c != end; ++c)
+        {
+            const unsigned char byte = static_cast<unsigned char>(*c);
+            if (byte >= 0x20 && byte != '"' && byte != '\\')
+            {
+                continue;
+            }
+
+            out.append(unescaped, c);
+            unescaped = c + 1;
+            switch (byte)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                out += "\\u00";
+                out += hexDigits[byte >> 4];
+                out += hexDigits[byte & 0xF];
+                break;
+            }
+        }
+        out.append(unescaped, end);
+        out += '"';
+    }
+
+    void WriteQuoted(const std::string& value, std::string& out) { WriteQuoted(value.data(), value.data() + value.size(), out); }
+
+    void WriteJson(const Json::Value& value, std::string& out)
+    {
+        switch (value.type())
+        {
+        case Json::nullValue:
+            out += "null";
+            break;
+        case Json::intValue:
+            out += std::to_string(value.asLargestInt());
+            break;
+        case Json::uintValue:
+            out += std::to_string(value.asLargestUInt());
+            break;
+        case Json::realValue:
+            out += Json::valueToString(value.asDouble());
+            break;
+        case Json::stringValue:
+        {
+            const char* begin;
+            const char* end;
+            value.getString(&begin, &end);
+            WriteQuoted(begin, end, out);
+            break;
+        }
+        case Json::booleanValue:
+            out += value.asBool() ? "true" : "false";
+            break;
+        case Json::arrayValue:
+            out += '[';
+            for (Json::ArrayIndex i = 0; i < value.size(); i++)
+            {
+                if (i != 0)
+                {
+                    out += ',';
+                }
+                WriteJson(value[i], out);
+            }
+            out += ']';
+            break;
+        case Json::objectValue:
+            out += '{';
+            for (auto member = value.begin(); member != value.end(); ++member)
+            {
+                if (member != value.begin())
+                {
+                    out += ',';
+                }
+                const char* nameEnd;
+                const char* name = member.memberName(&nameEnd);
+                WriteQuoted(name, nameEnd, out);
+                out += ':';
+                WriteJson(*member, out);
+            }
+            out += '}';
+            break;
+        }
+    }
+}
+
+namespace AdaptiveSharedNamespace
+{
+    SubmitPayloadBuilder::SubmitPayloadBuilder(const AdaptiveCard& card) { AddInputs(card); }
+
+    const std::vector<std::shared_ptr<BaseInputElement>>& SubmitPayloadBuilder::GetInputs() const { return m_inputs; }
+
+    std::string SubmitPayloadBuilder::Build(const SubmitAction& action, const std::unordered_map<std::string, std::string>& values) const
+    {
+        std::string payload;
+        Build(action, values, payload);
+        return payload;
+    }
+
+    void SubmitPayloadBuilder::Build(const SubmitAction& action,
+                                     const std::unordered_map<std::string, std::string>& values,
+                                     std::string& payload) const
+    {
+        payload.clear();
+
+        const Json::Value& data = action.GetDataJsonAsValue();
+        if (!data.isNull() && !data.isObject())
+        {
+            WriteJson(data, payload);
+            return;
+        }
+
+        payload += '{';
+        bool first = true;
+        for (auto member = data.begin(); member != data.end(); ++member)
+        {
+            // Inputs with a value take the place of data properties that share their id
+            const char* nameEnd;
+            const char* name = member.memberName(&nameEnd);
+            const std::string propertyName(name, nameEnd);
+            if (m_inputIds.count(propertyName) != 0 && values.count(propertyName) != 0)
+            {
+                continue;
+            }
+
+            if (!first)
+            {
+                payload += ',';
+            }
+            first = false;
+            WriteQuoted(propertyName, payload);
+            payload += ':';
+            WriteJson(*member, payload);
+        }
+
+        for (size_t i = 0; i < m_inputs.size(); i++)
+        {
+            const auto value = values.find(m_inputs[i]->GetId());
+            if (value == values.end())
+            {
+                continue;
+            }
+
+            if (!first)
+            {
+                payload += ',';
+            }
+            first = false;
+            payload += m_propertyNames[i];
+            WriteQuoted(value->second, payload);
+        }
+        payload += '}';
+    }
+
+    void SubmitPayloadBuilder::AddInputs(const AdaptiveCard& card)
+    {
+        AddInputs(card.GetBody());
+        AddInputs(card.GetActions());
+    }
+
+    void SubmitPayloadBuilder::AddInputs(const std::vector<std::shared_ptr<BaseCardElement>>& elements)
+    {
+        for (const auto& element : elements)
+        {
+            switch (element->GetElementType())
+            {
+            case CardElementType::Container:
+                AddInputs(std::static_pointer_cast<Container>(element)->GetItems());
+                break;
+            case CardElementType::Column:
+                AddInputs(std::static_pointer_cast<Column>(element)->GetItems());
+                break;
+            case CardElementType::ColumnSet:
+                for (const auto& column : std::static_pointer_cast<ColumnSet>(element)->GetColumns())
+                {
+                    AddInputs(column->GetItems());
+                }
+                break;
+            case CardElementType::ActionSet:
+                AddInputs(std::static_pointer_cast<ActionSet>(element)->GetActions());
+                break;
+            case CardElementType::ChoiceSetInput:
+            case CardElementType::DateInput:
+            case CardElementType::NumberInput:
+            case CardElementType::TextInput:
+            case CardElementType::TimeInput:
+            case CardElementType::ToggleInput:
+            {
+                auto input = std::static_pointer_cast<BaseInputElement>(element);
+                const std::string id = input->GetId();
+
+                // A duplicate id would give the payload two properties of the same name
+                if (m_inputIds.insert(id).second)
+                {
+                    std::string propertyName;
+                    WriteQuoted(id, propertyName);
+                    propertyName += ':';
+                    m_propertyNames.push_back(std::move(propertyName));
+                    m_inputs.push_back(std::move(input));
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    void SubmitPayloadBuilder::AddInputs(const std::vector<std::shared_ptr<BaseActionElement>>& actions)
+    {
+        for (const auto& action : actions)
+        {
+            if (action->GetElementType() == ActionType::ShowCard)
+            {
+                const auto card = std::static_pointer_cast<ShowCardAction>(action)->GetCard();
+                if (card)
+                {
+                    AddInputs(*card);
+                }
+            }
+        }
+    }
+}
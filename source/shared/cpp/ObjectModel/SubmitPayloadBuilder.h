@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "BaseInputElement.h"
+#include "SharedAdaptiveCard.h"
+
+namespace AdaptiveSharedNamespace
+{
+    class SubmitAction;
+
+    // SubmitPayloadBuilder writes the data for an Action.Submit as JSON text: the action's data with the value of every
+    // input merged in under the input's id, replacing any data property of the same name. When the action has no data
+    // the payload is just the inputs; data that isn't an object is written as is, without inputs, as in the JavaScript
+    // renderer.
+    //
+    // The inputs in scope are found once, when the builder is created: every input in the card, including the cards
+    // of ShowCard actions, but not fallback content. Build the payload for any Action.Submit in the card, however
+    // deeply nested, from the same builder. The payload is written in one pass, without copying the action's data.
+    class SubmitPayloadBuilder
+    {
+    public:
+        explicit SubmitPayloadBuilder(const AdaptiveCard& card);
+
+        const std::vector<std::shared_ptr<BaseInputElement>>& GetInputs() const;
+
+        // values maps input ids to their current values; inputs missing from it are left out of the payload
+        std::string Build(const SubmitAction& action, const std::unordered_map<std::string, std::string>& values) const;
+
+        // As above, replacing the contents of payload so its buffer can be reused from one submit to the next
+        void Build(const SubmitAction& action, const std::unordered_map<std::string, std::string>& values, std::string& payload) const;
+
+    private:
+        void AddInputs(const AdaptiveCard& card);
+        void AddInputs(const std::vector<std::shared_ptr<BaseCardElement>>& elements);
+        void AddInputs(const std::vector<std::shared_ptr<BaseActionElement>>& actions);
+
+        std::vector<std::shared_ptr<BaseInputElement>> m_inputs;
+
+        // Each input's id as an escaped JSON property name, ready to write
+        std::vector<std::string> m_propertyNames;
+        std::unordered_set<std::string> m_inputIds;
+    };
+}
@@ -50,6 +50,11 @@ std::string TextBlock::GetText() const
     return m_textElementProperties->GetText();
 }
 
+const std::string& TextBlock::GetTextRef() const
+{
+    return m_textElementProperties->GetTextRef();
+}
+
 void TextBlock::SetText(const std::string& value)
 {
     m_textElementProperties->SetText(value);
@@ -145,6 +150,11 @@ std::string TextBlock::GetLanguage() const
     return m_textElementProperties->GetLanguage();
 }
 
+const std::string& TextBlock::GetLanguageRef() const
+{
+    return m_textElementProperties->GetLanguageRef();
+}
+
 void TextBlock::SetLanguage(const std::string& value)
 {
     m_textElementProperties->SetLanguage(value);
@@ -172,9 +182,13 @@ std::shared_ptr<BaseCardElement> TextBlockParser::DeserializeFromString(ParseCon
 
 void TextBlock::PopulateKnownPropertiesSet()
 {
-    m_textElementProperties->PopulateKnownPropertiesSet(m_knownProperties);
-
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MaxLines),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalAlignment)});
+    static const std::unordered_set<std::string> knownProperties = [this]() {
+        std::unordered_set<std::string> properties =
+            ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap),
+                                   AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MaxLines),
+                                   AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::HorizontalAlignment)});
+        m_textElementProperties->PopulateKnownPropertiesSet(properties);
+        return properties;
+    }();
+    m_sharedKnownProperties = &knownProperties;
 }
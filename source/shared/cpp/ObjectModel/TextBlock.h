@@ -26,6 +26,7 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue() const override;
 
         std::string GetText() const;
+        const std::string& GetTextRef() const;
         void SetText(const std::string& value);
         DateTimePreparser GetTextForDateParsing() const;
 
@@ -55,6 +56,7 @@ namespace AdaptiveSharedNamespace
 
         void SetLanguage(const std::string& value);
         std::string GetLanguage() const;
+        const std::string& GetLanguageRef() const;
 
     private:
         bool m_wrap;
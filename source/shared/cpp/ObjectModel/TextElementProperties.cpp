@@ -61,6 +61,11 @@ std::string TextElementProperties::GetText() const
     return m_text;
 }
 
+const std::string& TextElementProperties::GetTextRef() const
+{
+    return m_text;
+}
+
 void TextElementProperties::SetText(const std::string& value)
 {
     m_text = value;
@@ -126,6 +131,11 @@ std::string TextElementProperties::GetLanguage() const
     return m_language;
 }
 
+const std::string& TextElementProperties::GetLanguageRef() const
+{
+    return m_language;
+}
+
 void TextElementProperties::SetLanguage(const std::string& value)
 {
     m_language = value;
@@ -24,6 +24,7 @@ namespace AdaptiveSharedNamespace
         virtual Json::Value SerializeToJsonValue(Json::Value& root) const;
 
         std::string GetText() const;
+        const std::string& GetTextRef() const;
         void SetText(const std::string& value);
         DateTimePreparser GetTextForDateParsing() const;
 
@@ -44,6 +45,7 @@ namespace AdaptiveSharedNamespace
 
         void SetLanguage(const std::string& value);
         std::string GetLanguage() const;
+        const std::string& GetLanguageRef() const;
 
         virtual void Deserialize(const ParseContext& context, const Json::Value& root);
         virtual void PopulateKnownPropertiesSet(std::unordered_set<std::string>& knownProperties);
@@ -61,6 +61,11 @@ std::string TextInput::GetPlaceholder() const
     return m_placeholder;
 }
 
+const std::string& TextInput::GetPlaceholderRef() const
+{
+    return m_placeholder;
+}
+
 void TextInput::SetPlaceholder(const std::string& value)
 {
     m_placeholder = value;
@@ -71,6 +76,11 @@ std::string TextInput::GetValue() const
     return m_value;
 }
 
+const std::string& TextInput::GetValueRef() const
+{
+    return m_value;
+}
+
 void TextInput::SetValue(const std::string& value)
 {
     m_value = value;
@@ -121,6 +131,11 @@ std::string TextInput::GetRegex() const
     return m_regex;
 }
 
+const std::string& TextInput::GetRegexRef() const
+{
+    return m_regex;
+}
+
 void TextInput::SetRegex(const std::string& value)
 {
     m_regex = value;
@@ -150,9 +165,11 @@ std::shared_ptr<BaseCardElement> TextInputParser::DeserializeFromString(ParseCon
 
 void TextInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsMultiline),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MaxLength),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::TextInput)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::IsMultiline),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::MaxLength),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::TextInput)});
+    m_sharedKnownProperties = &knownProperties;
 }
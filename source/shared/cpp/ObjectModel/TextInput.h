@@ -21,9 +21,11 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue() const override;
 
         std::string GetPlaceholder() const;
+        const std::string& GetPlaceholderRef() const;
         void SetPlaceholder(const std::string& value);
 
         std::string GetValue() const;
+        const std::string& GetValueRef() const;
         void SetValue(const std::string& value);
 
         bool GetIsMultiline() const;
@@ -39,6 +41,7 @@ namespace AdaptiveSharedNamespace
         void SetInlineAction(const std::shared_ptr<BaseActionElement> action);
 
         std::string GetRegex() const;
+        const std::string& GetRegexRef() const;
         void SetRegex(const std::string& value);
 
     private:
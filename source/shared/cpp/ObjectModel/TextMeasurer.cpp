@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TextMeasurer.h"
+#include "ParseUtil.h"
+
+namespace AdaptiveSharedNamespace
+{
+    namespace
+    {
+        // Decodes the UTF-8 sequence starting at text[index] and advances index past it. Malformed sequences decode
+        // as a single replacement character so measurement never stalls.
+        char32_t DecodeCodePoint(const std::string& text, size_t& index)
+        {
+            const unsigned char lead = static_cast<unsigned char>(text[index++]);
+            if (lead < 0x80)
+            {
+                return lead;
+            }
+
+            size_t trailing;
+            char32_t codePoint;
+            if ((lead & 0xE0) == 0xC0)
+            {
+                trailing = 1;
+                codePoint = lead & 0x1F;
+            }
+            else if ((lead & 0xF0) == 0xE0)
+            {
+                trailing = 2;
+                codePoint = lead & 0x0F;
+            }
+            else if ((lead & 0xF8) == 0xF0)
+            {
+                trailing = 3;
+                codePoint = lead & 0x07;
+            }
+            else
+            {
+                return 0xFFFD;
+            }
+
+            for (; trailing && index < text.size(); --trailing)
+            {
+                const unsigned char next = static_cast<unsigned char>(text[index]);
+                if ((next & 0xC0) != 0x80)
+                {
+                    return 0xFFFD;
+                }
+                codePoint = (codePoint << 6) | (next & 0x3F);
+                ++index;
+            }
+            return trailing ? 0xFFFD : codePoint;
+        }
+
+        unsigned int GetFontTypeIndex(FontType fontType) { return (fontType == FontType::Monospace) ? 1 : 0; }
+    }
+
+    FontMetrics FontMetrics::Deserialize(const Json::Value& json, const FontMetrics& defaultValue)
+    {
+        FontMetrics result;
+        result.averageCharWidth = json.get("averageCharWidth", defaultValue.averageCharWidth).asDouble();
+        result.bolderCharWidth = json.get("bolderCharWidth", defaultValue.bolderCharWidth).asDouble();
+        result.lineHeight = json.get("lineHeight", defaultValue.lineHeight).asDouble();
+
+        const auto& advances = json["advances"];
+        if (advances.isObject())
+        {
+            for (const auto& character : advances.getMemberNames())
+            {
+                if (character.empty())
+                {
+                    continue;
+                }
+
+                size_t index = 0;
+                const char32_t codePoint = DecodeCodePoint(character, index);
+                result.advances[codePoint] = advances[character].asDouble();
+            }
+        }
+        else
+        {
+            result.advances = defaultValue.advances;
+        }
+
+        return result;
+    }
+
+    FontMetricsTable::FontMetricsTable()
+    {
+        monospaceFontType.averageCharWidth = 0.6;
+        monospaceFontType.bolderCharWidth = 0.6;
+    }
+
+    const FontMetrics& FontMetricsTable::GetFontMetrics(FontType fontType) const
+    {
+        return (fontType == FontType::Monospace) ? monospaceFontType : defaultFontType;
+    }
+
+    FontMetricsTable FontMetricsTable::Deserialize(const Json::Value& json)
+    {
+        FontMetricsTable result;
+        result.defaultFontType = ParseUtil::ExtractJsonValueAndMergeWithDefault<FontMetrics>(
+            json, AdaptiveCardSchemaKey::Default, result.defaultFontType, FontMetrics::Deserialize);
+        result.monospaceFontType = ParseUtil::ExtractJsonValueAndMergeWithDefault<FontMetrics>(
+            json, AdaptiveCardSchemaKey::Monospace, result.monospaceFontType, FontMetrics::Deserialize);
+        return result;
+    }
+
+    FontMetricsTable FontMetricsTable::DeserializeFromString(const std::string& jsonString)
+    {
+        return FontMetricsTable::Deserialize(ParseUtil::GetJsonValueFromString(jsonString));
+    }
+
+    FontMetricsTable FontMetricsTable::DeserializeFromFile(const std::string& jsonFile)
+    {
+        std::ifstream jsonFileStream(jsonFile);
+
+        Json::Value root;
+        jsonFileStream >> root;
+
+        return FontMetricsTable::Deserialize(root);
+    }
+
+    AdvanceTableTextMeasurer::AdvanceTableTextMeasurer(const HostConfig& hostConfig, const FontMetricsTable& fontMetrics) :
+        m_fontMetrics(fontMetrics)
+    {
+        const TextSize sizes[] = {TextSize::Small, TextSize::Default, TextSize::Medium, TextSize::Large, TextSize::ExtraLarge};
+        for (const auto size : sizes)
+        {
+            m_fontSizes[0][static_cast<int>(size)] = hostConfig.GetFontSize(FontType::Default, size);
+            m_fontSizes[1][static_cast<int>(size)] = hostConfig.GetFontSize(FontType::Monospace, size);
+        }
+
+        const FontType fontTypes[] = {FontType::Default, FontType::Monospace};
+        for (const auto fontType : fontTypes)
+        {
+            const auto& metrics = m_fontMetrics.GetFontMetrics(fontType);
+            const double bolderScale = (metrics.averageCharWidth > 0) ? metrics.bolderCharWidth / metrics.averageCharWidth : 1.0;
+            m_bolderScales[GetFontTypeIndex(fontType)] = bolderScale;
+            for (char32_t codePoint = 0; codePoint < c_asciiTableSize; ++codePoint)
+            {
+                const auto advance = metrics.advances.find(codePoint);
+                const double width = (advance != metrics.advances.end()) ? advance->second : metrics.averageCharWidth;
+                m_asciiAdvances[GetFontTypeIndex(fontType)][0][codePoint] = width;
+                m_asciiAdvances[GetFontTypeIndex(fontType)][1][codePoint] = width * bolderScale;
+            }
+        }
+    }
+
+    double AdvanceTableTextMeasurer::MeasureWidth(const std::string& text, FontType fontType, TextSize size, TextWeight weight)
+    {
+        const unsigned int fontTypeIndex = GetFontTypeIndex(fontType);
+        const bool isBolder = (weight == TextWeight::Bolder);
+        const double* asciiAdvances = m_asciiAdvances[fontTypeIndex][isBolder ? 1 : 0];
+
+        double width = 0;
+        size_t index = 0;
+        while (index < text.size())
+        {
+            const unsigned char lead = static_cast<unsigned char>(text[index]);
+            if (lead < c_asciiTableSize)
+            {
+                width += asciiAdvances[lead];
+                ++index;
+                continue;
+            }
+
+            const auto& metrics = m_fontMetrics.GetFontMetrics(fontType);
+            const char32_t codePoint = DecodeCodePoint(text, index);
+            const auto advance = metrics.advances.find(codePoint);
+            if (advance != metrics.advances.end())
+            {
+                width += isBolder ? advance->second * m_bolderScales[fontTypeIndex] : advance->second;
+            }
+            else
+            {
+                width += metrics.GetCharWidth(weight);
+            }
+        }
+
+        return width * m_fontSizes[fontTypeIndex][static_cast<int>(size)];
+    }
+
+    double AdvanceTableTextMeasurer::GetLineHeight(FontType fontType, TextSize size)
+    {
+        return m_fontSizes[GetFontTypeIndex(fontType)][static_cast<int>(size)] * m_fontMetrics.GetFontMetrics(fontType).lineHeight;
+    }
+
+    CachingTextMeasurer::CachingTextMeasurer(std::shared_ptr<TextMeasurer> measurer, size_t maxEntries) :
+        m_measurer(measurer), m_maxEntries(maxEntries), m_lookupKey{}
+    {
+    }
+
+    double CachingTextMeasurer::MeasureWidth(const std::string& text, FontType fontType, TextSize size, TextWeight weight)
+    {
+        // reuse the lookup key's buffer so that cache hits don't allocate
+        m_lookupKey.text.assign(text);
+        m_lookupKey.style = (static_cast<unsigned int>(fontType) << 16) | (static_cast<unsigned int>(size) << 8) |
+                            static_cast<unsigned int>(weight);
+
+        const auto cached = m_widths.find(m_lookupKey);
+        if (cached != m_widths.end())
+        {
+            return cached->second;
+        }
+
+        if (m_widths.size() >= m_maxEntries)
+        {
+            m_widths.clear();
+        }
+
+        const double width = m_measurer->MeasureWidth(text, fontType, size, weight);
+        m_widths.emplace(m_lookupKey, width);
+        return width;
+    }
+
+    double CachingTextMeasurer::GetLineHeight(FontType fontType, TextSize size)
+    {
+        return m_measurer->GetLineHeight(fontType, size);
+    }
+
+    void CachingTextMeasurer::ClearCache() { m_widths.clear(); }
+}
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "pch.h"
+#include "HostConfig.h"
+
+namespace AdaptiveSharedNamespace
+{
+    // Approximate glyph metrics for a font type. Widths and line height are expressed as multiples of the font size so
+    // that a single table applies to every TextSize defined in HostConfig.
+    struct FontMetrics
+    {
+        double averageCharWidth = 0.5;
+        double bolderCharWidth = 0.55;
+        double lineHeight = 1.333;
+
+        // Optional per-code point advances at default weight. Code points that aren't listed use averageCharWidth.
+        std::unordered_map<char32_t, double> advances;
+
+        double GetCharWidth(TextWeight weight) const { return (weight == TextWeight::Bolder) ? bolderCharWidth : averageCharWidth; }
+
+        static FontMetrics Deserialize(const Json::Value& json, const FontMetrics& defaultValue);
+    };
+
+    struct FontMetricsTable
+    {
+        FontMetricsTable();
+
+        FontMetrics defaultFontType;
+        FontMetrics monospaceFontType;
+
+        const FontMetrics& GetFontMetrics(FontType fontType) const;
+
+        static FontMetricsTable Deserialize(const Json::Value& json);
+        static FontMetricsTable DeserializeFromString(const std::string& jsonString);
+        static FontMetricsTable DeserializeFromFile(const std::string& jsonFile);
+    };
+
+    // TextMeasurer measures single lines of text in pixels for a given font type, size, and weight as resolved through
+    // HostConfig. It makes no attempt at shaping; hosts that need exact results can provide an implementation backed by
+    // the platform's text stack.
+    class TextMeasurer
+    {
+    public:
+        virtual ~TextMeasurer() = default;
+
+        virtual double MeasureWidth(const std::string& text, FontType fontType, TextSize size, TextWeight weight) = 0;
+        virtual double GetLineHeight(FontType fontType, TextSize size) = 0;
+    };
+
+    // Measures text by summing per-code point advances from a FontMetricsTable. With a table that only specifies
+    // averageCharWidth this behaves as a monospace measurer.
+    class AdvanceTableTextMeasurer : public TextMeasurer
+    {
+    public:
+        AdvanceTableTextMeasurer(const HostConfig& hostConfig, const FontMetricsTable& fontMetrics);
+
+        double MeasureWidth(const std::string& text, FontType fontType, TextSize size, TextWeight weight) override;
+        double GetLineHeight(FontType fontType, TextSize size) override;
+
+    private:
+        static constexpr unsigned int c_asciiTableSize = 128;
+
+        FontMetricsTable m_fontMetrics;
+        unsigned int m_fontSizes[2][5];
+        double m_bolderScales[2];
+
+        // Advances for ASCII are flattened into arrays (indexed [fontType][isBolder]) so the common case is a load.
+        double m_asciiAdvances[2][2][c_asciiTableSize];
+    };
+
+    struct TextMeasurementKey
+    {
+        std::string text;
+        unsigned int style;
+
+        bool operator==(const TextMeasurementKey& other) const { return style == other.style && text == other.text; }
+    };
+
+    struct TextMeasurementKeyHash
+    {
+        std::size_t operator()(const TextMeasurementKey& key) const
+        {
+            return std::hash<std::string>()(key.text) ^ (static_cast<std::size_t>(key.style) * 0x9E3779B9);
+        }
+    };
+
+    // Memoizes the widths reported by another TextMeasurer per (text, font type, size, weight). Once maxEntries
+    // measurements are held the cache is discarded and refilled. Not thread-safe; use one instance per thread.
+    class CachingTextMeasurer : public TextMeasurer
+    {
+    public:
+        CachingTextMeasurer(std::shared_ptr<TextMeasurer> measurer, size_t maxEntries = 65536);
+
+        double MeasureWidth(const std::string& text, FontType fontType, TextSize size, TextWeight weight) override;
+        double GetLineHeight(FontType fontType, TextSize size) override;
+
+        void ClearCache();
+
+    private:
+        std::shared_ptr<TextMeasurer> m_measurer;
+        size_t m_maxEntries;
+        std::unordered_map<TextMeasurementKey, double, TextMeasurementKeyHash> m_widths;
+        TextMeasurementKey m_lookupKey;
+    };
+}
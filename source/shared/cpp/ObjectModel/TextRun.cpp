@@ -14,7 +14,12 @@ TextRun::TextRun() :
 
 void TextRun::PopulateKnownPropertiesSet()
 {
-    m_textElementProperties->PopulateKnownPropertiesSet(m_knownProperties);
+    static const std::unordered_set<std::string> knownProperties = [this]() {
+        std::unordered_set<std::string> properties = *m_sharedKnownProperties;
+        m_textElementProperties->PopulateKnownPropertiesSet(properties);
+        return properties;
+    }();
+    m_sharedKnownProperties = &knownProperties;
 }
 
 Json::Value TextRun::SerializeToJsonValue() const
@@ -41,6 +46,11 @@ std::string TextRun::GetText() const
     return m_textElementProperties->GetText();
 }
 
+const std::string& TextRun::GetTextRef() const
+{
+    return m_textElementProperties->GetTextRef();
+}
+
 void TextRun::SetText(const std::string& value)
 {
     m_textElementProperties->SetText(value);
@@ -136,6 +146,11 @@ std::string TextRun::GetLanguage() const
     return m_textElementProperties->GetLanguage();
 }
 
+const std::string& TextRun::GetLanguageRef() const
+{
+    return m_textElementProperties->GetLanguageRef();
+}
+
 void TextRun::SetLanguage(const std::string& value)
 {
     m_textElementProperties->SetLanguage(value);
@@ -163,7 +178,7 @@ void TextRun::SetUnderline(const bool value)
 
 std::shared_ptr<Inline> TextRun::Deserialize(ParseContext& context, const Json::Value& json)
 {
-    std::shared_ptr<TextRun> inlineTextRun = std::make_shared<TextRun>();
+    std::shared_ptr<TextRun> inlineTextRun = context.MakeShared<TextRun>();
 
     if (json.isString())
     {
@@ -178,7 +193,10 @@ std::shared_ptr<Inline> TextRun::Deserialize(ParseContext& context, const Json::
         inlineTextRun->SetUnderline(ParseUtil::GetBool(json, AdaptiveCardSchemaKey::Underline, false));
         inlineTextRun->SetSelectAction(ParseUtil::GetAction(context, json, AdaptiveCardSchemaKey::SelectAction, false));
 
-        HandleUnknownProperties(json, inlineTextRun->m_knownProperties, inlineTextRun->m_additionalProperties);
+        HandleUnknownProperties(json,
+                                *inlineTextRun->m_sharedKnownProperties,
+                                inlineTextRun->m_knownProperties,
+                                inlineTextRun->m_additionalProperties);
     }
 
     return inlineTextRun;
@@ -24,6 +24,7 @@ namespace AdaptiveSharedNamespace
         static std::shared_ptr<Inline> Deserialize(ParseContext& context, const Json::Value& root);
 
         std::string GetText() const;
+        const std::string& GetTextRef() const;
         void SetText(const std::string& value);
         DateTimePreparser GetTextForDateParsing() const;
 
@@ -53,6 +54,7 @@ namespace AdaptiveSharedNamespace
 
         void SetLanguage(const std::string& value);
         std::string GetLanguage() const;
+        const std::string& GetLanguageRef() const;
 
         bool GetUnderline() const;
         void SetUnderline(const bool value);
@@ -44,6 +44,11 @@ std::string TimeInput::GetMax() const
     return m_max;
 }
 
+const std::string& TimeInput::GetMaxRef() const
+{
+    return m_max;
+}
+
 void TimeInput::SetMax(const std::string& value)
 {
     m_max = value;
@@ -54,6 +59,11 @@ std::string TimeInput::GetMin() const
     return m_min;
 }
 
+const std::string& TimeInput::GetMinRef() const
+{
+    return m_min;
+}
+
 void TimeInput::SetMin(const std::string& value)
 {
     m_min = value;
@@ -64,6 +74,11 @@ std::string TimeInput::GetPlaceholder() const
     return m_placeholder;
 }
 
+const std::string& TimeInput::GetPlaceholderRef() const
+{
+    return m_placeholder;
+}
+
 void TimeInput::SetPlaceholder(const std::string& value)
 {
     m_placeholder = value;
@@ -74,6 +89,11 @@ std::string TimeInput::GetValue() const
     return m_value;
 }
 
+const std::string& TimeInput::GetValueRef() const
+{
+    return m_value;
+}
+
 void TimeInput::SetValue(const std::string& value)
 {
     m_value = value;
@@ -100,8 +120,10 @@ std::shared_ptr<BaseCardElement> TimeInputParser::DeserializeFromString(ParseCon
 
 void TimeInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Max),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Min),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Placeholder),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value)});
+    m_sharedKnownProperties = &knownProperties;
 }
@@ -47,6 +47,11 @@ std::string ToggleInput::GetTitle() const
     return m_title;
 }
 
+const std::string& ToggleInput::GetTitleRef() const
+{
+    return m_title;
+}
+
 void ToggleInput::SetTitle(const std::string& value)
 {
     m_title = value;
@@ -57,6 +62,11 @@ std::string ToggleInput::GetValue() const
     return m_value;
 }
 
+const std::string& ToggleInput::GetValueRef() const
+{
+    return m_value;
+}
+
 void ToggleInput::SetValue(const std::string& value)
 {
     m_value = value;
@@ -71,11 +81,21 @@ std::string ToggleInput::GetValueOff() const
     return m_valueOff;
 }
 
+const std::string& ToggleInput::GetValueOffRef() const
+{
+    return m_valueOff;
+}
+
 std::string ToggleInput::GetValueOn() const
 {
     return m_valueOn;
 }
 
+const std::string& ToggleInput::GetValueOnRef() const
+{
+    return m_valueOn;
+}
+
 void ToggleInput::SetValueOn(const std::string& valueOn)
 {
     m_valueOn = valueOn;
@@ -114,9 +134,11 @@ ToggleInputParser::DeserializeFromString(ParseContext& context, const std::strin
 
 void ToggleInput::PopulateKnownPropertiesSet()
 {
-    m_knownProperties.insert({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ValueOn),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ValueOff),
-                              AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap)});
+    static const std::unordered_set<std::string> knownProperties =
+        ExtendKnownProperties({AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Title),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Value),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ValueOn),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::ValueOff),
+                               AdaptiveCardSchemaKeyToString(AdaptiveCardSchemaKey::Wrap)});
+    m_sharedKnownProperties = &knownProperties;
 }
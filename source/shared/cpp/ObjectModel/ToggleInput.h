@@ -21,15 +21,19 @@ namespace AdaptiveSharedNamespace
         Json::Value SerializeToJsonValue() const override;
 
         std::string GetTitle() const;
+        const std::string& GetTitleRef() const;
         void SetTitle(const std::string& value);
 
         std::string GetValue() const;
+        const std::string& GetValueRef() const;
         void SetValue(const std::string& value);
 
         std::string GetValueOff() const;
+        const std::string& GetValueOffRef() const;
         void SetValueOff(const std::string& value);
 
         std::string GetValueOn() const;
+        const std::string& GetValueOnRef() const;
         void SetValueOn(const std::string& value);
 
         bool GetWrap() const;
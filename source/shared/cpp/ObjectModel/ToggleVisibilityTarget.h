@@ -21,6 +21,7 @@ namespace AdaptiveSharedNamespace
         ToggleVisibilityTarget();
 
         std::string GetElementId() const;
+        const std::string& GetElementIdRef() const;
         void SetElementId(const std::string& value);
 
         IsVisible GetIsVisible() const;
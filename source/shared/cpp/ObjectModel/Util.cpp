@@ -138,11 +138,7 @@ void EnsureShowCardVersions(const std::vector<std::shared_ptr<BaseActionElement>
     {
         if (action->GetElementType() == ActionType::ShowCard)
         {
-            auto showCardAction = std::static_pointer_cast<ShowCardAction>(action);
-            if (showCardAction->GetCard()->GetVersion().empty())
-            {
-                showCardAction->GetCard()->SetVersion(version);
-            }
+            std::static_pointer_cast<ShowCardAction>(action)->SetDefaultCardVersion(version);
         }
     }
 }
@@ -158,3 +154,18 @@ void HandleUnknownProperties(const Json::Value& json, const std::unordered_set<s
         }
     }
 }
+
+void HandleUnknownProperties(const Json::Value& json,
+                             const std::unordered_set<std::string>& sharedKnownProperties,
+                             const std::unordered_set<std::string>& knownProperties,
+                             Json::Value& unknownProperties)
+{
+    for (auto it = json.begin(); it != json.end(); ++it)
+    {
+        std::string key = it.key().asCString();
+        if (sharedKnownProperties.find(key) == sharedKnownProperties.end() && knownProperties.find(key) == knownProperties.end())
+        {
+            unknownProperties[key] = *it;
+        }
+    }
+}
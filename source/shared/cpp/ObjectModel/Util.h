@@ -15,3 +15,7 @@ void EnsureShowCardVersions(const std::vector<std::shared_ptr<AdaptiveSharedName
                             const std::string& version);
 
 void HandleUnknownProperties(const Json::Value& json, const std::unordered_set<std::string>& knownProperties, Json::Value& unknownProperties);
+void HandleUnknownProperties(const Json::Value& json,
+                             const std::unordered_set<std::string>& sharedKnownProperties,
+                             const std::unordered_set<std::string>& knownProperties,
+                             Json::Value& unknownProperties);
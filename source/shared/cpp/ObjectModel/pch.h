@@ -12,9 +12,11 @@
 
 #include <algorithm>
 #include <cctype>
+#include <climits>
 #include <exception>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <locale>
 #include <memory>
 #include <numeric>